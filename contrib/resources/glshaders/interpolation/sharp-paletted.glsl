@@ -0,0 +1,88 @@
+#version 120
+
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  Sharp-bilinear interpolation for paletted video modes. The input is
+ *  the raw 8-bit indexed frame; colours are resolved on the GPU through
+ *  the 256x1 'rubyPalette' texture, so the CPU neither expands the
+ *  palette nor uploads 32-bit pixels.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma use_npot_texture
+#pragma use_indexed_texture
+#pragma force_single_scan
+#pragma force_no_pixel_doubling
+
+varying vec2 v_texCoord;
+uniform vec2 rubyInputSize;
+uniform vec2 rubyOutputSize;
+uniform vec2 rubyTextureSize;
+varying vec2 prescale; // const set by vertex shader
+
+#if defined(VERTEX)
+
+attribute vec4 a_position;
+
+void main()
+{
+	gl_Position = a_position;
+	v_texCoord = vec2(a_position.x + 1.0, 1.0 - a_position.y) / 2.0 * rubyInputSize;
+	prescale = ceil(rubyOutputSize / rubyInputSize);
+}
+
+#elif defined(FRAGMENT)
+
+uniform sampler2D rubyTexture;
+uniform sampler2D rubyPalette;
+
+vec3 lookup(vec2 texel)
+{
+	vec2 uv = (texel + vec2(0.5)) / rubyTextureSize;
+	float index = texture2D(rubyTexture, uv).r;
+	return texture2D(rubyPalette, vec2(index * 255.0 / 256.0 + 0.5 / 256.0, 0.5)).rgb;
+}
+
+void main()
+{
+	const vec2 halfp = vec2(0.5);
+	vec2 texel_floored = floor(v_texCoord);
+	vec2 s = fract(v_texCoord);
+	vec2 region_range = halfp - halfp / prescale;
+
+	vec2 center_dist = s - halfp;
+	vec2 f = (center_dist - clamp(center_dist, -region_range, region_range)) * prescale + halfp;
+
+	vec2 mod_texel = min(texel_floored + f, rubyInputSize - halfp);
+
+	// The index texture must be sampled with nearest-neighbour, so the
+	// bilinear blend happens here, after the palette lookup
+	vec2 base = floor(mod_texel - halfp);
+	vec2 blend = mod_texel - halfp - base;
+	vec3 c00 = lookup(base);
+	vec3 c10 = lookup(base + vec2(1.0, 0.0));
+	vec3 c01 = lookup(base + vec2(0.0, 1.0));
+	vec3 c11 = lookup(base + vec2(1.0, 1.0));
+	gl_FragColor = vec4(mix(mix(c00, c10, blend.x),
+	                        mix(c01, c11, blend.x),
+	                        blend.y),
+	                    1.0);
+}
+
+#endif
@@ -21,13 +21,19 @@
 
 #include "dosbox.h"
 
+#include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdio.h>
 #include <array>
+#include <thread>
+#include <vector>
 
 #include "bios.h"
 #include "dos_inc.h"
 #include "mem.h"
+#include "rwqueue.h"
 
 /* The Section handling Bios Disk Access */
 #define BIOS_MAX_DISK 10
@@ -45,8 +51,11 @@ extern diskGeo DiskGeometryList[];
 class imageDisk  {
 public:
 	uint8_t Read_Sector(uint32_t head,uint32_t cylinder,uint32_t sector,void * data);
+	uint8_t Read_Sectors(uint32_t head, uint32_t cylinder, uint32_t sector,
+	                     uint32_t count, void* data);
 	uint8_t Write_Sector(uint32_t head,uint32_t cylinder,uint32_t sector,void * data);
 	uint8_t Read_AbsoluteSector(uint32_t sectnum, void * data);
+	uint8_t Read_AbsoluteSectors(uint32_t sectnum, uint32_t count, void* data);
 	uint8_t Write_AbsoluteSector(uint32_t sectnum, void * data);
 
 	void Set_Geometry(uint32_t setHeads, uint32_t setCyl, uint32_t setSect, uint32_t setSectSize);
@@ -58,8 +67,15 @@ public:
 	imageDisk(const imageDisk&) = delete; // prevent copy
 	imageDisk& operator=(const imageDisk&) = delete; // prevent assignment
 
+	// Write all cached dirty sectors to the image file in ascending
+	// sector order
+	void FlushWriteCache();
+
 	virtual ~imageDisk()
 	{
+		StopReadAhead();
+		FlushWriteCache();
+		LogWriteCacheStats();
 		if (diskimg != nullptr)
 			fclose(diskimg);
 	}
@@ -75,6 +91,48 @@ public:
 private:
 	cross_off_t current_fpos;
 	enum { NONE,READ,WRITE } last_action;
+
+	// Background sequential read-ahead ('disk_read_ahead_sectors'
+	// setting, 0 disables it). Once the access pattern turns
+	// sequential, upcoming sectors are staged by a worker thread
+	// through the request/completion queues and promoted into
+	// sector_cache, which is consulted before touching the image file.
+	// Writes bump write_generation, which invalidates every prefetch
+	// still in flight.
+	struct PrefetchedSector {
+		uint32_t sector     = 0;
+		uint64_t generation = 0;
+		std::vector<uint8_t> data = {};
+	};
+	void PrefetchWorkerLoop();
+	void ScheduleReadAhead(const uint32_t sectnum);
+	void DrainPrefetchCompletions();
+	void StopReadAhead();
+
+	int read_ahead_sectors          = 0;
+	uint32_t next_sequential_sector = 0;
+	uint32_t last_scheduled_sector  = 0;
+	std::atomic<uint64_t> write_generation = 0;
+	std::map<uint32_t, std::vector<uint8_t>> sector_cache = {};
+	RWQueue<uint32_t> prefetch_requests{16};
+	RWQueue<PrefetchedSector> prefetch_completions{64};
+	std::thread prefetch_worker = {};
+	std::mutex file_mutex       = {};
+
+	// Write-back cache ('disk_flush_interval_ms' setting, 0 writes
+	// through). Guest writes land in dirty_sectors and only reach the
+	// image file once per flush interval, on FlushWriteCache(), or at
+	// shutdown, so the FAT sectors that file operations rewrite over
+	// and over coalesce into a single host write each.
+	uint8_t WriteSectorToImage(const uint32_t sectnum, const void* data);
+	void MaybeFlushWriteCache();
+	void LogWriteCacheStats();
+
+	int flush_interval_ms   = 0;
+	int64_t last_flush_tick = 0;
+	std::map<uint32_t, std::vector<uint8_t>> dirty_sectors = {};
+	uint64_t num_cached_writes   = 0;
+	uint64_t num_sectors_flushed = 0;
 };
 
 void updateDPT(void);
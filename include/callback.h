@@ -67,6 +67,14 @@ enum {
 	CBRET_NONE=0,CBRET_STOP=1
 };
 
+/* The interpreter cores run callback handlers inline via
+   CALLBACK_RunDirect instead of unwinding to the machine loop for every
+   BIOS/DOS service. When an inline-run handler produces a result the
+   machine loop has to act on, the cores hand it up biased by CB_MAX so
+   the loops can tell it apart from a callback number that still needs
+   dispatching. */
+Bits CALLBACK_RunDirect(const Bitu cb_num);
+
 extern uint8_t lastint;
 
 static inline RealPt CALLBACK_RealPointer(callback_number_t cb_number)
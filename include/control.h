@@ -45,6 +45,7 @@ struct CommandLineArguments {
 	bool noprimaryconf;
 	bool nolocalconf;
 	bool fullscreen;
+	bool headless;
 	bool list_countries;
 	bool list_glshaders;
 	bool version;
@@ -56,6 +57,8 @@ struct CommandLineArguments {
 	bool exit;
 	bool securemode;
 	bool noautoexec;
+	bool startup_trace;
+	bool zygote;
 	std::string working_dir;
 	std::string lang;
 	std::string machine;
@@ -63,6 +63,13 @@ extern int64_t CPU_IODelayRemoved;
 extern bool CPU_CycleAutoAdjust;
 extern Bitu CPU_AutoDetermineMode;
 
+/* Persistent per-executable profiles for the auto cycle guessing code
+   (cycle_profile.cpp): DOS_Execute reports every launched binary and the
+   converged cycles of the previous session are restored right away */
+void CPU_CycleProfilesSetEnabled(const bool enabled);
+void CPU_CycleProfilesNotifyLaunch(const uint8_t* image, const size_t image_len);
+void CPU_CycleProfilesSave();
+
 extern ArchitectureType CPU_ArchitectureType;
 
 extern Bitu CPU_PrefetchQueueSize;
@@ -91,6 +98,23 @@ Bits CPU_Core_Prefetch_Trap_Run() noexcept;
 
 void CPU_Reset_AutoAdjust(void);
 
+// A BIOS or device service reports the guest is blocked waiting for
+// external input; the rest of the current millisecond's cycle budget
+// is skipped so the main loop can sleep (see 'host_idle').
+void CPU_NotifyIdle(void);
+
+// As above for hints that are only conventions (the DOS idle interrupt);
+// honoured only with 'host_idle = aggressive'.
+void CPU_NotifyIdleAdvisory(void);
+
+#if (C_DYNAMIC_X86) || (C_DYNREC)
+// Translation cache occupancy and frontier-reuse eviction counters, for
+// the telemetry endpoint
+Bitu CPU_GetDynCacheUsedBytes();
+Bitu CPU_GetDynCacheTotalBytes();
+void CPU_GetDynCacheEvictionStats(uint64_t& evictions, uint64_t& wraps);
+#endif
+
 
 //CPU Stuff
 
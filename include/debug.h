@@ -38,7 +38,22 @@ extern Bitu debugCallback;
 #endif // C_DEBUG
 
 #if C_DEBUG && C_HEAVY_DEBUG
-bool DEBUG_HeavyIsBreakpoint();
+// True while any feature that must observe every instruction is active:
+// breakpoints, instruction logging, or zero-code protection. Kept up to
+// date by the debugger; tested inline by the cores so a debugger-capable
+// binary with nothing armed runs at release-core speed.
+extern bool debug_heavy_armed;
+
+bool DEBUG_HeavyIsBreakpointImpl();
+
+inline bool DEBUG_HeavyIsBreakpoint()
+{
+	if (GCC_LIKELY(!debug_heavy_armed)) {
+		return false;
+	}
+	return DEBUG_HeavyIsBreakpointImpl();
+}
+
 void DEBUG_HeavyWriteLogInstruction();
 template <typename T>
 void DEBUG_UpdateMemoryReadBreakpoints(const PhysPt addr);
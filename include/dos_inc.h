@@ -116,6 +116,7 @@ enum { HAND_NONE=0,HAND_FILE,HAND_DEVICE};
 
 /* Routines for File Class */
 void DOS_SetupFiles (void);
+void DOS_LogFileOperationCounts();
 bool DOS_ReadFile(uint16_t handle,uint8_t * data,uint16_t * amount, bool fcb = false);
 bool DOS_WriteFile(uint16_t handle,uint8_t * data,uint16_t * amount,bool fcb = false);
 bool DOS_SeekFile(uint16_t handle,uint32_t * pos,uint32_t type,bool fcb = false);
@@ -664,6 +665,11 @@ public:
 	uint16_t GetDirIDCluster() const { return SGET_WORD(sDTA, dirCluster); }
 };
 
+// Appends the current DTA result and every remaining match of the search in
+// one call; for internal bulk consumers (DIR, TREE) listing large trees.
+// Call after a successful DOS_FindFirst.
+void DOS_FindAllRemaining(std::vector<DOS_DTA::Result>& results);
+
 enum class ResultGrouping {
 	None,
 	FilesFirst,
@@ -856,6 +862,8 @@ struct DOS_Block {
 	bool echo;          // if set to true dev_con::read will echo input 
 	bool direct_output;
 	bool internal_output;
+	bool fast_console_output;
+	bool batch_file_cache;
 	struct  {
 		RealPt mediaid;
 		RealPt tempdta;
@@ -22,7 +22,12 @@
 
 #include "dosbox.h"
 
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "bit_view.h"
@@ -182,10 +187,16 @@ private:
 
 class localFile : public DOS_File {
 public:
-	localFile(const char* name, const std_fs::path& path, FILE* handle,
+	localFile(const char* name, std_fs::path path, FILE* handle,
 	          const char* basedir);
 	localFile(const localFile&)            = delete; // prevent copying
 	localFile& operator=(const localFile&) = delete; // prevent assignment
+
+	// localFile objects are created and destroyed for every guest file
+	// open and close, so their storage is recycled through a small
+	// freelist pool instead of the heap (see drive_local.cpp)
+	static void* operator new(size_t size);
+	static void operator delete(void* ptr, size_t size) noexcept;
 	bool Read(uint8_t* data, uint16_t* size) override;
 	bool Write(uint8_t* data, uint16_t* size) override;
 	bool Seek(uint32_t* pos, uint32_t type) override;
@@ -295,6 +306,19 @@ public:
 		std::vector<CFileInfo*> longNameList;
 	};
 
+	// Lightweight snapshot handed out by FindFirst: just the fields
+	// FindNext needs, instead of deep CFileInfo copies of the whole
+	// directory. Large trees made those copies the dominant cost of
+	// DIR /S style listings.
+	struct SearchEntry {
+		char shortname[DOS_NAMELENGTH_ASCII] = {0};
+		bool isDir = false;
+	};
+	struct SearchSnapshot {
+		std::vector<SearchEntry> entries = {};
+		Bitu nextEntry = 0;
+	};
+
 private:
 	void ClearFileInfo(CFileInfo *dir);
 	void DeleteFileInfo(CFileInfo *dir);
@@ -310,10 +334,26 @@ private:
 	bool		RemoveSpaces		(char* str);
 	bool		OpenDir			(CFileInfo* dir, const char* path, uint16_t& id);
 	void		CreateEntry		(CFileInfo* dir, const char* name, bool is_directory);
-	void		CopyEntry		(CFileInfo* dir, CFileInfo* from);
 	uint16_t		GetFreeID		(CFileInfo* dir);
 	void		Clear			(void);
 
+	// Background pre-enumeration of the host directory tree. The worker
+	// started by SetBaseDir walks the mounted tree and publishes one
+	// listing per directory, keyed by the expanded host path; ReadDir
+	// consumes a listing instead of enumerating the host filesystem the
+	// first time a guest touches the directory. CacheOut drops the
+	// pre-scanned listing too, so explicit invalidation still forces a
+	// fresh host read.
+	using PreScannedEntries = std::vector<std::pair<std::string, bool>>;
+	void PreScanWorker();
+	void StopPreScan();
+	bool TakePreScannedDir(const char* path, PreScannedEntries& entries);
+
+	std::map<std::string, PreScannedEntries> pre_scanned = {};
+	std::mutex pre_scan_mutex                            = {};
+	std::thread pre_scan_worker                          = {};
+	std::atomic<bool> pre_scan_stop                      = false;
+
 	CFileInfo*	dirBase;
 	char		dirPath				[CROSS_LEN];
 	char		basePath			[CROSS_LEN];
@@ -324,7 +364,7 @@ private:
 
 	uint16_t		srchNr;
 	CFileInfo*	dirSearch			[MAX_OPENDIRS];
-	CFileInfo*	dirFindFirst		[MAX_OPENDIRS];
+	SearchSnapshot*	dirFindFirst		[MAX_OPENDIRS];
 	uint16_t		nextFreeFindFirst;
 
 	char		label				[CROSS_LEN];
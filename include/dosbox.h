@@ -55,6 +55,13 @@ void DOSBOX_RunMachine();
 void DOSBOX_SetLoop(LoopHandler * handler);
 void DOSBOX_SetNormalLoop();
 
+// Fast-forward mode unthrottles the cycle governor and skips video
+// rendering and mixer effect processing while device state keeps
+// advancing. A non-zero 'max_emulated_ms' re-engages normal presentation
+// automatically once that much emulated time has passed.
+void DOSBOX_SetFastForwardMode(bool enabled, uint32_t max_emulated_ms = 0);
+bool DOSBOX_IsFastForwardMode();
+
 void DOSBOX_Init(void);
 
 void DOSBOX_SetMachineTypeFromConfig(Section_prop* section);
@@ -21,7 +21,11 @@
 
 #include "dosbox.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <string>
 #include <vector>
@@ -37,6 +41,7 @@ bool filename_not_strict_8x3(const char *n);
 char *VFILE_Generate_8x3(const char *name, const unsigned int onpos);
 
 class imageDisk; // forward declare
+struct FsWatch;  // forward declare, see fs_utils.h
 
 class DriveManager {
 public:
@@ -88,6 +93,7 @@ public:
 	           uint8_t _sectors_cluster, uint16_t _total_clusters,
 	           uint16_t _free_clusters, uint8_t _mediaid,
 	           bool _always_open_ro_files = false);
+	~localDrive() override;
 	bool FileOpen(DOS_File** file, char* name, uint32_t flags) override;
 	virtual FILE* GetSystemFilePtr(const char* const name, const char* const type);
 	virtual bool GetSystemFilename(char* sysName, const char* const dosName);
@@ -111,6 +117,7 @@ public:
 	bool isRemote(void) override;
 	bool isRemovable(void) override;
 	Bits UnMount(void) override;
+	void EmptyCache() override;
 	const char* GetBasedir() const
 	{
 		return basedir;
@@ -124,6 +131,25 @@ protected:
 
 private:
 	bool IsFirstEncounter(const std::string& filename);
+
+	// Negative host filesystem probe cache: remembers DOS paths that
+	// recently failed to resolve, so the bursts of probes DOS programs
+	// issue for nonexistent files (overlays, config fallbacks) don't
+	// each hit the host filesystem. Entries expire after a short TTL so
+	// files created outside the emulator are still picked up.
+	bool IsCachedNegativeProbe(const std::string& dos_name);
+	void CacheNegativeProbe(const std::string& dos_name);
+	void ForgetNegativeProbe(const std::string& dos_name);
+
+	std::unordered_map<std::string, int64_t> negative_probe_cache = {};
+	uint64_t negative_probe_hits = 0;
+
+	// Native host change watch: invalidates just the directories changed
+	// outside the emulator instead of relying on a manual RESCAN
+	// (nullptr on hosts without a watch backend)
+	void PollHostWatch();
+	FsWatch* host_watch = nullptr;
+
 	bool always_open_ro_files;
 	std::unordered_set<std::string> write_protected_files;
 	struct {
@@ -245,6 +271,15 @@ public:
 private:
 	uint32_t getClusterValue(uint32_t clustNum);
 	void setClusterValue(uint32_t clustNum, uint32_t clustValue);
+
+	// A run of contiguous clusters within a cluster chain; see
+	// getChainExtents() in drive_fat.cpp
+	struct ChainExtent {
+		uint32_t logical_start = 0; // chain index of the run's first cluster
+		uint32_t first_cluster = 0; // cluster number opening the run
+		uint32_t cluster_count = 0;
+	};
+	const std::vector<ChainExtent>& getChainExtents(uint32_t startClustNum);
 	uint32_t getClustFirstSect(uint32_t clustNum);
 	bool FindNextInternal(uint32_t dirClustNumber, DOS_DTA & dta, direntry *foundEntry);
 	bool getDirClustNum(char * dir, uint32_t * clustNum, bool parDir);
@@ -267,6 +302,10 @@ private:
 
 	uint8_t fatSectBuffer[1024];
 	uint32_t curFatSect;
+
+	// Cluster-chain extents keyed by the chain's first cluster; dropped
+	// whenever the FAT is written
+	std::unordered_map<uint32_t, std::vector<ChainExtent>> chain_extent_cache = {};
 };
 
 class cdromDrive final : public localDrive
@@ -433,6 +472,24 @@ private:
 		uint8_t data[ISO_FRAMESIZE];
 	} sectorHashEntries[ISO_MAX_HASH_TABLE_SIZE];
 
+	// Mount-time path index: maps normalised full paths to their
+	// directory records so path resolution needs no sector I/O once the
+	// build has finished. Built by a background thread so MOUNT returns
+	// immediately; until the index is ready, lookups fall back to
+	// walking the directory sectors.
+	void BuildPathIndex();
+
+	std::unordered_map<std::string, isoDirEntry> path_index = {};
+	std::atomic<bool> path_index_ready = false;
+
+	// Set by UnMount to stop the builder before the MSCDEX interface it
+	// reads through is deleted
+	std::atomic<bool> path_index_cancel = false;
+
+	std::thread path_index_builder     = {};
+	std::mutex read_mutex              = {};
+	uint64_t path_index_hits           = 0;
+
 	bool iso;
 	bool dataCD;
 	isoDirEntry rootEntry;
@@ -68,6 +68,18 @@ public:
 
 	void Process(const bool is_stereo, AudioFrame &frame);
 
+	// Block variant: applies the envelope in-place to interleaved stereo
+	// frames. Deactivates through the same pointer swap as the per-frame
+	// form, so a finished envelope costs one call per block.
+	void Process(const bool is_stereo, float* interleaved_out,
+	             const int num_frames);
+
+	// True once the envelope has expired and Process is a no-op
+	bool IsDone() const
+	{
+		return is_done;
+	}
+
 	void Update(const int frame_rate, const int peak_amplitude,
 	            const uint8_t expansion_phase_ms,
 	            const uint8_t expire_after_seconds);
@@ -85,9 +97,21 @@ private:
 	void Skip([[maybe_unused]] bool is_stereo, [[maybe_unused]] AudioFrame &frame)
 	{}
 
+	void ApplyBlock(const bool is_stereo, float* interleaved_out,
+	                const int num_frames);
+
+	void SkipBlock([[maybe_unused]] bool is_stereo,
+	               [[maybe_unused]] float* interleaved_out,
+	               [[maybe_unused]] int num_frames)
+	{}
+
 	using process_f = std::function<void(Envelope &, const bool, AudioFrame &)>;
 	process_f process = &Envelope::Apply;
 
+	using process_block_f =
+	        std::function<void(Envelope &, const bool, float *, const int)>;
+	process_block_f process_block = &Envelope::ApplyBlock;
+
 	std::string channel_name = {};
 
 	int expire_after_frames = 0; // Stop enveloping when this many
@@ -102,6 +126,8 @@ private:
 	                             // sample is found to be beyond it.
 	float edge_limit = 0.0f;     // Stop enveloping when the current edge is
 	                             // hits or exceeds this limit.
+
+	bool is_done = false; // Set once process switches over to Skip.
 };
 
 #endif
@@ -170,10 +170,43 @@ union FatAttributeFlags; // forward declaration
 
 FILE* local_drive_create_file(const std_fs::path& path,
                               const FatAttributeFlags attributes);
+
+// Clone the full contents of one open file into another using the fastest
+// mechanism the host filesystem offers (reflinks, server-side copy).
+// Returns false when no such mechanism is available, in which case the
+// destination is left empty and the caller should fall back to a buffered
+// copy.
+bool local_drive_clone_file(FILE* src_file, FILE* dst_file);
 uint16_t local_drive_create_dir(const std_fs::path& path);
 uint16_t local_drive_get_attributes(const std_fs::path& path,
                                     FatAttributeFlags& attributes);
 uint16_t local_drive_set_attributes(const std_fs::path& path,
                                     const FatAttributeFlags attributes);
 
+// ***************************************************************************
+// Native directory change watching
+// ***************************************************************************
+
+// Watches a mounted host directory tree so drive caches can invalidate just
+// the directories that changed on the host, instead of staying stale until a
+// manual RESCAN wipes and re-enumerates everything. Backed by inotify on
+// Linux and ReadDirectoryChangesW on Windows; on other hosts fs_watch_open
+// returns nullptr and callers keep today's behaviour.
+
+struct FsWatch;
+
+// Start watching the tree rooted at base_dir; nullptr when unsupported
+FsWatch* fs_watch_open(const std_fs::path& base_dir);
+
+// Register one directory of the watched tree. Needed on hosts whose watches
+// are per-directory (inotify); a no-op where the base watch already covers
+// the whole subtree. Safe to call repeatedly for the same directory.
+void fs_watch_add_dir(FsWatch* watch, const std_fs::path& dir);
+
+// Drain pending events without blocking; returns the host paths of
+// directories whose contents changed since the last poll
+std::vector<std::string> fs_watch_poll(FsWatch* watch);
+
+void fs_watch_close(FsWatch* watch);
+
 #endif
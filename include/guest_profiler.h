@@ -0,0 +1,41 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DOSBOX_GUEST_PROFILER_H
+#define DOSBOX_GUEST_PROFILER_H
+
+#include <string>
+
+// Sampling profiler for guest code: a recurring PIC event records the
+// guest's CS:IP plus the CPU core that was executing it into a histogram.
+// Unlike Tracy (include/tracy.h) this sees guest addresses, so a slow
+// title can be split into guest-bound versus emulator-bound without
+// attaching host tools. Controlled by the [cpu] 'sampling_profiler'
+// setting; dumped by the debugger's PROFDUMP command and on exit.
+void GUESTPROF_Start(const int rate_hz);
+void GUESTPROF_Stop();
+
+// Writes the histogram in the collapsed-stack format flamegraph tools
+// accept, one "dosbox;<core>;<cs>:<ip> <count>" line per bucket. Returns
+// false if the file could not be written. Counts are cumulative; dumping
+// does not reset them.
+bool GUESTPROF_Dump(const std::string& path);
+
+#endif
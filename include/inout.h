@@ -72,6 +72,30 @@ void IO_FreeWriteHandler(io_port_t port,
                          io_width_t max_width,
                          io_port_t range = 1);
 
+// Bulk string IO: a device whose data port is backed by an internal FIFO
+// (such as the IDE PIO sector buffer) can register a handler that moves up
+// to 'items' units of the given width between the FIFO and guest memory at
+// 'addr' in one call, returning how many units it moved. The REP INSW/OUTSW
+// paths in the cores resolve whole transfers through these handlers instead
+// of dispatching one port access per unit; ports without a handler (or a
+// handler returning fewer units than requested) keep the per-unit path for
+// the remainder.
+using io_str_read_f = std::function<size_t(io_port_t port, uint32_t addr,
+                                           size_t items, io_width_t width)>;
+using io_str_write_f = std::function<size_t(io_port_t port, uint32_t addr,
+                                            size_t items, io_width_t width)>;
+
+void IO_RegisterStringReadHandler(io_port_t port, const io_str_read_f& handler);
+void IO_RegisterStringWriteHandler(io_port_t port, const io_str_write_f& handler);
+void IO_FreeStringReadHandler(io_port_t port);
+void IO_FreeStringWriteHandler(io_port_t port);
+
+// Both return 0 when no string handler is registered for the port
+size_t IO_StringReadPort(io_port_t port, uint32_t addr, size_t items,
+                         io_width_t width);
+size_t IO_StringWritePort(io_port_t port, uint32_t addr, size_t items,
+                          io_width_t width);
+
 /* Classes to manage the IO objects created by the various devices.
  * The io objects will remove itself on destruction.*/
 class IO_Base{
@@ -140,4 +164,7 @@ constexpr io_port_t port_num_virtualbox = 0x5654u;
 constexpr io_port_t port_num_vmware    = 0x5658u;
 constexpr io_port_t port_num_vmware_hb = 0x5659u; // high bandwidth
 
+// Paravirtual performance counter interface
+constexpr io_port_t port_num_perfcounter = 0x5660u;
+
 #endif
@@ -32,7 +32,8 @@ struct packetBuffer {
 	bool waitsize;
 };
 
-#define SOCKETTABLESIZE 16
+// Maximum number of simultaneously connected clients the server relays for
+#define SOCKETTABLESIZE 32
 #define CONVIP(hostvar) hostvar & 0xff, (hostvar >> 8) & 0xff, (hostvar >> 16) & 0xff, (hostvar >> 24) & 0xff
 #define CONVIPX(hostvar) hostvar[0], hostvar[1], hostvar[2], hostvar[3], hostvar[4], hostvar[5]
 
@@ -46,6 +46,23 @@ enum LOG_SEVERITIES {
 	LOG_ERROR
 };
 
+// Optional asynchronous log backend (src/misc/logging.cpp). While active,
+// the loguru-routed macros below do a single vsnprintf into a fixed-size
+// per-thread ring buffer; preamble formatting, sink locking and the actual
+// write happen on a background drain thread, keeping chatty device logging
+// out of emulation frame time. Controlled by the 'async_logging' setting.
+void LOG_StartAsync();
+void LOG_StopAsync();
+
+// Async-aware frontends backing the macros below; these fall straight
+// through to loguru until LOG_StartAsync() switches the backend
+void LOG_Info(const char* format, ...)
+        GCC_ATTRIBUTE(__format__(__printf__, 1, 2));
+void LOG_Warn(const char* format, ...)
+        GCC_ATTRIBUTE(__format__(__printf__, 1, 2));
+void LOG_Err(const char* format, ...)
+        GCC_ATTRIBUTE(__format__(__printf__, 1, 2));
+
 #if C_DEBUG
 class LOG 
 { 
@@ -82,14 +99,26 @@ void GFX_ShowMsg(const char* format, ...)
         GCC_ATTRIBUTE(__format__(__printf__, 1, 2));
 
 // Keep for compatibility
-#define LOG_MSG(...)	LOG_F(INFO, __VA_ARGS__)
+#define LOG_MSG(...)	LOG_Info(__VA_ARGS__)
 
-#define LOG_INFO(...)		LOG_F(INFO, __VA_ARGS__)
-#define LOG_WARNING(...)	LOG_F(WARNING, __VA_ARGS__)
-#define LOG_ERR(...)		LOG_F(ERROR, __VA_ARGS__)
+#define LOG_INFO(...)		LOG_Info(__VA_ARGS__)
+#define LOG_WARNING(...)	LOG_Warn(__VA_ARGS__)
+#define LOG_ERR(...)		LOG_Err(__VA_ARGS__)
 
 #endif // C_DEBUG
 
+// Compile-time site filter for the LOG(type, severity) macro above: a site
+// logging below the threshold drops out of the build entirely, argument
+// evaluation included. Override from the build, for example with
+// -DLOG_COMPILE_MIN_SEVERITY=LOG_WARN, to strip per-instruction chatter
+// from a binary while keeping warnings and errors. The LOG inside the
+// expansion refers to the class above and is not expanded again.
+#ifndef LOG_COMPILE_MIN_SEVERITY
+#define LOG_COMPILE_MIN_SEVERITY LOG_NORMAL
+#endif
+#define LOG(type, severity) \
+	if ((severity) < LOG_COMPILE_MIN_SEVERITY) {} else LOG(type, severity)
+
 #ifdef NDEBUG
 // LOG_DEBUG exists only for messages useful during development, and not to
 // be redirected into internal DOSBox debugger for DOS programs (C_DEBUG feature).
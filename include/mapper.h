@@ -77,9 +77,16 @@ void MAPPER_DisplayUI();
 void MAPPER_LosingFocus();
 bool MAPPER_IsUsingJoysticks();
 std::vector<std::string> MAPPER_GetEventNames(const std::string &prefix);
+
+// Directly activates or deactivates a mapper event by name, bypassing any
+// key bindings; used by the event log replay engine. 'value' is the axis
+// position for continuous events (key events use 0x7fff when pressed).
+void MAPPER_InjectEvent(const std::string& event_name, bool active, int32_t value);
 void MAPPER_AutoType(std::vector<std::string> &sequence,
                      const uint32_t wait_ms,
                      const uint32_t pacing_ms);
 void MAPPER_CheckEvent(SDL_Event *event);
+void MAPPER_GetEventDispatchStats(uint64_t& num_events, uint64_t& total_us,
+                                  uint64_t& max_us);
 
 #endif
@@ -44,6 +44,12 @@ uint16_t MEM_GetMaxMegabytes();
 bool MEM_A20_Enabled();
 void MEM_A20_Enable(bool enable);
 
+// Opt-in kernel same-page merging support for multi-instance hosting (see
+// the 'mergeable_memory' setting); all three are no-ops except on Linux.
+void MEM_AdviseMergeable(void* address, size_t num_bytes, const char* description);
+uint64_t MEM_GetMergeableAdvisedBytes();
+uint64_t MEM_GetKsmMergedPages(); // from /proc/self/ksm_stat, 0 if unavailable
+
 /* Memory management / EMS mapping */
 HostPt MEM_GetBlockPage();
 uint32_t MEM_FreeTotal();                      // free 4 KB pages
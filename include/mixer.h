@@ -225,6 +225,10 @@ public:
 	void SetChorusLevel(const float level);
 	float GetChorusLevel() const;
 
+	// Smoothed wall time spent mixing this channel's frames, in
+	// microseconds per Mix() call
+	double GetAvgMixTimeMicros() const;
+
 	template <class Type, bool stereo, bool signeddata, bool nativeorder>
 	void AddSamples(const uint16_t len, const Type* data);
 
@@ -272,11 +276,20 @@ private:
 	void ConvertSamples(const Type* data, const uint16_t frames,
 	                    std::vector<float>& out);
 
+	template <class Type, bool stereo>
+	void ConvertSamplesBatch(const Type* data, const uint16_t frames,
+	                         std::vector<float>& out);
+
 	void ConfigureResampler();
 	void ClearResampler();
 	void InitZohUpsamplerState();
 	void InitLerpUpsamplerState();
 
+	bool ConfigurePolyphaseResampler(const uint32_t in_rate,
+	                                 const uint32_t out_rate);
+	void InitPolyphaseState();
+	void PolyphaseResample(const std::vector<float>& in, std::vector<float>& out);
+
 	AudioFrame ApplyCrossfeed(const AudioFrame frame) const;
 
 	std::string name = {};
@@ -294,6 +307,10 @@ private:
 	// Timing on how many samples were needed by the mixer
 	int frames_needed = 0u;
 
+	// Smoothed cost of this channel's Mix() calls, updated on the mixer
+	// thread and read by MIXER.COM
+	std::atomic<double> avg_mix_time_us = 0.0;
+
 	// Previous and next sample fames
 	AudioFrame prev_frame = {};
 	AudioFrame next_frame = {};
@@ -367,6 +384,24 @@ private:
 		SpeexResamplerState* state = nullptr;
 	} speex_resampler = {};
 
+	// Table-driven polyphase resampler used instead of speex when the
+	// channel-to-mixer rate ratio reduces to a small rational (see
+	// ConfigurePolyphaseResampler)
+	struct {
+		bool enabled           = false;
+		uint32_t interp_factor = 0; // 'L', also the number of phases
+		uint32_t decim_factor  = 0; // 'M'
+		uint32_t phase         = 0;
+		uint32_t num_taps      = 0;
+
+		// num_taps coefficients per phase, phases stored contiguously
+		std::vector<float> table = {};
+
+		// Ring of the last num_taps input frames
+		std::vector<AudioFrame> history = {};
+		size_t history_pos              = 0;
+	} polyphase = {};
+
 	struct {
 		struct {
 			std::array<Iir::Butterworth::HighPass<max_filter_order>, 2> hpf = {};
@@ -409,6 +444,7 @@ private:
 		        const uint16_t sleep_after_ms = default_wait_ms);
 		bool ConfigureFadeOut(const std::string_view prefs);
 		AudioFrame MaybeFadeOrListen(const AudioFrame& frame);
+		void MaybeFadeOrListen(float* interleaved, const uint16_t frames);
 		void MaybeSleep();
 		bool WakeUp();
 
@@ -450,6 +486,23 @@ void MIXER_AddConfigSection(const config_ptr_t& conf);
 uint16_t MIXER_GetSampleRate();
 uint16_t MIXER_GetPreBufferMs();
 
+// Occupancy of the audio output buffer relative to the configured low and
+// high watermarks; used as feedback by the auto cycle-adjusting code
+enum class AudioBufferLevel {
+	BelowLowWatermark,
+	BetweenWatermarks,
+	AboveHighWatermark,
+};
+AudioBufferLevel MIXER_GetBufferLevel();
+
+// Number of audio callbacks that bailed out for lack of mixed frames,
+// leaving an audible gap; reported by the telemetry endpoint
+uint32_t MIXER_GetUnderrunCount();
+
+// Cumulative time spent in the reverb and chorus master stages;
+// reported by the telemetry endpoint
+void MIXER_GetEffectsStats(uint64_t& reverb_us, uint64_t& chorus_us);
+
 const AudioFrame MIXER_GetMasterVolume();
 void MIXER_SetMasterVolume(const AudioFrame volume);
 
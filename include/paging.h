@@ -95,8 +95,21 @@ void PAGING_ClearTLB();
 void PAGING_LinkPage(uint32_t lin_page,uint32_t phys_page);
 void PAGING_LinkPage_ReadOnly(uint32_t lin_page,uint32_t phys_page);
 void PAGING_UnlinkPages(Bitu lin_page,Bitu pages);
+/* Unlink only the linked TLB entries that resolve into the given physical
+   page range; cheaper than PAGING_ClearTLB when a small physical window
+   (such as the EMS page frame) is remapped */
+void PAGING_UnlinkPhysPages(Bitu phys_page,Bitu pages);
+/* Drop only the TLB entries covering the given linear byte range
+   (bounds inclusive); cheaper than PAGING_ClearTLB when a small window
+   changes, where the full clear would force a relink storm */
+void PAGING_InvalidateRange(Bitu lin_start,Bitu lin_end);
+/* Single-page variant, the form INVLPG needs */
+void PAGING_InvalidatePage(Bitu lin_addr);
 /* This maps the page directly, only use when paging is disabled */
 void PAGING_MapPage(Bitu lin_page,Bitu phys_page);
+/* Swap in the precomputed first-megabyte table for the given A20 gate
+   state; only the wraparound window's TLB entries are invalidated */
+void PAGING_SelectA20Table(const bool a20_enabled);
 bool PAGING_MakePhysPage(Bitu & page);
 bool PAGING_ForcePageInit(Bitu lin_addr);
 
@@ -230,7 +243,15 @@ struct PagingBlock {
 		std::vector<uint32_t> entries = std::vector<uint32_t>(PAGING_LINKS);
 	} links = {};
 
-	std::vector<uint32_t> firstmb = std::vector<uint32_t>(LINK_START);
+	// Both A20 gate states keep a fully precomputed first-megabyte page
+	// table; `firstmb` points at the active one, so toggling the gate is
+	// a pointer swap (see PAGING_SelectA20Table). Index 0 holds the
+	// wrapped (A20 disabled) mapping, index 1 the enabled one; the two
+	// only differ in the HMA window's entries
+	std::vector<uint32_t> firstmb_tables[2] = {
+	        std::vector<uint32_t>(LINK_START),
+	        std::vector<uint32_t>(LINK_START)};
+	uint32_t* firstmb = firstmb_tables[0].data();
 	bool enabled = false;
 };
 
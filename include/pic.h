@@ -65,12 +65,20 @@ static inline double PIC_FullIndex()
 void PIC_ActivateIRQ(uint8_t irq);
 void PIC_DeActivateIRQ(uint8_t irq);
 
+// Called whenever the guest EOIs IRQ 0, so the PIT can measure the guest
+// timer handler's duration and feed it the next banked tick when interrupt
+// batching is engaged (see timer.cpp)
+void PIC_SetIRQ0EOIHandler(void (*handler)());
+
 void PIC_runIRQs();
 bool PIC_RunQueue();
 
 //Delay in milliseconds
 void PIC_AddEvent(PIC_EventHandler handler, double delay, uint32_t val = 0);
 void PIC_RemoveEvents(PIC_EventHandler handler);
+
+// Number of events currently scheduled; reported by the telemetry endpoint
+uint32_t PIC_QueueDepth();
 void PIC_RemoveSpecificEvents(PIC_EventHandler handler, uint32_t val);
 
 void PIC_SetIRQMask(uint32_t irq, bool masked);
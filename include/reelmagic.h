@@ -32,7 +32,9 @@ struct ReelMagic_PlayerConfiguration;
 struct ReelMagic_PlayerAttributes;
 struct ReelMagic_VideoMixerMPEGProvider {
 	virtual ~ReelMagic_VideoMixerMPEGProvider() {}
-	virtual void OnVerticalRefresh(void* const outputBuffer, const float fps) = 0;
+	// Returns true when the MPEG picture in outputBuffer was rewritten so
+	// the mixer knows whether previously composed output is still valid
+	virtual bool OnVerticalRefresh(void* const outputBuffer, const float fps) = 0;
 	virtual const ReelMagic_PlayerConfiguration& GetConfig() const = 0;
 	virtual const ReelMagic_PlayerAttributes& GetAttrs() const     = 0;
 };
@@ -75,8 +75,14 @@ struct RenderPal_t {
 
 	bool changed          = false;
 	uint8_t modified[256] = {};
-	uint32_t first        = 0;
-	uint32_t last         = 0;
+
+	// Entries written since the last check_palette() pass. Unlike the
+	// coarse first..last span, this is per-entry, so cycling a handful
+	// of scattered colours only recomputes those lookup table entries.
+	uint8_t dirty[256] = {};
+
+	uint32_t first = 0;
+	uint32_t last  = 0;
 };
 
 struct Render_t {
@@ -114,10 +120,34 @@ struct Render_t {
 	bool active    = false;
 	bool fullFrame = true;
 
+	// Headless operation: skip line generation and frame updates
+	// entirely unless a capture is requesting frames
+	bool headless = false;
+
 	std::string current_shader_name = {};
 	bool force_reload_shader        = false;
 };
 
+// Pooled frame-sized buffer allocations for RenderedImage deep copies and
+// rendered-output readbacks. Released buffers are recycled through
+// power-of-two size classes, so steady-state capture never hits the heap and
+// a video mode change reuses the buffers of any earlier mode that rounds up
+// to the same class. Thread-safe: the capture workers release buffers that
+// the emulation thread acquired.
+uint8_t* RENDER_AcquireFrameBuffer(const uint32_t num_bytes);
+void RENDER_ReleaseFrameBuffer(uint8_t* buffer);
+
+// Counters for verifying the zero-allocation steady state in the unit tests
+struct RenderFrameBufferPoolStats {
+	// Buffers that had to be newly allocated from the heap
+	uint32_t heap_allocations = 0;
+
+	// Acquisitions served by recycling a pooled buffer
+	uint32_t pool_reuses = 0;
+};
+
+RenderFrameBufferPoolStats RENDER_GetFrameBufferPoolStats();
+
 // A frame of the emulated video output that's passed to the rendering backend
 // or to the image and video capturers.
 //
@@ -156,7 +186,7 @@ struct RenderedImage {
 		const auto image_data_num_bytes = static_cast<uint32_t>(
 		        params.height * pitch);
 
-		copy.image_data = new uint8_t[image_data_num_bytes];
+		copy.image_data = RENDER_AcquireFrameBuffer(image_data_num_bytes);
 
 		assert(image_data);
 		std::memcpy(copy.image_data, image_data, image_data_num_bytes);
@@ -165,7 +195,7 @@ struct RenderedImage {
 		// on the size and alignment of the palette...
 		if (palette_data) {
 			constexpr uint16_t PaletteNumBytes = 256 * 4;
-			copy.palette_data = new uint8_t[PaletteNumBytes];
+			copy.palette_data = RENDER_AcquireFrameBuffer(PaletteNumBytes);
 
 			std::memcpy(copy.palette_data, palette_data, PaletteNumBytes);
 		}
@@ -174,10 +204,10 @@ struct RenderedImage {
 
 	void free()
 	{
-		delete[] image_data;
+		RENDER_ReleaseFrameBuffer(image_data);
 		image_data = nullptr;
 
-		delete[] palette_data;
+		RENDER_ReleaseFrameBuffer(palette_data);
 		palette_data = nullptr;
 	}
 };
@@ -206,6 +236,12 @@ void RENDER_SetSize(const ImageInfo& image_info, const double frames_per_second)
 bool RENDER_StartUpdate(void);
 void RENDER_EndUpdate(bool abort);
 
+// Advance past the current scanline without supplying source data.
+// Only legal when the caller knows the line's source bytes are unchanged
+// since the last frame; returns false when the renderer needs the real
+// data after all (first frame, palette change, capture in progress).
+bool RENDER_MaybeSkipLine();
+
 void RENDER_SetPalette(const uint8_t entry, const uint8_t red,
                        const uint8_t green, const uint8_t blue);
 
@@ -1,7 +1,7 @@
 /*
  *  SPDX-License-Identifier: GPL-2.0-or-later
  *
- *  Copyright (C) 2021-2023  The DOSBox Staging Team
+ *  Copyright (C) 2021-2024  The DOSBox Staging Team
  *
  *  This program is free software; you can redistribute it and/or modify
  *  it under the terms of the GNU General Public License as published by
@@ -25,20 +25,25 @@
 
 /*  RW (Read/Write) Queue
  *  ---------------------
- *  A fixed-size thread-safe queue that blocks both the producer until space is
- *  available, and the consumer until items are available.
+ *  A fixed-size thread-safe queue that blocks the producer until space is
+ *  available and the consumer until items are available.
  *
- *  For optimal performance inside the rwqueue, blocking is accomplished by
- *  putting the thread into the waiting state, then waking it up via notify when
- *  the required conditions are met.
+ *  The queue is a lock-free ring buffer for one producer thread and one
+ *  consumer thread: as long as the ring is neither full nor empty, Enqueue
+ *  and Dequeue only touch atomics and never take the mutex or make a
+ *  syscall. Only when a side runs out of items (or room) does it fall back
+ *  to blocking on a condition variable, and the opposite side only pays for
+ *  a notify when someone is actually waiting.
  *
- *  Producer and consumer thread(s) are expected to simply call the enqueue and
- *  dequeue methods directly without any thread state management.
+ *  Producer and consumer thread(s) are expected to simply call the enqueue
+ *  and dequeue methods directly without any thread state management.
+ *  Stop() may be called from any thread.
  */
 
+#include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <condition_variable>
-#include <deque>
 #include <mutex>
 #include <optional>
 #include <vector>
@@ -46,38 +51,185 @@
 template <typename T>
 class RWQueue {
 private:
-	std::deque<T> queue{}; // faster than: vector, queue, and list
-	std::mutex mutex                  = {};
-	std::condition_variable has_room  = {};
-	std::condition_variable has_items = {};
-	size_t capacity                   = 0;
-	std::atomic<bool> is_running      = true;
-	using difference_t = typename std::vector<T>::difference_type;
+	std::vector<T> ring = {};
+
+	// Monotonically increasing positions; the number of queued items is
+	// (write_pos - read_pos) and the slot of a position p is p % capacity.
+	// write_pos is only advanced by the producer, read_pos only by the
+	// consumer.
+	std::atomic<size_t> write_pos = 0;
+	std::atomic<size_t> read_pos  = 0;
+
+	// The mutex and conditions are only used while a side is blocked
+	// waiting for the other; the waiter counts let the fast paths skip
+	// the notify syscall entirely when nobody is waiting.
+	std::mutex mutex                      = {};
+	std::condition_variable has_room      = {};
+	std::condition_variable has_items     = {};
+	std::atomic<int> num_waiting_to_write = 0;
+	std::atomic<int> num_waiting_to_read  = 0;
+
+	size_t capacity              = 0;
+	std::atomic<bool> is_running = true;
+
+	size_t NumQueued() const
+	{
+		return write_pos.load(std::memory_order_seq_cst) -
+		       read_pos.load(std::memory_order_seq_cst);
+	}
+
+	// Wake the consumer (or producer) if it registered itself as waiting.
+	// The seq_cst fence orders the preceding position store before the
+	// waiter-count load, so either we see the waiter and notify it, or
+	// the waiter (which registers before re-checking the positions under
+	// the mutex) sees our update and never sleeps. The empty lock/unlock
+	// closes the window where the waiter has passed its check but hasn't
+	// started waiting yet.
+	void WakeReader()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (num_waiting_to_read.load(std::memory_order_relaxed) > 0) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+			}
+			has_items.notify_one();
+		}
+	}
+
+	void WakeWriter()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (num_waiting_to_write.load(std::memory_order_relaxed) > 0) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+			}
+			has_room.notify_one();
+		}
+	}
+
+	// Block until the queue is stopped or has room for at least one item.
+	// Returns the current write position, or no value if we're stopped.
+	std::optional<size_t> WaitForRoom()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		num_waiting_to_write.fetch_add(1);
+		has_room.wait(lock, [this] {
+			return !is_running || NumQueued() < capacity;
+		});
+		num_waiting_to_write.fetch_sub(1);
+		if (!is_running) {
+			return {};
+		}
+		return write_pos.load(std::memory_order_relaxed);
+	}
+
+	// Block until the queue is stopped or has at least one item. Returns
+	// the current read position, or no value if we're stopped and drained.
+	std::optional<size_t> WaitForItems()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		num_waiting_to_read.fetch_add(1);
+		has_items.wait(lock, [this] {
+			return !is_running || NumQueued() > 0;
+		});
+		num_waiting_to_read.fetch_sub(1);
+		if (NumQueued() == 0) {
+			return {};
+		}
+		return read_pos.load(std::memory_order_relaxed);
+	}
 
 public:
 	RWQueue()                                      = delete;
 	RWQueue(const RWQueue<T>& other)               = delete;
 	RWQueue<T>& operator=(const RWQueue<T>& other) = delete;
 
-	RWQueue(size_t queue_capacity);
-	void Resize(size_t queue_capacity);
+	RWQueue(size_t queue_capacity)
+	{
+		Resize(queue_capacity);
+	}
 
-	bool IsEmpty();
+	// Resizing is only safe while the producer and consumer are
+	// quiescent, i.e. before the worker threads are started. Queued
+	// items are carried over (up to the new capacity).
+	void Resize(size_t queue_capacity)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		assert(queue_capacity > 0);
+
+		std::vector<T> new_ring(queue_capacity);
+
+		const auto r = read_pos.load(std::memory_order_relaxed);
+		const auto w = write_pos.load(std::memory_order_relaxed);
+
+		const auto num_queued = std::min(w - r, queue_capacity);
+		for (size_t i = 0; i < num_queued; ++i) {
+			new_ring[i] = std::move(ring[(r + i) % capacity]);
+		}
+		ring     = std::move(new_ring);
+		capacity = queue_capacity;
+
+		read_pos.store(0, std::memory_order_relaxed);
+		write_pos.store(num_queued, std::memory_order_relaxed);
+	}
+
+	bool IsEmpty()
+	{
+		return NumQueued() == 0;
+	}
 
 	// non-blocking call
-	bool IsRunning() const;
+	bool IsRunning() const
+	{
+		return is_running;
+	}
 
 	// non-blocking call
-	size_t Size();
+	size_t Size()
+	{
+		return NumQueued();
+	}
 
-	// non-blocking calls
-	void Stop();
+	// Restart a stopped queue. Only safe while the producer and consumer
+	// are quiescent, i.e. before the worker threads are (re)started.
+	void Start()
+	{
+		if (is_running) {
+			return;
+		}
+		mutex.lock();
+		is_running = true;
+		mutex.unlock();
+	}
 
 	// non-blocking call
-	size_t MaxCapacity() const;
+	void Stop()
+	{
+		if (!is_running) {
+			return;
+		}
+		mutex.lock();
+		is_running = false;
+		mutex.unlock();
+
+		// notify the conditions
+		has_items.notify_all();
+		has_room.notify_all();
+	}
 
 	// non-blocking call
-	float GetPercentFull();
+	size_t MaxCapacity() const
+	{
+		return capacity;
+	}
+
+	// non-blocking call
+	float GetPercentFull()
+	{
+		const auto cur_level = static_cast<float>(Size());
+		const auto max_level = static_cast<float>(capacity);
+		return (100.0f * cur_level) / max_level;
+	}
 
 	// Discourage copying into the queue. Instead, use std::move into the
 	// queue to explicitly invalidate the source object to avoid having
@@ -91,7 +243,25 @@ public:
 
 	// If queuing has stopped prior to enqueing, then this will immediately
 	//  return false and the item will not be queued.
-	bool Enqueue(T&& item);
+	bool Enqueue(T&& item)
+	{
+		auto w = write_pos.load(std::memory_order_relaxed);
+
+		// fast path: the ring has room, publish without blocking
+		if (!is_running.load(std::memory_order_acquire) ||
+		    w - read_pos.load(std::memory_order_acquire) >= capacity) {
+			const auto wait_pos = WaitForRoom();
+			if (!wait_pos) {
+				return false;
+			}
+			w = *wait_pos;
+		}
+		ring[w % capacity] = std::move(item);
+		write_pos.store(w + 1, std::memory_order_release);
+
+		WakeReader();
+		return true;
+	}
 
 	// The method potentially blocks until there is at least a single item
 	// in the queue to dequeue.
@@ -99,12 +269,30 @@ public:
 	// If queuing has stopped, this will continue to return item(s) until
 	// none remain in the queue, at which point it returns empty results
 	// as indicated by the <optional> wrapper evaluating as "false".
-	std::optional<T> Dequeue();
+	std::optional<T> Dequeue()
+	{
+		auto r = read_pos.load(std::memory_order_relaxed);
+
+		// fast path: an item is available, take it without blocking
+		if (write_pos.load(std::memory_order_acquire) == r) {
+			const auto wait_pos = WaitForItems();
+			if (!wait_pos) {
+				// stopped and fully drained
+				return {};
+			}
+			r = *wait_pos;
+		}
+		auto item = std::make_optional<T>(std::move(ring[r % capacity]));
+		read_pos.store(r + 1, std::memory_order_release);
+
+		WakeWriter();
+		return item;
+	}
 
 	// Bulk operations move multiple items from/to the given vector, which
-	// signficantly reduces the number of mutex lock state changes. It also
-	// uses references-to-vectors, such that they can be reused for the
-	// entire lifetime of the application, avoiding costly repeated memory
+	// significantly reduces the per-item overhead. It also uses
+	// references-to-vectors, such that they can be reused for the entire
+	// lifetime of the application, avoiding costly repeated memory
 	// reallocation.
 
 	// The number of requested items can exceed the capacity of the queue
@@ -123,7 +311,41 @@ public:
 	// this will immediately return false. The items queued /before/
 	// stopping will be available in the queue however the items that came
 	// after stopping will not be queued.
-	bool BulkEnqueue(std::vector<T>& from_source, const size_t num_requested);
+	bool BulkEnqueue(std::vector<T>& from_source, const size_t num_requested)
+	{
+		constexpr size_t min_items = 1;
+		assert(num_requested >= min_items);
+		assert(num_requested <= from_source.size());
+
+		auto source_start  = from_source.begin();
+		auto num_remaining = num_requested;
+
+		while (num_remaining > 0 && is_running) {
+			auto w = write_pos.load(std::memory_order_relaxed);
+			auto num_free = capacity -
+			                (w - read_pos.load(std::memory_order_acquire));
+			if (num_free == 0) {
+				const auto wait_pos = WaitForRoom();
+				if (!wait_pos) {
+					break;
+				}
+				w        = *wait_pos;
+				num_free = capacity - (w - read_pos.load());
+			}
+			const auto num_items = std::min(num_remaining, num_free);
+
+			for (size_t i = 0; i < num_items; ++i) {
+				ring[(w + i) % capacity] = std::move(*source_start);
+				++source_start;
+			}
+			write_pos.store(w + num_items, std::memory_order_release);
+			num_remaining -= num_items;
+
+			WakeReader();
+		}
+		from_source.clear();
+		return is_running;
+	}
 
 	// The target vector will be resized to accomodate, if needed. The
 	// method potentially blocks until the requested number of items have
@@ -134,7 +356,48 @@ public:
 	//  - Returns false when no items can be dequeued.
 	//
 	// The vector is always sized to match the number of items returned.
-	bool BulkDequeue(std::vector<T>& into_target, const size_t num_requested);
+	bool BulkDequeue(std::vector<T>& into_target, const size_t num_requested)
+	{
+		constexpr size_t min_items = 1;
+		assert(num_requested >= min_items);
+
+		if (into_target.size() != num_requested) {
+			into_target.resize(num_requested);
+		}
+
+		auto target_start  = into_target.begin();
+		auto num_remaining = num_requested;
+
+		while (num_remaining > 0) {
+			auto r = read_pos.load(std::memory_order_relaxed);
+			auto num_queued = write_pos.load(std::memory_order_acquire) - r;
+			if (num_queued == 0) {
+				const auto wait_pos = WaitForItems();
+				if (!wait_pos) {
+					// stopped and drained: cap off the
+					// target vector based on the subset
+					// that were dequeued
+					assert(num_remaining <= num_requested);
+					into_target.resize(num_requested -
+					                   num_remaining);
+					break;
+				}
+				r          = *wait_pos;
+				num_queued = write_pos.load() - r;
+			}
+			const auto num_items = std::min(num_remaining, num_queued);
+
+			for (size_t i = 0; i < num_items; ++i) {
+				*target_start = std::move(ring[(r + i) % capacity]);
+				++target_start;
+			}
+			read_pos.store(r + num_items, std::memory_order_release);
+			num_remaining -= num_items;
+
+			WakeWriter();
+		}
+		return !into_target.empty();
+	}
 };
 
 #endif
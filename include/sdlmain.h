@@ -29,6 +29,10 @@
 
 #if C_OPENGL
 #include <SDL_opengl.h>
+
+// Depth of the persistent-mapped pixel buffer ring used for OpenGL
+// frame texture uploads
+constexpr int NumPboBuffers = 3;
 #endif
 
 #include "fraction.h"
@@ -284,6 +288,25 @@ struct SDL_Block {
 
 		GLuint actual_frame_count;
 		GLfloat vertex_data[2 * 3];
+
+		// GPU palette expansion state; when active, the frame is
+		// uploaded as an 8-bit indexed texture and the shader
+		// resolves the colours through a 256x1 palette texture
+		bool use_indexed_texture = false;
+		GLuint palette_texture   = 0;
+		bool palette_dirty       = false;
+		uint8_t palette_data[256 * 4] = {};
+
+		// Persistent-mapped pixel buffer ring; when active, RENDER
+		// writes frames straight into GPU-visible memory and texture
+		// uploads overlap with emulation, paced by fence syncs
+		bool pbo_funcs_ok = false;
+		bool use_pbo_ring = false;
+		int pbo_index     = 0;
+
+		GLuint pbo_buffers[NumPboBuffers] = {};
+		void* pbo_maps[NumPboBuffers]     = {};
+		void* pbo_fences[NumPboBuffers]   = {};
 	} opengl = {};
 #endif // C_OPENGL
 
@@ -272,6 +272,11 @@ public:
 	// depratched
 	// connected device checks, if port can receive data:
 	bool CanReceiveByte();
+
+	// How many bytes the receive FIFO can still take. More than one
+	// only while the guest has the 16550 FIFOs switched on, in which
+	// case a peripheral may deliver a whole chunk per event.
+	size_t rxFifoFree();
 	
 	// when THR was shifted to TX
 	void ByteTransmitting();
@@ -24,8 +24,10 @@
 
 #include "dosbox.h"
 
+#include <cassert>
 #include <cstdio>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -181,6 +183,22 @@ public:
 		return default_value.type;
 	}
 
+	// Register a callback invoked whenever the config system assigns this
+	// property a new value (a config file parse or the runtime 'config
+	// -set' path), so modules can follow a setting instead of caching a
+	// copy and re-reading it by hand in Change_Config
+	void OnChange(std::function<void(const Value&)> callback)
+	{
+		changed_callbacks.emplace_back(std::move(callback));
+	}
+
+	void NotifyChanged() const
+	{
+		for (const auto& callback : changed_callbacks) {
+			callback(value);
+		}
+	}
+
 protected:
 	virtual bool ValidateValue(const Value& in);
 
@@ -194,6 +212,9 @@ protected:
 	const Changeable::Value change                         = {};
 	typedef std::vector<Value>::const_iterator const_iter;
 
+private:
+	std::vector<std::function<void(const Value&)>> changed_callbacks = {};
+
 private:
 	void MaybeSetBoolValid(const std::string_view value);
 };
@@ -360,6 +381,15 @@ class PropMultiValRemain;
 class Section_prop final : public Section {
 private:
 	std::deque<Property*> properties = {};
+
+	// Case-insensitive name index over 'properties'; names are fixed once
+	// a section is set up, so property lookups need not walk the deque
+	// comparing strings
+	std::map<std::string, Property*> property_index = {};
+
+	// Registers the property in the name index and takes ownership
+	Property* RegisterProperty(Property* prop);
+
 	typedef std::deque<Property*>::iterator it;
 	typedef std::deque<Property*>::const_iterator const_it;
 
@@ -397,6 +427,10 @@ public:
 
 	Property* Get_prop(int index);
 
+	// Case-insensitive name lookup; returns nullptr when the section has
+	// no property of that name
+	Property* FindProp(const std::string& propname) const;
+
 	int Get_int(const std::string& _propname) const;
 
 	std::string Get_string(const std::string& _propname) const;
@@ -423,6 +457,40 @@ public:
 	std::string GetPropValue(const std::string& property) const override;
 };
 
+// Typed handle to one section property: the name lookup happens once when
+// the handle is resolved, after that Get() is a pointer load plus value
+// fetch. Combine with OnChange() to follow runtime changes to the setting
+// instead of caching a copy by hand.
+template <typename T>
+class PropHandle {
+public:
+	PropHandle() = default;
+
+	PropHandle(Section_prop* section, const std::string& propname)
+	        : prop(section ? section->FindProp(propname) : nullptr)
+	{}
+
+	bool IsValid() const
+	{
+		return prop != nullptr;
+	}
+
+	T Get() const
+	{
+		assert(prop);
+		return static_cast<T>(prop->GetValue());
+	}
+
+	void OnChange(std::function<void(const Value&)> callback) const
+	{
+		assert(prop);
+		prop->OnChange(std::move(callback));
+	}
+
+private:
+	Property* prop = nullptr;
+};
+
 class PropMultiVal : public Property {
 protected:
 	std::unique_ptr<Section_prop> section;
@@ -0,0 +1,53 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DOSBOX_SNAPSHOT_H
+#define DOSBOX_SNAPSHOT_H
+
+#include "dosbox.h"
+
+#include <cstdint>
+#include <vector>
+
+// In-memory machine snapshots, for quickly returning a running title to
+// an earlier point (for example a QA test point) without rebooting it.
+//
+// The engine itself captures the CPU register file and all of guest RAM;
+// device modules opt in by registering a pair of save/load callbacks, so
+// coverage can grow module by module without touching this interface.
+
+// Saves the module's state by appending it to 'state'
+using SNAPSHOT_SaveHandler = void (*)(std::vector<uint8_t>& state);
+
+// Restores the module's state; returns false if 'state' is not understood
+using SNAPSHOT_LoadHandler = bool (*)(const std::vector<uint8_t>& state);
+
+void SNAPSHOT_AddModule(const char* name, SNAPSHOT_SaveHandler save,
+                        SNAPSHOT_LoadHandler load);
+
+// Captures the current machine state, replacing any previous snapshot.
+// Captures after the first one only store pages that have changed.
+void SNAPSHOT_Capture();
+
+// Returns the machine to the captured state; returns false if no
+// snapshot has been taken or a module rejected its saved state
+bool SNAPSHOT_Restore();
+
+#endif
@@ -285,6 +285,74 @@ std::vector<std::string> split_with_empties(std::string_view seq, char delim);
 std::vector<std::string> split(std::string_view seq,
                                std::string_view delims = " \f\n\r\t\v");
 
+// Non-allocating counterpart of split(): a lightweight range over the words
+// of a string view, usable in range-for without creating any intermediate
+// strings or vectors. The backing string must outlive the iteration.
+//
+// For example, iterating SplitView("  a   b c") yields "a", "b", "c".
+class SplitView {
+public:
+	SplitView(const std::string_view seq,
+	          const std::string_view delims = " \f\n\r\t\v")
+	        : seq(seq),
+	          delims(delims)
+	{}
+
+	class Iterator {
+	public:
+		Iterator() = default;
+		Iterator(const std::string_view seq, const std::string_view delims)
+		        : seq(seq),
+		          delims(delims),
+		          head(seq.find_first_not_of(delims, 0))
+		{
+			if (head != std::string_view::npos) {
+				tail = seq.find_first_of(delims, head);
+			}
+		}
+
+		std::string_view operator*() const
+		{
+			return seq.substr(head, tail - head);
+		}
+
+		Iterator& operator++()
+		{
+			head = seq.find_first_not_of(delims, tail);
+			if (head != std::string_view::npos) {
+				tail = seq.find_first_of(delims, head);
+			}
+			return *this;
+		}
+
+		// Only meaningful against the end() sentinel
+		bool operator!=(const Iterator& other) const
+		{
+			return (head != std::string_view::npos) !=
+			       (other.head != std::string_view::npos);
+		}
+
+	private:
+		std::string_view seq            = {};
+		std::string_view delims         = {};
+		std::string_view::size_type head = std::string_view::npos;
+		std::string_view::size_type tail = std::string_view::npos;
+	};
+
+	Iterator begin() const
+	{
+		return Iterator(seq, delims);
+	}
+	Iterator end() const
+	{
+		return Iterator();
+	}
+
+private:
+	std::string_view seq    = {};
+	std::string_view delims = {};
+};
+
 std::string join_with_commas(const std::vector<std::string>& items,
                              const std::string_view and_conjunction = "and",
                              const std::string_view end_punctuation = ".");
@@ -365,12 +433,20 @@ std::optional<float> parse_percentage_with_optional_percent_sign(const std::stri
 template <typename... Args>
 std::string format_string(const std::string& format, const Args&... args) noexcept
 {
-	// Perform a non-writing format to determine the size
-	const auto required_size = std::snprintf(nullptr, 0, format.c_str(), args...);
+	// Most formatted strings are short, so format into a stack buffer
+	// first; the common case then costs a single formatting pass and a
+	// single allocation for the returned string.
+	char buf[256];
+	const auto required_size = std::snprintf(buf, sizeof(buf), format.c_str(),
+	                                         args...);
 	if (required_size <= 0) {
 		return {};
 	}
+	if (static_cast<size_t>(required_size) < sizeof(buf)) {
+		return std::string(buf, static_cast<size_t>(required_size));
+	}
 
+	// The rare oversized result gets an exact-size second pass.
 	// snprintf's length parameter specifies the maximum number of
 	// characters to be written without the trailing null. However, it still
 	// writes the trailing null into the buffer, so we need to include that
@@ -390,4 +466,22 @@ std::string format_string(const std::string& format, const Args&... args) noexce
 	return result;
 }
 
+// Format directly into a caller-provided fixed-size buffer and return a view
+// of the formatted text, valid for as long as the buffer is. Non-allocating
+// counterpart of format_string() for per-frame and per-I/O paths; output
+// that does not fit in the buffer is truncated.
+template <size_t N, typename... Args>
+std::string_view format_to(char (&dst)[N], const char* format,
+                           const Args&... args) noexcept
+{
+	static_assert(N != 0, "zero-length arrays are not supported");
+	const auto written = std::snprintf(dst, N, format, args...);
+	if (written <= 0) {
+		dst[0] = '\0';
+		return {};
+	}
+	const auto len = static_cast<size_t>(written);
+	return {dst, (len < N) ? len : N - 1};
+}
+
 #endif
@@ -0,0 +1,34 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DOSBOX_TELEMETRY_H
+#define DOSBOX_TELEMETRY_H
+
+#include <string>
+
+// Opt-in local stats endpoint: a Unix domain socket that answers every
+// connection with one JSON snapshot of the emulator's runtime counters
+// (cycles, presented/skipped frames, audio underruns, PIC queue depth,
+// dynamic core cache occupancy) and closes. Started from the [dosbox]
+// section's 'telemetry_socket' setting; does nothing on Windows.
+void TELEMETRY_StartServer(const std::string& socket_path);
+void TELEMETRY_StopServer();
+
+#endif
@@ -119,6 +119,13 @@ static inline int64_t GetTicksUs()
 	        .count();
 }
 
+static inline int64_t GetTicksNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+	               std::chrono::steady_clock::now() - system_start_time)
+	        .count();
+}
+
 static inline int64_t GetTicksDiff(const int64_t new_ticks, const int64_t old_ticks)
 {
 	assert(new_ticks >= old_ticks);
@@ -147,4 +154,23 @@ static inline void DelayUs(const int64_t microseconds)
 	std::this_thread::sleep_for(std::chrono::microseconds(microseconds));
 }
 
+// Sleeps until the given GetTicksNs() deadline using an absolute-deadline
+// OS wait (clock_nanosleep with TIMER_ABSTIME on Linux, a high-resolution
+// waitable timer on Windows), so the time spent reaching the call and the
+// per-sleep quantization error don't push the wakeup back. Returns
+// immediately if the deadline has already passed.
+void DelayUntilTicksNs(const int64_t deadline_ns);
+
+// Like DelayUntilTicksNs, but accurate to well under 100 microseconds: the
+// bulk of the wait is the OS deadline sleep, and the last stretch (which
+// the OS may overshoot by a scheduler quantum) is finished with a yielding
+// spin. Only use this where the precision is worth burning a core for up
+// to the spin margin - never in a periodic fast path.
+void DelayUntilTicksNsPrecise(const int64_t deadline_ns);
+
+static inline void DelayPreciseUs(const int64_t microseconds)
+{
+	DelayUntilTicksNsPrecise(GetTicksNs() + microseconds * 1000);
+}
+
 #endif
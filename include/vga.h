@@ -268,6 +268,13 @@ struct VgaDraw {
 	uint32_t parts_left     = 0;
 	Bitu byte_panning_shift = 0;
 
+	// Adaptive partitioning: once enough consecutive frames pass without
+	// mid-frame palette or display start writes, the per-part draw events
+	// are collapsed into a single whole-frame event. The first write
+	// observed during active display reverts to fine parts.
+	bool whole_frame_active    = false;
+	uint32_t quiet_frame_count = 0;
+
 	struct {
 		double framestart = 0;
 		double vrstart = 0, vrend = 0;     // V-retrace
@@ -879,6 +886,11 @@ struct VgaAttr {
 	uint8_t color_plane_enable     = 0;
 	uint8_t color_select           = 0;
 
+	// Set when a register write invalidated the combined palette-to-DAC
+	// mappings; the full recompute is deferred to the next drawn line so a
+	// storm of writes around the retrace pays for it only once.
+	bool palette_mappings_dirty = false;
+
 	// Used for disabling the screen.
 	//
 	// Bit0: screen disabled by attribute controller index
@@ -1003,6 +1015,27 @@ struct VgaLfb {
 	PageHandler* handler = nullptr;
 };
 
+// Accumulates the range of video memory bytes written by the guest since
+// the start of the last frame, in the same address space the drawing code
+// uses for vga.draw.address. The memory write handlers in vga_memory.cpp
+// feed the range and vga_draw.cpp latches it once per frame to skip
+// converting and re-scaling scanlines whose source bytes are unchanged.
+struct VgaDirty {
+	// Inclusive dirty byte range; empty while first > last
+	uint32_t first = UINT32_MAX;
+	uint32_t last  = 0;
+
+	// True when the current mode routes all guest writes through the
+	// instrumented page handlers. Modes that map video memory directly
+	// into the guest (e.g. the linear framebuffer) can't track writes,
+	// so their frames are always treated as fully dirty.
+	bool handled_writes = false;
+
+	// Force a full redraw of the next frame regardless of the range
+	// (mode changes, bank switching, and other out-of-band updates)
+	bool all = true;
+};
+
 struct VgaType {
 	// The mode the vga system is in
 	VGAModes mode = {};
@@ -1038,8 +1071,19 @@ struct VgaType {
 	VgaChanges changes = {};
 #endif
 
+	VgaDirty dirty = {};
+
 	VgaLfb lfb = {};
 
+	// Set while INT10_SetVideoMode programs the full register set in one
+	// go; memory handler rebuilds (and their paging TLB clears) are
+	// deferred until the batch closes instead of running after every
+	// port write that touches the memory configuration.
+	struct {
+		bool active         = false;
+		bool wants_handlers = false;
+	} mode_program = {};
+
 	// Composite video mode parameters
 	struct {
 		int32_t ri = 0;
@@ -1079,6 +1123,17 @@ void VGA_SetMonochromeCgaPalette();
 void VGA_SetMode(VGAModes mode);
 void VGA_DetermineMode(void);
 void VGA_SetupHandlers(void);
+
+// Bracket a batched register program (a full INT10 mode set): handler
+// rebuilds requested inside the bracket are coalesced into a single
+// VGA_SetupHandlers call when the batch ends.
+void VGA_BeginModeProgram();
+void VGA_EndModeProgram();
+
+// Re-protect the video memory pages that were handed a direct TLB write
+// mapping by the write-combining handlers, so their next write traps and
+// marks them dirty again. Called once per frame at vertical retrace.
+void VGA_RearmWriteCombinedPages(void);
 const char* to_string(const VGAModes mode);
 
 void VGA_StartResize();
@@ -1088,6 +1143,11 @@ void VGA_SetupDrawing(uint32_t val);
 void VGA_CheckScanLength(void);
 void VGA_ChangedBank(void);
 
+// Wait for the parallel line-drawing worker to finish any in-flight
+// scanlines; required before mutating state it reads (e.g. the DAC
+// palette map). No-op when the worker is idle or disabled.
+void VGA_ParallelDrawSync();
+
 const VideoMode& VGA_GetCurrentVideoMode();
 
 // DAC/Attribute functions
@@ -1098,6 +1158,10 @@ void VGA_DAC_SetEntry(const uint8_t color_idx, const uint8_t red,
 
 void VGA_ATTR_SetPalette(const uint8_t index, const PaletteRegister value);
 
+// Applies a deferred palette-mapping recompute, if one is pending; called by
+// the draw handlers before any line is rendered.
+void VGA_ATTR_FlushPaletteUpdates();
+
 enum class EgaMonitorMode { Cga, Ega, Mono };
 
 void VGA_ATTR_SetEGAMonitorPalette(const EgaMonitorMode m);
@@ -1133,6 +1197,19 @@ void VGA_SetCGA4Table(uint8_t val0, uint8_t val1, uint8_t val2, uint8_t val3);
 PixelFormat VGA_ActivateHardwareCursor();
 void VGA_KillDrawing(void);
 
+// Tell the text mode drawers their cached glyph pixels went stale, i.e.
+// the font RAM content or the active font table selection changed
+void VGA_InvalidateTextGlyphCache();
+
+// Tell the draw code a register affecting the displayed picture (DAC palette,
+// CRTC display start) was written; a write landing mid-frame indicates a
+// raster effect and disables whole-frame drawing until the writes go quiet.
+void VGA_NotifyMidFrameChange();
+
+// Scanlines run through the composite NTSC filter and the accumulated time
+// spent in it, for the telemetry endpoint
+void VGA_GetCompositeFilterStats(uint64_t& num_lines, uint64_t& total_us);
+
 void VGA_SetOverride(const bool vga_override, const double override_refresh_hz = 0);
 void VGA_LogInitialization(const char* adapter_name, const char* ram_type,
                            const size_t num_modes);
@@ -1143,6 +1220,23 @@ void VGA_EnablePixelDoubling(const bool enabled);
 
 extern VgaType vga;
 
+// Record a guest write of 'len' bytes into video memory at 'offset'
+// (draw address space); cheap enough for the per-write handler paths.
+inline void VGA_MarkVramDirty(const uint32_t offset, const uint32_t len)
+{
+	if (offset < vga.dirty.first) {
+		vga.dirty.first = offset;
+	}
+	if (offset + len - 1 > vga.dirty.last) {
+		vga.dirty.last = offset + len - 1;
+	}
+}
+
+inline void VGA_MarkAllVramDirty()
+{
+	vga.dirty.all = true;
+}
+
 // Support for modular SVGA implementation
 
 /* Video mode extra data to be passed to FinishSetMode_SVGA().
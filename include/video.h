@@ -368,6 +368,10 @@ constexpr uint8_t GFX_CAN_RANDOM = 1 << 6; // interface can also do random acces
 // - false means event loop wants to quit.
 bool GFX_Events();
 
+// Cumulative counts of frames presented to and skipped by the host
+// presentation path; reported by the telemetry endpoint
+void GFX_GetFrameCounts(int64_t& num_presented, int64_t& num_skipped);
+
 // Let the presentation layer safely call no-op functions.
 // Useful during output initialization or transitions.
 void GFX_DisengageRendering();
@@ -375,6 +379,11 @@ void GFX_DisengageRendering();
 uint8_t GFX_GetBestMode(const uint8_t flags);
 uint32_t GFX_GetRGB(const uint8_t red, const uint8_t green, const uint8_t blue);
 
+// Palette updates for the indexed (8-bit) output path; entries are 4 bytes
+// per colour with the 4th byte unused, matching the RenderPal_t layout
+void GFX_UpdatePalette(const uint8_t* rgbx_data, const uint16_t first,
+                       const uint16_t count);
+
 struct ShaderInfo;
 
 void GFX_SetShader(const ShaderInfo& shader_info, const std::string& shader_source);
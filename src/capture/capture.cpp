@@ -60,6 +60,7 @@ static struct {
 		int32_t video              = 1;
 		int32_t image              = 1;
 		int32_t serial_log         = 1;
+		int32_t mapper_event_log   = 1;
 	} next_index = {};
 } capture = {};
 
@@ -112,6 +113,8 @@ static const char* capture_type_to_string(const CaptureType type)
 
 	case CaptureType::SerialLog: return "serial log";
 
+	case CaptureType::MapperEventLog: return "mapper event log";
+
 	default: assertm(false, "Unknown CaptureType"); return "";
 	}
 }
@@ -132,6 +135,8 @@ static const char* capture_type_to_basename(const CaptureType type)
 
 	case CaptureType::SerialLog: return "serial";
 
+	case CaptureType::MapperEventLog: return "events";
+
 	default: assertm(false, "Unknown CaptureType"); return "";
 	}
 }
@@ -152,6 +157,8 @@ static const char* capture_type_to_extension(const CaptureType type)
 
 	case CaptureType::SerialLog: return ".serlog";
 
+	case CaptureType::MapperEventLog: return ".evl";
+
 	default: assertm(false, "Unknown CaptureType"); return "";
 	}
 }
@@ -246,6 +253,10 @@ static void set_next_capture_index(const CaptureType type, int32_t index)
 		capture.next_index.serial_log = index;
 		break;
 
+	case CaptureType::MapperEventLog:
+		capture.next_index.mapper_event_log = index;
+		break;
+
 	default: assertm(false, "Unknown CaptureType");
 	}
 }
@@ -270,7 +281,8 @@ static bool maybe_create_capture_dir_and_init_capture_indices()
 	                                             CaptureType::RawImage,
 	                                             CaptureType::UpscaledImage,
 	                                             CaptureType::RenderedImage,
-	                                             CaptureType::SerialLog};
+	                                             CaptureType::SerialLog,
+	                                             CaptureType::MapperEventLog};
 
 	for (auto type : all_capture_types) {
 		const auto index = find_highest_capture_index(type);
@@ -310,6 +322,9 @@ int32_t get_next_capture_index(const CaptureType type)
 
 	case CaptureType::SerialLog: return capture.next_index.serial_log++;
 
+	case CaptureType::MapperEventLog:
+		return capture.next_index.mapper_event_log++;
+
 	default: assertm(false, "Unknown CaptureType"); return 0;
 	}
 }
@@ -38,7 +38,8 @@ enum class CaptureType {
 	RawImage,
 	UpscaledImage,
 	RenderedImage,
-	SerialLog
+	SerialLog,
+	MapperEventLog
 };
 
 enum class CaptureState { Off, Pending, InProgress };
@@ -23,22 +23,32 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 
 #include "mem.h"
+#include "rwqueue.h"
 #include "setup.h"
+#include "support.h"
 
 static constexpr auto SampleFrameSize   = 4;
 static constexpr auto NumFramesInBuffer = 16 * 1024;
 static constexpr auto NumChannels       = 2;
 
+// Bounds the memory held in flight between the mixer and the writer
+// thread; the mixer blocks on a full queue, which is the same
+// backpressure the old synchronous writes applied, just much rarer
+static constexpr auto MaxQueuedChunks = 16;
+
 static struct {
 	FILE* handle = nullptr;
 
-	uint16_t buf[NumFramesInBuffer][NumChannels] = {};
+	// Staging chunk the mixer path appends to; handed to the writer
+	// thread wholesale once full
+	std::vector<int16_t> chunk = {};
 
 	uint32_t sample_rate        = 0;
-	uint32_t buf_frames_used    = 0;
-	
+
 	// TODO A 16-bit / 44.1kHz WAV file is limited to a bit less than 4GB
 	// worth of sample data because the chunk sizes are stored as 32-bit
 	// unsigned integers in the RIFF container the WAV format uses.
@@ -54,6 +64,22 @@ static struct {
 	uint32_t data_bytes_written = 0;
 } wave = {};
 
+// The WAV sample data is little-endian 16-bit, which matches the mixer's
+// native frames, so the writer thread can fwrite the chunks unmodified.
+// Writes are chunk-sized (64 KB) and happen off the mixer path, so they
+// no longer contend with video capture for synchronous disk time.
+static RWQueue<std::vector<int16_t>> write_fifo{MaxQueuedChunks};
+static std::thread writer = {};
+
+static void write_queued_chunks()
+{
+	while (auto chunk = write_fifo.Dequeue()) {
+		const auto bytes_to_write = chunk->size() * sizeof(int16_t);
+		fwrite(chunk->data(), 1, bytes_to_write, wave.handle);
+		wave.data_bytes_written += static_cast<uint32_t>(bytes_to_write);
+	}
+}
+
 // clang-format off
 static uint8_t wav_header[] = {
 	'R',  'I',  'F',  'F',   // uint32 - RIFF chunk ID
@@ -80,10 +106,15 @@ static void create_wave_file(const uint32_t sample_rate)
 	}
 
 	wave.sample_rate        = sample_rate;
-	wave.buf_frames_used    = 0;
 	wave.data_bytes_written = 0;
+	wave.chunk.clear();
+	wave.chunk.reserve(NumFramesInBuffer * NumChannels);
 
 	fwrite(wav_header, 1, sizeof(wav_header), wave.handle);
+
+	write_fifo.Start();
+	writer = std::thread(write_queued_chunks);
+	set_thread_name(writer, "dosbox:audcap");
 }
 
 void capture_audio_add_data(const uint32_t sample_rate,
@@ -100,29 +131,27 @@ void capture_audio_add_data(const uint32_t sample_rate,
 	const int16_t* data   = sample_frames;
 	auto remaining_frames = num_sample_frames;
 
-	while (remaining_frames > 0) {
-		uint32_t frames_left = NumFramesInBuffer - wave.buf_frames_used;
-		if (!frames_left) {
-			const auto bytes_to_write = NumFramesInBuffer * SampleFrameSize;
-			fwrite(wave.buf, 1, bytes_to_write, wave.handle);
+	constexpr uint32_t samples_per_chunk = NumFramesInBuffer * NumChannels;
 
-			wave.data_bytes_written += bytes_to_write;
-			wave.buf_frames_used = 0;
-
-			frames_left = NumFramesInBuffer;
-		}
-
-		if (frames_left > remaining_frames) {
-			frames_left = remaining_frames;
+	while (remaining_frames > 0) {
+		const auto frames_free = static_cast<uint32_t>(
+		        (samples_per_chunk - wave.chunk.size()) / NumChannels);
+
+		const auto frames_to_copy = std::min(frames_free, remaining_frames);
+		wave.chunk.insert(wave.chunk.end(),
+		                  data,
+		                  data + frames_to_copy * NumChannels);
+
+		data += frames_to_copy * NumChannels;
+		remaining_frames -= frames_to_copy;
+
+		// Hand the full staging chunk to the writer thread and start
+		// a fresh one
+		if (wave.chunk.size() == samples_per_chunk) {
+			write_fifo.Enqueue(std::move(wave.chunk));
+			wave.chunk = {};
+			wave.chunk.reserve(samples_per_chunk);
 		}
-
-		memcpy(&wave.buf[wave.buf_frames_used],
-		       data,
-		       frames_left * SampleFrameSize);
-
-		wave.buf_frames_used += frames_left;
-		data += frames_left * NumChannels;
-		remaining_frames -= frames_left;
 	}
 }
 
@@ -132,10 +161,15 @@ void capture_audio_finalise()
 		return;
 	}
 
-	// Flush audio buffer
-	const auto bytes_to_write = wave.buf_frames_used * SampleFrameSize;
-	fwrite(wave.buf, 1, bytes_to_write, wave.handle);
-	wave.data_bytes_written += bytes_to_write;
+	// Flush the partial staging chunk, then let the writer thread
+	// drain the queue and exit
+	if (!wave.chunk.empty()) {
+		write_fifo.Enqueue(std::move(wave.chunk));
+	}
+	write_fifo.Stop();
+	if (writer.joinable()) {
+		writer.join();
+	}
 
 	// Update headers
 	constexpr auto chunk_header_size = 8;
@@ -23,11 +23,18 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
 
 #include "math_utils.h"
 #include "mem.h"
 #include "render.h"
+#include "rwqueue.h"
 #include "support.h"
+#include "tracy.h"
 
 #include "zmbv/zmbv.h"
 
@@ -38,6 +45,12 @@ static constexpr auto NumAudioChannels = 2;
 
 static constexpr auto AviHeaderSize = 500;
 
+// The index grows by 16 bytes per chunk for the whole session, so it's
+// staged in a fixed-size segment and spilled to a temporary file each
+// time the segment fills; memory use stays constant no matter how long
+// the recording runs.
+static constexpr auto IndexSegmentBytes = 16 * 4096;
+
 static struct {
 	FILE* handle = nullptr;
 
@@ -52,7 +65,8 @@ static struct {
 	uint32_t buf_size          = 0;
 	std::vector<uint8_t> buf   = {};
 	std::vector<uint8_t> index = {};
-	uint32_t index_used        = 0;
+	FILE* index_spill          = nullptr;
+	uint32_t index_bytes       = 0;
 
 	struct {
 		int16_t buf[NumSampleFramesInBuffer][NumAudioChannels] = {};
@@ -63,6 +77,31 @@ static struct {
 	} audio = {};
 } video = {};
 
+// Compression and file writes run on a worker thread so the emulation
+// thread only pays for a frame copy. Frames and audio chunks are queued
+// as work items in submission order; an item carries either a deep-copied
+// frame (freed by the worker, mirroring ImageSaver's contract) or a chunk
+// of interleaved audio sample frames.
+struct VideoWorkItem {
+	std::optional<RenderedImage> image = {};
+	float frames_per_second            = 0.0f;
+
+	uint32_t sample_rate            = 0;
+	std::vector<int16_t> audio_data = {};
+};
+
+static constexpr auto MaxQueuedWorkItems = 256;
+
+// Leave room for the audio chunks that accompany the queued frames; when
+// the encoder falls this far behind, new frames are dropped instead of
+// stalling the emulation thread.
+static constexpr auto FrameDropThreshold = MaxQueuedWorkItems - 64;
+
+static std::unique_ptr<RWQueue<VideoWorkItem>> work_fifo = {};
+static std::thread worker                                = {};
+
+static uint32_t num_dropped_frames = 0;
+
 static ZMBV_FORMAT to_zmbv_format(const PixelFormat format)
 {
 	switch (format) {
@@ -98,6 +137,18 @@ static uint8_t to_bytes_per_pixel(const ZMBV_FORMAT format)
 	return ZMBV_ToBytesPerPixel(format);
 }
 
+// Moves the staged index entries into the spill file. Without a spill
+// file (tmpfile() failed at creation time) the segment simply keeps
+// growing in memory, which is the old behaviour.
+static void flush_index_segment()
+{
+	if (!video.index_spill || video.index.empty()) {
+		return;
+	}
+	fwrite(video.index.data(), 1, video.index.size(), video.index_spill);
+	video.index.clear();
+}
+
 static void add_avi_chunk(const char* tag, const uint32_t size,
                           const void* data, const uint32_t flags)
 {
@@ -119,24 +170,26 @@ static void add_avi_chunk(const char* tag, const uint32_t size,
 	auto pos = video.written + 4;
 	video.written += writesize + 8;
 
-	if (video.index_used + 16 >= video.index.size()) {
-		video.index.resize(video.index.size() + 16 * 4096);
-	}
+	uint8_t entry[16] = {};
+
+	entry[0] = tag[0];
+	entry[1] = tag[1];
+	entry[2] = tag[2];
+	entry[3] = tag[3];
 
-	auto index = video.index.data() + video.index_used;
-	video.index_used += 16;
+	host_writed(entry + 4, flags);
+	host_writed(entry + 8, pos);
+	host_writed(entry + 12, size);
 
-	index[0] = tag[0];
-	index[1] = tag[1];
-	index[2] = tag[2];
-	index[3] = tag[3];
+	video.index.insert(video.index.end(), entry, entry + sizeof(entry));
+	video.index_bytes += sizeof(entry);
 
-	host_writed(index + 4, flags);
-	host_writed(index + 8, pos);
-	host_writed(index + 12, size);
+	if (video.index.size() >= IndexSegmentBytes) {
+		flush_index_segment();
+	}
 }
 
-void capture_video_finalise()
+static void finalise_avi_file()
 {
 	if (!video.handle) {
 		return;
@@ -160,7 +213,7 @@ void capture_video_finalise()
 
 	// Try and write an avi header
 	AVIOUT4("RIFF"); // Riff header
-	AVIOUTd(AviHeaderSize + video.written - 8 + video.index_used);
+	AVIOUTd(AviHeaderSize + video.written - 8 + 8 + video.index_bytes);
 	AVIOUT4("AVI ");
 	AVIOUT4("LIST");
 
@@ -288,10 +341,27 @@ void capture_video_finalise()
 	AVIOUTd(video.written + 4);
 	AVIOUT4("movi");
 
-	// First add the index table to the end
-	memcpy(video.index.data(), "idx1", 4);
-	host_writed(video.index.data() + 4, video.index_used - 8);
-	fwrite(video.index.data(), 1, video.index_used, video.handle);
+	// First add the index table to the end: the chunk header, then the
+	// spilled segments streamed back from the temporary file, then
+	// whatever is still staged in memory
+	uint8_t index_header[8] = {};
+	memcpy(index_header, "idx1", 4);
+	host_writed(index_header + 4, video.index_bytes);
+	fwrite(index_header, 1, sizeof(index_header), video.handle);
+
+	if (video.index_spill) {
+		rewind(video.index_spill);
+
+		uint8_t copy_buf[IndexSegmentBytes];
+		size_t num_read = 0;
+		while ((num_read = fread(copy_buf, 1, sizeof(copy_buf),
+		                         video.index_spill)) > 0) {
+			fwrite(copy_buf, 1, num_read, video.handle);
+		}
+		fclose(video.index_spill);
+		video.index_spill = nullptr;
+	}
+	fwrite(video.index.data(), 1, video.index.size(), video.handle);
 
 	fseek(video.handle, 0, SEEK_SET);
 	fwrite(&avi_header, 1, AviHeaderSize, video.handle);
@@ -301,7 +371,7 @@ void capture_video_finalise()
 	video.handle = nullptr;
 }
 
-void capture_video_add_audio_data(const uint32_t sample_rate,
+static void add_audio_data_to_avi(const uint32_t sample_rate,
                                   const uint32_t num_sample_frames,
                                   const int16_t* sample_frames)
 {
@@ -337,8 +407,15 @@ static void create_avi_file(const uint16_t width, const uint16_t height,
 	video.buf_size = video.codec->NeededSize(width, height, format);
 	video.buf.resize(video.buf_size);
 
-	video.index.resize(16 * 4096);
-	video.index_used = 8;
+	video.index.clear();
+	video.index.reserve(IndexSegmentBytes);
+	video.index_bytes = 0;
+
+	video.index_spill = tmpfile();
+	if (!video.index_spill) {
+		LOG_WARNING("CAPTURE: Could not create a temporary file for "
+		            "the AVI index; keeping the index in memory");
+	}
 
 	video.width             = width;
 	video.height            = height;
@@ -439,8 +516,9 @@ static void compress_raw_frame(const RenderedImage& image)
 	}
 }
 
-void capture_video_add_frame(const RenderedImage& image, const float frames_per_second)
+static void add_frame_to_avi(const RenderedImage& image, const float frames_per_second)
 {
+	ZoneScoped;
 	const auto& src = image.params;
 	assert(src.width <= SCALER_MAXWIDTH);
 
@@ -458,7 +536,7 @@ void capture_video_add_frame(const RenderedImage& image, const float frames_per_
 	if (video.handle && (video.width != raw_width || video.height != raw_height ||
 	                     video.pixel_format != src.pixel_format ||
 	                     video.frames_per_second != frames_per_second)) {
-		capture_video_finalise();
+		finalise_avi_file();
 	}
 
 	const auto zmbv_format = to_zmbv_format(src.pixel_format);
@@ -507,3 +585,95 @@ void capture_video_add_frame(const RenderedImage& image, const float frames_per_
 		video.audio.buf_frames_used = 0;
 	}
 }
+
+static void process_work_items()
+{
+	while (auto item = work_fifo->Dequeue()) {
+		if (item->image) {
+			add_frame_to_avi(*item->image, item->frames_per_second);
+			item->image->free();
+		} else {
+			const auto num_sample_frames = check_cast<uint32_t>(
+			        item->audio_data.size() / NumAudioChannels);
+
+			add_audio_data_to_avi(item->sample_rate,
+			                      num_sample_frames,
+			                      item->audio_data.data());
+		}
+	}
+}
+
+static void start_worker()
+{
+	assert(!work_fifo);
+	work_fifo = std::make_unique<RWQueue<VideoWorkItem>>(MaxQueuedWorkItems);
+
+	worker = std::thread(process_work_items);
+	set_thread_name(worker, "dosbox:vidcap");
+}
+
+void capture_video_add_frame(const RenderedImage& image, const float frames_per_second)
+{
+	if (!work_fifo) {
+		start_worker();
+	}
+	if (!work_fifo->IsRunning()) {
+		return;
+	}
+
+	// Dropping a frame under overload is preferable to stalling the
+	// emulation thread until the encoder catches up.
+	if (work_fifo->Size() >= FrameDropThreshold) {
+		++num_dropped_frames;
+		return;
+	}
+
+	// The frame must be deep-copied as the caller reuses its render
+	// buffers as soon as we return (see ImageSaver for the same contract).
+	VideoWorkItem item     = {};
+	item.image             = image.deep_copy();
+	item.frames_per_second = frames_per_second;
+
+	work_fifo->Enqueue(std::move(item));
+}
+
+void capture_video_add_audio_data(const uint32_t sample_rate,
+                                  const uint32_t num_sample_frames,
+                                  const int16_t* sample_frames)
+{
+	if (!work_fifo) {
+		start_worker();
+	}
+	if (!work_fifo->IsRunning()) {
+		return;
+	}
+
+	VideoWorkItem item = {};
+	item.sample_rate   = sample_rate;
+	item.audio_data.assign(sample_frames,
+	                       sample_frames + num_sample_frames * NumAudioChannels);
+
+	work_fifo->Enqueue(std::move(item));
+}
+
+void capture_video_finalise()
+{
+	// Let the worker drain the remaining work items, then finish the
+	// file on this thread.
+	if (work_fifo) {
+		work_fifo->Stop();
+		if (worker.joinable()) {
+			worker.join();
+		}
+		work_fifo = {};
+	}
+
+	finalise_avi_file();
+
+	if (num_dropped_frames) {
+		LOG_WARNING("CAPTURE: Dropped %u video frames because the "
+		            "encoder could not keep up",
+		            num_dropped_frames);
+		num_dropped_frames = 0;
+	}
+}
@@ -20,8 +20,10 @@
 
 #include "image_capturer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <string>
+#include <thread>
 
 #include "std_filesystem.h"
 
@@ -34,11 +36,24 @@ ImageCapturer::ImageCapturer(const std::string& grouped_mode_prefs)
 {
 	ConfigureGroupedMode(grouped_mode_prefs);
 
-	for (auto& image_saver : image_savers) {
-		image_saver.Open();
+	// At least three savers so the images of a grouped capture (raw,
+	// upscaled, and rendered) are always encoded in parallel; more on
+	// hosts with plenty of cores to soak up capture bursts.
+	constexpr size_t MinImageSavers = 3;
+	constexpr size_t MaxImageSavers = 8;
+
+	const auto num_savers = std::clamp(
+	        static_cast<size_t>(std::thread::hardware_concurrency() / 2),
+	        MinImageSavers,
+	        MaxImageSavers);
+
+	for (size_t i = 0; i < num_savers; ++i) {
+		image_savers.emplace_back();
+		image_savers.back().Open();
 	}
 
-	LOG_MSG("CAPTURE: Image capturer started");
+	LOG_MSG("CAPTURE: Image capturer started with %u workers",
+	        static_cast<uint32_t>(num_savers));
 }
 
 void ImageCapturer::ConfigureGroupedMode(const std::string& prefs)
@@ -195,7 +210,7 @@ void ImageCapturer::CapturePostRenderImage(const RenderedImage& image)
 ImageSaver& ImageCapturer::GetNextImageSaver()
 {
 	++current_image_saver_index;
-	current_image_saver_index %= NumImageSavers;
+	current_image_saver_index %= image_savers.size();
 	return image_savers[current_image_saver_index];
 }
 
@@ -21,7 +21,7 @@
 #ifndef DOSBOX_IMAGE_CAPTURER_H
 #define DOSBOX_IMAGE_CAPTURER_H
 
-#include <array>
+#include <deque>
 #include <string>
 
 #include "std_filesystem.h"
@@ -96,9 +96,12 @@ private:
 
 	std_fs::path rendered_path    = {};
 
-	static constexpr auto NumImageSavers                = 3;
-	size_t current_image_saver_index                    = 0;
-	std::array<ImageSaver, NumImageSavers> image_savers = {};
+	// The savers form a pool so bursts of capture requests (e.g.
+	// screenshotting every step of a scripted run) are encoded in
+	// parallel instead of backing up behind a single worker. A deque is
+	// used because ImageSaver instances cannot be copied or moved.
+	size_t current_image_saver_index  = 0;
+	std::deque<ImageSaver> image_savers = {};
 
 	void ConfigureGroupedMode(const std::string& prefs);
 
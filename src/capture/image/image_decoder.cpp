@@ -20,6 +20,8 @@
 
 #include "image_scaler.h"
 
+#include <cstring>
+
 #include "checks.h"
 
 CHECK_NARROWING();
@@ -63,3 +65,72 @@ void ImageDecoder::AdvanceRow()
 
 	pos = curr_row_start;
 }
+
+void ImageDecoder::DecodeRowToIndexed8(uint8_t* out, const uint16_t num_pixels)
+{
+	assert(image.is_paletted());
+
+	const auto src = curr_row_start;
+
+	if (pixel_skip_count == 0) {
+		std::memcpy(out, src, num_pixels);
+		return;
+	}
+
+	const auto advance = pixel_skip_count + 1;
+	for (auto x = 0; x < num_pixels; ++x) {
+		out[x] = src[x * advance];
+	}
+}
+
+void ImageDecoder::DecodeRowToRgb888(Rgb888* out, const uint16_t num_pixels)
+{
+	const auto advance = pixel_skip_count + 1;
+	const auto src     = curr_row_start;
+
+	switch (image.params.pixel_format) {
+	case PixelFormat::Indexed8:
+		for (auto x = 0; x < num_pixels; ++x) {
+			const auto pal_index = src[x * advance];
+
+			out[x] = {image.palette_data[pal_index * 4 + 0],
+			          image.palette_data[pal_index * 4 + 1],
+			          image.palette_data[pal_index * 4 + 2]};
+		}
+		break;
+
+	case PixelFormat::RGB555_Packed16:
+		for (auto x = 0; x < num_pixels; ++x) {
+			const auto p = host_readw(src + x * advance * 2);
+
+			out[x] = Rgb555(p).ToRgb888();
+		}
+		break;
+
+	case PixelFormat::RGB565_Packed16:
+		for (auto x = 0; x < num_pixels; ++x) {
+			const auto p = host_readw(src + x * advance * 2);
+
+			out[x] = Rgb565(p).ToRgb888();
+		}
+		break;
+
+	case PixelFormat::BGR24_ByteArray:
+		for (auto x = 0; x < num_pixels; ++x) {
+			const auto pixel = src + x * advance * 3;
+
+			out[x] = {pixel[2], pixel[1], pixel[0]};
+		}
+		break;
+
+	case PixelFormat::BGRX32_ByteArray:
+		for (auto x = 0; x < num_pixels; ++x) {
+			const auto pixel = src + x * advance * 4;
+
+			out[x] = {pixel[2], pixel[1], pixel[0]};
+		}
+		break;
+
+	default: assertm(false, "Invalid PixelFormat value");
+	}
+}
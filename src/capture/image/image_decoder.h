@@ -72,6 +72,14 @@ public:
 
 	void AdvanceRow();
 
+	// Row-level decode kernels. In contrast to the per-pixel getters
+	// above, whose per-call format dispatch defeats auto-vectorisation,
+	// these switch on the pixel format once and decode the whole row in
+	// tight per-format loops. Both read from the start of the current
+	// row without consuming it; call AdvanceRow() to move on as usual.
+	void DecodeRowToIndexed8(uint8_t* out, const uint16_t num_pixels);
+	void DecodeRowToRgb888(Rgb888* out, const uint16_t num_pixels);
+
 	// prevent copying
 	ImageDecoder(const ImageDecoder&) = delete;
 	// prevent assignment
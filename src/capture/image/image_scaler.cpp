@@ -21,6 +21,7 @@
 #include "image_scaler.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "byteorder.h"
 #include "checks.h"
@@ -221,11 +222,14 @@ void ImageScaler::AllocateBuffers()
 {
 	uint8_t bytes_per_pixel = {};
 	switch (output.pixel_format) {
-	case OutputPixelFormat::Indexed8: bytes_per_pixel = 8; break;
-	case OutputPixelFormat::Rgb888: bytes_per_pixel = 24; break;
+	case OutputPixelFormat::Indexed8: bytes_per_pixel = 1; break;
+	case OutputPixelFormat::Rgb888: bytes_per_pixel = 3; break;
 	default: assert(false);
 	}
 
+	// The buffers are class members so their backing allocations are
+	// retained and reused across captures; resizing only reallocates
+	// when a capture needs larger rows than any previous one.
 	output.row_buf.resize(static_cast<size_t>(output.width) *
 	                      static_cast<size_t>(bytes_per_pixel));
 
@@ -233,6 +237,11 @@ void ImageScaler::AllocateBuffers()
 	// without branching (the interpolator operates on the current and the
 	// next pixel).
 	linear_row_buf.resize((input.params.width + 1u) * ComponentsPerRgbPixel);
+
+	// Scratch rows for the row-level decode kernels; like the row buffers
+	// above, the backing allocations persist across captures.
+	indexed_row_buf.resize(input.params.width);
+	rgb_row_buf.resize(input.params.width);
 }
 
 uint16_t ImageScaler::GetOutputWidth() const
@@ -252,10 +261,13 @@ OutputPixelFormat ImageScaler::GetOutputPixelFormat() const
 
 void ImageScaler::DecodeNextRowToLinearRgb()
 {
-	auto out = linear_row_buf.begin();
+	input_decoder.DecodeRowToRgb888(rgb_row_buf.data(), input.params.width);
+
+	auto out           = linear_row_buf.begin();
+	const auto rgb_row = rgb_row_buf.data();
 
 	for (auto x = 0; x < input.params.width; ++x) {
-		const auto pixel = input_decoder.GetNextPixelAsRgb888();
+		const auto& pixel = rgb_row[x];
 
 		*out++ = srgb8_to_linear_lut(pixel.red);
 		*out++ = srgb8_to_linear_lut(pixel.green);
@@ -276,26 +288,68 @@ void ImageScaler::SetRowRepeat()
 	}
 }
 
-void ImageScaler::GenerateNextIntegerUpscaledOutputRow()
+// Writes each input element `N` times to the output row; the compile-time
+// replication factor lets the compiler unroll and vectorise the common
+// small scales.
+template <uint32_t N, typename T>
+static void repeat_row_elements_n(const T* in, T* out, const uint16_t num_elems)
 {
-	auto out = output.row_buf.begin();
-
-	for (auto x = 0; x < input.params.width; ++x) {
-		auto pixels_to_write = static_cast<uint32_t>(output.horiz_scale);
+	for (auto x = 0; x < num_elems; ++x) {
+		for (uint32_t i = 0; i < N; ++i) {
+			*out++ = in[x];
+		}
+	}
+}
 
-		if (input.is_paletted()) {
-			const auto pixel = input_decoder.GetNextIndexed8Pixel();
-			while (pixels_to_write--) {
-				*out++ = pixel;
+template <typename T>
+static void repeat_row_elements(const T* in, T* out, const uint16_t num_elems,
+                                const uint32_t factor)
+{
+	switch (factor) {
+	case 1: std::memcpy(out, in, num_elems * sizeof(T)); break;
+	case 2: repeat_row_elements_n<2>(in, out, num_elems); break;
+	case 3: repeat_row_elements_n<3>(in, out, num_elems); break;
+	case 4: repeat_row_elements_n<4>(in, out, num_elems); break;
+	case 5: repeat_row_elements_n<5>(in, out, num_elems); break;
+	default:
+		for (auto x = 0; x < num_elems; ++x) {
+			for (uint32_t i = 0; i < factor; ++i) {
+				*out++ = in[x];
 			}
+		}
+	}
+}
+
+void ImageScaler::GenerateNextIntegerUpscaledOutputRow()
+{
+	const auto num_pixels = input.params.width;
+	const auto scale      = static_cast<uint32_t>(output.horiz_scale);
+
+	if (input.is_paletted()) {
+		// The palette indexes can be replicated as-is; for the 1:1
+		// case the kernel decodes straight into the output row.
+		if (scale == 1) {
+			input_decoder.DecodeRowToIndexed8(output.row_buf.data(),
+			                                  num_pixels);
 		} else {
-			const auto pixel = input_decoder.GetNextPixelAsRgb888();
-			while (pixels_to_write--) {
-				*out++ = pixel.red;
-				*out++ = pixel.green;
-				*out++ = pixel.blue;
-			}
+			input_decoder.DecodeRowToIndexed8(indexed_row_buf.data(),
+			                                  num_pixels);
+
+			repeat_row_elements(indexed_row_buf.data(),
+			                    output.row_buf.data(),
+			                    num_pixels,
+			                    scale);
 		}
+	} else {
+		static_assert(sizeof(Rgb888) == ComponentsPerRgbPixel,
+		              "Rgb888 rows must be tightly packed");
+
+		input_decoder.DecodeRowToRgb888(rgb_row_buf.data(), num_pixels);
+
+		repeat_row_elements(rgb_row_buf.data(),
+		                    reinterpret_cast<Rgb888*>(output.row_buf.data()),
+		                    num_pixels,
+		                    scale);
 	}
 
 	input_decoder.AdvanceRow();
@@ -114,6 +114,11 @@ private:
 
 	std::vector<float> linear_row_buf = {};
 
+	// Scratch rows the row-level decode kernels write into before the
+	// horizontal replication step
+	std::vector<uint8_t> indexed_row_buf = {};
+	std::vector<Rgb888> rgb_row_buf      = {};
+
 	struct {
 		uint16_t width  = 0;
 		uint16_t height = 0;
@@ -91,6 +91,20 @@ static Bitu stop_handler(void) {
 	return CBRET_STOP;
 }
 
+Bits CALLBACK_RunDirect(const Bitu cb_num)
+{
+	if (GCC_UNLIKELY(cb_num >= CB_MAX)) {
+		// Same quiet unwind the machine loop performed for
+		// out-of-range numbers: a biased CBRET_NONE
+		return static_cast<Bits>(CB_MAX);
+	}
+	const Bitu ret = (*CallBack_Handlers[cb_num])();
+	if (GCC_UNLIKELY(ret != CBRET_NONE)) {
+		return static_cast<Bits>(CB_MAX + ret);
+	}
+	return CBRET_NONE;
+}
+
 
 
 void CALLBACK_RunRealFar(uint16_t seg,uint16_t off) {
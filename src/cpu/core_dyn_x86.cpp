@@ -255,6 +255,7 @@ static void dyn_restoreregister(DynReg * src_reg, DynReg * dst_reg) {
 }
 
 #include "core_dyn_x86/decoder.h"
+#include "dyn_warmup_replay.h"
 
 #	if defined(X86_DYNFPU_DH_ENABLED)
 
@@ -330,18 +331,27 @@ restart_core:
 #endif
 #endif
 	CodePageHandler * chandler=nullptr;
-	if (GCC_UNLIKELY(MakeCodePage(ip_point,chandler))) {
-		CPU_Exception(cpu.exception.which,cpu.exception.error);
-		goto restart_core;
-	}
-	if (!chandler) {
-		return sync_dh_fpu_and_run_normal_core();
+	/* Indirect transfers (returns above all) usually land on already
+	   translated code: consult the branch-target buffer before walking
+	   the page's block list */
+	CacheBlock * block=dyn_btb_lookup(ip_point);
+	if (GCC_LIKELY(block != nullptr)) {
+		chandler=block->page.handler;
+	} else {
+		if (GCC_UNLIKELY(MakeCodePage(ip_point,chandler))) {
+			CPU_Exception(cpu.exception.which,cpu.exception.error);
+			goto restart_core;
+		}
+		if (!chandler) {
+			return sync_dh_fpu_and_run_normal_core();
+		}
+		/* Find correct Dynamic Block to run */
+		block=chandler->FindCacheBlock(ip_point&4095);
 	}
-	/* Find correct Dynamic Block to run */
-	CacheBlock * block=chandler->FindCacheBlock(ip_point&4095);
 	if (!block) {
 		if (!chandler->invalidation_map || (chandler->invalidation_map[ip_point&4095]<4)) {
 			block=CreateCacheBlock(chandler,ip_point,32);
+			warmup_code_page(chandler, ip_point);
 		} else {
 			int32_t old_cycles=CPU_Cycles;
 			CPU_Cycles=1;
@@ -353,9 +363,11 @@ restart_core:
 				goto restart_core;
 			}
 			CPU_CycleLeft+=old_cycles;
-			return nc_retcode; 
+			return nc_retcode;
 		}
 	}
+	/* Remember the resolution for the next indirect transfer here */
+	dyn_btb_insert(ip_point,chandler,block);
 run_block:
 	cache.block.running=nullptr;
 	const auto ret = sync_normal_fpu_and_run_dyn_code(block->cache.start);
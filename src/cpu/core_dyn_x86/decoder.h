@@ -1901,8 +1901,10 @@ static void dyn_exit_link(Bits eip_change) {
 	gen_protectflags();
 	gen_dop_word_imm(DOP_ADD,decode.big_op,DREG(EIP),(decode.code-decode.code_start)+eip_change);
 	dyn_reduce_cycles();
+	gen_setup_linked_regs();
 	dyn_save_critical_regs();
-	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start));
+	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start_linked));
+	gen_finish_linked_regs();
 	dyn_closeblock();
 }
 
@@ -1910,6 +1912,7 @@ static void dyn_branched_exit(BranchTypes btype,int32_t eip_add) {
 	Bitu eip_base=decode.code-decode.code_start;
  	gen_needflags();
  	gen_protectflags();
+	gen_setup_linked_regs();
 	dyn_save_noncritical_regs();
 	gen_releasereg(DREG(FLAGS));
 	gen_releasereg(DREG(EIP));
@@ -1926,7 +1929,7 @@ static void dyn_branched_exit(BranchTypes btype,int32_t eip_add) {
  	gen_dop_word_imm(DOP_ADD,decode.big_op,DREG(EIP),eip_base);
 	gen_releasereg(DREG(CYCLES));
  	gen_releasereg(DREG(EIP));
- 	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start));
+ 	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start_linked));
  	gen_fill_branch(data);
 
  	/* Branch taken */
@@ -1936,7 +1939,8 @@ static void dyn_branched_exit(BranchTypes btype,int32_t eip_add) {
  	gen_dop_word_imm(DOP_ADD,decode.big_op,DREG(EIP),eip_base+eip_add);
 	gen_releasereg(DREG(CYCLES));
  	gen_releasereg(DREG(EIP));
- 	gen_jmp_ptr(&decode.block->link[1].to,offsetof(CacheBlock,cache.start));
+ 	gen_jmp_ptr(&decode.block->link[1].to,offsetof(CacheBlock,cache.start_linked));
+	gen_finish_linked_regs();
  	dyn_closeblock();
 }
 
@@ -1982,8 +1986,10 @@ static void dyn_loop(LoopTypes type) {
 	gen_dop_word_imm(DOP_ADD,decode.big_op,DREG(EIP),eip_add);
 	DynState st;
 	dyn_savestate(&st);
+	gen_setup_linked_regs();
 	dyn_save_critical_regs();
-	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start));
+	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start_linked));
+	gen_finish_linked_regs();
 	dyn_loadstate(&st);
 	if (branch1) {
 		gen_fill_branch(branch1);
@@ -1993,8 +1999,10 @@ static void dyn_loop(LoopTypes type) {
 	gen_fill_branch(branch2);
 	dyn_reduce_cycles();
 	dyn_set_eip_end();
+	gen_setup_linked_regs();
 	dyn_save_critical_regs();
-	gen_jmp_ptr(&decode.block->link[1].to,offsetof(CacheBlock,cache.start));
+	gen_jmp_ptr(&decode.block->link[1].to,offsetof(CacheBlock,cache.start_linked));
+	gen_finish_linked_regs();
 	dyn_closeblock();
 }
 
@@ -2018,8 +2026,10 @@ static void dyn_call_near_imm(void) {
 	if (cpu.code.big) gen_dop_word(DOP_MOV,true,DREG(EIP),DREG(TMPW));
 	else gen_extend_word(false,DREG(EIP),DREG(TMPW));
 	dyn_reduce_cycles();
+	gen_setup_linked_regs();
 	dyn_save_critical_regs();
-	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start));
+	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start_linked));
+	gen_finish_linked_regs();
 	dyn_closeblock();
 }
 
@@ -2212,6 +2222,12 @@ static CacheBlock * CreateCacheBlock(CodePageHandler * codepage,PhysPt start,Bit
 		DynRegs[i].genreg=nullptr;
 	}
 	gen_reinit();
+	/* Load the linked registers, only executed on entry through the
+	   dispatcher; direct jumps from other blocks enter at start_linked
+	   with these registers already set up by the seam of the source
+	   block */
+	gen_load_linked_regs();
+	decode.block->cache.start_linked=cache.pos;
 	gen_save_host_direct(&cache.block.running,(Bitu)decode.block);
 	/* Start with the cycles check */
 	gen_protectflags();
@@ -2899,8 +2915,10 @@ restart_prefix:
 	// link to next block because the maximum number of opcodes has been reached
 	dyn_set_eip_end();
 	dyn_reduce_cycles();
+	gen_setup_linked_regs();
 	dyn_save_critical_regs();
-	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start));
+	gen_jmp_ptr(&decode.block->link[0].to,offsetof(CacheBlock,cache.start_linked));
+	gen_finish_linked_regs();
 	dyn_closeblock();
 	goto finish_block;
 core_close_block:
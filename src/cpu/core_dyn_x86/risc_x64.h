@@ -530,6 +530,59 @@ static void gen_reinit(void) {
 	}
 }
 
+/* linked register contract: the hottest guest registers stay resident in
+   fixed callee-saved host registers across direct block links; the seam
+   synchronizes them with memory and places them in the contract register,
+   the target block enters at cache.start_linked which skips the loads of
+   its dispatcher entry (the register content always matches memory, so
+   every exit to the dispatcher remains correct without extra saves) */
+static const struct {
+	Bitu gri;		// guest register (index into DynRegs)
+	Bitu hri;		// host register it travels in
+} linked_regs[]={
+	{G_EAX,X64_REG_RBX},
+	{G_ESI,X64_REG_R12},
+	{G_EDI,X64_REG_R14},
+};
+
+// load the linked registers; emitted at the start of each block and only
+// executed when the block is entered through the dispatcher
+static void gen_load_linked_regs(void) {
+	for (Bitu i=0;i<sizeof(linked_regs)/sizeof(linked_regs[0]);i++) {
+		x64gen.regs[linked_regs[i].hri]->Load(&DynRegs[linked_regs[i].gri]);
+	}
+}
+
+// place the linked registers into their contract host registers and write
+// changed values back to memory, right before the releases that precede a
+// direct jump to another block; the contract registers are marked
+// unusable so the remaining code of the exit cannot clobber them
+static void gen_setup_linked_regs(void) {
+	for (Bitu i=0;i<sizeof(linked_regs)/sizeof(linked_regs[0]);i++) {
+		GenReg * genreg=x64gen.regs[linked_regs[i].hri];
+		DynReg * dynreg=&DynRegs[linked_regs[i].gri];
+		if (dynreg->genreg==genreg) {
+			if (dynreg->flags&DYNFLG_CHANGED) genreg->Save();
+		} else {
+			if (genreg->dynreg) genreg->Clear();
+			if (dynreg->genreg) {
+				if (dynreg->flags&DYNFLG_CHANGED) dynreg->genreg->Save();
+				opcode(genreg->index).setrm(dynreg->genreg->index).Emit8(0x8B); // mov reg32,reg32
+			} else {
+				opcode(genreg->index).setabsaddr(dynreg->data).Emit8(0x8B); // mov reg32,[]
+			}
+		}
+		genreg->notusable=true;
+	}
+}
+
+// release the contract registers again after the jump has been emitted
+static void gen_finish_linked_regs(void) {
+	for (Bitu i=0;i<sizeof(linked_regs)/sizeof(linked_regs[0]);i++) {
+		x64gen.regs[linked_regs[i].hri]->notusable=false;
+	}
+}
+
 static void gen_load_host(void * data,DynReg * dr1,Bitu size) {
 	opcode op = opcode(FindDynReg(dr1,true)->index).setabsaddr(data);
 	switch (size) {
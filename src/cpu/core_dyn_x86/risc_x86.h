@@ -299,6 +299,60 @@ static void gen_reinit(void) {
 	}
 }
 
+/* linked register contract: the hottest guest registers stay resident in
+   fixed callee-saved host registers across direct block links; the seam
+   synchronizes them with memory and places them in the contract register,
+   the target block enters at cache.start_linked which skips the loads of
+   its dispatcher entry (the register content always matches memory, so
+   every exit to the dispatcher remains correct without extra saves) */
+static const struct {
+	Bitu gri;		// guest register (index into DynRegs)
+	Bitu hri;		// host register it travels in
+} linked_regs[]={
+	{G_EAX,X86_REG_EBX},
+	{G_ESI,X86_REG_ESI},
+	{G_EDI,X86_REG_EDI},
+};
+
+// load the linked registers; emitted at the start of each block and only
+// executed when the block is entered through the dispatcher
+static void gen_load_linked_regs(void) {
+	for (Bitu i=0;i<sizeof(linked_regs)/sizeof(linked_regs[0]);i++) {
+		x86gen.regs[linked_regs[i].hri]->Load(&DynRegs[linked_regs[i].gri]);
+	}
+}
+
+// place the linked registers into their contract host registers and write
+// changed values back to memory, right before the releases that precede a
+// direct jump to another block; the contract registers are marked
+// unusable so the remaining code of the exit cannot clobber them
+static void gen_setup_linked_regs(void) {
+	for (Bitu i=0;i<sizeof(linked_regs)/sizeof(linked_regs[0]);i++) {
+		GenReg * genreg=x86gen.regs[linked_regs[i].hri];
+		DynReg * dynreg=&DynRegs[linked_regs[i].gri];
+		if (dynreg->genreg==genreg) {
+			if (dynreg->flags&DYNFLG_CHANGED) genreg->Save();
+		} else {
+			if (genreg->dynreg) genreg->Clear();
+			if (dynreg->genreg) {
+				if (dynreg->flags&DYNFLG_CHANGED) dynreg->genreg->Save();
+				cache_addw(0xc08b+(genreg->index<<11)+(dynreg->genreg->index<<8));	// mov reg,reg
+			} else {
+				cache_addw(0x058b+(genreg->index<<11));		// mov reg,[data]
+				cache_addd((uint32_t)dynreg->data);
+			}
+		}
+		genreg->notusable=true;
+	}
+}
+
+// release the contract registers again after the jump has been emitted
+static void gen_finish_linked_regs(void) {
+	for (Bitu i=0;i<sizeof(linked_regs)/sizeof(linked_regs[0]);i++) {
+		x86gen.regs[linked_regs[i].hri]->notusable=false;
+	}
+}
+
 
 static void gen_load_host(void * data,DynReg * dr1,Bitu size) {
 	GenReg * gr1=FindDynReg(dr1,true);
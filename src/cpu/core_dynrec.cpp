@@ -182,6 +182,7 @@ static_assert(offsetof(core_dynrec_t, readdata) % sizeof(uint32_t) == 0,
 #endif
 
 #include "core_dynrec/decoder.h"
+#include "dyn_warmup_replay.h"
 
 CacheBlock *LinkBlocks(BlockReturn ret)
 {
@@ -239,24 +240,33 @@ Bits CPU_Core_Dynrec_Run() noexcept
 #endif
 
 		CodePageHandler *chandler = nullptr;
-		// see if the current page is present and contains code
-		if (GCC_UNLIKELY(MakeCodePage(ip_point,chandler))) {
-			// page not present, throw the exception
-			CPU_Exception(cpu.exception.which,cpu.exception.error);
-			continue;
-		}
+		// indirect transfers (returns above all) usually land on
+		// already translated code: consult the branch-target buffer
+		// before walking the page's block list
+		CacheBlock *block = dyn_btb_lookup(ip_point);
+		if (GCC_LIKELY(block != nullptr)) {
+			chandler = block->page.handler;
+		} else {
+			// see if the current page is present and contains code
+			if (GCC_UNLIKELY(MakeCodePage(ip_point,chandler))) {
+				// page not present, throw the exception
+				CPU_Exception(cpu.exception.which,cpu.exception.error);
+				continue;
+			}
 
-		// page doesn't contain code or is special
-		if (GCC_UNLIKELY(!chandler)) return CPU_Core_Normal_Run();
+			// page doesn't contain code or is special
+			if (GCC_UNLIKELY(!chandler)) return CPU_Core_Normal_Run();
 
-		// find correct Dynamic Block to run
-		CacheBlock *block = chandler->FindCacheBlock(ip_point & 4095);
+			// find correct Dynamic Block to run
+			block = chandler->FindCacheBlock(ip_point & 4095);
+		}
 		if (!block) {
 			// no block found, thus translate the instruction stream
 			// unless the instruction is known to be modified
 			if (!chandler->invalidation_map || (chandler->invalidation_map[ip_point&4095]<4)) {
 				// translate up to 32 instructions
 				block=CreateCacheBlock(chandler,ip_point,32);
+				warmup_code_page(chandler, ip_point);
 			} else {
 				// let the normal core handle this instruction to avoid zero-sized blocks
 				Bitu old_cycles=CPU_Cycles;
@@ -269,7 +279,17 @@ Bits CPU_Core_Dynrec_Run() noexcept
 				CPU_CycleLeft+=old_cycles;
 				return nc_retcode;
 			}
+		} else if (GCC_UNLIKELY(!block->is_trace &&
+		                        ++block->hot_count>=trace_hot_threshold)) {
+			// the block keeps getting re-entered through the
+			// dispatcher; retranslate it as a straightened trace
+			// block so more work is done per dispatcher entry
+			block->Clear();
+			make_trace_block=true;
+			block=CreateCacheBlock(chandler,ip_point,trace_max_opcodes);
 		}
+		// remember the resolution for the next indirect transfer here
+		dyn_btb_insert(ip_point,chandler,block);
 
 run_block:
 		cache.block.running=nullptr;
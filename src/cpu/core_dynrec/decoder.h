@@ -42,6 +42,9 @@ static CacheBlock *CreateCacheBlock(CodePageHandler *codepage, PhysPt start, Bit
 	decode.active_block=decode.block=cache_openblock();
 	decode.block->page.start=(uint16_t)decode.page.index;
 	codepage->AddCacheBlock(decode.block);
+	decode.trace=make_trace_block;
+	decode.block->is_trace=decode.trace;
+	make_trace_block=false;
 
 	auto cache_addr = static_cast<void *>(
 	        const_cast<uint8_t *>(decode.block->cache.start));
@@ -63,6 +66,12 @@ static CacheBlock *CreateCacheBlock(CodePageHandler *codepage, PhysPt start, Bit
 
 	decode.cycles=0;
 	while (max_opcodes--) {
+		// close a trace block early once its emitted-code budget is
+		// used up, so the block cannot overrun its cache allotment
+		if (decode.trace &&
+		    (Bitu)(cache.pos-decode.block->cache.start)>=trace_code_limit) {
+			break;
+		}
 		// Init prefixes
 		decode.big_addr=cpu.code.big;
 		decode.big_op=cpu.code.big;
@@ -197,8 +206,14 @@ restart_prefix:
 				case 0x22:dyn_mov_to_crx();goto finish_block;
 
 				// short conditional jumps
-				case 0x80:case 0x81:case 0x82:case 0x83:case 0x84:case 0x85:case 0x86:case 0x87:	
-				case 0x88:case 0x89:case 0x8a:case 0x8b:case 0x8c:case 0x8d:case 0x8e:case 0x8f:	
+				case 0x80:case 0x81:case 0x82:case 0x83:case 0x84:case 0x85:case 0x86:case 0x87:
+				case 0x88:case 0x89:case 0x8a:case 0x8b:case 0x8c:case 0x8d:case 0x8e:case 0x8f:
+					if (decode.trace && max_opcodes>0 &&
+					    used_save_info_dynrec<trace_max_exits) {
+						dyn_branched_side_exit((BranchTypes)(dual_code&0xf),
+							decode.big_op ? (int32_t)decode_fetchd() : (int16_t)decode_fetchw());
+						break;
+					}
 					dyn_branched_exit((BranchTypes)(dual_code&0xf),
 						decode.big_op ? (int32_t)decode_fetchd() : (int16_t)decode_fetchw());
 					goto finish_block;
@@ -300,9 +315,16 @@ restart_prefix:
 //		case 0x6c to 0x6f missing (ins/outs)
 
 		// short conditional jumps
-		case 0x70:case 0x71:case 0x72:case 0x73:case 0x74:case 0x75:case 0x76:case 0x77:	
-		case 0x78:case 0x79:case 0x7a:case 0x7b:case 0x7c:case 0x7d:case 0x7e:case 0x7f:	
-			dyn_branched_exit((BranchTypes)(opcode&0xf),(int8_t)decode_fetchb());	
+		case 0x70:case 0x71:case 0x72:case 0x73:case 0x74:case 0x75:case 0x76:case 0x77:
+		case 0x78:case 0x79:case 0x7a:case 0x7b:case 0x7c:case 0x7d:case 0x7e:case 0x7f:
+			if (decode.trace && max_opcodes>0 &&
+			    used_save_info_dynrec<trace_max_exits) {
+				// straighten the trace: continue along the
+				// not-taken path, exit on the taken one
+				dyn_branched_side_exit((BranchTypes)(opcode&0xf),(int8_t)decode_fetchb());
+				break;
+			}
+			dyn_branched_exit((BranchTypes)(opcode&0xf),(int8_t)decode_fetchb());
 			goto finish_block;
 
 		// 'op []/reg8,imm8'
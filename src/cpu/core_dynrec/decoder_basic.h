@@ -92,6 +92,7 @@ static struct DynDecode {
 	Bitu cycles;			// number cycles used by currently translated code
 	bool seg_prefix_used;	// segment overridden
 	uint8_t seg_prefix;		// segment prefix (if seg_prefix_used==true)
+	bool trace;				// translating a straightened trace block
 
 	// block that contains the first instruction translated
 	CacheBlock *block;
@@ -561,7 +562,20 @@ static inline const uint8_t* gen_call_function_mm(void * func,Bitu op1,Bitu op2)
 
 
 
-enum save_info_type {db_exception, cycle_check, string_break};
+enum save_info_type {db_exception, cycle_check, string_break, branch_taken};
+
+
+// trace formation: blocks that keep coming back to the dispatcher are
+// retranslated as straightened trace blocks where conditional branches
+// fall through inline and the taken path becomes a rarely-executed side
+// exit (see CreateCacheBlock in decoder.h)
+constexpr Bitu trace_hot_threshold = 64;   // dispatcher entries before tracing
+constexpr Bitu trace_max_opcodes   = 64;   // opcode budget for a trace block
+constexpr Bitu trace_max_exits     = 16;   // conditional side exits per trace
+constexpr Bitu trace_code_limit    = CACHE_MAXSIZE / 4; // emitted-code budget
+
+// set by the dispatcher to make the next translation form a trace block
+static bool make_trace_block = false;
 
 
 // function that is called on exceptions
@@ -621,6 +635,12 @@ static void dyn_fill_blocks(void) {
 				gen_add_direct_word(&reg_eip,save_info_dynrec[sct].eip_change,decode.big_op);
 				dyn_return(BR_Cycles);
 				break;
+			case branch_taken:
+				// conditional branch out of a trace block, continue
+				// at the branch target through the dispatcher
+				gen_add_direct_word(&reg_eip,save_info_dynrec[sct].eip_change,cpu.code.big);
+				dyn_return(BR_Normal);
+				break;
 		}
 	}
 	used_save_info_dynrec=0;
@@ -723,6 +743,61 @@ bool DRC_CALL_CONV mem_writed_checked_drc(PhysPt address,uint32_t val) {
 
 // functions that enable access to the memory
 
+#if defined(DRC_USE_INLINE_MEMACCESS)
+// versions for backends that emit the paging-table lookup and the memory
+// access directly into the translated code; the call to the C helper
+// function is only taken for handler-mapped pages and for accesses that
+// cross a page boundary, where it also provides the exception check
+
+// read a byte from a given address and store it in reg_dst
+static void dyn_read_byte(HostReg reg_addr,HostReg reg_dst) {
+	gen_mov_regs(FC_OP1,reg_addr);
+	const uint8_t* fast_jump=gen_mem_read_inline(reg_dst,1,(void *)&mem_readb_checked_drc);
+	dyn_check_exception(FC_RETOP);
+	gen_mov_byte_to_reg_low(reg_dst,&core_dynrec.readdata);
+	gen_fill_short_jump(fast_jump);
+}
+static void dyn_read_byte_canuseword(HostReg reg_addr,HostReg reg_dst) {
+	gen_mov_regs(FC_OP1,reg_addr);
+	const uint8_t* fast_jump=gen_mem_read_inline(reg_dst,1,(void *)&mem_readb_checked_drc);
+	dyn_check_exception(FC_RETOP);
+	gen_mov_byte_to_reg_low_canuseword(reg_dst,&core_dynrec.readdata);
+	gen_fill_short_jump(fast_jump);
+}
+
+// write a byte from reg_val into the memory given by the address
+static void dyn_write_byte(HostReg reg_addr,HostReg reg_val) {
+	gen_mov_regs(FC_OP2,reg_val);
+	gen_mov_regs(FC_OP1,reg_addr);
+	const uint8_t* fast_jump=gen_mem_write_inline(1,(void *)&mem_writeb_checked_drc);
+	dyn_check_exception(FC_RETOP);
+	gen_fill_short_jump(fast_jump);
+}
+
+// read a 32bit (dword=true) or 16bit (dword=false) value
+// from a given address and store it in reg_dst
+static void dyn_read_word(HostReg reg_addr,HostReg reg_dst,bool dword) {
+	gen_mov_regs(FC_OP1,reg_addr);
+	const uint8_t* fast_jump=gen_mem_read_inline(reg_dst,dword?4:2,
+		dword?(void *)&mem_readd_checked_drc:(void *)&mem_readw_checked_drc);
+	dyn_check_exception(FC_RETOP);
+	gen_mov_word_to_reg(reg_dst,&core_dynrec.readdata,dword);
+	gen_fill_short_jump(fast_jump);
+}
+
+// write a 32bit (dword=true) or 16bit (dword=false) value
+// from reg_val into the memory given by the address
+static void dyn_write_word(HostReg reg_addr,HostReg reg_val,bool dword) {
+	gen_mov_regs(FC_OP2,reg_val);
+	gen_mov_regs(FC_OP1,reg_addr);
+	const uint8_t* fast_jump=gen_mem_write_inline(dword?4:2,
+		dword?(void *)&mem_writed_checked_drc:(void *)&mem_writew_checked_drc);
+	dyn_check_exception(FC_RETOP);
+	gen_fill_short_jump(fast_jump);
+}
+
+#else
+
 // read a byte from a given address and store it in reg_dst
 static void dyn_read_byte(HostReg reg_addr,HostReg reg_dst) {
 	gen_mov_regs(FC_OP1,reg_addr);
@@ -766,6 +841,8 @@ static void dyn_write_word(HostReg reg_addr,HostReg reg_val,bool dword) {
 	dyn_check_exception(FC_RETOP);
 }
 
+#endif
+
 // effective address calculation helper, op2 has to be present!
 // loads op1 into ea_reg and adds the scaled op2 and the immediate to it
 [[maybe_unused]] static void dyn_lea_mem_mem(HostReg ea_reg,
@@ -1000,7 +1000,8 @@ static bool dyn_grp7(void) {
 			case 0x07:	// INVLPG
 //				if (cpu.pmode && cpu.cpl) EXCEPTION(EXCEPTION_GP);
 				if (cpu.pmode && cpu.cpl) IllegalOptionDynrec("invlpg nonpriviledged");
-				gen_call_function_raw((void*)PAGING_ClearTLB);
+				dyn_fill_ea(FC_ADDR);
+				gen_call_function_R((void*)PAGING_InvalidatePage,FC_ADDR);
 				break;
 			default: IllegalOptionDynrec("dyn_grp7_1");
 		}
@@ -1122,6 +1123,21 @@ static void dyn_branched_exit(BranchTypes btype,int32_t eip_add) {
 	dyn_closeblock();
 }
 
+// trace-block variant of dyn_branched_exit: the not-taken path falls
+// through and translation continues, the taken path becomes a side exit
+// that is filled in at the end of the block (see dyn_fill_blocks)
+static void dyn_branched_side_exit(BranchTypes btype,int32_t eip_add) {
+	Bitu eip_base=decode.code-decode.code_start;
+	dyn_reduce_cycles();
+
+	dyn_branchflag_to_reg(btype);
+	save_info_dynrec[used_save_info_dynrec].branch_pos=gen_create_branch_long_nonzero(FC_RETOP,true);
+	save_info_dynrec[used_save_info_dynrec].eip_change=eip_base+eip_add;
+	if (!cpu.code.big) save_info_dynrec[used_save_info_dynrec].eip_change&=0xffff;
+	save_info_dynrec[used_save_info_dynrec].type=branch_taken;
+	++used_save_info_dynrec;
+}
+
 /*
 static void dyn_set_byte_on_condition(BranchTypes btype) {
 	dyn_get_modrm();
@@ -66,15 +66,40 @@ static inline void dyn_fpu_top_swapped() {
 	gen_mov_word_to_reg(FC_OP2,(void*)(&TOP),true);
 }
 
+// generate the code for one of the basic arithmetic operations with both
+// stack positions already loaded into FC_OP1/FC_OP2; op is the modrm.reg
+// value of the instruction (0=FADD, 1=FMUL, 4=FSUB, 5=FSUBR, 6=FDIV,
+// 7=FDIVR) and func the matching interpreter helper; these helpers only
+// modify the register contents, so backends that can emit the
+// double-precision operation directly do so instead of calling out
+static void dyn_fpu_arith([[maybe_unused]] Bitu op,[[maybe_unused]] void* func) {
+#if defined(DRC_USE_INLINE_FPU_ARITH) && !C_FPU_X86
+	gen_fpu_arith_regs((void*)fpu.regs,op);
+#else
+	gen_call_function_RR(func,FC_OP1,FC_OP2);
+#endif
+}
+
+// same for the memory operand forms: the operand has been loaded into the
+// scratch register fpu.regs[8] by the caller, with TOP in FC_OP1
+static void dyn_fpu_arith_ea([[maybe_unused]] Bitu op,[[maybe_unused]] void* func) {
+#if defined(DRC_USE_INLINE_FPU_ARITH) && !C_FPU_X86
+	gen_mov_dword_to_reg_imm(FC_OP2,8);
+	gen_fpu_arith_regs((void*)fpu.regs,op);
+#else
+	gen_call_function_R(func,FC_OP1);
+#endif
+}
+
 static void dyn_eatree() {
 //	Bitu group = (decode.modrm.val >> 3) & 7;
 	Bitu group = decode.modrm.reg&7; //It is already that, but compilers.
 	switch (group){
 	case 0x00:		// FADD ST,STi
-		gen_call_function_R((void*)&FPU_FADD_EA,FC_OP1);
+		dyn_fpu_arith_ea(0,(void*)&FPU_FADD_EA);
 		break;
 	case 0x01:		// FMUL  ST,STi
-		gen_call_function_R((void*)&FPU_FMUL_EA,FC_OP1);
+		dyn_fpu_arith_ea(1,(void*)&FPU_FMUL_EA);
 		break;
 	case 0x02:		// FCOM  STi
 		gen_call_function_R((void*)&FPU_FCOM_EA,FC_OP1);
@@ -84,16 +109,16 @@ static void dyn_eatree() {
 		gen_call_function_raw((void*)&FPU_FPOP);
 		break;
 	case 0x04:		// FSUB  ST,STi
-		gen_call_function_R((void*)&FPU_FSUB_EA,FC_OP1);
-		break;	
+		dyn_fpu_arith_ea(4,(void*)&FPU_FSUB_EA);
+		break;
 	case 0x05:		// FSUBR ST,STi
-		gen_call_function_R((void*)&FPU_FSUBR_EA,FC_OP1);
+		dyn_fpu_arith_ea(5,(void*)&FPU_FSUBR_EA);
 		break;
 	case 0x06:		// FDIV  ST,STi
-		gen_call_function_R((void*)&FPU_FDIV_EA,FC_OP1);
+		dyn_fpu_arith_ea(6,(void*)&FPU_FDIV_EA);
 		break;
 	case 0x07:		// FDIVR ST,STi
-		gen_call_function_R((void*)&FPU_FDIVR_EA,FC_OP1);
+		dyn_fpu_arith_ea(7,(void*)&FPU_FDIVR_EA);
 		break;
 	default:
 		break;
@@ -107,10 +132,10 @@ static void dyn_fpu_esc0(){
 		dyn_fpu_top();
 		switch (decode.modrm.reg){
 		case 0x00:		//FADD ST,STi
-			gen_call_function_RR((void*)&FPU_FADD,FC_OP1,FC_OP2);
+			dyn_fpu_arith(0,(void*)&FPU_FADD);
 			break;
 		case 0x01:		// FMUL  ST,STi
-			gen_call_function_RR((void*)&FPU_FMUL,FC_OP1,FC_OP2);
+			dyn_fpu_arith(1,(void*)&FPU_FMUL);
 			break;
 		case 0x02:		// FCOM  STi
 			gen_call_function_RR((void*)&FPU_FCOM,FC_OP1,FC_OP2);
@@ -120,16 +145,16 @@ static void dyn_fpu_esc0(){
 			gen_call_function_raw((void*)&FPU_FPOP);
 			break;
 		case 0x04:		// FSUB  ST,STi
-			gen_call_function_RR((void*)&FPU_FSUB,FC_OP1,FC_OP2);
-			break;	
+			dyn_fpu_arith(4,(void*)&FPU_FSUB);
+			break;
 		case 0x05:		// FSUBR ST,STi
-			gen_call_function_RR((void*)&FPU_FSUBR,FC_OP1,FC_OP2);
+			dyn_fpu_arith(5,(void*)&FPU_FSUBR);
 			break;
 		case 0x06:		// FDIV  ST,STi
-			gen_call_function_RR((void*)&FPU_FDIV,FC_OP1,FC_OP2);
+			dyn_fpu_arith(6,(void*)&FPU_FDIV);
 			break;
 		case 0x07:		// FDIVR ST,STi
-			gen_call_function_RR((void*)&FPU_FDIVR,FC_OP1,FC_OP2);
+			dyn_fpu_arith(7,(void*)&FPU_FDIVR);
 			break;
 		default:
 			break;
@@ -439,11 +464,11 @@ static void dyn_fpu_esc4(){
 		switch(decode.modrm.reg){
 		case 0x00:	/* FADD STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FADD,FC_OP1,FC_OP2);
+			dyn_fpu_arith(0,(void*)&FPU_FADD);
 			break;
 		case 0x01:	/* FMUL STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FMUL,FC_OP1,FC_OP2);
+			dyn_fpu_arith(1,(void*)&FPU_FMUL);
 			break;
 		case 0x02:  /* FCOM*/
 			dyn_fpu_top();
@@ -456,26 +481,26 @@ static void dyn_fpu_esc4(){
 			break;
 		case 0x04:  /* FSUBR STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUBR,FC_OP1,FC_OP2);
+			dyn_fpu_arith(5,(void*)&FPU_FSUBR);
 			break;
 		case 0x05:  /* FSUB  STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUB,FC_OP1,FC_OP2);
+			dyn_fpu_arith(4,(void*)&FPU_FSUB);
 			break;
 		case 0x06:  /* FDIVR STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIVR,FC_OP1,FC_OP2);
+			dyn_fpu_arith(7,(void*)&FPU_FDIVR);
 			break;
 		case 0x07:  /* FDIV STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIV,FC_OP1,FC_OP2);
+			dyn_fpu_arith(6,(void*)&FPU_FDIV);
 			break;
 		default:
 			break;
 		}
-	} else { 
+	} else {
 		dyn_fill_ea(FC_ADDR);
-		gen_call_function_R((void*)&FPU_FLD_F64_EA,FC_ADDR); 
+		gen_call_function_R((void*)&FPU_FLD_F64_EA,FC_ADDR);
 		gen_mov_word_to_reg(FC_OP1,(void*)(&TOP),true);
 		dyn_eatree();
 	}
@@ -559,11 +584,11 @@ static void dyn_fpu_esc6(){
 		switch(decode.modrm.reg){
 		case 0x00:	/*FADDP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FADD,FC_OP1,FC_OP2);
+			dyn_fpu_arith(0,(void*)&FPU_FADD);
 			break;
 		case 0x01:	/* FMULP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FMUL,FC_OP1,FC_OP2);
+			dyn_fpu_arith(1,(void*)&FPU_FMUL);
 			break;
 		case 0x02:  /* FCOMP5*/
 			dyn_fpu_top();
@@ -583,19 +608,19 @@ static void dyn_fpu_esc6(){
 			break;
 		case 0x04:  /* FSUBRP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUBR,FC_OP1,FC_OP2);
+			dyn_fpu_arith(5,(void*)&FPU_FSUBR);
 			break;
 		case 0x05:  /* FSUBP  STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FSUB,FC_OP1,FC_OP2);
+			dyn_fpu_arith(4,(void*)&FPU_FSUB);
 			break;
 		case 0x06:	/* FDIVRP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIVR,FC_OP1,FC_OP2);
+			dyn_fpu_arith(7,(void*)&FPU_FDIVR);
 			break;
 		case 0x07:  /* FDIVP STi,ST*/
 			dyn_fpu_top_swapped();
-			gen_call_function_RR((void*)&FPU_FDIV,FC_OP1,FC_OP2);
+			dyn_fpu_arith(6,(void*)&FPU_FDIV);
 			break;
 		default:
 			break;
@@ -29,6 +29,18 @@
 // try to replace _simple functions by code
 #define DRC_FLAGS_INVALIDATION_DCODE
 
+// emit the paging-table lookup and the memory access itself into the
+// translated code instead of calling out to the C helper functions
+// (the helpers remain as the slow path for handler-mapped pages);
+// requires the flat paging-table layout
+#if defined(USE_FULL_TLB)
+#define DRC_USE_INLINE_MEMACCESS
+#endif
+
+// emit the basic x87 arithmetic operations as scalar NEON instructions
+// instead of calling the interpreter helpers
+#define DRC_USE_INLINE_FPU_ARITH
+
 // calling convention modifier
 #define DRC_CALL_CONV	/* nothing */
 #define DRC_FC			/* nothing */
@@ -229,6 +241,8 @@ typedef uint8_t HostReg;
 #define SUB_IMM(dst, src, imm, simm) (0x51000000 + (dst) + ((src) << 5) + ((imm) << 10) + ((simm)?0x00400000:0) )
 // sub dst, src1, src2, lsl #imm
 #define SUB_REG_LSL_IMM(dst, src1, src2, imm) (0x4b000000 + (dst) + ((src1) << 5) + ((src2) << 16) + ((imm) << 10) )
+// add dst, src1, src2, uxtw
+#define ADD64_REG_UXTW(dst, src1, src2) (0x8b204000 + (dst) + ((src1) << 5) + ((src2) << 16) )
 // cmp src, #(imm lsl simm)		@	0 <= imm <= 4095	&	simm = 0/12
 #define CMP_IMM(src, imm, simm) (0x7100001f + ((src) << 5) + ((imm) << 10) + ((simm)?0x00400000:0) )
 // nop
@@ -269,6 +283,8 @@ typedef uint8_t HostReg;
 #define LDURH_IMM(reg, addr, imm) (0x78400000 + (reg) + ((addr) << 5) + (((imm) << 12) & 0x001ff000) )
 // ldurb reg, [addr, #imm]		@	-256 <= imm < 256
 #define LDURB_IMM(reg, addr, imm) (0x38400000 + (reg) + ((addr) << 5) + (((imm) << 12) & 0x001ff000) )
+// ldr dreg, [addr1, addr2, lsl #imm]		@	imm = 0/3
+#define LDRD_REG_LSL_IMM(reg, addr1, addr2, imm) (0xfc606800 + (reg) + ((addr1) << 5) + ((addr2) << 16) + ((imm)?0x00001000:0) )
 
 // store
 // stp reg1, reg2 [addr, #imm]		@	-512 <= imm < 512	&	imm mod 8 = 0
@@ -289,8 +305,24 @@ typedef uint8_t HostReg;
 #define STURH_IMM(reg, addr, imm) (0x78000000 + (reg) + ((addr) << 5) + (((imm) << 12) & 0x001ff000) )
 // sturb reg, [addr, #imm]		@	-256 <= imm < 256
 #define STURB_IMM(reg, addr, imm) (0x38000000 + (reg) + ((addr) << 5) + (((imm) << 12) & 0x001ff000) )
+// str dreg, [addr1, addr2, lsl #imm]		@	imm = 0/3
+#define STRD_REG_LSL_IMM(reg, addr1, addr2, imm) (0xfc206800 + (reg) + ((addr1) << 5) + ((addr2) << 16) + ((imm)?0x00001000:0) )
+
+// floating point (scalar double-precision)
+// fadd dst, src1, src2
+#define FADD_D(dst, src1, src2) (0x1e602800 + (dst) + ((src1) << 5) + ((src2) << 16) )
+// fsub dst, src1, src2
+#define FSUB_D(dst, src1, src2) (0x1e603800 + (dst) + ((src1) << 5) + ((src2) << 16) )
+// fmul dst, src1, src2
+#define FMUL_D(dst, src1, src2) (0x1e600800 + (dst) + ((src1) << 5) + ((src2) << 16) )
+// fdiv dst, src1, src2
+#define FDIV_D(dst, src1, src2) (0x1e601800 + (dst) + ((src1) << 5) + ((src2) << 16) )
 
 // branch
+// beq pc+imm		@	0 <= imm < 1M	&	imm mod 4 = 0
+#define BEQ_FWD(imm) (0x54000000 + ((imm) << 3) )
+// bhs pc+imm		@	0 <= imm < 1M	&	imm mod 4 = 0
+#define BHS_FWD(imm) (0x54000002 + ((imm) << 3) )
 // bgt pc+imm		@	0 <= imm < 1M	&	imm mod 4 = 0
 #define BGT_FWD(imm) (0x5400000c + ((imm) << 3) )
 // b pc+imm		@	0 <= imm < 128M	&	imm mod 4 = 0
@@ -301,6 +333,8 @@ typedef uint8_t HostReg;
 #define BLR_REG(reg) (0xd63f0000 + ((reg) << 5) )
 // cbz reg, pc+imm		@	0 <= imm < 1M	&	imm mod 4 = 0
 #define CBZ_FWD(reg, imm) (0x34000000 + (reg) + ((imm) << 3) )
+// cbz reg, pc+imm (64-bit register)		@	0 <= imm < 1M	&	imm mod 4 = 0
+#define CBZ64_FWD(reg, imm) (0xb4000000 + (reg) + ((imm) << 3) )
 // cbnz reg, pc+imm		@	0 <= imm < 1M	&	imm mod 4 = 0
 #define CBNZ_FWD(reg, imm) (0x35000000 + (reg) + ((imm) << 3) )
 // ret reg
@@ -872,6 +906,104 @@ static void inline gen_fill_branch_long(const uint8_t* data) {
 	cache_addd(((data[3]<<24)&~0x03ffffff)|(offset&0x03ffffff),data);
 }
 
+
+#if defined(DRC_USE_INLINE_MEMACCESS)
+// short unconditional jump over the slow path of an inline memory access
+// the destination is set by gen_fill_short_jump() later
+static const uint8_t* gen_create_short_jump(void) {
+	cache_addd( B_FWD(0) );      // b j
+	return (cache.pos-4);
+}
+
+// calculate relative offset and fill it into the location pointed to by data
+static void gen_fill_short_jump(const uint8_t* data) {
+	gen_fill_branch_long(data);
+}
+
+// emit the common part of an inline memory access: the page-crossing test
+// (for 16/32bit accesses) and the paging-table lookup for the linear
+// address in FC_OP1; afterwards temp2 holds the host address of the
+// accessed memory, the returned branch positions have to be routed to the
+// slow path
+static void gen_memaccess_inline_intro(HostPt* table,Bitu size,const uint8_t** brk_page,const uint8_t** brk_nomap) {
+	*brk_page=nullptr;
+	if (size > 1) {
+		cache_addd( UBFM(temp1, FC_OP1, 0, 11) );                   // ubfx temp1, FC_OP1, #0, #12
+		cache_addd( CMP_IMM(temp1, (size == 4)?0xffd:0xfff, 0) );   // cmp temp1, #0xffd/#0xfff
+		cache_addd( (size == 4)?BHS_FWD(0):BEQ_FWD(0) );            // b.hs/b.eq j (slow path)
+		*brk_page=cache.pos-4;
+	}
+	gen_mov_qword_to_reg_imm(temp2, (uint64_t)table);           // mov temp2, #table
+	cache_addd( UBFM(temp1, FC_OP1, 12, 31) );                  // lsr temp1, FC_OP1, #12
+	cache_addd( LDR64_REG_LSL_IMM(temp2, temp2, temp1, 1) );    // ldr temp2, [temp2, temp1, lsl #3]
+	cache_addd( CBZ64_FWD(temp2, 0) );                          // cbz temp2, j (slow path)
+	*brk_nomap=cache.pos-4;
+	cache_addd( ADD64_REG_UXTW(temp2, temp2, FC_OP1) );         // add temp2, temp2, FC_OP1, uxtw
+}
+
+// emit an inline read of size bytes (1/2/4) from the linear address in
+// FC_OP1 into reg_dst, with a call to slow_func for handler-mapped pages
+// and page-crossing accesses; returns the branch at the end of the fast
+// path which has to be set by gen_fill_short_jump() after the slow path
+// has loaded core_dynrec.readdata into reg_dst
+static const uint8_t* gen_mem_read_inline(HostReg reg_dst,Bitu size,void* slow_func) {
+	const uint8_t *brk_page,*brk_nomap;
+	gen_memaccess_inline_intro(PAGING_GetReadBaseAddress(),size,&brk_page,&brk_nomap);
+	switch (size) {
+		case 1: cache_addd( LDRB_IMM(reg_dst, temp2, 0) ); break;   // ldrb reg_dst, [temp2]
+		case 2: cache_addd( LDRH_IMM(reg_dst, temp2, 0) ); break;   // ldrh reg_dst, [temp2]
+		default: cache_addd( LDR_IMM(reg_dst, temp2, 0) ); break;   // ldr reg_dst, [temp2]
+	}
+	const uint8_t* fast_jump=gen_create_short_jump();
+	if (brk_page) gen_fill_branch(brk_page);
+	gen_fill_branch(brk_nomap);
+	gen_call_function_raw(slow_func);
+	return fast_jump;
+}
+
+// emit an inline write of size bytes (1/2/4) from FC_OP2 to the linear
+// address in FC_OP1, with a call to slow_func for handler-mapped pages
+// and page-crossing accesses; returns the branch at the end of the fast
+// path which has to be set by gen_fill_short_jump() after the slow path
+static const uint8_t* gen_mem_write_inline(Bitu size,void* slow_func) {
+	const uint8_t *brk_page,*brk_nomap;
+	gen_memaccess_inline_intro(PAGING_GetWriteBaseAddress(),size,&brk_page,&brk_nomap);
+	switch (size) {
+		case 1: cache_addd( STRB_IMM(FC_OP2, temp2, 0) ); break;    // strb FC_OP2, [temp2]
+		case 2: cache_addd( STRH_IMM(FC_OP2, temp2, 0) ); break;    // strh FC_OP2, [temp2]
+		default: cache_addd( STR_IMM(FC_OP2, temp2, 0) ); break;    // str FC_OP2, [temp2]
+	}
+	const uint8_t* fast_jump=gen_create_short_jump();
+	if (brk_page) gen_fill_branch(brk_page);
+	gen_fill_branch(brk_nomap);
+	gen_call_function_raw(slow_func);
+	return fast_jump;
+}
+#endif
+
+
+#if defined(DRC_USE_INLINE_FPU_ARITH)
+// emit regs[op1] = regs[op1] <operation> regs[op2] on the double-precision
+// register file at regs (stride 8 bytes) with the register indexes in
+// FC_OP1/FC_OP2; op is the modrm.reg value of the x87 instruction:
+// 0=add, 1=mul, 4=sub, 5=subr, 6=div, 7=divr
+static void gen_fpu_arith_regs(void* regs,Bitu op) {
+	gen_mov_qword_to_reg_imm(temp1,(uint64_t)regs);
+	cache_addd( LDRD_REG_LSL_IMM(0, temp1, FC_OP1, 1) );    // ldr d0, [temp1, FC_OP1, lsl #3]
+	cache_addd( LDRD_REG_LSL_IMM(1, temp1, FC_OP2, 1) );    // ldr d1, [temp1, FC_OP2, lsl #3]
+	switch (op) {
+		case 0: cache_addd( FADD_D(0, 0, 1) ); break;       // fadd d0, d0, d1
+		case 1: cache_addd( FMUL_D(0, 0, 1) ); break;       // fmul d0, d0, d1
+		case 4: cache_addd( FSUB_D(0, 0, 1) ); break;       // fsub d0, d0, d1
+		case 5: cache_addd( FSUB_D(0, 1, 0) ); break;       // fsub d0, d1, d0
+		case 6: cache_addd( FDIV_D(0, 0, 1) ); break;       // fdiv d0, d0, d1
+		default: cache_addd( FDIV_D(0, 1, 0) ); break;      // fdiv d0, d1, d0
+	}
+	cache_addd( STRD_REG_LSL_IMM(0, temp1, FC_OP1, 1) );    // str d0, [temp1, FC_OP1, lsl #3]
+}
+#endif
+
+
 static void gen_run_code(void) {
 	const uint8_t *pos1, *pos2, *pos3;
 
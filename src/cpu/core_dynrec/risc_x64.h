@@ -29,6 +29,18 @@
 // try to replace _simple functions by code
 #define DRC_FLAGS_INVALIDATION_DCODE
 
+// emit the paging-table lookup and the memory access itself into the
+// translated code instead of calling out to the C helper functions
+// (the helpers remain as the slow path for handler-mapped pages);
+// requires the flat paging-table layout
+#if defined(USE_FULL_TLB)
+#define DRC_USE_INLINE_MEMACCESS
+#endif
+
+// emit the basic x87 arithmetic operations as scalar SSE2 instructions
+// instead of calling the interpreter helpers
+#define DRC_USE_INLINE_FPU_ARITH
+
 // calling convention modifier
 #define DRC_CALL_CONV	/* nothing */
 #define DRC_FC			/* nothing */
@@ -599,6 +611,145 @@ static void gen_fill_branch_long(const uint8_t* data) {
 	cache_addd((uint32_t)(cache.pos-data-4),data);
 }
 
+
+#if defined(DRC_USE_INLINE_MEMACCESS)
+// scratch register for the inline memory access code below; rdx carries
+// the third parameter in the SystemV ABI and is thus free here, on Win64
+// (where rdx holds the second parameter) the LEA temporary is used
+#if defined (_WIN64)
+#define MEMACCESS_SCRATCH TEMP_REG_DRC
+#else
+#define MEMACCESS_SCRATCH HOST_EDX
+#endif
+
+// short unconditional jump over the slow path of an inline memory access
+// the destination is set by gen_fill_short_jump() later
+static const uint8_t* gen_create_short_jump(void) {
+	cache_addw(0x00eb);		// jmp short
+	return (cache.pos-1);
+}
+
+// calculate relative offset and fill it into the location pointed to by data
+static void gen_fill_short_jump(const uint8_t* data) {
+	gen_fill_branch(data);
+}
+
+// emit the common part of an inline memory access: the page-crossing test
+// (for 16/32bit accesses) and the paging-table lookup for the linear
+// address in FC_OP1; afterwards FC_RETOP holds the host page pointer and
+// MEMACCESS_SCRATCH the zero-extended linear address, the returned branch
+// positions have to be routed to the slow path
+static void gen_memaccess_inline_intro(HostPt* table,Bitu size,const uint8_t** brk_page,const uint8_t** brk_nomap) {
+	*brk_page=nullptr;
+	if (size>1) {
+		cache_addb(0x8b);		// mov scratch,FC_OP1
+		cache_addb(0xc0+(MEMACCESS_SCRATCH<<3)+FC_OP1);
+		cache_addw(0xe081+(MEMACCESS_SCRATCH<<8));	// and scratch,0xfff
+		cache_addd(0xfff);
+		cache_addw(0xf881+(MEMACCESS_SCRATCH<<8));	// cmp scratch,0xffd/0xfff
+		cache_addd((size==4)?0xffd:0xfff);
+		cache_addw((size==4)?0x0073:0x0074);		// jae/je (slow path)
+		*brk_page=cache.pos-1;
+	}
+	cache_addw(0xb848+(MEMACCESS_SCRATCH<<8));	// mov scratch,table
+	cache_addq((uint64_t)table);
+	cache_addb(0x8b);			// mov eax,FC_OP1
+	cache_addb(0xc0+FC_OP1);
+	cache_addw(0xe8c1);			// shr eax,12
+	cache_addb(0x0c);
+	cache_addw(0x8b48);			// mov rax,[scratch+rax*8]
+	cache_addb(0x04);
+	cache_addb(0xc0+MEMACCESS_SCRATCH);
+	cache_addw(0x8548);			// test rax,rax
+	cache_addb(0xc0);
+	cache_addw(0x0074);			// je (slow path)
+	*brk_nomap=cache.pos-1;
+	cache_addb(0x8b);			// mov scratch,FC_OP1 - zero-extend the address
+	cache_addb(0xc0+(MEMACCESS_SCRATCH<<3)+FC_OP1);
+}
+
+// emit an inline read of size bytes (1/2/4) from the linear address in
+// FC_OP1 into reg_dst, with a call to slow_func for handler-mapped pages
+// and page-crossing accesses; returns the branch at the end of the fast
+// path which has to be set by gen_fill_short_jump() after the slow path
+// has loaded core_dynrec.readdata into reg_dst
+static const uint8_t* gen_mem_read_inline(HostReg reg_dst,Bitu size,void* slow_func) {
+	const uint8_t *brk_page,*brk_nomap;
+	gen_memaccess_inline_intro(PAGING_GetReadBaseAddress(),size,&brk_page,&brk_nomap);
+	switch (size) {
+		case 1: cache_addw(0xb60f); break;	// movzx reg_dst,byte [rax+scratch]
+		case 2: cache_addw(0xb70f); break;	// movzx reg_dst,word [rax+scratch]
+		default: cache_addb(0x8b); break;	// mov reg_dst,[rax+scratch]
+	}
+	cache_addb(0x04+(reg_dst<<3));
+	cache_addb(MEMACCESS_SCRATCH<<3);
+	const uint8_t* fast_jump=gen_create_short_jump();
+	if (brk_page) gen_fill_branch(brk_page);
+	gen_fill_branch(brk_nomap);
+	gen_call_function_raw(slow_func);
+	return fast_jump;
+}
+
+// emit an inline write of size bytes (1/2/4) from FC_OP2 to the linear
+// address in FC_OP1, with a call to slow_func for handler-mapped pages
+// and page-crossing accesses; returns the branch at the end of the fast
+// path which has to be set by gen_fill_short_jump() after the slow path
+static const uint8_t* gen_mem_write_inline(Bitu size,void* slow_func) {
+	const uint8_t *brk_page,*brk_nomap;
+	gen_memaccess_inline_intro(PAGING_GetWriteBaseAddress(),size,&brk_page,&brk_nomap);
+	switch (size) {
+		case 1: cache_addw(0x8840); break;	// mov [rax+scratch],FC_OP2 (low byte)
+		case 2: cache_addw(0x8966); break;	// mov [rax+scratch],FC_OP2 (word)
+		default: cache_addb(0x89); break;	// mov [rax+scratch],FC_OP2
+	}
+	cache_addb(0x04+(FC_OP2<<3));
+	cache_addb(MEMACCESS_SCRATCH<<3);
+	const uint8_t* fast_jump=gen_create_short_jump();
+	if (brk_page) gen_fill_branch(brk_page);
+	gen_fill_branch(brk_nomap);
+	gen_call_function_raw(slow_func);
+	return fast_jump;
+}
+#endif
+
+
+#if defined(DRC_USE_INLINE_FPU_ARITH)
+// emit regs[op1] = regs[op1] <operation> regs[op2] on the double-precision
+// register file at regs (stride 8 bytes) with the register indexes in
+// FC_OP1/FC_OP2; op is the modrm.reg value of the x87 instruction:
+// 0=add, 1=mul, 4=sub, 5=subr, 6=div, 7=divr
+static void gen_fpu_arith_regs(void* regs,Bitu op) {
+	uint8_t opcode;
+	bool reversed=false;
+	switch (op) {
+		case 0: opcode=0x58; break;					// addsd
+		case 1: opcode=0x59; break;					// mulsd
+		case 4: opcode=0x5c; break;					// subsd
+		case 5: opcode=0x5c; reversed=true; break;	// subsd, reversed
+		case 6: opcode=0x5e; break;					// divsd
+		default: opcode=0x5e; reversed=true; break;	// divsd, reversed
+	}
+	const HostReg src1=reversed?FC_OP2:FC_OP1;
+	const HostReg src2=reversed?FC_OP1:FC_OP2;
+
+	cache_addw(0xb848);			// mov rax,regs
+	cache_addq((uint64_t)regs);
+
+	cache_addw(0x0ff2);			// movsd xmm0,[rax+src1*8]
+	cache_addb(0x10);
+	cache_addw(0xc004+(src1<<11));
+
+	cache_addw(0x0ff2);			// opsd xmm0,[rax+src2*8]
+	cache_addb(opcode);
+	cache_addw(0xc004+(src2<<11));
+
+	cache_addw(0x0ff2);			// movsd [rax+FC_OP1*8],xmm0
+	cache_addb(0x11);
+	cache_addw(0xc004+(FC_OP1<<11));
+}
+#endif
+
+
 static void gen_run_code(void) {
 	cache_addw(0x5355);     // push rbp,rbx
 	cache_addb(0x56);       // push rsi
@@ -66,13 +66,13 @@ switch (inst.code.op) {
 		lflags.type=inst.code.op;
 		break;
 	case t_INCb:	case t_INCw:	case t_INCd:
-		LoadCF;
+		PreserveCF();
 		lf_var1d=inst_op1_d;
 		inst_op1_d=lf_resd=inst_op1_d+1;
 		lflags.type=inst.code.op;
 		break;
 	case t_DECb:	case t_DECw:	case t_DECd:
-		LoadCF;
+		PreserveCF();
 		lf_var1d=inst_op1_d;
 		inst_op1_d=lf_resd=inst_op1_d-1;
 		lflags.type=inst.code.op;
@@ -451,7 +451,7 @@ switch (inst.code.op) {
 		case 7:		/* INVLPG */
 			if (cpu.pmode && cpu.cpl) EXCEPTION(EXCEPTION_GP);
 			FillFlags();
-			PAGING_ClearTLB();
+			PAGING_InvalidatePage(inst.rm_eaa);
 			goto nextopcode;
 		default:
 			LOG(LOG_CPU,LOG_ERROR)("Group 7 Illegal subfunction %X", static_cast<uint32_t>(inst.rm_index));
@@ -62,6 +62,7 @@ extern Bitu cycle_count;
 #define OPCODE_NONE			0x000
 #define OPCODE_0F			0x100
 #define OPCODE_SIZE			0x200
+#define OPCODE_MASK			0x3ff
 
 #define PREFIX_ADDR			0x1
 #define PREFIX_REP			0x2
@@ -137,14 +138,27 @@ static inline uint32_t Fetchd() {
 
 #define EALookupTable (core.ea_table)
 
-Bits CPU_Core_Normal_Run() noexcept
+/* The run loop is instantiated once per code segment size so the
+   per-instruction dispatch setup below folds to constants; real-mode
+   (and 16-bit protected-mode) code never pays for the 32-bit setup.
+   When an instruction switches the code segment size the running
+   instance backs out and CPU_Core_Normal_Run re-enters through the
+   matching one. */
+static bool core_respecialize = false;
+
+template <bool is_big_code>
+static Bits Core_Normal_Run() noexcept
 {
-	ZoneScoped;
 	while (CPU_Cycles-->0) {
+		if (GCC_UNLIKELY(cpu.code.big != is_big_code)) {
+			CPU_Cycles++;
+			core_respecialize=true;
+			return CBRET_NONE;
+		}
 		LOADIP;
-		core.opcode_index=cpu.code.big*0x200;
-		core.prefixes=cpu.code.big;
-		core.ea_table=&EATable[cpu.code.big*256];
+		core.opcode_index=is_big_code*0x200;
+		core.prefixes=is_big_code;
+		core.ea_table=&EATable[is_big_code*256];
 		BaseDS=SegBase(ds);
 		BaseSS=SegBase(ss);
 		core.base_val_ds=ds;
@@ -158,7 +172,12 @@ Bits CPU_Core_Normal_Run() noexcept
 		cycle_count++;
 #endif
 restart_opcode:
-		switch (core.opcode_index+Fetchb()) {
+		/* The dispatch value only spans OPCODE_MASK+1 entries (the 0f
+		   and operand-size bits plus the opcode byte). Masking it to
+		   that range proves this to the compiler, so the jump table is
+		   indexed directly instead of bounds-checking every single
+		   instruction dispatch first. */
+		switch ((core.opcode_index+Fetchb()) & OPCODE_MASK) {
 		#include "core_normal/prefix_none.h"
 		#include "core_normal/prefix_0f.h"
 		#include "core_normal/prefix_66.h"
@@ -191,6 +210,18 @@ decode_end:
 	return CBRET_NONE;
 }
 
+Bits CPU_Core_Normal_Run() noexcept
+{
+	ZoneScoped;
+	for (;;) {
+		core_respecialize=false;
+		const Bits ret=cpu.code.big ? Core_Normal_Run<true>()
+		                            : Core_Normal_Run<false>();
+		if (GCC_UNLIKELY(core_respecialize)) continue;
+		return ret;
+	}
+}
+
 Bits CPU_Core_Normal_Trap_Run() noexcept
 {
 	Bits oldCycles = CPU_Cycles;
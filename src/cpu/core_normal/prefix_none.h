@@ -1102,7 +1102,12 @@
 				{
 					Bitu cb=Fetchw();
 					FillFlags();SAVEIP;
-					return cb;
+					/* Run the handler right here instead of bouncing the
+					   number through the machine loop and re-entering the
+					   core; only results the loop has to act on unwind */
+					Bits cb_ret=CALLBACK_RunDirect(cb);
+					if (GCC_UNLIKELY(cb_ret!=CBRET_NONE)) return cb_ret;
+					continue;
 				}
 			default:
 				E_Exit("Illegal GRP4 Call %d",(rm>>3) & 7);
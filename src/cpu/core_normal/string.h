@@ -59,6 +59,16 @@ static void DoString(STRING_OP type) {
 		break;
 	case R_OUTSW:
 		add_index *= 2;
+		/* Devices with a bulk FIFO on the port take the whole forward,
+		   non-wrapping transfer in one call; anything left keeps the
+		   per-word path */
+		if (add_index == 2 && count > 1 &&
+		    (uint64_t)si_index + (uint64_t)count * 2 <= (uint64_t)add_mask + 1) {
+			const auto done = IO_StringWritePort(
+			        reg_dx, si_base + si_index, count, io_width_t::word);
+			si_index = (si_index + (uint32_t)done * 2) & add_mask;
+			count -= (uint32_t)done;
+		}
 		for (;count>0;count--) {
 			IO_WriteW(reg_dx,LoadMw(si_base+si_index));
 			si_index=(si_index+add_index) & add_mask;
@@ -79,6 +89,14 @@ static void DoString(STRING_OP type) {
 		break;
 	case R_INSW:
 		add_index *= 2;
+		/* See R_OUTSW */
+		if (add_index == 2 && count > 1 &&
+		    (uint64_t)di_index + (uint64_t)count * 2 <= (uint64_t)add_mask + 1) {
+			const auto done = IO_StringReadPort(
+			        reg_dx, di_base + di_index, count, io_width_t::word);
+			di_index = (di_index + (uint32_t)done * 2) & add_mask;
+			count -= (uint32_t)done;
+		}
 		for (;count>0;count--) {
 			SaveMw(di_base+di_index,IO_ReadW(reg_dx));
 			di_index=(di_index+add_index) & add_mask;
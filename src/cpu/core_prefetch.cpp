@@ -116,22 +116,57 @@ static uint8_t prefetch_buffer[MAX_PQ_SIZE];
 static bool pq_valid=false;
 static Bitu pq_start;
 
+/* Fill queue bytes [dst,dst+count) from guest memory starting at addr.
+   Code almost always sits in plain RAM, so this follows the mem_memcpy
+   page-span pattern: one memcpy per crossed page straight out of the
+   read TLB, with the byte loop kept for handler-mapped pages. The old
+   per-byte refill loops made this core pay for its queue semantics on
+   every slide and branch; the window contents are bit-identical. */
+static void pq_refill(PhysPt addr,Bitu dst,Bitu count) {
+	while (count>0) {
+		Bitu chunk=dos_pagesize-(addr & (dos_pagesize-1));
+		if (chunk>count) chunk=count;
+		const HostPt host=get_tlb_read(addr);
+		if (GCC_LIKELY(host)) {
+			memcpy(&prefetch_buffer[dst],host+addr,chunk);
+		} else {
+			for (Bitu i=0;i<chunk;i++) prefetch_buffer[dst+i]=LoadMb(addr+i);
+		}
+		addr+=chunk;
+		dst+=chunk;
+		count-=chunk;
+	}
+}
+
+/* Reload the whole queue at addr (queue flush or fetch outside the
+   window) */
+static void pq_reload(PhysPt addr) {
+	pq_refill(addr,0,CPU_PrefetchQueueSize);
+	pq_start=addr;
+	pq_valid=true;
+}
+
+/* Slide the window forward so it starts at addr: the not yet consumed
+   tail keeps the bytes captured at fill time, only the freed space is
+   loaded from memory, exactly as the byte loops used to do */
+static void pq_slide(PhysPt addr) {
+	const Bitu remaining_bytes=pq_start+CPU_PrefetchQueueSize-addr;
+	memmove(prefetch_buffer,&prefetch_buffer[addr-pq_start],remaining_bytes);
+	pq_refill(addr+remaining_bytes,remaining_bytes,CPU_PrefetchQueueSize-remaining_bytes);
+	pq_start=addr;
+	pq_valid=true;
+}
+
 static uint8_t Fetchb() {
 	uint8_t temp;
 	if (pq_valid && (core.cseip>=pq_start) && (core.cseip<pq_start+CPU_PrefetchQueueSize)) {
 		temp=prefetch_buffer[core.cseip-pq_start];
 		if ((core.cseip+1>=pq_start+CPU_PrefetchQueueSize-4) &&
 			(core.cseip+1<pq_start+CPU_PrefetchQueueSize)) {
-			Bitu remaining_bytes=pq_start+CPU_PrefetchQueueSize-(core.cseip+1);
-			for (Bitu i=0; i<remaining_bytes; i++) prefetch_buffer[i]=prefetch_buffer[core.cseip+1-pq_start+i];
-			for (Bitu i=remaining_bytes; i<CPU_PrefetchQueueSize; i++) prefetch_buffer[i]=LoadMb(core.cseip+1+i);
-			pq_start=core.cseip+1;
-			pq_valid=true;
+			pq_slide(core.cseip+1);
 		}
 	} else {
-		for (Bitu i=0; i<CPU_PrefetchQueueSize; i++) prefetch_buffer[i]=LoadMb(core.cseip+i);
-		pq_start=core.cseip;
-		pq_valid=true;
+		pq_reload(core.cseip);
 		temp=prefetch_buffer[0];
 	}
 /*	if (temp!=LoadMb(core.cseip)) {
@@ -148,16 +183,10 @@ static uint16_t Fetchw() {
 			(prefetch_buffer[core.cseip-pq_start+1]<<8);
 		if ((core.cseip+2>=pq_start+CPU_PrefetchQueueSize-4) &&
 			(core.cseip+2<pq_start+CPU_PrefetchQueueSize)) {
-			Bitu remaining_bytes=pq_start+CPU_PrefetchQueueSize-(core.cseip+2);
-			for (Bitu i=0; i<remaining_bytes; i++) prefetch_buffer[i]=prefetch_buffer[core.cseip+2-pq_start+i];
-			for (Bitu i=remaining_bytes; i<CPU_PrefetchQueueSize; i++) prefetch_buffer[i]=LoadMb(core.cseip+2+i);
-			pq_start=core.cseip+2;
-			pq_valid=true;
+			pq_slide(core.cseip+2);
 		}
 	} else {
-		for (Bitu i=0; i<CPU_PrefetchQueueSize; i++) prefetch_buffer[i]=LoadMb(core.cseip+i);
-		pq_start=core.cseip;
-		pq_valid=true;
+		pq_reload(core.cseip);
 		temp=prefetch_buffer[0] | (prefetch_buffer[1]<<8);
 	}
 /*	if (temp!=LoadMw(core.cseip)) {
@@ -176,16 +205,10 @@ static uint32_t Fetchd() {
 			(prefetch_buffer[core.cseip-pq_start+3]<<24);
 		if ((core.cseip+4>=pq_start+CPU_PrefetchQueueSize-4) &&
 			(core.cseip+4<pq_start+CPU_PrefetchQueueSize)) {
-			Bitu remaining_bytes=pq_start+CPU_PrefetchQueueSize-(core.cseip+4);
-			for (Bitu i=0; i<remaining_bytes; i++) prefetch_buffer[i]=prefetch_buffer[core.cseip+4-pq_start+i];
-			for (Bitu i=remaining_bytes; i<CPU_PrefetchQueueSize; i++) prefetch_buffer[i]=LoadMb(core.cseip+4+i);
-			pq_start=core.cseip+4;
-			pq_valid=true;
+			pq_slide(core.cseip+4);
 		}
 	} else {
-		for (Bitu i=0; i<CPU_PrefetchQueueSize; i++) prefetch_buffer[i]=LoadMb(core.cseip+i);
-		pq_start=core.cseip;
-		pq_valid=true;
+		pq_reload(core.cseip);
 		temp=prefetch_buffer[0] | (prefetch_buffer[1]<<8) |
 			(prefetch_buffer[2]<<16) | (prefetch_buffer[3]<<24);
 	}
@@ -208,17 +231,33 @@ static uint32_t Fetchd() {
 
 #define EALookupTable (core.ea_table)
 
-Bits CPU_Core_Prefetch_Run() noexcept
+/* As in core_normal, the run loop is instantiated once per code segment
+   size so the per-instruction dispatch setup below folds to constants.
+   When an instruction switches the code segment size the running
+   instance backs out and CPU_Core_Prefetch_Run re-enters through the
+   matching one. */
+static bool core_respecialize = false;
+
+template <bool is_big_code>
+static Bits Core_Prefetch_Run() noexcept
 {
 	bool invalidate_pq=false;
 	while (CPU_Cycles-->0) {
+		if (GCC_UNLIKELY(cpu.code.big != is_big_code)) {
+			CPU_Cycles++;
+			// the mode switch came from a far transfer, so the
+			// prefetch queue is stale in any case
+			pq_valid=false;
+			core_respecialize=true;
+			return CBRET_NONE;
+		}
 		if (invalidate_pq) {
 			pq_valid = false;
 		}
 		LOADIP;
-		core.opcode_index=cpu.code.big*0x200;
-		core.prefixes=cpu.code.big;
-		core.ea_table=&EATable[cpu.code.big*256];
+		core.opcode_index=is_big_code*0x200;
+		core.prefixes=is_big_code;
+		core.ea_table=&EATable[is_big_code*256];
 		BaseDS=SegBase(ds);
 		BaseSS=SegBase(ss);
 		core.base_val_ds=ds;
@@ -309,6 +348,17 @@ decode_end:
 	return CBRET_NONE;
 }
 
+Bits CPU_Core_Prefetch_Run() noexcept
+{
+	for (;;) {
+		core_respecialize=false;
+		const Bits ret=cpu.code.big ? Core_Prefetch_Run<true>()
+		                            : Core_Prefetch_Run<false>();
+		if (GCC_UNLIKELY(core_respecialize)) continue;
+		return ret;
+	}
+}
+
 Bits CPU_Core_Prefetch_Trap_Run() noexcept
 {
 	Bits oldCycles = CPU_Cycles;
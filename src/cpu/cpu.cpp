@@ -19,18 +19,22 @@
 
 #include "cpu.h"
 
+#include "dyn_warmup.h"
+
 #include <assert.h>
 #include <sstream>
 #include <stddef.h>
 
 #include "memory.h"
 #include "debug.h"
+#include "guest_profiler.h"
 #include "mapper.h"
 #include "setup.h"
 #include "programs.h"
 #include "paging.h"
 #include "lazyflags.h"
 #include "support.h"
+#include "timer.h"
 
 extern void GFX_RefreshTitle(const bool is_paused = false);
 extern void GFX_SetTitle(const int32_t cycles, const bool is_paused = false);
@@ -66,6 +70,42 @@ ArchitectureType CPU_ArchitectureType = ArchitectureType::Mixed;
 
 Bitu CPU_extflags_toggle=0;	// ID and AC flags may be toggled depending on emulated CPU architecture
 
+enum class HostIdleMode { Off, Auto, Aggressive };
+static HostIdleMode host_idle_mode = HostIdleMode::Auto;
+
+// Idle-percentage accounting: ticks during which at least one idle
+// hint fired versus all emulated ticks
+static bool idle_hint_this_tick = false;
+static int64_t idle_tick_count  = 0;
+static int64_t total_tick_count = 0;
+
+static void CPU_IdleTickCounter()
+{
+	++total_tick_count;
+	if (idle_hint_this_tick) {
+		idle_hint_this_tick = false;
+		++idle_tick_count;
+	}
+}
+
+void CPU_NotifyIdle(void)
+{
+	if (host_idle_mode == HostIdleMode::Off)
+		return;
+	idle_hint_this_tick = true;
+	// Charge the rest of this millisecond's budget as removed, the
+	// same way HLT does; the main loop then reaches its tick-pacing
+	// sleep instead of burning a host core on the guest's wait loop
+	CPU_IODelayRemoved += CPU_Cycles;
+	CPU_Cycles = 0;
+}
+
+void CPU_NotifyIdleAdvisory(void)
+{
+	if (host_idle_mode == HostIdleMode::Aggressive)
+		CPU_NotifyIdle();
+}
+
 Bitu CPU_PrefetchQueueSize=0;
 
 void CPU_Core_Full_Init(void);
@@ -2076,6 +2116,7 @@ static Bits HLT_Decode(void) {
 	if (reg_eip!=cpu.hlt.eip || SegValue(cs) != cpu.hlt.cs) {
 		cpudecoder=cpu.hlt.old_decoder;
 	} else {
+		idle_hint_this_tick = true;
 		CPU_IODelayRemoved += CPU_Cycles;
 		CPU_Cycles=0;
 	}
@@ -2084,6 +2125,7 @@ static Bits HLT_Decode(void) {
 
 void CPU_HLT(Bitu oldeip) {
 	reg_eip=oldeip;
+	idle_hint_this_tick = true;
 	CPU_IODelayRemoved += CPU_Cycles;
 	CPU_Cycles=0;
 	cpu.hlt.cs=SegValue(cs);
@@ -2334,6 +2376,25 @@ public:
 
 		CPU_CycleUp=section->Get_int("cycleup");
 		CPU_CycleDown=section->Get_int("cycledown");
+
+		const std::string host_idle = section->Get_string("host_idle");
+		if (host_idle == "off")
+			host_idle_mode = HostIdleMode::Off;
+		else if (host_idle == "aggressive")
+			host_idle_mode = HostIdleMode::Aggressive;
+		else
+			host_idle_mode = HostIdleMode::Auto;
+
+		DYN_WarmupSetEnabled(section->Get_bool("dynamic_core_warmup"));
+		CPU_CycleProfilesSetEnabled(section->Get_bool("cycle_profiles"));
+
+		const auto sampling_hz = section->Get_int("sampling_profiler");
+		if (sampling_hz > 0) {
+			GUESTPROF_Start(sampling_hz);
+		} else {
+			GUESTPROF_Stop();
+		}
+
 		std::string core(section->Get_string("core"));
 		cpudecoder=&CPU_Core_Normal_Run;
 		if (core == "normal") {
@@ -2427,6 +2488,14 @@ public:
 static CPU * test;
 
 void CPU_ShutDown([[maybe_unused]] Section* sec) {
+	TIMER_DelTickHandler(CPU_IdleTickCounter);
+	if (total_tick_count > 0) {
+		LOG_MSG("CPU: Guest signalled idle during %.1f%% of emulated time",
+		        100.0 * static_cast<double>(idle_tick_count) /
+		                static_cast<double>(total_tick_count));
+	}
+	DYN_WarmupSaveCache();
+	CPU_CycleProfilesSave();
 #if (C_DYNAMIC_X86)
 	CPU_Core_Dyn_X86_Cache_Close();
 #elif (C_DYNREC)
@@ -2441,6 +2510,8 @@ void CPU_Init(Section* sec)
 
 	test = new (std::nothrow) CPU(sec);
 
+	TIMER_AddTickHandler(CPU_IdleTickCounter);
+
 	constexpr auto changeable_at_runtime = true;
 	sec->AddDestroyFunction(&CPU_ShutDown, changeable_at_runtime);
 }
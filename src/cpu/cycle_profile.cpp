@@ -0,0 +1,225 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "cpu.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+
+#include "cross.h"
+#include "logging.h"
+#include "timer.h"
+
+#define XXH_INLINE_ALL 1
+#define XXH_NO_INLINE_HINTS 1
+#define XXH_STATIC_LINKING_ONLY 1
+#include "../libs/decoders/xxhash.h"
+
+// Persistent per-executable profiles for the auto cycle guessing code.
+//
+// DOS_Execute hands over the first chunk of every launched binary. The
+// converged CPU_CycleMax of the previous program is folded into its
+// stored profile and the profile recorded for the new program in an
+// earlier session is applied right away, so a relaunched title starts
+// at last session's end state instead of oscillating through the first
+// minute of guesses.
+
+// Keep the store bounded: enough for a sizeable game collection
+constexpr size_t MaxProfiles = 4096;
+
+// Launches shorter than this are not recorded: the guessing code has
+// not converged yet, and installers or loader stubs chaining into the
+// real game would otherwise pollute the profile of the stub
+constexpr int64_t MinRuntimeMs = 10000;
+
+// Matches the hardcoded ceiling the auto adjustment applies when no
+// explicit cycle limit is configured
+constexpr int32_t MaxStoredCycles = 2000000;
+
+constexpr uint32_t ProfileFileMagic = 0x31505943; // "CYP1"
+constexpr auto ProfileFileName      = "cycle_profiles.cache";
+
+struct CycleProfile {
+	int32_t cycles  = 0;
+	int32_t percent = 0;
+};
+
+static bool profiles_enabled = false;
+static bool profiles_loaded  = false;
+static bool profiles_dirty   = false;
+
+// Stored profiles, keyed by the content hash of the executable image
+static std::map<uint64_t, CycleProfile> profiles = {};
+
+// The executable currently being refined
+static bool have_active        = false;
+static uint64_t active_hash    = 0;
+static int64_t active_since_ms = 0;
+
+static std_fs::path get_profile_path()
+{
+	return GetConfigDir() / ProfileFileName;
+}
+
+static void load_profiles()
+{
+	profiles_loaded = true;
+
+	std::ifstream file(get_profile_path(), std::ios::binary);
+	if (!file) {
+		return;
+	}
+	uint32_t magic = 0;
+	file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	if (!file || magic != ProfileFileMagic) {
+		LOG_WARNING("CPU: Ignoring cycle profile store with unknown format");
+		return;
+	}
+	uint32_t num_profiles = 0;
+	file.read(reinterpret_cast<char*>(&num_profiles), sizeof(num_profiles));
+
+	for (uint32_t i = 0;
+	     file && i < std::min<size_t>(num_profiles, MaxProfiles); ++i) {
+		uint64_t hash = 0;
+		CycleProfile profile = {};
+		file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+		file.read(reinterpret_cast<char*>(&profile.cycles),
+		          sizeof(profile.cycles));
+		file.read(reinterpret_cast<char*>(&profile.percent),
+		          sizeof(profile.percent));
+		const bool valid = file &&
+		                   profile.cycles >= CPU_CYCLES_LOWER_LIMIT &&
+		                   profile.cycles <= MaxStoredCycles &&
+		                   profile.percent > 0 && profile.percent <= 100;
+		if (!valid) {
+			profiles.clear();
+			return;
+		}
+		profiles[hash] = profile;
+	}
+	LOG_MSG("CPU: Loaded cycle profiles for %u executables",
+	        static_cast<uint32_t>(profiles.size()));
+}
+
+// Fold the current cycles into the stored profile of the program that
+// has been running since the last launch notification
+static void flush_active()
+{
+	if (!have_active) {
+		return;
+	}
+	have_active = false;
+
+	if (!CPU_CycleAutoAdjust) {
+		return;
+	}
+	if (GetTicks() - active_since_ms < MinRuntimeMs) {
+		return;
+	}
+	if (profiles.size() >= MaxProfiles && !profiles.count(active_hash)) {
+		return;
+	}
+	auto& profile = profiles[active_hash];
+
+	// Weigh earlier sessions three to one so a single unusual run
+	// (menus only, background load) shifts the profile but does not
+	// overwrite it
+	if (profile.cycles > 0 && profile.percent == CPU_CyclePercUsed) {
+		profile.cycles = (profile.cycles * 3 + CPU_CycleMax) / 4;
+	} else {
+		profile.cycles = CPU_CycleMax;
+	}
+	profile.percent = CPU_CyclePercUsed;
+	profiles_dirty  = true;
+}
+
+void CPU_CycleProfilesSetEnabled(const bool enabled)
+{
+	profiles_enabled = enabled;
+}
+
+void CPU_CycleProfilesNotifyLaunch(const uint8_t* image, const size_t image_len)
+{
+	if (!profiles_enabled || !image || !image_len) {
+		return;
+	}
+	if (!profiles_loaded) {
+		load_profiles();
+	}
+	flush_active();
+
+	active_hash     = XXH3_64bits(image, image_len);
+	active_since_ms = GetTicks();
+	have_active     = true;
+
+	if (!CPU_CycleAutoAdjust) {
+		return;
+	}
+	const auto it = profiles.find(active_hash);
+	if (it == profiles.end()) {
+		return;
+	}
+	// A profile converged under a different usage target is not
+	// comparable, leave the guessing code to start from scratch
+	if (it->second.percent != CPU_CyclePercUsed) {
+		return;
+	}
+	auto cycles = it->second.cycles;
+	if (CPU_CycleLimit > 0 && cycles > CPU_CycleLimit) {
+		cycles = CPU_CycleLimit;
+	}
+	if (cycles < CPU_CYCLES_LOWER_LIMIT) {
+		cycles = CPU_CYCLES_LOWER_LIMIT;
+	}
+	CPU_CycleMax = cycles;
+	LOG_MSG("CPU: Warm-starting auto cycles at %d from the profile store",
+	        CPU_CycleMax);
+}
+
+void CPU_CycleProfilesSave()
+{
+	if (!profiles_enabled) {
+		return;
+	}
+	flush_active();
+	if (!profiles_dirty) {
+		return;
+	}
+	std::ofstream file(get_profile_path(), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		LOG_WARNING("CPU: Failed writing cycle profile store");
+		return;
+	}
+	const auto num_profiles = static_cast<uint32_t>(profiles.size());
+	file.write(reinterpret_cast<const char*>(&ProfileFileMagic),
+	           sizeof(ProfileFileMagic));
+	file.write(reinterpret_cast<const char*>(&num_profiles),
+	           sizeof(num_profiles));
+
+	for (const auto& [hash, profile] : profiles) {
+		file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+		file.write(reinterpret_cast<const char*>(&profile.cycles),
+		           sizeof(profile.cycles));
+		file.write(reinterpret_cast<const char*>(&profile.percent),
+		           sizeof(profile.percent));
+	}
+	profiles_dirty = false;
+}
@@ -81,6 +81,12 @@ public:
 	struct Cache {
 		const uint8_t* start = {}; // where in the cache are we
 
+		// entry point used by direct jumps from linked blocks; cores
+		// that emit a register preload prologue for dispatcher entries
+		// (see the linked register contract in core_dyn_x86) point this
+		// past the prologue, otherwise it equals start
+		const uint8_t* start_linked = {};
+
 		Bitu size        = 0;
 		CacheBlock* next = {};
 		// writemap masking maskpointer/start/length to allow holes in
@@ -116,6 +122,11 @@ public:
 	} link[2] = {};                // maximum two links (conditional jumps)
 
 	CacheBlock* crossblock = {};
+
+	// dispatcher-entry counter and marker for the dynrec trace
+	// formation (see CreateCacheBlock in core_dynrec/decoder.h)
+	uint16_t hot_count = 0;
+	bool is_trace      = false;
 };
 
 static_assert(std::is_standard_layout_v<CacheBlock::Page>, "standard-layout is required for offsetof");
@@ -154,6 +165,43 @@ static uint8_t* cache_code_link_blocks = {};
 static std::vector<CacheBlock> cache_blocks(CACHE_BLOCKS);
 static CacheBlock link_blocks[2] = {}; // default linking (specially marked)
 
+// diagnostics for self-modifying-code handling: blocks cleared by guest
+// writes, and clears avoided because the write only touched masked bytes
+// (reported on shutdown, see cache_close)
+static uint64_t cache_smc_invalidations  = 0;
+static uint64_t cache_smc_clears_avoided = 0;
+
+// eviction accounting for the ring allocator: blocks retired in place so
+// the frontier could reuse their space, and full laps of the frontier
+// around the arena (reported via the telemetry endpoint for tuning
+// CACHE_TOTAL per title)
+static uint64_t cache_frontier_evictions = 0;
+static uint64_t cache_frontier_wraps     = 0;
+
+// test whether a write range touches bytes a block was actually translated
+// from; blocks can contain masked bytes (wmapmask) holding immediates that
+// the generated code reads back from guest memory at runtime, so writes
+// landing only on those do not stale the translation
+static bool cache_block_covers_range(const CacheBlock *block, Bitu start, Bitu end)
+{
+	if (!block->cache.wmapmask)
+		return true;
+	Bitu from = start;
+	if (from < block->page.start)
+		from = block->page.start;
+	Bitu to = end;
+	if (to > block->page.end)
+		to = block->page.end;
+	for (Bitu addr = from; addr <= to; addr++) {
+		if (addr < block->cache.maskstart)
+			return true; // before the mask: plain code
+		const Bitu maskct = addr - block->cache.maskstart;
+		if (maskct >= block->cache.masklen || !block->cache.wmapmask[maskct])
+			return true;
+	}
+	return false; // the write only hit masked bytes
+}
+
 // the CodePageHandler class provides access to the contained
 // cache blocks and intercepts writes to the code for special treatment
 class CodePageHandler final : public PageHandler {
@@ -176,6 +224,7 @@ public:
 
 		active_blocks=0;
 		active_count=16;
+		warmup_replayed=false;
 
 		// initialize the maps with zero (no cache blocks as well as
 		// code present)
@@ -211,10 +260,17 @@ public:
 				CacheBlock *nextblock = block->hash.next;
 				// test if this block is in the range
 				if (start<=block->page.end && end>=block->page.start) {
-					if (ip_point<=block->page.end && ip_point>=block->page.start) is_current_block=true;
-					block->Clear(); // clear the block,
-					                // decrements the
-					                // write_map accordingly
+					if (GCC_UNLIKELY(!cache_block_covers_range(block, start, end))) {
+						// the write only hit bytes the
+						// block reads back at runtime
+						cache_smc_clears_avoided++;
+					} else {
+						if (ip_point<=block->page.end && ip_point>=block->page.start) is_current_block=true;
+						block->Clear(); // clear the block,
+						                // decrements the
+						                // write_map accordingly
+						cache_smc_invalidations++;
+					}
 				}
 				block=nextblock;
 			}
@@ -475,9 +531,10 @@ public:
 
 	void Release()
 	{
-		// revert to old handler
+		// revert to old handler; only TLB entries resolving into this
+		// one physical page can reference the retired handler
 		MEM_SetPageHandler(phys_page,1,old_pagehandler);
-		PAGING_ClearTLB();
+		PAGING_UnlinkPhysPages(phys_page,1);
 
 		// remove page from the lists
 		if (prev) prev->next=next;
@@ -523,6 +580,16 @@ public:
 		return hostmem;
 	}
 
+	// Host pointer to this code page's guest memory, for the
+	// warm-up hint content hashing (dyn_warmup.h)
+	HostPt GetHostCodePt()
+	{
+		if (!hostmem) {
+			GetHostReadPt(phys_page);
+		}
+		return hostmem;
+	}
+
 	HostPt GetHostWritePt(Bitu phys_page) override
 	{
 		return GetHostReadPt(phys_page);
@@ -534,6 +601,9 @@ public:
 	uint8_t write_map[4096] = {};
 	uint8_t *invalidation_map = nullptr;
 
+	// set once the warm-up hints for this page have been replayed
+	bool warmup_replayed = false;
+
 	CodePageHandler *prev = nullptr;
 	CodePageHandler *next = nullptr;
 
@@ -550,6 +620,54 @@ private:
 	Bitu phys_page = 0;
 };
 
+// Small branch-target buffer for dispatcher entries. Indirect control
+// transfers (returns above all) exit the generated code with BR_Normal and
+// re-enter through the dispatcher, which walks the code page's hash map
+// every time. The buffer remembers the block the dispatcher resolved for a
+// linear CS:EIP so the next return to the same target skips the walk. A
+// hit is only taken when the cached block is still registered in the
+// cached page handler at the right page offset and that handler is still
+// the one the TLB resolves the address to, so cleared or reused blocks and
+// remapped pages fall back to the full lookup naturally; no invalidation
+// hooks are needed.
+#define DYN_BTB_SIZE 512 // must be a power of two
+
+static struct {
+	PhysPt ip = 0;
+	bool big = false;
+	CacheBlock *block = nullptr;
+	CodePageHandler *handler = nullptr;
+} dyn_btb[DYN_BTB_SIZE];
+
+static inline Bitu dyn_btb_index(const PhysPt ip_point)
+{
+	return (ip_point ^ (ip_point >> DYN_HASH_SHIFT)) & (DYN_BTB_SIZE - 1);
+}
+
+static inline CacheBlock *dyn_btb_lookup(const PhysPt ip_point)
+{
+	const auto &entry = dyn_btb[dyn_btb_index(ip_point)];
+	CacheBlock *block = entry.block;
+	if (block && entry.ip == ip_point && entry.big == cpu.code.big &&
+	    block->page.handler == entry.handler &&
+	    block->page.start == (ip_point & 4095) &&
+	    static_cast<PageHandler *>(entry.handler) ==
+	            get_tlb_readhandler(ip_point)) {
+		return block;
+	}
+	return nullptr;
+}
+
+static inline void dyn_btb_insert(const PhysPt ip_point,
+                                  CodePageHandler *handler, CacheBlock *block)
+{
+	auto &entry = dyn_btb[dyn_btb_index(ip_point)];
+	entry.ip = ip_point;
+	entry.big = cpu.code.big;
+	entry.block = block;
+	entry.handler = handler;
+}
+
 static inline void cache_add_unused_block(CacheBlock *block)
 {
 	// block has become unused, add it to the freelist
@@ -697,8 +815,10 @@ static CacheBlock *cache_openblock()
 	// check for enough space in this block
 	Bitu size=block->cache.size;
 	CacheBlock *nextblock = block->cache.next;
-	if (block->page.handler)
+	if (block->page.handler) {
 		block->Clear();
+		cache_frontier_evictions++;
+	}
 	// block size must be at least CACHE_MAXSIZE
 	while (size<CACHE_MAXSIZE) {
 		if (!nextblock)
@@ -706,8 +826,10 @@ static CacheBlock *cache_openblock()
 		// merge blocks
 		size+=nextblock->cache.size;
 		CacheBlock *tempblock = nextblock->cache.next;
-		if (nextblock->page.handler)
+		if (nextblock->page.handler) {
 			nextblock->Clear();
+			cache_frontier_evictions++;
+		}
 		// block is free now
 		cache_add_unused_block(nextblock);
 		nextblock=tempblock;
@@ -716,7 +838,10 @@ skipresize:
 	// adjust parameters and open this block
 	block->cache.size=size;
 	block->cache.next=nextblock;
+	block->hot_count=0;
+	block->is_trace=false;
 	cache.pos=block->cache.start;
+	block->cache.start_linked=block->cache.start;
 	return block;
 }
 
@@ -765,8 +890,11 @@ static void cache_closeblock()
 	                            (block->cache.next->cache.start > limit));
 #endif
 	if (cache_is_full) {
-		// LOG_DEBUG("Cache full; restarting");
+		// The arena is a ring: wrap the frontier back to the start and
+		// keep retiring blocks one at a time as it advances (see
+		// cache_openblock), so steady state never pays a full flush
 		cache.block.active=cache.block.first;
+		cache_frontier_wraps++;
 	} else {
 		cache.block.active=block->cache.next;
 	}
@@ -1024,6 +1152,7 @@ static void cache_init(bool enable) {
 			// setup the default blocks for block linkage returns
 			cache.pos = &cache_code_link_blocks[code_pos];
 			link_blocks[block_num].cache.start = cache.pos;
+			link_blocks[block_num].cache.start_linked = cache.pos;
 			// link code that returns with a special return code
 			// must be less than 32 bytes
 			dyn_return(block_num == 0 ? BR_Link1 : BR_Link2, false);
@@ -1072,6 +1201,15 @@ static void cache_init(bool enable) {
 }
 
 static void cache_close(void) {
+	if (cache_smc_invalidations || cache_smc_clears_avoided) {
+		LOG_MSG("CPU: Self-modifying code cleared %" PRIu64 " cache "
+		        "blocks; the write-mask overlap test avoided %" PRIu64
+		        " clears",
+		        cache_smc_invalidations,
+		        cache_smc_clears_avoided);
+		cache_smc_invalidations  = 0;
+		cache_smc_clears_avoided = 0;
+	}
 /*	for (;;) {
 		if (cache.used_pages) {
 			CodePageHandler * cpage=cache.used_pages;
@@ -1095,3 +1233,29 @@ static void cache_close(void) {
 	cache_code_link_blocks = NULL;
 	cache_initialized = false; */
 }
+
+// Occupancy of the translation cache, for the telemetry endpoint. The
+// block allocator is linear with cleared blocks recycled in place, so the
+// distance from the cache base to the active frontier block is the
+// high-water mark of generated code.
+Bitu CPU_GetDynCacheUsedBytes()
+{
+	if (!cache_initialized || !cache.block.active || !cache_code) {
+		return 0;
+	}
+	return static_cast<Bitu>(cache.block.active->cache.start - cache_code);
+}
+
+Bitu CPU_GetDynCacheTotalBytes()
+{
+	return CACHE_TOTAL;
+}
+
+// Frontier-reuse eviction counters; a high eviction rate or frequent wraps
+// on a title means the working set exceeds CACHE_TOTAL and retranslation
+// is churning
+void CPU_GetDynCacheEvictionStats(uint64_t& evictions, uint64_t& wraps)
+{
+	evictions = cache_frontier_evictions;
+	wraps     = cache_frontier_wraps;
+}
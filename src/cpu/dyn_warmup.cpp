@@ -0,0 +1,169 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "dyn_warmup.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <set>
+
+#include "cross.h"
+#include "logging.h"
+
+#define XXH_INLINE_ALL 1
+#define XXH_NO_INLINE_HINTS 1
+#define XXH_STATIC_LINKING_ONLY 1
+#include "../libs/decoders/xxhash.h"
+
+constexpr auto CodePageSize = 4096;
+
+// Keep the cache bounded: enough for several large executables
+constexpr size_t MaxCachedPages     = 8192;
+constexpr size_t MaxEntriesPerPage  = 256;
+
+constexpr uint32_t CacheFileMagic   = 0x31555744; // "DWU1"
+constexpr auto CacheFileName        = "dynrec_warmup.cache";
+
+static bool warmup_enabled = false;
+static bool cache_loaded   = false;
+static bool cache_dirty    = false;
+
+// Per-page entry offsets, keyed by the page's content hash
+static std::map<uint64_t, std::set<uint16_t>> cached_pages = {};
+
+static uint64_t hash_page(const uint8_t* page_mem)
+{
+	return XXH3_64bits(page_mem, CodePageSize);
+}
+
+static std_fs::path get_cache_path()
+{
+	return GetConfigDir() / CacheFileName;
+}
+
+static void load_cache()
+{
+	cache_loaded = true;
+
+	std::ifstream file(get_cache_path(), std::ios::binary);
+	if (!file) {
+		return;
+	}
+	uint32_t magic = 0;
+	file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	if (!file || magic != CacheFileMagic) {
+		LOG_WARNING("CPU: Ignoring dynrec warmup cache with unknown format");
+		return;
+	}
+	uint32_t num_pages = 0;
+	file.read(reinterpret_cast<char*>(&num_pages), sizeof(num_pages));
+
+	for (uint32_t i = 0; file && i < std::min<size_t>(num_pages, MaxCachedPages);
+	     ++i) {
+		uint64_t hash       = 0;
+		uint16_t num_offsets = 0;
+		file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+		file.read(reinterpret_cast<char*>(&num_offsets), sizeof(num_offsets));
+		if (!file || num_offsets > MaxEntriesPerPage) {
+			cached_pages.clear();
+			return;
+		}
+		auto& offsets = cached_pages[hash];
+		for (uint16_t j = 0; file && j < num_offsets; ++j) {
+			uint16_t offset = 0;
+			file.read(reinterpret_cast<char*>(&offset), sizeof(offset));
+			offsets.insert(offset);
+		}
+	}
+	LOG_MSG("CPU: Loaded dynrec warmup hints for %u code pages",
+	        static_cast<uint32_t>(cached_pages.size()));
+}
+
+void DYN_WarmupSetEnabled(const bool enabled)
+{
+	warmup_enabled = enabled;
+}
+
+bool DYN_WarmupIsEnabled()
+{
+	return warmup_enabled;
+}
+
+void DYN_WarmupRecordEntry(const uint8_t* page_mem, const uint16_t offset)
+{
+	if (!warmup_enabled || !page_mem) {
+		return;
+	}
+	if (!cache_loaded) {
+		load_cache();
+	}
+	if (cached_pages.size() >= MaxCachedPages) {
+		return;
+	}
+	auto& offsets = cached_pages[hash_page(page_mem)];
+	if (offsets.size() >= MaxEntriesPerPage) {
+		return;
+	}
+	cache_dirty |= offsets.insert(offset).second;
+}
+
+std::vector<uint16_t> DYN_WarmupGetEntries(const uint8_t* page_mem)
+{
+	if (!warmup_enabled || !page_mem) {
+		return {};
+	}
+	if (!cache_loaded) {
+		load_cache();
+	}
+	const auto it = cached_pages.find(hash_page(page_mem));
+	if (it == cached_pages.end()) {
+		return {};
+	}
+	return {it->second.begin(), it->second.end()};
+}
+
+void DYN_WarmupSaveCache()
+{
+	if (!warmup_enabled || !cache_dirty) {
+		return;
+	}
+	std::ofstream file(get_cache_path(), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		LOG_WARNING("CPU: Failed writing dynrec warmup cache");
+		return;
+	}
+	const auto num_pages = static_cast<uint32_t>(cached_pages.size());
+	file.write(reinterpret_cast<const char*>(&CacheFileMagic),
+	           sizeof(CacheFileMagic));
+	file.write(reinterpret_cast<const char*>(&num_pages), sizeof(num_pages));
+
+	for (const auto& [hash, offsets] : cached_pages) {
+		const auto num_offsets = static_cast<uint16_t>(offsets.size());
+		file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+		file.write(reinterpret_cast<const char*>(&num_offsets),
+		           sizeof(num_offsets));
+		for (const auto offset : offsets) {
+			file.write(reinterpret_cast<const char*>(&offset),
+			           sizeof(offset));
+		}
+	}
+	cache_dirty = false;
+}
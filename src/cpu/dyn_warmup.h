@@ -0,0 +1,56 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DOSBOX_DYN_WARMUP_H
+#define DOSBOX_DYN_WARMUP_H
+
+#include "dosbox.h"
+
+#include <cstdint>
+#include <vector>
+
+// Persistent warm-up hints for the dynamic recompiler cores.
+//
+// During a session the cores record the entry offsets of every block they
+// translate, keyed by a content hash of the surrounding guest code page.
+// The hints are written to the config directory on shutdown and replayed
+// on the next run: when a code page with a known hash takes its first
+// dispatcher miss, all previously-seen entry points in it are translated
+// in one batch instead of trickling in miss by miss.
+//
+// Only translation *order* is cached, never generated machine code --
+// emitted blocks embed absolute host addresses, so mapping them back in
+// across runs would be unsound.
+
+void DYN_WarmupSetEnabled(const bool enabled);
+bool DYN_WarmupIsEnabled();
+
+// Record that a block was translated at 'offset' within the 4 KB code
+// page whose guest contents live at 'page_mem'
+void DYN_WarmupRecordEntry(const uint8_t* page_mem, const uint16_t offset);
+
+// Entry offsets recorded for a page with identical contents in a prior
+// session, or an empty list when the page is unknown
+std::vector<uint16_t> DYN_WarmupGetEntries(const uint8_t* page_mem);
+
+// Write the accumulated hints back to disk, if dirty
+void DYN_WarmupSaveCache();
+
+#endif
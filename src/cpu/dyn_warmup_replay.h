@@ -0,0 +1,62 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// Shared between the dynamic cores; include after the core's decoder so
+// the core-specific MakeCodePage and CreateCacheBlock are in scope (same
+// pattern as dyn_cache.h).
+
+#include "dyn_warmup.h"
+
+// Record this dispatcher miss for the next session and, on the first
+// miss in a page, batch-translate the entry points recorded for the
+// same page contents in earlier sessions (see dyn_warmup.h).
+static void warmup_code_page(CodePageHandler* chandler, const PhysPt ip_point)
+{
+	if (!DYN_WarmupIsEnabled()) {
+		return;
+	}
+	DYN_WarmupRecordEntry(chandler->GetHostCodePt(),
+	                      static_cast<uint16_t>(ip_point & 4095));
+	if (chandler->warmup_replayed) {
+		return;
+	}
+	chandler->warmup_replayed = true;
+
+	for (const auto offset : DYN_WarmupGetEntries(chandler->GetHostCodePt())) {
+		const PhysPt entry_point = (ip_point & ~4095u) | offset;
+		if (entry_point == ip_point) {
+			continue;
+		}
+		// Translation can wrap the code cache and recycle page
+		// handlers, so re-check that this page is still live
+		CodePageHandler* check = nullptr;
+		if (MakeCodePage(entry_point, check) || check != chandler) {
+			break;
+		}
+		if (chandler->FindCacheBlock(entry_point & 4095)) {
+			continue;
+		}
+		if (chandler->invalidation_map &&
+		    chandler->invalidation_map[offset] >= 4) {
+			continue;
+		}
+		CreateCacheBlock(chandler, entry_point, 32);
+	}
+}
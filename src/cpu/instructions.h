@@ -192,37 +192,37 @@
 
 
 #define INCB(op1,load,save)									\
-	LoadCF;lf_var1b=load(op1);								\
+	PreserveCF();lf_var1b=load(op1);								\
 	lf_resb=lf_var1b+1;										\
 	save(op1,lf_resb);										\
 	lflags.type=t_INCb;										\
 
 #define INCW(op1,load,save)									\
-	LoadCF;lf_var1w=load(op1);								\
+	PreserveCF();lf_var1w=load(op1);								\
 	lf_resw=lf_var1w+1;										\
 	save(op1,lf_resw);										\
 	lflags.type=t_INCw;
 
 #define INCD(op1,load,save)									\
-	LoadCF;lf_var1d=load(op1);								\
+	PreserveCF();lf_var1d=load(op1);								\
 	lf_resd=lf_var1d+1;										\
 	save(op1,lf_resd);										\
 	lflags.type=t_INCd;
 
 #define DECB(op1,load,save)									\
-	LoadCF;lf_var1b=load(op1);								\
+	PreserveCF();lf_var1b=load(op1);								\
 	lf_resb=lf_var1b-1;										\
 	save(op1,lf_resb);										\
 	lflags.type=t_DECb;
 
 #define DECW(op1,load,save)									\
-	LoadCF;lf_var1w=load(op1);								\
+	PreserveCF();lf_var1w=load(op1);								\
 	lf_resw=lf_var1w-1;										\
 	save(op1,lf_resw);										\
 	lflags.type=t_DECw;
 
 #define DECD(op1,load,save)									\
-	LoadCF;lf_var1d=load(op1);								\
+	PreserveCF();lf_var1d=load(op1);								\
 	lf_resd=lf_var1d-1;										\
 	save(op1,lf_resd);										\
 	lflags.type=t_DECd;
@@ -118,6 +118,27 @@ inline void SETFLAGSd(const uint32_t FLAGD)
 	CPU_SetFlagsd(FLAGD);
 }
 
+// INC and DEC overwrite every arithmetic flag except CF, so they have to
+// materialise CF into reg_flags before replacing the lazy state. When the
+// previous instruction was itself an INC/DEC (or the flags are already
+// filled in) CF is already sitting in reg_flags and the whole lookup is
+// redundant; skipping it lets chains of INC/DEC bypass the lazy-flag
+// machinery entirely.
+inline void PreserveCF()
+{
+	switch (lflags.type) {
+	case t_UNKNOWN:
+	case t_INCb: case t_INCw: case t_INCd:
+	case t_DECb: case t_DECw: case t_DECd:
+	case t_MUL:
+		// get_CF() would just read reg_flags back for these types
+		return;
+	default:
+		SETFLAGBIT(CF, get_CF());
+		return;
+	}
+}
+
 #define LoadCF SETFLAGBIT(CF, get_CF());
 #define LoadZF SETFLAGBIT(ZF, get_ZF());
 #define LoadSF SETFLAGBIT(SF, get_SF());
@@ -20,6 +20,7 @@
 #include "paging.h"
 
 #include <cassert>
+#include <cinttypes>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -38,6 +39,11 @@
 
 PagingBlock paging;
 
+// Software TLB diagnostics: page walks serviced by the init handler (refills)
+// and full flushes of all linked pages, reported on shutdown
+static uint64_t tlb_refills = 0;
+static uint64_t tlb_flushes = 0;
+
 uint8_t PageHandler::readb(PhysPt addr)
 {
 	E_Exit("No byte handler for read from %d",addr);	
@@ -394,6 +400,7 @@ public:
 	{
 		const auto lin_page = lin_addr >> 12;
 		uint32_t phys_page;
+		tlb_refills++;
 		if (paging.enabled) {
 			X86PageEntry table;
 			X86PageEntry entry;
@@ -773,6 +780,8 @@ bool PAGING_ForcePageInit(Bitu lin_addr) {
 	return false;
 }
 
+static void PAGING_PrelinkROMPages();
+
 #if defined(USE_FULL_TLB)
 void PAGING_InitTLB()
 {
@@ -787,6 +796,7 @@ void PAGING_InitTLB()
 
 void PAGING_ClearTLB()
 {
+	tlb_flushes++;
 	uint32_t * entries=&paging.links.entries[0];
 	for (;paging.links.used>0;paging.links.used--) {
 		const auto page=*entries++;
@@ -808,9 +818,28 @@ void PAGING_UnlinkPages(Bitu lin_page,Bitu pages) {
 	}
 }
 
+/* Unlinked entries stay on the links list; PAGING_ClearTLB resetting them a
+   second time later is harmless */
+void PAGING_UnlinkPhysPages(Bitu phys_page,Bitu pages) {
+	const uint32_t* entries=&paging.links.entries[0];
+	for (Bitu i=0;i<paging.links.used;i++) {
+		const auto page=entries[i];
+		if (paging.tlb.phys_page[page]>=phys_page &&
+		    paging.tlb.phys_page[page]<phys_page+pages) {
+			paging.tlb.read[page]=nullptr;
+			paging.tlb.write[page]=nullptr;
+			paging.tlb.readhandler[page]=&init_page_handler;
+			paging.tlb.writehandler[page]=&init_page_handler;
+		}
+	}
+}
+
 void PAGING_MapPage(Bitu lin_page,Bitu phys_page) {
 	if (lin_page<LINK_START) {
-		paging.firstmb[lin_page]=phys_page;
+		/* keep both A20 tables coherent; only the gate toggle itself
+		   is allowed to make them differ (in the HMA window) */
+		paging.firstmb_tables[0][lin_page]=phys_page;
+		paging.firstmb_tables[1][lin_page]=phys_page;
 		paging.tlb.read[lin_page]=nullptr;
 		paging.tlb.write[lin_page]=nullptr;
 		paging.tlb.readhandler[lin_page]=&init_page_handler;
@@ -830,6 +859,7 @@ void PAGING_LinkPage(uint32_t lin_page,uint32_t phys_page) {
 		LOG(LOG_PAGING,LOG_NORMAL)("Not enough paging links, resetting cache");
 		PAGING_ClearTLB();
 		assert(paging.links.used == 0);
+		PAGING_PrelinkROMPages();
 	}
 
 	paging.tlb.phys_page[lin_page]=phys_page;
@@ -890,6 +920,7 @@ void PAGING_InitTLB()
 
 void PAGING_ClearTLB()
 {
+	tlb_flushes++;
 	uint32_t* entries = &paging.links.entries[0];
 	for (;paging.links.used>0;paging.links.used--) {
 		Bitu page=*entries++;
@@ -913,9 +944,27 @@ void PAGING_UnlinkPages(Bitu lin_page,Bitu pages) {
 	}
 }
 
+/* Unlinked entries stay on the links list; PAGING_ClearTLB resetting them a
+   second time later is harmless */
+void PAGING_UnlinkPhysPages(Bitu phys_page,Bitu pages) {
+	for (Bitu i=0;i<paging.links.used;i++) {
+		Bitu page=paging.links.entries[i];
+		tlb_entry *entry = get_tlb_entry(page<<12);
+		if (entry->phys_page>=phys_page && entry->phys_page<phys_page+pages) {
+			entry->read=0;
+			entry->write=0;
+			entry->readhandler=&init_page_handler;
+			entry->writehandler=&init_page_handler;
+		}
+	}
+}
+
 void PAGING_MapPage(Bitu lin_page,Bitu phys_page) {
 	if (lin_page<LINK_START) {
-		paging.firstmb[lin_page]=phys_page;
+		/* keep both A20 tables coherent; only the gate toggle itself
+		   is allowed to make them differ (in the HMA window) */
+		paging.firstmb_tables[0][lin_page]=phys_page;
+		paging.firstmb_tables[1][lin_page]=phys_page;
 		paging.tlbh[lin_page].read=0;
 		paging.tlbh[lin_page].write=0;
 		paging.tlbh[lin_page].readhandler=&init_page_handler;
@@ -935,6 +984,7 @@ void PAGING_LinkPage(uint32_t lin_page, uint32_t phys_page)
 	if (paging.links.used>=PAGING_LINKS) {
 		LOG(LOG_PAGING,LOG_NORMAL)("Not enough paging links, resetting cache");
 		PAGING_ClearTLB();
+		PAGING_PrelinkROMPages();
 	}
 
 	tlb_entry *entry = get_tlb_entry(lin_base);
@@ -974,6 +1024,59 @@ void PAGING_LinkPage_ReadOnly(uint32_t lin_page, uint32_t phys_page)
 
 #endif
 
+/* Re-establish the direct read mappings of ROM pages straight after a full
+   TLB flush. Their content never changes and, with paging off, neither does
+   their mapping, so code running from the BIOS and video ROMs (interrupt
+   services, font reads) resumes at direct-memory speed instead of refaulting
+   through the init handler page by page; writes keep faulting into the ROM
+   handler as before. */
+static void PAGING_PrelinkROMPages() {
+	if (paging.enabled) return;
+	for (uint32_t lin_page=0;lin_page<LINK_START;lin_page++) {
+		const auto phys_page=paging.firstmb[lin_page];
+		if (!(MEM_GetPageHandler(phys_page)->flags & PFLAG_HASROM))
+			continue;
+		if (get_tlb_read(lin_page*MEM_PAGE_SIZE)) continue; // still linked
+		PAGING_LinkPage(lin_page,phys_page);
+	}
+}
+
+/* The first page of the HMA, i.e. the start of the A20 wraparound window */
+static constexpr Bitu first_hma_page = 1024/4;
+
+void PAGING_SelectA20Table(const bool a20_enabled) {
+	paging.firstmb = paging.firstmb_tables[a20_enabled ? 1 : 0].data();
+	/* Only the wraparound window's TLB entries changed meaning; pages
+	   outside it keep their links and need no invalidation */
+	PAGING_UnlinkPages(first_hma_page,LINK_START-first_hma_page);
+}
+
+void PAGING_InvalidateRange(Bitu lin_start,Bitu lin_end) {
+	const Bitu first=lin_start>>12;
+	const Bitu last=lin_end>>12;
+	if (GCC_UNLIKELY(first>last || last>=TLB_SIZE)) {
+		PAGING_ClearTLB();
+		return;
+	}
+	const Bitu count=last-first+1;
+	/* Wide ranges walk the link list instead, so only the entries that
+	   are actually resident get touched; as with PAGING_UnlinkPhysPages
+	   the unlinked entries staying on the list is harmless */
+	if (count>paging.links.used) {
+		const uint32_t* entries=&paging.links.entries[0];
+		for (Bitu i=0;i<paging.links.used;i++) {
+			const auto page=entries[i];
+			if (page>=first && page<=last)
+				PAGING_UnlinkPages(page,1);
+		}
+		return;
+	}
+	PAGING_UnlinkPages(first,count);
+}
+
+void PAGING_InvalidatePage(Bitu lin_addr) {
+	PAGING_InvalidateRange(lin_addr,lin_addr);
+}
 
 void PAGING_SetDirBase(Bitu cr3) {
 	assert(cr3 <= UINT32_MAX);
@@ -1002,6 +1105,7 @@ void PAGING_Enable(bool enabled) {
 		PAGING_SetDirBase(paging.cr3);
 	}
 	PAGING_ClearTLB();
+	PAGING_PrelinkROMPages();
 }
 
 bool PAGING_Enabled()
@@ -1015,11 +1119,26 @@ public:
 		/* Setup default Page Directory, force it to update */
 		paging.enabled=false;
 		PAGING_InitTLB();
+		/* Precompute the per-A20-state tables: identical identity
+		   mappings except for the wraparound window, where the
+		   disabled gate wraps the HMA back onto the first 64 KB */
 		for (auto i=0;i<LINK_START;i++) {
-			paging.firstmb[i]=i;
+			paging.firstmb_tables[0][i]=i;
+			paging.firstmb_tables[1][i]=i;
+		}
+		for (auto i=first_hma_page;i<LINK_START;i++) {
+			paging.firstmb_tables[0][i]=i-first_hma_page;
 		}
 		pf_queue.used=0;
 	}
+	~PAGING() override {
+		if (tlb_refills > 0) {
+			LOG_MSG("PAGING: Serviced %" PRIu64 " TLB refills and %" PRIu64 " full TLB flushes",
+			        tlb_refills, tlb_flushes);
+			tlb_refills = 0;
+			tlb_flushes = 0;
+		}
+	}
 };
 
 static std::unique_ptr<PAGING> paging_instance = nullptr;
@@ -23,6 +23,7 @@
 
 #include <string.h>
 #include <list>
+#include <unordered_set>
 #include <vector>
 #include <ctype.h>
 #include <fstream>
@@ -34,6 +35,7 @@ using namespace std;
 #include "debug.h"
 #include "cross.h" //snprintf
 #include "cpu.h"
+#include "guest_profiler.h"
 #include "video.h"
 #include "pic.h"
 #include "mapper.h"
@@ -132,6 +134,15 @@ DBGBlock dbg = {};
 Bitu cycle_count = 0;
 static bool debugging = false;
 
+// The UI redraw rate is decoupled from emulation progress: draw requests
+// mark the screen dirty and actual redraws run on a fixed low-frequency
+// interval, so an attached debugger perturbs the measured workload as
+// little as possible.
+constexpr int64_t ui_refresh_interval_ms = 50; // 20 Hz
+
+static int64_t last_ui_refresh_ticks = 0;
+static bool ui_dirty                 = false;
+
 static void SetColor(Bitu test) {
 	if (test) {
 		if (has_colors()) { wattrset(dbg.win_reg,COLOR_PAIR(PAIR_BYELLOW_BLACK));}
@@ -432,6 +443,48 @@ void CBreakpoint::Activate(bool _active)
 // Statics
 static std::list<CBreakpoint *> BPoints = {};
 
+#if C_HEAVY_DEBUG
+bool debug_heavy_armed = false;
+#else
+static bool debug_heavy_armed = false;
+#endif
+
+static void UpdateArmedFlag()
+{
+	debug_heavy_armed = cpuLog || logHeavy || zeroProtect ||
+	                    skipFirstInstruction || !BPoints.empty();
+}
+
+// Hashed index of the physical breakpoints' addresses, plus a flag for
+// the breakpoint types that need a full scan on every instruction. Lets
+// CheckBreakpoint reject the common no-hit case with a single lookup
+// instead of walking the list. Rebuilt on every list mutation, which is
+// never hot.
+static std::unordered_multiset<PhysPt> phys_bp_index = {};
+static bool have_scan_breakpoints = false;
+
+static void UpdateBreakpointIndex()
+{
+	phys_bp_index.clear();
+	have_scan_breakpoints = false;
+	for (const auto& bp : BPoints) {
+		switch (bp->GetType()) {
+		case BKPNT_PHYSICAL:
+			phys_bp_index.insert(bp->GetLocation());
+			break;
+		case BKPNT_MEMORY:
+		case BKPNT_MEMORY_READ:
+		case BKPNT_MEMORY_PROT:
+		case BKPNT_MEMORY_LINEAR:
+			have_scan_breakpoints = true;
+			break;
+		default:
+			break;
+		}
+	}
+	UpdateArmedFlag();
+}
+
 #if C_HEAVY_DEBUG
 template <typename T>
 void DEBUG_UpdateMemoryReadBreakpoints(const PhysPt addr)
@@ -467,6 +520,7 @@ CBreakpoint* CBreakpoint::AddBreakpoint(uint16_t seg, uint32_t off, bool once)
 	bp->SetAddress		(seg,off);
 	bp->SetOnce			(once);
 	BPoints.push_front	(bp);
+	UpdateBreakpointIndex();
 	return bp;
 }
 
@@ -476,6 +530,7 @@ CBreakpoint* CBreakpoint::AddIntBreakpoint(uint8_t intNum, uint16_t ah, uint16_t
 	bp->SetInt			(intNum,ah,al);
 	bp->SetOnce			(once);
 	BPoints.push_front	(bp);
+	UpdateBreakpointIndex();
 	return bp;
 }
 
@@ -486,6 +541,7 @@ CBreakpoint* CBreakpoint::AddMemBreakpoint(uint16_t seg, uint32_t off)
 	bp->SetOnce			(false);
 	bp->SetType			(BKPNT_MEMORY);
 	BPoints.push_front	(bp);
+	UpdateBreakpointIndex();
 	return bp;
 }
 
@@ -522,6 +578,12 @@ bool CBreakpoint::CheckBreakpoint(Bitu seg, Bitu off)
 	// Quick exit if there are no breakpoints
 	if (BPoints.empty()) return false;
 
+	// Hashed fast path: physical breakpoints are indexed by address, so
+	// a miss needs no list walk unless a memory breakpoint forces one
+	if (!have_scan_breakpoints &&
+	    phys_bp_index.find(GetAddress(seg, off)) == phys_bp_index.end())
+		return false;
+
 	// Search matching breakpoint
 	for (auto i = BPoints.begin(); i != BPoints.end(); ++i) {
 		auto bp = (*i);
@@ -534,6 +596,7 @@ bool CBreakpoint::CheckBreakpoint(Bitu seg, Bitu off)
 				BPoints.erase(i);
 				bp->Activate(false);
 				delete bp;
+				UpdateBreakpointIndex();
 			} else {
 				// Also look for once-only breakpoints at this address
 				bp = FindPhysBreakpoint(seg, off, true);
@@ -541,6 +604,7 @@ bool CBreakpoint::CheckBreakpoint(Bitu seg, Bitu off)
 					BPoints.remove(bp);
 					bp->Activate(false);
 					delete bp;
+					UpdateBreakpointIndex();
 				}
 			}
 			return true;
@@ -607,6 +671,7 @@ bool CBreakpoint::CheckIntBreakpoint([[maybe_unused]] PhysPt adr, uint8_t intNr,
 					BPoints.erase(i);
 					bp->Activate(false);
 					delete bp;
+					UpdateBreakpointIndex();
 				}
 				return true;
 			}
@@ -622,6 +687,7 @@ void CBreakpoint::DeleteAll()
 		delete bp;
 	}
 	BPoints.clear();
+	UpdateBreakpointIndex();
 }
 
 bool CBreakpoint::DeleteByIndex(uint16_t index)
@@ -637,6 +703,7 @@ bool CBreakpoint::DeleteByIndex(uint16_t index)
 	BPoints.erase(it);
 	bp->Activate(false);
 	delete bp;
+	UpdateBreakpointIndex();
 	return true;
 }
 
@@ -683,6 +750,7 @@ bool CBreakpoint::DeleteBreakpoint(uint16_t seg, uint32_t off)
 	if (bp) {
 		BPoints.remove(bp);
 		delete bp;
+		UpdateBreakpointIndex();
 		return true;
 	}
 
@@ -753,7 +821,13 @@ static bool StepOver()
 bool DEBUG_ExitLoop(void)
 {
 #if C_HEAVY_DEBUG
-	DrawVariables();
+	// this runs once per emulation loop iteration, so keep the variable
+	// overlay on the same low-frequency refresh as the rest of the UI
+	const auto now = GetTicks();
+	if (now - last_ui_refresh_ticks >= ui_refresh_interval_ms) {
+		last_ui_refresh_ticks = now;
+		DrawVariables();
+	}
 #endif
 
 	if (exitLoop) {
@@ -772,14 +846,37 @@ static void DrawData(void) {
 	uint8_t ch;
 	uint32_t add = dataOfs;
 	uint32_t address;
-	/* Data win */	
+
+	// shadow of the bytes currently on screen; while the view parameters
+	// are unchanged only cells whose memory content changed are rewritten
+	static uint8_t shownData[8 * 16] = {};
+	static uint32_t shownDataOfs     = 0;
+	static uint16_t shownDataSeg     = 0;
+	static bool shownPrintable       = false;
+	static bool shownValid           = false;
+
+	const bool sameView = shownValid && (shownDataOfs == dataOfs) &&
+	                      (shownDataSeg == dataSeg) &&
+	                      (shownPrintable == showPrintable);
+	bool windowchanges = !sameView;
+
+	/* Data win */
 	for (int y=0; y<8; y++) {
 		// Address
-		if (add<0x10000) mvwprintw (dbg.win_data,y,0,"%04X:%04X     ",dataSeg,add);
-		else mvwprintw (dbg.win_data,y,0,"%04X:%08X ",dataSeg,add);
+		if (!sameView) {
+			if (add<0x10000) mvwprintw (dbg.win_data,y,0,"%04X:%04X     ",dataSeg,add);
+			else mvwprintw (dbg.win_data,y,0,"%04X:%08X ",dataSeg,add);
+		}
 		for (int x=0; x<16; x++) {
 			address = GetAddress(dataSeg,add);
 			if (mem_readb_checked(address,&ch)) ch=0;
+			uint8_t& shown = shownData[y * 16 + x];
+			if (sameView && (shown == ch)) {
+				add++;
+				continue;
+			}
+			shown         = ch;
+			windowchanges = true;
 			mvwprintw (dbg.win_data,y,14+3*x,"%02X",ch);
 			if (showPrintable) {
 				if (ch<32 || !isprint(*reinterpret_cast<unsigned char*>(&ch))) ch='.';
@@ -795,10 +892,43 @@ static void DrawData(void) {
 			add++;
 		}
 	}
-	wrefresh(dbg.win_data);
+
+	shownDataOfs   = dataOfs;
+	shownDataSeg   = dataSeg;
+	shownPrintable = showPrintable;
+	shownValid     = true;
+
+	if (windowchanges) wrefresh(dbg.win_data);
 }
 
 static void DrawRegisters(void) {
+	// Skip the redraw when nothing the panel displays changed and no
+	// change highlight from the previous draw is waiting to be cleared
+	static bool hadHighlights    = false;
+	static auto shownCycleCount  = cycle_count;
+	static char shownSelector[3] = { 0,0,0 };
+
+	const bool regchanges =
+	        (reg_eax != oldregs.eax) || (reg_ebx != oldregs.ebx) ||
+	        (reg_ecx != oldregs.ecx) || (reg_edx != oldregs.edx) ||
+	        (reg_esi != oldregs.esi) || (reg_edi != oldregs.edi) ||
+	        (reg_ebp != oldregs.ebp) || (reg_esp != oldregs.esp) ||
+	        (reg_eip != oldregs.eip) || (reg_flags != oldflags) ||
+	        (SegValue(ds) != oldsegs[ds].val) ||
+	        (SegValue(es) != oldsegs[es].val) ||
+	        (SegValue(fs) != oldsegs[fs].val) ||
+	        (SegValue(gs) != oldsegs[gs].val) ||
+	        (SegValue(ss) != oldsegs[ss].val) ||
+	        (SegValue(cs) != oldsegs[cs].val) || (cpu.cpl != oldcpucpl);
+
+	if (!regchanges && !hadHighlights && (cycle_count == shownCycleCount) &&
+	    (memcmp(shownSelector, curSelectorName, sizeof(shownSelector)) == 0))
+		return;
+
+	hadHighlights   = regchanges;
+	shownCycleCount = cycle_count;
+	memcpy(shownSelector, curSelectorName, sizeof(shownSelector));
+
 	/* Main Registers */
 	SetColor(reg_eax!=oldregs.eax);oldregs.eax=reg_eax;mvwprintw (dbg.win_reg,0,4,"%08X",reg_eax);
 	SetColor(reg_ebx!=oldregs.ebx);oldregs.ebx=reg_ebx;mvwprintw (dbg.win_reg,1,4,"%08X",reg_ebx);
@@ -1103,6 +1233,11 @@ bool ParseCommand(char* str) {
 		return true;
 	}
 
+	if (command == "PROFDUMP") { // Dump guest sampling profile to file
+		GUESTPROF_Dump("profile.folded");
+		return true;
+	}
+
 	if (command == "IV") { // Insert variable
 		uint16_t seg = (uint16_t)GetHexValue(found,found); found++;
 		uint32_t ofs = (uint16_t)GetHexValue(found,found); found++;
@@ -1314,6 +1449,7 @@ bool ParseCommand(char* str) {
 		//Initialize log object
 		cpuLogFile << hex << noshowbase << setfill('0') << uppercase;
 		cpuLog = true;
+		UpdateArmedFlag();
 		cpuLogCounter = GetHexValue(found,found);
 
 		debugging = false;
@@ -1401,12 +1537,14 @@ bool ParseCommand(char* str) {
 #if C_HEAVY_DEBUG
 	if (command == "HEAVYLOG") { // Create Cpu log file
 		logHeavy = !logHeavy;
+		UpdateArmedFlag();
 		DEBUG_ShowMsg("DEBUG: Heavy cpu logging %s.\n",logHeavy?"on":"off");
 		return true;
 	}
 
 	if (command == "ZEROPROTECT") { //toggle zero protection
 		zeroProtect = !zeroProtect;
+		UpdateArmedFlag();
 		DEBUG_ShowMsg("DEBUG: Zero code execution protection %s.\n",zeroProtect?"on":"off");
 		return true;
 	}
@@ -1447,6 +1585,7 @@ bool ParseCommand(char* str) {
 
 		DEBUG_ShowMsg("MEMDUMP [seg]:[off] [len] - Write memory to file memdump.txt.\n");
 		DEBUG_ShowMsg("MEMDUMPBIN [s]:[o] [len]  - Write memory to file memdump.bin.\n");
+		DEBUG_ShowMsg("PROFDUMP                  - Write sampling profile to file profile.folded.\n");
 		DEBUG_ShowMsg("SELINFO [segName]         - Show selector info.\n");
 
 		DEBUG_ShowMsg("INTVEC [filename]         - Writes interrupt vector table to file.\n");
@@ -1662,6 +1801,7 @@ char* AnalyzeInstruction(char* inst, bool saveSelector) {
 
 int32_t DEBUG_Run(int32_t amount,bool quickexit) {
 	skipFirstInstruction = true;
+	UpdateArmedFlag();
 	CPU_Cycles = amount;
 	int32_t ret = (*cpudecoder)();
 	if (quickexit) SetCodeWinStart();
@@ -1925,7 +2065,7 @@ uint32_t DEBUG_CheckKeys(void) {
 		if (ret<0) return ret;
 		if (ret>0) {
 			if (GCC_UNLIKELY(ret >= CB_MAX))
-				ret = 0;
+				ret = ret - CB_MAX; // handler already ran inline
 			else
 				ret = (*CallBack_Handlers[ret])();
 			if (ret) {
@@ -1944,6 +2084,9 @@ uint32_t DEBUG_CheckKeys(void) {
 Bitu DEBUG_Loop(void) {
 //TODO Disable sound
 	GFX_Events();
+	// flush a redraw that was deferred by the UI refresh throttle
+	if (ui_dirty)
+		DEBUG_DrawScreen();
 	// Interrupt started ? - then skip it
 	uint16_t oldCS	= SegValue(cs);
 	uint32_t oldEIP	= reg_eip;
@@ -1987,6 +2130,7 @@ void DEBUG_Enable(bool pressed)
 	SDL_RaiseWindow(pdc_window);
 	SDL_SetWindowInputFocus(pdc_window);
 	SetCodeWinStart();
+	last_ui_refresh_ticks = 0; // draw immediately on entry
 	DEBUG_DrawScreen();
 
 	// Maybe show help for the first time in the debugger
@@ -2004,6 +2148,16 @@ void DEBUG_Enable(bool pressed)
 }
 
 void DEBUG_DrawScreen(void) {
+	// Coalesce redraw requests onto the fixed UI refresh interval; any
+	// request arriving early marks the screen dirty and DEBUG_Loop()
+	// flushes it once the interval elapses
+	ui_dirty       = true;
+	const auto now = GetTicks();
+	if (now - last_ui_refresh_ticks < ui_refresh_interval_ms)
+		return;
+	last_ui_refresh_ticks = now;
+	ui_dirty              = false;
+
 	DrawData();
 	DrawCode();
 	DrawRegisters();
@@ -2690,6 +2844,7 @@ void DEBUG_HeavyWriteLogInstruction()
 {
 	if (!logHeavy) return;
 	logHeavy = false;
+	UpdateArmedFlag();
 
 	DEBUG_ShowMsg("DEBUG: Creating cpu log LOGCPU_INT_CD.TXT\n");
 
@@ -2726,7 +2881,9 @@ void DEBUG_HeavyWriteLogInstruction()
 	DEBUG_ShowMsg("DEBUG: Done.\n");
 }
 
-bool DEBUG_HeavyIsBreakpoint(void) {
+// Slow path behind the inline debug_heavy_armed test in debug.h; only
+// reached while a breakpoint, log, or protection feature is active
+bool DEBUG_HeavyIsBreakpointImpl() {
 	static Bitu zero_count = 0;
 	if (cpuLog) {
 		if (cpuLogCounter>0) {
@@ -2738,6 +2895,7 @@ bool DEBUG_HeavyIsBreakpoint(void) {
 			cpuLogFile.close();
 			DEBUG_ShowMsg("DEBUG: cpu log LOGCPU.TXT created\n");
 			cpuLog = false;
+			UpdateArmedFlag();
 			DEBUG_EnableDebugger();
 			return true;
 		}
@@ -2755,6 +2913,7 @@ bool DEBUG_HeavyIsBreakpoint(void) {
 
 	if (skipFirstInstruction) {
 		skipFirstInstruction = false;
+		UpdateArmedFlag();
 		return false;
 	}
 	if (BPoints.size() && CBreakpoint::CheckBreakpoint(SegValue(cs), reg_eip))
@@ -24,13 +24,18 @@
 
 #include "dosbox.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <cstring>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <SDL.h>
@@ -39,6 +44,8 @@
 #include "support.h"
 #include "mem.h"
 #include "mixer.h"
+#include "audio_frame.h"
+#include "rwqueue.h"
 
 #include "decoders/SDL_sound.h"
 #include "sdlcd/SDL_cdrom.h"
@@ -118,6 +125,12 @@ public:
 	virtual bool LoadUnloadMedia    (bool unload) = 0;
 	virtual void InitNewMedia       () {}
 
+	// Advisory hint that the guest is streaming sequentially and will
+	// likely request the given sectors next; implementations may stage
+	// them ahead of time. Must never block.
+	virtual void ReadAheadHost([[maybe_unused]] unsigned long sector,
+	                           [[maybe_unused]] unsigned long num) {}
+
 protected:
 	void LagDriveResponse() const;
 };
@@ -247,6 +260,10 @@ private:
 		virtual ~TrackFile()                              = default;
 		virtual bool read(uint8_t* buffer, const uint32_t offset,
 		                  const uint32_t requested_bytes) = 0;
+		// Advisory; stage the byte range for upcoming read() calls
+		virtual void read_ahead([[maybe_unused]] const uint32_t offset,
+		                        [[maybe_unused]] const uint32_t requested_bytes)
+		{}
 		virtual bool seek(const uint32_t offset)          = 0;
 		virtual uint32_t decode(int16_t* buffer,
 		                        const uint32_t desired_track_frames) = 0;
@@ -270,6 +287,8 @@ private:
 
 		bool read(uint8_t* buffer, const uint32_t offset,
 		          const uint32_t requested_bytes) override;
+		void read_ahead(const uint32_t offset,
+		                const uint32_t requested_bytes) override;
 		bool seek(const uint32_t offset) override;
 		uint32_t decode(int16_t* buffer,
 		                const uint32_t desired_track_frames) override;
@@ -290,6 +309,14 @@ private:
 
 	private:
 		std::ifstream* file;
+
+		// Shared read-only memory mapping of the image, when the
+		// platform provides one; multiple emulator instances mounting
+		// the same image then share a single page-cache copy and
+		// sector reads become plain memcpys. When unavailable (or if
+		// mapping fails), reads fall back to the ifstream.
+		const uint8_t* mapped_view = nullptr;
+		size_t mapped_size         = 0;
 	};
 
 	class AudioFile final : public TrackFile {
@@ -316,6 +343,29 @@ private:
 		void setAudioPosition([[maybe_unused]] uint32_t pos) override {}
 
 	private:
+		// Games loop CDDA tracks by re-seeking the same start position
+		// every couple of minutes, and for the compressed codecs that
+		// seek re-walks the stream, which is audible as a playback gap.
+		// We record the first half-second of PCM decoded after a seek;
+		// when the same position is seeked again, playback resumes
+		// instantly from the recording while the codec seek is deferred
+		// to the moment the recording runs out (on the mixer thread,
+		// off the emulation thread).
+		static constexpr uint32_t loop_cache_ms = 500;
+
+		uint32_t loopCacheFrames();
+		bool serveFromLoopCache(int16_t*& buffer,
+		                        uint32_t& desired_track_frames,
+		                        uint32_t& frames_decoded);
+		bool resolveDeferredSeek();
+
+		std::vector<int16_t> loop_cache = {};
+		uint32_t loop_cache_pos    = std::numeric_limits<uint32_t>::max();
+		uint32_t loop_cache_ms_pos = 0;
+		uint32_t loop_cache_served = 0;
+		bool loop_cache_complete = false;
+		bool loop_cache_serving  = false;
+
 		Sound_Sample* sample = nullptr;
 	};
 
@@ -353,6 +403,7 @@ public:
 	                 const uint16_t num) override;
 	bool ReadSectorsHost(void* buffer, bool raw, unsigned long sector,
 	                     unsigned long num) override;
+	void ReadAheadHost(unsigned long sector, unsigned long num) override;
 	bool LoadUnloadMedia(bool unload) override;
 	bool ReadSector(uint8_t* buffer, const bool raw, const uint32_t sector);
 	bool HasDataTrack();
@@ -364,12 +415,28 @@ private:
 		std::weak_ptr<TrackFile> trackFile = {};
 		mixer_channel_t channel = nullptr;
 		CDROM_Interface_Image    *cd                = nullptr;
-		void (MixerChannel::*addFrames)(uint16_t, const int16_t *) = nullptr;
+		/**
+		 *  Decode-ahead state: a dedicated thread keeps the frame FIFO
+		 *  topped up so decoder stalls (cold page-cache reads, codec
+		 *  frame boundaries) never land inside the mixer tick, which
+		 *  runs while holding the audio-device lock. The decode thread
+		 *  only touches the track file and player state while holding
+		 *  the mutex; the FIFO itself is lock-free between the decode
+		 *  thread and the mixer callback.
+		 */
+		RWQueue<AudioFrame>      frameFifo{1};
+		std::thread              decodeThread = {};
+		std::mutex               decodeMutex = {};
+		std::condition_variable  decodeWake = {};
+		uint64_t                 decodeUnderruns = 0;
 		uint32_t                 playedTrackFrames  = 0;
 		uint32_t                 totalTrackFrames   = 0;
 		uint32_t                 startSector        = 0;
 		uint32_t                 totalRedbookFrames = 0;
 		int16_t buffer[MixerBufferLength * REDBOOK_CHANNELS] = {0};
+		std::atomic<bool>        trackEnded = false;
+		bool                     decodeActive = false; // guarded by decodeMutex
+		bool                     decodeQuit   = false; // guarded by decodeMutex
 		bool                     isPlaying          = false;
 		bool                     isPaused           = false;
 	} player;
@@ -381,6 +448,7 @@ private:
 	                 const bool mode2);
 	std::vector<Track>::iterator GetTrack(const uint32_t sector);
 	void CDAudioCallBack(uint16_t desired_frames);
+	static void CDAudioDecodeLoop();
 
 	// Private functions for cue sheet processing
 	bool  LoadCueSheet(char *cuefile);
@@ -430,6 +498,45 @@ private:
 	bool IsOpen() const;
 	bool Open(const char* device_name);
 
+	// Background sector-run read-ahead mirroring the disk image
+	// read-ahead ('disk_read_ahead_sectors' setting, 0 disables it).
+	// Once data access turns sequential, the next run of sectors is
+	// read by a worker thread through the request/completion queues and
+	// promoted into sector_cache, which is consulted before issuing a
+	// synchronous ioctl on the emulation thread. Media changes bump
+	// media_generation, which invalidates every prefetch still in
+	// flight.
+	struct PrefetchRequest {
+		uint32_t sector = 0;
+		uint16_t num    = 0;
+		bool raw        = false;
+	};
+	struct PrefetchedRun {
+		uint32_t sector           = 0;
+		bool raw                  = false;
+		uint64_t generation       = 0;
+		std::vector<uint8_t> data = {};
+	};
+	bool ReadSectorRun(uint8_t* buf, const bool raw, const uint32_t sector,
+	                   const uint16_t num);
+	void DrainPrefetchCompletions();
+	void ScheduleReadAhead(const uint32_t sector, const uint16_t num,
+	                       const bool raw);
+	void PrefetchWorkerLoop();
+	void InvalidateReadAhead();
+	void StartReadAhead();
+	void StopReadAhead();
+
+	int read_ahead_sectors                 = 0;
+	uint32_t next_sequential_sector        = 0;
+	uint32_t last_scheduled_sector         = 0;
+	std::atomic<uint64_t> media_generation = {0};
+	std::map<uint64_t, std::vector<uint8_t>> sector_cache = {};
+	RWQueue<PrefetchRequest> prefetch_requests{16};
+	RWQueue<PrefetchedRun> prefetch_completions{16};
+	std::thread prefetch_worker = {};
+	std::mutex device_mutex     = {};
+
 	int cdrom_fd                          = -1;
 	mixer_channel_t mixer_channel         = nullptr;
 	std::vector<int16_t> input_buffer     = {};
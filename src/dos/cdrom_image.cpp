@@ -23,11 +23,14 @@
 
 #include "cdrom.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cctype>
 #include <chrono>
+#include <cinttypes>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -41,7 +44,15 @@
 #include <cstring>
 #endif
 
+#ifdef HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "channel_names.h"
+#include "control.h"
 #include "drives.h"
 #include "fs_utils.h"
 #include "math_utils.h"
@@ -54,6 +65,11 @@ using namespace std;
 #define MAX_LINE_LENGTH 512
 #define MAX_FILENAME_LENGTH 256
 
+// Number of PCM frames the decode-ahead thread pulls per decode call (~12 ms
+// at Redbook rate); small enough that playback control never has to wait long
+// on an in-flight decode.
+#define CDDA_DECODE_BATCH_FRAMES 512u
+
 // STL type shorteners, local to this file
 using track_iter       = vector<CDROM_Interface_Image::Track>::iterator;
 using track_const_iter = vector<CDROM_Interface_Image::Track>::const_iterator;
@@ -106,10 +122,46 @@ CDROM_Interface_Image::BinaryFile::BinaryFile(const char *filename, bool &error)
 	file = new ifstream(filename, ios::in | ios::binary);
 	// If new fails, an exception is generated and scope leaves this constructor
 	error = file->fail();
+
+#ifdef HAVE_MMAP
+	// Try to service reads from a shared read-only mapping: all
+	// instances mounting the same image then share one page-cache copy
+	// and sector reads become plain memcpys. The ifstream remains the
+	// fallback if the image can't be mapped.
+	if (!error) {
+		const int fd = open(filename, O_RDONLY);
+		if (fd >= 0) {
+			struct stat file_info = {};
+			if (fstat(fd, &file_info) == 0 && file_info.st_size > 0) {
+				const auto view = mmap(nullptr,
+				                       static_cast<size_t>(file_info.st_size),
+				                       PROT_READ,
+				                       MAP_SHARED,
+				                       fd,
+				                       0);
+				if (view != MAP_FAILED) {
+					mapped_view = static_cast<const uint8_t*>(view);
+					mapped_size = static_cast<size_t>(
+					        file_info.st_size);
+				}
+			}
+			// the mapping stays valid after closing the descriptor
+			close(fd);
+		}
+	}
+#endif
 }
 
 CDROM_Interface_Image::BinaryFile::~BinaryFile()
 {
+#ifdef HAVE_MMAP
+	if (mapped_view) {
+		munmap(const_cast<uint8_t*>(mapped_view), mapped_size);
+		mapped_view = nullptr;
+		mapped_size = 0;
+	}
+#endif
+
 	// Guard: only cleanup if needed
 	if (file == nullptr)
 		return;
@@ -131,6 +183,14 @@ bool CDROM_Interface_Image::BinaryFile::read(uint8_t *buffer,
 	if (adjusted_bytes == 0) // no work to do!
 		return true;
 
+	if (mapped_view) {
+		if (!offsetInsideTrack(offset) ||
+		    offset + adjusted_bytes > mapped_size)
+			return false;
+		memcpy(buffer, mapped_view + offset, adjusted_bytes);
+		return true;
+	}
+
 	// Reposition if needed
 	if (!seek(offset))
 		return false;
@@ -139,9 +199,42 @@ bool CDROM_Interface_Image::BinaryFile::read(uint8_t *buffer,
 	return !file->fail();
 }
 
+void CDROM_Interface_Image::BinaryFile::read_ahead(
+        [[maybe_unused]] const uint32_t offset,
+        [[maybe_unused]] const uint32_t requested_bytes)
+{
+#ifdef HAVE_MMAP
+	// Ask the kernel to stage the upcoming range of the mapping into the
+	// page cache asynchronously, so the memcpys in read() don't fault on
+	// cold pages when the image sits on slow or networked storage. The
+	// page cache is the sector cache here, and the kernel evicts it
+	// under its usual policy; without a mapping there is nothing cheap
+	// to stage, so the hint is ignored.
+	if (!mapped_view)
+		return;
+
+	const uint32_t adjusted_bytes = adjustOverRead(offset, requested_bytes);
+	if (adjusted_bytes == 0 || offset + adjusted_bytes > mapped_size)
+		return;
+
+	const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+	const auto start = reinterpret_cast<uintptr_t>(mapped_view + offset) &
+	                   ~(page_size - 1);
+	const auto end = reinterpret_cast<uintptr_t>(mapped_view + offset +
+	                                             adjusted_bytes);
+	madvise(reinterpret_cast<void*>(start), end - start, MADV_WILLNEED);
+#endif
+}
+
 int CDROM_Interface_Image::BinaryFile::getLength()
 {
 	// Return our cached result if we've already been asked before
+	if (length_redbook_bytes < 0 && mapped_view) {
+		length_redbook_bytes = static_cast<int>(mapped_size);
+
+		assertm(static_cast<uint32_t>(length_redbook_bytes) <= MAX_REDBOOK_BYTES,
+		        "Track length exceeds the maximum CDROM size");
+	}
 	if (length_redbook_bytes < 0 && file) {
 		file->seekg(0, ios::end);
 		/**
@@ -177,6 +270,10 @@ bool CDROM_Interface_Image::BinaryFile::seek(const uint32_t offset)
 	if (!offsetInsideTrack(offset))
 		return false;
 
+	// A mapped image has no file position; reads index the view directly
+	if (mapped_view)
+		return offset <= mapped_size;
+
 	if (static_cast<uint32_t>(file->tellg()) == offset)
 		return true;
 
@@ -201,18 +298,31 @@ uint32_t CDROM_Interface_Image::BinaryFile::decode(int16_t *buffer,
 	assertm(audio_pos < MAX_REDBOOK_BYTES,
 	        "Tried to decode audio before the playback position was set");
 
-	// Reposition against our last audio position if needed
-	if (static_cast<uint32_t>(file->tellg()) != audio_pos)
+	uint32_t bytes_read = 0;
+	if (mapped_view) {
 		if (!seek(audio_pos))
 			return 0;
+		const auto bytes_remaining = mapped_size - audio_pos;
+		bytes_read = static_cast<uint32_t>(
+		        std::min<size_t>(desired_track_frames * BYTES_PER_REDBOOK_PCM_FRAME,
+		                         bytes_remaining));
+		memcpy(buffer, mapped_view + audio_pos, bytes_read);
+	} else {
+		// Reposition against our last audio position if needed
+		if (static_cast<uint32_t>(file->tellg()) != audio_pos)
+			if (!seek(audio_pos))
+				return 0;
 
-	file->read((char*)buffer, desired_track_frames * BYTES_PER_REDBOOK_PCM_FRAME);
-	/**
-	 *  Note: gcount returns a signed type, but according to specification:
-	 *  "Except in the constructors of std::strstreambuf, negative values of
-	 *  std::streamsize are never used."; so we store it as unsigned.
-	 */
-	const uint32_t bytes_read = static_cast<uint32_t>(file->gcount());
+		file->read((char*)buffer,
+		           desired_track_frames * BYTES_PER_REDBOOK_PCM_FRAME);
+		/**
+		 *  Note: gcount returns a signed type, but according to
+		 *  specification: "Except in the constructors of
+		 *  std::strstreambuf, negative values of std::streamsize are
+		 *  never used."; so we store it as unsigned.
+		 */
+		bytes_read = static_cast<uint32_t>(file->gcount());
+	}
 
 	// decoding is an audio-task, so update our audio position
 	audio_pos += bytes_read;
@@ -292,10 +402,33 @@ bool CDROM_Interface_Image::AudioFile::seek(const uint32_t requested_pos)
 	clock::time_point begin = clock::now(); // start the timer
 #endif
 
+	// Loop restart: the game is re-seeking a position we've already
+	// recorded PCM for, so resume playback from the recording and defer
+	// the (expensive, codec-dependent) seek until the recording runs out
+	if (requested_pos == loop_cache_pos && loop_cache_complete) {
+		loop_cache_serving = true;
+		loop_cache_served  = 0;
+		audio_pos = requested_pos;
+#ifdef DEBUG
+		LOG_MSG("CDROM: seek to %u served from the loop cache", requested_pos);
+#endif
+		return true;
+	}
+
 	// Perform the seek and update our position
 	const bool result = Sound_Seek(sample, pos_in_ms);
 	audio_pos = result ? requested_pos : std::numeric_limits<uint32_t>::max();
 
+	// Start recording the PCM that follows this position, so the next
+	// seek back to it can resume instantly
+	if (result) {
+		loop_cache.clear();
+		loop_cache_pos      = requested_pos;
+		loop_cache_ms_pos   = pos_in_ms;
+		loop_cache_complete = false;
+		loop_cache_serving  = false;
+	}
+
 #ifdef DEBUG
 	clock::time_point end = clock::now(); // stop the timer
 	const int32_t elapsed_ms = static_cast<int32_t>
@@ -353,6 +486,11 @@ bool CDROM_Interface_Image::AudioFile::read(uint8_t *buffer,
 	if (!seek(requested_pos))
 		return false;
 
+	// DAE decodes straight from the codec, so a seek deferred by the
+	// loop cache has to land before we read
+	if (!resolveDeferredSeek())
+		return false;
+
 	const uint32_t adjusted_bytes = adjustOverRead(requested_pos, requested_bytes);
 	if (adjusted_bytes == 0) // no work to do!
 		return true;
@@ -428,15 +566,89 @@ bool CDROM_Interface_Image::AudioFile::read(uint8_t *buffer,
 	return !(sample->flags & SOUND_SAMPLEFLAG_ERROR);
 }
 
+uint32_t CDROM_Interface_Image::AudioFile::loopCacheFrames()
+{
+	return check_cast<uint32_t>(static_cast<uint64_t>(getRate()) *
+	                            loop_cache_ms / 1000);
+}
+
+// Copy recorded PCM into the caller's buffer, advancing the buffer pointer
+// and remaining-frame count. When the recording runs out mid-call, the
+// deferred codec seek is performed so decoding continues seamlessly after
+// it; returns false only if that seek failed.
+bool CDROM_Interface_Image::AudioFile::serveFromLoopCache(int16_t*& buffer,
+                                                          uint32_t& desired_track_frames,
+                                                          uint32_t& frames_decoded)
+{
+	const uint32_t channels = getChannels();
+	const uint32_t cached   = loopCacheFrames();
+	const uint32_t frames = std::min(desired_track_frames,
+	                                 cached - loop_cache_served);
+
+	memcpy(buffer, loop_cache.data() + loop_cache_served * channels,
+	       frames * channels * sizeof(int16_t));
+	buffer += frames * channels;
+	loop_cache_served += frames;
+	desired_track_frames -= frames;
+	frames_decoded += frames;
+
+	if (loop_cache_served < cached)
+		return true;
+	return resolveDeferredSeek();
+}
+
+bool CDROM_Interface_Image::AudioFile::resolveDeferredSeek()
+{
+	if (!loop_cache_serving)
+		return true;
+	loop_cache_serving = false;
+
+	// Land the codec right past the served part of the recording
+	const uint32_t served_ms = check_cast<uint32_t>(
+	        static_cast<uint64_t>(loop_cache_served) * 1000 / getRate());
+	if (Sound_Seek(sample, loop_cache_ms_pos + served_ms))
+		return true;
+
+	LOG_WARNING("CDROM: deferred seek to %u ms after a loop restart failed",
+	            loop_cache_ms_pos + served_ms);
+	audio_pos = std::numeric_limits<uint32_t>::max();
+	return false;
+}
+
 uint32_t CDROM_Interface_Image::AudioFile::decode(int16_t *buffer,
                                                   const uint32_t desired_track_frames)
 {
 	assertm(audio_pos < MAX_REDBOOK_BYTES,
 	        "Tried to decode audio before the playback position was set");
 
-	// Sound_Decode_Direct returns frames (agnostic of bitrate and channels)
-	const uint32_t frames_decoded =
-	    Sound_Decode_Direct(sample, (void*)buffer, desired_track_frames);
+	uint32_t frames_decoded = 0;
+	uint32_t frames_wanted  = desired_track_frames;
+	int16_t* out = buffer;
+
+	// Resume a loop restart from the recorded PCM first
+	if (loop_cache_serving &&
+	    !serveFromLoopCache(out, frames_wanted, frames_decoded))
+		frames_wanted = 0; // deferred seek failed; end the stream
+
+	if (frames_wanted > 0) {
+		// Sound_Decode_Direct returns frames (agnostic of bitrate and
+		// channels)
+		const uint32_t decoded = Sound_Decode_Direct(sample, (void*)out,
+		                                             frames_wanted);
+
+		// Keep recording until we hold a full recording's worth of
+		// contiguous post-seek PCM
+		if (!loop_cache_complete && !loop_cache_serving && decoded &&
+		    loop_cache_pos != std::numeric_limits<uint32_t>::max()) {
+			const uint32_t channels = getChannels();
+			const uint32_t want = loopCacheFrames() * channels;
+			const auto have = static_cast<uint32_t>(loop_cache.size());
+			const uint32_t take = std::min(want - have, decoded * channels);
+			loop_cache.insert(loop_cache.end(), out, out + take);
+			loop_cache_complete = (loop_cache.size() >= want);
+		}
+		frames_decoded += decoded;
+	}
 
 	// decoding is an audio-task, so update our audio position
 	// in terms of Redbook-equivalent bytes
@@ -503,6 +715,24 @@ CDROM_Interface_Image::CDROM_Interface_Image(uint8_t sub_unit)
 			                                   ChannelFeature::DigitalAudio});
 
 			player.channel->Enable(false); // only enabled during playback periods
+
+			/**
+			 *  Size the decode-ahead FIFO from the configured
+			 *  depth, assuming Redbook-rate tracks; lower-rate
+			 *  tracks simply buffer proportionally more
+			 *  milliseconds.
+			 */
+			const auto section = static_cast<Section_prop *>(
+			        control->GetSection("dos"));
+			const auto buffer_ms = section ? section->Get_int("cdda_buffer_ms")
+			                               : 150;
+			player.frameFifo.Resize(REDBOOK_PCM_FRAMES_PER_SECOND *
+			                        check_cast<uint32_t>(buffer_ms) / 1000);
+
+			player.decodeQuit = false;
+			player.decodeThread = std::thread(
+			        &CDROM_Interface_Image::CDAudioDecodeLoop);
+			set_thread_name(player.decodeThread, "dosbox:cdda");
 		}
 #ifdef DEBUG
 		LOG_MSG("CDROM: Initialised the %s audio channel", ChannelName::CdAudio);
@@ -522,6 +752,20 @@ CDROM_Interface_Image::~CDROM_Interface_Image()
 		if (player.cd) {
 			StopAudio();
 		}
+		if (player.decodeThread.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(player.decodeMutex);
+				player.decodeQuit = true;
+			}
+			player.decodeWake.notify_all();
+			player.decodeThread.join();
+		}
+		if (player.decodeUnderruns > 0) {
+			LOG_WARNING("CDROM: CD-DA decode-ahead buffer underran %" PRIu64
+			            " times; consider raising 'cdda_buffer_ms'",
+			            player.decodeUnderruns);
+			player.decodeUnderruns = 0;
+		}
 		MIXER_DeregisterChannel(player.channel);
 		player.channel.reset();
 	}
@@ -733,10 +977,26 @@ bool CDROM_Interface_Image::PlayAudioSector(uint32_t start, uint32_t len)
 	const auto sector_offset = start - track->start;
 	const auto byte_offset = track->skip + sector_offset * track->sectorSize;
 
+	/**
+	 *  Synchronize with the decode-ahead thread before repositioning the
+	 *  track: the thread only touches the track file and the frame FIFO
+	 *  while holding this mutex, so once we have it we can safely seek
+	 *  and discard frames decoded for the previous playback position.
+	 */
+	std::unique_lock<std::mutex> lock(player.decodeMutex);
+	player.decodeActive = false;
+	player.trackEnded = false;
+
+	// Discard frames decoded for the previous playback position
+	while (!player.frameFifo.IsEmpty()) {
+		player.frameFifo.Dequeue();
+	}
+
 	// Guard: Bail if our track could not be seeked
 	if (!track_file->seek(byte_offset)) {
 		LOG_MSG("CDROM: Track %d failed to seek to byte %u, so cancelling playback",
 		        track->number, byte_offset);
+		lock.unlock();
 		StopAudio();
 		return false;
 	}
@@ -745,7 +1005,6 @@ bool CDROM_Interface_Image::PlayAudioSector(uint32_t start, uint32_t len)
 	track_file->setAudioPosition(byte_offset);
 
 	// Get properties about the current track
-	const uint8_t track_channels = track_file->getChannels();
 	const uint32_t track_rate = track_file->getRate();
 
 	// Update our player with properties about this playback sequence
@@ -756,15 +1015,6 @@ bool CDROM_Interface_Image::PlayAudioSector(uint32_t start, uint32_t len)
 	player.isPlaying = true;
 	player.isPaused = false;
 
-	// Assign the mixer function associated with this track's content type
-	if (track_file->getEndian() == AUDIO_S16SYS) {
-		player.addFrames = track_channels ==  2  ? &MixerChannel::AddSamples_s16 \
-		                                         : &MixerChannel::AddSamples_m16;
-	} else {
-		player.addFrames = track_channels ==  2  ? &MixerChannel::AddSamples_s16_nonnative \
-		                                         : &MixerChannel::AddSamples_m16_nonnative;
-	}
-
 	/**
 	 *  Convert Redbook frames (len) to Track PCM frames, rounding up to whole
 	 *  integer frames. Note: the intermediate numerator in the calculation
@@ -800,6 +1050,16 @@ bool CDROM_Interface_Image::PlayAudioSector(uint32_t start, uint32_t len)
 	}
 #endif
 
+	// Wake the decode-ahead thread, then wait for it to prime the FIFO
+	// (or to immediately hit the end of the track), so playback starts on
+	// the very next mixer tick just as the synchronous path did.
+	player.decodeActive = true;
+	player.decodeWake.notify_all();
+	player.decodeWake.wait(lock, [] {
+		return !player.decodeActive || !player.frameFifo.IsEmpty();
+	});
+	lock.unlock();
+
 	// start the channel!
 	player.channel->SetSampleRate(track_rate);
 	player.channel->Enable(true);
@@ -821,6 +1081,12 @@ bool CDROM_Interface_Image::PauseAudio(bool resume)
 
 bool CDROM_Interface_Image::StopAudio(void)
 {
+	// Put the decode-ahead thread back to sleep; any frames left in the
+	// FIFO are discarded by the next PlayAudioSector
+	{
+		std::lock_guard<std::mutex> lock(player.decodeMutex);
+		player.decodeActive = false;
+	}
 	player.isPlaying = false;
 	player.isPaused = false;
 	if (player.channel) {
@@ -1000,34 +1266,126 @@ bool CDROM_Interface_Image::ReadSectorsHost(void *buffer, bool raw, unsigned lon
 	return success;
 }
 
+void CDROM_Interface_Image::ReadAheadHost(unsigned long sector, unsigned long num)
+{
+	// Quietly ignore hints beyond the playable range; GetTrack would log
+	if (num == 0 || sector > MAX_REDBOOK_SECTOR ||
+	    tracks.size() < MIN_REDBOOK_TRACKS || sector >= tracks.back().start)
+		return;
+
+	track_const_iter track = GetTrack(static_cast<uint32_t>(sector));
+	if (track == tracks.end() || track->file == nullptr ||
+	    sector < track->start || sector >= track->start + track->length)
+		return;
+
+	// Only stage up to the end of the track the run is inside of
+	num = std::min(num, static_cast<unsigned long>(
+	                            track->start + track->length - sector));
+
+	const uint32_t offset = track->skip +
+	                        (static_cast<uint32_t>(sector) - track->start) *
+	                                track->sectorSize;
+	track->file->read_ahead(offset,
+	                        static_cast<uint32_t>(num) * track->sectorSize);
+}
+
+void CDROM_Interface_Image::CDAudioDecodeLoop()
+{
+	// Scratch for converting the decoded PCM into stereo mixer frames;
+	// reused across batches to avoid repeated reallocation
+	std::vector<AudioFrame> frames = {};
+
+	std::unique_lock<std::mutex> lock(player.decodeMutex);
+	while (!player.decodeQuit) {
+		player.decodeWake.wait(lock, [] {
+			return player.decodeQuit ||
+			       (player.decodeActive &&
+			        player.frameFifo.Size() + CDDA_DECODE_BATCH_FRAMES <=
+			                player.frameFifo.MaxCapacity());
+		});
+		if (player.decodeQuit) {
+			break;
+		}
+		std::shared_ptr<TrackFile> track_file = player.trackFile.lock();
+		if (!track_file) {
+			// The image was pulled out from underneath us; flag the
+			// track as ended so the mixer callback stops playback
+			player.decodeActive = false;
+			player.trackEnded = true;
+			player.decodeWake.notify_all();
+			continue;
+		}
+		const auto decoded = track_file->decode(player.buffer,
+		                                        CDDA_DECODE_BATCH_FRAMES);
+		if (decoded == 0) {
+			player.decodeActive = false;
+			player.trackEnded = true;
+			player.decodeWake.notify_all();
+			continue;
+		}
+
+		// Expand the track's PCM into host-order stereo frames
+		const bool is_stereo = (track_file->getChannels() == 2);
+		const bool is_native = (track_file->getEndian() == AUDIO_S16SYS);
+		auto host_sample = [is_native](const int16_t sample) -> int16_t {
+			if (is_native) {
+				return sample;
+			}
+			const auto swapped = static_cast<uint16_t>(sample);
+			return static_cast<int16_t>((swapped << 8) | (swapped >> 8));
+		};
+		frames.resize(decoded);
+		for (uint32_t i = 0; i < decoded; ++i) {
+			const auto left = host_sample(
+			        player.buffer[is_stereo ? i * 2 : i]);
+			const auto right = is_stereo
+			                         ? host_sample(player.buffer[i * 2 + 1])
+			                         : left;
+			frames[i] = {left, right};
+		}
+
+		// The predicate above guaranteed room for the whole batch and
+		// the mixer callback only frees up more, so this never blocks
+		const bool was_empty = player.frameFifo.IsEmpty();
+		player.frameFifo.BulkEnqueue(frames, decoded);
+		if (was_empty) {
+			// PlayAudioSector may be waiting on the first frames
+			player.decodeWake.notify_all();
+		}
+	}
+}
+
 void CDROM_Interface_Image::CDAudioCallBack(uint16_t desired_track_frames)
 {
 	/**
-	 *  This callback runs in SDL's mixer thread, so there's a risk
-	 *  our track_file pointer could be removed by the main thread.
-	 *  We reserve the track_file up-front for the scope of this call.
+	 *  The decode-ahead thread keeps the frame FIFO topped up; this
+	 *  callback only moves ready frames into the mixer, so decoder
+	 *  stalls can never hold up the mixer tick under the audio-device
+	 *  lock.
 	 */
-	std::shared_ptr<TrackFile> track_file = player.trackFile.lock();
 
 	// Guards: Bail if the request or our player is invalid
-	if (desired_track_frames == 0 || !player.cd || !track_file) {
+	if (desired_track_frames == 0 || !player.cd) {
 #ifdef DEBUG
 		LOG_MSG("CDROM: CDAudioCallBack called with one more empty dependencies:\n"
 		        "\t - frames to play (%" PRIuPTR ")\n"
-		        "\t - pointer to the CD object (%p)\n"
-		        "\t - pointer to the track's file (%p)\n",
-		        desired_track_frames, static_cast<void *>(player.cd),
-		        static_cast<void *>(track_file.get()));
+		        "\t - pointer to the CD object (%p)\n",
+		        desired_track_frames, static_cast<void *>(player.cd));
 #endif
 		if (player.cd)
 			player.cd->StopAudio();
 		return;
 	}
 
-	const auto decoded_track_frames = check_cast<uint16_t>(
-	        track_file->decode(player.buffer, desired_track_frames));
-
-	if (!decoded_track_frames) {
+	const auto num_queued = player.frameFifo.Size();
+	if (num_queued == 0) {
+		if (!player.trackEnded) {
+			// The decoder couldn't keep up, so bridge the gap with
+			// silence instead of stalling on it
+			++player.decodeUnderruns;
+			player.channel->AddSilence();
+			return;
+		}
 		// This particular CDDA track has come to an end, but the
 		// program has requested we continue playing for a longer
 		// period. So keep going!
@@ -1050,11 +1408,18 @@ void CDROM_Interface_Image::CDAudioCallBack(uint16_t desired_track_frames)
 		return;
 	}
 
-	// Use the stereo or mono and native or nonnative AddSamples call
-	// assigned during construction
-	(player.channel.get()->*player.addFrames)(decoded_track_frames, player.buffer);
+	// We're the FIFO's only consumer, so the queued frames can only grow
+	// from here and this dequeue never blocks
+	static std::vector<AudioFrame> audio_frames = {};
+	const auto num_frames = check_cast<uint16_t>(
+	        std::min(num_queued, static_cast<size_t>(desired_track_frames)));
+	player.frameFifo.BulkDequeue(audio_frames, num_frames);
+	player.channel->AddSamples_sfloat(num_frames, &audio_frames[0][0]);
+
+	// Tell the decode-ahead thread there's room in the FIFO again
+	player.decodeWake.notify_one();
 
-	player.playedTrackFrames += decoded_track_frames;
+	player.playedTrackFrames += num_frames;
 	if (player.playedTrackFrames >= player.totalTrackFrames) {
 #ifdef DEBUG
 		LOG_MSG("CDROM: CDAudioCallBack stopping because "
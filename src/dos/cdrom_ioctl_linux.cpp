@@ -16,11 +16,14 @@
  *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include <algorithm>
 #include <assert.h>
 #include <string.h>
 
 #include "cdrom.h"
 #include "channel_names.h"
+#include "control.h"
+#include "setup.h"
 #include "support.h"
 
 #if defined(LINUX)
@@ -40,6 +43,7 @@ constexpr size_t InputBufferMaxSamples = InputBufferMaxRedbookFrames *
 
 CDROM_Interface_Ioctl::~CDROM_Interface_Ioctl()
 {
+	StopReadAhead();
 	if (mixer_channel) {
 		MIXER_DeregisterChannel(mixer_channel);
 	}
@@ -240,6 +244,10 @@ bool CDROM_Interface_Ioctl::GetMediaTrayStatus(bool& mediaPresent,
 	auto ret     = ioctl(cdrom_fd, CDROM_MEDIA_CHANGED, CDSL_CURRENT);
 	mediaChanged = (ret > 0) && (ret & 1);
 
+	if (mediaChanged) {
+		InvalidateReadAhead();
+	}
+
 #ifdef DEBUG_IOCTL
 	LOG_INFO("CDROM_IOCTL: GetMediaTrayStatus => media is %s, %s, and the tray is %s",
 	         mediaPresent ? "present" : "not present",
@@ -250,23 +258,20 @@ bool CDROM_Interface_Ioctl::GetMediaTrayStatus(bool& mediaPresent,
 	return true;
 }
 
-bool CDROM_Interface_Ioctl::ReadSectors(PhysPt buffer, const bool raw,
-                                        const uint32_t sector, const uint16_t num)
+// Reads a run of sectors synchronously; shared by the emulation thread and
+// the read-ahead worker, so the device access is serialized
+bool CDROM_Interface_Ioctl::ReadSectorRun(uint8_t* buf, const bool raw,
+                                          const uint32_t sector, const uint16_t num)
 {
-	if (!IsOpen()) {
-		return false;
-	}
-
 	const auto buflen = raw ? num * (unsigned int)CD_FRAMESIZE_RAW
 	                        : num * (unsigned int)CD_FRAMESIZE;
-	assert(buflen);
-	std::vector<uint8_t> buf(buflen, 0);
 	int ret = 0;
 
+	std::lock_guard<std::mutex> lock(device_mutex);
 	if (raw) {
 		struct cdrom_read cdrom_read;
 		cdrom_read.cdread_lba = (int)sector;
-		cdrom_read.cdread_bufaddr = reinterpret_cast<char *>(buf.data());
+		cdrom_read.cdread_bufaddr = reinterpret_cast<char *>(buf);
 		cdrom_read.cdread_buflen = (int)buflen;
 
 		ret = ioctl(cdrom_fd, CDROMREADRAW, &cdrom_read);
@@ -274,14 +279,168 @@ bool CDROM_Interface_Ioctl::ReadSectors(PhysPt buffer, const bool raw,
 		ret = lseek(cdrom_fd, (off_t)(sector * (unsigned long)CD_FRAMESIZE),
 		            SEEK_SET);
 		if (ret >= 0)
-			ret = read(cdrom_fd, buf.data(), buflen);
+			ret = read(cdrom_fd, buf, buflen);
 		if ((Bitu)ret != buflen)
 			ret = -1;
 	}
 
+	return (ret > 0);
+}
+
+bool CDROM_Interface_Ioctl::ReadSectors(PhysPt buffer, const bool raw,
+                                        const uint32_t sector, const uint16_t num)
+{
+	if (!IsOpen()) {
+		return false;
+	}
+
+	const auto sector_bytes = raw ? (unsigned int)CD_FRAMESIZE_RAW
+	                              : (unsigned int)CD_FRAMESIZE;
+	const auto buflen = num * sector_bytes;
+	assert(buflen);
+	std::vector<uint8_t> buf(buflen, 0);
+
+	// serve the request from prefetched sectors when every one is cached
+	bool success = false;
+	if (read_ahead_sectors > 0) {
+		DrainPrefetchCompletions();
+		success = true;
+		for (uint16_t i = 0; i < num && success; ++i) {
+			const auto key = (uint64_t(sector + i) << 1) |
+			                 (raw ? 1 : 0);
+			const auto it = sector_cache.find(key);
+			if (it != sector_cache.end()) {
+				memcpy(&buf[i * sector_bytes],
+				       it->second.data(),
+				       sector_bytes);
+			} else {
+				success = false;
+			}
+		}
+	}
+	if (!success) {
+		success = ReadSectorRun(buf.data(), raw, sector, num);
+	}
+	if (read_ahead_sectors > 0) {
+		ScheduleReadAhead(sector, num, raw);
+	}
+
 	MEM_BlockWrite(buffer, buf.data(), buflen);
 
-	return (ret > 0);
+	return success;
+}
+
+// Move finished prefetch runs into the sector cache, dropping any that a
+// media change has invalidated in the meantime
+void CDROM_Interface_Ioctl::DrainPrefetchCompletions()
+{
+	constexpr size_t max_cached_sectors = 128;
+
+	while (!prefetch_completions.IsEmpty()) {
+		auto run = prefetch_completions.Dequeue();
+		if (!run) {
+			break;
+		}
+		if (run->generation != media_generation.load()) {
+			continue; // stale: the media changed after the prefetch
+		}
+		const auto sector_bytes = run->raw ? (size_t)CD_FRAMESIZE_RAW
+		                                   : (size_t)CD_FRAMESIZE;
+		const auto num = run->data.size() / sector_bytes;
+		for (size_t i = 0; i < num; ++i) {
+			while (sector_cache.size() >= max_cached_sectors) {
+				sector_cache.erase(sector_cache.begin());
+			}
+			const auto key = (uint64_t(run->sector + i) << 1) |
+			                 (run->raw ? 1 : 0);
+			sector_cache[key].assign(
+			        run->data.begin() + i * sector_bytes,
+			        run->data.begin() + (i + 1) * sector_bytes);
+		}
+	}
+}
+
+// Detect sequential access and keep the worker topped up with the next run
+// of sectors
+void CDROM_Interface_Ioctl::ScheduleReadAhead(const uint32_t sector,
+                                              const uint16_t num, const bool raw)
+{
+	if (sector == next_sequential_sector) {
+		const auto first = std::max(last_scheduled_sector + 1,
+		                            sector + num);
+		const auto last = sector + num - 1 +
+		                  static_cast<uint32_t>(read_ahead_sectors);
+
+		if (first <= last && prefetch_requests.Size() <
+		                             prefetch_requests.MaxCapacity()) {
+			PrefetchRequest request = {};
+			request.sector = first;
+			request.num    = static_cast<uint16_t>(last - first + 1);
+			request.raw    = raw;
+			if (prefetch_requests.Enqueue(std::move(request))) {
+				last_scheduled_sector = last;
+			}
+		}
+	} else {
+		// random access: collapse the window back to this request
+		last_scheduled_sector = sector + num - 1;
+	}
+	next_sequential_sector = sector + num;
+}
+
+void CDROM_Interface_Ioctl::PrefetchWorkerLoop()
+{
+	while (auto request = prefetch_requests.Dequeue()) {
+		PrefetchedRun run = {};
+		run.sector        = request->sector;
+		run.raw           = request->raw;
+		run.generation    = media_generation.load();
+
+		const auto sector_bytes = request->raw ? (size_t)CD_FRAMESIZE_RAW
+		                                       : (size_t)CD_FRAMESIZE;
+		run.data.resize(request->num * sector_bytes);
+
+		if (!ReadSectorRun(run.data.data(), request->raw,
+		                   request->sector, request->num)) {
+			continue; // leave this run to the synchronous path
+		}
+		if (!prefetch_completions.Enqueue(std::move(run))) {
+			break; // the queue was stopped
+		}
+	}
+}
+
+// Drops every cached and in-flight prefetch; called whenever the medium
+// may no longer match what was read from it
+void CDROM_Interface_Ioctl::InvalidateReadAhead()
+{
+	++media_generation;
+	sector_cache.clear();
+	next_sequential_sector = 0;
+	last_scheduled_sector  = 0;
+}
+
+void CDROM_Interface_Ioctl::StartReadAhead()
+{
+	if (prefetch_worker.joinable()) {
+		return;
+	}
+	const auto section = static_cast<Section_prop*>(control->GetSection("dos"));
+	read_ahead_sectors = section ? section->Get_int("disk_read_ahead_sectors") : 0;
+	if (read_ahead_sectors > 0) {
+		prefetch_worker = std::thread(&CDROM_Interface_Ioctl::PrefetchWorkerLoop,
+		                              this);
+		set_thread_name(prefetch_worker, "dosbox:cdpre");
+	}
+}
+
+void CDROM_Interface_Ioctl::StopReadAhead()
+{
+	if (prefetch_worker.joinable()) {
+		prefetch_requests.Stop();
+		prefetch_completions.Stop();
+		prefetch_worker.join();
+	}
 }
 
 // Opens the given device name, replacing any currently opened device
@@ -295,6 +454,8 @@ bool CDROM_Interface_Ioctl::Open(const char* device_name)
 		close(cdrom_fd);
 	}
 	cdrom_fd = fd;
+	InvalidateReadAhead();
+	StartReadAhead();
 	return true;
 }
 
@@ -485,6 +646,7 @@ bool CDROM_Interface_Ioctl::LoadUnloadMedia(bool unload)
 	if (!IsOpen()) {
 		return false;
 	}
+	InvalidateReadAhead();
 	if (unload) {
 		return ioctl(cdrom_fd, CDROMEJECT) == 0;
 	} else {
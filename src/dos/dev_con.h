@@ -73,6 +73,24 @@ void device_CON::ClearAnsi()
 	ansi.numberofarg = 0;
 }
 
+// Returns true for bytes neither the CON device nor the teletype path
+// treat specially, i.e. characters that just get drawn and advance the
+// cursor - these can be written as a block
+static bool is_plain_con_output(const uint8_t chr)
+{
+	switch (chr) {
+	case 0x07: // bell
+	case 0x08: // backspace
+	case '\t':
+	case '\n':
+	case '\r':
+	case 0x1b: // escape
+		return false;
+	default:
+		return true;
+	}
+}
+
 bool device_CON::Read(uint8_t * data,uint16_t * size) {
 	uint16_t oldax=reg_ax;
 	uint16_t count=0;
@@ -165,6 +183,24 @@ bool device_CON::Write(uint8_t * data,uint16_t * size) {
 				count++;
 				continue;
 			} else {
+				/* Batch runs of plain characters into a block
+				   write with one cursor update. Bypassed when a
+				   program hooks INT 10h so TSRs still see every
+				   character, and when ANSI attributes or the
+				   scroll quirks of Output() are in play. */
+				if (dos.fast_console_output && !ansi.enabled &&
+				    !dos.internal_output &&
+				    CurMode->type == M_TEXT &&
+				    is_plain_con_output(data[count]) &&
+				    INT10_VectorIsDefault()) {
+					uint16_t run = 1;
+					while (count + run < *size &&
+					       is_plain_con_output(data[count + run]))
+						run++;
+					INT10_TeletypeOutputBlock(data + count, run, 7);
+					count += run;
+					continue;
+				}
 				Output(data[count]);
 				count++;
 				continue;
@@ -26,6 +26,7 @@
 #include <array>
 
 #include "bios.h"
+#include "bios_disk.h"
 #include "callback.h"
 #include "dos_locale.h"
 #include "drives.h"
@@ -346,8 +347,15 @@ static Bitu DOS_21Handler(void) {
 //TODO Find out the values for when reg_al!=0
 //TODO Hope this doesn't do anything special
 	case 0x0d:		/* Disk Reset */
-//Sure let's reset a virtual disk
-		break;	
+		// Programs call this to get pending writes onto the disk, so
+		// flush any write-back cached sectors of mounted images
+		for (const auto drive : Drives) {
+			const auto fat_drive = dynamic_cast<fatDrive*>(drive);
+			if (fat_drive && fat_drive->loadedDisk) {
+				fat_drive->loadedDisk->FlushWriteCache();
+			}
+		}
+		break;
 	case 0x0e:		/* Select Default Drive */
 		DOS_SetDefaultDrive(reg_dl);
 		reg_al=DOS_DRIVES;
@@ -1297,6 +1305,13 @@ static Bitu DOS_27Handler(void) {
 	return CBRET_NONE;
 }
 
+static Bitu DOS_28Handler(void) {
+	// DOS idle interrupt: by convention only raised from wait loops,
+	// and any TSR hooked ahead of us has already run by this point
+	CPU_NotifyIdleAdvisory();
+	return CBRET_NONE;
+}
+
 static uint16_t DOS_SectorAccess(const bool read)
 {
 	const auto drive = dynamic_cast<fatDrive*>(Drives.at(reg_al));
@@ -1466,7 +1481,7 @@ public:
 		callback[4].Install(DOS_27Handler,CB_IRET,"DOS Int 27");
 		callback[4].Set_RealVec(0x27);
 
-		callback[5].Install(nullptr,CB_IRET,"DOS Int 28");
+		callback[5].Install(DOS_28Handler,CB_IRET,"DOS Int 28");
 		callback[5].Set_RealVec(0x28);
 
 		callback[6].Install(nullptr,CB_INT29,"CON Output Int 29");
@@ -1494,6 +1509,9 @@ public:
 		dos.internal_output=false;
 
 		const Section_prop* section = static_cast<Section_prop*>(configuration);
+		dos.fast_console_output = section->Get_bool("fast_console_output");
+		dos.batch_file_cache    = section->Get_bool("batch_file_cache");
+
 		std::string args = section->Get_string("ver");
 		std::string word = strip_word(args);
 		const auto new_version = DOS_ParseVersion(word.c_str(), args.c_str());
@@ -1503,6 +1521,8 @@ public:
 		}
 	}
 	~DOS(){
+		DOS_LogFileOperationCounts();
+
 		// Clear the driver pointers. The actual objects are managed by
 		// the drive manager class.
 		Drives.fill(nullptr);
@@ -21,18 +21,63 @@
 
 #include <string.h>
 
+#include <string>
+#include <unordered_map>
+
 #include "dosbox.h"
 #include "callback.h"
 #include "regs.h"
 #include "mem.h"
 #include "bios.h"
 #include "dos_inc.h"
+#include "string_utils.h"
 #include "support.h"
 #include "drives.h"
 #include "dev_con.h"
 
 DOS_Device * Devices[DOS_DEVICES];
 
+// Index of device names to Devices[] slots so DOS_FindDevice doesn't have to
+// walk the table with wildcard compares on every INT 21h file operation. The
+// keys are stored uppercased, matching the names DOS_MakeName produces.
+static std::unordered_map<std::string, uint8_t> device_name_index = {};
+
+// Devices with wildcards in their name can't be looked up by exact name;
+// while any are registered the lookup falls back to the table walk.
+static int num_wildcard_devices = 0;
+
+static bool device_name_has_wildcards(const char* name)
+{
+	return strpbrk(name, "*?") != nullptr;
+}
+
+static std::string device_name_key(const char* name)
+{
+	std::string key = name;
+	upcase(key);
+	return key;
+}
+
+static void index_device(const uint8_t slot)
+{
+	const auto name = Devices[slot]->GetName();
+	if (device_name_has_wildcards(name)) {
+		++num_wildcard_devices;
+	} else {
+		device_name_index[device_name_key(name)] = slot;
+	}
+}
+
+static void unindex_device(const uint8_t slot)
+{
+	const auto name = Devices[slot]->GetName();
+	if (device_name_has_wildcards(name)) {
+		--num_wildcard_devices;
+	} else {
+		device_name_index.erase(device_name_key(name));
+	}
+}
+
 struct ExtDeviceData {
 	uint16_t attribute;
 	uint16_t segment;
@@ -405,6 +450,7 @@ uint8_t DOS_FindDevice(const char* name)
 					if (DOS_CheckExtDevice(name_part, false) != 0) {
 						return index;
 					} else {
+						unindex_device(check_cast<uint8_t>(index));
 						delete Devices[index];
 						Devices[index] = nullptr;
 						break;
@@ -426,6 +472,13 @@ uint8_t DOS_FindDevice(const char* name)
 	if (strcmp(name_part, "PRN") == 0)
 		name_part = lpt;
 
+	/* exact lookup; the table walk is only needed as long as devices
+	   with wildcards in their name are registered */
+	if (num_wildcard_devices == 0) {
+		const auto it = device_name_index.find(name_part);
+		return (it != device_name_index.end()) ? it->second : DOS_DEVICES;
+	}
+
 	/* loop through devices */
 	for(uint8_t index = 0;index < DOS_DEVICES;index++) {
 		if (Devices[index]) {
@@ -443,6 +496,7 @@ void DOS_AddDevice(DOS_Device * adddev) {
 		if(!Devices[i]){
 			Devices[i] = adddev;
 			Devices[i]->SetDeviceNumber(i);
+			index_device(check_cast<uint8_t>(i));
 			return;
 		}
 	}
@@ -454,6 +508,7 @@ void DOS_DelDevice(DOS_Device * dev) {
 // TODO:The file table is not checked to see the device is opened somewhere!
 	for (Bitu i = 0; i <DOS_DEVICES;i++) {
 		if (Devices[i] && !strcasecmp(Devices[i]->GetName(), dev->GetName())) {
+			unindex_device(check_cast<uint8_t>(i));
 			delete Devices[i];
 			Devices[i] = nullptr;
 			return;
@@ -581,4 +636,6 @@ void DOS_ShutDownDevices()
 		delete d;
 		d = nullptr;
 	}
+	device_name_index.clear();
+	num_wildcard_devices = 0;
 }
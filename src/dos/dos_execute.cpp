@@ -22,6 +22,8 @@
 #include <string.h>
 #include <ctype.h>
 
+#include <vector>
+
 #include "callback.h"
 #include "cpu.h"
 #include "debug.h"
@@ -66,6 +68,45 @@ struct EXE_Header {
 #define OVERLAY 3
 
 
+// Cache of EXE relocation tables, keyed by a hash of the raw header and
+// the file size. Batch workloads exec the same handful of utilities
+// thousands of times per session; a hit skips the relocation-table seek
+// and its per-entry reads through the DOS file layer. The header itself
+// has to be read anyway to form the content key, so only the fixup list
+// is worth keeping.
+struct ExeRelocCacheEntry {
+	uint64_t key = 0;
+	std::vector<RealPt> relocations = {};
+};
+static std::vector<ExeRelocCacheEntry> exe_reloc_cache = {};
+constexpr size_t max_exe_reloc_cache_entries = 16;
+
+// FNV-1a over the header bytes, mixed with the file size; all fourteen
+// header fields plus the size make an accidental match between two
+// different builds vanishingly unlikely
+static uint64_t hash_exe_identity(const EXE_Header &head, const uint32_t file_size)
+{
+	uint64_t hash = 0xcbf29ce484222325;
+	auto mix = [&hash](const uint8_t byte) {
+		hash ^= byte;
+		hash *= 0x100000001b3;
+	};
+	const auto *bytes = reinterpret_cast<const uint8_t *>(&head);
+	for (size_t i = 0; i < sizeof(head); ++i)
+		mix(bytes[i]);
+	for (int shift = 0; shift < 32; shift += 8)
+		mix(static_cast<uint8_t>(file_size >> shift));
+	return hash;
+}
+
+static const std::vector<RealPt> *find_cached_relocations(const uint64_t key)
+{
+	for (const auto &entry : exe_reloc_cache)
+		if (entry.key == key)
+			return &entry.relocations;
+	return nullptr;
+}
+
 extern void GFX_RefreshTitle(const bool is_paused = false);
 extern void GFX_SetTitle(const int32_t cycles, const bool is_paused = false);
 
@@ -245,7 +286,7 @@ bool DOS_Execute(char * name,PhysPt block_pt,uint8_t flags) {
 	EXE_Header head;Bitu i;
 	uint16_t fhandle;uint16_t len;uint32_t pos;
 	uint16_t pspseg,envseg,loadseg,memsize,readsize;
-	PhysPt loadaddress;RealPt relocpt;
+	PhysPt loadaddress;
 	Bitu headersize=0,imagesize=0;
 	DOS_ParamBlock block(block_pt);
 
@@ -378,14 +419,46 @@ bool DOS_Execute(char * name,PhysPt block_pt,uint8_t flags) {
 		uint16_t relocate;
 		if (flags==OVERLAY) relocate=block.overlay.relocation;
 		else relocate=loadseg;
-		pos=head.reloctable;DOS_SeekFile(fhandle,&pos,0);
-		for (i=0;i<head.relocations;i++) {
-			readsize=4;DOS_ReadFile(fhandle,(uint8_t *)&relocpt,&readsize);
-			relocpt=host_readd((HostPt)&relocpt);		//Endianize
+		pos=0;DOS_SeekFile(fhandle,&pos,DOS_SEEK_END);
+		const uint64_t exe_key = hash_exe_identity(head,pos);
+		const std::vector<RealPt>* relocations = find_cached_relocations(exe_key);
+		std::vector<RealPt> fresh_relocations = {};
+		if (!relocations) {
+			/* Fetch the relocation table in batches instead of one
+			   4-byte read per entry through the DOS file layer */
+			fresh_relocations.reserve(head.relocations);
+			pos=head.reloctable;DOS_SeekFile(fhandle,&pos,0);
+			constexpr uint16_t entries_per_batch=0x2000;
+			Bitu remaining=head.relocations;
+			while (remaining>0) {
+				const uint16_t batch=(remaining>entries_per_batch)?entries_per_batch:(uint16_t)remaining;
+				readsize=batch*4;DOS_ReadFile(fhandle,loadbuf,&readsize);
+				for (i=0;i<readsize/4u;i++)
+					fresh_relocations.push_back(host_readd((HostPt)(loadbuf+i*4)));
+				if (readsize<batch*4u) break;	// truncated table
+				remaining-=batch;
+			}
+			if (fresh_relocations.size()==head.relocations) {
+				if (exe_reloc_cache.size()>=max_exe_reloc_cache_entries)
+					exe_reloc_cache.erase(exe_reloc_cache.begin());
+				exe_reloc_cache.push_back({exe_key,fresh_relocations});
+			}
+			relocations=&fresh_relocations;
+		}
+		for (const RealPt relocpt : *relocations) {
 			PhysPt address=PhysicalMake(RealSegment(relocpt)+loadseg,RealOffset(relocpt));
 			mem_writew(address,mem_readw(address)+relocate);
 		}
 	}
+	if (flags==LOADNGO) {
+		/* Hand the first chunk of the image to the cycle profile store,
+		   which restores the converged auto cycles value from earlier
+		   sessions of the same executable */
+		pos=0;DOS_SeekFile(fhandle,&pos,DOS_SEEK_SET);
+		readsize=0xffff;
+		if (DOS_ReadFile(fhandle,loadbuf,&readsize))
+			CPU_CycleProfilesNotifyLaunch(loadbuf,readsize);
+	}
 	delete [] loadbuf;
 	DOS_CloseFile(fhandle);
 
@@ -22,6 +22,7 @@
 #include <array>
 #include <climits>
 #include <ctype.h>
+#include <cinttypes>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -46,6 +47,47 @@
 
 DOS_File* Files[DOS_FILES] = {};
 
+/* Lowest handle that could still be free; keeps the open and create paths
+   from scanning the whole table on every call when many handles are busy */
+static uint8_t first_free_handle = 0;
+
+static uint8_t get_free_file_handle()
+{
+	for (uint8_t i = first_free_handle; i < DOS_FILES; ++i) {
+		if (!Files[i]) {
+			first_free_handle = i;
+			return i;
+		}
+	}
+	first_free_handle = DOS_FILES;
+	return DOS_FILES;
+}
+
+// Per-class counters for the INT 21h file operations, reported on shutdown
+// so I/O-heavy guest workloads can be quantified
+static struct {
+	uint64_t opens   = 0;
+	uint64_t creates = 0;
+	uint64_t reads   = 0;
+	uint64_t writes  = 0;
+	uint64_t seeks   = 0;
+	uint64_t closes  = 0;
+} file_op_counts = {};
+
+void DOS_LogFileOperationCounts()
+{
+	if (file_op_counts.opens == 0 && file_op_counts.creates == 0) {
+		return;
+	}
+	LOG_MSG("DOS: Handled %" PRIu64 " opens, %" PRIu64 " creates, %" PRIu64
+	        " reads, %" PRIu64 " writes, %" PRIu64 " seeks and %" PRIu64
+	        " closes",
+	        file_op_counts.opens, file_op_counts.creates,
+	        file_op_counts.reads, file_op_counts.writes,
+	        file_op_counts.seeks, file_op_counts.closes);
+	file_op_counts = {};
+}
+
 // Merely pointers. The actual filesystem and raw image objects are managed by
 // the drive manager class.
 std::array<DOS_Drive*, DOS_DRIVES> Drives = {};
@@ -450,8 +492,26 @@ bool DOS_FindNext(void) {
 	return false;
 }
 
+void DOS_FindAllRemaining(std::vector<DOS_DTA::Result>& results)
+{
+	DOS_DTA dta(dos.dta());
+	const uint8_t i = dta.GetSearchDrive();
+	if (i >= DOS_DRIVES || !Drives[i]) {
+		/* Corrupt search. */
+		LOG(LOG_FILES,LOG_ERROR)("Corrupt search!!!!");
+		DOS_SetError(DOSERR_NO_MORE_FILES);
+		return;
+	}
+	do {
+		DOS_DTA::Result result = {};
+		dta.GetResult(result);
+		results.emplace_back(std::move(result));
+	} while (Drives[i]->FindNext(dta));
+}
+
 
 bool DOS_ReadFile(uint16_t entry,uint8_t * data,uint16_t * amount,bool fcb) {
+	++file_op_counts.reads;
 	uint32_t handle = fcb?entry:RealHandle(entry);
 	if (handle>=DOS_FILES) {
 		DOS_SetError(DOSERR_INVALID_HANDLE);
@@ -474,6 +534,7 @@ bool DOS_ReadFile(uint16_t entry,uint8_t * data,uint16_t * amount,bool fcb) {
 }
 
 bool DOS_WriteFile(uint16_t entry,uint8_t * data,uint16_t * amount,bool fcb) {
+	++file_op_counts.writes;
 	uint32_t handle = fcb?entry:RealHandle(entry);
 	if (handle>=DOS_FILES) {
 		DOS_SetError(DOSERR_INVALID_HANDLE);
@@ -496,6 +557,7 @@ bool DOS_WriteFile(uint16_t entry,uint8_t * data,uint16_t * amount,bool fcb) {
 }
 
 bool DOS_SeekFile(uint16_t entry,uint32_t * pos,uint32_t type,bool fcb) {
+	++file_op_counts.seeks;
 	uint32_t handle = fcb?entry:RealHandle(entry);
 	if (handle>=DOS_FILES) {
 		DOS_SetError(DOSERR_INVALID_HANDLE);
@@ -509,6 +571,7 @@ bool DOS_SeekFile(uint16_t entry,uint32_t * pos,uint32_t type,bool fcb) {
 }
 
 bool DOS_CloseFile(uint16_t entry, bool fcb, uint8_t * refcnt) {
+	++file_op_counts.closes;
 	uint32_t handle = fcb?entry:RealHandle(entry);
 	if (handle>=DOS_FILES) {
 		DOS_SetError(DOSERR_INVALID_HANDLE);
@@ -529,6 +592,8 @@ bool DOS_CloseFile(uint16_t entry, bool fcb, uint8_t * refcnt) {
 	if (refs<=0) {
 		delete Files[handle];
 		Files[handle]=nullptr;
+		if (handle < first_free_handle)
+			first_free_handle = static_cast<uint8_t>(handle);
 		refs=0;
 	}
 	if (refcnt!=nullptr) *refcnt=static_cast<uint8_t>(refs+1);
@@ -552,6 +617,8 @@ bool DOS_FlushFile(uint16_t entry) {
 bool DOS_CreateFile(const char* name, FatAttributeFlags attributes,
                     uint16_t* entry, bool fcb)
 {
+	++file_op_counts.creates;
+
 	// Creation of a device is the same as opening it
 	// Tc201 installer
 	if (DOS_FindDevice(name) != DOS_DEVICES)
@@ -566,13 +633,7 @@ bool DOS_CreateFile(const char* name, FatAttributeFlags attributes,
 		return false;
 
 	/* Check for a free file handle */
-	uint8_t handle = DOS_FILES;
-	for (uint8_t i = 0; i < DOS_FILES; ++i) {
-		if (!Files[i]) {
-			handle = i;
-			break;
-		}
-	}
+	const uint8_t handle = get_free_file_handle();
 	if (handle == DOS_FILES) {
 		DOS_SetError(DOSERR_TOO_MANY_OPEN_FILES);
 		return false;
@@ -605,6 +666,8 @@ bool DOS_CreateFile(const char* name, FatAttributeFlags attributes,
 
 bool DOS_OpenFile(const char* name, uint8_t flags, uint16_t* entry, bool fcb)
 {
+	++file_op_counts.opens;
+
 	/* First check for devices */
 	if (flags>2) LOG(LOG_FILES,LOG_ERROR)("Special file open command %X file %s",flags,name);
 	else LOG(LOG_FILES,LOG_NORMAL)("file open command %X file %s",flags,name);
@@ -628,13 +691,7 @@ bool DOS_OpenFile(const char* name, uint8_t flags, uint16_t* entry, bool fcb)
 		return false;
 
 	/* Check for a free file handle */
-	uint8_t handle = DOS_FILES;
-	for (uint8_t i = 0; i < DOS_FILES; ++i) {
-		if (!Files[i]) {
-			handle = i;
-			break;
-		}
-	}
+	const uint8_t handle = get_free_file_handle();
 	if (handle == DOS_FILES) {
 		DOS_SetError(DOSERR_TOO_MANY_OPEN_FILES);
 		return false;
@@ -1111,15 +1168,22 @@ static std::pair<std::string, std::string> DTAExtendName(const char *fullname)
 		return s;
 	};
 
-	// Split the string on the dot (if it has one)
-	auto v = split_with_empties(fullname, '.');
+	// Split the string on the dot (if it has one). This runs for every
+	// FCB find result, so scan in place instead of allocating a vector
+	// of chunks.
+	const std::string_view full = fullname;
+	const auto first_dot        = full.find('.');
 
-	// append placeholders until our vector has two chunks
-	while (v.size() < 2)
-		v.emplace_back("");
+	auto ext_part = std::string_view();
+	if (first_dot != std::string_view::npos) {
+		const auto ext_start = first_dot + 1;
+		const auto ext_end   = full.find('.', ext_start);
+		ext_part = full.substr(ext_start, ext_end - ext_start);
+	}
 
-	const auto name = truncate_or_pad(std::move(v[0]), DOS_MFNLENGTH);
-	const auto ext  = truncate_or_pad(std::move(v[1]), DOS_EXTLENGTH);
+	const auto name = truncate_or_pad(std::string(full.substr(0, first_dot)),
+	                                  DOS_MFNLENGTH);
+	const auto ext = truncate_or_pad(std::string(ext_part), DOS_EXTLENGTH);
 	return {name, ext};
 }
 
@@ -1573,6 +1637,7 @@ void DOS_SetupFiles()
 	/* Setup the File Handles */
 	for (uint8_t i = 0; i < DOS_FILES; ++i)
 		Files[i] = nullptr;
+	first_free_handle = 0;
 	/* Setup the Virtual Disk System */
 	for (uint8_t i = 0; i < DOS_DRIVES; ++i)
 		Drives[i] = nullptr;
@@ -21,8 +21,11 @@
 
 #include "dos_locale.h"
 
+#include <algorithm>
+#include <array>
 #include <cstring>
 #include <map>
+#include <string_view>
 #include <vector>
 
 #if defined(WIN32)
@@ -263,7 +266,35 @@ enum class Country : uint16_t {
 	// - Switzerland/Italian  42041
 };
 
-static const std::map<uint16_t, Country> CodeToCountryCorrectionMap = {
+// Compile-time sorted lookup tables; keeping them constexpr lets the data
+// live in the read-only binary segment (shared between processes by the OS)
+// instead of being rebuilt on the heap by every instance at startup.
+template <typename K, typename V, size_t N>
+static constexpr bool is_sorted_by_key(const std::array<std::pair<K, V>, N>& table)
+{
+	for (size_t i = 1; i < N; ++i) {
+		if (!(table[i - 1].first < table[i].first)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename K, typename V, size_t N>
+static const V* find_by_key(const std::array<std::pair<K, V>, N>& table, const K& key)
+{
+	const auto it = std::lower_bound(table.begin(), table.end(), key,
+	                                 [](const std::pair<K, V>& entry,
+	                                    const K& value) {
+		                                 return entry.first < value;
+	                                 });
+	if (it != table.end() && it->first == key) {
+		return &it->second;
+	}
+	return nullptr;
+}
+
+static constexpr std::array<std::pair<uint16_t, Country>, 3> CodeToCountryCorrectionTable = {{
         // Duplicates listed here are mentioned in Ralf Brown's Interrupt List
         // and confirmed by us using different COUNTRY.SYS versions:
 
@@ -272,7 +303,10 @@ static const std::map<uint16_t, Country> CodeToCountryCorrectionMap = {
         { 88,  Country::Taiwan   }, // also Paragon PTS DOS standard code
         { 384, Country::Croatia  }, // most likely a mistake in MS-DOS 6.22
 	// clang-format on
-};
+}};
+
+static_assert(is_sorted_by_key(CodeToCountryCorrectionTable),
+              "table must stay sorted for the binary search");
 
 // TODO: at least MS-DOS 6.22 and Windows ME unofficially support
 //       country code 711 - not sure what it represents:
@@ -2466,11 +2500,11 @@ constexpr size_t ReservedAreaSize        = 10;
 static Country correct_country(const Country country)
 {
 	// Correct country code to handle duplicates in DOS country numbers
-	if (CodeToCountryCorrectionMap.count(enum_val(country))) {
-		return CodeToCountryCorrectionMap.at(enum_val(country));
-	} else {
-		return country;
+	if (const auto corrected = find_by_key(CodeToCountryCorrectionTable,
+	                                       enum_val(country))) {
+		return *corrected;
 	}
+	return country;
 }
 
 static std::string get_country_name(const Country country)
@@ -2769,7 +2803,8 @@ uint16_t DOS_GetDefaultCountry()
 // Autodetection code
 // ***************************************************************************
 
-static const std::map<std::string, Country> LayoutToCountryMap = {
+// Sorted by layout name, for the binary search
+static constexpr std::array<std::pair<std::string_view, Country>, 120> LayoutToCountryTable = {{
         // clang-format off
 	// reference: https://gitlab.com/FreeDOS/base/keyb_lay/-/blob/master/DOC/KEYB/LAYOUTS/LAYOUTS.TXT
 	{ "ar462",  Country::Arabic             },
@@ -2789,9 +2824,9 @@ static const std::map<std::string, Country> LayoutToCountryMap = {
 	{ "ca",     Country::CanadaEnglish      }, // Standard
 	{ "ce",     Country::Russia             }, // Chechnya Standard
 	{ "ce443",  Country::Russia             }, // Chechnya Typewriter
-	{ "cg",     Country::Montenegro         },
 	{ "cf",     Country::CanadaFrench       }, // Standard
 	{ "cf445",  Country::CanadaFrench       }, // Dual-layer
+	{ "cg",     Country::Montenegro         },
 	{ "co",     Country::UnitedStates       }, // Colemak
 	{ "cz",     Country::Czechia            }, // QWERTY
 	{ "cz243",  Country::Czechia            }, // Standard
@@ -2837,8 +2872,8 @@ static const std::map<std::string, Country> LayoutToCountryMap = {
 	{ "lt456",  Country::Lithuania          }, // Dual-layout
 	{ "lv",     Country::Latvia             }, // Standard
 	{ "lv455",  Country::Latvia             }, // Dual-layout
-	{ "ml",     Country::Malta              }, // UK-based
 	{ "mk",     Country::NorthMacedonia     },
+	{ "ml",     Country::Malta              }, // UK-based
 	{ "mn",     Country::Mongolia           },
 	{ "mo",     Country::Mongolia           },
 	{ "mt",     Country::Malta              }, // UK-based
@@ -2852,9 +2887,9 @@ static const std::map<std::string, Country> LayoutToCountryMap = {
 	{ "pl214",  Country::Poland             }, // 102-key
 	{ "po",     Country::Portugal           },
 	{ "px",     Country::Portugal           }, // International
+	{ "rh",     Country::UnitedStates       }, // Right-Hand Dvorak
 	{ "ro",     Country::Romania            }, // Standard
 	{ "ro446",  Country::Romania            }, // QWERTY
-	{ "rh",     Country::UnitedStates       }, // Right-Hand Dvorak
 	{ "ru",     Country::Russia             }, // Standard
 	{ "ru443",  Country::Russia             }, // Typewriter
 	{ "rx",     Country::Russia             }, // Extended Standard
@@ -2881,10 +2916,10 @@ static const std::map<std::string, Country> LayoutToCountryMap = {
 	{ "uk",     Country::UnitedKingdom      }, // Standard
 	{ "uk168",  Country::UnitedKingdom      }, // Alternate
 	{ "ur",     Country::Ukraine            }, // 101-key
-	{ "ur465",  Country::Ukraine            }, // 101-key
 	{ "ur1996", Country::Ukraine            }, // 101-key
 	{ "ur2001", Country::Ukraine            }, // 102-key
 	{ "ur2007", Country::Ukraine            }, // 102-key
+	{ "ur465",  Country::Ukraine            }, // 101-key
 	{ "us",     Country::UnitedStates       }, // Standard
 	{ "ux",     Country::UnitedStates       }, // International
 	{ "uz",     Country::Uzbekistan         },
@@ -2893,18 +2928,25 @@ static const std::map<std::string, Country> LayoutToCountryMap = {
 	{ "yc450",  Country::Serbia             }, // No-deadkey
 	{ "yu",     Country::Yugoslavia         },
         // clang-format on
-};
+}};
 
-static const std::map<std::string, std::string> LanguageToLayoutExceptionMap = {
+static_assert(is_sorted_by_key(LayoutToCountryTable),
+              "table must stay sorted for the binary search");
+
+static constexpr std::array<std::pair<std::string_view, std::string_view>, 1> LanguageToLayoutExceptionTable = {{
         {"nl", "us"},
-};
+}};
+
+static_assert(is_sorted_by_key(LanguageToLayoutExceptionTable),
+              "table must stay sorted for the binary search");
 
 std::string DOS_CheckLanguageToLayoutException(const std::string& language_code)
 {
 	if (!language_code.empty()) {
-		const auto it = LanguageToLayoutExceptionMap.find(language_code);
-		if (it != LanguageToLayoutExceptionMap.end()) {
-			return it->second;
+		const std::string_view key = language_code;
+		if (const auto layout = find_by_key(LanguageToLayoutExceptionTable,
+		                                    key)) {
+			return std::string(*layout);
 		}
 	}
 	return language_code;
@@ -2912,9 +2954,9 @@ std::string DOS_CheckLanguageToLayoutException(const std::string& language_code)
 
 bool DOS_GetCountryFromLayout(const std::string& layout, uint16_t& country)
 {
-	const auto it = LayoutToCountryMap.find(layout);
-	if (it != LayoutToCountryMap.end()) {
-		country = enum_val(it->second);
+	const std::string_view key = layout;
+	if (const auto found = find_by_key(LayoutToCountryTable, key)) {
+		country = enum_val(*found);
 		return true;
 	}
 
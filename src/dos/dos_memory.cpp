@@ -22,7 +22,9 @@
 #include "mem.h"
 #include "support.h"
 
+#include <algorithm>
 #include <string_view>
+#include <vector>
 
 enum class McbFaultStrategy { Deny, Repair, Report, Allow };
 
@@ -95,6 +97,79 @@ static bool triage_block(DOS_MCB &mcb, const uint8_t repair_type)
 	return true;
 }
 
+// Free-block index shadowing the MCB chain
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// DOS_AllocateMemory used to walk every MCB per call; TSR-heavy setups and
+// EXEC (which allocates several blocks per load) spend measurable time in
+// that walk. The index mirrors just the free blocks of the chain in address
+// order, so a steady-state allocation only inspects a handful of entries.
+// The chain in guest memory remains the single source of truth: programs
+// are free to edit MCBs behind our back, so every entry is re-checked
+// against the guest's MCB before use and any mismatch drops the index and
+// falls back to the classic full walk.
+
+struct FreeMcbEntry {
+	uint16_t segment = 0; // segment of the MCB itself, not of its data
+	uint16_t size = 0;    // block size in paragraphs
+};
+
+static std::vector<FreeMcbEntry> free_mcb_index = {};
+static bool free_mcb_index_valid = false;
+
+static void invalidate_free_index()
+{
+	free_mcb_index_valid = false;
+}
+
+// Walk the chain from dos.firstMCB and record its free blocks. When the
+// UMBs are linked into the chain this covers them too, exactly as the
+// classic walk would.
+static void rebuild_free_index()
+{
+	free_mcb_index.clear();
+
+	uint16_t mcb_segment = dos.firstMCB;
+	DOS_MCB mcb(mcb_segment);
+
+	uint16_t faults = 0;
+	while (faults < max_allowed_faults) {
+		if (mcb.GetPSPSeg() == MCB_FREE)
+			free_mcb_index.push_back({mcb_segment, mcb.GetSize()});
+		if (mcb.GetType() == ending_mcb_type)
+			break;
+		faults += triage_block(mcb, middle_mcb_type);
+		mcb_segment += mcb.GetSize() + 1;
+		mcb.SetPt(mcb_segment);
+	}
+	free_mcb_index_valid = true;
+}
+
+#ifndef NDEBUG
+// Debug-only cross-check of the whole index against a fresh chain walk;
+// catches free blocks the guest created by editing MCBs directly, which
+// the per-entry check cannot see.
+static bool free_index_matches_chain()
+{
+	std::vector<FreeMcbEntry> fresh = {};
+	uint16_t mcb_segment = dos.firstMCB;
+	DOS_MCB mcb(mcb_segment);
+	for (;;) {
+		if (mcb.GetPSPSeg() == MCB_FREE)
+			fresh.push_back({mcb_segment, mcb.GetSize()});
+		if (mcb.GetType() != middle_mcb_type)
+			break;
+		mcb_segment += mcb.GetSize() + 1;
+		mcb.SetPt(mcb_segment);
+	}
+	auto entries_match = [](const FreeMcbEntry &a, const FreeMcbEntry &b) {
+		return a.segment == b.segment && a.size == b.size;
+	};
+	return fresh.size() == free_mcb_index.size() &&
+	       std::equal(fresh.begin(), fresh.end(), free_mcb_index.begin(),
+	                  entries_match);
+}
+#endif
+
 static void DOS_CompressMemory()
 {
 	uint16_t mcb_segment = dos.firstMCB;
@@ -115,6 +190,7 @@ static void DOS_CompressMemory()
 			mcb.SetPt(mcb_segment);
 		}
 	}
+	rebuild_free_index();
 }
 
 void DOS_FreeProcessMemory(uint16_t pspseg) {
@@ -170,7 +246,103 @@ bool DOS_SetMemAllocStrategy(const uint16_t strat)
 	return false;
 }
 
-bool DOS_AllocateMemory(uint16_t * segment,uint16_t * blocks) {
+// Try to satisfy an allocation from the index alone. Returns false when no
+// entry fits or an entry no longer matches guest memory, in which case the
+// caller takes the classic chain walk.
+static bool allocate_memory_indexed(uint16_t *segment, const uint16_t blocks)
+{
+	assert(free_mcb_index_valid);
+#ifndef NDEBUG
+	if (!free_index_matches_chain()) {
+		LOG(LOG_DOSMISC, LOG_WARN)("Free MCB index out of sync with chain, rebuilding");
+		invalidate_free_index();
+		return false;
+	}
+#endif
+	const uint16_t strategy = allocation_strategy & 0x3f;
+	const size_t num_entries = free_mcb_index.size();
+
+	DOS_MCB mcb(0);
+	size_t found = num_entries;
+	for (size_t i = 0; i < num_entries; ++i) {
+		const auto &entry = free_mcb_index[i];
+		mcb.SetPt(entry.segment);
+		const auto mcb_type = mcb.GetType();
+		if (mcb.GetPSPSeg() != MCB_FREE || mcb.GetSize() != entry.size ||
+		    (mcb_type != middle_mcb_type && mcb_type != ending_mcb_type)) {
+			/* the guest edited the chain behind our back */
+			invalidate_free_index();
+			return false;
+		}
+		if (entry.size < blocks)
+			continue;
+		if (strategy == 0) {
+			/* firstfit: lowest fitting address wins */
+			found = i;
+			break;
+		} else if (strategy == 1) {
+			/* bestfit: an exact fit ends the search, otherwise
+			   the smallest fitting block (first one on ties) */
+			if (entry.size == blocks) {
+				found = i;
+				break;
+			}
+			if ((found == num_entries) ||
+			    (entry.size < free_mcb_index[found].size))
+				found = i;
+		} else {
+			/* everything else is handled as lastfit by dos:
+			   highest fitting address wins */
+			found = i;
+		}
+	}
+	if (found == num_entries)
+		return false;
+
+	const auto entry = free_mcb_index[found];
+	char psp_name[9];
+	DOS_MCB psp_mcb(dos.psp() - 1);
+	psp_mcb.GetFileName(psp_name);
+
+	mcb.SetPt(entry.segment);
+	DOS_MCB mcb_next(0);
+	if (entry.size == blocks) {
+		/* MCB fits precisely, use the whole block */
+		mcb.SetPSPSeg(dos.psp());
+		if (strategy > 1)
+			mcb.SetFileName(psp_name);
+		*segment = entry.segment + 1;
+		free_mcb_index.erase(free_mcb_index.begin() + found);
+	} else if (strategy > 1) {
+		/* lastfit, allocate block at the end of the MCB */
+		*segment = entry.segment + 1 + entry.size - blocks;
+		mcb_next.SetPt((uint16_t)(*segment - 1));
+		mcb_next.SetSize(blocks);
+		mcb_next.SetType(mcb.GetType());
+		mcb_next.SetPSPSeg(dos.psp());
+		mcb_next.SetFileName(psp_name);
+		mcb.SetSize(entry.size - blocks - 1);
+		mcb.SetPSPSeg(MCB_FREE);
+		mcb.SetType(middle_mcb_type);
+		free_mcb_index[found].size = entry.size - blocks - 1;
+	} else {
+		/* firstfit/bestfit, allocate block at the beginning of the MCB */
+		mcb_next.SetPt((uint16_t)(entry.segment + blocks + 1));
+		mcb_next.SetPSPSeg(MCB_FREE);
+		mcb_next.SetType(mcb.GetType());
+		mcb_next.SetSize(entry.size - blocks - 1);
+		mcb.SetSize(blocks);
+		mcb.SetType(middle_mcb_type);
+		mcb.SetPSPSeg(dos.psp());
+		mcb.SetFileName(psp_name);
+		*segment = entry.segment + 1;
+		free_mcb_index[found].segment = entry.segment + blocks + 1;
+		free_mcb_index[found].size = entry.size - blocks - 1;
+	}
+	return true;
+}
+
+static bool allocate_memory_classic(uint16_t * segment,uint16_t * blocks) {
 	DOS_CompressMemory();
 	uint16_t bigsize=0;
 	uint16_t mem_strat  = allocation_strategy;
@@ -294,6 +466,26 @@ bool DOS_AllocateMemory(uint16_t * segment,uint16_t * blocks) {
 	return false;
 }
 
+bool DOS_AllocateMemory(uint16_t * segment,uint16_t * blocks) {
+	/* UMB-first strategies (bits 7 or 6 set) are rare enough to keep on
+	   the classic walk; everything else tries the index first */
+	if ((allocation_strategy & 0xc0) == 0) {
+		if (!free_mcb_index_valid)
+			DOS_CompressMemory();
+		if (free_mcb_index_valid &&
+		    allocate_memory_indexed(segment, *blocks))
+			return true;
+		/* no fit in the index: the classic path compresses first,
+		   which may merge neighbouring free blocks into a fit */
+	}
+	const bool allocated = allocate_memory_classic(segment, blocks);
+	if (allocated) {
+		/* the classic walk claims blocks without updating the index */
+		invalidate_free_index();
+	}
+	return allocated;
+}
+
 
 bool DOS_ResizeMemory(uint16_t segment,uint16_t * blocks) {
 	if (segment < DOS_MEM_START+1) {
@@ -360,6 +552,7 @@ bool DOS_ResizeMemory(uint16_t segment,uint16_t * blocks) {
 	}
 	mcb.SetSize(total);
 	mcb.SetPSPSeg(dos.psp());
+	invalidate_free_index(); // a trailing free block may have been joined
 	if (*blocks==total) return true;	/* block fit exactly */
 
 	*blocks=total;	/* return maximum */
@@ -383,6 +576,17 @@ bool DOS_FreeMemory(uint16_t segment) {
 	}
 	mcb.SetPSPSeg(MCB_FREE);
 //	DOS_CompressMemory();
+	if (free_mcb_index_valid) {
+		/* keep the index warm: record the freed block in address order */
+		const FreeMcbEntry freed = {(uint16_t)(segment - 1), mcb.GetSize()};
+		const auto pos = std::lower_bound(
+		        free_mcb_index.begin(), free_mcb_index.end(), freed,
+		        [](const FreeMcbEntry &a, const FreeMcbEntry &b) {
+			        return a.segment < b.segment;
+		        });
+		if (pos == free_mcb_index.end() || pos->segment != freed.segment)
+			free_mcb_index.insert(pos, freed);
+	}
 	return true;
 }
 
@@ -422,6 +626,7 @@ void DOS_BuildUMBChain(bool umb_active,bool ems_active) {
 		dos_infoblock.SetStartOfUMBChain(0xffff);
 		dos_infoblock.SetUMBChainState(0);
 	}
+	invalidate_free_index();
 }
 
 bool DOS_LinkUMBsToMemChain(uint16_t linkstate) {
@@ -465,6 +670,7 @@ bool DOS_LinkUMBsToMemChain(uint16_t linkstate) {
 		        return false;
 	        }
 
+	invalidate_free_index(); // the chain just gained or lost the UMB tail
 	return true;
 }
 
@@ -535,4 +741,5 @@ void DOS_SetupMemory(void) {
 
 	dos.firstMCB=DOS_MEM_START;
 	dos_infoblock.SetFirstMCB(DOS_MEM_START);
+	invalidate_free_index();
 }
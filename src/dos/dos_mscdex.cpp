@@ -195,6 +195,10 @@ private:
 	PhysPt		GetDefaultBuffer	(void);
 	PhysPt		GetTempBuffer		(void);
 
+	bool		ReadSectorCached	(uint8_t subUnit, uint32_t sector, PhysPt data);
+	void		InvalidateMediaCache	(uint8_t subUnit);
+	void		InvalidateMediaCaches	(void);
+
 	uint16_t		numDrives;
 
 	typedef struct SDriveInfo {
@@ -210,6 +214,22 @@ private:
 		TCtrl	audioCtrl;		// audio channel control
 	} TDriveInfo;
 
+	// Per-drive cache of the ISO structures titles poll constantly for
+	// disc-change detection: the TOC and the metadata sectors holding the
+	// volume descriptors and directory records. Dropped whenever new
+	// media is announced, so steady-state polls never touch sector I/O.
+	static constexpr int num_cached_sectors = 8;
+	typedef struct SMediaCache {
+		bool	tocValid;
+		uint8_t	tocFirstTrack;
+		uint8_t	tocLastTrack;
+		TMSF	tocLeadOut;
+		bool	sectorValid[num_cached_sectors];
+		uint32_t	sectorNum[num_cached_sectors];
+		uint8_t	sectorData[num_cached_sectors][2048];
+	} TMediaCache;
+
+	TMediaCache         mediaCache[MSCDEX_MAX_DRIVES];
 	uint16_t            defaultBufSeg;
 	
 public:
@@ -228,6 +248,7 @@ CMscdex::CMscdex()
 	  cdrom{nullptr}
 {
 	memset(dinfo, 0, sizeof(dinfo));
+	memset(mediaCache, 0, sizeof(mediaCache));
 }
 
 CMscdex::~CMscdex()
@@ -284,6 +305,8 @@ int CMscdex::RemoveDrive(uint16_t _drive)
 		memset(&dinfo[idx],0,sizeof(TDriveInfo));
 	}
 	numDrives--;
+	// subunit numbering may have shifted, start the caches afresh
+	InvalidateMediaCaches();
 
 	if (GetNumDrives() == 0) {
 		DOS_DeviceHeader devHeader(PhysicalMake(rootDriverHeaderSeg,0));
@@ -414,6 +437,8 @@ int CMscdex::AddDrive(uint16_t _drive, const char* physicalPath, uint8_t& subUni
 	}
 	// stop audio
 	StopAudio(subUnit);
+	// subunit numbering may have shifted, start the caches afresh
+	InvalidateMediaCaches();
 	return result;
 }
 
@@ -427,6 +452,16 @@ void CMscdex::ReplaceDrive(CDROM_Interface* newCdrom, uint8_t subUnit) {
 		delete cdrom[subUnit];
 	}
 	cdrom[subUnit] = newCdrom;
+	InvalidateMediaCache(subUnit);
+}
+
+void CMscdex::InvalidateMediaCache(uint8_t subUnit) {
+	if (subUnit < MSCDEX_MAX_DRIVES)
+		memset(&mediaCache[subUnit], 0, sizeof(TMediaCache));
+}
+
+void CMscdex::InvalidateMediaCaches(void) {
+	memset(mediaCache, 0, sizeof(mediaCache));
 }
 
 PhysPt CMscdex::GetDefaultBuffer(void) {
@@ -455,9 +490,25 @@ void CMscdex::GetDriverInfo	(PhysPt data) {
 
 bool CMscdex::GetCDInfo(uint8_t subUnit, uint8_t& tr1, uint8_t& tr2, TMSF& leadOut) {
 	if (subUnit>=numDrives) return false;
+	// Titles poll the TOC for disc-change detection; serve repeats from
+	// the cache, which media-change notification drops
+	TMediaCache& cache = mediaCache[subUnit];
+	if (cache.tocValid) {
+		tr1 = cache.tocFirstTrack;
+		tr2 = cache.tocLastTrack;
+		leadOut = cache.tocLeadOut;
+		dinfo[subUnit].lastResult = true;
+		return true;
+	}
 	// Assume Media change
 	cdrom[subUnit]->InitNewMedia();
 	dinfo[subUnit].lastResult = cdrom[subUnit]->GetAudioTracks(tr1, tr2, leadOut);
+	if (dinfo[subUnit].lastResult) {
+		cache.tocFirstTrack = tr1;
+		cache.tocLastTrack = tr2;
+		cache.tocLeadOut = leadOut;
+		cache.tocValid = true;
+	}
 	return dinfo[subUnit].lastResult;
 }
 
@@ -601,7 +652,7 @@ bool CMscdex::ReadVTOC(uint16_t drive, uint16_t volume, PhysPt data, uint16_t& o
 		error=MSCDEX_ERROR_UNKNOWN_DRIVE;
 		return false;
 	} */
-	if (!ReadSectors(subunit,false,16+volume,1,data)) {
+	if (!ReadSectorCached(subunit,16+volume,data)) {
 		error=MSCDEX_ERROR_DRIVE_NOT_READY;
 		return false;
 	}
@@ -686,6 +737,24 @@ bool CMscdex::ReadSectors(uint16_t drive, uint32_t sector, uint16_t num, PhysPt
 	return ReadSectors(GetSubUnit(drive),false,sector,num,data);
 }
 
+// Serve ISO metadata sectors (volume descriptors, directory records) from
+// the per-drive cache so steady-state polls stay off the sector I/O path
+bool CMscdex::ReadSectorCached(uint8_t subUnit, uint32_t sector, PhysPt data) {
+	if (subUnit>=numDrives) return false;
+	TMediaCache& cache = mediaCache[subUnit];
+	const uint32_t slot = sector % num_cached_sectors;
+	if (cache.sectorValid[slot] && cache.sectorNum[slot]==sector) {
+		MEM_BlockWrite(data,cache.sectorData[slot],2048);
+		dinfo[subUnit].lastResult = true;
+		return true;
+	}
+	if (!ReadSectors(subUnit,false,sector,1,data)) return false;
+	MEM_BlockRead(data,cache.sectorData[slot],2048);
+	cache.sectorNum[slot] = sector;
+	cache.sectorValid[slot] = true;
+	return true;
+}
+
 bool CMscdex::GetDirectoryEntry(uint16_t drive, bool copyFlag, PhysPt pathname, PhysPt buffer, uint16_t& error) {
 	char	volumeID[6] = {0};
 	char	searchName[256];
@@ -709,7 +778,7 @@ bool CMscdex::GetDirectoryEntry(uint16_t drive, bool copyFlag, PhysPt pathname,
 	//LOG(LOG_MISC,LOG_ERROR)("MSCDEX: Get DirEntry : Find : %s",searchName);
 	// read vtoc
 	PhysPt defBuffer = GetDefaultBuffer();
-	if (!ReadSectors(GetSubUnit(drive),false,16,1,defBuffer)) return false;
+	if (!ReadSectorCached(GetSubUnit(drive),16,defBuffer)) return false;
 	MEM_StrCopy(defBuffer+1,volumeID,5); volumeID[5] = 0;
 	bool iso = (strcmp("CD001",volumeID)==0);
 	if (!iso) {
@@ -723,7 +792,7 @@ bool CMscdex::GetDirectoryEntry(uint16_t drive, bool copyFlag, PhysPt pathname,
 	Bitu index;
 	while (dirSize>0) {
 		index = 0;
-		if (!ReadSectors(GetSubUnit(drive),false,dirEntrySector,1,defBuffer)) return false;
+		if (!ReadSectorCached(GetSubUnit(drive),dirEntrySector,defBuffer)) return false;
 		// Get string part
 		foundName	= false;
 		if (nextPart) {
@@ -896,6 +965,7 @@ void CMscdex::InitNewMedia(uint8_t subUnit) {
 	if (subUnit<numDrives) {
 		// Reopen new media
 		cdrom[subUnit]->InitNewMedia();
+		InvalidateMediaCache(subUnit);
 	}
 }
 
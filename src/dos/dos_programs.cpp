@@ -26,6 +26,7 @@
 #include "program_autotype.h"
 #include "program_boot.h"
 #include "program_choice.h"
+#include "program_ffwd.h"
 #include "program_help.h"
 #include "program_imgmount.h"
 #include "program_intro.h"
@@ -81,6 +82,7 @@ void Add_VFiles(const bool add_autoexec)
 	PROGRAMS_MakeFile("CHOICE.COM", ProgramCreate<CHOICE>);
 	PROGRAMS_MakeFile("COMMAND.COM", SHELL_ProgramCreate);
 	PROGRAMS_MakeFile("CONFIG.COM", CONFIG_ProgramCreate);
+	PROGRAMS_MakeFile("FFWD.COM", ProgramCreate<FFWD>);
 	PROGRAMS_MakeFile("HELP.COM", ProgramCreate<HELP>);
 	PROGRAMS_MakeFile("IMGMOUNT.COM", ProgramCreate<IMGMOUNT>);
 	PROGRAMS_MakeFile("INTRO.COM", ProgramCreate<INTRO>);
@@ -26,6 +26,7 @@
 #include "cross.h"
 #include "dos_inc.h"
 #include "drives.h"
+#include "std_filesystem.h"
 #include "string_utils.h"
 #include "support.h"
 
@@ -55,10 +56,49 @@ bool SortByDirNameRev(DOS_Drive_Cache::CFileInfo* const a,
                       DOS_Drive_Cache::CFileInfo* const b)
 {
 	// Directories first...
-	if (a->isDir!=b->isDir) return (a->isDir>b->isDir);	
+	if (a->isDir!=b->isDir) return (a->isDir>b->isDir);
 	return strcmp(a->shortname,b->shortname)>0;
 }
 
+// The same orderings for the lightweight FindFirst snapshots
+[[maybe_unused]] static bool SortSearchByName(const DOS_Drive_Cache::SearchEntry& a,
+                                              const DOS_Drive_Cache::SearchEntry& b)
+{
+	return strcmp(a.shortname, b.shortname) < 0;
+}
+
+static bool SortSearchByNameRev(const DOS_Drive_Cache::SearchEntry& a,
+                                const DOS_Drive_Cache::SearchEntry& b)
+{
+	return strcmp(a.shortname, b.shortname) > 0;
+}
+
+static bool SortSearchByDirName(const DOS_Drive_Cache::SearchEntry& a,
+                                const DOS_Drive_Cache::SearchEntry& b)
+{
+	// Directories first...
+	if (a.isDir != b.isDir) return (a.isDir > b.isDir);
+	return strcmp(a.shortname, b.shortname) < 0;
+}
+
+static bool SortSearchByDirNameRev(const DOS_Drive_Cache::SearchEntry& a,
+                                   const DOS_Drive_Cache::SearchEntry& b)
+{
+	// Directories first...
+	if (a.isDir != b.isDir) return (a.isDir > b.isDir);
+	return strcmp(a.shortname, b.shortname) > 0;
+}
+
+// Keys into the pre-scanned listings are expanded host paths with a
+// trailing separator, matching dirPath as set up by OpenDir
+static std::string pre_scan_key(const char* path)
+{
+	std::string key = path;
+	if (!key.empty() && key.back() != CROSS_FILESPLIT)
+		key += CROSS_FILESPLIT;
+	return key;
+}
+
 DOS_Drive_Cache::DOS_Drive_Cache(void)
 	: dirBase(new CFileInfo),
 	  dirPath{0},
@@ -95,9 +135,10 @@ DOS_Drive_Cache::DOS_Drive_Cache(const char* path)
 }
 
 DOS_Drive_Cache::~DOS_Drive_Cache(void) {
+	StopPreScan();
 	Clear();
 	for (uint32_t i=0; i<MAX_OPENDIRS; i++) {
-		DeleteFileInfo(dirFindFirst[i]);
+		delete dirFindFirst[i];
 		dirFindFirst[i] = nullptr;
 	}
 }
@@ -112,6 +153,7 @@ void DOS_Drive_Cache::Clear(void) {
 
 void DOS_Drive_Cache::EmptyCache(void) {
 	// Empty Cache and reinit
+	StopPreScan();
 	Clear();
 	dirBase		= new CFileInfo;
 	save_dir	= nullptr;
@@ -159,6 +201,14 @@ void DOS_Drive_Cache::SetBaseDir(const char *baseDir)
 		char* result = nullptr;
 		ReadDir(id,result);
 	}
+	// Enumerate the rest of the tree in the background, so the first
+	// guest access to a subdirectory finds its listing ready instead of
+	// stalling on the host filesystem
+	StopPreScan();
+	pre_scan_stop = false;
+	pre_scan_worker = std::thread(&DOS_Drive_Cache::PreScanWorker, this);
+	set_thread_name(pre_scan_worker, "dosbox:dircache");
+
 	// Get Volume Label
 #if defined (WIN32)
 	bool cdrom = false;
@@ -174,6 +224,66 @@ void DOS_Drive_Cache::SetBaseDir(const char *baseDir)
 #endif
 }
 
+void DOS_Drive_Cache::PreScanWorker()
+{
+	// Bound the memory the pre-scan may pin; anything beyond this falls
+	// back to on-demand enumeration
+	constexpr size_t max_entries = 1024 * 1024;
+
+	size_t num_entries = 0;
+	std::vector<std::string> pending = {};
+	pending.push_back(pre_scan_key(basePath));
+
+	while (!pending.empty() && !pre_scan_stop && num_entries < max_entries) {
+		const auto dir_key = std::move(pending.back());
+		pending.pop_back();
+
+		// Host enumeration always includes the dot entries, so the
+		// published listings carry them too
+		PreScannedEntries entries = {};
+		entries.emplace_back(".", true);
+		entries.emplace_back("..", true);
+
+		std::error_code ec = {};
+		for (const auto& e : std_fs::directory_iterator(dir_key, ec)) {
+			if (pre_scan_stop)
+				return;
+			std::error_code type_ec = {};
+			const bool is_dir = e.is_directory(type_ec);
+			entries.emplace_back(e.path().filename().string(), is_dir);
+			if (is_dir)
+				pending.push_back(dir_key + entries.back().first +
+				                  CROSS_FILESPLIT);
+		}
+		if (ec)
+			continue;
+
+		num_entries += entries.size();
+
+		std::lock_guard<std::mutex> lock(pre_scan_mutex);
+		pre_scanned[dir_key] = std::move(entries);
+	}
+}
+
+bool DOS_Drive_Cache::TakePreScannedDir(const char* path, PreScannedEntries& entries)
+{
+	std::lock_guard<std::mutex> lock(pre_scan_mutex);
+	auto it = pre_scanned.find(pre_scan_key(path));
+	if (it == pre_scanned.end())
+		return false;
+	entries = std::move(it->second);
+	pre_scanned.erase(it);
+	return true;
+}
+
+void DOS_Drive_Cache::StopPreScan()
+{
+	pre_scan_stop = true;
+	if (pre_scan_worker.joinable())
+		pre_scan_worker.join();
+	pre_scanned.clear();
+}
+
 void DOS_Drive_Cache::ExpandNameAndNormaliseCase(char* path)
 {
 	safe_strncpy(path, GetExpandNameAndNormaliseCase(path), CROSS_LEN);
@@ -367,6 +477,11 @@ void DOS_Drive_Cache::CacheOut(const char* path, bool ignoreLastDir) {
 	dir->fileList.clear();
 	dir->longNameList.clear();
 	save_dir = nullptr;
+
+	// Drop the pre-scanned listing as well, so the next ReadDir hits
+	// the host filesystem and not a snapshot taken at mount time
+	std::lock_guard<std::mutex> lock(pre_scan_mutex);
+	pre_scanned.erase(pre_scan_key(expand));
 }
 
 bool DOS_Drive_Cache::IsCachedIn(CFileInfo* curDir) {
@@ -683,28 +798,10 @@ void DOS_Drive_Cache::CreateShortName(CFileInfo* curDir, CFileInfo* info) {
 		}
 
 		// keep list sorted for CreateShortNameID to work correctly
-		if (curDir->longNameList.size()>0) {
-			if (!(strcmp(info->shortname,curDir->longNameList.back()->shortname)<0)) {
-				// append at end of list
-				curDir->longNameList.push_back(info);
-			} else {
-				// look for position where to insert this element
-				bool found=false;
-				std::vector<CFileInfo*>::iterator it;
-				for (it=curDir->longNameList.begin(); it!=curDir->longNameList.end(); ++it) {
-					if (strcmp(info->shortname,(*it)->shortname)<0) {
-						found = true;
-						break;
-					}
-				}
-				// Put it in longname list...
-				if (found) curDir->longNameList.insert(it,info);
-				else curDir->longNameList.push_back(info);
-			}
-		} else {
-			// empty file list, append
-			curDir->longNameList.push_back(info);
-		}
+		const auto it = std::upper_bound(curDir->longNameList.begin(),
+		                                 curDir->longNameList.end(),
+		                                 info, SortByName);
+		curDir->longNameList.insert(it, info);
 	} else {
 		safe_strcpy(info->shortname, tmpName);
 	}
@@ -846,43 +943,12 @@ void DOS_Drive_Cache::CreateEntry(CFileInfo* dir, const char* name, bool is_dire
 	info->isDir = is_directory;
 
 	// Check for long filenames...
-	CreateShortName(dir, info);		
-
-	bool found = false;
+	CreateShortName(dir, info);
 
 	// keep list sorted (so GetLongName works correctly, used by CreateShortName in this routine)
-	if (dir->fileList.size()>0) {
-		if (!(strcmp(info->shortname,dir->fileList.back()->shortname)<0)) {
-			// append at end of list
-			dir->fileList.push_back(info);
-		} else {
-			// look for position where to insert this element
-			std::vector<CFileInfo*>::iterator it;
-			for (it=dir->fileList.begin(); it!=dir->fileList.end(); ++it) {
-				if (strcmp(info->shortname,(*it)->shortname)<0) {
-					found = true;
-					break;
-				}
-			}
-			// Put file in lists
-			if (found) dir->fileList.insert(it,info);
-			else dir->fileList.push_back(info);
-		}
-	} else {
-		// empty file list, append
-		dir->fileList.push_back(info);
-	}
-}
-
-void DOS_Drive_Cache::CopyEntry(CFileInfo* dir, CFileInfo* from) {
-	CFileInfo* info = new CFileInfo;
-	// just copy things into new fileinfo
-	safe_strcpy(info->orgname, from->orgname);
-	safe_strcpy(info->shortname, from->shortname);
-	info->shortNr = from->shortNr;
-	info->isDir = from->isDir;
-
-	dir->fileList.push_back(info);
+	const auto it = std::upper_bound(dir->fileList.begin(), dir->fileList.end(),
+	                                 info, SortByName);
+	dir->fileList.insert(it, info);
 }
 
 bool DOS_Drive_Cache::ReadDir(uint16_t id, char* &result) {
@@ -891,27 +957,35 @@ bool DOS_Drive_Cache::ReadDir(uint16_t id, char* &result) {
 		return false;
 
 	if (!IsCachedIn(dirSearch[id])) {
-		// Try to open directory
-		dir_information* dirp = open_directory(dirPath);
-		if (!dirp) {
-			if (dirSearch[id]) {
-				dirSearch[id]->id = MAX_OPENDIRS;
-				dirSearch[id] = nullptr;
+		// The background pre-scan may have enumerated this directory
+		// already; consume its listing instead of the host filesystem
+		PreScannedEntries pre_scanned_entries = {};
+		if (TakePreScannedDir(dirPath, pre_scanned_entries)) {
+			for (const auto& [entry_name, is_dir] : pre_scanned_entries)
+				CreateEntry(dirSearch[id], entry_name.c_str(), is_dir);
+		} else {
+			// Try to open directory
+			dir_information* dirp = open_directory(dirPath);
+			if (!dirp) {
+				if (dirSearch[id]) {
+					dirSearch[id]->id = MAX_OPENDIRS;
+					dirSearch[id] = nullptr;
+				}
+				return false;
 			}
-			return false;
-		}
-		// Read complete directory
-		char dir_name[CROSS_LEN];
-		bool is_directory;
-		if (read_directory_first(dirp, dir_name, is_directory)) {
-			CreateEntry(dirSearch[id], dir_name, is_directory);
-			while (read_directory_next(dirp, dir_name, is_directory)) {
+			// Read complete directory
+			char dir_name[CROSS_LEN];
+			bool is_directory;
+			if (read_directory_first(dirp, dir_name, is_directory)) {
 				CreateEntry(dirSearch[id], dir_name, is_directory);
+				while (read_directory_next(dirp, dir_name, is_directory)) {
+					CreateEntry(dirSearch[id], dir_name, is_directory);
+				}
 			}
-		}
 
-		// close dir
-		close_directory(dirp);
+			// close dir
+			close_directory(dirp);
+		}
 
 		// Info
 /*		if (!dirp) {
@@ -970,28 +1044,34 @@ bool DOS_Drive_Cache::FindFirst(char* path, uint16_t& id) {
 		// Clear the internal list then.
 		dirFindFirstID = 0;
 		this->nextFreeFindFirst = 1; //the next free one after this search
-		for(Bitu n=0; n<MAX_OPENDIRS;n++) {	
+		for(Bitu n=0; n<MAX_OPENDIRS;n++) {
 	     	// Clear and reuse slot
-			DeleteFileInfo(dirFindFirst[n]);
+			delete dirFindFirst[n];
 			dirFindFirst[n] = nullptr;
 		}
-	   
+
 	}
 	assert(dirFindFirst[dirFindFirstID] == nullptr);
-	dirFindFirst[dirFindFirstID] = new CFileInfo();
-	dirFindFirst[dirFindFirstID]->nextEntry = 0;
-
-	// Copy entries to use with FindNext
-	for (Bitu i=0; i<dirSearch[dirID]->fileList.size(); i++) {
-		CopyEntry(dirFindFirst[dirFindFirstID],dirSearch[dirID]->fileList[i]);
+	auto snapshot = new SearchSnapshot();
+	dirFindFirst[dirFindFirstID] = snapshot;
+
+	// Copy the fields FindNext needs
+	const auto& fileList = dirSearch[dirID]->fileList;
+	snapshot->entries.reserve(fileList.size());
+	for (const auto* info : fileList) {
+		SearchEntry entry = {};
+		safe_strcpy(entry.shortname, info->shortname);
+		entry.isDir = info->isDir;
+		snapshot->entries.push_back(entry);
 	}
-	// Now re-sort the fileList accordingly to output
+	// Now re-sort the entries accordingly to output
+	auto& entries = snapshot->entries;
 	switch (sortDirType) {
 		case ALPHABETICAL		: break;
-//		case ALPHABETICAL		: std::sort(dirFindFirst[dirFindFirstID]->fileList.begin(), dirFindFirst[dirFindFirstID]->fileList.end(), SortByName);		break;
-		case DIRALPHABETICAL	: std::sort(dirFindFirst[dirFindFirstID]->fileList.begin(), dirFindFirst[dirFindFirstID]->fileList.end(), SortByDirName);		break;
-		case ALPHABETICALREV	: std::sort(dirFindFirst[dirFindFirstID]->fileList.begin(), dirFindFirst[dirFindFirstID]->fileList.end(), SortByNameRev);		break;
-		case DIRALPHABETICALREV	: std::sort(dirFindFirst[dirFindFirstID]->fileList.begin(), dirFindFirst[dirFindFirstID]->fileList.end(), SortByDirNameRev);	break;
+//		case ALPHABETICAL		: std::sort(entries.begin(), entries.end(), SortSearchByName);		break;
+		case DIRALPHABETICAL	: std::sort(entries.begin(), entries.end(), SortSearchByDirName);	break;
+		case ALPHABETICALREV	: std::sort(entries.begin(), entries.end(), SortSearchByNameRev);	break;
+		case DIRALPHABETICALREV	: std::sort(entries.begin(), entries.end(), SortSearchByDirNameRev);	break;
 		case NOSORT				: break;
 	}
 
@@ -1006,12 +1086,17 @@ bool DOS_Drive_Cache::FindNext(uint16_t id, char* &result) {
 		LOG(LOG_MISC,LOG_ERROR)("DIRCACHE: FindFirst/Next failure : ID out of range: %04X",id);
 		return false;
 	}
-	if (!SetResult(dirFindFirst[id], result, dirFindFirst[id]->nextEntry)) {
+	auto snapshot = dirFindFirst[id];
+	if (snapshot->nextEntry >= snapshot->entries.size()) {
 		// free slot
-		DeleteFileInfo(dirFindFirst[id]);
+		delete snapshot;
 		dirFindFirst[id] = nullptr;
 		return false;
 	}
+	static char res[CROSS_LEN] = { 0 };
+	safe_strcpy(res, snapshot->entries[snapshot->nextEntry].shortname);
+	++snapshot->nextEntry;
+	result = res;
 	return true;
 }
 
@@ -133,6 +133,27 @@ bool fatFile::Read(uint8_t * data, uint16_t *size) {
 		data[sizecount++] = sectorBuffer[curSectOff++];
 		seekpos++;
 		if(curSectOff >= myDrive->getSectorSize()) {
+			// Fast path: while whole sectors remain both in the
+			// request and the file, read them straight into the
+			// caller's buffer instead of bouncing each byte
+			// through sectorBuffer. A trailing partial sector (if
+			// any) still goes through the normal reload below.
+			const auto sector_bytes = static_cast<uint16_t>(
+			        myDrive->getSectorSize());
+			while (sizedec > sector_bytes &&
+			       filelength - seekpos >= sector_bytes) {
+				currentSector = myDrive->getAbsoluteSectFromBytePos(firstCluster, seekpos);
+				if(currentSector == 0) {
+					/* EOC reached before EOF */
+					*size = sizecount;
+					loadedSector = false;
+					return true;
+				}
+				myDrive->readSector(currentSector, &data[sizecount]);
+				seekpos += sector_bytes;
+				sizecount += sector_bytes;
+				sizedec -= sector_bytes;
+			}
 			currentSector = myDrive->getAbsoluteSectFromBytePos(firstCluster, seekpos);
 			if(currentSector == 0) {
 				/* EOC reached before EOF */
@@ -306,6 +327,11 @@ bool fatFile::Close()
 		if (loadedSector) {
 			myDrive->writeSector(currentSector, sectorBuffer);
 		}
+
+		/* Push any write-back cached sectors out to the image */
+		if (myDrive->loadedDisk) {
+			myDrive->loadedDisk->FlushWriteCache();
+		}
 	}
 
 	set_archive_on_close = false;
@@ -374,6 +400,9 @@ uint32_t fatDrive::getClusterValue(uint32_t clustNum) {
 }
 
 void fatDrive::setClusterValue(uint32_t clustNum, uint32_t clustValue) {
+	// The FAT is changing; any condensed chain may now be stale
+	chain_extent_cache.clear();
+
 	uint32_t fatoffset=0;
 	uint32_t fatsectnum;
 	uint32_t fatentoff;
@@ -618,17 +647,31 @@ uint32_t fatDrive::getAbsoluteSectFromBytePos(uint32_t startClustNum, uint32_t b
 	return  getAbsoluteSectFromChain(startClustNum, bytePos / bootbuffer.bytespersector);
 }
 
-uint32_t fatDrive::getAbsoluteSectFromChain(uint32_t startClustNum, uint32_t logicalSector) {
-	int32_t skipClust = logicalSector / bootbuffer.sectorspercluster;
-	uint32_t sectClust = logicalSector % bootbuffer.sectorspercluster;
+// Walks the FAT once and condenses the chain starting at 'startClustNum' into
+// runs of contiguous clusters. Seeks then binary-search the runs instead of
+// re-walking the chain link by link, which made random access into large
+// files O(file size) per seek. setClusterValue drops the cache whenever the
+// FAT changes.
+const std::vector<fatDrive::ChainExtent>& fatDrive::getChainExtents(const uint32_t startClustNum)
+{
+	const auto cached = chain_extent_cache.find(startClustNum);
+	if (cached != chain_extent_cache.end()) {
+		return cached->second;
+	}
 
+	std::vector<ChainExtent> extents = {};
+	ChainExtent run = {0, startClustNum, 1};
+
+	uint32_t index        = 0;
 	uint32_t currentClust = startClustNum;
-	uint32_t testvalue;
 
-	while(skipClust!=0) {
+	// Guard against a corrupted (circular) FAT chain
+	const uint32_t max_chain_length = CountOfClusters + 2;
+
+	while (true) {
+		const uint32_t testvalue = getClusterValue(currentClust);
 		bool isEOF = false;
-		testvalue = getClusterValue(currentClust);
-		switch(fattype) {
+		switch (fattype) {
 			case FAT12:
 				if(testvalue >= 0xff8) isEOF = true;
 				break;
@@ -639,17 +682,55 @@ uint32_t fatDrive::getAbsoluteSectFromChain(uint32_t startClustNum, uint32_t log
 				if(testvalue >= 0xfffffff8) isEOF = true;
 				break;
 		}
-		if((isEOF) && (skipClust>=1)) {
-			//LOG_MSG("End of cluster chain reached before end of logical sector seek!");
-			if (skipClust == 1 && fattype == FAT12) {
-				//break;
-				LOG(LOG_DOSMISC, LOG_ERROR)("End of cluster chain reached, but maybe good after all ?");
-			}
-			return 0;
+		if (isEOF) {
+			break;
+		}
+		++index;
+		if (index >= max_chain_length) {
+			LOG(LOG_DOSMISC, LOG_ERROR)("Cluster chain starting at %u does not terminate",
+			                            startClustNum);
+			break;
+		}
+		if (testvalue == currentClust + 1) {
+			++run.cluster_count;
+		} else {
+			extents.push_back(run);
+			run = {index, testvalue, 1};
 		}
 		currentClust = testvalue;
-		--skipClust;
 	}
+	extents.push_back(run);
+
+	const auto result = chain_extent_cache.emplace(startClustNum,
+	                                               std::move(extents));
+	return result.first->second;
+}
+
+uint32_t fatDrive::getAbsoluteSectFromChain(uint32_t startClustNum, uint32_t logicalSector) {
+	const uint32_t skipClust = logicalSector / bootbuffer.sectorspercluster;
+	const uint32_t sectClust = logicalSector % bootbuffer.sectorspercluster;
+
+	const auto& extents = getChainExtents(startClustNum);
+	assert(!extents.empty());
+
+	const auto& last_run = extents.back();
+	const uint32_t chain_length = last_run.logical_start + last_run.cluster_count;
+	if (skipClust >= chain_length) {
+		//LOG_MSG("End of cluster chain reached before end of logical sector seek!");
+		if (skipClust == chain_length && fattype == FAT12) {
+			LOG(LOG_DOSMISC, LOG_ERROR)("End of cluster chain reached, but maybe good after all ?");
+		}
+		return 0;
+	}
+
+	// Find the run holding the requested cluster index
+	auto it = std::upper_bound(extents.begin(), extents.end(), skipClust,
+	                           [](const uint32_t index, const ChainExtent& extent) {
+		                           return index < extent.logical_start;
+	                           });
+	--it;
+	const uint32_t currentClust = it->first_cluster +
+	                              (skipClust - it->logical_start);
 
 	return (getClustFirstSect(currentClust) + sectClust);
 }
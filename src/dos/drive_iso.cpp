@@ -19,6 +19,7 @@
 #include "drives.h"
 
 #include <cctype>
+#include <cinttypes>
 #include <cstring>
 
 #include "cdrom.h"
@@ -171,6 +172,11 @@ isoDrive::isoDrive(char driveLetter, const char *fileName, uint8_t mediaid, int
 			if (!MSCDEX_GetVolumeName(subUnit, buffer)) strcpy(buffer, "");
 			Set_Label(buffer,discLabel,true);
 
+			// Index the directory tree in the background so the
+			// mount returns immediately
+			path_index_builder = std::thread(&isoDrive::BuildPathIndex, this);
+			set_thread_name(path_index_builder, "dosbox:isoidx");
+
 		} else if (CDROM_Interface_Image::images[subUnit]->HasDataTrack() == false) { //Audio only cdrom
 			safe_strcpy(info, fileName);
 			this->driveLetter = driveLetter;
@@ -182,7 +188,17 @@ isoDrive::isoDrive(char driveLetter, const char *fileName, uint8_t mediaid, int
 	}
 }
 
-isoDrive::~isoDrive() { }
+isoDrive::~isoDrive()
+{
+	if (path_index_builder.joinable()) {
+		path_index_builder.join();
+	}
+	if (path_index_hits > 0) {
+		LOG_MSG("ISODRIVE: Path index answered %" PRIu64
+		        " lookups without sector I/O",
+		        path_index_hits);
+	}
+}
 
 int isoDrive::UpdateMscdex(char drive_letter, const char *path, uint8_t &sub_unit)
 {
@@ -414,6 +430,12 @@ bool isoDrive::isRemovable(void) {
 
 Bits isoDrive::UnMount()
 {
+	// The path index builder reads sectors through the CDROM interface
+	// that MSCDEX_RemoveDrive is about to delete, so stop it first
+	path_index_cancel = true;
+	if (path_index_builder.joinable()) {
+		path_index_builder.join();
+	}
 	return MSCDEX_RemoveDrive(driveLetter) ? 0 : 2;
 }
 
@@ -491,7 +513,7 @@ bool isoDrive::ReadCachedSector(uint8_t** buffer, const uint32_t sector) {
 
 	// check if the entry is valid and contains the correct sector
 	if (!he.valid || he.sector != sector) {
-		if (!CDROM_Interface_Image::images[subUnit]->ReadSector(he.data, false, sector)) {
+		if (!readSector(he.data, sector)) {
 			return false;
 		}
 		he.valid = true;
@@ -502,7 +524,10 @@ bool isoDrive::ReadCachedSector(uint8_t** buffer, const uint32_t sector) {
 	return true;
 }
 
-inline bool isoDrive :: readSector(uint8_t *buffer, uint32_t sector) {
+bool isoDrive :: readSector(uint8_t *buffer, uint32_t sector) {
+	// serializes image access between the emulation thread and the
+	// path index builder
+	std::lock_guard<std::mutex> lock(read_mutex);
 	return CDROM_Interface_Image::images[subUnit]->ReadSector(buffer, false, sector);
 }
 
@@ -566,11 +591,128 @@ bool isoDrive :: loadImage() {
 	return false;
 }
 
+// Normalise a guest path to the form used for path index keys: forward
+// slashes, uppercase, and at most one trailing dot stripped per component,
+// matching the comparisons the sector-walking lookup performs
+static std::string normalise_iso_path(const char* path)
+{
+	char iso_path[ISO_MAXPATHNAME];
+	safe_strcpy(iso_path, path);
+	strreplace(iso_path, '\\', '/');
+
+	std::string result = {};
+	for (char* name = strtok(iso_path, "/"); name != nullptr;
+	     name = strtok(nullptr, "/")) {
+		const size_t name_length = strlen(name);
+		if (name_length > 0 && name[name_length - 1] == '.') {
+			name[name_length - 1] = 0;
+		}
+		if (!result.empty()) {
+			result += '/';
+		}
+		result += name;
+	}
+	upcase(result);
+	return result;
+}
+
+// Walk the directory records of a directory extent, mirroring the sector
+// advancing logic of GetNextDirEntry but on a local buffer so it is safe
+// to run off the emulation thread
+void isoDrive::BuildPathIndex()
+{
+	struct PendingDir {
+		isoDirEntry entry = {};
+		std::string path  = {};
+	};
+	std::vector<PendingDir> pending = {};
+	pending.push_back({rootEntry, ""});
+
+	uint64_t num_entries = 0;
+
+	while (!pending.empty() && !path_index_cancel) {
+		const auto dir = std::move(pending.back());
+		pending.pop_back();
+
+		auto sector = EXTENT_LOCATION(dir.entry);
+		auto end_sector = sector + DATA_LENGTH(dir.entry) / ISO_FRAMESIZE - 1;
+		if (DATA_LENGTH(dir.entry) % ISO_FRAMESIZE != 0) {
+			++end_sector;
+		}
+
+		uint8_t buffer[ISO_FRAMESIZE];
+		if (!readSector(buffer, sector)) {
+			continue;
+		}
+		uint32_t pos = 0;
+
+		while (true) {
+			if ((pos >= ISO_FRAMESIZE) || (buffer[pos] == 0) ||
+			    (pos + buffer[pos] > ISO_FRAMESIZE)) {
+				if (sector >= end_sector) {
+					break;
+				}
+				++sector;
+				pos = 0;
+				if (path_index_cancel ||
+				    !readSector(buffer, sector)) {
+					break;
+				}
+				continue;
+			}
+
+			isoDirEntry de = {};
+			const int length = readDirEntry(&de, &buffer[pos]);
+			if (length < 0) {
+				break;
+			}
+			pos += static_cast<uint32_t>(length);
+
+			const auto ident = reinterpret_cast<const char*>(de.ident);
+			if (IS_ASSOC(FLAGS1) || (strcmp(ident, ".") == 0) ||
+			    (strcmp(ident, "..") == 0)) {
+				continue;
+			}
+
+			auto path = dir.path.empty() ? std::string(ident)
+			                             : dir.path + '/' + ident;
+			upcase(path);
+
+			if (IS_DIR(FLAGS1)) {
+				pending.push_back({de, path});
+			}
+			path_index.emplace(std::move(path), de);
+			++num_entries;
+		}
+	}
+
+	if (path_index_cancel) {
+		return; // an unmount abandoned the build
+	}
+
+	path_index_ready = true;
+
+	LOG_MSG("ISODRIVE: Indexed %" PRIu64 " directory entries of '%s'",
+	        num_entries, fileName);
+}
+
 bool isoDrive :: lookup(isoDirEntry *de, const char *path) {
 	if (!dataCD) return false;
 	*de = this->rootEntry;
 	if (!strcmp(path, "")) return true;
 
+	// Once the mount-time index is ready, path resolution is a single
+	// hash lookup with no sector I/O
+	if (path_index_ready) {
+		const auto it = path_index.find(normalise_iso_path(path));
+		if (it == path_index.end()) {
+			return false;
+		}
+		*de = it->second;
+		++path_index_hits;
+		return true;
+	}
+
 	char isoPath[ISO_MAXPATHNAME];
 	safe_strcpy(isoPath, path);
 	strreplace(isoPath, '\\', '/');
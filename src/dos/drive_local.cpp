@@ -25,6 +25,7 @@
 #include "drives.h"
 
 #include <cerrno>
+#include <cinttypes>
 #include <climits>
 #include <cstdio>
 #include <ctime>
@@ -45,6 +46,90 @@
 #include "string_utils.h"
 #include "cross.h"
 #include "inout.h"
+#include "timer.h"
+#include "tracy.h"
+
+// How long a failed host filesystem probe is remembered. Long enough to
+// absorb the bursts of probes DOS programs issue for nonexistent files,
+// short enough that files created outside the emulator show up promptly.
+constexpr int64_t NegativeProbeTtlMs = 500;
+
+// Freelist pool backing localFile allocations. Guest build and install
+// workloads open and close files millions of times, and each open used to
+// cost a heap round trip for the object alone. The pool's high-water mark
+// is bounded by the DOS open-file limit, so it stays tiny. The DOS layer
+// is single-threaded, so no locking is needed.
+union LocalFileSlot {
+	LocalFileSlot* next_free;
+	alignas(localFile) char storage[sizeof(localFile)];
+};
+
+static LocalFileSlot* local_file_free_list = nullptr;
+
+void* localFile::operator new(const size_t size)
+{
+	// Derived classes (e.g. OverlayFile) have their own size and take
+	// the regular heap path
+	if (size != sizeof(localFile)) {
+		return ::operator new(size);
+	}
+	if (local_file_free_list) {
+		const auto slot      = local_file_free_list;
+		local_file_free_list = slot->next_free;
+		return slot;
+	}
+	return ::operator new(sizeof(LocalFileSlot));
+}
+
+void localFile::operator delete(void* ptr, const size_t size) noexcept
+{
+	if (!ptr) {
+		return;
+	}
+	if (size != sizeof(localFile)) {
+		::operator delete(ptr);
+		return;
+	}
+	const auto slot      = static_cast<LocalFileSlot*>(ptr);
+	slot->next_free      = local_file_free_list;
+	local_file_free_list = slot;
+}
+
+bool localDrive::IsCachedNegativeProbe(const std::string& dos_name)
+{
+	const auto it = negative_probe_cache.find(dos_name);
+	if (it == negative_probe_cache.end()) {
+		return false;
+	}
+	if (GetTicksSince(it->second) > NegativeProbeTtlMs) {
+		negative_probe_cache.erase(it);
+		return false;
+	}
+	++negative_probe_hits;
+	return true;
+}
+
+void localDrive::CacheNegativeProbe(const std::string& dos_name)
+{
+	negative_probe_cache[dos_name] = GetTicks();
+}
+
+void localDrive::ForgetNegativeProbe(const std::string& dos_name)
+{
+	negative_probe_cache.erase(dos_name);
+}
+
+void localDrive::EmptyCache()
+{
+	if (negative_probe_hits > 0) {
+		LOG_MSG("FILESYSTEM: Negative probe cache absorbed %" PRIu64
+		        " host lookups under '%s'",
+		        negative_probe_hits, basedir);
+		negative_probe_hits = 0;
+	}
+	negative_probe_cache.clear();
+	dirCache.EmptyCache();
+}
 
 bool localDrive::FileCreate(DOS_File** file, char* name, FatAttributeFlags attributes)
 {
@@ -81,6 +166,10 @@ bool localDrive::FileCreate(DOS_File** file, char* name, FatAttributeFlags attri
 		dirCache.AddEntry(newname, true);
 	}
 
+	// The file exists now; drop any remembered failed probes for it
+	ForgetNegativeProbe(name);
+	ForgetNegativeProbe(expanded_name);
+
 	// Make the 16 bit device information
 	*file = new localFile(name, expanded_name, file_pointer, basedir);
 
@@ -125,6 +214,7 @@ DOS_File *FindOpenFile(const DOS_Drive *drive, const char *name)
 
 bool localDrive::FileOpen(DOS_File **file, char *name, uint32_t flags)
 {
+	ZoneScoped;
 	const char *type = nullptr;
 	switch (flags&0xf) {
 	case OPEN_READ:        type = "rb" ; break;
@@ -136,6 +226,13 @@ bool localDrive::FileOpen(DOS_File **file, char *name, uint32_t flags)
 		return false;
 	}
 
+	// Skip the host filesystem entirely when this path recently failed
+	// to resolve
+	if (IsCachedNegativeProbe(name)) {
+		DOS_SetError(DOSERR_INVALID_HANDLE);
+		return false;
+	}
+
 	// Don't allow opening read-only files in write mode,
 	// unless configured otherwise
 	FatAttributeFlags test_attr = {};
@@ -225,6 +322,9 @@ bool localDrive::FileOpen(DOS_File **file, char *name, uint32_t flags)
 #endif
 
 	if (!fhandle) {
+		if (errno == ENOENT) {
+			CacheNegativeProbe(name);
+		}
 		DOS_SetError(DOSERR_INVALID_HANDLE);
 		return false;
 	}
@@ -317,6 +417,9 @@ bool localDrive::FindFirst(char* _dir, DOS_DTA& dta, bool fcb_findfirst)
 		EmptyCache(); //rescan floppie-content on each findfirst
 	}
 
+	// Pick up host-side changes before handing out a listing
+	PollHostWatch();
+
 	// End the temp directory with a slash
 	const auto temp_dir_len = strlen(tempDir);
 	if (temp_dir_len < 1 || tempDir[temp_dir_len - 1] != CROSS_FILESPLIT) {
@@ -329,6 +432,12 @@ bool localDrive::FindFirst(char* _dir, DOS_DTA& dta, bool fcb_findfirst)
 		DOS_SetError(DOSERR_PATH_NOT_FOUND);
 		return false;
 	}
+	// Watch every directory the guest lists, so host-side changes to it
+	// invalidate the cached listing (per-directory watch hosts only)
+	if (host_watch) {
+		fs_watch_add_dir(host_watch,
+		                 dirCache.GetExpandNameAndNormaliseCase(tempDir));
+	}
 	safe_strcpy(srchInfo[id].srch_dir, tempDir);
 	dta.SetDirID(id);
 
@@ -543,7 +652,10 @@ bool localDrive::Rename(char* oldname, char* newname)
 	safe_strcat(newnew, newname);
 	CROSS_FILENAME(newnew);
 	int temp = rename(newold, dirCache.GetExpandNameAndNormaliseCase(newnew));
-	if (temp==0) dirCache.CacheOut(newnew);
+	if (temp==0) {
+		dirCache.CacheOut(newnew);
+		ForgetNegativeProbe(newname);
+	}
 	return (temp == 0);
 }
 
@@ -559,13 +671,19 @@ bool localDrive::AllocationInfo(uint16_t* _bytes_sector, uint8_t* _sectors_clust
 
 bool localDrive::FileExists(const char* name)
 {
+	if (IsCachedNegativeProbe(name)) {
+		return false;
+	}
 	char newname[CROSS_LEN];
 	safe_strcpy(newname, basedir);
 	safe_strcat(newname, name);
 	CROSS_FILENAME(newname);
 	dirCache.ExpandNameAndNormaliseCase(newname);
 	struct stat temp_stat;
-	if (stat(newname,&temp_stat)!=0) return false;
+	if (stat(newname,&temp_stat)!=0) {
+		CacheNegativeProbe(name);
+		return false;
+	}
 	if (temp_stat.st_mode & S_IFDIR) return false;
 	return true;
 }
@@ -630,6 +748,30 @@ localDrive::localDrive(const char* startdir, uint16_t _bytes_sector,
 	safe_strcpy(basedir, startdir);
 	safe_strcpy(info, startdir);
 	dirCache.SetBaseDir(basedir);
+	host_watch = fs_watch_open(basedir);
+}
+
+localDrive::~localDrive()
+{
+	fs_watch_close(host_watch);
+}
+
+// Apply host-side changes reported by the native watch: drop just the
+// affected directory listings instead of waiting for a manual RESCAN
+void localDrive::PollHostWatch()
+{
+	if (!host_watch) {
+		return;
+	}
+	const auto changed_dirs = fs_watch_poll(host_watch);
+	if (changed_dirs.empty()) {
+		return;
+	}
+	for (const auto& dir : changed_dirs) {
+		dirCache.CacheOut(dir.c_str());
+	}
+	// new host files may resolve probes that recently failed
+	negative_probe_cache.clear();
 }
 
 // Updates the internal file's current position
@@ -671,6 +813,7 @@ void localFile::fseek_and_check(int whence)
 //TODO Maybe use fflush, but that seemed to fuck up in visual c
 bool localFile::Read(uint8_t *data, uint16_t *size)
 {
+	ZoneScoped;
 	// check if the file is opened in write-only mode
 	if ((this->flags & 0xf) == OPEN_WRITE) {
 		DOS_SetError(DOSERR_ACCESS_DENIED);
@@ -713,6 +856,7 @@ bool localFile::Read(uint8_t *data, uint16_t *size)
 
 bool localFile::Write(uint8_t *data, uint16_t *size)
 {
+	ZoneScoped;
 	uint32_t lastflags = this->flags & 0xf;
 	if (lastflags == OPEN_READ || lastflags == OPEN_READ_NO_MOD) {	// check if file opened in read-only mode
 		DOS_SetError(DOSERR_ACCESS_DENIED);
@@ -874,10 +1018,10 @@ uint16_t localFile::GetInformation(void)
 	return read_only_medium ? 0x40 : 0;
 }
 
-localFile::localFile(const char* _name, const std_fs::path& path, FILE* handle,
+localFile::localFile(const char* _name, std_fs::path path, FILE* handle,
                      const char* _basedir)
         : fhandle(handle),
-          path(path),
+          path(std::move(path)),
           basedir(_basedir)
 {
 	open = true;
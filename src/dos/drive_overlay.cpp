@@ -207,9 +207,9 @@ bool Overlay_Drive::TestDir(char * dir) {
 
 class OverlayFile final : public localFile {
 public:
-	OverlayFile(const char* name, const std_fs::path& path, FILE* handle,
+	OverlayFile(const char* name, std_fs::path path, FILE* handle,
 	            const char* basedir)
-	        : localFile(name, path, handle, basedir),
+	        : localFile(name, std::move(path), handle, basedir),
 	          overlay_active(false)
 	{
 		if (logoverlay)
@@ -321,9 +321,16 @@ bool OverlayFile::create_copy() {
 	}
  
 	if (!newhandle) return false;
-	char buffer[BUFSIZ];
-	size_t s;
-	while ( (s = fread(buffer,1,BUFSIZ,lhandle)) != 0 ) fwrite(buffer, 1, s, newhandle);
+
+	// Hosts with reflink or server-side copy support clone the base file
+	// without pushing its contents through the process, so the first
+	// write to a large base file no longer stalls the guest; otherwise
+	// fall back to the buffered copy.
+	if (!local_drive_clone_file(lhandle, newhandle)) {
+		char buffer[BUFSIZ];
+		size_t s;
+		while ( (s = fread(buffer,1,BUFSIZ,lhandle)) != 0 ) fwrite(buffer, 1, s, newhandle);
+	}
 	fclose(lhandle);
 
 	//Set copied file handle to position of the old one
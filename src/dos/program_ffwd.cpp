@@ -0,0 +1,95 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "program_ffwd.h"
+
+#include <cmath>
+#include <string>
+
+#include "dosbox.h"
+#include "program_more_output.h"
+#include "support.h"
+
+void FFWD::Run()
+{
+	if (HelpRequested()) {
+		MoreOutputStrings output(*this);
+		output.AddString(MSG_Get("PROGRAM_FFWD_HELP_LONG"));
+		output.Display();
+		return;
+	}
+
+	if (cmd->FindExist("/off")) {
+		DOSBOX_SetFastForwardMode(false);
+		WriteOut(MSG_Get("PROGRAM_FFWD_DISENGAGED"));
+		return;
+	}
+
+	if (!cmd->FindCommand(1, temp_line)) {
+		WriteOut(MSG_Get(DOSBOX_IsFastForwardMode()
+		                         ? "PROGRAM_FFWD_STATUS_ON"
+		                         : "PROGRAM_FFWD_STATUS_OFF"));
+		return;
+	}
+
+	constexpr auto max_seconds = 60.0 * 60.0; // one emulated hour
+
+	const auto seconds = to_finite<double>(temp_line);
+	if (!std::isfinite(seconds) || seconds <= 0 || seconds > max_seconds) {
+		WriteOut(MSG_Get("PROGRAM_FFWD_INVALID_SECONDS"), temp_line.c_str());
+		return;
+	}
+
+	const auto emulated_ms = static_cast<uint32_t>(seconds * 1000);
+	DOSBOX_SetFastForwardMode(true, emulated_ms);
+	WriteOut(MSG_Get("PROGRAM_FFWD_ENGAGED"), seconds);
+}
+
+void FFWD::AddMessages()
+{
+	MSG_Add("PROGRAM_FFWD_HELP_LONG",
+	        "Fast-forward the emulated machine through a stretch of time.\n"
+	        "\n"
+	        "Usage:\n"
+	        "  [color=light-green]ffwd[reset] [color=light-cyan]SECONDS[reset]\n"
+	        "  [color=light-green]ffwd[reset] /off\n"
+	        "\n"
+	        "Parameters:\n"
+	        "  [color=light-cyan]SECONDS[reset]  emulated time to skip ahead, up to one hour\n"
+	        "\n"
+	        "Notes:\n"
+	        "  - While fast-forwarding, the CPU is unthrottled and video and audio\n"
+	        "    presentation are skipped; the machine state still advances normally.\n"
+	        "  - Normal presentation resumes by itself once the requested emulated\n"
+	        "    time has passed, or immediately with the /off option.\n"
+	        "  - Useful in scripted runs (for example with [color=light-green]autotype[reset]) to reach a\n"
+	        "    later point of a game quickly.\n"
+	        "\n"
+	        "Examples:\n"
+	        "  [color=light-green]ffwd[reset] [color=light-cyan]600[reset]   ; skip ahead ten emulated minutes\n"
+	        "  [color=light-green]ffwd[reset] /off\n");
+	MSG_Add("PROGRAM_FFWD_ENGAGED",
+	        "Fast-forwarding %.1f emulated seconds.\n");
+	MSG_Add("PROGRAM_FFWD_DISENGAGED", "Fast-forward off.\n");
+	MSG_Add("PROGRAM_FFWD_STATUS_ON", "Fast-forward is engaged.\n");
+	MSG_Add("PROGRAM_FFWD_STATUS_OFF", "Fast-forward is not engaged.\n");
+	MSG_Add("PROGRAM_FFWD_INVALID_SECONDS",
+	        "Invalid number of seconds: '%s'\n");
+}
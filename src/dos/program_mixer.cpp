@@ -744,6 +744,10 @@ void MIXER::Run()
 		MIDI_ListAll(this);
 		return;
 	}
+	if (cmd->FindExist("/STATS")) {
+		ShowChannelStats();
+		return;
+	}
 
 	constexpr auto remove = true;
 	auto show_status      = !cmd->FindExist("/NOSHOW", remove);
@@ -800,6 +804,7 @@ void MIXER::AddMessages()
 	        "Usage:\n"
 	        "  [color=light-green]mixer[reset] [color=light-cyan][CHANNEL][reset] [color=white]COMMANDS[reset] [/noshow]\n"
 	        "  [color=light-green]mixer[reset] [/listmidi]\n"
+	        "  [color=light-green]mixer[reset] [/stats]\n"
 	        "\n"
 	        "Parameters:\n"
 	        "  [color=light-cyan]CHANNEL[reset]   mixer channel to change the settings of\n"
@@ -815,6 +820,8 @@ void MIXER::AddMessages()
 	        "Notes:\n"
 	        "  - Run [color=light-green]mixer[reset] without arguments to view the current settings.\n"
 	        "  - Run [color=light-green]mixer[reset] /listmidi to list all available MIDI devices.\n"
+	        "  - Run [color=light-green]mixer[reset] /stats to show how much time each channel spends in the\n"
+	        "    mixer, as a smoothed average per mixed block.\n"
 	        "  - You may change the settings of more than one channel in a single command.\n"
 	        "  - If no channel is specified, you can set crossfeed, reverb, or chorus\n"
 	        "    of all channels globally.\n"
@@ -899,6 +906,9 @@ void MIXER::AddMessages()
 	MSG_Add("SHELL_CMD_MIXER_INVALID_CHANNEL_COMMAND",
 	        "Invalid command for the [color=light-cyan]%s[reset] channel: "
 	        "[color=white]%s[reset]");
+
+	MSG_Add("SHELL_CMD_MIXER_STATS_HEADER",
+	        "[color=white]Channel                  Rate  State  Avg mix time (us)[reset]");
 }
 
 void MIXER::ShowMixerStatus()
@@ -987,3 +997,22 @@ void MIXER::ShowMixerStatus()
 
 	MIXER_UnlockAudioDevice();
 }
+
+void MIXER::ShowChannelStats()
+{
+	// Plain space-separated columns so the output is easy to both read
+	// and parse
+	WriteOut("%s\n", MSG_Get("SHELL_CMD_MIXER_STATS_HEADER"));
+
+	MIXER_LockAudioDevice();
+
+	for (auto& [name, chan] : MIXER_GetChannels()) {
+		WriteOut("%-22s %6u  %-5s %18.1f\n",
+		         name.c_str(),
+		         chan->GetSampleRate(),
+		         chan->is_enabled ? "on" : "off",
+		         chan->GetAvgMixTimeMicros());
+	}
+
+	MIXER_UnlockAudioDevice();
+}
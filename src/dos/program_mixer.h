@@ -154,6 +154,7 @@ public:
 
 private:
 	void ShowMixerStatus();
+	void ShowChannelStats();
 
 	static void AddMessages();
 };
@@ -735,6 +735,7 @@ void MoreOutputFiles::DisplayInputStream()
 	// Since this CAN be STDIN input (there is no way to check),
 	// CTRL+C shall quit
 	should_end_on_ctrl_c = true;
+	input_is_device      = true;
 	ClearScreenIfRequested();
 	DisplaySingleStream();
 }
@@ -806,6 +807,10 @@ void MoreOutputFiles::DisplayInputFiles()
 		// If input from a device, CTRL+C shall quit
 		should_end_on_ctrl_c = input_file.is_device;
 
+		input_is_device  = input_file.is_device;
+		read_buffer_used = 0;
+		read_buffer_pos  = 0;
+
 		const auto decision = DisplaySingleStream();
 		DOS_CloseFile(input_handle);
 		if (decision == UserDecision::Cancel) {
@@ -836,13 +841,29 @@ bool MoreOutputFiles::GetCharacterRaw(char& code, bool& is_last_character)
 	// our 'end of input' message displayed at the end.
 	is_last_character = false;
 
-	uint16_t count = 1;
-	DOS_ReadFile(input_handle, reinterpret_cast<uint8_t *>(&code), &count);
+	if (input_is_device) {
+		uint16_t count = 1;
+		DOS_ReadFile(input_handle, reinterpret_cast<uint8_t *>(&code), &count);
+
+		if (!count) {
+			return false; // end of stream
+		}
+
+		return true;
+	}
+
+	// Regular file - serve the characters from block-sized reads
+	if (read_buffer_pos == read_buffer_used) {
+		read_buffer_used = ReadBufferSize;
+		read_buffer_pos  = 0;
+		DOS_ReadFile(input_handle, read_buffer.data(), &read_buffer_used);
 
-	if (!count) {
-		return false; // end of stream
+		if (!read_buffer_used) {
+			return false; // end of file
+		}
 	}
 
+	code = static_cast<char>(read_buffer[read_buffer_pos++]);
 	return true;
 }
 
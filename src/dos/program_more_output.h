@@ -23,6 +23,7 @@
 
 #include "programs.h"
 
+#include <array>
 #include <string>
 
 // ***************************************************************************
@@ -180,6 +181,16 @@ private:
 
 	std::vector<InputFile> input_files = {};
 	uint16_t input_handle = 0; // DOS handle of the input stream
+
+	// Block-buffered reads for regular files; devices (like STDIN) are
+	// still read one byte at a time, as a block read could stall waiting
+	// for input that never comes
+	static constexpr uint16_t ReadBufferSize = 4096;
+
+	std::array<uint8_t, ReadBufferSize> read_buffer = {};
+	uint16_t read_buffer_used = 0;
+	uint16_t read_buffer_pos  = 0;
+	bool input_is_device      = true;
 };
 
 // ***************************************************************************
@@ -291,28 +291,28 @@ bool TREE::DisplayTree(MoreOutputStrings& output, const std::string& path,
 	flags.hidden    = true;
 	flags.directory = true;
 
-	bool has_next_entry = DOS_FindFirst(pattern.c_str(), flags._data);
+	std::vector<DOS_DTA::Result> found_entries = {};
+	if (DOS_FindFirst(pattern.c_str(), flags._data)) {
+		DOS_FindAllRemaining(found_entries);
+	}
 	size_t space_needed = 7; // length of indentation + ellipsis
 
-	while (!shutdown_requested && has_next_entry) {
-		DOS_DTA::Result result = {};
-
-		const DOS_DTA dta(dos.dta());
-		dta.GetResult(result);
+	for (auto& result : found_entries) {
+		if (shutdown_requested) {
+			break;
+		}
 		assert(!result.name.empty());
 
-		has_next_entry = DOS_FindNext();
-
 		if (!should_display(result)) {
 			continue;
 		}
 
 		space_needed = std::max(space_needed, result.name.size());
 
-		dir_contents.emplace_back(result);
 		if (result.IsDirectory()) {
 			++num_subdirs;
 		}
+		dir_contents.emplace_back(std::move(result));
 
 		if (dir_contents.size() > MaxObjectsInDir) {
 			dos.dta(save_dta);
@@ -55,6 +55,7 @@
 #include "setup.h"
 #include "shell.h"
 #include "support.h"
+#include "telemetry.h"
 #include "timer.h"
 #include "tracy.h"
 #include "video.h"
@@ -88,6 +89,9 @@ void PCI_Init(Section*);
 void VOODOO_Init(Section*);
 void VIRTUALBOX_Init(Section*);
 void VMWARE_Init(Section*);
+void PERFCOUNTER_Init(Section*);
+void SNAPSHOT_Init(Section*);
+void EVENTLOG_Init(Section*);
 
 void KEYBOARD_Init(Section*);	//TODO This should setup INT 16 too but ok ;)
 void JOYSTICK_Init(Section*);
@@ -131,6 +135,8 @@ static int64_t ticksAdded;
 int64_t ticksDone;
 int64_t ticksScheduled;
 bool ticksLocked;
+static bool fastForwardMode = false;
+static uint32_t fastForwardUntil = 0; // PIC_Ticks target, 0 = no target
 void increaseticks();
 
 bool mono_cga=false;
@@ -146,9 +152,14 @@ static Bitu Normal_Loop() {
 			ret = (*cpudecoder)();
 			if (GCC_UNLIKELY(ret<0)) return 1;
 			if (ret>0) {
-				if (GCC_UNLIKELY(ret >= CB_MAX)) return 0;
-				Bitu blah = (*CallBack_Handlers[ret])();
-				if (GCC_UNLIKELY(blah)) return blah;
+				if (GCC_UNLIKELY(ret >= CB_MAX)) {
+					// Biased result of a handler a core ran inline
+					const Bitu blah = static_cast<Bitu>(ret) - CB_MAX;
+					if (blah) return blah;
+				} else {
+					Bitu blah = (*CallBack_Handlers[ret])();
+					if (GCC_UNLIKELY(blah)) return blah;
+				}
 			}
 #if C_DEBUG
 			if (DEBUG_ExitLoop()) return 0;
@@ -167,6 +178,10 @@ static Bitu Normal_Loop() {
 void increaseticks() { //Make it return ticksRemain and set it in the function above to remove the global variable.
 	ZoneScoped;
 	if (GCC_UNLIKELY(ticksLocked)) { // For Fast Forward Mode
+		if (fastForwardUntil && PIC_Ticks >= fastForwardUntil) {
+			LOG_MSG("DOSBOX: Fast-forward target reached");
+			DOSBOX_SetFastForwardMode(false);
+		}
 		ticksRemain=5;
 		/* Reset any auto cycle guessing for this frame */
 		ticksLast = GetTicks();
@@ -185,8 +200,12 @@ void increaseticks() { //Make it return ticksRemain and set it in the function a
 
 		static int64_t cumulativeTimeSlept = 0;
 
-		constexpr auto sleepDuration = std::chrono::microseconds(1000);
-		std::this_thread::sleep_for(sleepDuration);
+		// Sleep to the absolute start of the next emulated millisecond
+		// rather than for a relative millisecond: the OS wait then
+		// carries the sub-millisecond remainder instead of quantizing
+		// it away, so frame and audio margins don't inherit the jitter
+		constexpr int64_t nanoseconds_per_tick = 1'000'000;
+		DelayUntilTicksNs((ticksNew + 1) * nanoseconds_per_tick);
 
 		const auto timeslept = GetTicksUsSince(ticksNewUs);
 
@@ -270,6 +289,24 @@ void increaseticks() { //Make it return ticksRemain and set it in the function a
 
 		if (new_cmax < CPU_CYCLES_LOWER_LIMIT)
 			new_cmax = CPU_CYCLES_LOWER_LIMIT;
+
+		/* Feedback from the mixer: when the audio buffer has drained
+		   below its low watermark the host is already falling behind,
+		   so back off right away instead of waiting for the underrun
+		   to show up in the tick timing. Increases are held back until
+		   the buffer has refilled up to the high watermark. */
+		const auto audio_level = MIXER_GetBufferLevel();
+		if (audio_level == AudioBufferLevel::BelowLowWatermark) {
+			int32_t backed_off = (CPU_CycleMax / 10) * 9;
+			if (backed_off < CPU_CYCLES_LOWER_LIMIT)
+				backed_off = CPU_CYCLES_LOWER_LIMIT;
+			if (new_cmax > backed_off)
+				new_cmax = backed_off;
+			CPU_CycleMax = new_cmax;
+		} else if (audio_level == AudioBufferLevel::BetweenWatermarks &&
+		           new_cmax > CPU_CycleMax) {
+			new_cmax = CPU_CycleMax;
+		}
 		/*
 		LOG_INFO("cyclelog: current %06d   cmax %06d   ratio  %05d  done %03d   sched %03d Add %d rr %4.2f",
 			CPU_CycleMax,
@@ -341,9 +378,26 @@ static void DOSBOX_UnlockSpeed( bool pressed ) {
 			autoadjust = false;
 			CPU_CycleAutoAdjust = true;
 		}
+		// Releasing the speedlock also cancels a scripted fast-forward
+		fastForwardMode  = false;
+		fastForwardUntil = 0;
 	}
 }
 
+void DOSBOX_SetFastForwardMode(const bool enabled, const uint32_t max_emulated_ms)
+{
+	fastForwardMode  = enabled;
+	fastForwardUntil = (enabled && max_emulated_ms)
+	                         ? PIC_Ticks + max_emulated_ms
+	                         : 0;
+	DOSBOX_UnlockSpeed(enabled);
+}
+
+bool DOSBOX_IsFastForwardMode()
+{
+	return fastForwardMode;
+}
+
 void DOSBOX_SetMachineTypeFromConfig(Section_prop* section)
 {
 	const auto arguments = &control->arguments;
@@ -402,6 +456,17 @@ static void DOSBOX_RealInit(Section* sec)
 
 	DOSBOX_SetMachineTypeFromConfig(section);
 
+	if (section->Get_bool("async_logging")) {
+		LOG_StartAsync();
+	} else {
+		LOG_StopAsync();
+	}
+
+	const auto telemetry_socket = section->Get_string("telemetry_socket");
+	if (!telemetry_socket.empty()) {
+		TELEMETRY_StartServer(telemetry_socket);
+	}
+
 	// Set the user's prefered MCB fault handling strategy
 	DOS_SetMcbFaultStrategy(section->Get_string("mcb_fault_strategy").c_str());
 
@@ -585,6 +650,39 @@ void DOSBOX_Init()
 	        "Please file a bug with the project if you find a game that fails\n"
 	        "when this is enabled so we will list them here.");
 
+	pbool = secprop->Add_bool("pit_irq_batching", only_at_start, false);
+	pbool->Set_help(
+	        "Deliver multi-kHz timer (PIT channel 0) interrupts in batches\n"
+	        "per host timer event instead of scheduling one event per period\n"
+	        "(disabled by default). Every interrupt is still delivered and\n"
+	        "counter reads stay exact, but the interrupts of one batch arrive\n"
+	        "back-to-back, so it only engages while the guest's timer handler\n"
+	        "is measured to be trivial. Cuts the host CPU cost of titles that\n"
+	        "program the timer to very high rates.");
+
+	pbool = secprop->Add_bool("async_logging", only_at_start, false);
+	pbool->Set_help(
+	        "Queue log messages and write them out from a background thread\n"
+	        "(disabled by default). Keeps chatty device logging from disturbing\n"
+	        "emulation timing, at the cost of slightly delayed and approximately\n"
+	        "ordered output. Messages logged before startup finishes are written\n"
+	        "out directly.");
+
+	pbool = secprop->Add_bool("mergeable_memory", only_at_start, false);
+	pbool->Set_help(
+	        "Advise the kernel that guest RAM and video memory may be merged\n"
+	        "with identical pages of other processes (disabled by default).\n"
+	        "Reduces the aggregate memory footprint when many instances run\n"
+	        "the same titles on one Linux host with KSM enabled; no effect on\n"
+	        "other platforms. Merged pages are unshared again when written.");
+
+	pstring = secprop->Add_string("telemetry_socket", only_at_start, "");
+	pstring->Set_help(
+	        "Path of a Unix domain socket serving a JSON snapshot of runtime\n"
+	        "stats (cycles, frame and audio counters, dynamic core cache use)\n"
+	        "to each connection (unset by default). Intended for external\n"
+	        "monitoring; has no effect on Windows.");
+
 	secprop->AddInitFunction(&CALLBACK_Init);
 	secprop->AddInitFunction(&PIC_Init);
 	secprop->AddInitFunction(&PROGRAMS_Init);
@@ -700,6 +798,42 @@ void DOSBOX_Init()
 	pint->Set_help("Number of cycles subtracted with the decrease cycles hotkey (20 by default).\n"
 	               "Setting it lower than 100 will be a percentage.");
 
+	pbool = secprop->Add_bool("cycle_profiles", only_at_start, true);
+	pbool->Set_help(
+	        "Remember the converged auto cycles value per launched executable and restore\n"
+	        "it the next time the same program is started (enabled by default).\n"
+	        "Skips the initial period of cycle guessing when 'cycles' is set to 'max'.");
+
+	pbool = secprop->Add_bool("dynamic_core_warmup", only_at_start, false);
+	pbool->Set_help(
+	        "Remember which code locations the dynamic cores translated and batch-translate\n"
+	        "them again on the next run of the same program (disabled by default).\n"
+	        "Shortens the warm-up period when repeatedly booting the same title.");
+
+	pint = secprop->Add_int("sampling_profiler", always, 0);
+	pint->SetMinMax(0, 10000);
+	pint->Set_help(
+	        "Sample the guest's CS:IP at this rate in Hz into a histogram tagged\n"
+	        "with the active CPU core (0 by default, meaning disabled). The\n"
+	        "histogram is written to 'profile.folded' on exit, in the collapsed\n"
+	        "format flamegraph tools accept; the debugger's PROFDUMP command\n"
+	        "writes it on demand. Cheap enough to leave on for slow-title reports.");
+
+	const char* host_idle_values[] = {"off", "auto", "aggressive", nullptr};
+	pstring = secprop->Add_string("host_idle", always, "auto");
+	pstring->Set_values(host_idle_values);
+	pstring->Set_help(
+	        "Let the host CPU sleep while the guest is only waiting for input\n"
+	        "('auto' by default). The remainder of the current millisecond's cycle\n"
+	        "budget is skipped when the guest signals that it's idle, so the emulation\n"
+	        "loop sleeps until the next timer tick instead of spinning in the guest's\n"
+	        "wait loop.\n"
+	        "  off:         Keep executing wait loops at full speed (HLT still sleeps).\n"
+	        "  auto:        Skip while blocked in the BIOS keyboard wait (INT 16h).\n"
+	        "  aggressive:  Additionally treat each DOS idle interrupt (INT 28h) call\n"
+	        "               as an idle signal. TSRs hooked into it still run; only the\n"
+	        "               caller's busy loop is throttled.");
+
 #if C_FPU
 	secprop->AddInitFunction(&FPU_Init);
 #endif
@@ -729,6 +863,13 @@ void DOSBOX_Init()
 	pbool = secprop->Add_bool("voodoo_multithreading", only_at_start, true);
 	pbool->Set_help("Use threads to improve 3dfx Voodoo performance (enabled by default).");
 
+	pint = secprop->Add_int("voodoo_threads", only_at_start, 0);
+	pint->SetMinMax(0, 15);
+	pint->Set_help(
+	        "Number of worker threads for 3dfx Voodoo rasterization, from 1 to 15\n"
+	        "(0 by default, which sizes the pool to the host's core count). Only used\n"
+	        "when 'voodoo_multithreading' is enabled.");
+
 	pbool = secprop->Add_bool("voodoo_bilinear_filtering", only_at_start, false);
 	pbool->Set_help(
 	        "Use bilinear filtering to emulate the 3dfx Voodoo's texture smoothing effect\n"
@@ -1158,6 +1299,41 @@ void DOSBOX_Init()
 	                  "A single number is treated as the major version.\n"
 	                  "Common settings are 3.3, 5.0, 6.22, and 7.1.");
 
+	pint = secprop->Add_int("disk_read_ahead_sectors", only_at_start, 8);
+	pint->SetMinMax(0, 64);
+	pint->Set_help(
+	        "Number of sectors to prefetch in the background when disk image or\n"
+	        "physical CD-ROM drive access turns sequential (8 by default).\n"
+	        "Set to 0 to disable read-ahead.");
+
+	pint = secprop->Add_int("disk_flush_interval_ms", only_at_start, 100);
+	pint->SetMinMax(0, 5000);
+	pint->Set_help(
+	        "How many milliseconds to hold guest disk image writes before flushing them\n"
+	        "to the host (100 by default), so repeated writes to the same sectors\n"
+	        "coalesce. Cached writes are also flushed when the guest closes a file or\n"
+	        "resets the disk system. Set to 0 to write through immediately.");
+
+	pint = secprop->Add_int("cdda_buffer_ms", only_at_start, 150);
+	pint->SetMinMax(50, 1000);
+	pint->Set_help(
+	        "How many milliseconds of CD audio to decode ahead of playback\n"
+	        "(150 by default). A background thread keeps this buffer filled, so\n"
+	        "slow image reads cannot interrupt CD audio playback.");
+
+	pbool = secprop->Add_bool("fast_console_output", only_at_start, true);
+	pbool->Set_help(
+	        "Write runs of printable console output into video memory as a block with a\n"
+	        "single cursor update (enabled by default). Automatically bypassed when a\n"
+	        "program hooks INT 10h, so TSRs still see every character. Disable for\n"
+	        "programs that depend on per-character output timing.");
+
+	pbool = secprop->Add_bool("batch_file_cache", only_at_start, true);
+	pbool->Set_help(
+	        "Read each batch file into memory once and run it from there (enabled by\n"
+	        "default), instead of re-reading it through the DOS file layer for every\n"
+	        "line. Disable for batch files that modify themselves while running.");
+
 	// DOS locale settings
 
 	secprop->AddInitFunction(&DOS_Locale_Init, changeable_at_runtime);
@@ -1285,6 +1461,9 @@ void DOSBOX_Init()
 	// VMM interfaces
 	secprop->AddInitFunction(&VIRTUALBOX_Init);
 	secprop->AddInitFunction(&VMWARE_Init);
+	secprop->AddInitFunction(&PERFCOUNTER_Init);
+	secprop->AddInitFunction(&SNAPSHOT_Init);
+	secprop->AddInitFunction(&EVENTLOG_Init);
 
 	//TODO ?
 	control->AddSection_line("autoexec", &AUTOEXEC_Init);
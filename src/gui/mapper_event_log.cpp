@@ -0,0 +1,298 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "mapper_event_log.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../capture/capture.h"
+#include "byteorder.h"
+#include "checks.h"
+#include "mapper.h"
+#include "pic.h"
+#include "setup.h"
+#include "support.h"
+
+CHECK_NARROWING();
+
+// Log format: a 6-byte header (magic plus version), then one record per
+// fired event. All fields are little-endian:
+//
+//   u64  timestamp       emulated microseconds since machine start
+//   i32  value           event value (axis position, 0x7fff for keys)
+//   u8   active          1 = activated, 0 = deactivated
+//   u8   name_len        length of the event name that follows
+//   u8[] name            mapper event name, not NUL-terminated
+
+static constexpr char log_magic[4] = {'D', 'B', 'E', 'L'};
+
+static constexpr uint16_t log_version = 1;
+
+struct LoggedEvent {
+	uint64_t timestamp_us = 0;
+	int32_t value         = 0;
+	bool active           = false;
+	std::string name      = {};
+};
+
+static struct {
+	FILE* record_file = nullptr;
+
+	std::vector<LoggedEvent> replay_events = {};
+	size_t replay_pos                      = 0;
+
+	// Emulated microseconds subtracted from each record's timestamp so
+	// replay starts with the first event's delay relative to 'now'
+	uint64_t replay_base_us = 0;
+	uint64_t replay_start_us = 0;
+
+	// Path of the last recording, so the replay hotkey can play it back
+	std_fs::path last_log_path = {};
+} state = {};
+
+static uint64_t emulated_time_us()
+{
+	return static_cast<uint64_t>(PIC_FullIndex() * 1000.0);
+}
+
+void EVENTLOG_RecordEvent(const char* event_name, const bool active,
+                          const int32_t value)
+{
+	if (!state.record_file) {
+		return;
+	}
+
+	const auto name_len = std::strlen(event_name);
+	assert(name_len <= UINT8_MAX);
+
+	const auto timestamp = host_to_le64(emulated_time_us());
+	const auto le_value  = host_to_le32(static_cast<uint32_t>(value));
+
+	const uint8_t active_byte = (active ? 1 : 0);
+	const auto name_len_byte  = static_cast<uint8_t>(name_len);
+
+	fwrite(&timestamp, sizeof(timestamp), 1, state.record_file);
+	fwrite(&le_value, sizeof(le_value), 1, state.record_file);
+	fwrite(&active_byte, sizeof(active_byte), 1, state.record_file);
+	fwrite(&name_len_byte, sizeof(name_len_byte), 1, state.record_file);
+	fwrite(event_name, name_len, 1, state.record_file);
+}
+
+static void start_recording()
+{
+	const auto index = get_next_capture_index(CaptureType::MapperEventLog);
+	const auto path = generate_capture_filename(CaptureType::MapperEventLog,
+	                                            index);
+
+	state.record_file = CAPTURE_CreateFile(CaptureType::MapperEventLog, path);
+	if (!state.record_file) {
+		return;
+	}
+
+	fwrite(log_magic, sizeof(log_magic), 1, state.record_file);
+	const auto version = host_to_le16(log_version);
+	fwrite(&version, sizeof(version), 1, state.record_file);
+
+	state.last_log_path = path;
+	LOG_MSG("EVENTLOG: Recording mapper events");
+}
+
+static void stop_recording()
+{
+	fclose(state.record_file);
+	state.record_file = nullptr;
+	LOG_MSG("EVENTLOG: Recording stopped");
+}
+
+static bool parse_log_file(const std_fs::path& path, std::vector<LoggedEvent>& events)
+{
+	FILE* infile = fopen(path.string().c_str(), "rb");
+	if (!infile) {
+		LOG_WARNING("EVENTLOG: Cannot open event log '%s'",
+		            path.string().c_str());
+		return false;
+	}
+
+	auto read_failed = [&] {
+		LOG_WARNING("EVENTLOG: Event log '%s' is malformed",
+		            path.string().c_str());
+		fclose(infile);
+		return false;
+	};
+
+	char magic[sizeof(log_magic)] = {};
+	uint16_t version              = 0;
+
+	if (fread(magic, sizeof(magic), 1, infile) != 1 ||
+	    std::memcmp(magic, log_magic, sizeof(magic)) != 0) {
+		return read_failed();
+	}
+	if (fread(&version, sizeof(version), 1, infile) != 1 ||
+	    le16_to_host(version) != log_version) {
+		return read_failed();
+	}
+
+	uint64_t timestamp = 0;
+	while (fread(&timestamp, sizeof(timestamp), 1, infile) == 1) {
+		uint32_t value       = 0;
+		uint8_t active_byte  = 0;
+		uint8_t name_len     = 0;
+		char name[UINT8_MAX] = {};
+
+		if (fread(&value, sizeof(value), 1, infile) != 1 ||
+		    fread(&active_byte, sizeof(active_byte), 1, infile) != 1 ||
+		    fread(&name_len, sizeof(name_len), 1, infile) != 1 ||
+		    (name_len > 0 && fread(name, name_len, 1, infile) != 1)) {
+			return read_failed();
+		}
+
+		LoggedEvent event = {};
+		event.timestamp_us = le64_to_host(timestamp);
+		event.value  = static_cast<int32_t>(le32_to_host(value));
+		event.active = (active_byte != 0);
+		event.name.assign(name, name_len);
+		events.emplace_back(std::move(event));
+	}
+
+	fclose(infile);
+	return true;
+}
+
+static void replay_tick(uint32_t)
+{
+	const auto now_us = emulated_time_us() - state.replay_start_us;
+
+	auto& events = state.replay_events;
+
+	while (state.replay_pos < events.size() &&
+	       events[state.replay_pos].timestamp_us - state.replay_base_us <= now_us) {
+		const auto& event = events[state.replay_pos];
+		MAPPER_InjectEvent(event.name, event.active, event.value);
+		++state.replay_pos;
+	}
+
+	if (state.replay_pos < events.size()) {
+		const auto next_us = events[state.replay_pos].timestamp_us -
+		                     state.replay_base_us;
+		const auto delay_ms = static_cast<double>(next_us - now_us) / 1000.0;
+		PIC_AddEvent(replay_tick, delay_ms);
+	} else {
+		events.clear();
+		state.replay_pos = 0;
+		LOG_MSG("EVENTLOG: Replay finished");
+	}
+}
+
+bool EVENTLOG_Replay(const std_fs::path& path)
+{
+	if (EVENTLOG_IsReplaying()) {
+		LOG_WARNING("EVENTLOG: Replay already in progress");
+		return false;
+	}
+
+	std::vector<LoggedEvent> events = {};
+	if (!parse_log_file(path, events)) {
+		return false;
+	}
+	if (events.empty()) {
+		LOG_WARNING("EVENTLOG: Event log '%s' contains no events",
+		            path.string().c_str());
+		return false;
+	}
+
+	state.replay_events = std::move(events);
+	state.replay_pos    = 0;
+
+	// Re-base the timestamps onto the first event so only the recorded
+	// inter-event spacing is reproduced; any lead-in between machine
+	// start and the first event is dropped
+	state.replay_base_us  = state.replay_events.front().timestamp_us;
+	state.replay_start_us = emulated_time_us();
+
+	PIC_AddEvent(replay_tick, 0.0);
+
+	LOG_MSG("EVENTLOG: Replaying %u events from '%s'",
+	        static_cast<uint32_t>(state.replay_events.size()),
+	        path.string().c_str());
+	return true;
+}
+
+bool EVENTLOG_IsReplaying()
+{
+	return !state.replay_events.empty();
+}
+
+static void record_handler(const bool pressed)
+{
+	if (!pressed) {
+		return;
+	}
+	if (state.record_file) {
+		stop_recording();
+	} else {
+		start_recording();
+	}
+}
+
+static void replay_handler(const bool pressed)
+{
+	if (!pressed) {
+		return;
+	}
+	if (state.record_file) {
+		// Replaying a log while recording it would feed the injected
+		// events straight back into the recording
+		LOG_WARNING("EVENTLOG: Cannot replay while recording");
+		return;
+	}
+	if (state.last_log_path.empty()) {
+		LOG_WARNING("EVENTLOG: Nothing recorded yet to replay");
+		return;
+	}
+	EVENTLOG_Replay(state.last_log_path);
+}
+
+void EVENTLOG_Destroy(Section*)
+{
+	if (state.record_file) {
+		stop_recording();
+	}
+	PIC_RemoveEvents(replay_tick);
+}
+
+void EVENTLOG_Init(Section* sec)
+{
+	sec->AddDestroyFunction(&EVENTLOG_Destroy, false);
+
+	// Unbound by default; assign keys through the mapper
+	MAPPER_AddHandler(record_handler,
+	                  SDL_SCANCODE_UNKNOWN,
+	                  0,
+	                  "evtrec",
+	                  "Rec. Events");
+	MAPPER_AddHandler(replay_handler,
+	                  SDL_SCANCODE_UNKNOWN,
+	                  0,
+	                  "evtplay",
+	                  "Play Events");
+}
@@ -0,0 +1,41 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DOSBOX_MAPPER_EVENT_LOG_H
+#define DOSBOX_MAPPER_EVENT_LOG_H
+
+#include <cstdint>
+
+#include "std_filesystem.h"
+
+// Records fired mapper events with emulated-time timestamps into a compact
+// append-only binary log (an '.evl' capture file), and replays such logs by
+// re-injecting the events at their recorded emulated times. Because replay
+// is driven by PIC events, it is tick-exact and independent of host speed.
+
+// Appends one event to the log; a no-op unless a recording is in progress
+void EVENTLOG_RecordEvent(const char* event_name, bool active, int32_t value);
+
+// Replays the given log file; returns false if it cannot be parsed
+bool EVENTLOG_Replay(const std_fs::path& path);
+
+bool EVENTLOG_IsReplaying();
+
+#endif // DOSBOX_MAPPER_EVENT_LOG_H
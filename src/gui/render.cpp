@@ -21,9 +21,11 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include "../capture/capture.h"
 #include "control.h"
@@ -79,10 +81,36 @@ static void check_palette(void)
 	}
 	Bitu i;
 	switch (render.scale.outMode) {
-	case scalerMode8: break;
+	case scalerMode8:
+		// Indexed output: the backend applies the palette itself, so
+		// just forward the new colours and force a frame refresh
+		for (i = render.pal.first; i <= render.pal.last; i++) {
+			if (!render.pal.dirty[i]) {
+				continue;
+			}
+			const uint32_t new_pal = (render.pal.rgb[i].red << 16) |
+			                         (render.pal.rgb[i].green << 8) |
+			                         (render.pal.rgb[i].blue << 0);
+			if (new_pal != render.pal.lut.b32[i]) {
+				render.pal.changed     = true;
+				render.pal.modified[i] = 1;
+				render.pal.lut.b32[i]  = new_pal;
+			}
+		}
+		if (render.pal.changed) {
+			// Only the written span needs re-uploading
+			const auto count = render.pal.last - render.pal.first + 1;
+			GFX_UpdatePalette((const uint8_t*)&render.pal.rgb[render.pal.first],
+			                  check_cast<uint16_t>(render.pal.first),
+			                  check_cast<uint16_t>(count));
+		}
+		break;
 	case scalerMode15:
 	case scalerMode16:
 		for (i = render.pal.first; i <= render.pal.last; i++) {
+			if (!render.pal.dirty[i]) {
+				continue;
+			}
 			uint8_t r = render.pal.rgb[i].red;
 			uint8_t g = render.pal.rgb[i].green;
 			uint8_t b = render.pal.rgb[i].blue;
@@ -98,6 +126,9 @@ static void check_palette(void)
 	case scalerMode32:
 	default:
 		for (i = render.pal.first; i <= render.pal.last; i++) {
+			if (!render.pal.dirty[i]) {
+				continue;
+			}
 			uint8_t r = render.pal.rgb[i].red;
 			uint8_t g = render.pal.rgb[i].green;
 			uint8_t b = render.pal.rgb[i].blue;
@@ -112,6 +143,10 @@ static void check_palette(void)
 		break;
 	}
 
+	memset(render.pal.dirty + render.pal.first,
+	       0,
+	       render.pal.last - render.pal.first + 1);
+
 	// Setup pal index to startup values
 	render.pal.first = 256;
 	render.pal.last  = 0;
@@ -124,6 +159,8 @@ void RENDER_SetPalette(const uint8_t entry, const uint8_t red,
 	render.pal.rgb[entry].green = green;
 	render.pal.rgb[entry].blue  = blue;
 
+	render.pal.dirty[entry] = 1;
+
 	if (render.pal.first > entry) {
 		render.pal.first = entry;
 	}
@@ -132,6 +169,92 @@ void RENDER_SetPalette(const uint8_t entry, const uint8_t red,
 	}
 }
 
+// --- Pooled frame buffers --------------------------------------------------
+//
+// RenderedImage deep copies and rendered-output readbacks need a frame-sized
+// buffer per captured frame, which the capture workers release again moments
+// later. Recycling the buffers through power-of-two size classes keeps the
+// steady-state frame path off the heap; only the first frame after a growth
+// in frame size allocates.
+
+// Smallest class is 1 KB (2^10); 18 classes take it up to 128 MB, enough for
+// a 4K 32-bit rendered readback
+constexpr int first_frame_buffer_class_bits = 10;
+constexpr int num_frame_buffer_classes      = 18;
+
+// Per class: enough for the video capture queue plus the in-flight copy
+constexpr size_t max_pooled_buffers_per_class = 4;
+
+// Keeps the user data aligned like a plain new[] would
+constexpr size_t frame_buffer_header_bytes = alignof(std::max_align_t);
+
+static std::mutex frame_buffer_pool_mutex = {};
+static std::vector<uint8_t*> frame_buffer_pool[num_frame_buffer_classes] = {};
+static RenderFrameBufferPoolStats frame_buffer_pool_stats = {};
+
+static int frame_buffer_size_class(const uint32_t num_bytes)
+{
+	int size_class = 0;
+	while ((size_t(1) << (first_frame_buffer_class_bits + size_class)) < num_bytes) {
+		++size_class;
+	}
+	assert(size_class < num_frame_buffer_classes);
+	return size_class;
+}
+
+uint8_t* RENDER_AcquireFrameBuffer(const uint32_t num_bytes)
+{
+	const auto size_class = frame_buffer_size_class(num_bytes);
+
+	uint8_t* base = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(frame_buffer_pool_mutex);
+
+		auto& pool = frame_buffer_pool[size_class];
+		if (!pool.empty()) {
+			base = pool.back();
+			pool.pop_back();
+			++frame_buffer_pool_stats.pool_reuses;
+		} else {
+			const auto class_bytes = size_t(1)
+			                      << (first_frame_buffer_class_bits +
+			                          size_class);
+			base = new uint8_t[frame_buffer_header_bytes + class_bytes];
+			++frame_buffer_pool_stats.heap_allocations;
+		}
+	}
+	// The class index rides in front of the user data so the release side
+	// can find the right pool again
+	base[0] = check_cast<uint8_t>(size_class);
+	return base + frame_buffer_header_bytes;
+}
+
+void RENDER_ReleaseFrameBuffer(uint8_t* buffer)
+{
+	if (!buffer) {
+		return;
+	}
+	auto base = buffer - frame_buffer_header_bytes;
+
+	const int size_class = base[0];
+	assert(size_class < num_frame_buffer_classes);
+
+	std::lock_guard<std::mutex> lock(frame_buffer_pool_mutex);
+
+	auto& pool = frame_buffer_pool[size_class];
+	if (pool.size() < max_pooled_buffers_per_class) {
+		pool.push_back(base);
+	} else {
+		delete[] base;
+	}
+}
+
+RenderFrameBufferPoolStats RENDER_GetFrameBufferPoolStats()
+{
+	std::lock_guard<std::mutex> lock(frame_buffer_pool_mutex);
+	return frame_buffer_pool_stats;
+}
+
 static void empty_line_handler(const void*) {}
 
 static void start_line_handler(const void* s)
@@ -201,6 +324,12 @@ bool RENDER_StartUpdate(void)
 	if (GCC_UNLIKELY(!render.active)) {
 		return false;
 	}
+	// Headless: nobody consumes the output, so skip line generation
+	// for the whole frame - unless a capture wants the frames
+	if (GCC_UNLIKELY(render.headless) && !CAPTURE_IsCapturingImage() &&
+	    !CAPTURE_IsCapturingVideo()) {
+		return false;
+	}
 	if (render.scale.inMode == scalerMode8) {
 		check_palette();
 	}
@@ -250,6 +379,17 @@ bool RENDER_StartUpdate(void)
 	return true;
 }
 
+bool RENDER_MaybeSkipLine()
+{
+	// Full-frame updates (cache clears, palette changes, captures)
+	// still need the real source data to repopulate the caches
+	if (!render.updating || render.fullFrame) {
+		return false;
+	}
+	RENDER_DrawLine(nullptr);
+	return true;
+}
+
 static void halt_render(void)
 {
 	RENDER_DrawLine = empty_line_handler;
@@ -389,6 +529,10 @@ static void render_reset(void)
 
 	switch (render.src.pixel_format) {
 	case PixelFormat::Indexed8:
+		// Keep GFX_CAN_8: the OpenGL backend can take the indexed frame
+		// directly when the shader does the palette lookup itself
+		render.src_start = (render.src.width * 2) / src_pixel_bytes;
+		break;
 	case PixelFormat::RGB555_Packed16:
 	case PixelFormat::RGB565_Packed16:
 		render.src_start = (render.src.width * 2) / src_pixel_bytes;
@@ -404,6 +548,13 @@ static void render_reset(void)
 		break;
 	}
 
+	// The shader must be set up-front: whether the backend can take an
+	// indexed frame depends on the capabilities of the current shader
+	if (GFX_GetRenderingBackend() == RenderingBackend::OpenGl) {
+		GFX_SetShader(get_shader_manager().GetCurrentShaderInfo(),
+		              get_shader_manager().GetCurrentShaderSource());
+	}
+
 	gfx_flags = GFX_GetBestMode(gfx_flags);
 
 	if (!gfx_flags) {
@@ -424,11 +575,6 @@ static void render_reset(void)
 		gfx_flags |= GFX_DBL_W;
 	}
 
-	if (GFX_GetRenderingBackend() == RenderingBackend::OpenGl) {
-		GFX_SetShader(get_shader_manager().GetCurrentShaderInfo(),
-		              get_shader_manager().GetCurrentShaderSource());
-	}
-
 	const auto render_pixel_aspect_ratio = render.src.pixel_aspect_ratio;
 
 	gfx_flags = GFX_SetSize(render_width_px,
@@ -498,6 +644,9 @@ static void render_reset(void)
 	render.pal.changed = false;
 	memset(render.pal.modified, 0, sizeof(render.pal.modified));
 
+	// All entries must be recomputed against the new output mode
+	memset(render.pal.dirty, 1, sizeof(render.pal.dirty));
+
 	// Finish this frame using a copy only handler
 	RENDER_DrawLine       = finish_line_handler;
 	render.scale.outWrite = nullptr;
@@ -1355,6 +1504,8 @@ void RENDER_Init(Section* sec)
 	const auto prev_viewport_settings       = viewport_settings;
 	const auto prev_aspect_ratio_correction_mode = aspect_ratio_correction_mode;
 
+	render.headless = control->arguments.headless;
+
 	render.pal.first = 256;
 	render.pal.last  = 0;
 
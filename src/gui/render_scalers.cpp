@@ -96,6 +96,11 @@ static inline void ScalerAddLines( Bitu changed, Bitu count ) {
 
 #define CC scalerChangeCache
 
+// Let the simple scalers accept a null source line, meaning "unchanged
+// since last frame": the line is counted as clean and the source cache
+// is left untouched. Used by RENDER_MaybeSkipLine().
+#define RENDER_NULL_INPUT 1
+
 /* Include the different rendering routines */
 #define SBPP 8
 #define DBPP 8
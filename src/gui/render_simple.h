@@ -75,12 +75,16 @@ static void conc4d(SCALERNAME,SBPP,DBPP,R)(const void *s) {
 			line0 += address_step * SCALERWIDTH;
 #endif
 		} else {
-#if defined(SCALERLINEAR)
-#if (SCALERHEIGHT > 1) 
+#if (SCALERHEIGHT > 1) && defined(SCALERROWREPEAT)
+			/* All output rows are identical: fill only the first
+			   one and block-copy it downwards after the run */
+			PTYPE * const row0 = line0;
+#elif defined(SCALERLINEAR)
+#if (SCALERHEIGHT > 1)
 			PTYPE *line1 = WC[0];
 #endif
 #else
-#if (SCALERHEIGHT > 1) 
+#if (SCALERHEIGHT > 1)
 		PTYPE *line1 = (PTYPE *)(((uint8_t*)line0)+ render.scale.outPitch);
 #endif
 #endif //defined(SCALERLINEAR)
@@ -92,11 +96,17 @@ static void conc4d(SCALERNAME,SBPP,DBPP,R)(const void *s) {
 				const PTYPE P = PMAKE(S);
 				SCALERFUNC;
 				line0 += SCALERWIDTH;
-#if (SCALERHEIGHT > 1) 
+#if (SCALERHEIGHT > 1) && !defined(SCALERROWREPEAT)
 				line1 += SCALERWIDTH;
 #endif
 			}
-#if defined(SCALERLINEAR)
+#if (SCALERHEIGHT > 1) && defined(SCALERROWREPEAT)
+			const Bitu rowLen = (Bitu)((uint8_t*)line0 - (uint8_t*)row0);
+			for (Bitu h = 1; h < SCALERHEIGHT; h++) {
+				BituMove(((uint8_t*)row0) + render.scale.outPitch * h,
+				         row0, rowLen);
+			}
+#elif defined(SCALERLINEAR)
 #if (SCALERHEIGHT > 1)
 			Bitu copyLen = (Bitu)((uint8_t*)line1 - (uint8_t*)WC[0]);
 			BituMove(((uint8_t*)line0)-copyLen+render.scale.outPitch  ,WC[0], copyLen );
@@ -243,16 +243,16 @@
 #	define SCALERNAME   Normal2x
 #	define SCALERWIDTH  2
 #	define SCALERHEIGHT 2
+#	define SCALERROWREPEAT
 #	define SCALERFUNC \
        line0[0] = P; \
-       line0[1] = P; \
-       line1[0] = P;                                                           \
-       line1[1] = P;
+       line0[1] = P;
 #	include "render_simple.h"
 
 #	undef SCALERNAME
 #	undef SCALERWIDTH
 #	undef SCALERHEIGHT
+#	undef SCALERROWREPEAT
 #	undef SCALERFUNC
 
 #	define SCALERNAME   NormalDw
@@ -271,13 +271,14 @@
 #	define SCALERNAME   NormalDh
 #	define SCALERWIDTH  1
 #	define SCALERHEIGHT 2
+#	define SCALERROWREPEAT
 #	define SCALERFUNC \
-		line0[0] = P; \
-		line1[0] = P;
+		line0[0] = P;
 #	include "render_simple.h"
 #	undef SCALERNAME
 #	undef SCALERWIDTH
 #	undef SCALERHEIGHT
+#	undef SCALERROWREPEAT
 #	undef SCALERFUNC
 
 #endif // (SBPP != 9) || (DBPP != 8)
@@ -41,6 +41,7 @@
 #include "joystick.h"
 #include "keyboard.h"
 #include "mapper.h"
+#include "mapper_event_log.h"
 #include "math_utils.h"
 #include "mouse.h"
 #include "pic.h"
@@ -100,7 +101,7 @@ class CBindGroup;
 
 static void SetActiveEvent(CEvent * event);
 static void SetActiveBind(CBind * _bind);
-extern uint8_t int10_font_14[256 * 14];
+extern const uint8_t int10_font_14[256 * 14];
 
 static std::vector<std::unique_ptr<CEvent>> events;
 static std::vector<std::unique_ptr<CButton>> buttons;
@@ -142,6 +143,16 @@ public:
 	virtual bool IsTrigger() = 0;
 	CBindList bindlist;
 protected:
+	// Fires the event's action and records it in the mapper event log
+	// (a no-op unless an event recording is in progress)
+	void LogActive(const bool yesno)
+	{
+		EVENTLOG_RecordEvent(entry,
+		                     yesno,
+		                     static_cast<int32_t>(current_value));
+		Active(yesno);
+	}
+
 	Bitu activity = 0;
 	char entry[16] = {0};
 	Bits current_value = 0;
@@ -157,7 +168,7 @@ public:
 	void ActivateEvent(bool ev_trigger,bool skip_action) override {
 		if (current_value>25000) {
 			/* value exceeds boundary, trigger event if not active */
-			if (!activity && !skip_action) Active(true);
+			if (!activity && !skip_action) LogActive(true);
 			if (activity<32767) activity++;
 		} else {
 			if (activity>0) {
@@ -169,7 +180,7 @@ public:
 	}
 	void DeActivateEvent(bool /*ev_trigger*/) override {
 		activity--;
-		if (!activity) Active(false);
+		if (!activity) LogActive(false);
 	}
 };
 
@@ -183,11 +194,11 @@ public:
 	void ActivateEvent(bool ev_trigger,bool skip_action) override {
 		if (ev_trigger) {
 			activity++;
-			if (!skip_action) Active(true);
+			if (!skip_action) LogActive(true);
 		} else {
 			/* test if no trigger-activity is present, this cares especially
 			   about activity of the opposite-direction joystick axis for example */
-			if (!GetActivityCount()) Active(true);
+			if (!GetActivityCount()) LogActive(true);
 		}
 	}
 	void DeActivateEvent(const bool ev_trigger) override
@@ -196,7 +207,7 @@ public:
 			// Zero-out this event's pending activity if triggered
 			// or we have no opposite-direction events
 			activity = 0;
-			Active(false);
+			LogActive(false);
 		}
 	}
 
@@ -2754,11 +2765,64 @@ static bool load_binds_from_file(const std::string_view mapperfile_path,
 	return was_loaded;
 }
 
+// Event dispatch latency counters, from SDL poll return to the guest
+// queue insertion done by the activated binds; sampled by the telemetry
+// endpoint from its server thread
+static std::atomic<uint64_t> dispatch_num_events = 0;
+static std::atomic<uint64_t> dispatch_total_us   = 0;
+static std::atomic<uint64_t> dispatch_max_us     = 0;
+
+static void dispatch_event(SDL_Event *event)
+{
+	// Route the event by type straight to the groups able to consume
+	// it, instead of probing every bind group; the groups themselves
+	// already resolve binds in O(1) (the keyboard group indexes its
+	// bind lists by scancode, the joystick groups filter by instance)
+	switch (event->type) {
+	case SDL_KEYDOWN:
+	case SDL_KEYUP:
+		for (auto &group : keybindgroups)
+			if (group->CheckEvent(event))
+				return;
+		break;
+	case SDL_JOYAXISMOTION:
+	case SDL_JOYBUTTONDOWN:
+	case SDL_JOYBUTTONUP:
+	case SDL_JOYHATMOTION:
+		for (auto &group : stickbindgroups)
+			if (group->CheckEvent(event))
+				return;
+		break;
+	default:
+		for (auto &group : bindgroups)
+			if (group->CheckEvent(event))
+				return;
+		break;
+	}
+}
+
 void MAPPER_CheckEvent(SDL_Event *event)
 {
-	for (auto &group : bindgroups)
-		if (group->CheckEvent(event))
-			return;
+	const auto start_us = GetTicksUs();
+
+	dispatch_event(event);
+
+	const auto elapsed = static_cast<uint64_t>(GetTicksUsSince(start_us));
+	++dispatch_num_events;
+	dispatch_total_us += elapsed;
+	// Only the main thread updates the counters, so a plain
+	// compare-and-store is race-free here
+	if (elapsed > dispatch_max_us) {
+		dispatch_max_us = elapsed;
+	}
+}
+
+void MAPPER_GetEventDispatchStats(uint64_t &num_events, uint64_t &total_us,
+                                  uint64_t &max_us)
+{
+	num_events = dispatch_num_events;
+	total_us   = dispatch_total_us;
+	max_us     = dispatch_max_us;
 }
 
 void BIND_MappingEvents() {
@@ -3114,8 +3178,9 @@ void MAPPER_DisplayUI() {
 	}
 
 	// Create font atlas surface
+	// SDL only reads the pixels here, but the API takes a mutable pointer
 	SDL_Surface* atlas_surface = SDL_CreateRGBSurfaceFrom(
-	        int10_font_14, 8, 256 * 14, 1, 1, 0, 0, 0, 0);
+	        const_cast<uint8_t*>(int10_font_14), 8, 256 * 14, 1, 1, 0, 0, 0, 0);
 	if (atlas_surface == nullptr) {
 		E_Exit("MAPPER: Failed to create atlas surface: %s", SDL_GetError());
 	}
@@ -3265,6 +3330,20 @@ void MAPPER_BindKeys(Section *sec)
 	GFX_RegenerateWindow(sec);
 }
 
+void MAPPER_InjectEvent(const std::string& event_name, const bool active,
+                        const int32_t value)
+{
+	for (const auto& event : events) {
+		if (event_name == event->GetName()) {
+			event->SetValue(value);
+			event->Active(active);
+			return;
+		}
+	}
+	LOG_WARNING("MAPPER: Cannot inject unknown event '%s'",
+	            event_name.c_str());
+}
+
 std::vector<std::string> MAPPER_GetEventNames(const std::string &prefix) {
 	std::vector<std::string> key_names;
 	key_names.reserve(events.size());
@@ -24,6 +24,7 @@
 #include <array>
 #include <cassert>
 #include <cerrno>
+#include <cinttypes>
 #include <cmath>
 #include <cstdarg>
 #include <cstdio>
@@ -41,6 +42,8 @@
 #include <process.h>
 #include <signal.h>
 #include <windows.h>
+#else
+#include <sys/wait.h>
 #endif
 
 #include <SDL.h>
@@ -110,6 +113,43 @@ typedef void (APIENTRYP PFNGLUNIFORM2FPROC) (GLint location, GLfloat v0, GLfloat
 typedef void (APIENTRYP PFNGLUNIFORM1IPROC) (GLint location, GLint v0);
 typedef void (APIENTRYP PFNGLUSEPROGRAMPROC) (GLuint program);
 typedef void (APIENTRYP PFNGLVERTEXATTRIBPOINTERPROC) (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid *pointer);
+typedef void (APIENTRYP PFNGLACTIVETEXTUREPROC_NP) (GLenum texture);
+
+/* Buffer object and fence sync entry points for the persistent-mapped
+ * pixel buffer ring; older GL headers may lack the related types and
+ * enums, so provide them when missing.
+ */
+#ifndef GL_ARB_sync
+typedef struct __GLsync *GLsync;
+typedef uint64_t GLuint64;
+#endif
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif
+
+typedef void (APIENTRYP PFNGLGENBUFFERSPROC_NP) (GLsizei n, GLuint *buffers);
+typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC_NP) (GLsizei n, const GLuint *buffers);
+typedef void (APIENTRYP PFNGLBINDBUFFERPROC_NP) (GLenum target, GLuint buffer);
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC_NP) (GLenum target, ptrdiff_t size, const void *data, GLbitfield flags);
+typedef void *(APIENTRYP PFNGLMAPBUFFERRANGEPROC_NP) (GLenum target, ptrdiff_t offset, ptrdiff_t length, GLbitfield access);
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC_NP) (GLenum condition, GLbitfield flags);
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC_NP) (GLsync sync, GLbitfield flags, GLuint64 timeout);
+typedef void (APIENTRYP PFNGLDELETESYNCPROC_NP) (GLsync sync);
 
 /* Apple defines these functions in their GL header (as core functions)
  * so we can't use their names as function pointers. We can't link
@@ -136,6 +176,15 @@ PFNGLUNIFORM2FPROC glUniform2f = nullptr;
 PFNGLUNIFORM1IPROC glUniform1i = nullptr;
 PFNGLUSEPROGRAMPROC glUseProgram = nullptr;
 PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
+PFNGLACTIVETEXTUREPROC_NP glActiveTexture = nullptr;
+PFNGLGENBUFFERSPROC_NP glGenBuffers = nullptr;
+PFNGLDELETEBUFFERSPROC_NP glDeleteBuffers = nullptr;
+PFNGLBINDBUFFERPROC_NP glBindBuffer = nullptr;
+PFNGLBUFFERSTORAGEPROC_NP glBufferStorage = nullptr;
+PFNGLMAPBUFFERRANGEPROC_NP glMapBufferRange = nullptr;
+PFNGLFENCESYNCPROC_NP glFenceSync = nullptr;
+PFNGLCLIENTWAITSYNCPROC_NP glClientWaitSync = nullptr;
+PFNGLDELETESYNCPROC_NP glDeleteSync = nullptr;
 }
 
 /* "using" is meant to hide identical names declared in outer scope
@@ -160,6 +209,15 @@ PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer = nullptr;
 #define glUniform1i               gl2::glUniform1i
 #define glUseProgram              gl2::glUseProgram
 #define glVertexAttribPointer     gl2::glVertexAttribPointer
+#define glActiveTexture           gl2::glActiveTexture
+#define glGenBuffers              gl2::glGenBuffers
+#define glDeleteBuffers           gl2::glDeleteBuffers
+#define glBindBuffer              gl2::glBindBuffer
+#define glBufferStorage           gl2::glBufferStorage
+#define glMapBufferRange          gl2::glMapBufferRange
+#define glFenceSync               gl2::glFenceSync
+#define glClientWaitSync          gl2::glClientWaitSync
+#define glDeleteSync              gl2::glDeleteSync
 
 #endif // C_OPENGL
 
@@ -644,7 +702,16 @@ static bool is_command_pressed(const SDL_Event event)
 
 uint8_t GFX_GetBestMode(const uint8_t flags)
 {
-	return (flags & GFX_CAN_32) & ~(GFX_CAN_8 | GFX_CAN_15 | GFX_CAN_16);
+	auto best_flags = (flags & GFX_CAN_32) & ~(GFX_CAN_8 | GFX_CAN_15 | GFX_CAN_16);
+#if C_OPENGL
+	// Keep the 8-bit capability when the current shader can resolve the
+	// palette itself; GFX_SetSize then takes the indexed frame directly
+	if (sdl.want_rendering_backend == RenderingBackend::OpenGl &&
+	    sdl.opengl.shader_info.settings.use_indexed_texture) {
+		best_flags |= (flags & GFX_CAN_8);
+	}
+#endif
+	return best_flags;
 }
 
 // Let the presentation layer safely call no-op functions.
@@ -1031,6 +1098,87 @@ static void remove_window()
 	}
 }
 
+// Rolling statistics of the host frame-present cost. The expected cost is
+// used to schedule presents against the frame deadline instead of only
+// detecting lateness after the fact, and the histogram is reported on
+// shutdown so pacing regressions are visible in the logs.
+constexpr auto NumPresentCostBuckets = 17;
+
+static struct {
+	// Power-of-two microsecond buckets: bucket b counts presents that
+	// took less than 2^b us; the last bucket counts the rest.
+	uint64_t histogram[NumPresentCostBuckets] = {};
+
+	int64_t num_presented = 0;
+	int64_t num_skipped   = 0;
+
+	double ema_cost_us = 0.0;
+} present_stats = {};
+
+// Cumulative variants of the presentation counters: present_stats resets
+// with every periodic log while the telemetry endpoint wants monotonic
+// counts it can difference between scrapes
+static std::atomic<int64_t> total_frames_presented = 0;
+static std::atomic<int64_t> total_frames_skipped   = 0;
+
+void GFX_GetFrameCounts(int64_t& num_presented, int64_t& num_skipped)
+{
+	num_presented = total_frames_presented.load();
+	num_skipped   = total_frames_skipped.load();
+}
+
+static bool present_frame_timed()
+{
+	const auto start_us  = GetTicksUs();
+	const auto presented = sdl.frame.present();
+	const auto cost_us   = GetTicksUsSince(start_us);
+
+	auto bucket = 0;
+	while (bucket < NumPresentCostBuckets - 1 &&
+	       cost_us >= (static_cast<int64_t>(1) << bucket)) {
+		++bucket;
+	}
+	++present_stats.histogram[bucket];
+	++present_stats.num_presented;
+	++total_frames_presented;
+
+	// Exponential moving average, biased towards the historical cost
+	constexpr auto ema_weight = 0.1;
+	present_stats.ema_cost_us =
+	        (present_stats.ema_cost_us == 0.0)
+	                ? static_cast<double>(cost_us)
+	                : present_stats.ema_cost_us * (1.0 - ema_weight) +
+	                          static_cast<double>(cost_us) * ema_weight;
+	return presented;
+}
+
+static void log_presentation_stats()
+{
+	if (!present_stats.num_presented) {
+		return;
+	}
+	// Derive the 99th percentile cost from the histogram
+	const auto target = (present_stats.num_presented * 99) / 100;
+
+	int64_t accumulated = 0;
+	auto p99_bucket     = 0;
+	for (auto b = 0; b < NumPresentCostBuckets; ++b) {
+		accumulated += check_cast<int64_t>(present_stats.histogram[b]);
+		if (accumulated >= target) {
+			p99_bucket = b;
+			break;
+		}
+	}
+	LOG_MSG("SDL: Presented %" PRId64 " frames averaging %.0f us per present"
+	        " (99%% under %" PRId64 " us), %" PRId64 " frames skipped",
+	        present_stats.num_presented,
+	        present_stats.ema_cost_us,
+	        static_cast<int64_t>(1) << p99_bucket,
+	        present_stats.num_skipped);
+
+	present_stats = {};
+}
+
 // The throttled presenter skips frames that have inter-frame spacing narrower
 // than the allowed frame period (sdl.frame.period_us). When a frame is skipped,
 // the presenter still tries to present it at its next oppourtunity.
@@ -1043,19 +1191,30 @@ static void maybe_present_throttled(const bool frame_is_new)
 	const auto now     = GetTicksUs();
 	const auto elapsed = now - last_present_time;
 
-	if (elapsed >= sdl.frame.period_us) {
+	// Schedule against the deadline: when the present itself is expected
+	// to consume the remainder of the frame period, start it now rather
+	// than detecting the overshoot on the next pass.
+	const auto expected_cost_us = static_cast<int64_t>(present_stats.ema_cost_us);
+
+	if (elapsed + expected_cost_us >= sdl.frame.period_us) {
 		// If we waited beyond this frame's refresh period, then credit
 		// this extra wait back by deducting it from the recorded time.
-		const auto wait_overage = elapsed % sdl.frame.period_us;
+		const auto wait_overage = (elapsed >= sdl.frame.period_us)
+		                                ? elapsed % sdl.frame.period_us
+		                                : static_cast<int64_t>(0);
 		last_present_time = now - (9 * wait_overage / 10);
 
 		if (frame_is_new || was_new_and_throttled) {
-			sdl.frame.present();
+			present_frame_timed();
 		}
 	}
 	// Otherwise we've had to throttle the frame, however if the frame was
 	// new, we'll record it as such and try to present it next time.
 	else {
+		if (frame_is_new) {
+			++present_stats.num_skipped;
+			++total_frames_skipped;
+		}
 		was_new_and_throttled = frame_is_new;
 	}
 }
@@ -1076,7 +1235,11 @@ static void maybe_present_synced(const bool present_if_last_skipped)
 	const auto should_present = on_time || (present_if_last_skipped &&
 	                                        !last_frame_presented);
 
-	last_frame_presented = should_present ? sdl.frame.present() : false;
+	if (!should_present) {
+		++present_stats.num_skipped;
+		++total_frames_skipped;
+	}
+	last_frame_presented = should_present ? present_frame_timed() : false;
 
 	last_sync_time = should_present ? GetTicksUs() : now;
 }
@@ -1715,6 +1878,63 @@ static void initialize_sdl_window_size(SDL_Window* sdl_window,
 	}
 }
 
+#if C_OPENGL
+
+static void destroy_pbo_ring()
+{
+	for (auto i = 0; i < NumPboBuffers; ++i) {
+		if (sdl.opengl.pbo_fences[i]) {
+			glDeleteSync(static_cast<GLsync>(sdl.opengl.pbo_fences[i]));
+			sdl.opengl.pbo_fences[i] = nullptr;
+		}
+		if (sdl.opengl.pbo_buffers[i]) {
+			// Persistent maps are released with their buffer
+			glDeleteBuffers(1, &sdl.opengl.pbo_buffers[i]);
+			sdl.opengl.pbo_buffers[i] = 0;
+		}
+		sdl.opengl.pbo_maps[i] = nullptr;
+	}
+	sdl.opengl.pbo_index    = 0;
+	sdl.opengl.use_pbo_ring = false;
+}
+
+static void create_pbo_ring(const size_t buffer_bytes)
+{
+	if (!sdl.opengl.pbo_funcs_ok) {
+		return;
+	}
+
+	constexpr GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+	                              GL_MAP_COHERENT_BIT;
+
+	auto all_mapped = true;
+	for (auto i = 0; i < NumPboBuffers; ++i) {
+		glGenBuffers(1, &sdl.opengl.pbo_buffers[i]);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, sdl.opengl.pbo_buffers[i]);
+		glBufferStorage(GL_PIXEL_UNPACK_BUFFER,
+		                static_cast<ptrdiff_t>(buffer_bytes),
+		                nullptr,
+		                access);
+		sdl.opengl.pbo_maps[i] = glMapBufferRange(
+		        GL_PIXEL_UNPACK_BUFFER,
+		        0,
+		        static_cast<ptrdiff_t>(buffer_bytes),
+		        access);
+		all_mapped &= (sdl.opengl.pbo_maps[i] != nullptr);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+	if (!all_mapped || glGetError() != GL_NO_ERROR) {
+		LOG_WARNING("OPENGL: Failed to set up the pixel buffer ring, "
+		            "falling back to client-side frame uploads");
+		destroy_pbo_ring();
+		return;
+	}
+	sdl.opengl.use_pbo_ring = true;
+}
+
+#endif // C_OPENGL
+
 uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
                     const Fraction& render_pixel_aspect_ratio, const uint8_t flags,
                     const VideoMode& video_mode, GFX_CallBack_t callback)
@@ -1761,6 +1981,10 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 	case RenderingBackend::Texture: {
 	fallback_texture: // FIXME: Must be replaced with a proper fallback system.
 
+#if C_OPENGL
+		sdl.opengl.use_indexed_texture = false;
+		sdl.opengl.use_pbo_ring        = false;
+#endif
 		if (!SetupWindowScaled(RenderingBackend::Texture)) {
 			LOG_ERR("DISPLAY: Can't initialise 'texture' window");
 			E_Exit("SDL: Failed to create window");
@@ -1863,10 +2087,18 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 #if C_OPENGL
 		free(sdl.opengl.framebuf);
 		sdl.opengl.framebuf = nullptr;
+		destroy_pbo_ring();
 		if (!(flags & GFX_CAN_32)) {
 			goto fallback_texture;
 		}
 
+		// GPU palette expansion: take the frame as 8-bit indices and
+		// let the shader resolve the colours via the palette texture
+		sdl.opengl.use_indexed_texture =
+		        (flags & GFX_CAN_8) && sdl.opengl.use_shader &&
+		        (glActiveTexture != nullptr) &&
+		        sdl.opengl.shader_info.settings.use_indexed_texture;
+
 		int texsize_w_px, texsize_h_px;
 
 		const auto use_npot_texture = sdl.opengl.npot_textures_supported &&
@@ -2015,6 +2247,11 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 					u = glGetUniformLocation(sdl.opengl.program_object, "rubyTexture");
 					glUniform1i(u, 0);
 
+					// Only present in palette-aware shaders;
+					// a missing uniform is simply ignored
+					u = glGetUniformLocation(sdl.opengl.program_object, "rubyPalette");
+					glUniform1i(u, 1);
+
 					sdl.opengl.ruby.texture_size = glGetUniformLocation(sdl.opengl.program_object, "rubyTextureSize");
 					sdl.opengl.ruby.input_size = glGetUniformLocation(sdl.opengl.program_object, "rubyInputSize");
 					sdl.opengl.ruby.output_size = glGetUniformLocation(sdl.opengl.program_object, "rubyOutputSize");
@@ -2027,7 +2264,13 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 		const auto framebuffer_bytes = static_cast<size_t>(render_width_px) *
 		                               render_height_px * MAX_BYTES_PER_PIXEL;
 		sdl.opengl.framebuf = malloc(framebuffer_bytes); // 32 bit colour
-		sdl.opengl.pitch = render_width_px * 4;
+		sdl.opengl.pitch = render_width_px *
+		                   (sdl.opengl.use_indexed_texture ? 1 : 4);
+
+		// Prefer writing frames into a persistent-mapped buffer ring;
+		// the malloc'd buffer above stays as the fallback path
+		create_pbo_ring(static_cast<size_t>(sdl.opengl.pitch) *
+		                render_height_px);
 
 		// One-time initialize the window size
 		if (!sdl.desktop.window.adjusted_initial_size) {
@@ -2069,9 +2312,12 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_parameter);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_parameter);
 
-		const GLint filter = (sdl.interpolation_mode == InterpolationMode::NearestNeighbour
-		                              ? GL_NEAREST
-		                              : GL_LINEAR);
+		// The indexed texture must be point-sampled; any blending has to
+		// happen after the palette lookup, inside the shader
+		const GLint filter = (sdl.opengl.use_indexed_texture ||
+		                      sdl.interpolation_mode == InterpolationMode::NearestNeighbour)
+		                            ? GL_NEAREST
+		                            : GL_LINEAR;
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
@@ -2112,10 +2358,13 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 
 		// Using GL_SRGB8_ALPHA8 because GL_SRGB8 doesn't work properly
 		// with Mesa drivers on certain integrated Intel GPUs
-		const auto texformat = sdl.opengl.shader_info.settings.use_srgb_texture &&
-		                                       sdl.opengl.framebuffer_is_srgb_encoded
-		                             ? GL_SRGB8_ALPHA8
-		                             : GL_RGB8;
+		const auto texformat =
+		        sdl.opengl.use_indexed_texture
+		                ? GL_LUMINANCE8
+		                : (sdl.opengl.shader_info.settings.use_srgb_texture &&
+		                                   sdl.opengl.framebuffer_is_srgb_encoded
+		                           ? GL_SRGB8_ALPHA8
+		                           : GL_RGB8);
 
 #if 0
 		if (texformat == GL_SRGB8_ALPHA8) {
@@ -2129,11 +2378,40 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 		             texsize_w_px,
 		             texsize_h_px,
 		             0,
-		             GL_BGRA_EXT,
+		             sdl.opengl.use_indexed_texture ? GL_LUMINANCE : GL_BGRA_EXT,
 		             GL_UNSIGNED_BYTE,
 		             emptytex);
 		delete[] emptytex;
 
+		if (sdl.opengl.use_indexed_texture) {
+			// Indexed rows are byte-packed
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+			if (sdl.opengl.palette_texture > 0) {
+				glDeleteTextures(1, &sdl.opengl.palette_texture);
+			}
+			glGenTextures(1, &sdl.opengl.palette_texture);
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, sdl.opengl.palette_texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexImage2D(GL_TEXTURE_2D,
+			             0,
+			             GL_RGBA8,
+			             256,
+			             1,
+			             0,
+			             GL_RGBA,
+			             GL_UNSIGNED_BYTE,
+			             sdl.opengl.palette_data);
+			glActiveTexture(GL_TEXTURE0);
+			sdl.opengl.palette_dirty = false;
+		} else {
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+		}
+
 		if (sdl.opengl.framebuffer_is_srgb_encoded) {
 			glEnable(GL_FRAMEBUFFER_SRGB);
 #if 0
@@ -2197,7 +2475,8 @@ uint8_t GFX_SetSize(const int render_width_px, const int render_height_px,
 
 		OPENGL_ERROR("End of setsize");
 
-		retFlags          = GFX_CAN_32 | GFX_CAN_RANDOM;
+		retFlags = (sdl.opengl.use_indexed_texture ? GFX_CAN_8 : GFX_CAN_32) |
+		           GFX_CAN_RANDOM;
 		sdl.frame.update  = update_frame_gl;
 		sdl.frame.present = present_frame_gl;
 #else
@@ -2440,7 +2719,23 @@ bool GFX_StartUpdate(uint8_t * &pixels, int &pitch)
 		return true;
 	case RenderingBackend::OpenGl:
 #if C_OPENGL
-		pixels = static_cast<uint8_t*>(sdl.opengl.framebuf);
+		if (sdl.opengl.use_pbo_ring) {
+			// Wait for the GPU to finish any upload still reading
+			// from this ring slot before handing it to RENDER
+			auto& fence = sdl.opengl.pbo_fences[sdl.opengl.pbo_index];
+			if (fence) {
+				constexpr GLuint64 timeout_ns = 1'000'000'000;
+				glClientWaitSync(static_cast<GLsync>(fence),
+				                 GL_SYNC_FLUSH_COMMANDS_BIT,
+				                 timeout_ns);
+				glDeleteSync(static_cast<GLsync>(fence));
+				fence = nullptr;
+			}
+			pixels = static_cast<uint8_t*>(
+			        sdl.opengl.pbo_maps[sdl.opengl.pbo_index]);
+		} else {
+			pixels = static_cast<uint8_t*>(sdl.opengl.framebuf);
+		}
 		OPENGL_ERROR("end of start update");
 		if (pixels == nullptr) {
 			return false;
@@ -2473,7 +2768,7 @@ void GFX_EndUpdate(const uint16_t* changedLines)
 		// keep the contents of rendered and raw/upscaled screenshots in sync
 		// (so they capture the exact same frame) in multi-output image
 		// capture modes.
-		sdl.frame.present();
+		present_frame_timed();
 	} else {
 		// Helper lambda indicating whether the frame should be presented.
 		// Returns true if the frame has been updated or if the limit of
@@ -2493,7 +2788,7 @@ void GFX_EndUpdate(const uint16_t* changedLines)
 			break;
 		case FrameMode::Vfr:
 			if (vfr_should_present()) {
-				sdl.frame.present();
+				present_frame_timed();
 			}
 			break;
 		case FrameMode::ThrottledVfr:
@@ -2574,7 +2869,9 @@ static std::optional<RenderedImage> get_rendered_output_from_backbuffer()
 
 		const auto image_size_bytes = check_cast<uint32_t>(
 		        image.params.height * image.pitch);
-		image.image_data = new uint8_t[image_size_bytes];
+		// Pooled so repeated rendered captures reuse the same buffer;
+		// the image saver releases it via RenderedImage::free()
+		image.image_data = RENDER_AcquireFrameBuffer(image_size_bytes);
 	};
 
 #if C_OPENGL
@@ -2641,7 +2938,7 @@ static std::optional<RenderedImage> get_rendered_output_from_backbuffer()
 		LOG_WARNING("SDL: Failed reading pixels from the texture renderer: %s",
 		            SDL_GetError());
 
-		delete[] image.image_data;
+		RENDER_ReleaseFrameBuffer(image.image_data);
 		return {};
 	}
 	return image;
@@ -2676,8 +2973,28 @@ static bool present_frame_texture()
 #if C_OPENGL
 static void update_frame_gl(const uint16_t* changedLines)
 {
+	if (sdl.opengl.use_indexed_texture && sdl.opengl.palette_dirty) {
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, sdl.opengl.palette_texture);
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA,
+		                GL_UNSIGNED_BYTE, sdl.opengl.palette_data);
+		glActiveTexture(GL_TEXTURE0);
+		sdl.opengl.palette_dirty = false;
+	}
+
 	if (changedLines) {
-		const auto framebuf = static_cast<uint8_t *>(sdl.opengl.framebuf);
+		// With the buffer ring bound the upload sources straight from
+		// the persistent mapping RENDER has just written, so pixel
+		// "pointers" become byte offsets into the bound buffer
+		const auto use_pbo = sdl.opengl.use_pbo_ring;
+		if (use_pbo) {
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER,
+			             sdl.opengl.pbo_buffers[sdl.opengl.pbo_index]);
+		}
+
+		const auto framebuf = use_pbo ? nullptr
+		                              : static_cast<uint8_t*>(
+		                                        sdl.opengl.framebuf);
 		const auto pitch = sdl.opengl.pitch;
 		int y = 0;
 		size_t index = 0;
@@ -2687,13 +3004,34 @@ static void update_frame_gl(const uint16_t* changedLines)
 			} else {
 				const uint8_t *pixels = framebuf + y * pitch;
 				const int height_px = changedLines[index];
-				glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y,
-				                sdl.draw.render_width_px, height_px, GL_BGRA_EXT,
-				                GL_UNSIGNED_INT_8_8_8_8_REV, pixels);
+				if (sdl.opengl.use_indexed_texture) {
+					glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y,
+					                sdl.draw.render_width_px,
+					                height_px, GL_LUMINANCE,
+					                GL_UNSIGNED_BYTE, pixels);
+				} else {
+					glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y,
+					                sdl.draw.render_width_px,
+					                height_px, GL_BGRA_EXT,
+					                GL_UNSIGNED_INT_8_8_8_8_REV,
+					                pixels);
+				}
 				y += height_px;
 			}
 			index++;
 		}
+
+		if (use_pbo) {
+			// Fence the uploads so the slot is not rewritten while
+			// the driver may still be reading it, then move on
+			auto& fence = sdl.opengl.pbo_fences[sdl.opengl.pbo_index];
+			assert(!fence);
+			fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+			sdl.opengl.pbo_index = (sdl.opengl.pbo_index + 1) %
+			                       NumPboBuffers;
+		}
 	} else {
 		sdl.opengl.actual_frame_count++;
 	}
@@ -2730,6 +3068,30 @@ static bool present_frame_gl()
 }
 #endif
 
+void GFX_UpdatePalette([[maybe_unused]] const uint8_t* rgbx_data,
+                       [[maybe_unused]] const uint16_t first,
+                       [[maybe_unused]] const uint16_t count)
+{
+#if C_OPENGL
+	if (sdl.rendering_backend != RenderingBackend::OpenGl ||
+	    !sdl.opengl.use_indexed_texture) {
+		return;
+	}
+	assert(first + count <= 256);
+
+	auto dest = sdl.opengl.palette_data + first * 4;
+	for (auto i = 0; i < count; ++i) {
+		dest[0] = rgbx_data[0];
+		dest[1] = rgbx_data[1];
+		dest[2] = rgbx_data[2];
+		dest[3] = 255;
+		dest += 4;
+		rgbx_data += 4;
+	}
+	sdl.opengl.palette_dirty = true;
+#endif
+}
+
 uint32_t GFX_GetRGB(const uint8_t red, const uint8_t green, const uint8_t blue)
 {
 	switch (sdl.rendering_backend) {
@@ -2794,6 +3156,8 @@ static void clean_up_sdl_resources()
 
 static void GUI_ShutDown(Section *)
 {
+	log_presentation_stats();
+
 	GFX_Stop();
 	if (sdl.draw.callback)
 		(sdl.draw.callback)( GFX_CallBackStop );
@@ -3240,6 +3604,13 @@ static void set_output(Section* sec, const bool wants_aspect_ratio_correction)
 	const auto section = static_cast<const Section_prop *>(sec);
 	std::string output = section->Get_string("output");
 
+	// The dummy video driver has no GPU, so render through the software
+	// texture backend and never enter fullscreen
+	if (control->arguments.headless) {
+		output = "texturenb";
+		sdl.desktop.fullscreen = false;
+	}
+
 	GFX_DisengageRendering();
 	// it's the job of everything after this to re-engage it.
 
@@ -3281,6 +3652,9 @@ static void set_output(Section* sec, const bool wants_aspect_ratio_correction)
 		SDL_DisableScreenSaver();
 
 	sdl.render_driver = section->Get_string("texture_renderer");
+	if (control->arguments.headless) {
+		sdl.render_driver = "software";
+	}
 	lowcase(sdl.render_driver);
 	if (sdl.render_driver != "auto") {
 		if (SDL_SetHint(SDL_HINT_RENDER_DRIVER,
@@ -3355,6 +3729,31 @@ static void set_output(Section* sec, const bool wants_aspect_ratio_correction)
 			        "glUseProgram");
 			glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)
 			        SDL_GL_GetProcAddress("glVertexAttribPointer");
+			glActiveTexture = (PFNGLACTIVETEXTUREPROC_NP)SDL_GL_GetProcAddress(
+			        "glActiveTexture");
+			glGenBuffers = (PFNGLGENBUFFERSPROC_NP)SDL_GL_GetProcAddress(
+			        "glGenBuffers");
+			glDeleteBuffers = (PFNGLDELETEBUFFERSPROC_NP)SDL_GL_GetProcAddress(
+			        "glDeleteBuffers");
+			glBindBuffer = (PFNGLBINDBUFFERPROC_NP)SDL_GL_GetProcAddress(
+			        "glBindBuffer");
+			glBufferStorage = (PFNGLBUFFERSTORAGEPROC_NP)SDL_GL_GetProcAddress(
+			        "glBufferStorage");
+			glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC_NP)
+			        SDL_GL_GetProcAddress("glMapBufferRange");
+			glFenceSync = (PFNGLFENCESYNCPROC_NP)SDL_GL_GetProcAddress(
+			        "glFenceSync");
+			glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC_NP)
+			        SDL_GL_GetProcAddress("glClientWaitSync");
+			glDeleteSync = (PFNGLDELETESYNCPROC_NP)SDL_GL_GetProcAddress(
+			        "glDeleteSync");
+
+			sdl.opengl.pbo_funcs_ok =
+			        (glGenBuffers && glDeleteBuffers && glBindBuffer &&
+			         glBufferStorage && glMapBufferRange &&
+			         glFenceSync && glClientWaitSync && glDeleteSync &&
+			         SDL_GL_ExtensionSupported("GL_ARB_buffer_storage"));
+
 			sdl.opengl.use_shader =
 			        (glAttachShader && glCompileShader &&
 			         glCreateProgram && glDeleteProgram &&
@@ -4228,6 +4627,10 @@ static void messages_add_command_line()
 	        "\n"
 	        "  --fullscreen             Start in fullscreen mode.\n"
 	        "\n"
+	        "  --headless               Run without a window, display, or GPU, for batch\n"
+	        "                           workloads. Video output is not rendered (image and\n"
+	        "                           video capture still work on demand).\n"
+	        "\n"
 	        "  --lang <lang_file>       Start with the language specified in <lang_file>.\n"
 	        "\n"
 	        "  --machine <type>         Emulate a specific type of machine. The machine type has\n"
@@ -4252,6 +4655,13 @@ static void messages_add_command_line()
 	        "\n"
 	        "  --socket <num>           Run nullmodem on the specified socket number.\n"
 	        "\n"
+	        "  --startup-trace          Log how many milliseconds each subsystem takes to\n"
+	        "                           initialise during startup.\n"
+	        "\n"
+	        "  --zygote                 Stay resident after the shared setup and fork one\n"
+	        "                           session process per line read on standard input.\n"
+	        "                           Not available on Windows.\n"
+	        "\n"
 	        "  -h, -?, --help           Print help message and exit.\n"
 	        "\n"
 	        "  -V, --version            Print version information and exit.\n");
@@ -4707,6 +5117,41 @@ static void override_wm_class()
 
 extern "C" int SDL_CDROMInit(void);
 
+#if !defined(WIN32)
+// Zygote mode for session-per-process services: the parent pays for
+// message registration, DOSBOX_Init's section setup, and config parsing
+// once, then forks one session per line read on standard input. The fork
+// happens while the process is still single-threaded and SDL-free, so the
+// child can safely carry on with SDL init and the per-session section
+// startup. Returns the parent's exit code, or -1 in the forked child,
+// which then continues the normal startup path.
+static int run_zygote_loop()
+{
+	LOG_MSG("ZYGOTE: Ready; forking one session per line on standard input");
+
+	char line[256];
+	while (fgets(line, sizeof(line), stdin)) {
+		// reap any sessions that have since finished
+		while (waitpid(-1, nullptr, WNOHANG) > 0)
+			;
+		const auto pid = fork();
+		if (pid < 0) {
+			LOG_ERR("ZYGOTE: fork failed: %s",
+			        safe_strerror(errno).c_str());
+			return 1;
+		}
+		if (pid == 0) {
+			return -1; // the child continues the normal startup
+		}
+		LOG_MSG("ZYGOTE: Forked session process %d", static_cast<int>(pid));
+	}
+	// stdin closed; wait for the remaining sessions before quitting
+	while (waitpid(-1, nullptr, 0) > 0)
+		;
+	return 0;
+}
+#endif
+
 int sdl_main(int argc, char* argv[])
 {
 	CommandLine command_line(argc, argv);
@@ -4881,6 +5326,18 @@ int sdl_main(int argc, char* argv[])
 		}
 #endif
 #endif // WIN32
+#if !defined(WIN32)
+		// The fork must happen before SDL and any emulator threads
+		// exist, as neither survives a fork; everything from here on
+		// runs per session in the forked child
+		if (arguments->zygote) {
+			if (const auto parent_rc = run_zygote_loop();
+			    parent_rc >= 0) {
+				return parent_rc;
+			}
+		}
+#endif
+
 		// Seamless mouse integration feels more 'seamless' if mouse
 		// clicks on out-of-focus window are passed to the guest
 		SDL_SetHint(SDL_HINT_MOUSE_FOCUS_CLICKTHROUGH, "1");
@@ -4889,6 +5346,14 @@ int sdl_main(int argc, char* argv[])
 			return err;
 		}
 
+		// Headless batch operation: SDL's dummy video driver needs no
+		// display or GPU, and the render pipeline is short-circuited
+		// unless a capture asks for frames
+		if (arguments->headless) {
+			SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+			LOG_MSG("SDL: Running headless using the dummy video driver");
+		}
+
 		if (SDL_Init(SDL_INIT_AUDIO | SDL_INIT_VIDEO) < 0) {
 			E_Exit("SDL: Can't init SDL %s", SDL_GetError());
 		}
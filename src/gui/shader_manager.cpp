@@ -134,6 +134,14 @@ void ShaderManager::LoadShader(const std::string& shader_name)
 {
 	auto new_shader_name = shader_name;
 
+	// Serve repeat loads from the cache
+	if (const auto it = shader_cache.find(new_shader_name);
+	    it != shader_cache.end()) {
+		current_shader.source = it->second.source;
+		SetCurrentShaderInfo(new_shader_name, it->second.settings);
+		return;
+	}
+
 	if (!ReadShaderSource(new_shader_name, current_shader.source)) {
 		current_shader.source.clear();
 
@@ -157,6 +165,14 @@ void ShaderManager::LoadShader(const std::string& shader_name)
 	const auto settings = ParseShaderSettings(new_shader_name,
 	                                          current_shader.source);
 
+	shader_cache[new_shader_name] = {current_shader.source, settings};
+
+	SetCurrentShaderInfo(new_shader_name, settings);
+}
+
+void ShaderManager::SetCurrentShaderInfo(const std::string& shader_name,
+                                         const ShaderSettings& settings)
+{
 	const bool is_adaptive = [&] {
 		if (mode == ShaderMode::Single) {
 			return false;
@@ -164,11 +180,11 @@ void ShaderManager::LoadShader(const std::string& shader_name)
 		} else {
 			// This will turn off vertical integer scaling for the
 			// 'sharp' shader in 'integer_scaling = auto' mode
-			return (new_shader_name != SharpShaderName);
+			return (shader_name != SharpShaderName);
 		}
 	}();
 
-	current_shader.info = {new_shader_name, settings, is_adaptive};
+	current_shader.info = {shader_name, settings, is_adaptive};
 }
 
 const ShaderInfo& ShaderManager::GetCurrentShaderInfo() const
@@ -183,6 +199,9 @@ const std::string& ShaderManager::GetCurrentShaderSource() const
 
 void ShaderManager::ReloadCurrentShader()
 {
+	// An explicit reload must pick up on-disk changes to the source
+	shader_cache.erase(current_shader.info.name);
+
 	LoadShader(current_shader.info.name);
 	LOG_MSG("RENDER: Reloaded current shader '%s'",
 	        current_shader.info.name.c_str());
@@ -354,6 +373,9 @@ ShaderSettings ShaderManager::ParseShaderSettings(const std::string& shader_name
 
 			} else if (pragma == "force_no_pixel_doubling") {
 				settings.force_no_pixel_doubling = true;
+
+			} else if (pragma == "use_indexed_texture") {
+				settings.use_indexed_texture = true;
 			}
 			++next;
 		}
@@ -22,6 +22,7 @@
 #define DOSBOX_SHADER_MANAGER_H
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "rect.h"
@@ -102,6 +103,11 @@ struct ShaderSettings {
 	bool use_srgb_framebuffer    = false;
 	bool force_single_scan       = false;
 	bool force_no_pixel_doubling = false;
+
+	// The shader samples an 8-bit indexed input texture and resolves the
+	// colours itself via the 'rubyPalette' texture; paletted video modes
+	// are then uploaded to the GPU without CPU-side palette expansion
+	bool use_indexed_texture = false;
 };
 
 struct ShaderInfo {
@@ -156,6 +162,8 @@ public:
 
 private:
 	void LoadShader(const std::string& shader_name);
+	void SetCurrentShaderInfo(const std::string& shader_name,
+	                          const ShaderSettings& settings);
 	bool ReadShaderSource(const std::string& shader_name, std::string& source);
 
 	ShaderSettings ParseShaderSettings(const std::string& shader_name,
@@ -181,6 +189,15 @@ private:
 		std::string source = {};
 	} current_shader = {};
 
+	// Loaded shaders are cached by name so the adaptive CRT modes can
+	// flip between them on mode changes without re-reading and re-parsing
+	// the sources.
+	struct CachedShader {
+		std::string source      = {};
+		ShaderSettings settings = {};
+	};
+	std::unordered_map<std::string, CachedShader> shader_cache = {};
+
 	std::string shader_name_from_config = {};
 
 	int pixels_per_scanline                   = 1;
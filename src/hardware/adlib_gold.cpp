@@ -90,15 +90,10 @@ void SurroundProcessor::ControlWrite(const uint8_t val)
 	control_state.a0  = reg.a0;
 }
 
-AudioFrame SurroundProcessor::Process(const AudioFrame frame)
+void SurroundProcessor::Process(const float* in_mono, float* out_left,
+                                float* out_right, const uint32_t frames)
 {
-	YM7128B_ChipIdeal_Process_Data data = {};
-
-	data.inputs[0] = frame.left + frame.right;
-
-	YM7128B_ChipIdeal_Process(&chip, &data);
-
-	return {data.outputs[0], data.outputs[1]};
+	YM7128B_ChipIdeal_Process_Block(&chip, in_mono, out_left, out_right, frames);
 }
 
 // Philips Semiconductors TDA8425 hi-fi stereo audio processor emulation
@@ -349,19 +344,31 @@ void AdlibGold::SurroundControlWrite(const uint8_t val)
 
 void AdlibGold::Process(const int16_t* in, const uint32_t frames, float* out)
 {
-	auto frames_remaining = frames;
+	// Run the surround module over the whole block; its delay line taps
+	// are accumulated with SIMD when processed in batches.
+	surround_in.resize(frames);
+	wet_left.resize(frames);
+	wet_right.resize(frames);
+
+	for (uint32_t i = 0; i < frames; ++i) {
+		surround_in[i] = static_cast<float>(in[i * 2]) +
+		                 static_cast<float>(in[i * 2 + 1]);
+	}
+
+	surround_processor->Process(surround_in.data(),
+	                            wet_left.data(),
+	                            wet_right.data(),
+	                            frames);
 
-	while (frames_remaining--) {
+	for (uint32_t i = 0; i < frames; ++i) {
 		AudioFrame frame = {static_cast<float>(in[0]),
 		                    static_cast<float>(in[1])};
 
-		const auto wet = surround_processor->Process(frame);
-
 		// Additional wet signal level boost to make the emulated
 		// sound more closely resemble real hardware recordings.
 		constexpr auto wet_boost = 1.8f;
-		frame.left += wet.left * wet_boost;
-		frame.right += wet.right * wet_boost;
+		frame.left += wet_left[i] * wet_boost;
+		frame.right += wet_right[i] * wet_boost;
 
 		frame = stereo_processor->Process(frame);
 
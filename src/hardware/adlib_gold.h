@@ -23,6 +23,8 @@
 
 #include "dosbox.h"
 
+#include <vector>
+
 #include "bit_view.h"
 #include "mixer.h"
 
@@ -34,7 +36,8 @@ public:
 	~SurroundProcessor();
 
 	void ControlWrite(const uint8_t val);
-	AudioFrame Process(const AudioFrame frame);
+	void Process(const float* in_mono, float* out_left, float* out_right,
+	             const uint32_t frames);
 
 	// prevent copying
 	SurroundProcessor(const SurroundProcessor&) = delete;
@@ -135,6 +138,11 @@ public:
 private:
 	std::unique_ptr<SurroundProcessor> surround_processor = {};
 	std::unique_ptr<StereoProcessor> stereo_processor     = {};
+
+	// Scratch buffers for block-processing the surround module
+	std::vector<float> surround_in  = {};
+	std::vector<float> wet_left     = {};
+	std::vector<float> wet_right    = {};
 };
 
 #endif
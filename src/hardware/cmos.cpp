@@ -39,6 +39,12 @@ static struct {
 		uint8_t div;
 		double delay;
 		bool acknowledged;
+		// Guests that enable the periodic interrupt but never read
+		// status register C (masked or plain uninterested) get the
+		// event chain suspended after a few unacknowledged periods;
+		// reading register C re-arms it, phase-aligned.
+		uint8_t unacknowledged;
+		bool suspended;
 	} timer;
 	struct {
 		double timer;
@@ -48,11 +54,23 @@ static struct {
 	bool update_ended;
 } cmos;
 
+// Periods without a register C read before the event chain is parked;
+// polling guests read the register and so keep the chain alive
+constexpr uint8_t max_unacknowledged_periods = 4;
+
 static void cmos_timerevent(uint32_t /*val*/)
 {
 	if (cmos.timer.acknowledged) {
-		cmos.timer.acknowledged = false;
+		cmos.timer.acknowledged   = false;
+		cmos.timer.unacknowledged = 0;
 		PIC_ActivateIRQ(8);
+	} else if (++cmos.timer.unacknowledged >= max_unacknowledged_periods) {
+		// The guest is ignoring the interrupt: stop burning an event
+		// per period. The pending flags stay staged in register C,
+		// and reading it resumes delivery.
+		cmos.timer.suspended = true;
+		cmos.regs[0xc] = 0xC0;
+		return;
 	}
 	if (cmos.timer.enabled) {
 		PIC_AddEvent(cmos_timerevent,cmos.timer.delay);
@@ -62,6 +80,8 @@ static void cmos_timerevent(uint32_t /*val*/)
 
 static void cmos_checktimer(void) {
 	PIC_RemoveEvents(cmos_timerevent);
+	cmos.timer.unacknowledged = 0;
+	cmos.timer.suspended      = false;
 	if (cmos.timer.div<=2) cmos.timer.div+=7;
 	cmos.timer.delay = (1000.0 / (32768.0 / (1 << (cmos.timer.div - 1))));
 	if (!cmos.timer.div || !cmos.timer.enabled) return;
@@ -170,7 +190,17 @@ static uint8_t cmos_readreg(io_port_t, io_width_t)
 		}
 	case 0x0c:		/* Status register C */
 		cmos.timer.acknowledged=true;
+		cmos.timer.unacknowledged = 0;
 		if (cmos.timer.enabled) {
+			if (cmos.timer.suspended) {
+				// The guest cares again: resume the event
+				// chain on the running clock's period grid
+				cmos.timer.suspended = false;
+				const auto remd = fmod(PIC_FullIndex(),
+				                       cmos.timer.delay);
+				PIC_AddEvent(cmos_timerevent,
+				             cmos.timer.delay - remd);
+			}
 			/* In periodic interrupt mode only care for those flags */
 			uint8_t val=cmos.regs[0xc];
 			cmos.regs[0xc]=0;
@@ -352,6 +382,8 @@ public:
 		ReadHandler[0].Install(port_0x71, cmos_readreg, io_width_t::byte);
 		cmos.timer.enabled = false;
 		cmos.timer.acknowledged = true;
+		cmos.timer.unacknowledged = 0;
+		cmos.timer.suspended = false;
 		cmos.reg = 0xa;
 		cmos_writereg(port_0x71, 0x26, io_width_t::byte);
 		cmos.reg = 0xb;
@@ -62,6 +62,7 @@
 #include "dosbox.h"
 
 #include <cstdint>
+#include <vector>
 
 typedef struct AudioFrame AudioFrame_;
 
@@ -87,6 +88,13 @@ public:
 
 	AudioFrame Process(const AudioFrame in);
 
+	// Block variant: compresses 'frames' frames in-place. The detector
+	// and gain curves are computed over the whole block with vectorized
+	// log/exp approximations, and the audio path runs through a short
+	// lookahead delay ring so the gain reduction is already in effect
+	// when an attack transient arrives.
+	void Process(float* left, float* right, const int frames);
+
 	// prevent copying
 	Compressor(const Compressor &) = delete;
 	// prevent assignment
@@ -103,6 +111,8 @@ private:
 	float release_coeff   = {};
 	float rms_coeff       = {};
 
+	float log_threshold = {};
+
 	// state variables
 	float comp_ratio      = {};
 	float run_db          = {};
@@ -110,6 +120,17 @@ private:
 	float over_db         = {};
 	float run_max_db      = {};
 	float max_over_db     = {};
+
+	// Lookahead delay ring for the block path; sized to a power of two
+	// so the wrap is a branchless mask
+	std::vector<float> lookahead_left  = {};
+	std::vector<float> lookahead_right = {};
+	uint32_t lookahead_mask            = {};
+	uint32_t lookahead_pos             = {};
+
+	// Scratch buffers for the block path
+	std::vector<float> det_buf  = {};
+	std::vector<float> gain_buf = {};
 };
 
 #endif
@@ -92,18 +92,15 @@ static void perform_dma_io(const DMA_DIRECTION direction, const PhysPt spage,
 		// Determine how many bytes to transfer within this page
 		const auto chunk_bytes = std::min(remaining_bytes, bytes_to_page_end);
 
-		// Copy the data from the page address into the data pointer
+		// The chunk is confined to a single page of plain guest RAM, so
+		// it can be copied as one block instead of a byte at a time.
 		if (direction == DMA_DIRECTION::READ) {
-			for (auto i = 0; i < chunk_bytes; ++i) {
-				data_pt[i] = phys_readb(chunk_start + i);
-			}
+			memcpy(data_pt, MemBase + chunk_start, chunk_bytes);
 		}
 
 		// Copy the data from the data pointer into the page address
 		else if (direction == DMA_DIRECTION::WRITE) {
-			for (auto i = 0; i < chunk_bytes; ++i) {
-				phys_writeb(chunk_start + i, data_pt[i]);
-			}
+			memcpy(MemBase + chunk_start, data_pt, chunk_bytes);
 		}
 
 		mem_address += chunk_bytes;
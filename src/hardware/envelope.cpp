@@ -31,8 +31,10 @@ void Envelope::Reactivate()
 {
 	edge        = 0.0f;
 	frames_done = 0;
+	is_done     = false;
 
-	process = &Envelope::Apply;
+	process       = &Envelope::Apply;
+	process_block = &Envelope::ApplyBlock;
 }
 
 void Envelope::Update(const int frame_rate, const int peak_amplitude,
@@ -83,6 +85,12 @@ void Envelope::Process(const bool is_stereo, AudioFrame &frame)
 	process(*this, is_stereo, frame);
 }
 
+void Envelope::Process(const bool is_stereo, float* interleaved_out,
+                       const int num_frames)
+{
+	process_block(*this, is_stereo, interleaved_out, num_frames);
+}
+
 void Envelope::Apply(const bool is_stereo, AudioFrame &frame)
 {
 	// Only start the envelope once our samples have actual values
@@ -100,7 +108,9 @@ void Envelope::Apply(const bool is_stereo, AudioFrame &frame)
 
 	// Should we deactivate the envelope?
 	if (++frames_done > expire_after_frames || edge >= edge_limit) {
-		process = &Envelope::Skip;
+		process       = &Envelope::Skip;
+		process_block = &Envelope::SkipBlock;
+		is_done       = true;
 		(void)channel_name; // [[maybe_unused]] in release builds
 		LOG_DEBUG("ENVELOPE: %s done after %u frames, peak sample was %.4f",
 		          channel_name.c_str(),
@@ -109,3 +119,42 @@ void Envelope::Apply(const bool is_stereo, AudioFrame &frame)
 	}
 }
 
+// Same per-frame maths as Apply, but run over a whole block so the active
+// phase pays one indirect call per chunk rather than per frame. Frames
+// after the expiry point pass through untouched, exactly as they would
+// through Skip.
+void Envelope::ApplyBlock(const bool is_stereo, float* interleaved_out,
+                          const int num_frames)
+{
+	int i = 0;
+
+	// Only start the envelope once our samples have actual values
+	if (frames_done == 0u) {
+		while (i < num_frames && interleaved_out[i * 2] == 0.0f) {
+			++i;
+		}
+	}
+
+	for (; i < num_frames; ++i) {
+		const float lip = edge + edge_increment;
+
+		const bool on_lip = ClampSample(interleaved_out[i * 2], lip) ||
+		                    (is_stereo &&
+		                     ClampSample(interleaved_out[i * 2 + 1], lip));
+		if (on_lip)
+			edge += edge_increment;
+
+		if (++frames_done > expire_after_frames || edge >= edge_limit) {
+			process       = &Envelope::Skip;
+			process_block = &Envelope::SkipBlock;
+			is_done       = true;
+			(void)channel_name; // [[maybe_unused]] in release builds
+			LOG_DEBUG("ENVELOPE: %s done after %u frames, peak sample was %.4f",
+			          channel_name.c_str(),
+			          frames_done,
+			          edge);
+			return;
+		}
+	}
+}
+
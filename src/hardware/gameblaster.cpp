@@ -21,6 +21,8 @@
 
 #include "gameblaster.h"
 
+#include <cmath>
+
 #include "channel_names.h"
 #include "pic.h"
 #include "setup.h"
@@ -132,37 +134,39 @@ void GameBlaster::Open(const int port_choice, const std::string &card_choice,
 	is_open = true;
 }
 
-bool GameBlaster::MaybeRenderFrame(AudioFrame &frame)
+void GameBlaster::RenderFrames(const int num_frames, std::vector<AudioFrame> &out)
 {
-	// Static containers set up once and reused
-	static std::array<int16_t, 2> buf = {}; // left and right
-	static int16_t *p_buf[]           = {&buf[0], &buf[1]};
+	// Static container set up once and reused
 	static device_sound_interface::sound_stream stream;
 
-	// Accumulate the samples from both SAA-1099 devices
-	devices[0]->sound_stream_update(stream, nullptr, p_buf, 1);
-	int left_accum = buf[0];
-	int right_accum = buf[1];
-
-	devices[1]->sound_stream_update(stream, nullptr, p_buf, 1);
-	left_accum += buf[0];
-	right_accum += buf[1];
-
-	// Increment our time datum up to which the device has rendered
-	last_rendered_ms += ms_per_render;
-
-	// Resample the limited frame
-	const auto l_ready = resamplers[0]->input(left_accum);
-	const auto r_ready = resamplers[1]->input(right_accum);
-	assert(l_ready == r_ready);
-	const auto frame_is_ready = l_ready && r_ready;
-
-	// Get the frame from the resampler
-	if (frame_is_ready) {
-		frame.left  = static_cast<float>(resamplers[0]->output());
-		frame.right = static_cast<float>(resamplers[1]->output());
+	auto frames_remaining = num_frames;
+	while (frames_remaining > 0) {
+		const auto frames = std::min(frames_remaining, chip_buffer_frames);
+
+		// Render a block of stereo samples from both SAA-1099 devices
+		int16_t *left_dev_bufs[]  = {chip_buffers[0].data(),
+		                             chip_buffers[1].data()};
+		int16_t *right_dev_bufs[] = {chip_buffers[2].data(),
+		                             chip_buffers[3].data()};
+		devices[0]->sound_stream_update(stream, nullptr, left_dev_bufs, frames);
+		devices[1]->sound_stream_update(stream, nullptr, right_dev_bufs, frames);
+
+		// Accumulate the devices' samples and resample them into frames
+		for (auto i = 0; i < frames; ++i) {
+			const int left_accum  = chip_buffers[0][i] + chip_buffers[2][i];
+			const int right_accum = chip_buffers[1][i] + chip_buffers[3][i];
+
+			const auto l_ready = resamplers[0]->input(left_accum);
+			const auto r_ready = resamplers[1]->input(right_accum);
+			assert(l_ready == r_ready);
+			if (l_ready && r_ready) {
+				out.emplace_back(AudioFrame{
+				        static_cast<float>(resamplers[0]->output()),
+				        static_cast<float>(resamplers[1]->output())});
+			}
+		}
+		frames_remaining -= frames;
 	}
-	return frame_is_ready;
 }
 
 void GameBlaster::RenderUpToNow()
@@ -175,12 +179,17 @@ void GameBlaster::RenderUpToNow()
 		last_rendered_ms = now;
 		return;
 	}
-	// Keep rendering until we're current
-	while (last_rendered_ms < now) {
-		last_rendered_ms += ms_per_render;
-		if (AudioFrame f = {}; MaybeRenderFrame(f))
-			fifo.emplace(f);
-	}
+	// Render a block covering the elapsed period and queue the frames
+	const auto frames_pending = static_cast<int>(
+	        std::ceil((now - last_rendered_ms) / ms_per_render));
+	if (frames_pending <= 0)
+		return;
+	last_rendered_ms += frames_pending * ms_per_render;
+
+	render_buffer.clear();
+	RenderFrames(frames_pending, render_buffer);
+	for (const auto &frame : render_buffer)
+		fifo.emplace(frame);
 }
 
 void GameBlaster::WriteDataToLeftDevice(io_port_t, io_val_t value, io_width_t)
@@ -217,17 +226,31 @@ void GameBlaster::AudioCallback(const uint16_t requested_frames)
 	auto frames_remaining = requested_frames;
 
 	// First, add any frames we've queued since the last callback
+	render_buffer.clear();
 	while (frames_remaining && fifo.size()) {
-		channel->AddSamples_sfloat(1, &fifo.front()[0]);
+		render_buffer.emplace_back(fifo.front());
 		fifo.pop();
 		--frames_remaining;
 	}
+	if (!render_buffer.empty()) {
+		channel->AddSamples_sfloat(check_cast<uint16_t>(render_buffer.size()),
+		                           &render_buffer[0][0]);
+	}
 	// If the queue's run dry, render the remainder and sync-up our time datum
-	while (frames_remaining) {
-		if (AudioFrame f = {}; MaybeRenderFrame(f)) {
-			channel->AddSamples_sfloat(1, &f[0]);
+	if (frames_remaining) {
+		if (devices[0]->is_silent() && devices[1]->is_silent()) {
+			// Both chips are programmed silent, so skip synthesis and
+			// let the channel's sleep feature idle the card
+			channel->AddSilence();
+		} else {
+			render_buffer.clear();
+			RenderFrames(frames_remaining, render_buffer);
+			if (!render_buffer.empty()) {
+				channel->AddSamples_sfloat(
+				        check_cast<uint16_t>(render_buffer.size()),
+				        &render_buffer[0][0]);
+			}
 		}
-		--frames_remaining;
 	}
 	last_rendered_ms = PIC_FullIndex();
 }
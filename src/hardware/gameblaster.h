@@ -49,8 +49,7 @@ public:
 
 private:
 	// Audio rendering
-	bool MaybeRenderFrame(AudioFrame &frame);
-	std::vector<int16_t> GetFrame();
+	void RenderFrames(int num_frames, std::vector<AudioFrame> &out);
 	void AudioCallback(const uint16_t requested_frames);
 	void RenderUpToNow();
 
@@ -80,6 +79,12 @@ private:
 
 	std::queue<AudioFrame> fifo = {};
 
+	// Scratch buffers for block rendering: the stereo chip samples (left
+	// and right per device) and the resampled frames headed to the mixer
+	static constexpr auto chip_buffer_frames = 128;
+	std::array<int16_t, chip_buffer_frames> chip_buffers[4] = {};
+	std::vector<AudioFrame> render_buffer                   = {};
+
 	// Static rate-related configuration
 	static constexpr auto chip_clock     = 14318180 / 2;
 	static constexpr auto render_divisor = 32;
@@ -119,6 +119,7 @@ struct VoiceCtrl {
 using address_array_t     = std::array<uint8_t, DMA_IRQ_ADDRESSES>;
 using pan_scalars_array_t = std::array<AudioFrame, PAN_POSITIONS>;
 using ram_array_t         = std::vector<uint8_t>;
+using ram_shadow_array_t  = std::vector<int16_t>;
 using read_io_array_t     = std::array<IO_ReadHandleObject, READ_HANDLERS>;
 using vol_scalars_array_t = std::array<float, VOLUME_LEVELS>;
 using write_io_array_t    = std::array<IO_WriteHandleObject, WRITE_HANDLERS>;
@@ -138,10 +139,13 @@ public:
 	Voice(Voice&&) = default;
 
 	void RenderFrames(const ram_array_t& ram,
+	                  const ram_shadow_array_t& ram_shadow,
 	                  const vol_scalars_array_t& vol_scalars,
 	                  const pan_scalars_array_t& pan_scalars,
+	                  std::vector<float>& scratch,
 	                  std::vector<AudioFrame>& frames);
 
+	bool IsPlaying() const noexcept;
 	uint8_t ReadVolState() const noexcept;
 	uint8_t ReadWaveState() const noexcept;
 	void ResetCtrls() noexcept;
@@ -164,10 +168,12 @@ private:
 	bool CheckWaveRolloverCondition() noexcept;
 	bool Is16Bit() const noexcept;
 	float GetVolScalar(const vol_scalars_array_t &vol_scalars);
-	float GetSample(const ram_array_t &ram) noexcept;
+	float GetSample(const ram_array_t &ram,
+	                const ram_shadow_array_t &ram_shadow) noexcept;
 	int32_t PopWavePos() noexcept;
 	float PopVolScalar(const vol_scalars_array_t &vol_scalars);
-	float Read8BitSample(const ram_array_t &ram, int32_t addr) const noexcept;
+	float Read8BitSample(const ram_shadow_array_t &ram_shadow,
+	                     int32_t addr) const noexcept;
 	float Read16BitSample(const ram_array_t &ram, int32_t addr) const noexcept;
 	uint8_t ReadCtrlState(const VoiceCtrl &ctrl) const noexcept;
 	void IncrementCtrlPos(VoiceCtrl &ctrl, bool skip_loop) noexcept;
@@ -239,6 +245,7 @@ private:
 	void CheckVoiceIrq();
 	uint32_t GetDmaOffset() noexcept;
 	void UpdateDmaAddr(uint32_t offset) noexcept;
+	void UpdateRamShadow(const size_t offset, const size_t num_bytes) noexcept;
 	void DmaCallback(const DmaChannel* chan, DMAEvent event);
 	void StartDmaTransfers();
 	bool IsDmaPcm16Bit() noexcept;
@@ -251,6 +258,7 @@ private:
 	void PopulatePanScalars() noexcept;
 	void PopulateVolScalars() noexcept;
 	void PrepareForPlayback() noexcept;
+	void RefreshPlayingVoices();
 	uint16_t ReadFromPort(io_port_t port, io_width_t width);
 
 	void RegisterIoHandlers();
@@ -272,11 +280,19 @@ private:
 	vol_scalars_array_t vol_scalars = {{}};
 	pan_scalars_array_t pan_scalars = {{}};
 	ram_array_t ram                 = {};
+	ram_shadow_array_t ram_shadow   = {};
 	read_io_array_t read_handlers   = {};
 	write_io_array_t write_handlers = {};
 	std::vector<Voice> voices       = {};
 	std::vector<AudioFrame> rendered_frames = {};
 
+	// The subset of active voices that are actually playing, refreshed
+	// when a voice-control register write marks it stale
+	std::vector<Voice*> playing_voices = {};
+
+	// Scratch buffer reused by each voice's per-block sample generation
+	std::vector<float> render_scratch = {};
+
 	const address_array_t dma_addresses = {
 	        {MIN_DMA_ADDRESS, 1, 3, 5, 6, MAX_IRQ_ADDRESS, 0, 0}};
 	const address_array_t irq_addresses = {
@@ -330,6 +346,7 @@ private:
 
 	bool dac_enabled = false;
 	bool irq_enabled = false;
+	bool playing_voices_stale = true;
 	bool irq_previously_interrupted = false;
 	bool is_running = false;
 	bool should_change_irq_dma      = false;
@@ -424,7 +441,8 @@ bool Voice::Is16Bit() const noexcept
 	return (wave_ctrl.state & CTRL::BIT16);
 }
 
-float Voice::GetSample(const ram_array_t &ram) noexcept
+float Voice::GetSample(const ram_array_t &ram,
+                       const ram_shadow_array_t &ram_shadow) noexcept
 {
 	const int32_t pos = PopWavePos();
 	const auto addr = pos / WAVE_WIDTH;
@@ -432,11 +450,12 @@ float Voice::GetSample(const ram_array_t &ram) noexcept
 	const bool should_interpolate = wave_ctrl.inc < WAVE_WIDTH && fraction;
 	const auto is_16bit = Is16Bit();
 	float sample = is_16bit ? Read16BitSample(ram, addr)
-	                        : Read8BitSample(ram, addr);
+	                        : Read8BitSample(ram_shadow, addr);
 	if (should_interpolate) {
 		const auto next_addr = addr + 1;
-		const float next_sample = is_16bit ? Read16BitSample(ram, next_addr)
-		                                   : Read8BitSample(ram, next_addr);
+		const float next_sample = is_16bit
+		                                ? Read16BitSample(ram, next_addr)
+		                                : Read8BitSample(ram_shadow, next_addr);
 		constexpr float WAVE_WIDTH_INV = 1.0 / WAVE_WIDTH;
 		sample += (next_sample - sample) *
 		          static_cast<float>(fraction) * WAVE_WIDTH_INV;
@@ -446,22 +465,36 @@ float Voice::GetSample(const ram_array_t &ram) noexcept
 	return sample;
 }
 
+bool Voice::IsPlaying() const noexcept
+{
+	return !(vol_ctrl.state & wave_ctrl.state & CTRL::DISABLED);
+}
+
 void Voice::RenderFrames(const ram_array_t& ram,
+                         const ram_shadow_array_t& ram_shadow,
                          const vol_scalars_array_t& vol_scalars,
                          const pan_scalars_array_t& pan_scalars,
+                         std::vector<float>& scratch,
                          std::vector<AudioFrame>& frames)
 {
-	if (vol_ctrl.state & wave_ctrl.state & CTRL::DISABLED)
+	if (!IsPlaying())
 		return;
 
 	const auto pan_scalar = pan_scalars.at(pan_position);
 
-	// Sum the voice's samples into the exising frames, angled in L-R space
-	for (auto& frame : frames) {
-		float sample = GetSample(ram);
-		sample *= PopVolScalar(vol_scalars);
-		frame.left += sample * pan_scalar.left;
-		frame.right += sample * pan_scalar.right;
+	// First generate the voice's volume-scaled samples into the scratch
+	// buffer; this pass walks the wave and volume controls, which can
+	// loop, reverse, and stop the voice
+	scratch.resize(frames.size());
+	for (auto& sample : scratch)
+		sample = GetSample(ram, ram_shadow) * PopVolScalar(vol_scalars);
+
+	// Then sum the span into the existing frames, angled in L-R space; a
+	// plain multiply-accumulate the compiler can vectorize
+	const auto num_frames = frames.size();
+	for (size_t i = 0; i < num_frames; ++i) {
+		frames[i].left += scratch[i] * pan_scalar.left;
+		frames[i].right += scratch[i] * pan_scalar.right;
 	}
 	// Keep track of how many ms this voice has generated
 	Is16Bit() ? generated_16bit_ms++ : generated_8bit_ms++;
@@ -485,14 +518,14 @@ float Voice::PopVolScalar(const vol_scalars_array_t &vol_scalars)
 	return vol_scalars.at(static_cast<size_t>(i));
 }
 
-// Read an 8-bit sample scaled into the 16-bit range, returned as a float
-float Voice::Read8BitSample(const ram_array_t &ram, const int32_t addr) const noexcept
+// Read an 8-bit sample pre-scaled into the 16-bit range, returned as a
+// float. The scaling happened once at upload time into the shadow, so the
+// hot voice loop is just an indexed load.
+float Voice::Read8BitSample(const ram_shadow_array_t &ram_shadow,
+                            const int32_t addr) const noexcept
 {
 	const auto i = static_cast<size_t>(addr) & 0xfffffu;
-	constexpr auto bits_in_16 = std::numeric_limits<int16_t>::digits;
-	constexpr auto bits_in_8 = std::numeric_limits<int8_t>::digits;
-	constexpr float to_16bit_range = 1 << (bits_in_16 - bits_in_8);
-	return static_cast<int8_t>(ram.at(i)) * to_16bit_range;
+	return ram_shadow.at(i);
 }
 
 // Read a 16-bit sample returned as a float
@@ -599,6 +632,7 @@ void Voice::WriteWaveRate(uint16_t val) noexcept
 Gus::Gus(const io_port_t port_pref, const uint8_t dma_pref, const uint8_t irq_pref,
          const char* ultradir, const std::string& filter_prefs)
         : ram(RAM_SIZE),
+          ram_shadow(RAM_SIZE),
           dma2(dma_pref),
           irq1(irq_pref),
           irq2(irq_pref)
@@ -672,7 +706,24 @@ void Gus::ActivateVoices(uint8_t requested_voices)
 		ms_per_render = millis_in_second / frame_rate_hz;
 
 		audio_channel->SetSampleRate(frame_rate_hz);
+		playing_voices_stale = true;
+	}
+}
+
+// Rebuild the list of voices worth rendering. Voices that stop themselves
+// mid-block stay listed until the next control write, which is harmless as
+// they bail out of RenderFrames immediately.
+void Gus::RefreshPlayingVoices()
+{
+	playing_voices.clear();
+	auto voice = voices.begin();
+	const auto last_voice = voice + active_voices;
+	while (voice < last_voice) {
+		if (voice->IsPlaying())
+			playing_voices.emplace_back(&(*voice));
+		++voice;
 	}
+	playing_voices_stale = false;
 }
 
 const std::vector<AudioFrame>& Gus::RenderFrames(const int num_requested_frames)
@@ -684,16 +735,16 @@ const std::vector<AudioFrame>& Gus::RenderFrames(const int num_requested_frames)
 	}
 
 	if (dac_enabled) {
-		auto voice = voices.begin();
-		const auto last_voice = voice + active_voices;
-		while (voice < last_voice) {
+		if (playing_voices_stale)
+			RefreshPlayingVoices();
+		for (auto* voice : playing_voices) {
 			// Render all of the requested frames from each voice
 			// before moving onto the next voice. This ensures each
 			// voice can deliver all its samples without being
 			// affected by state changes that (might) occur when
 			// rendering subsequent voices.
-			voice->RenderFrames(ram, vol_scalars, pan_scalars, rendered_frames);
-			++voice;
+			voice->RenderFrames(ram, ram_shadow, vol_scalars, pan_scalars,
+			                    render_scratch, rendered_frames);
 		}
 	}
 	// If the DAC isn't enabled we still check the IRQ return a silent vector
@@ -859,6 +910,23 @@ void Gus::UpdateDmaAddr(uint32_t offset) noexcept
 	dma_addr_nibble = check_cast<uint8_t>(adjusted & 0xf);
 }
 
+// Re-convert an updated region of wave RAM into the 16-bit shadow, which
+// holds every byte pre-scaled into the 16-bit range for the 8-bit voice
+// read path. Called once per DMA batch and per poked byte, so voice
+// rendering never converts
+void Gus::UpdateRamShadow(const size_t offset, const size_t num_bytes) noexcept
+{
+	constexpr auto bits_in_16 = std::numeric_limits<int16_t>::digits;
+	constexpr auto bits_in_8  = std::numeric_limits<int8_t>::digits;
+	constexpr int16_t to_16bit_range = 1 << (bits_in_16 - bits_in_8);
+
+	const auto end = std::min(offset + num_bytes, ram.size());
+	for (auto i = offset; i < end; ++i) {
+		ram_shadow[i] = static_cast<int16_t>(
+		        static_cast<int8_t>(ram[i]) * to_16bit_range);
+	}
+}
+
 bool Gus::PerformDmaTransfer()
 {
 	if (dma_channel->is_masked || !(dma_ctrl & 0x01)) {
@@ -909,6 +977,12 @@ bool Gus::PerformDmaTransfer()
 			ram_pos += skip;
 		}
 	}
+	// Refresh the converted-sample shadow over the uploaded region (after
+	// any MSB inversion, which changes the bytes the shadow derives from)
+	if (is_reading) {
+		UpdateRamShadow(offset, bytes_transfered);
+	}
+
 	// Raise the TC irq if needed
 	if ((dma_ctrl & 0x20) != 0) {
 		// We've hit the terminal count, so enable that bit
@@ -1067,6 +1141,7 @@ void Gus::PrepareForPlayback() noexcept
 	// Initialize the voice states
 	for (auto &voice : voices)
 		voice.ResetCtrls();
+	playing_voices_stale = true;
 
 	// Initialize the OPL emulator state
 	adlib_command_reg = ADLIB_CMD_DEFAULT;
@@ -1298,6 +1373,7 @@ void Gus::StopPlayback()
 	target_voice = nullptr;
 	voice_index = 0u;
 	active_voices = 0u;
+	playing_voices_stale = true;
 
 	UpdateDmaAddr(0);
 	dram_addr = 0u;
@@ -1423,8 +1499,10 @@ void Gus::WriteToPort(io_port_t port, io_val_t value, io_width_t width)
 		WriteToRegister();
 		break;
 	case 0x307:
-		if (dram_addr < ram.size())
+		if (dram_addr < ram.size()) {
 			ram.at(dram_addr) = static_cast<uint8_t>(val);
+			UpdateRamShadow(dram_addr, 1);
+		}
 		break;
 	default:
 #if LOG_GUS
@@ -1535,6 +1613,7 @@ void Gus::WriteToRegister()
 	case 0x0: // Voice wave control register
 		if (target_voice->UpdateWaveState(register_data >> 8))
 			CheckVoiceIrq();
+		playing_voices_stale = true;
 		break;
 	case 0x1: // Voice rate control register
 		target_voice->WriteWaveRate(register_data);
@@ -1584,6 +1663,7 @@ void Gus::WriteToRegister()
 	case 0xd: // Voice volume control register
 		if (target_voice->UpdateVolState(register_data >> 8))
 			CheckVoiceIrq();
+		playing_voices_stale = true;
 		break;
 	default:
 #if LOG_GUS
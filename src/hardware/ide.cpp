@@ -35,6 +35,8 @@ static void ide_altio_w(io_port_t port, io_val_t val, io_width_t width);
 static uint32_t ide_altio_r(io_port_t port, io_width_t width);
 static void ide_baseio_w(io_port_t port, io_val_t val, io_width_t width);
 static uint32_t ide_baseio_r(io_port_t port, io_width_t width);
+static size_t ide_baseio_str_r(io_port_t port, uint32_t addr, size_t items, io_width_t width);
+static size_t ide_baseio_str_w(io_port_t port, uint32_t addr, size_t items, io_width_t width);
 bool GetMSCDEXDrive(uint8_t drive_letter, CDROM_Interface **_cdrom);
 
 enum IDEDeviceType { IDE_TYPE_NONE, IDE_TYPE_HDD = 1, IDE_TYPE_CDROM };
@@ -150,6 +152,10 @@ public:
 	virtual void writecommand(uint8_t cmd);
 	virtual uint32_t data_read(io_width_t width);          /* read from 1F0h data port from IDE device */
 	virtual void data_write(uint32_t v, io_width_t width); /* write to 1F0h data port to IDE device */
+	/* bulk REP INSW/OUTSW transfers against the data port; return how many
+	   items were moved, 0 to fall back to per-unit port access */
+	virtual size_t data_read_bulk(PhysPt addr, size_t items, io_width_t width);
+	virtual size_t data_write_bulk(PhysPt addr, size_t items, io_width_t width);
 	virtual bool command_interruption_ok(uint8_t cmd);
 	virtual void abort_silent();
 };
@@ -176,6 +182,8 @@ public:
 	uint32_t data_read(io_width_t width) override;
 	/* write to 1F0h data port to IDE device */
 	void data_write(uint32_t v, io_width_t width) override;
+	size_t data_read_bulk(PhysPt addr, size_t items, io_width_t width) override;
+	size_t data_write_bulk(PhysPt addr, size_t items, io_width_t width) override;
 	virtual void generate_identify_device();
 	virtual void prepare_read(uint32_t offset, uint32_t size);
 	virtual void prepare_write(uint32_t offset, uint32_t size);
@@ -234,6 +242,8 @@ public:
 	uint32_t data_read(io_width_t width) override;
 	/* write to 1F0h data port to IDE device */
 	void data_write(uint32_t v, io_width_t width) override;
+	/* PACKET command writes stay on the per-unit path */
+	size_t data_read_bulk(PhysPt addr, size_t items, io_width_t width) override;
 	virtual void generate_identify_device();
 	virtual void generate_mmc_inquiry();
 	virtual void prepare_read(uint32_t offset, uint32_t size);
@@ -275,6 +285,9 @@ public:
 	std::string id_mmc_product_rev = "0.83-X";
 	uint32_t LBA = 0;
 	uint32_t TransferLength = 0;
+	/* where the next READ would land if the guest keeps streaming
+	   sequentially; used to drive the cdrom layer's read-ahead hint */
+	uint32_t next_sequential_lba = 0;
 	int loading_mode = LOAD_IDLE;
 	bool has_changed = false;
 
@@ -1130,6 +1143,18 @@ void IDEATAPICDROMDevice::on_atapi_busy_time()
 				feature = 0x00;
 				state = IDE_DEV_DATA_READ;
 				status = IDE_STATUS_DRIVE_READY | IDE_STATUS_DRQ | IDE_STATUS_DRIVE_SEEK_COMPLETE;
+
+				/* FMV titles stream sequential READs; once the
+				   trajectory is established, hint the next
+				   stretch so the cdrom layer can stage it
+				   before the guest asks for it */
+				if (LBA == next_sequential_lba) {
+					const uint32_t ahead = std::min(
+					        TransferLength * 4u, 128u);
+					cdrom->ReadAheadHost(LBA + TransferLength,
+					                     ahead);
+				}
+				next_sequential_lba = LBA + TransferLength;
 			} else {
 				feature = 0xF4;   /* abort sense=0xF */
 				count = 0x03;     /* no more transfer */
@@ -1553,6 +1578,29 @@ uint32_t IDEATAPICDROMDevice::data_read(io_width_t width)
 	return w;
 }
 
+size_t IDEATAPICDROMDevice::data_read_bulk(const PhysPt addr, size_t items,
+                                           const io_width_t width)
+{
+	if (state != IDE_DEV_DATA_READ || !(status & IDE_STATUS_DRQ))
+		return 0;
+
+	const auto item_size = static_cast<uint8_t>(width);
+	if (sector_i >= sector_total)
+		return 0;
+
+	items = std::min(items, static_cast<size_t>(sector_total - sector_i) / item_size);
+	if (items == 0)
+		return 0;
+
+	MEM_BlockWrite(addr, sector + sector_i, items * item_size);
+	sector_i += check_cast<uint32_t>(items * item_size);
+
+	if (sector_i >= sector_total)
+		io_completion();
+
+	return items;
+}
+
 /* TBD: Your code should also be paying attention to the "transfer length" field
          in many of the commands here. Right now it doesn't matter. */
 void IDEATAPICDROMDevice::atapi_cmd_completion()
@@ -1867,6 +1915,50 @@ uint32_t IDEATADevice::data_read(io_width_t width)
 	return w;
 }
 
+size_t IDEATADevice::data_read_bulk(const PhysPt addr, size_t items, const io_width_t width)
+{
+	if (state != IDE_DEV_DATA_READ || !(status & IDE_STATUS_DRQ))
+		return 0;
+
+	const auto item_size = static_cast<uint8_t>(width);
+	if (sector_i >= sector_total)
+		return 0;
+
+	items = std::min(items, static_cast<size_t>(sector_total - sector_i) / item_size);
+	if (items == 0)
+		return 0;
+
+	MEM_BlockWrite(addr, sector + sector_i, items * item_size);
+	sector_i += check_cast<uint32_t>(items * item_size);
+
+	if (sector_i >= sector_total)
+		io_completion();
+
+	return items;
+}
+
+size_t IDEATADevice::data_write_bulk(const PhysPt addr, size_t items, const io_width_t width)
+{
+	if (state != IDE_DEV_DATA_WRITE || !(status & IDE_STATUS_DRQ))
+		return 0;
+
+	const auto item_size = static_cast<uint8_t>(width);
+	if (sector_i >= sector_total)
+		return 0;
+
+	items = std::min(items, static_cast<size_t>(sector_total - sector_i) / item_size);
+	if (items == 0)
+		return 0;
+
+	MEM_BlockRead(addr, sector + sector_i, items * item_size);
+	sector_i += check_cast<uint32_t>(items * item_size);
+
+	if (sector_i >= sector_total)
+		io_completion();
+
+	return items;
+}
+
 void IDEATADevice::data_write(uint32_t v, io_width_t width)
 {
 	if (state != IDE_DEV_DATA_WRITE) {
@@ -3408,6 +3500,16 @@ uint32_t IDEDevice::data_read(io_width_t)
 void IDEDevice::data_write(io_val_t, io_width_t)
 {}
 
+size_t IDEDevice::data_read_bulk(PhysPt, size_t, io_width_t)
+{
+	return 0;
+}
+
+size_t IDEDevice::data_write_bulk(PhysPt, size_t, io_width_t)
+{
+	return 0;
+}
+
 /* IDE controller -> upon writing bit 2 of alt (0x3F6) */
 void IDEDevice::host_reset_complete()
 {
@@ -3837,6 +3939,10 @@ void IDEController::install_io_ports()
 			WriteHandler[i].Install(base_io + i, ide_baseio_w, io_width_t::dword);
 			ReadHandler[i].Install(base_io + i, ide_baseio_r, io_width_t::dword);
 		}
+
+		/* whole-sector REP INSW/OUTSW transfers on the data port */
+		IO_RegisterStringReadHandler(base_io, ide_baseio_str_r);
+		IO_RegisterStringWriteHandler(base_io, ide_baseio_str_w);
 	}
 
 	if (alt_io != 0) {
@@ -3857,6 +3963,10 @@ void IDEController::uninstall_io_ports()
 	for (auto & h : ReadHandler)
 		h.Uninstall();
 
+	// Uninstall the bulk string handlers on the data port
+	IO_FreeStringReadHandler(base_io);
+	IO_FreeStringWriteHandler(base_io);
+
 	// Uninstall the two sets of alternate I/O ports
 	assert(alt_io != 0);
 	for (auto & h : WriteHandlerAlt)
@@ -4100,3 +4210,31 @@ static void ide_baseio_w(io_port_t port, io_val_t val, io_width_t width)
 		break;
 	}
 }
+
+/* Bulk REP INSW/OUTSW transfers against the data port (see inout.h);
+   returning 0 drops the transfer back to per-word port access */
+static size_t ide_baseio_str_r(io_port_t port, uint32_t addr, size_t items, io_width_t width)
+{
+	IDEController *ide = match_ide_controller(port);
+
+	if (ide == nullptr)
+		return 0;
+	if (width == io_width_t::dword && (!ide->enable_pio32 || ide->ignore_pio32))
+		return 0;
+
+	IDEDevice *dev = ide->device[ide->select];
+	return (dev != nullptr) ? dev->data_read_bulk(addr, items, width) : 0;
+}
+
+static size_t ide_baseio_str_w(io_port_t port, uint32_t addr, size_t items, io_width_t width)
+{
+	IDEController *ide = match_ide_controller(port);
+
+	if (ide == nullptr)
+		return 0;
+	if (width == io_width_t::dword && (!ide->enable_pio32 || ide->ignore_pio32))
+		return 0;
+
+	IDEDevice *dev = ide->device[ide->select];
+	return (dev != nullptr) ? dev->data_write_bulk(addr, items, width) : 0;
+}
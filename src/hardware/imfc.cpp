@@ -2159,11 +2159,26 @@ private:
 	CounterData m_counter1{"timer.counter1"};
 	CounterData m_counter2{"timer.counter2"};
 
-	static void registerNextEvent()
+	// The counter0 has a resolution of 2 microseconds per count
+	static constexpr double ms_per_count = 0.002;
+
+	static void registerEventAfterCounts(const unsigned int counts)
 	{
 		// PIC_AddEvent takes milliseconds as argument
-		// the counter0 has a resolution of 2 microseconds
-		PIC_AddEvent(Intel8253_TimerEvent, 0.002, 0); // FIXME
+		PIC_AddEvent(Intel8253_TimerEvent, counts * ms_per_count, 0);
+	}
+
+	void restartCounter0()
+	{
+		// (Re)start the output pulse train from the top of the count;
+		// events are only scheduled at the output transitions instead
+		// of polling at every 2-microsecond count
+		PIC_RemoveEvents(Intel8253_TimerEvent);
+		m_timerA.setValue(true);
+		m_counter0.m_runningCounter = m_counter0.m_counter;
+		if (m_counter0.m_counter != 0U) {
+			registerEventAfterCounts(m_counter0.m_counter);
+		}
 	}
 
 public:
@@ -2174,7 +2189,7 @@ public:
 
 	explicit Intel8253(const std::string& name) : m_name(name)
 	{
-		Intel8253::registerNextEvent(); // FIXME
+		// No event is scheduled until counter0 is programmed
 	}
 	DataProvider<bool>* getTimerA() const
 	{
@@ -2201,6 +2216,11 @@ public:
 	{
 		IMF_LOG("writePortCNTR0 / value=0x%X", val);
 		m_counter0.writeCounterByte(val);
+		// A completed 16-bit write reloads the counter and schedules
+		// the next output transition
+		if (m_counter0.m_nextWriteTarget == COUNTERWRITETARGET_BYTE1) {
+			restartCounter0();
+		}
 	}
 
 	uint8_t readPortCNTR1()
@@ -2285,40 +2305,33 @@ public:
 
 	void timerEvent(uint32_t /*val*/)
 	{
-		if (m_counter0.m_counter != 0U) {
-			// counter was initialized with a value
-			if (m_counter0.m_runningCounter > 1) {
-				// normal case -> decrease the counter
-				m_counter0.m_runningCounter--;
-				// IMF_LOG("m_counter0.m_runningCounter -> %i",
-				// m_counter0.m_runningCounter);
-			} else if (m_counter0.m_runningCounter == 1) {
-				// if the counter is 1, then the timer out goes LOW
-				if (m_debug) {
-					IMF_LOG("%s - m_runningCounter == 1 -> m_timerA = LOW",
-					        m_name.c_str());
-				}
-				m_timerA.setValue(false);
-				m_counter0.m_runningCounter--;
-				// IMF_LOG("m_counter0.m_runningCounter -> %i",
-				// m_counter0.m_runningCounter);
-				// IMF_LOG("m_timerA.OUT is going LOW");
-			} else {
-				// if the counter is 0, then the timer out does
-				// HIGH again
-				if (m_debug) {
-					IMF_LOG("%s - m_runningCounter == 0 -> m_timerA = HIGH",
-					        m_name.c_str());
-				}
-				m_timerA.setValue(true);
-				m_counter0.m_runningCounter = m_counter0.m_counter;
-				// IMF_LOG("m_counter0.m_runningCounter -> %i",
-				// m_counter0.m_runningCounter);
-				// IMF_LOG("m_timerA.OUT is going HIGH");
+		if (m_counter0.m_counter == 0U) {
+			// counter isn't initialized with a value; stay idle
+			// until it's programmed again
+			return;
+		}
+		if (m_counter0.m_runningCounter != 0U) {
+			// the count has elapsed, so the timer out goes LOW for
+			// one count
+			if (m_debug) {
+				IMF_LOG("%s - count elapsed -> m_timerA = LOW",
+				        m_name.c_str());
+			}
+			m_timerA.setValue(false);
+			m_counter0.m_runningCounter = 0;
+			registerEventAfterCounts(1);
+		} else {
+			// after one low count the timer out goes HIGH again
+			// and the counter reloads
+			if (m_debug) {
+				IMF_LOG("%s - reload -> m_timerA = HIGH",
+				        m_name.c_str());
 			}
+			m_timerA.setValue(true);
+			m_counter0.m_runningCounter = m_counter0.m_counter;
+			registerEventAfterCounts(m_counter0.m_counter);
 		}
 		// TODO: the other timers
-		Intel8253::registerNextEvent(); // FIXME
 	}
 };
 
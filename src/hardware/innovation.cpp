@@ -21,6 +21,8 @@
 
 #include "innovation.h"
 
+#include <algorithm>
+
 #include "channel_names.h"
 #include "checks.h"
 #include "control.h"
@@ -29,6 +31,12 @@
 
 CHECK_NARROWING();
 
+// Upper bound on chip cycles clocked per batch, which also bounds the
+// scratch buffer sizes. At the default chip clock this is under 5 ms of
+// audio, so catching up after a long gap still happens in a handful of
+// calls.
+constexpr uint32_t max_render_cycles = 4096;
+
 void Innovation::Open(const std::string_view model_choice,
                       const std::string_view clock_choice,
                       const int filter_strength_6581,
@@ -104,6 +112,7 @@ void Innovation::Open(const std::string_view model_choice,
 	}
 
 	const auto frame_rate_hz = mixer_channel->GetSampleRate();
+	clocks_per_frame         = chip_clock / frame_rate_hz;
 
 	// Determine the passband frequency, which is capped at 90% of Nyquist.
 	const double passband = 0.9 * frame_rate_hz / 2;
@@ -195,27 +204,32 @@ void Innovation::RenderUpToNow()
 		last_rendered_ms = now;
 		return;
 	}
-	// Keep rendering until we're current
+	// Keep rendering until we're current, clocking the chip over the
+	// whole elapsed span in batches instead of one cycle at a time. The
+	// writes are still cycle-positioned because every port write renders
+	// up to 'now' before it's applied.
 	while (last_rendered_ms < now) {
-		last_rendered_ms += ms_per_clock;
-		if (float frame = 0.0f; MaybeRenderFrame(frame))
-			fifo.emplace(frame);
+		const auto pending_clocks = static_cast<uint32_t>(std::min<double>(
+		        (now - last_rendered_ms) / ms_per_clock + 1, max_render_cycles));
+
+		const auto num_frames = RenderCycles(pending_clocks);
+		for (uint32_t i = 0; i < num_frames; ++i)
+			fifo.emplace(static_cast<float>(render_buf[i] * 2));
+
+		last_rendered_ms += pending_clocks * ms_per_clock;
 	}
 }
 
-bool Innovation::MaybeRenderFrame(float &frame)
+// Clock the chip forward by the given number of cycles into the render
+// buffer, and return the number of frames the resampler produced
+uint32_t Innovation::RenderCycles(const uint32_t cycles)
 {
 	assert(service);
+	assert(cycles <= max_render_cycles);
 
-	int16_t sample = {0};
-
-	const auto frame_is_ready = service->clock(1, &sample);
-
-	// Get the frame
-	if (frame_is_ready)
-		frame = static_cast<float>(sample * 2);
-
-	return frame_is_ready;
+	// The resampler can't produce more frames than cycles clocked
+	render_buf.resize(cycles);
+	return check_cast<uint32_t>(service->clock(cycles, render_buf.data()));
 }
 
 void Innovation::AudioCallback(const uint16_t requested_frames)
@@ -228,17 +242,37 @@ void Innovation::AudioCallback(const uint16_t requested_frames)
 	auto frames_remaining = requested_frames;
 
 	// First, send any frames we've queued since the last callback
-	while (frames_remaining && fifo.size()) {
-		channel->AddSamples_mfloat(1, &fifo.front());
-		fifo.pop();
-		--frames_remaining;
+	if (!fifo.empty()) {
+		const auto queued = check_cast<uint16_t>(
+		        std::min<size_t>(frames_remaining, fifo.size()));
+		frame_buf.resize(queued);
+		for (auto &frame : frame_buf) {
+			frame = fifo.front();
+			fifo.pop();
+		}
+		channel->AddSamples_mfloat(queued, frame_buf.data());
+		frames_remaining = check_cast<uint16_t>(frames_remaining - queued);
 	}
-	// If the queue's run dry, render the remainder and sync-up our time datum
+	// If the queue's run dry, render the remainder in clocked batches and
+	// sync-up our time datum
 	while (frames_remaining) {
-		if (float frame = 0.0f; MaybeRenderFrame(frame)) {
-			channel->AddSamples_mfloat(1, &frame);
-		}
-		--frames_remaining;
+		const auto cycles = static_cast<uint32_t>(std::min<double>(
+		        frames_remaining * clocks_per_frame + 1, max_render_cycles));
+
+		const auto num_frames = RenderCycles(cycles);
+		frame_buf.resize(num_frames);
+		for (uint32_t i = 0; i < num_frames; ++i)
+			frame_buf[i] = static_cast<float>(render_buf[i] * 2);
+
+		const auto num_to_send = check_cast<uint16_t>(
+		        std::min<uint32_t>(num_frames, frames_remaining));
+		channel->AddSamples_mfloat(num_to_send, frame_buf.data());
+
+		// Queue any overshoot for the next callback
+		for (uint32_t i = num_to_send; i < num_frames; ++i)
+			fifo.emplace(frame_buf[i]);
+
+		frames_remaining = check_cast<uint16_t>(frames_remaining - num_to_send);
 	}
 	last_rendered_ms = PIC_FullIndex();
 }
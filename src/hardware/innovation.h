@@ -26,6 +26,7 @@
 #include <memory>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include "mixer.h"
 #include "inout.h"
@@ -46,9 +47,9 @@ public:
 	}
 
 private:
-	bool MaybeRenderFrame(float &frame);
 	void AudioCallback(const uint16_t requested_frames);
 	uint8_t ReadFromPort(io_port_t port, io_width_t width);
+	uint32_t RenderCycles(const uint32_t cycles);
 	void RenderUpToNow();
 	int16_t TallySilence(const int16_t sample);
 	void WriteToPort(io_port_t port, io_val_t value, io_width_t width);
@@ -60,9 +61,14 @@ private:
 	std::unique_ptr<reSIDfp::SID> service = {};
 	std::queue<float> fifo                = {};
 
+	// Scratch buffers reused by the batched chip-clocking calls
+	std::vector<int16_t> render_buf = {};
+	std::vector<float> frame_buf    = {};
+
 	// Initial configuration
 	double chip_clock            = 0.0;
 	double ms_per_clock          = 0.0;
+	double clocks_per_frame      = 0.0;
 	io_port_t base_port          = 0;
 	int idle_after_silent_frames = 0;
 
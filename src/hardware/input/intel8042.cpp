@@ -1169,6 +1169,16 @@ bool I8042_IsReadyForKbdFrame()
 	return !waiting_bytes_from_kbd && !is_disabled_kbd && !is_diagnostic_dump;
 }
 
+size_t I8042_GetKbdFrameCapacity()
+{
+	if (is_disabled_kbd || is_diagnostic_dump) {
+		return 0;
+	}
+
+	return (buffer_num_used < BufferSize) ? (BufferSize - buffer_num_used)
+	                                      : 0;
+}
+
 // ***************************************************************************
 // Initialization
 // ***************************************************************************
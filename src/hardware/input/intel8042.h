@@ -21,6 +21,7 @@
 #ifndef DOSBOX_INTEL_8042_H
 #define DOSBOX_INTEL_8042_H
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -38,6 +39,10 @@ void I8042_AddKbdFrame(const std::vector<uint8_t>& bytes);
 bool I8042_IsReadyForAuxFrame();
 bool I8042_IsReadyForKbdFrame();
 
+// Number of scancode bytes the controller buffer can still accept;
+// allows the keyboard to burst several queued frames in one go
+size_t I8042_GetKbdFrameCapacity();
+
 // The following routines needs to be implemented by keyboard/mouse
 // emulation code:
 
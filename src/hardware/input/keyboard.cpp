@@ -172,16 +172,35 @@ static void warn_waiting_for_secure_mode()
 // keyboard buffer support
 // ***************************************************************************
 
+static void pop_transfer_frame()
+{
+	I8042_AddKbdFrame(buffer[buffer_start_idx]);
+
+	--buffer_num_used;
+	buffer_start_idx = (buffer_start_idx + 1) % buffer_size;
+}
+
 static void maybe_transfer_buffer()
 {
 	if (!buffer_num_used || !I8042_IsReadyForKbdFrame()) {
 		return;
 	}
 
-	I8042_AddKbdFrame(buffer[buffer_start_idx]);
+	pop_transfer_frame();
 
-	--buffer_num_used;
-	buffer_start_idx = (buffer_start_idx + 1) % buffer_size;
+	// If the keyboard is plainly scanning (no command waiting for a
+	// parameter), hand the controller as many already queued frames as
+	// fit into its buffer - this drains scripted input (like AUTOTYPE)
+	// in bursts, with a single readiness notification per burst instead
+	// of one per scancode
+	if (current_command != Command::None || !is_scanning) {
+		return;
+	}
+
+	while (buffer_num_used &&
+	       buffer[buffer_start_idx].size() <= I8042_GetKbdFrameCapacity()) {
+		pop_transfer_frame();
+	}
 }
 
 static void buffer_add(const std::vector<uint8_t>& scan_code)
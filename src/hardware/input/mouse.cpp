@@ -579,10 +579,10 @@ void MOUSE_EventMoved(const float x_rel, const float y_rel,
 	const float y_scaled = y_rel * mouse_config.sensitivity_coeff_y;
 	for (auto& interface : mouse_interfaces) {
 		if (interface->IsUsingHostPointer()) {
-			interface->NotifyMoved(x_scaled,
-			                       y_scaled,
-			                       state.cursor_x_abs,
-			                       state.cursor_y_abs);
+			interface->EventMoved(x_scaled,
+			                      y_scaled,
+			                      state.cursor_x_abs,
+			                      state.cursor_y_abs);
 		}
 	}
 }
@@ -602,7 +602,7 @@ void MOUSE_EventMoved(const float x_rel, const float y_rel,
 	if (interface && interface->IsUsingEvents()) {
 		const float x_scaled = x_rel * mouse_config.sensitivity_coeff_x;
 		const float y_scaled = y_rel * mouse_config.sensitivity_coeff_y;
-		interface->NotifyMoved(x_scaled, y_scaled, 0, 0);
+		interface->EventMoved(x_scaled, y_scaled, 0, 0);
 	}
 }
 
@@ -644,7 +644,7 @@ void MOUSE_EventButton(const MouseButtonId button_id, const bool pressed)
 	// Notify mouse interfaces
 	for (auto& interface : mouse_interfaces) {
 		if (interface->IsUsingHostPointer()) {
-			interface->NotifyButton(button_id, pressed);
+			interface->EventButton(button_id, pressed);
 		}
 	}
 }
@@ -664,7 +664,7 @@ void MOUSE_EventButton(const MouseButtonId button_id, const bool pressed,
 	// Notify mouse interface
 	auto interface = MouseInterface::Get(interface_id);
 	if (interface && interface->IsUsingEvents()) {
-		interface->NotifyButton(button_id, pressed);
+		interface->EventButton(button_id, pressed);
 	}
 }
 
@@ -680,7 +680,7 @@ void MOUSE_EventWheel(const int16_t w_rel)
 	// Notify mouse interfaces
 	for (auto& interface : mouse_interfaces) {
 		if (interface->IsUsingHostPointer()) {
-			interface->NotifyWheel(w_rel);
+			interface->EventWheel(w_rel);
 		}
 	}
 }
@@ -697,7 +697,7 @@ void MOUSE_EventWheel(const int16_t w_rel, const MouseInterfaceId interface_id)
 	// Notify mouse interface
 	auto interface = MouseInterface::Get(interface_id);
 	if (interface && interface->IsUsingEvents()) {
-		interface->NotifyWheel(w_rel);
+		interface->EventWheel(w_rel);
 	}
 }
 
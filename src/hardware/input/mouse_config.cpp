@@ -272,6 +272,9 @@ static void config_read(Section *section)
 	mouse_config.raw_input      = conf->Get_bool("mouse_raw_input");
 	mouse_config.dos_immediate  = conf->Get_bool("dos_mouse_immediate");
 
+	mouse_config.coalescing_rate_hz = static_cast<uint16_t>(
+	        conf->Get_int("mouse_coalescing_rate"));
+
 	// Settings below should be read only once
 
 	if (mouse_shared.ready_config) {
@@ -376,6 +379,17 @@ static void config_init(Section_prop &secprop)
 	        "settings (enabled by default). Works in fullscreen or when the mouse is\n"
 	        "captured in windowed mode.");
 
+	Prop_int* prop_int = secprop.Add_int("mouse_coalescing_rate", always, 1000);
+	assert(prop_int);
+	prop_int->SetMinMax(0, 1000);
+	prop_int->Set_help(
+	        "Maximum rate, in Hz, at which mouse movements are delivered to the emulated\n"
+	        "mice (1000 by default, meaning once per emulated millisecond). Host events\n"
+	        "arriving faster - typical for gaming mice - get their movement deltas merged,\n"
+	        "which prevents high-rate mice from flooding the emulated interrupt machinery.\n"
+	        "Button and wheel events are never delayed or reordered. Set to 0 to disable\n"
+	        "coalescing and pass every host event through individually.");
+
 	// DOS driver configuration
 
 	prop_bool = secprop.Add_bool("dos_mouse_driver", only_at_start, true);
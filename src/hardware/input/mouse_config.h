@@ -85,6 +85,10 @@ struct MouseConfig {
 	bool raw_input           = false; // true = relative input is raw data
 	bool multi_display_aware = false;
 
+	// Maximum rate motion events are delivered to the emulated mice;
+	// host events above this rate get their deltas merged, 0 disables
+	uint16_t coalescing_rate_hz = 1000;
+
 	bool dos_driver    = false; // whether DOS virtual mouse driver should be enabled
 	bool dos_immediate = false;
 
@@ -26,6 +26,7 @@
 #include "mouse_manymouse.h"
 
 #include "checks.h"
+#include "pic.h"
 
 CHECK_NARROWING();
 
@@ -396,6 +397,75 @@ void MouseInterface::NotifyInterfaceRate(const uint16_t new_rate_hz)
 	UpdateRate();
 }
 
+static void flush_pending_motion_handler(const uint32_t val)
+{
+	const auto interface = MouseInterface::Get(static_cast<MouseInterfaceId>(val));
+	if (interface) {
+		interface->FlushPendingMotion();
+	}
+}
+
+void MouseInterface::EventMoved(const float x_rel, const float y_rel,
+                                const uint32_t x_abs, const uint32_t y_abs)
+{
+	const auto rate_limit_hz = mouse_config.coalescing_rate_hz;
+	if (rate_limit_hz == 0) {
+		// Coalescing disabled, pass the event through
+		NotifyMoved(x_rel, y_rel, x_abs, y_abs);
+		return;
+	}
+
+	// Merge with movement not delivered yet; the absolute position is
+	// not a delta, the latest one simply wins
+	pending_x_rel = MOUSE_ClampRelativeMovement(pending_x_rel + x_rel);
+	pending_y_rel = MOUSE_ClampRelativeMovement(pending_y_rel + y_rel);
+	pending_x_abs = x_abs;
+	pending_y_abs = y_abs;
+
+	has_pending_motion = true;
+
+	if (!flush_scheduled) {
+		flush_scheduled = true;
+		PIC_AddEvent(flush_pending_motion_handler,
+		             1000.0 / rate_limit_hz,
+		             GetInterfaceIdx());
+	}
+}
+
+void MouseInterface::EventButton(const MouseButtonId id, const bool pressed)
+{
+	DeliverPendingMotion();
+	NotifyButton(id, pressed);
+}
+
+void MouseInterface::EventWheel(const int16_t w_rel)
+{
+	DeliverPendingMotion();
+	NotifyWheel(w_rel);
+}
+
+void MouseInterface::FlushPendingMotion()
+{
+	flush_scheduled = false;
+	DeliverPendingMotion();
+}
+
+void MouseInterface::DeliverPendingMotion()
+{
+	if (!has_pending_motion) {
+		return;
+	}
+	has_pending_motion = false;
+
+	const auto x_rel = pending_x_rel;
+	const auto y_rel = pending_y_rel;
+
+	pending_x_rel = 0.0f;
+	pending_y_rel = 0.0f;
+
+	NotifyMoved(x_rel, y_rel, pending_x_abs, pending_y_abs);
+}
+
 void MouseInterface::NotifyBooting() {}
 
 void MouseInterface::NotifyDisconnect()
@@ -130,6 +130,17 @@ public:
 	virtual void NotifyButton(const MouseButtonId id, const bool pressed) = 0;
 	virtual void NotifyWheel(const int16_t w_rel) = 0;
 
+	// Host event entry points. Movements get their deltas merged and are
+	// delivered to the emulated device at the [mouse] section's
+	// 'mouse_coalescing_rate' at most; buttons and wheel flush any
+	// pending movement first, so the guest sees the edges in their
+	// original order relative to the motion.
+	void EventMoved(const float x_rel, const float y_rel,
+	                const uint32_t x_abs, const uint32_t y_abs);
+	void EventButton(const MouseButtonId id, const bool pressed);
+	void EventWheel(const int16_t w_rel);
+	void FlushPendingMotion(); // called from the scheduled PIC event
+
 	void NotifyInterfaceRate(const uint16_t rate_hz);
 	virtual void NotifyBooting();
 	void NotifyDisconnect();
@@ -217,6 +228,17 @@ private:
 	MouseButtons345 old_buttons_345 = 0;
 
 	float sensitivity_predefined = 1.0f; // hardcoded for the given interface
+
+	// Coalesced movement not yet delivered to the emulated device
+	float pending_x_rel    = 0.0f;
+	float pending_y_rel    = 0.0f;
+	uint32_t pending_x_abs = 0;
+	uint32_t pending_y_abs = 0;
+
+	bool has_pending_motion = false;
+	bool flush_scheduled    = false;
+
+	void DeliverPendingMotion();
 };
 
 extern std::vector<std::unique_ptr<MouseInterface>> mouse_interfaces;
@@ -28,6 +28,7 @@
 #include "string_utils.h"
 
 #include <algorithm>
+#include <chrono>
 #include <initializer_list>
 
 CHECK_NARROWING();
@@ -71,10 +72,70 @@ ManyMouseGlue &ManyMouseGlue::GetInstance()
 
 ManyMouseGlue::~ManyMouseGlue()
 {
+	// No ring draining - other emulator objects might be gone already
+	StopPollingThread(false);
 	PIC_RemoveEvents(manymouse_tick);
 	ManyMouse_Quit();
 }
 
+void ManyMouseGlue::PollingLoop()
+{
+	while (poll_thread_running) {
+		ManyMouseEvent event;
+		while (ManyMouse_PollEvent(&event)) {
+			const auto head = ring_head.load(std::memory_order_relaxed);
+			const auto next = (head + 1) % ring_size;
+			if (next == ring_tail.load(std::memory_order_acquire)) {
+				// Ring full; dropping is preferable to ever
+				// blocking on the emulation thread
+				continue;
+			}
+			ring[head] = event;
+			ring_head.store(next, std::memory_order_release);
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+bool ManyMouseGlue::PopEvent(ManyMouseEvent &event)
+{
+	const auto tail = ring_tail.load(std::memory_order_relaxed);
+	if (tail == ring_head.load(std::memory_order_acquire))
+		return false;
+
+	event = ring[tail];
+	ring_tail.store((tail + 1) % ring_size, std::memory_order_release);
+	return true;
+}
+
+void ManyMouseGlue::StartPollingThread()
+{
+	if (poll_thread_running)
+		return;
+
+	poll_thread_running = true;
+	poll_thread = std::thread(&ManyMouseGlue::PollingLoop, this);
+}
+
+void ManyMouseGlue::StopPollingThread(const bool drain_ring)
+{
+	if (!poll_thread_running)
+		return;
+
+	poll_thread_running = false;
+	if (poll_thread.joinable())
+		poll_thread.join();
+
+	if (!drain_ring)
+		return;
+
+	// Handle whatever is still queued; critical events (button
+	// releases, disconnects) must not get lost
+	ManyMouseEvent event;
+	while (PopEvent(event))
+		HandleEvent(event, true);
+}
+
 void ManyMouseGlue::InitIfNeeded()
 {
 	if (initialized || malfunction)
@@ -131,6 +192,7 @@ void ManyMouseGlue::ShutdownForced()
 	if (!initialized)
 		return;
 
+	StopPollingThread();
 	PIC_RemoveEvents(manymouse_tick);
 	ManyMouse_Quit();
 	ClearPhysicalMice();
@@ -245,10 +307,12 @@ bool ManyMouseGlue::ProbeForMapping(uint8_t &physical_device_idx)
 		CALLBACK_Idle();
 
 	// Make sure the module is initialized,
-	// but suppress default event handling
+	// but suppress default event handling; the probe loop below
+	// needs to poll the library directly, so pause the polling thread
 	InitIfNeeded();
 	if (!initialized)
 		return false;
+	StopPollingThread();
 	PIC_RemoveEvents(manymouse_tick);
 
 	// Flush events, handle critical ones
@@ -290,8 +354,10 @@ bool ManyMouseGlue::ProbeForMapping(uint8_t &physical_device_idx)
 		break;
 	}
 
-	if (is_mapping_in_effect)
+	if (is_mapping_in_effect) {
+		StartPollingThread();
 		PIC_AddEvent(manymouse_tick, tick_interval);
+	}
 	return success;
 }
 
@@ -356,10 +422,15 @@ void ManyMouseGlue::MapFinalize()
 			continue;
 
 		is_mapping_in_effect = true;
-		if (mouse_config.capture != MouseCapture::NoMouse)
+		if (mouse_config.capture != MouseCapture::NoMouse) {
+			StartPollingThread();
 			PIC_AddEvent(manymouse_tick, tick_interval);
+		}
 		break;
 	}
+
+	if (!is_mapping_in_effect)
+		StopPollingThread();
 }
 
 bool ManyMouseGlue::IsMappingInEffect() const
@@ -452,9 +523,9 @@ void ManyMouseGlue::Tick()
 {
 	assert(mouse_config.capture != MouseCapture::NoMouse);
 
-	// Handle all the events from the queue
+	// Handle all the events collected by the polling thread
 	ManyMouseEvent event;
-	while (ManyMouse_PollEvent(&event))
+	while (PopEvent(event))
 		HandleEvent(event);
 
 	// Report accumulated mouse movements
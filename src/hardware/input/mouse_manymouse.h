@@ -22,7 +22,10 @@
 #include "mouse.h"
 #include "mouse_interfaces.h"
 
+#include <array>
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 
 #if C_MANYMOUSE
@@ -89,6 +92,25 @@ private:
 	void HandleEvent(const ManyMouseEvent &event,
 	                 const bool critical_only = false);
 
+	// The polling thread calls the (blocking) host APIs via
+	// ManyMouse_PollEvent and pushes raw events into the ring; the
+	// emulation thread drains the ring from Tick(). Runs only while a
+	// mapping is in effect, so single-mouse setups never pay for it.
+	void StartPollingThread();
+	void StopPollingThread(const bool drain_ring = true);
+	void PollingLoop();
+	bool PopEvent(ManyMouseEvent &event);
+
+	// Single-producer (polling thread), single-consumer (emulation
+	// thread) ring; a full ring drops the event
+	static constexpr size_t ring_size = 256; // power of two
+	std::array<ManyMouseEvent, ring_size> ring = {};
+	std::atomic<size_t> ring_head = 0;
+	std::atomic<size_t> ring_tail = 0;
+
+	std::thread poll_thread = {};
+	std::atomic<bool> poll_thread_running = false;
+
 	bool initialized = false;
 	bool malfunction = false; // once set to false, will stay false forever
 	bool is_mapping_in_effect  = false;
@@ -82,6 +82,27 @@ enum class MouseEventId : uint8_t {
 // delay to enforce between callbacks, in milliseconds
 static uint8_t delay_ms = 5;
 
+// Adaptive pacing: if the measured guest callback execution time shows the
+// application doing heavy per-event work (paint programs, GUIs), motion
+// callbacks are spaced out so the handler occupies at most
+// 'callback_load_limit' of the guest time; the intermediate deltas are
+// fused by the pending accumulators below, so no displacement is lost.
+// Button and wheel events always keep the base delay, so click edges are
+// never deferred behind an extended motion delay.
+static constexpr float callback_load_limit = 0.5f;
+
+// never drop the guest-visible motion callback rate below 25 Hz
+static constexpr uint8_t delay_adaptive_max_ms = 40;
+
+// exponentially smoothed guest callback execution time
+static float avg_callback_time_ms = 0.0f;
+
+// PIC time when the current callback was dispatched, 0.0 if none running
+static double callback_start_time = 0.0;
+
+// delay the currently running timer was armed with
+static uint8_t armed_delay_ms = 0;
+
 // true = delay timer is in progress
 static bool delay_running  = false;
 // true = delay timer expired, event can be sent immediately
@@ -257,14 +278,37 @@ static void maybe_start_delay_timer(const uint8_t timer_delay_ms)
 		return;
 	}
 	PIC_AddEvent(delay_handler, timer_delay_ms);
+	armed_delay_ms = timer_delay_ms;
 	delay_running  = true;
 	delay_finished = false;
 }
 
+static uint8_t pick_delay_ms()
+{
+	// Button and wheel events are never paced down
+	if (pending_button || pending_wheel) {
+		return delay_ms;
+	}
+
+	const auto adaptive_ms = avg_callback_time_ms / callback_load_limit;
+	return static_cast<uint8_t>(
+	        std::clamp(adaptive_ms,
+	                   static_cast<float>(delay_ms),
+	                   static_cast<float>(delay_adaptive_max_ms)));
+}
+
 static void maybe_trigger_event()
 {
+	const auto timer_delay_ms = pick_delay_ms();
+
 	if (!delay_finished) {
-		maybe_start_delay_timer(delay_ms);
+		// A button or wheel event must not wait out an extended
+		// motion delay - re-arm the timer at the shorter delay
+		if (delay_running && timer_delay_ms < armed_delay_ms) {
+			PIC_RemoveEvents(delay_handler);
+			delay_running = false;
+		}
+		maybe_start_delay_timer(timer_delay_ms);
 		return;
 	}
 
@@ -272,7 +316,7 @@ static void maybe_trigger_event()
 		return;
 	}
 
-	maybe_start_delay_timer(delay_ms);
+	maybe_start_delay_timer(timer_delay_ms);
 	PIC_ActivateIRQ(mouse_predefined.IRQ_PS2);
 }
 
@@ -1036,6 +1080,10 @@ static void reset()
 	state.user_callback_mask    = 0;
 	mouse_shared.dos_cb_running = false;
 
+	// Forget the previous client's callback timing
+	avg_callback_time_ms = 0.0f;
+	callback_start_time  = 0.0;
+
 	update_driver_active();
 	clear_pending_events();
 }
@@ -1855,6 +1903,17 @@ static Bitu mouse_bd_handler()
 
 static Bitu user_callback_handler()
 {
+	// Measure how long the guest took to handle the callback; the
+	// exponential smoothing keeps a single slow frame from spiking
+	// the adaptive pacing
+	if (callback_start_time != 0.0) {
+		const auto elapsed_ms = static_cast<float>(
+		        PIC_FullIndex() - callback_start_time);
+		avg_callback_time_ms = 0.9f * avg_callback_time_ms +
+		                       0.1f * elapsed_ms;
+		callback_start_time = 0.0;
+	}
+
 	mouse_shared.dos_cb_running = false;
 	return CBRET_NONE;
 }
@@ -1973,6 +2032,7 @@ uint8_t MOUSEDOS_DoInterrupt()
 void MOUSEDOS_DoCallback(const uint8_t mask)
 {
 	mouse_shared.dos_cb_running = true;
+	callback_start_time = PIC_FullIndex();
 	const bool mouse_moved = mask & static_cast<uint8_t>(MouseEventId::MouseHasMoved);
 	const bool wheel_moved = mask & static_cast<uint8_t>(MouseEventId::WheelHasMoved);
 
@@ -44,6 +44,7 @@ uint32_t read_dword_from_port(const io_port_t port);
 void write_byte_to_port(const io_port_t port, const uint8_t val);
 void write_word_to_port(const io_port_t port, const uint16_t val);
 void write_dword_to_port(const io_port_t port, const uint32_t val);
+void io_reset_dispatch_tables();
 
 
 struct IOF_Entry {
@@ -399,6 +400,8 @@ public:
 			io_read_handlers[i].clear();
 			io_write_handlers[i].clear();
 		}
+		// The dispatch tables point into the maps just cleared
+		io_reset_dispatch_tables();
 		LOG_DEBUG("IOBUS: Handlers consumed %d total bytes",
 		          static_cast<int>(total_bytes));
 	}
@@ -21,6 +21,7 @@
 
 #include "dosbox.h"
 
+#include <array>
 #include <cassert>
 #include <cstring>
 #include <functional>
@@ -65,6 +66,72 @@ constexpr auto &io_write_byte_handler = io_write_handlers[0];
 constexpr auto &io_write_word_handler = io_write_handlers[1];
 constexpr auto &io_write_dword_handler = io_write_handlers[2];
 
+// Flat per-width dispatch tables indexed by port number, so steady-state
+// port I/O is a single indexed load plus the handler call instead of a hash
+// lookup (guests hammer ports like the 3DAh display status in busy-wait
+// loops). Each slot points at the handler stored in the maps above; those
+// are node-based, so the pointers stay valid until the entry itself is
+// erased. The tables are maintained on handler (de)registration.
+constexpr auto num_io_ports = 65536;
+
+static std::array<std::array<const io_read_f*, num_io_ports>, io_widths>
+        io_read_dispatch = {};
+static std::array<std::array<const io_write_f*, num_io_ports>, io_widths>
+        io_write_dispatch = {};
+
+void io_reset_dispatch_tables()
+{
+	for (auto& table : io_read_dispatch) {
+		table.fill(nullptr);
+	}
+	for (auto& table : io_write_dispatch) {
+		table.fill(nullptr);
+	}
+}
+
+// Bulk string IO handlers (see inout.h); consulted by the REP INS/OUTS
+// paths in the cores
+static std::unordered_map<io_port_t, io_str_read_f> io_str_read_handlers = {};
+static std::unordered_map<io_port_t, io_str_write_f> io_str_write_handlers = {};
+
+void IO_RegisterStringReadHandler(const io_port_t port, const io_str_read_f& handler)
+{
+	io_str_read_handlers[port] = handler;
+}
+
+void IO_RegisterStringWriteHandler(const io_port_t port, const io_str_write_f& handler)
+{
+	io_str_write_handlers[port] = handler;
+}
+
+void IO_FreeStringReadHandler(const io_port_t port)
+{
+	io_str_read_handlers.erase(port);
+}
+
+void IO_FreeStringWriteHandler(const io_port_t port)
+{
+	io_str_write_handlers.erase(port);
+}
+
+size_t IO_StringReadPort(const io_port_t port, const uint32_t addr,
+                         const size_t items, const io_width_t width)
+{
+	const auto it = io_str_read_handlers.find(port);
+	return (it != io_str_read_handlers.end())
+	               ? it->second(port, addr, items, width)
+	               : 0;
+}
+
+size_t IO_StringWritePort(const io_port_t port, const uint32_t addr,
+                          const size_t items, const io_width_t width)
+{
+	const auto it = io_str_write_handlers.find(port);
+	return (it != io_str_write_handlers.end())
+	               ? it->second(port, addr, items, width)
+	               : 0;
+}
+
 constexpr io_val_t blocked_read(const io_port_t, const io_width_t)
 {
 	return 0xff;
@@ -73,17 +140,21 @@ constexpr io_val_t blocked_read(const io_port_t, const io_width_t)
 // type-sized IO handler API
 uint8_t read_byte_from_port(const io_port_t port)
 {
+	if (const auto handler = io_read_dispatch[0][port]) {
+		return (*handler)(port, io_width_t::byte) & 0xff;
+	}
+	// First access to an unhandled port; block it from now on
 	const auto [it, was_blocked] = io_read_byte_handler.emplace(port, blocked_read);
 	if (was_blocked)
 		LOG(LOG_IO, LOG_WARN)("Unhandled read from port %04Xh; blocking", port);
+	io_read_dispatch[0][port] = &it->second;
 	return it->second(port, io_width_t::byte) & 0xff;
 }
 
 uint16_t read_word_from_port(const io_port_t port)
 {
-	const auto reader = io_read_word_handler.find(port);
-	const auto value = reader != io_read_word_handler.end()
-	                           ? (reader->second(port, io_width_t::word) & 0xffff)
+	const auto handler = io_read_dispatch[1][port];
+	const auto value = handler ? ((*handler)(port, io_width_t::word) & 0xffff)
 	                           : static_cast<io_val_t>(
 	                                     read_byte_from_port(port) |
 	                                     (read_byte_from_port(port + 1) << 8));
@@ -92,9 +163,8 @@ uint16_t read_word_from_port(const io_port_t port)
 
 uint32_t read_dword_from_port(const io_port_t port)
 {
-	const auto reader = io_read_dword_handler.find(port);
-	const auto value = reader != io_read_dword_handler.end()
-	                           ? reader->second(port, io_width_t::dword)
+	const auto handler = io_read_dispatch[2][port];
+	const auto value = handler ? (*handler)(port, io_width_t::dword)
 	                           : static_cast<io_val_t>(
 	                                     read_word_from_port(port) |
 	                                     (read_word_from_port(port + 2) << 16));
@@ -109,19 +179,24 @@ constexpr void blocked_write(const io_port_t, const io_val_t, const io_width_t)
 
 void write_byte_to_port(const io_port_t port, const uint8_t val)
 {
+	if (const auto handler = io_write_dispatch[0][port]) {
+		(*handler)(port, val, io_width_t::byte);
+		return;
+	}
+	// First access to an unhandled port; block it from now on
 	const auto [it, was_blocked] = io_write_byte_handler.emplace(port, blocked_write);
 	if (was_blocked)
 		LOG(LOG_IO, LOG_WARN)("Unhandled write of value 0x%02x"
 		                      " (%u) to port %04Xh; blocking",
 		                      val, val, port);
+	io_write_dispatch[0][port] = &it->second;
 	it->second(port, val, io_width_t::byte);
 }
 
 void write_word_to_port(const io_port_t port, const uint16_t val)
 {
-	const auto writer = io_write_word_handler.find(port);
-	if (writer != io_write_word_handler.end()) {
-		writer->second(port, val, io_width_t::word);
+	if (const auto handler = io_write_dispatch[1][port]) {
+		(*handler)(port, val, io_width_t::word);
 	} else {
 		write_byte_to_port(port, static_cast<uint8_t>(val & 0xff));
 		write_byte_to_port(port + 1, static_cast<uint8_t>(val >> 8));
@@ -130,9 +205,8 @@ void write_word_to_port(const io_port_t port, const uint16_t val)
 
 void write_dword_to_port(const io_port_t port, const uint32_t val)
 {
-	const auto writer = io_write_dword_handler.find(port);
-	if (writer != io_write_dword_handler.end()) {
-		writer->second(port, val, io_width_t::dword);
+	if (const auto handler = io_write_dispatch[2][port]) {
+		(*handler)(port, val, io_width_t::dword);
 	} else {
 		write_word_to_port(port, static_cast<uint16_t>(val & 0xffff));
 		write_word_to_port(port + 2, static_cast<uint16_t>(val >> 16));
@@ -146,10 +220,15 @@ void IO_RegisterReadHandler(io_port_t port,
 {
 	while (range--) {
 		io_read_byte_handler[port] = handler;
-		if (max_width == io_width_t::word || max_width == io_width_t::dword)
+		io_read_dispatch[0][port] = &io_read_byte_handler[port];
+		if (max_width == io_width_t::word || max_width == io_width_t::dword) {
 			io_read_word_handler[port] = handler;
-		if (max_width == io_width_t::dword)
+			io_read_dispatch[1][port] = &io_read_word_handler[port];
+		}
+		if (max_width == io_width_t::dword) {
 			io_read_dword_handler[port] = handler;
+			io_read_dispatch[2][port] = &io_read_dword_handler[port];
+		}
 		++port;
 	}
 }
@@ -161,10 +240,15 @@ void IO_RegisterWriteHandler(io_port_t port,
 {
 	while (range--) {
 		io_write_byte_handler[port] = handler;
-		if (max_width == io_width_t::word || max_width == io_width_t::dword)
+		io_write_dispatch[0][port] = &io_write_byte_handler[port];
+		if (max_width == io_width_t::word || max_width == io_width_t::dword) {
 			io_write_word_handler[port] = handler;
-		if (max_width == io_width_t::dword)
+			io_write_dispatch[1][port] = &io_write_word_handler[port];
+		}
+		if (max_width == io_width_t::dword) {
 			io_write_dword_handler[port] = handler;
+			io_write_dispatch[2][port] = &io_write_dword_handler[port];
+		}
 		++port;
 	}
 }
@@ -175,10 +259,15 @@ void IO_FreeReadHandler(io_port_t port,
 {
 	while (range--) {
 		io_read_byte_handler.erase(port);
-		if (max_width == io_width_t::word || max_width == io_width_t::dword)
+		io_read_dispatch[0][port] = nullptr;
+		if (max_width == io_width_t::word || max_width == io_width_t::dword) {
 			io_read_word_handler.erase(port);
-		if (max_width == io_width_t::dword)
+			io_read_dispatch[1][port] = nullptr;
+		}
+		if (max_width == io_width_t::dword) {
 			io_read_dword_handler.erase(port);
+			io_read_dispatch[2][port] = nullptr;
+		}
 		++port;
 	}
 }
@@ -189,10 +278,15 @@ void IO_FreeWriteHandler(io_port_t port,
 {
 	while (range--) {
 		io_write_byte_handler.erase(port);
-		if (width == io_width_t::word || width == io_width_t::dword)
+		io_write_dispatch[0][port] = nullptr;
+		if (width == io_width_t::word || width == io_width_t::dword) {
 			io_write_word_handler.erase(port);
-		if (width == io_width_t::dword)
+			io_write_dispatch[1][port] = nullptr;
+		}
+		if (width == io_width_t::dword) {
 			io_write_dword_handler.erase(port);
+			io_write_dispatch[2][port] = nullptr;
+		}
 		++port;
 	}
 }
@@ -27,6 +27,7 @@
 #include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <memory>
 
 #include "cross.h"
 #include "string_utils.h"
@@ -43,6 +44,7 @@
 #include "timer.h"
 #include "programs.h"
 #include "pic.h"
+#include "udp_socket_reader.h"
 
 #define SOCKTABLESIZE	150 // DOS IPX driver was limited to 150 open sockets
 
@@ -57,7 +59,9 @@ bool isIpxConnected;
 IPaddress ipxServConnIp;			// IPAddress for client connection to server
 UDPsocket ipxClientSocket;
 int UDPChannel;						// Channel used by UDP connection
-uint8_t recvBuffer[IPXBUFFERSIZE];	// Incoming packet buffer
+
+// Drains the client socket on its own thread while we're connected
+static std::unique_ptr<UdpSocketReader> ipxClientReader = {};
 
 static RealPt ipx_callback;
 
@@ -608,15 +612,10 @@ static void receivePacket(uint8_t *buffer, int16_t bufSize) {
 }
 
 static void IPX_ClientLoop(void) {
-	int numrecv;
-	UDPpacket inPacket;
-	inPacket.data = (Uint8 *)recvBuffer;
-	inPacket.maxlen = IPXBUFFERSIZE;
-	inPacket.channel = UDPChannel;
-
-	// Its amazing how much simpler UDP is than TCP
-	numrecv = SDLNet_UDP_Recv(ipxClientSocket, &inPacket);
-	if(numrecv) receivePacket(inPacket.data, inPacket.len);
+	// Hand over everything the reader thread queued since the last tick
+	while (auto datagram = ipxClientReader->Receive())
+		receivePacket(datagram->data.data(),
+		              check_cast<int16_t>(datagram->len));
 }
 
 
@@ -625,6 +624,8 @@ void DisconnectFromServer(bool unexpected) {
 	if(incomingPacket.connected) {
 		incomingPacket.connected = false;
 		TIMER_DelTickHandler(&IPX_ClientLoop);
+		// Stop the reader thread before its socket goes away
+		ipxClientReader.reset();
 		SDLNet_UDP_Close(ipxClientSocket);
 	}
 }
@@ -739,17 +740,9 @@ static void sendPacket(ECBClass* sendecb) {
 }
 
 static bool pingCheck(IPXHeader * outHeader) {
-	char buffer[1024];
-	UDPpacket regPacket;
-	IPXHeader *regHeader;
-	regPacket.data = (Uint8 *)buffer;
-	regPacket.maxlen = sizeof(buffer);
-	regPacket.channel = UDPChannel;
-	regHeader = (IPXHeader *)buffer;
-
-	const int result = SDLNet_UDP_Recv(ipxClientSocket, &regPacket);
-	if (result != 0) {
-		memcpy(outHeader, regHeader, sizeof(IPXHeader));
+	const auto datagram = ipxClientReader->Receive();
+	if (datagram && datagram->len >= sizeof(IPXHeader)) {
+		memcpy(outHeader, datagram->data.data(), sizeof(IPXHeader));
 		return true;
 	}
 	return false;
@@ -826,6 +819,8 @@ bool ConnectToServer(const char* strAddr)
 				LOG_MSG("IPX: Connected to server.  IPX address is %d:%d:%d:%d:%d:%d", CONVIPX(localIpxAddr.netnode));
 
 				incomingPacket.connected = true;
+				ipxClientReader = std::make_unique<UdpSocketReader>(
+				        ipxClientSocket, UDPChannel);
 				TIMER_AddTickHandler(&IPX_ClientLoop);
 				return true;
 			}
@@ -24,7 +24,11 @@
 #include "timer.h"
 #include <stdlib.h>
 #include <string.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 #include "ipx.h"
+#include "udp_socket_reader.h"
 
 constexpr int UDP_UNICAST = -1; // SDLNet magic number
 
@@ -33,12 +37,31 @@ UDPsocket ipxServerSocket;  // Listening server socket
 
 packetBuffer connBuffer[SOCKETTABLESIZE];
 
-uint8_t inBuffer[IPXBUFFERSIZE];
+// Drains the listening socket on its own thread while the server is up
+static std::unique_ptr<UdpSocketReader> serverReader = {};
 IPaddress ipconn[SOCKETTABLESIZE];  // Active TCP/IP connection
 UDPsocket tcpconn[SOCKETTABLESIZE]; // Active TCP/IP connections
 SDLNet_SocketSet serverSocketSet;
 TIMER_TickHandler* serverTimer;
 
+// Unicast destinations are looked up in a hash table keyed on the
+// client's IP and port instead of scanning the connection table per
+// packet, and broadcasts iterate only the registered slots. Clients are
+// never unregistered (the table has no disconnect handling), so the
+// active list only ever grows up to SOCKETTABLESIZE entries.
+static std::unordered_map<uint64_t, uint16_t> addressTable;
+static std::vector<uint16_t> activeConnections;
+
+static uint64_t addressKey(const uint32_t host, const uint16_t port)
+{
+	return (static_cast<uint64_t>(host) << 16) | port;
+}
+
+static uint64_t addressKey(const IPaddress& addr)
+{
+	return addressKey(addr.host, addr.port);
+}
+
 uint8_t packetCRC(uint8_t *buffer, uint16_t bufSize) {
 	uint8_t tmpCRC = 0;
 	uint16_t i;
@@ -82,8 +105,8 @@ static void sendIPXPacket(uint8_t *buffer, int16_t bufSize) {
 
 	if(desthost == 0xffffffff) {
 		// Broadcast
-		for (uint16_t i = 0; i < SOCKETTABLESIZE; ++i) {
-			if(connBuffer[i].connected && ((ipconn[i].host != srchost)||(ipconn[i].port!=srcport))) {
+		for (const auto i : activeConnections) {
+			if((ipconn[i].host != srchost)||(ipconn[i].port!=srcport)) {
 				outPacket.address = ipconn[i];
 				const int result = SDLNet_UDP_Send(ipxServerSocket,
 				                                   UDP_UNICAST,
@@ -97,18 +120,16 @@ static void sendIPXPacket(uint8_t *buffer, int16_t bufSize) {
 		}
 	} else {
 		// Specific address
-		for (uint16_t i = 0; i < SOCKETTABLESIZE; ++i) {
-			if((connBuffer[i].connected) && (ipconn[i].host == desthost) && (ipconn[i].port == destport)) {
-				outPacket.address = ipconn[i];
-				const int result = SDLNet_UDP_Send(ipxServerSocket,
-				                                   UDP_UNICAST,
-				                                   &outPacket);
-				if (result == 0) {
-					LOG_MSG("IPXSERVER: %s", SDLNet_GetError());
-					continue;
-				}
-				//LOG_MSG("IPXSERVER: Packet sent from %d.%d.%d.%d to %d.%d.%d.%d", CONVIP(srchost), CONVIP(desthost));
+		const auto entry = addressTable.find(addressKey(desthost, destport));
+		if (entry != addressTable.end()) {
+			outPacket.address = ipconn[entry->second];
+			const int result = SDLNet_UDP_Send(ipxServerSocket,
+			                                   UDP_UNICAST,
+			                                   &outPacket);
+			if (result == 0) {
+				LOG_MSG("IPXSERVER: %s", SDLNet_GetError());
 			}
+			//LOG_MSG("IPXSERVER: Packet sent from %d.%d.%d.%d to %d.%d.%d.%d", CONVIP(srchost), CONVIP(desthost));
 		}
 	}
 }
@@ -146,62 +167,68 @@ static void ackClient(IPaddress clientAddr) {
 		        SDLNet_GetError());
 }
 
-static void IPX_ServerLoop() {
-	UDPpacket inPacket;
+static void serverProcessPacket(UdpDatagram &datagram) {
 	IPaddress tmpAddr;
-
-	//char regString[] = "IPX Register\0";
-
 	uint32_t host;
 
-	inPacket.channel = -1;
-	inPacket.data = &inBuffer[0];
-	inPacket.maxlen = IPXBUFFERSIZE;
-
-	const int result = SDLNet_UDP_Recv(ipxServerSocket, &inPacket);
-	if (result != 0) {
-		// Check to see if incoming packet is a registration packet
-		// For this, I just spoofed the echo protocol packet designation 0x02
-		IPXHeader *tmpHeader;
-		tmpHeader = (IPXHeader *)&inBuffer[0];
-
-		// Check to see if echo packet
-		if(SDLNet_Read16(tmpHeader->dest.socket) == 0x2) {
-			// Null destination node means its a server registration packet
-			if(tmpHeader->dest.addr.byIP.host == 0x0) {
-				UnpackIP(tmpHeader->src.addr.byIP, &tmpAddr);
-				for (uint16_t i = 0; i < SOCKETTABLESIZE; ++i) {
-					if(!connBuffer[i].connected) {
-						// Use prefered host IP rather than the reported source IP
-						// It may be better to use the reported source
-						ipconn[i] = inPacket.address;
-
-						connBuffer[i].connected = true;
-						host = ipconn[i].host;
-						LOG_MSG("IPXSERVER: Connect from %d.%d.%d.%d", CONVIP(host));
-						ackClient(inPacket.address);
-						return;
-					} else {
-						if((ipconn[i].host == tmpAddr.host) && (ipconn[i].port == tmpAddr.port)) {
-
-							LOG_MSG("IPXSERVER: Reconnect from %d.%d.%d.%d", CONVIP(tmpAddr.host));
-							// Update anonymous port number if changed
-							ipconn[i].port = inPacket.address.port;
-							ackClient(inPacket.address);
-							return;
-						}
-					}
+	// Check to see if incoming packet is a registration packet
+	// For this, I just spoofed the echo protocol packet designation 0x02
+	IPXHeader *tmpHeader;
+	tmpHeader = (IPXHeader *)datagram.data.data();
+
+	// Check to see if echo packet
+	if(SDLNet_Read16(tmpHeader->dest.socket) == 0x2) {
+		// Null destination node means its a server registration packet
+		if(tmpHeader->dest.addr.byIP.host == 0x0) {
+			UnpackIP(tmpHeader->src.addr.byIP, &tmpAddr);
+
+			// Known clients are found in the address table
+			const auto existing = addressTable.find(addressKey(tmpAddr));
+			if (existing != addressTable.end()) {
+				const auto i = existing->second;
+				LOG_MSG("IPXSERVER: Reconnect from %d.%d.%d.%d", CONVIP(tmpAddr.host));
+				// Update anonymous port number if changed
+				if (ipconn[i].port != datagram.address.port) {
+					addressTable.erase(existing);
+					ipconn[i].port = datagram.address.port;
+					addressTable.emplace(addressKey(ipconn[i]), i);
 				}
+				ackClient(datagram.address);
+				return;
 			}
-		}
 
-		// IPX packet is complete.  Now interpret IPX header and send to respective IP address
-		sendIPXPacket((uint8_t *)inPacket.data, inPacket.len);
+			for (uint16_t i = 0; i < SOCKETTABLESIZE; ++i) {
+				if(!connBuffer[i].connected) {
+					// Use prefered host IP rather than the reported source IP
+					// It may be better to use the reported source
+					ipconn[i] = datagram.address;
+
+					connBuffer[i].connected = true;
+					addressTable.emplace(addressKey(ipconn[i]), i);
+					activeConnections.push_back(i);
+					host = ipconn[i].host;
+					LOG_MSG("IPXSERVER: Connect from %d.%d.%d.%d", CONVIP(host));
+					ackClient(datagram.address);
+					return;
+				}
+			}
+		}
 	}
+
+	// IPX packet is complete.  Now interpret IPX header and send to respective IP address
+	sendIPXPacket(datagram.data.data(), check_cast<int16_t>(datagram.len));
+}
+
+static void IPX_ServerLoop() {
+	// Forward everything the reader thread queued since the last tick
+	while (auto datagram = serverReader->Receive())
+		serverProcessPacket(*datagram);
 }
 
 void IPX_StopServer() {
 	TIMER_DelTickHandler(&IPX_ServerLoop);
+	// Stop the reader thread before its socket goes away
+	serverReader.reset();
 	SDLNet_UDP_Close(ipxServerSocket);
 }
 
@@ -215,6 +242,12 @@ bool IPX_StartServer(uint16_t portnum)
 		for (uint16_t i = 0; i < SOCKETTABLESIZE; ++i)
 			connBuffer[i].connected = false;
 
+		addressTable.clear();
+		activeConnections.clear();
+
+		constexpr int all_channels = -1;
+		serverReader = std::make_unique<UdpSocketReader>(ipxServerSocket,
+		                                                 all_channels);
 		TIMER_AddTickHandler(&IPX_ServerLoop);
 		return true;
 	}
@@ -18,6 +18,7 @@
 
 #include "joystick.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <string.h>
 #include <math.h>
@@ -57,12 +58,35 @@ constexpr JoystickAxisRates default_axis_rates = {
         {'y', 1.110 / 2, 0.02},
 };
 
+// Capacitor discharge deadline for the timed mode, split into a whole PIC
+// tick and an elapsed-cycles offset within that tick. Precomputed on the
+// guest's trigger write, so the hot port 0x201 read only compares integers
+// instead of doing float math on every poll.
+struct AxisDeadline {
+	uint32_t tick  = 0; // PIC_Ticks value when the axis resets
+	int32_t cycles = 0; // elapsed cycles within that tick
+};
+
+static AxisDeadline make_axis_deadline(const double absolute_tick)
+{
+	const auto whole = static_cast<uint32_t>(std::max(absolute_tick, 0.0));
+	const auto fraction = absolute_tick - whole;
+	return {whole, static_cast<int32_t>(fraction * CPU_CycleMax)};
+}
+
+static bool axis_expired(const AxisDeadline &deadline, const uint32_t now_tick,
+                         const int32_t now_cycles)
+{
+	return (now_tick > deadline.tick) ||
+	       (now_tick == deadline.tick && now_cycles >= deadline.cycles);
+}
+
 struct JoyStick {
 	double xpos = 0.0;
 	double ypos = 0.0; // position as set by SDL
 
-	double xtick = 0.0;
-	double ytick = 0.0;
+	AxisDeadline xtick = {};
+	AxisDeadline ytick = {};
 
 	double xfinal = 0.0;
 	double yfinal = 0.0; // position returned to the game for stick 0
@@ -221,14 +245,15 @@ static uint8_t read_p201(io_port_t, io_width_t)
 static uint8_t read_p201_timed(io_port_t, io_width_t)
 {
 	uint8_t ret = 0xff;
-	const auto currentTick = PIC_FullIndex();
+	const auto now_tick   = PIC_Ticks;
+	const auto now_cycles = PIC_TickIndexND();
 	if( stick[0].enabled ){
-		if( stick[0].xtick < currentTick ) ret &=~1;
-		if( stick[0].ytick < currentTick ) ret &=~2;
+		if (axis_expired(stick[0].xtick, now_tick, now_cycles)) ret &=~1;
+		if (axis_expired(stick[0].ytick, now_tick, now_cycles)) ret &=~2;
 	}
 	if( stick[1].enabled ){
-		if( stick[1].xtick < currentTick ) ret &=~4;
-		if( stick[1].ytick < currentTick ) ret &=~8;
+		if (axis_expired(stick[1].xtick, now_tick, now_cycles)) ret &=~4;
+		if (axis_expired(stick[1].ytick, now_tick, now_cycles)) ret &=~8;
 	}
 
 	if (stick[0].enabled) {
@@ -297,18 +322,18 @@ static void write_p201_timed(io_port_t, io_val_t, io_width_t)
 
 	if (stick[0].enabled) {
 		stick[0].transform_input();
-		stick[0].xtick = position_to_ticks(stick[0].xfinal,
-		                                   calibrated_axis_rates.x);
-		stick[0].ytick = position_to_ticks(stick[0].yfinal,
-		                                   calibrated_axis_rates.y);
+		stick[0].xtick = make_axis_deadline(
+		        position_to_ticks(stick[0].xfinal, calibrated_axis_rates.x));
+		stick[0].ytick = make_axis_deadline(
+		        position_to_ticks(stick[0].yfinal, calibrated_axis_rates.y));
 	}
 	if (stick[1].enabled) {
-		stick[1].xtick = position_to_ticks(swap34 ? stick[1].ypos
-		                                          : stick[1].xpos,
-		                                   calibrated_axis_rates.x);
-		stick[1].ytick = position_to_ticks(swap34 ? stick[1].xpos
-		                                          : stick[1].ypos,
-		                                   calibrated_axis_rates.y);
+		stick[1].xtick = make_axis_deadline(
+		        position_to_ticks(swap34 ? stick[1].ypos : stick[1].xpos,
+		                          calibrated_axis_rates.x));
+		stick[1].ytick = make_axis_deadline(
+		        position_to_ticks(swap34 ? stick[1].xpos : stick[1].ypos,
+		                          calibrated_axis_rates.y));
 	}
 }
 
@@ -575,11 +600,11 @@ public:
 		configure_calibration(*section);
 
 		// Set initial time and position states
-		const auto ticks = PIC_FullIndex();
-		stick[0].xtick = ticks;
-		stick[0].ytick = ticks;
-		stick[1].xtick = ticks;
-		stick[1].ytick = ticks;
+		const auto deadline = make_axis_deadline(PIC_FullIndex());
+		stick[0].xtick = deadline;
+		stick[0].ytick = deadline;
+		stick[1].xtick = deadline;
+		stick[1].ytick = deadline;
 		stick[0].xpos = 0.0;
 		stick[0].ypos = 0.0;
 		stick[1].xpos = 0.0;
@@ -100,20 +100,27 @@ void LptDac::AudioCallback(const uint16_t requested_frames)
 {
 	assert(channel);
 
+	// Gather the frames into one buffer and hand them to the mixer as a
+	// single batch, which mixes them through its block conversion path
+	render_buffer.clear();
+	render_buffer.reserve(requested_frames);
+
 	auto frames_remaining = requested_frames;
 
 	// First, add any frames we've queued since the last callback
 	while (frames_remaining && render_queue.size()) {
-		channel->AddSamples_sfloat(1, &render_queue.front()[0]);
+		render_buffer.emplace_back(render_queue.front());
 		render_queue.pop();
 		--frames_remaining;
 	}
 	// If the queue's run dry, render the remainder and sync-up our time datum
 	while (frames_remaining) {
-		const auto frame = Render();
-		channel->AddSamples_sfloat(1, &frame[0]);
+		render_buffer.emplace_back(Render());
 		--frames_remaining;
 	}
+	if (requested_frames) {
+		channel->AddSamples_sfloat(requested_frames, &render_buffer[0][0]);
+	}
 	last_rendered_ms = PIC_FullIndex();
 }
 
@@ -134,7 +141,8 @@ LptDac::~LptDac()
 	assert(channel);
 	MIXER_DeregisterChannel(channel);
 
-	render_queue = {};
+	render_queue  = {};
+	render_buffer = {};
 }
 
 std::unique_ptr<LptDac> lpt_dac = {};
@@ -26,6 +26,7 @@
 #include <queue>
 #include <set>
 #include <string_view>
+#include <vector>
 
 #include "inout.h"
 #include "lpt.h"
@@ -53,8 +54,9 @@ protected:
 	virtual AudioFrame Render() = 0;
 	void RenderUpToNow();
 	void AudioCallback(const uint16_t requested_frames);
-	std::queue<AudioFrame> render_queue = {};
-	mixer_channel_t channel             = {};
+	std::queue<AudioFrame> render_queue   = {};
+	std::vector<AudioFrame> render_buffer = {};
+	mixer_channel_t channel               = {};
 
 	double last_rendered_ms = 0.0;
 	double ms_per_frame     = 0.0;
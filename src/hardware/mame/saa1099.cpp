@@ -191,8 +191,11 @@ saa1099_device::saa1099_device(const char *tag, device_t *owner,
           m_sync_state(0),
           m_selected_reg(0),
           m_sample_rate(static_cast<double>(clock) / rate_divisor),
-          m_chip_clock(0)
+          m_chip_clock(0),
+          m_num_live(0),
+          m_noise_used(false)
 {
+	FILL_ARRAY( m_live_channels );
 	FILL_ARRAY( m_noise_params );
 	FILL_ARRAY( m_env_enable );
 	FILL_ARRAY( m_env_reverse_right );
@@ -246,6 +249,8 @@ void saa1099_device::device_start()
 		save_item(NAME(m_noise[i].freq), i);
 		save_item(NAME(m_noise[i].level), i);
 	}
+
+	update_live_channels();
 }
 
 
@@ -259,8 +264,9 @@ void saa1099_device::sound_stream_update([[maybe_unused]] sound_stream &stream,
                                          int samples)
 {
 	int j, ch;
-	/* if the channels are disabled we're done */
-	if (!m_all_ch_enable)
+	/* if the channels are disabled or none of the enabled ones has a
+	 * non-zero amplitude we're done */
+	if (!m_all_ch_enable || m_num_live == 0)
 	{
 		/* init output data */
 		memset(outputs[LEFT],0,samples*sizeof(*outputs[LEFT]));
@@ -290,9 +296,10 @@ void saa1099_device::sound_stream_update([[maybe_unused]] sound_stream &stream,
 	{
 		int output_l = 0, output_r = 0;
 
-		/* for each channel */
-		uint8_t ch_num = 0;
-		for (auto &channel : m_channels) {
+		/* for each live channel (see update_live_channels) */
+		for (int idx = 0; idx < m_num_live; idx++) {
+			const uint8_t ch_num = m_live_channels[idx];
+			auto &channel = m_channels[ch_num];
 			if (channel.freq == 0.0) {
 				channel.update_freq(m_chip_clock);
 			}
@@ -331,10 +338,11 @@ void saa1099_device::sound_stream_update([[maybe_unused]] sound_stream &stream,
 					            channel.envelope[RIGHT] / 16;
 				}
 			}
-			++ch_num;
 		}
 
-		for (ch = 0; ch < 2; ch++)
+		/* the noise shifters only need clocking while a live channel
+		 * mixes them in */
+		for (ch = 0; ch < 2 && m_noise_used; ch++)
 		{
 			/* update the state of the noise generator
 			 * polynomial is x^18 + x^11 + x (i.e. 0x20400) and is a plain XOR, initial state is probably all 1s
@@ -405,6 +413,45 @@ void saa1099_device::envelope_w(int ch)
 }
 
 
+void saa1099_device::update_live_channels()
+{
+	bool in_list[6] = { false, false, false, false, false, false };
+	bool group_live[2] = { false, false };
+
+	m_num_live = 0;
+	m_noise_used = false;
+
+	for (int ch = 0; ch < 6; ch++)
+	{
+		const auto &channel = m_channels[ch];
+		/* a channel needs synthesizing when it is routed to an output
+		 * (tone or noise) with a non-zero amplitude on either side */
+		if (!channel.freq_enable && !channel.noise_enable)
+			continue;
+		if ((channel.amplitude[LEFT] | channel.amplitude[RIGHT]) == 0)
+			continue;
+		in_list[ch] = true;
+		group_live[ch / 3] = true;
+		if (channel.noise_enable)
+			m_noise_used = true;
+	}
+
+	/* an internally clocked envelope generator is driven by the level
+	 * transitions of channel 1 (resp. 4), so that channel must keep
+	 * running while its group is audible even if it is silent itself */
+	for (int ch = 0; ch < 2; ch++)
+	{
+		if (group_live[ch] && m_env_enable[ch] && m_env_clock[ch] == 0)
+			in_list[ch * 3 + 1] = true;
+	}
+
+	for (int ch = 0; ch < 6; ch++)
+	{
+		if (in_list[ch])
+			m_live_channels[m_num_live++] = static_cast<uint8_t>(ch);
+	}
+}
+
 WRITE8_MEMBER( saa1099_device::control_w )
 {
 	if ((data & 0xff) > 0x1c)
@@ -444,6 +491,7 @@ WRITE8_MEMBER( saa1099_device::data_w )
 		ch = reg & 7;
 		m_channels[ch].amplitude[LEFT] = amplitude_lookup[data & 0x0f];
 		m_channels[ch].amplitude[RIGHT] = amplitude_lookup[(data >> 4) & 0x0f];
+		update_live_channels();
 		break;
 	/* channel i frequency */
 	case 0x08:  case 0x09:  case 0x0a:  case 0x0b:  case 0x0c:  case 0x0d:
@@ -467,6 +515,7 @@ WRITE8_MEMBER( saa1099_device::data_w )
 		m_channels[3].freq_enable = data & 0x08;
 		m_channels[4].freq_enable = data & 0x10;
 		m_channels[5].freq_enable = data & 0x20;
+		update_live_channels();
 		break;
 	/* channel i noise enable */
 	case 0x15:
@@ -476,6 +525,7 @@ WRITE8_MEMBER( saa1099_device::data_w )
 		m_channels[3].noise_enable = data & 0x08;
 		m_channels[4].noise_enable = data & 0x10;
 		m_channels[5].noise_enable = data & 0x20;
+		update_live_channels();
 		break;
 	/* noise generators parameters */
 	case 0x16:
@@ -492,6 +542,7 @@ WRITE8_MEMBER( saa1099_device::data_w )
 		m_env_enable[ch] = data & 0x80;
 		/* reset the envelope */
 		m_env_step[ch] = 0;
+		update_live_channels();
 		break;
 	/* channels enable & reset generators */
 	case 0x1c:
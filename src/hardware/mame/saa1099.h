@@ -40,6 +40,13 @@ public:
 
 	DECLARE_WRITE8_MEMBER( write );
 
+	// true while the chip can produce no output: either all channels are
+	// disabled or no enabled channel has a non-zero amplitude
+	bool is_silent() const
+	{
+		return !m_all_ch_enable || m_num_live == 0;
+	}
+
 	// protected:
 	//  device-level overrides
 	void device_start() override;
@@ -76,6 +83,7 @@ private:
 	};
 
 	void envelope_w(int ch);
+	void update_live_channels();
 
 	sound_stream *m_stream;           /* our stream */
 	const double m_noise_freqs[3];    /* noise frequencies based on chip-clock */
@@ -93,6 +101,9 @@ private:
 	saa1099_noise m_noise[2];         /* noise generators */
 	double m_sample_rate;
 	int m_chip_clock;
+	uint8_t m_live_channels[6];       /* channels worth synthesizing */
+	int m_num_live;                   /* number of live channels */
+	bool m_noise_used;                /* a live channel mixes in noise */
 };
 
 #endif // MAME_SOUND_SAA1099_H
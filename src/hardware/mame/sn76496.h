@@ -26,6 +26,14 @@ public:
 //	auto ready_cb() { return m_ready_handler.bind(); }
 
 	void convert_samplerate(int32_t target_rate);
+
+	// true while all four attenuators are at maximum, i.e. the chip is
+	// outputting silence; lets callers idle their channel instead of
+	// clocking the generators
+	bool is_muted() const
+	{
+		return (m_volume[0] | m_volume[1] | m_volume[2] | m_volume[3]) == 0;
+	}
 protected:
 	sn76496_base_device(
 			const char *tag,
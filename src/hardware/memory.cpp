@@ -19,8 +19,16 @@
 
 #include "mem.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <string.h>
 
+#if defined(LINUX)
+#include <sys/mman.h>
+#endif
+
+#include "control.h"
 #include "inout.h"
 #include "paging.h"
 #include "pci_bus.h"
@@ -204,21 +212,82 @@ void mem_strcpy(PhysPt dest,PhysPt src) {
 }
 
 void mem_memcpy(PhysPt dest,PhysPt src,Bitu size) {
-	while (size--) mem_writeb_inline(dest++,mem_readb_inline(src++));
+	// Overlapping ranges depend on the ascending byte order of the
+	// fallback loop, so they never take the block path below
+	if (dest < src + size && src < dest + size) {
+		while (size--) mem_writeb_inline(dest++,mem_readb_inline(src++));
+		return;
+	}
+	// Copy in page-sized spans using the TLB's host pointers. Pages
+	// without a direct mapping (hardware handlers, pages holding cached
+	// code, or entries not faulted in yet) fall back to the byte loop,
+	// which routes every access through the page handlers and thereby
+	// keeps code-cache invalidation intact. XMS block moves are the
+	// heaviest caller and used to crawl through here one byte at a time.
+	while (size) {
+		Bitu chunk = std::min<Bitu>(size, dos_pagesize - (src & (dos_pagesize - 1)));
+		chunk = std::min<Bitu>(chunk, dos_pagesize - (dest & (dos_pagesize - 1)));
+
+		const HostPt src_host  = get_tlb_read(src);
+		const HostPt dest_host = get_tlb_write(dest);
+		if (src_host && dest_host) {
+			memcpy(dest_host + dest, src_host + src, chunk);
+		} else {
+			for (Bitu i = 0; i < chunk; ++i) {
+				mem_writeb_inline(dest + i, mem_readb_inline(src + i));
+			}
+		}
+		src += chunk;
+		dest += chunk;
+		size -= chunk;
+	}
 }
 
 void MEM_BlockRead(PhysPt pt,void * data,Bitu size) {
 	uint8_t * write=reinterpret_cast<uint8_t *>(data);
-	while (size--) {
-		*write++=mem_readb_inline(pt++);
+	// Read in page-sized spans through the TLB's host pointers, as in
+	// mem_memcpy above; pages without a direct mapping (hardware
+	// handlers or entries not faulted in yet) fall back to the byte
+	// loop. INT 13h sector transfers and EXE loading all funnel
+	// through here.
+	while (size) {
+		const Bitu chunk = std::min<Bitu>(
+		        size, dos_pagesize - (pt & (dos_pagesize - 1)));
+		const HostPt host = get_tlb_read(pt);
+		if (host) {
+			memcpy(write, host + pt, chunk);
+		} else {
+			for (Bitu i = 0; i < chunk; ++i) {
+				write[i] = mem_readb_inline(pt + i);
+			}
+		}
+		pt += chunk;
+		write += chunk;
+		size -= chunk;
 	}
 }
 
 void MEM_BlockWrite(PhysPt pt, const void *data, size_t size)
 {
 	const uint8_t *read = static_cast<const uint8_t *>(data);
-	while (size--) {
-		mem_writeb_inline(pt++,*read++);
+	// Same span scheme as MEM_BlockRead; pages holding cached code
+	// have no direct write mapping, so their fallback keeps routing
+	// through the page handlers and code-cache invalidation stays
+	// intact
+	while (size) {
+		const size_t chunk = std::min<size_t>(
+		        size, dos_pagesize - (pt & (dos_pagesize - 1)));
+		const HostPt host = get_tlb_write(pt);
+		if (host) {
+			memcpy(host + pt, read, chunk);
+		} else {
+			for (size_t i = 0; i < chunk; ++i) {
+				mem_writeb_inline(pt + i, read[i]);
+			}
+		}
+		pt += chunk;
+		read += chunk;
+		size -= chunk;
 	}
 }
 
@@ -471,13 +540,10 @@ void MEM_A20_Enable(bool enabled) {
 	if (memory.a20.enabled == enabled) {
 		return;
 	}
-	constexpr uint32_t a20_base_page = megabyte / dos_pagesize;
-
-	const uint32_t phys_base_page = enabled ? a20_base_page : 0;
-
-	for (uint8_t page = 0; page < 16; ++page) {
-		PAGING_MapPage(a20_base_page + page, phys_base_page + page);
-	}
+	// Both gate states have a precomputed first-megabyte table, so the
+	// toggle is a pointer swap; HIMEM-era software flips the gate around
+	// every far memory operation
+	PAGING_SelectA20Table(enabled);
 	memory.a20.enabled = enabled;
 }
 
@@ -715,6 +781,84 @@ HostPt GetMemBase(void)
 	return MemBase;
 }
 
+#if defined(LINUX)
+static uint64_t mergeable_advised_bytes = 0;
+
+static bool is_mergeable_enabled()
+{
+	const auto section = static_cast<Section_prop*>(
+	        control->GetSection("dosbox"));
+	return section && section->Get_bool("mergeable_memory");
+}
+#endif
+
+void MEM_AdviseMergeable([[maybe_unused]] void* address,
+                         [[maybe_unused]] const size_t num_bytes,
+                         [[maybe_unused]] const char* description)
+{
+#if defined(LINUX)
+	if (!is_mergeable_enabled()) {
+		return;
+	}
+
+	// KSM only considers whole pages, so trim the range to page bounds.
+	// Note: don't advise buffers which are dirtied continuously (like the
+	// dynarec code arena) - the kernel would merge and copy-on-write
+	// unshare them in a loop, burning cycles without saving memory.
+	constexpr uintptr_t host_page_size = 4096;
+	const auto base  = reinterpret_cast<uintptr_t>(address);
+	const auto first = (base + host_page_size - 1) & ~(host_page_size - 1);
+	const auto last  = (base + num_bytes) & ~(host_page_size - 1);
+	if (first >= last) {
+		return;
+	}
+
+	if (madvise(reinterpret_cast<void*>(first), last - first,
+	            MADV_MERGEABLE) == 0) {
+		mergeable_advised_bytes += last - first;
+		LOG_MSG("MEMORY: Advised %u KB of %s as mergeable",
+		        static_cast<uint32_t>((last - first) / 1024),
+		        description);
+	} else {
+		LOG_WARNING("MEMORY: Failed advising %s as mergeable: %s",
+		            description, strerror(errno));
+	}
+#endif
+}
+
+uint64_t MEM_GetMergeableAdvisedBytes()
+{
+#if defined(LINUX)
+	return mergeable_advised_bytes;
+#else
+	return 0;
+#endif
+}
+
+uint64_t MEM_GetKsmMergedPages()
+{
+#if defined(LINUX)
+	// Available since Linux 5.19; absence simply reports zero sharing
+	FILE* file = fopen("/proc/self/ksm_stat", "r");
+	if (!file) {
+		return 0;
+	}
+	uint64_t merged = 0;
+	char key[64];
+	unsigned long long value = 0;
+	while (fscanf(file, "%63s %llu", key, &value) == 2) {
+		if (strcmp(key, "ksm_merging_pages") == 0) {
+			merged = value;
+			break;
+		}
+	}
+	fclose(file);
+	return merged;
+#else
+	return 0;
+#endif
+}
+
 class MEMORY final : public Module_base {
 private:
 	IO_ReadHandleObject ReadHandler   = {};
@@ -735,6 +879,32 @@ public:
 		// The MemBase is address of the first page's first byte
 		MemBase = &(memory.pages[0].bytes[0]);
 
+#if defined(LINUX)
+		// Ask the kernel to back the guest RAM with transparent huge
+		// pages: guest memory accesses through the paging TLB helpers
+		// are a large host dTLB consumer, and 2 MB mappings cut those
+		// misses. This is a best-effort hint; without kernel support
+		// the madvise call simply fails and the plain mapping is used.
+		constexpr uintptr_t huge_page_size = 2 * 1024 * 1024;
+		const auto base  = reinterpret_cast<uintptr_t>(MemBase);
+		const auto first = (base + huge_page_size - 1) &
+		                   ~(huge_page_size - 1);
+		const auto last = (base + num_pages * dos_pagesize) &
+		                  ~(huge_page_size - 1);
+		if (first < last && madvise(reinterpret_cast<void*>(first),
+		                            last - first,
+		                            MADV_HUGEPAGE) == 0) {
+			LOG_MSG("MEMORY: Enabled transparent huge pages for %u MB of guest RAM",
+			        static_cast<uint32_t>((last - first) / megabyte));
+		}
+#endif
+
+		// Multi-instance hosts running the same titles duplicate most
+		// of this content, so optionally let the kernel deduplicate it
+		MEM_AdviseMergeable(MemBase,
+		                    static_cast<size_t>(num_pages) * dos_pagesize,
+		                    "guest RAM");
+
 		LOG_MSG("MEMORY: Using %d DOS memory pages (%u MB) at address: %p",
 		        static_cast<int>(memory.pages.size()),
 		        num_megabytes,
@@ -24,16 +24,25 @@
 #include "mixer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cinttypes>
+#include <climits>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <numeric>
 #include <optional>
 #include <sys/types.h>
 
 #include <SDL.h>
 #include <speex/speex_resampler.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "../capture/capture.h"
 #include "channel_names.h"
 #include "checks.h"
@@ -79,6 +88,26 @@ constexpr auto EnvelopeExpiresAfterSeconds = 10u;
 
 constexpr auto MaxPrebufferMs = 100;
 
+// Buffer occupancy watermarks steering the auto cycle-adjusting code, as
+// percentages of the prebuffered minimum
+constexpr auto MinBufferWatermarkPercent         = 10;
+constexpr auto MaxBufferWatermarkPercent         = 200;
+constexpr auto DefaultBufferLowWatermarkPercent  = 50;
+constexpr auto DefaultBufferHighWatermarkPercent = 100;
+
+// Adaptive latency tuning (see adapt_latency_on_callback): length of one
+// assessment window in SDL callbacks, the conservative starting point and
+// hard floor of the prebuffer walk, how much of the prebuffer one step
+// removes, and how many underruns mark a session as too rough for the
+// current blocksize
+constexpr auto AdaptWindowCallbacks       = 256;
+constexpr uint16_t AdaptStartPrebufferMs  = 40;
+constexpr uint16_t AdaptFloorPrebufferMs  = 5;
+constexpr auto AdaptStepDownPercent       = 25;
+constexpr auto AdaptRoughSessionUnderruns = 4u;
+constexpr auto AdaptMinBlocksize          = 128;
+constexpr auto AdaptMaxBlocksize          = 8192;
+
 template <class T, size_t ROWS, size_t COLS>
 using matrix = std::array<std::array<T, COLS>, ROWS>;
 
@@ -155,6 +184,11 @@ struct ChorusSettings {
 	}
 };
 
+// A master effects stage processes 'frames' frames of the work buffer
+// starting at 'start_pos' (wrapping at the ring buffer's end)
+using MasterStage = void (*)(const work_index_t start_pos,
+                             const work_index_t frames);
+
 struct MixerSettings {
 	// Complex types
 	matrix<float, MixerBufferLength, 2> work       = {};
@@ -184,6 +218,46 @@ struct MixerSettings {
 
 	uint16_t prebuffer_ms = 25; // user-adjustable in conf
 
+	// Output buffer occupancy at the start of the last SDL callback as a
+	// percentage of min_frames_needed; feedback for the auto
+	// cycle-adjusting code (see Normal_Loop in dosbox.cpp)
+	std::atomic<int> buffer_occupancy_percent = 100;
+
+	// SDL callbacks that found too few frames mixed and bailed out,
+	// leaving an audible gap; reported by the telemetry endpoint
+	std::atomic<uint32_t> underruns = 0;
+
+	// Cumulative time spent in the reverb and chorus master stages;
+	// written by the mixing thread, sampled by the telemetry endpoint
+	std::atomic<uint64_t> reverb_us = 0;
+	std::atomic<uint64_t> chorus_us = 0;
+
+	// user-adjustable in conf
+	int buffer_low_watermark_percent  = 50;
+	int buffer_high_watermark_percent = 100;
+
+	// user-adjustable in conf; see adapt_latency_on_callback()
+	bool adaptive_latency = false;
+
+	// State of the adaptive latency walk. Only touched by the SDL
+	// callback and by MIXER_Init while the device is paused, so plain
+	// members suffice.
+	struct {
+		bool active         = false;
+		bool converged      = false;
+		bool have_persisted = false;
+
+		uint16_t floor_ms           = AdaptFloorPrebufferMs;
+		uint16_t start_prebuffer_ms = 0;
+
+		uint32_t callbacks      = 0;
+		uint32_t underruns_seen = 0;
+
+		// Smallest number of frames the callbacks of the current
+		// window found mixed beyond what they consumed
+		int min_margin_frames = INT_MAX;
+	} adapt = {};
+
 	SDL_AudioDeviceID sdldevice = 0;
 
 	MixerState state = MixerState::Uninitialized; // use set_mixer_state()
@@ -202,6 +276,11 @@ struct MixerSettings {
 	ChorusSettings chorus = {};
 	bool do_chorus        = false;
 
+	// Only the active master stages, in processing order. Rebuilt by
+	// rebuild_master_chain() whenever an effect is toggled, so the
+	// per-chunk loop never branches on disabled features.
+	std::vector<MasterStage> master_chain = {};
+
 	bool is_manually_muted = false;
 };
 
@@ -209,6 +288,139 @@ static struct MixerSettings mixer = {};
 
 alignas(sizeof(float)) uint8_t MixTemp[MixerBufferLength] = {};
 
+// Apply reverb effect to the reverb aux buffer, then mix the results to
+// the master output
+static void apply_reverb_stage(const work_index_t start_pos, const work_index_t frames)
+{
+	const auto start_us = GetTicksUs();
+
+	// Flat de-ringed copies of the reverb send; MVerb operates on two
+	// non-interleaved sample streams
+	static float buf_left[MixerBufferLength]  = {};
+	static float buf_right[MixerBufferLength] = {};
+	static float* reverb_buf[2] = {buf_left, buf_right};
+
+	auto pos = start_pos;
+	for (work_index_t i = 0; i < frames; ++i) {
+		buf_left[i]  = mixer.aux_reverb[pos][0];
+		buf_right[i] = mixer.aux_reverb[pos][1];
+
+		pos = (pos + 1) & MixerBufferMask;
+	}
+
+	// High-pass filter the reverb input
+	for (work_index_t i = 0; i < frames; ++i) {
+		buf_left[i]  = mixer.reverb.highpass_filter[0].filter(buf_left[i]);
+		buf_right[i] = mixer.reverb.highpass_filter[1].filter(buf_right[i]);
+	}
+
+	// One call processes the whole block in-place
+	mixer.reverb.mverb.process(reverb_buf, reverb_buf, frames);
+
+	pos = start_pos;
+	for (work_index_t i = 0; i < frames; ++i) {
+		mixer.work[pos][0] += buf_left[i];
+		mixer.work[pos][1] += buf_right[i];
+
+		pos = (pos + 1) & MixerBufferMask;
+	}
+
+	mixer.reverb_us += static_cast<uint64_t>(GetTicksUsSince(start_us));
+}
+
+// Apply chorus effect to the chorus aux buffer, then mix the results to
+// the master output
+static void apply_chorus_stage(const work_index_t start_pos, const work_index_t frames)
+{
+	const auto start_us = GetTicksUs();
+
+	// Flat de-ringed copies of the chorus send
+	static float buf_left[MixerBufferLength]  = {};
+	static float buf_right[MixerBufferLength] = {};
+
+	auto pos = start_pos;
+	for (work_index_t i = 0; i < frames; ++i) {
+		buf_left[i]  = mixer.aux_chorus[pos][0];
+		buf_right[i] = mixer.aux_chorus[pos][1];
+
+		pos = (pos + 1) & MixerBufferMask;
+	}
+
+	mixer.chorus.chorus_engine.process(buf_left, buf_right, frames);
+
+	pos = start_pos;
+	for (work_index_t i = 0; i < frames; ++i) {
+		mixer.work[pos][0] += buf_left[i];
+		mixer.work[pos][1] += buf_right[i];
+
+		pos = (pos + 1) & MixerBufferMask;
+	}
+
+	mixer.chorus_us += static_cast<uint64_t>(GetTicksUsSince(start_us));
+}
+
+// Apply high-pass filter to the master output
+static void apply_master_highpass_stage(const work_index_t start_pos,
+                                        const work_index_t frames)
+{
+	auto pos = start_pos;
+
+	for (work_index_t i = 0; i < frames; ++i) {
+		for (size_t ch = 0; ch < 2; ++ch) {
+			mixer.work[pos][ch] = mixer.highpass_filter[ch].filter(
+			        mixer.work[pos][ch]);
+		}
+		pos = (pos + 1) & MixerBufferMask;
+	}
+}
+
+// Apply compressor to the master output as the very last step
+static void apply_compressor_stage(const work_index_t start_pos,
+                                   const work_index_t frames)
+{
+	// Flat de-ringed copies of the master output
+	static float buf_left[MixerBufferLength]  = {};
+	static float buf_right[MixerBufferLength] = {};
+
+	auto pos = start_pos;
+	for (work_index_t i = 0; i < frames; ++i) {
+		buf_left[i]  = mixer.work[pos][0];
+		buf_right[i] = mixer.work[pos][1];
+
+		pos = (pos + 1) & MixerBufferMask;
+	}
+
+	mixer.compressor.Process(buf_left, buf_right, frames);
+
+	pos = start_pos;
+	for (work_index_t i = 0; i < frames; ++i) {
+		mixer.work[pos][0] = buf_left[i];
+		mixer.work[pos][1] = buf_right[i];
+
+		pos = (pos + 1) & MixerBufferMask;
+	}
+}
+
+// Reassemble the flat list of active master stages in processing order.
+// Must be called after any change to the global effect settings.
+static void rebuild_master_chain()
+{
+	mixer.master_chain.clear();
+
+	if (mixer.do_reverb) {
+		mixer.master_chain.push_back(apply_reverb_stage);
+	}
+	if (mixer.do_chorus) {
+		mixer.master_chain.push_back(apply_chorus_stage);
+	}
+	// The master high-pass filter is always active
+	mixer.master_chain.push_back(apply_master_highpass_stage);
+
+	if (mixer.do_compressor) {
+		mixer.master_chain.push_back(apply_compressor_stage);
+	}
+}
+
 void MixerChannel::SetLineoutMap(const StereoLine map)
 {
 	output_map = map;
@@ -237,6 +449,30 @@ uint16_t MIXER_GetPreBufferMs()
 	return mixer.prebuffer_ms;
 }
 
+AudioBufferLevel MIXER_GetBufferLevel()
+{
+	const auto percent = mixer.buffer_occupancy_percent.load();
+
+	if (percent < mixer.buffer_low_watermark_percent) {
+		return AudioBufferLevel::BelowLowWatermark;
+	}
+	if (percent >= mixer.buffer_high_watermark_percent) {
+		return AudioBufferLevel::AboveHighWatermark;
+	}
+	return AudioBufferLevel::BetweenWatermarks;
+}
+
+uint32_t MIXER_GetUnderrunCount()
+{
+	return mixer.underruns.load();
+}
+
+void MIXER_GetEffectsStats(uint64_t& reverb_us, uint64_t& chorus_us)
+{
+	reverb_us = mixer.reverb_us.load();
+	chorus_us = mixer.chorus_us.load();
+}
+
 uint16_t MIXER_GetSampleRate()
 {
 	const auto sample_rate_hz = mixer.sample_rate.load();
@@ -491,6 +727,7 @@ void MIXER_SetReverbPreset(const ReverbPreset new_preset)
 	}
 
 	sync_reverb_setting(r.preset);
+	rebuild_master_chain();
 
 	if (mixer.do_reverb) {
 		LOG_MSG("MIXER: Reverb enabled ('%s' preset)", to_string(r.preset));
@@ -580,6 +817,7 @@ void MIXER_SetChorusPreset(const ChorusPreset new_preset)
 	}
 
 	sync_chorus_setting(c.preset);
+	rebuild_master_chain();
 
 	if (mixer.do_chorus) {
 		LOG_MSG("MIXER: Chorus enabled ('%s' preset)", to_string(c.preset));
@@ -591,6 +829,8 @@ void MIXER_SetChorusPreset(const ChorusPreset new_preset)
 static void init_compressor(const bool compressor_enabled)
 {
 	mixer.do_compressor = compressor_enabled;
+	rebuild_master_chain();
+
 	if (!mixer.do_compressor) {
 		LOG_MSG("MIXER: Master compressor disabled");
 		return;
@@ -875,6 +1115,129 @@ void MixerChannel::Enable(const bool should_enable)
 // --------
 //   - Speex resampling only if channel_rate != mixer_rate
 //
+// Builds the polyphase filter bank for a reducible in:out rate ratio.
+// Returns false when the ratio needs too many phases to be worth tabling,
+// in which case the caller falls back to the speex resampler.
+bool MixerChannel::ConfigurePolyphaseResampler(const uint32_t in_rate,
+                                               const uint32_t out_rate)
+{
+	// 1024 phases cover the 8000/11025/22050/44100 to 48000 families
+	// (at most 640 phases); beyond that the table gains little over the
+	// general-case resampler
+	constexpr uint32_t max_phases    = 1024;
+	constexpr uint32_t base_num_taps = 16;
+
+	const auto divisor = std::gcd(in_rate, out_rate);
+	const auto interp  = out_rate / divisor;
+	const auto decim   = in_rate / divisor;
+
+	if (interp > max_phases || decim > max_phases) {
+		return false;
+	}
+
+	// When decimating, the anti-alias cutoff drops by decim/interp, so
+	// the filter needs proportionally more taps to keep its shape
+	const auto num_taps = base_num_taps *
+	                      std::max(1u, (decim + interp - 1) / interp);
+
+	auto& p = polyphase;
+
+	p.interp_factor = interp;
+	p.decim_factor  = decim;
+	p.num_taps      = num_taps;
+	p.table.resize(static_cast<size_t>(num_taps) * interp);
+	p.history.resize(num_taps);
+
+	// Windowed-sinc low-pass at the narrower of the input and output
+	// Nyquist rates, evaluated at the interpolated rate in_rate * L. The
+	// full filter has num_taps * L coefficients; phase 'ph' keeps those
+	// at positions k * L + ph, stored contiguously per phase.
+	const auto total_taps = static_cast<size_t>(num_taps) * interp;
+	const auto center     = static_cast<double>(total_taps - 1) / 2.0;
+	const auto cutoff     = 1.0 / (2.0 * std::max(interp, decim));
+
+	auto sinc = [](const double x) {
+		return (x == 0.0) ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+	};
+
+	for (uint32_t ph = 0; ph < interp; ++ph) {
+		double sum = 0.0;
+		for (uint32_t k = 0; k < num_taps; ++k) {
+			const auto i = static_cast<double>(
+			        static_cast<size_t>(k) * interp + ph);
+
+			// Blackman window
+			const auto w = 0.42 -
+			               0.5 * std::cos(2.0 * M_PI * i /
+			                              static_cast<double>(total_taps - 1)) +
+			               0.08 * std::cos(4.0 * M_PI * i /
+			                               static_cast<double>(total_taps - 1));
+
+			const auto h = 2.0 * cutoff * sinc(2.0 * cutoff * (i - center)) * w;
+
+			p.table[static_cast<size_t>(ph) * num_taps + k] =
+			        static_cast<float>(h);
+			sum += h;
+		}
+		// Normalise each phase to unity DC gain to avoid ripple in the
+		// passband level
+		const auto scale = static_cast<float>(1.0 / sum);
+		for (uint32_t k = 0; k < num_taps; ++k) {
+			p.table[static_cast<size_t>(ph) * num_taps + k] *= scale;
+		}
+	}
+	return true;
+}
+
+void MixerChannel::InitPolyphaseState()
+{
+	auto& p = polyphase;
+
+	p.phase       = 0;
+	p.history_pos = 0;
+	std::fill(p.history.begin(), p.history.end(), AudioFrame{});
+}
+
+void MixerChannel::PolyphaseResample(const std::vector<float>& in,
+                                     std::vector<float>& out)
+{
+	auto& p = polyphase;
+
+	const auto interp   = p.interp_factor;
+	const auto decim    = p.decim_factor;
+	const auto num_taps = p.num_taps;
+
+	out.resize(0);
+
+	const auto num_in_frames = in.size() / 2;
+	for (size_t i = 0; i < num_in_frames; ++i) {
+		p.history[p.history_pos] = {in[i * 2], in[i * 2 + 1]};
+		p.history_pos = (p.history_pos + 1) % num_taps;
+
+		// Emit every output frame whose interpolated position falls
+		// before the next input frame
+		while (p.phase < interp) {
+			const float* coeffs = p.table.data() +
+			                      static_cast<size_t>(p.phase) * num_taps;
+			float left  = 0.0f;
+			float right = 0.0f;
+
+			// Walk the history ring from the newest frame backwards
+			auto idx = p.history_pos;
+			for (uint32_t k = 0; k < num_taps; ++k) {
+				idx = (idx == 0 ? num_taps : idx) - 1;
+				left += coeffs[k] * p.history[idx].left;
+				right += coeffs[k] * p.history[idx].right;
+			}
+			out.push_back(left);
+			out.push_back(right);
+
+			p.phase += decim;
+		}
+		p.phase -= interp;
+	}
+}
+
 void MixerChannel::ConfigureResampler()
 {
 	const auto channel_rate = sample_rate;
@@ -916,9 +1279,24 @@ void MixerChannel::ConfigureResampler()
 
 		do_resample = (in_rate != out_rate);
 		if (!do_resample) {
+			polyphase.enabled = false;
 			return;
 		}
 
+		// Table-driven polyphase path for simple rational ratios;
+		// speex remains the fallback for arbitrary ones
+		polyphase.enabled = ConfigurePolyphaseResampler(in_rate, out_rate);
+		if (polyphase.enabled) {
+			InitPolyphaseState();
+#ifdef DEBUG_MIXER
+			LOG_DEBUG("%s: Polyphase resampler is on, ratio %u:%u",
+			          name.c_str(),
+			          polyphase.interp_factor,
+			          polyphase.decim_factor);
+#endif
+			break;
+		}
+
 		if (!speex_resampler.state) {
 			constexpr auto num_channels = 2; // always stereo
 			constexpr auto quality      = 5;
@@ -956,6 +1334,10 @@ void MixerChannel::ClearResampler()
 
 	case ResampleMethod::Resample:
 		if (do_resample) {
+			if (polyphase.enabled) {
+				InitPolyphaseState();
+				break;
+			}
 			assert(speex_resampler.state);
 			speex_resampler_reset_mem(speex_resampler.state);
 			speex_resampler_skip_zeros(speex_resampler.state);
@@ -1023,10 +1405,15 @@ void MixerChannel::SetPeakAmplitude(const int peak)
 
 void MixerChannel::Mix(const uint16_t frames_requested)
 {
+	ZoneScoped;
+	ZoneText(name.c_str(), name.length());
+
 	if (!is_enabled) {
 		return;
 	}
 
+	const auto start_time = std::chrono::steady_clock::now();
+
 	frames_needed = frames_requested;
 
 	while (frames_needed > frames_done) {
@@ -1046,6 +1433,16 @@ void MixerChannel::Mix(const uint16_t frames_requested)
 		handler(static_cast<work_index_t>(frames_remaining));
 	}
 
+	// Fold the cost of this call (the device's callback plus any
+	// resampling and effects it triggered) into the smoothed per-channel
+	// average, so MIXER.COM can attribute mixer time to channels
+	constexpr auto ewma_weight = 0.05;
+	const auto elapsed_us =
+	        std::chrono::duration<double, std::micro>(
+	                std::chrono::steady_clock::now() - start_time)
+	                .count();
+	avg_mix_time_us = avg_mix_time_us + ewma_weight * (elapsed_us - avg_mix_time_us);
+
 	if (do_sleep) {
 		sleeper.MaybeSleep();
 	}
@@ -1445,6 +1842,11 @@ float MixerChannel::GetChorusLevel() const
 	return chorus.level;
 }
 
+double MixerChannel::GetAvgMixTimeMicros() const
+{
+	return avg_mix_time_us.load();
+}
+
 // Floating-point conversion from unsigned 8-bit to signed 16-bit.
 // This is only used to populate a lookup table that's 20-fold faster.
 constexpr int16_t u8to16(const int u_val)
@@ -1593,12 +1995,158 @@ AudioFrame MixerChannel::ConvertNextFrame(const Type* data, const work_index_t p
 	return frame;
 }
 
+// Batch conversion for the steady-state common case: native signed 16-bit or
+// float input, default channel and output mappings, and no zero-order-hold
+// upsampling. Converts and applies the gain four frames per step with
+// SSE2/NEON where available; the scalar tail produces the same values as the
+// generic per-frame path.
+template <class Type, bool stereo>
+void MixerChannel::ConvertSamplesBatch(const Type* data, const uint16_t frames,
+                                       std::vector<float>& out)
+{
+	const auto gain_l = combined_volume_scalar.left;
+	const auto gain_r = combined_volume_scalar.right;
+
+	out.resize(static_cast<size_t>(frames) * 2);
+	float* out_pos = out.data();
+
+	// The stream is delayed by one frame: the first output frame is the
+	// last input frame of the previous call
+	*out_pos++ = next_frame.left * gain_l;
+	*out_pos++ = (stereo ? next_frame.right : next_frame.left) * gain_r;
+
+	// The remaining output frames are input frames 0 to frames - 2
+	const auto num_frames = static_cast<size_t>(frames) - 1;
+	size_t i = 0;
+
+	if constexpr (stereo) {
+		const auto num_samples = num_frames * 2;
+#if defined(__SSE2__)
+		const auto gains = _mm_set_ps(gain_r, gain_l, gain_r, gain_l);
+		if constexpr (std::is_same_v<Type, float>) {
+			for (; i + 4 <= num_samples; i += 4) {
+				_mm_storeu_ps(out_pos + i,
+				              _mm_mul_ps(_mm_loadu_ps(data + i),
+				                         gains));
+			}
+		} else {
+			for (; i + 8 <= num_samples; i += 8) {
+				const auto v = _mm_loadu_si128(
+				        reinterpret_cast<const __m128i*>(data + i));
+				const auto lo = _mm_srai_epi32(
+				        _mm_unpacklo_epi16(v, v), 16);
+				const auto hi = _mm_srai_epi32(
+				        _mm_unpackhi_epi16(v, v), 16);
+				_mm_storeu_ps(out_pos + i,
+				              _mm_mul_ps(_mm_cvtepi32_ps(lo), gains));
+				_mm_storeu_ps(out_pos + i + 4,
+				              _mm_mul_ps(_mm_cvtepi32_ps(hi), gains));
+			}
+		}
+#elif defined(__ARM_NEON)
+		const float32x4_t gains = {gain_l, gain_r, gain_l, gain_r};
+		if constexpr (std::is_same_v<Type, float>) {
+			for (; i + 4 <= num_samples; i += 4) {
+				vst1q_f32(out_pos + i,
+				          vmulq_f32(vld1q_f32(data + i), gains));
+			}
+		} else {
+			for (; i + 8 <= num_samples; i += 8) {
+				const int16x8_t v = vld1q_s16(data + i);
+				const auto lo = vcvtq_f32_s32(
+				        vmovl_s16(vget_low_s16(v)));
+				const auto hi = vcvtq_f32_s32(
+				        vmovl_s16(vget_high_s16(v)));
+				vst1q_f32(out_pos + i, vmulq_f32(lo, gains));
+				vst1q_f32(out_pos + i + 4, vmulq_f32(hi, gains));
+			}
+		}
+#endif
+		for (; i < num_samples; i += 2) {
+			out_pos[i]     = static_cast<float>(data[i]) * gain_l;
+			out_pos[i + 1] = static_cast<float>(data[i + 1]) * gain_r;
+		}
+	} else {
+		// Mono input feeds both output channels
+#if defined(__SSE2__)
+		const auto gains_l = _mm_set1_ps(gain_l);
+		const auto gains_r = _mm_set1_ps(gain_r);
+		for (; i + 4 <= num_frames; i += 4) {
+			__m128 v;
+			if constexpr (std::is_same_v<Type, float>) {
+				v = _mm_loadu_ps(data + i);
+			} else {
+				const auto s = _mm_loadl_epi64(
+				        reinterpret_cast<const __m128i*>(data + i));
+				v = _mm_cvtepi32_ps(_mm_srai_epi32(
+				        _mm_unpacklo_epi16(s, s), 16));
+			}
+			const auto l = _mm_mul_ps(v, gains_l);
+			const auto r = _mm_mul_ps(v, gains_r);
+			_mm_storeu_ps(out_pos + i * 2, _mm_unpacklo_ps(l, r));
+			_mm_storeu_ps(out_pos + i * 2 + 4, _mm_unpackhi_ps(l, r));
+		}
+#elif defined(__ARM_NEON)
+		const auto gains_l = vdupq_n_f32(gain_l);
+		const auto gains_r = vdupq_n_f32(gain_r);
+		for (; i + 4 <= num_frames; i += 4) {
+			float32x4_t v;
+			if constexpr (std::is_same_v<Type, float>) {
+				v = vld1q_f32(data + i);
+			} else {
+				v = vcvtq_f32_s32(vmovl_s16(vld1_s16(data + i)));
+			}
+			const float32x4x2_t lr = {vmulq_f32(v, gains_l),
+			                          vmulq_f32(v, gains_r)};
+			vst2q_f32(out_pos + i * 2, lr);
+		}
+#endif
+		for (; i < num_frames; ++i) {
+			const auto sample  = static_cast<float>(data[i]);
+			out_pos[i * 2]     = sample * gain_l;
+			out_pos[i * 2 + 1] = sample * gain_r;
+		}
+	}
+
+	// Maintain the one-frame delay state for the next call
+	auto load_frame = [&](const size_t idx) -> AudioFrame {
+		if constexpr (stereo) {
+			return {static_cast<float>(data[idx * 2]),
+			        static_cast<float>(data[idx * 2 + 1])};
+		} else {
+			return {static_cast<float>(data[idx]), 0.0f};
+		}
+	};
+	const auto last = static_cast<size_t>(frames) - 1;
+
+	prev_frame = (frames > 1) ? load_frame(last - 1) : next_frame;
+	next_frame = load_frame(last);
+}
+
 // Converts sample stream to floats, performs output channel mappings, removes
 // clicks, and optionally performs zero-order-hold-upsampling.
 template <class Type, bool stereo, bool signeddata, bool nativeorder>
 void MixerChannel::ConvertSamples(const Type* data, const uint16_t frames,
                                   std::vector<float>& out)
 {
+	// The batch path covers the steady state; the generic loop remains
+	// for custom mappings, upsampling, and the rarer sample formats
+	constexpr bool is_native_s16 = std::is_same_v<Type, int16_t> &&
+	                               signeddata && nativeorder;
+	constexpr bool is_native_float = std::is_same_v<Type, float>;
+
+	if constexpr (is_native_s16 || is_native_float) {
+		if (!do_zoh_upsample && channel_map == Stereo &&
+		    output_map == Stereo) {
+			ConvertSamplesBatch<Type, stereo>(data, frames, out);
+
+			// The start-up envelope runs in-place over the block
+			// and becomes a no-op via pointer swap once done
+			envelope.Process(stereo, out.data(), frames);
+			return;
+		}
+	}
+
 	// read-only aliases to avoid repeated dereferencing and to inform the
 	// compiler their values don't change
 	const auto mapped_output_left  = output_map.left;
@@ -1791,6 +2339,29 @@ AudioFrame MixerChannel::Sleeper::MaybeFadeOrListen(const AudioFrame& frame)
 	return frame;
 }
 
+// Block form of the above, in-place over interleaved stereo frames
+void MixerChannel::Sleeper::MaybeFadeOrListen(float* interleaved,
+                                              const uint16_t frames)
+{
+	const auto num_samples = static_cast<size_t>(frames) * 2;
+
+	if (wants_fadeout) {
+		for (size_t i = 0; i < num_samples; ++i) {
+			interleaved[i] *= fadeout_level;
+		}
+		return;
+	}
+	if (!had_signal) {
+		constexpr auto silence_threshold = 1.0f;
+		for (size_t i = 0; i < num_samples; ++i) {
+			if (fabsf(interleaved[i]) > silence_threshold) {
+				had_signal = true;
+				break;
+			}
+		}
+	}
+}
+
 void MixerChannel::Sleeper::MaybeSleep()
 {
 	const auto awake_for_ms = GetTicksSince(woken_at_ms);
@@ -1904,6 +2475,12 @@ void MixerChannel::AddSamples(const uint16_t frames, const Type* data)
 			// number of temporary buffers
 
 		case ResampleMethod::Resample: {
+			if (polyphase.enabled) {
+				PolyphaseResample(mixer.resample_temp,
+				                  mixer.resample_out);
+				break;
+			}
+
 			auto in_frames = check_cast<uint32_t>(
 			                         mixer.resample_temp.size()) /
 			                 2u;
@@ -1941,6 +2518,64 @@ void MixerChannel::AddSamples(const uint16_t frames, const Type* data)
 	auto mixpos = check_cast<work_index_t>((mixer.pos + frames_done) &
 	                                       MixerBufferMask);
 
+	// With no per-frame processing enabled, the remaining work is a plain
+	// accumulate into the master buffer, done vectorized in contiguous
+	// runs up to the ring buffer's wrap point
+	const bool plain_accumulate = !do_highpass_filter && !do_lowpass_filter &&
+	                              !do_crossfeed && !do_reverb_send &&
+	                              !do_chorus_send;
+	if (plain_accumulate) {
+		// The fade level only moves in MaybeSleep() between mixer
+		// callbacks, so fading or listening can run over the whole
+		// block before the accumulate
+		if (do_sleep) {
+			sleeper.MaybeFadeOrListen(mixer.resample_out.data(),
+			                          out_frames);
+		}
+
+		// The rows of the work matrix are contiguous float pairs
+		static_assert(sizeof(mixer.work) ==
+		              MixerBufferLength * 2 * sizeof(float));
+
+		auto remaining  = static_cast<size_t>(out_frames);
+		const float* in = mixer.resample_out.data();
+
+		while (remaining > 0) {
+			const auto run = std::min(
+			        remaining,
+			        static_cast<size_t>(MixerBufferLength - mixpos));
+
+			float* mix = mixer.work[mixpos].data();
+			const auto num_samples = run * 2;
+			size_t i = 0;
+#if defined(__SSE2__)
+			for (; i + 4 <= num_samples; i += 4) {
+				_mm_storeu_ps(mix + i,
+				              _mm_add_ps(_mm_loadu_ps(mix + i),
+				                         _mm_loadu_ps(in + i)));
+			}
+#elif defined(__ARM_NEON)
+			for (; i + 4 <= num_samples; i += 4) {
+				vst1q_f32(mix + i,
+				          vaddq_f32(vld1q_f32(mix + i),
+				                    vld1q_f32(in + i)));
+			}
+#endif
+			for (; i < num_samples; ++i) {
+				mix[i] += in[i];
+			}
+
+			in += num_samples;
+			mixpos = static_cast<work_index_t>((mixpos + run) &
+			                                   MixerBufferMask);
+			remaining -= run;
+		}
+		frames_done += out_frames;
+
+		MIXER_UnlockAudioDevice();
+		return;
+	}
+
 	while (pos != mixer.resample_out.end()) {
 		AudioFrame frame = {*pos++, *pos++};
 
@@ -2229,83 +2864,12 @@ static void mix_samples(const int frames_requested)
 		channel->Mix(check_cast<work_index_t>(frames_requested));
 	}
 
-	if (mixer.do_reverb) {
-		// Apply reverb effect to the reverb aux buffer, then mix the
-		// results to the master output
-		auto pos = start_pos;
-
-		for (work_index_t i = 0; i < frames_added; ++i) {
-			AudioFrame frame = {mixer.aux_reverb[pos][0],
-			                    mixer.aux_reverb[pos][1]};
-
-			// High-pass filter the reverb input
-			for (size_t ch = 0; ch < 2; ++ch) {
-				frame[ch] = mixer.reverb.highpass_filter[ch].filter(
-				        frame[ch]);
-			}
-
-			// MVerb operates on two non-interleaved sample streams
-			static float in_left[1]     = {};
-			static float in_right[1]    = {};
-			static float* reverb_buf[2] = {in_left, in_right};
-
-			in_left[0]  = frame.left;
-			in_right[0] = frame.right;
-
-			const auto in         = reverb_buf;
-			auto out              = reverb_buf;
-			constexpr auto frames = 1;
-			mixer.reverb.mverb.process(in, out, frames);
-
-			mixer.work[pos][0] += reverb_buf[0][0];
-			mixer.work[pos][1] += reverb_buf[1][0];
-
-			pos = (pos + 1) & MixerBufferMask;
-		}
-	}
-
-	if (mixer.do_chorus) {
-		// Apply chorus effect to the chorus aux buffer, then mix the
-		// results to the master output
-		auto pos = start_pos;
-
-		for (work_index_t i = 0; i < frames_added; ++i) {
-			AudioFrame frame = {mixer.aux_chorus[pos][0],
-			                    mixer.aux_chorus[pos][1]};
-
-			mixer.chorus.chorus_engine.process(&frame.left, &frame.right);
-
-			mixer.work[pos][0] += frame.left;
-			mixer.work[pos][1] += frame.right;
-
-			pos = (pos + 1) & MixerBufferMask;
-		}
-	}
-
-	// Apply high-pass filter to the master output
-	auto pos = start_pos;
-
-	for (work_index_t i = 0; i < frames_added; ++i) {
-		for (size_t ch = 0; ch < 2; ++ch) {
-			mixer.work[pos][ch] = mixer.highpass_filter[ch].filter(
-			        mixer.work[pos][ch]);
-		}
-		pos = (pos + 1) & MixerBufferMask;
-	}
-
-	if (mixer.do_compressor) {
-		// Apply compressor to the master output as the very last step
-		pos = start_pos;
-
-		for (work_index_t i = 0; i < frames_added; ++i) {
-			AudioFrame frame = {mixer.work[pos][0], mixer.work[pos][1]};
-
-			frame = mixer.compressor.Process(frame);
-
-			mixer.work[pos][0] = frame.left;
-			mixer.work[pos][1] = frame.right;
-
-			pos = (pos + 1) & MixerBufferMask;
+	// Run only the active master stages; the chain is rebuilt whenever an
+	// effect is toggled. In fast-forward mode nobody hears the output,
+	// so the effect processing is skipped entirely.
+	if (!DOSBOX_IsFastForwardMode()) {
+		for (const auto stage : mixer.master_chain) {
+			stage(start_pos, frames_added);
 		}
 	}
 
@@ -2388,6 +2952,64 @@ static void handle_mix_no_sound()
 	MIXER_UnlockAudioDevice();
 }
 
+static void apply_prebuffer(const int prebuffer_ms)
+{
+	mixer.prebuffer_ms = check_cast<uint16_t>(
+	        clamp(prebuffer_ms, 1, MaxPrebufferMs));
+
+	const auto prebuffer_frames = (mixer.sample_rate * mixer.prebuffer_ms) / 1000;
+	mixer.max_frames_needed = mixer.blocksize * 2 + 2 * prebuffer_frames;
+}
+
+// Walk the prebuffer toward the host's stable minimum. Each window of
+// callbacks records the smallest margin left after meeting the deadline;
+// a quiet window with comfortable margins shrinks the prebuffer by one
+// step, while an underrun backs it off and raises the floor so the walk
+// cannot return to a level the host has already failed at.
+static void adapt_latency_on_callback(const int frames_requested)
+{
+	auto& adapt = mixer.adapt;
+
+	adapt.min_margin_frames = std::min(adapt.min_margin_frames,
+	                                   mixer.frames_done - frames_requested);
+	++adapt.callbacks;
+
+	const auto underruns_now = mixer.underruns.load();
+	const bool underran      = (underruns_now != adapt.underruns_seen);
+
+	if (adapt.callbacks < AdaptWindowCallbacks && !underran) {
+		return;
+	}
+
+	if (underran) {
+		adapt.underruns_seen = underruns_now;
+		adapt.converged      = false;
+		adapt.floor_ms       = check_cast<uint16_t>(
+                        std::min(mixer.prebuffer_ms + 2, MaxPrebufferMs));
+		apply_prebuffer(mixer.prebuffer_ms * 3 / 2 + 1);
+
+	} else if (!adapt.converged) {
+		const auto step_ms = std::max(
+		        1, mixer.prebuffer_ms * AdaptStepDownPercent / 100);
+		const auto step_frames = (mixer.sample_rate * step_ms) / 1000;
+
+		// Only shrink while the tightest callback of the window would
+		// still have met its deadline with the smaller buffer
+		if (mixer.prebuffer_ms > adapt.floor_ms &&
+		    adapt.min_margin_frames > 2 * step_frames) {
+			apply_prebuffer(std::max<int>(mixer.prebuffer_ms - step_ms,
+			                              adapt.floor_ms));
+		} else {
+			adapt.converged = true;
+			LOG_MSG("MIXER: Adaptive latency converged on %u ms prebuffer",
+			        mixer.prebuffer_ms);
+		}
+	}
+
+	adapt.callbacks         = 0;
+	adapt.min_margin_frames = INT_MAX;
+}
+
 static void SDLCALL mixer_callback([[maybe_unused]] void* userdata,
                                    Uint8* stream, int len)
 {
@@ -2399,11 +3021,23 @@ static void SDLCALL mixer_callback([[maybe_unused]] void* userdata,
 	auto reduce_frames    = 0;
 	work_index_t pos      = 0;
 
+	if (mixer.adapt.active) {
+		adapt_latency_on_callback(frames_requested);
+	}
+
 	// Local resampling counter to manipulate the data when sending it off
 	// to the callback
 	auto index_add = (1 << IndexShiftLocal);
 	auto index     = (index_add % frames_requested) ? frames_requested : 0;
 
+	// Publish the buffer occupancy relative to the minimum needed before
+	// this callback drains it, so the cycle governor can react before an
+	// underrun becomes audible
+	if (const auto min_needed = mixer.min_frames_needed.load(); min_needed > 0) {
+		mixer.buffer_occupancy_percent = (mixer.frames_done * 100) /
+		                                 min_needed;
+	}
+
 	/* Enough room in the buffer ? */
 	if (mixer.frames_done < frames_requested) {
 		//		LOG_WARNING("Full underrun requested %d, have
@@ -2412,6 +3046,7 @@ static void SDLCALL mixer_callback([[maybe_unused]] void* userdata,
 		if ((frames_requested - mixer.frames_done) >
 		    (frames_requested >> 7)) { // Max 1 percent
 			                       // stretch.
+			++mixer.underruns;
 			return;
 		}
 		reduce_frames = mixer.frames_done;
@@ -2568,7 +3203,70 @@ static void SDLCALL mixer_callback([[maybe_unused]] void* userdata,
 	}
 }
 
-static void stop_mixer([[maybe_unused]] Section* sec) {}
+static std_fs::path get_latency_settings_path()
+{
+	return GetConfigDir() / "mixer-latency.conf";
+}
+
+// Start the walk from the point the previous session converged on; the
+// values are per config directory and thus per machine
+static void load_adaptive_latency_settings()
+{
+	FILE* f = fopen(get_latency_settings_path().string().c_str(), "r");
+	if (!f) {
+		return;
+	}
+	int blocksize    = 0;
+	int prebuffer_ms = 0;
+	const auto num_read = fscanf(f, "blocksize %d prebuffer %d",
+	                             &blocksize, &prebuffer_ms);
+	fclose(f);
+
+	const bool is_power_of_two = blocksize > 0 && !(blocksize & (blocksize - 1));
+	if (num_read != 2 || !is_power_of_two ||
+	    blocksize < AdaptMinBlocksize || blocksize > AdaptMaxBlocksize ||
+	    prebuffer_ms < AdaptFloorPrebufferMs || prebuffer_ms > MaxPrebufferMs) {
+		LOG_WARNING("MIXER: Invalid adaptive latency settings in '%s'; retuning",
+		            get_latency_settings_path().string().c_str());
+		return;
+	}
+
+	mixer.blocksize                = check_cast<uint16_t>(blocksize);
+	mixer.adapt.start_prebuffer_ms = check_cast<uint16_t>(prebuffer_ms);
+	mixer.adapt.have_persisted     = true;
+}
+
+static void save_adaptive_latency_settings()
+{
+	// The blocksize can only change by reopening the device, so it is
+	// walked across sessions: probe one size down after a clean run that
+	// bottomed out the prebuffer, back off after a rough one
+	int blocksize        = mixer.blocksize;
+	const auto underruns = mixer.underruns.load();
+
+	if (underruns > AdaptRoughSessionUnderruns) {
+		blocksize = std::min(blocksize * 2, AdaptMaxBlocksize);
+	} else if (underruns == 0 && mixer.adapt.converged &&
+	           mixer.prebuffer_ms <= mixer.adapt.floor_ms) {
+		blocksize = std::max(blocksize / 2, AdaptMinBlocksize);
+	}
+
+	FILE* f = fopen(get_latency_settings_path().string().c_str(), "w");
+	if (!f) {
+		LOG_WARNING("MIXER: Can't write adaptive latency settings to '%s'",
+		            get_latency_settings_path().string().c_str());
+		return;
+	}
+	fprintf(f, "blocksize %d\nprebuffer %u\n", blocksize, mixer.prebuffer_ms);
+	fclose(f);
+}
+
+static void stop_mixer([[maybe_unused]] Section* sec)
+{
+	if (mixer.adapt.active) {
+		save_adaptive_latency_settings();
+	}
+}
 
 [[maybe_unused]] static const char* MixerStateToString(const MixerState s)
 {
@@ -2765,6 +3463,14 @@ void MIXER_Init(Section* sec)
 	mixer.sample_rate = check_cast<uint16_t>(section->Get_int("rate"));
 	mixer.blocksize = static_cast<uint16_t>(section->Get_int("blocksize"));
 
+	mixer.adaptive_latency = section->Get_bool("adaptive_latency");
+	if (mixer.adaptive_latency) {
+		// May replace the configured blocksize with the one the
+		// previous session converged on; must happen before the
+		// device is opened
+		load_adaptive_latency_settings();
+	}
+
 	const auto configured_state = section->Get_bool("nosound")
 	                                    ? MixerState::NoSound
 	                                    : MixerState::On;
@@ -2789,6 +3495,32 @@ void MIXER_Init(Section* sec)
 	mixer.prebuffer_ms = check_cast<uint16_t>(
 	        clamp(requested_prebuffer_ms, 1, MaxPrebufferMs));
 
+	mixer.buffer_low_watermark_percent = clamp(section->Get_int("buffer_low_watermark"),
+	                                           MinBufferWatermarkPercent,
+	                                           MaxBufferWatermarkPercent);
+
+	mixer.buffer_high_watermark_percent = clamp(section->Get_int("buffer_high_watermark"),
+	                                            mixer.buffer_low_watermark_percent,
+	                                            MaxBufferWatermarkPercent);
+
+	if (mixer.adaptive_latency) {
+		// Resume just above the previously converged prebuffer, or
+		// start conservative and let the callback walk it down
+		const int start_ms = mixer.adapt.have_persisted
+		                           ? mixer.adapt.start_prebuffer_ms + 2
+		                           : std::max(mixer.prebuffer_ms,
+		                                      AdaptStartPrebufferMs);
+		mixer.prebuffer_ms = check_cast<uint16_t>(
+		        clamp(start_ms, 1, MaxPrebufferMs));
+
+		mixer.adapt.active            = (mixer.state == MixerState::On);
+		mixer.adapt.converged         = false;
+		mixer.adapt.floor_ms          = AdaptFloorPrebufferMs;
+		mixer.adapt.callbacks         = 0;
+		mixer.adapt.underruns_seen    = mixer.underruns.load();
+		mixer.adapt.min_margin_frames = INT_MAX;
+	}
+
 	const auto prebuffer_frames = (mixer.sample_rate * mixer.prebuffer_ms) / 1000;
 
 	mixer.pos           = 0;
@@ -2921,6 +3653,30 @@ void init_mixer_dosbox_settings(Section_prop& sec_prop)
 	                                 "will also be more lagged.",
 	                                 default_prebuffer_ms));
 
+	int_prop = sec_prop.Add_int("buffer_low_watermark", only_at_start,
+	                            DefaultBufferLowWatermarkPercent);
+	int_prop->SetMinMax(MinBufferWatermarkPercent, MaxBufferWatermarkPercent);
+	int_prop->Set_help(format_string(
+	        "Audio buffer occupancy, as a percentage of the prebuffered minimum, below\n"
+	        "which the auto cycle-adjusting backs off CPU cycles (%d by default).",
+	        DefaultBufferLowWatermarkPercent));
+
+	int_prop = sec_prop.Add_int("buffer_high_watermark", only_at_start,
+	                            DefaultBufferHighWatermarkPercent);
+	int_prop->SetMinMax(MinBufferWatermarkPercent, MaxBufferWatermarkPercent);
+	int_prop->Set_help(format_string(
+	        "Audio buffer occupancy the auto cycle-adjusting needs to regain before\n"
+	        "raising CPU cycles again (%d by default).",
+	        DefaultBufferHighWatermarkPercent));
+
+	bool_prop = sec_prop.Add_bool("adaptive_latency", only_at_start, false);
+	bool_prop->Set_help(
+	        "Tune 'blocksize' and 'prebuffer' to this machine automatically (disabled by\n"
+	        "default). Starts conservative, then walks the buffering down while the audio\n"
+	        "callbacks keep meeting their deadlines and backs off on underruns. The\n"
+	        "converged values are saved as 'mixer-latency.conf' in the configuration\n"
+	        "directory and picked up on the next start; delete the file to retune.");
+
 	bool_prop = sec_prop.Add_bool("negotiate", only_at_start, default_allow_negotiate);
 	bool_prop->Set_help(
 	        format_string("Let the system audio driver negotiate possibly better sample rate and blocksize\n"
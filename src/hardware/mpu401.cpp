@@ -109,6 +109,7 @@ struct MpuClock {
 	uint8_t cth_savecount = 0;
 
 	bool clock_to_host = false;
+	bool is_ticking    = false;
 };
 
 struct Mpu {
@@ -179,6 +180,28 @@ static void send_all_notes_off()
 	}
 }
 
+// The internal clock event is armed lazily from the port handlers: it only
+// runs while intelligent-mode playback or clock-to-host is active, so UART
+// mode (the common case) and idle intelligent mode keep no standing timer.
+static void MPU401_StartClock()
+{
+	if (mpu.clock.is_ticking)
+		return;
+	if (!(mpu.state.playing || mpu.clock.clock_to_host))
+		return;
+	mpu.clock.is_ticking = true;
+	PIC_AddEvent(MPU401_Event,
+	             MPU401_TIMECONSTANT / (mpu.clock.tempo * mpu.clock.timebase));
+}
+
+static void MPU401_StopClock()
+{
+	if (mpu.state.playing || mpu.clock.clock_to_host)
+		return;
+	mpu.clock.is_ticking = false;
+	PIC_RemoveEvents(MPU401_Event);
+}
+
 static void MPU401_WriteCommand(io_port_t, const io_val_t value, io_width_t)
 {
 	const auto val = check_cast<uint8_t>(value);
@@ -214,19 +237,14 @@ static void MPU401_WriteCommand(io_port_t, const io_val_t value, io_width_t)
 			LOG(LOG_MISC, LOG_ERROR)("MPU-401:Unhandled Recording Command %u", val);
 		switch (val & 0xc) {
 		case 0x4: // Stop
-			if (mpu.state.playing && !mpu.clock.clock_to_host)
-				PIC_RemoveEvents(MPU401_Event);
 			mpu.state.playing = false;
+			MPU401_StopClock();
 			send_all_notes_off();
 			break;
 		case 0x8: // Play
 			LOG(LOG_MISC, LOG_NORMAL)("MPU-401:Intelligent mode playback started");
-			if (!mpu.state.playing && !mpu.clock.clock_to_host)
-				PIC_AddEvent(MPU401_Event,
-				             MPU401_TIMECONSTANT /
-				                     (mpu.clock.tempo *
-				                      mpu.clock.timebase));
 			mpu.state.playing = true;
+			MPU401_StartClock();
 			ClrQueue();
 			break;
 		}
@@ -253,17 +271,12 @@ static void MPU401_WriteCommand(io_port_t, const io_val_t value, io_width_t)
 			break;
 		case 0x8f: mpu.state.cond_set = true; break;
 		case 0x94: // Clock to host
-			if (mpu.clock.clock_to_host && !mpu.state.playing)
-				PIC_RemoveEvents(MPU401_Event);
 			mpu.clock.clock_to_host = false;
+			MPU401_StopClock();
 			break;
 		case 0x95:
-			if (!mpu.clock.clock_to_host && !mpu.state.playing)
-				PIC_AddEvent(MPU401_Event,
-				             MPU401_TIMECONSTANT /
-				                     (mpu.clock.tempo *
-				                      mpu.clock.timebase));
 			mpu.clock.clock_to_host = true;
+			MPU401_StartClock();
 			break;
 			// Internal timebase
 		case 0xc2: mpu.clock.timebase = 48; break;
@@ -654,13 +667,15 @@ static void UpdateConductor()
 
 static void MPU401_Event(io_val_t)
 {
-	if (mpu.mode == M_UART)
+	if (mpu.mode == M_UART) {
+		mpu.clock.is_ticking = false;
 		return;
+	}
 
-	const auto event_delay = MPU401_TIMECONSTANT /
-	                         (mpu.clock.tempo * mpu.clock.timebase);
 	if (mpu.state.irq_pending) {
-		PIC_AddEvent(MPU401_Event, event_delay);
+		PIC_AddEvent(MPU401_Event,
+		             MPU401_TIMECONSTANT /
+		                     (mpu.clock.tempo * mpu.clock.timebase));
 		return;
 	}
 
@@ -695,7 +710,14 @@ static void MPU401_Event(io_val_t)
 	if (!mpu.state.irq_pending && mpu.state.req_mask)
 		MPU401_EOIHandler();
 
-	PIC_AddEvent(MPU401_Event, event_delay);
+	// Re-arm only while clocked work remains; the port handlers restart
+	// the clock when playback or clock-to-host turns back on
+	if (mpu.state.playing || mpu.clock.clock_to_host)
+		PIC_AddEvent(MPU401_Event,
+		             MPU401_TIMECONSTANT /
+		                     (mpu.clock.tempo * mpu.clock.timebase));
+	else
+		mpu.clock.is_ticking = false;
 }
 
 static void MPU401_EOIHandlerDispatch()
@@ -747,6 +769,7 @@ static void MPU401_Reset()
 	mpu.mode = (mpu.is_intelligent ? M_INTELLIGENT : M_UART);
 	PIC_RemoveEvents(MPU401_Event);
 	PIC_RemoveEvents(MPU401_EOIHandler);
+	mpu.clock.is_ticking = false;
 	mpu.state.eoi_scheduled = false;
 	mpu.state.wsd = false;
 	mpu.state.wsm = false;
@@ -18,6 +18,7 @@
 
 #include "opl.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
@@ -488,18 +489,28 @@ void OPL::Init(const uint16_t sample_rate)
 	case Mode::Opl2: break;
 	case Mode::DualOpl2:
 		// Setup opl3 mode in the hander
-		WriteReg(0x105, 1);
+		QueueWriteReg(0x105, 1);
 		// Also set it up in the cache so the capturing will start opl3
 		CacheWrite(0x105, 1);
 		break;
 	}
 }
 
-void OPL::WriteReg(const io_port_t selected_reg, const uint8_t val)
+// Runs on the emulation thread: records the write with its tick time and
+// tracks the new-mode bit, which gates address decoding in WriteAddr
+void OPL::QueueWriteReg(const io_port_t selected_reg, const uint8_t val)
 {
-	OPL3_WriteRegBuffered(&oplchip, selected_reg, val);
 	if (selected_reg == 0x105)
 		newm = selected_reg & 0x01;
+
+	write_queue.Enqueue({PIC_FullIndex(), selected_reg, val});
+}
+
+// Runs on the mixer thread, which replays the queued writes between
+// synthesised frames
+void OPL::WriteReg(const io_port_t selected_reg, const uint8_t val)
+{
+	OPL3_WriteRegBuffered(&oplchip, selected_reg, val);
 }
 
 io_port_t OPL::WriteAddr(const io_port_t port, const uint8_t val)
@@ -511,58 +522,51 @@ io_port_t OPL::WriteAddr(const io_port_t port, const uint8_t val)
 	return addr;
 }
 
-AudioFrame OPL::RenderFrame()
-{
-	static int16_t buf[2] = {};
-	OPL3_GenerateStream(&oplchip, buf, 1);
-
-	AudioFrame frame = {};
-	if (adlib_gold) {
-		adlib_gold->Process(buf, 1, &frame[0]);
-	} else {
-		frame.left  = buf[0];
-		frame.right = buf[1];
-	}
-	return frame;
-}
-
-void OPL::RenderUpToNow()
-{
-	const auto now = PIC_FullIndex();
-
-	// Wake up the channel and update the last rendered time datum.
-	assert(channel);
-	if (channel->WakeUp()) {
-		last_rendered_ms = now;
-		return;
-	}
-	// Keep rendering until we're current
-	while (last_rendered_ms < now) {
-		last_rendered_ms += ms_per_frame;
-		fifo.emplace(RenderFrame());
-	}
-}
-
 void OPL::AudioCallback(const uint16_t requested_frames)
 {
 	assert(channel);
 
-	//if (fifo.size())
-	//	LOG_MSG("OPL: Queued %2lu cycle-accurate frames", fifo.size());
+	const auto period_start_ms = last_rendered_ms;
 
-	auto frames_remaining = requested_frames;
+	// Only replay the writes queued before this callback started; writes
+	// racing in while we render belong to the next block
+	auto num_queued = write_queue.Size();
 
-	// First, send any frames we've queued since the last callback
-	while (frames_remaining && fifo.size()) {
-		channel->AddSamples_sfloat(1, &fifo.front()[0]);
-		fifo.pop();
-		--frames_remaining;
+	render_buf.resize(static_cast<size_t>(requested_frames) * 2);
+	uint16_t rendered = 0;
+
+	while (num_queued--) {
+		const auto write = write_queue.Dequeue();
+		if (!write)
+			break;
+
+		// Synthesise up to the write's frame offset within the block,
+		// then apply it, so it lands sample-accurately
+		const auto offset_ms = write->time_ms - period_start_ms;
+		const auto offset = static_cast<uint16_t>(std::clamp(
+		        offset_ms / ms_per_frame,
+		        static_cast<double>(rendered),
+		        static_cast<double>(requested_frames)));
+		if (offset > rendered) {
+			OPL3_GenerateStream(&oplchip,
+			                    &render_buf[rendered * 2u],
+			                    check_cast<uint16_t>(offset - rendered));
+			rendered = offset;
+		}
+		WriteReg(write->reg, write->val);
 	}
-	// If the queue's run dry, render the remainder and sync-up our time datum
-	while (frames_remaining) {
-		const auto frame = RenderFrame();
-		channel->AddSamples_sfloat(1, &frame[0]);
-		--frames_remaining;
+	if (requested_frames > rendered)
+		OPL3_GenerateStream(&oplchip,
+		                    &render_buf[rendered * 2u],
+		                    check_cast<uint16_t>(requested_frames - rendered));
+
+	if (adlib_gold) {
+		frame_buf.resize(static_cast<size_t>(requested_frames) * 2);
+		adlib_gold->Process(render_buf.data(), requested_frames,
+		                    frame_buf.data());
+		channel->AddSamples_sfloat(requested_frames, frame_buf.data());
+	} else {
+		channel->AddSamples_s16(requested_frames, render_buf.data());
 	}
 	last_rendered_ms = PIC_FullIndex();
 }
@@ -599,7 +603,7 @@ void OPL::DualWrite(const uint8_t index, const uint8_t port, const uint8_t value
 		val |= index ? 0xA0 : 0x50;
 	}
 	const auto full_port = check_cast<io_port_t>(port + (index ? 0x100 : 0u));
-	WriteReg(full_port, val);
+	QueueWriteReg(full_port, val);
 	CacheWrite(full_port, val);
 }
 
@@ -667,7 +671,13 @@ uint8_t OPL::AdlibGoldControlRead()
 
 void OPL::PortWrite(const io_port_t port, const io_val_t value, const io_width_t)
 {
-	RenderUpToNow();
+	// Port writes don't touch the synth core: they wake the channel and
+	// queue timestamped register writes, which the mixer-side renderer
+	// replays at their frame offsets while synthesising the block
+	assert(channel);
+	if (channel->WakeUp()) {
+		last_rendered_ms = PIC_FullIndex();
+	}
 
 	const auto val = check_cast<uint8_t>(value);
 
@@ -684,7 +694,7 @@ void OPL::PortWrite(const io_port_t port, const io_val_t value, const io_width_t
 		case Mode::Opl2:
 		case Mode::Opl3:
 			if (!chip[0].Write(reg.normal, val)) {
-				WriteReg(reg.normal, val);
+				QueueWriteReg(reg.normal, val);
 				CacheWrite(reg.normal, val);
 			}
 			break;
@@ -23,11 +23,12 @@
 
 #include <cmath>
 #include <memory>
-#include <queue>
+#include <vector>
 
 #include "adlib_gold.h"
 #include "mixer.h"
 #include "inout.h"
+#include "rwqueue.h"
 #include "setup.h"
 #include "pic.h"
 #include "hardware.h"
@@ -101,7 +102,19 @@ private:
 	IO_ReadHandleObject ReadHandler[3];
 	IO_WriteHandleObject WriteHandler[3];
 
-	std::queue<AudioFrame> fifo = {};
+	// A guest register write captured with its tick time; the mixer-side
+	// renderer replays it at the matching frame offset within the block,
+	// so port writes never touch the synth core directly
+	struct QueuedWrite {
+		double time_ms = 0.0;
+		io_port_t reg  = 0;
+		uint8_t val    = 0;
+	};
+	RWQueue<QueuedWrite> write_queue{8192};
+
+	// Scratch buffers reused by the audio callback's block rendering
+	std::vector<int16_t> render_buf = {};
+	std::vector<float> frame_buf = {};
 
 	Mode mode = {};
 
@@ -135,8 +148,6 @@ private:
 	void Init(const uint16_t sample_rate);
 
 	void AudioCallback(const uint16_t frames);
-	AudioFrame RenderFrame();
-	void RenderUpToNow();
 
 	void PortWrite(const io_port_t port, const io_val_t value,
 	               const io_width_t width);
@@ -144,6 +155,7 @@ private:
 	uint8_t PortRead(const io_port_t port, const io_width_t width);
 
 	io_port_t WriteAddr(const io_port_t port, const uint8_t val);
+	void QueueWriteReg(const io_port_t selected_reg, const uint8_t val);
 	void WriteReg(const io_port_t selected_reg, const uint8_t val);
 	void CacheWrite(const io_port_t port, const uint8_t val);
 	void DualWrite(const uint8_t index, const uint8_t reg, const uint8_t value);
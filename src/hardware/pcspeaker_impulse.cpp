@@ -405,7 +405,8 @@ void PcSpeakerImpulse::AddImpulse(float index, const int16_t amplitude)
 	index = clamp(index, 0.0f, 1.0f);
 
 #ifdef USE_LOOKUP_TABLES
-	// Use pre-calculated sinc lookup tables
+	// Quantize the edge's fractional position to one of the precomputed
+	// impulse responses
 	const auto samples_in_impulse = index * sample_rate_per_ms;
 	auto phase = static_cast<int>(samples_in_impulse * sinc_oversampling_factor) %
 	             sinc_oversampling_factor;
@@ -415,12 +416,14 @@ void PcSpeakerImpulse::AddImpulse(float index, const int16_t amplitude)
 		phase = sinc_oversampling_factor - phase;
 	}
 
-	for (uint16_t i = 0; i < sinc_filter_quality; ++i) {
-		const auto wave_i    = check_cast<uint16_t>(offset + i);
-		const auto impulse_i = check_cast<uint16_t>(
-		        phase + i * sinc_oversampling_factor);
-		waveform_deque.at(wave_i) += amplitude * impulse_lut.at(impulse_i);
-	}
+	// Accumulate the response's taps sequentially into the waveform
+	const auto &impulse  = impulse_bank.at(check_cast<uint16_t>(phase));
+	const auto wave_last = check_cast<uint16_t>(offset + sinc_filter_quality - 1);
+	assert(wave_last < waveform_deque.size());
+
+	for (uint16_t i = 0; i < sinc_filter_quality; ++i)
+		waveform_deque[check_cast<uint16_t>(offset + i)] +=
+		        amplitude * impulse[i];
 }
 
 #else
@@ -471,12 +474,16 @@ void PcSpeakerImpulse::ChannelCallback(uint16_t requested_frames)
 	}
 }
 
-void PcSpeakerImpulse::InitializeImpulseLUT()
+void PcSpeakerImpulse::InitializeImpulseBank()
 {
-	assert(impulse_lut.size() == sinc_filter_width);
-	for (auto i = 0u; i < sinc_filter_width; ++i)
-		impulse_lut[i] = CalcImpulse(i / (static_cast<double>(sample_rate) *
-		                                  sinc_oversampling_factor));
+	// Precompute the windowed-sinc response for every oversampled phase,
+	// with each phase's taps laid out contiguously
+	constexpr auto oversampled_rate = static_cast<double>(sample_rate) *
+	                                  sinc_oversampling_factor;
+	for (auto phase = 0u; phase < sinc_oversampling_factor; ++phase)
+		for (auto i = 0u; i < sinc_filter_quality; ++i)
+			impulse_bank[phase][i] = CalcImpulse(
+			        (phase + i * sinc_oversampling_factor) / oversampled_rate);
 }
 
 void PcSpeakerImpulse::SetFilterState(const FilterState filter_state)
@@ -520,7 +527,7 @@ PcSpeakerImpulse::PcSpeakerImpulse()
 	static_assert(sample_rate % 1000 == 0,
 	              "Sample rate must be a multiple of 1000");
 
-	InitializeImpulseLUT();
+	InitializeImpulseBank();
 
 	// Size the waveform queue
 	constexpr auto waveform_size = sinc_filter_quality + sample_rate_per_ms;
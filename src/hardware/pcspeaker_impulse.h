@@ -47,7 +47,7 @@ private:
 	void ChannelCallback(uint16_t requested_frames);
 	void ForwardPIT(const float new_index);
 	float CalcImpulse(const double t) const;
-	void InitializeImpulseLUT();
+	void InitializeImpulseBank();
 
 	// Constants
 	static constexpr auto device_name = ChannelName::PcSpeaker;
@@ -81,8 +81,6 @@ private:
 	static constexpr float sinc_amplitude_fade         = 0.999f;
 	static constexpr uint16_t sinc_filter_quality      = 100u;
 	static constexpr uint16_t sinc_oversampling_factor = 32u;
-	static constexpr uint16_t sinc_filter_width = sinc_filter_quality *
-	                                              sinc_oversampling_factor;
 
 	static constexpr float max_possible_pit_ms = 1320000.0f / PIT_TICK_RATE;
 
@@ -111,7 +109,10 @@ private:
 
 	std::deque<float> waveform_deque = {};
 
-	std::array<float, sinc_filter_width> impulse_lut = {};
+	// Impulse responses precomputed per fractional edge position: one
+	// contiguous row of filter taps for each oversampled phase, so an
+	// edge becomes a single sequential table-indexed accumulate
+	std::array<std::array<float, sinc_filter_quality>, sinc_oversampling_factor> impulse_bank = {};
 
 	mixer_channel_t channel = nullptr;
 
@@ -0,0 +1,132 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <algorithm>
+#include <chrono>
+
+#include "checks.h"
+#include "dosbox.h"
+#include "inout.h"
+#include "pic.h"
+#include "setup.h"
+
+CHECK_NARROWING();
+
+// Paravirtual performance counter interface, so profiling tools running
+// inside the guest can bracket code sections with precise timestamps
+// instead of relying on the 18.2 Hz BIOS tick.
+//
+// Protocol (all on a single port):
+// - OUT selects a counter by index and latches its current 64-bit value
+// - two subsequent dword INs return the latched value, low half first
+//
+// Latching on the OUT keeps the two halves coherent and makes the reads
+// side-effect free and repeatable.
+
+static bool is_interface_enabled = false;
+
+enum class PerfCounter : uint8_t {
+	// Emulated CPU cycles, derived from the millisecond tick count and
+	// the position within the current tick. Deltas are exact while the
+	// cycles setting is stable; with 'cycles=auto' or 'cycles=max' they
+	// are scaled by whatever rate is in effect at read time.
+	EmulatedCycles = 0,
+
+	// Host monotonic clock, in nanoseconds
+	HostNanoseconds = 1,
+
+	// The instantaneous cycles-per-millisecond setting, for converting
+	// cycle deltas into emulated time under 'cycles=auto' tuning
+	CyclesPerMs = 2,
+};
+
+static uint64_t latched_value = 0;
+
+// Which half of the latched value the next read returns
+static bool read_high_half = false;
+
+static uint64_t get_emulated_cycles()
+{
+	const auto cycles_per_ms = static_cast<uint64_t>(CPU_CycleMax);
+	const auto within_tick   = static_cast<int64_t>(PIC_TickIndexND());
+
+	const auto total = static_cast<int64_t>(PIC_Ticks * cycles_per_ms) +
+	                   within_tick;
+	return static_cast<uint64_t>(std::max(total, INT64_C(0)));
+}
+
+static uint64_t get_host_nanoseconds()
+{
+	const auto now = std::chrono::steady_clock::now().time_since_epoch();
+	const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now);
+	return static_cast<uint64_t>(ns.count());
+}
+
+static void port_write_perfcounter(const io_port_t, const io_val_t value,
+                                   const io_width_t)
+{
+	switch (static_cast<PerfCounter>(value & 0xff)) {
+	case PerfCounter::EmulatedCycles:
+		latched_value = get_emulated_cycles();
+		break;
+	case PerfCounter::HostNanoseconds:
+		latched_value = get_host_nanoseconds();
+		break;
+	case PerfCounter::CyclesPerMs:
+		latched_value = static_cast<uint64_t>(CPU_CycleMax);
+		break;
+	default:
+		LOG_WARNING("PERFCOUNTER: unimplemented counter index %u",
+		            value & 0xff);
+		latched_value = 0;
+		break;
+	}
+	read_high_half = false;
+}
+
+static uint32_t port_read_perfcounter(const io_port_t, const io_width_t)
+{
+	const auto shift = read_high_half ? 32 : 0;
+	read_high_half   = !read_high_half;
+	return static_cast<uint32_t>(latched_value >> shift);
+}
+
+void PERFCOUNTER_Destroy(Section*)
+{
+	if (is_interface_enabled) {
+		IO_FreeReadHandler(port_num_perfcounter, io_width_t::dword);
+		IO_FreeWriteHandler(port_num_perfcounter, io_width_t::byte);
+		is_interface_enabled = false;
+	}
+}
+
+void PERFCOUNTER_Init(Section* sec)
+{
+	if (!is_interface_enabled) {
+		sec->AddDestroyFunction(&PERFCOUNTER_Destroy, false);
+		IO_RegisterReadHandler(port_num_perfcounter,
+		                       port_read_perfcounter,
+		                       io_width_t::dword);
+		IO_RegisterWriteHandler(port_num_perfcounter,
+		                        port_write_perfcounter,
+		                        io_width_t::byte);
+		is_interface_enabled = true;
+	}
+}
@@ -17,12 +17,16 @@
  */
 
 #include "dosbox.h"
+
+#include <cinttypes>
+
 #include "inout.h"
 #include "cpu.h"
 #include "callback.h"
 #include "pic.h"
 #include "timer.h"
 #include "setup.h"
+#include "tracy.h"
 
 // PIC Controllers
 // ~~~~~~~~~~~~~~~
@@ -40,6 +44,9 @@
 
 #define PIC_QUEUESIZE 512
 
+// number of one-millisecond slots in the event wheel; must be a power of two
+#define PIC_WHEELSIZE 64
+
 struct PIC_Controller {
 	Bitu icw_words;
 	Bitu icw_index;
@@ -134,6 +141,13 @@ struct PIC_Controller {
 static PIC_Controller pics[2];
 static PIC_Controller &primary_controller = pics[0];
 static PIC_Controller &secondary_controller = pics[1];
+
+static void (*irq0_eoi_handler)() = nullptr;
+
+void PIC_SetIRQ0EOIHandler(void (*handler)())
+{
+	irq0_eoi_handler = handler;
+}
 uint32_t PIC_Ticks = 0;
 uint32_t PIC_IRQCheck = 0; // x86 dynamic core expects a 32 bit variable size
 
@@ -191,16 +205,31 @@ void PIC_Controller::start_irq(uint8_t val) {
 
 
 struct PICEntry {
-	double index;
+	double index; // due time in milliseconds, same scale as PIC_FullIndex()
 	Bitu value;
 	PIC_EventHandler pic_event;
 	PICEntry * next;
 };
 
+// Calendar-style event wheel with one sorted slot per upcoming millisecond,
+// selected by the due tick modulo the wheel size. Inserting an event only
+// walks the handful of entries that share its millisecond instead of the
+// whole queue. Events due beyond a wheel revolution wait in the sorted
+// overflow list and migrate into their slot once it comes within the
+// horizon (see TIMER_AddTick).
 static struct {
 	PICEntry entries[PIC_QUEUESIZE];
 	PICEntry * free_entry;
-	PICEntry * next_entry;
+	PICEntry * slots[PIC_WHEELSIZE];
+	PICEntry * overflow;
+
+	// counters for judging queue pressure, logged on shutdown
+	struct {
+		uint32_t num_queued;
+		uint32_t max_queued;
+		uint64_t num_insertions;
+		uint64_t num_insertion_steps;
+	} stats;
 } pic_queue;
 
 static void write_command(io_port_t port, io_val_t value, io_width_t)
@@ -232,6 +261,7 @@ static void write_command(io_port_t port, io_val_t value, io_width_t)
 		}
 	} else {	// OCW2 issued
 		if (val&0x20) {		// EOI commands
+			const auto prev_isr = pic->isr;
 			if (GCC_UNLIKELY(val&0x80)) E_Exit("rotate mode not supported");
 			if (val&0x40) {		// specific EOI
 				pic->isr &= ~(1<< ((val-0x60)));
@@ -239,7 +269,7 @@ static void write_command(io_port_t port, io_val_t value, io_width_t)
 				pic->check_after_EOI();
 //				if (val&0x80);	// perform rotation
 			} else {		// nonspecific EOI
-				if (pic->active_irq != 8) { 
+				if (pic->active_irq != 8) {
 					//If there is no irq in service, ignore the call, some games send an eoi to both pics when a sound irq happens (regardless of the irq).
 					pic->isr &= ~(1 << (pic->active_irq));
 					pic->isrr = ~pic->isr;
@@ -247,6 +277,12 @@ static void write_command(io_port_t port, io_val_t value, io_width_t)
 				}
 //				if (val&0x80);	// perform rotation
 			}
+			// IRQ 0 just completed: let the PIT measure the
+			// handler and feed its next banked tick
+			if (irq0_eoi_handler && pic == &pics[0] &&
+			    (prev_isr & 1) && !(pic->isr & 1)) {
+				irq0_eoi_handler();
+			}
 		} else {
 			if ((val&0x40)==0) {		// rotate in auto EOI mode
 				if (val&0x80) pic->rotate_on_auto_eoi=true;
@@ -416,34 +452,42 @@ void PIC_SetIRQMask(uint32_t irq, bool masked)
 	pic->set_imr(newmask);
 }
 
+// the tick whose wheel slot an entry belongs in; overdue events are clamped
+// to the current tick so they run this millisecond
+static uint32_t EntryDueTick(const PICEntry * entry) {
+	if (entry->index <= PIC_Ticks) return PIC_Ticks;
+	// work with the offset so the result wraps along with PIC_Ticks
+	return PIC_Ticks + static_cast<uint32_t>(entry->index - PIC_Ticks);
+}
+
+// sorted insert that keeps FIFO order between events due at the same time
+static void InsertSorted(PICEntry ** where, PICEntry * entry) {
+	while (*where && (*where)->index <= entry->index) {
+		where = &(*where)->next;
+		++pic_queue.stats.num_insertion_steps;
+	}
+	entry->next=*where;
+	*where=entry;
+}
+
 static void AddEntry(PICEntry * entry) {
-	PICEntry * find_entry=pic_queue.next_entry;
-	if (GCC_UNLIKELY(find_entry ==nullptr)) {
-		entry->next=nullptr;
-		pic_queue.next_entry=entry;
-	} else if (find_entry->index>entry->index) {
-		pic_queue.next_entry=entry;
-		entry->next=find_entry;
-	} else while (find_entry) {
-		if (find_entry->next) {
-			/* See if the next index comes later than this one */
-			if (find_entry->next->index > entry->index) {
-				entry->next=find_entry->next;
-				find_entry->next=entry;
-				break;
-			} else {
-				find_entry=find_entry->next;
-			}
-		} else {
-			entry->next=find_entry->next;
-			find_entry->next=entry;
-			break;
-		}
+	++pic_queue.stats.num_insertions;
+	const auto due_tick = EntryDueTick(entry);
+	if (due_tick - PIC_Ticks < PIC_WHEELSIZE) {
+		InsertSorted(&pic_queue.slots[due_tick % PIC_WHEELSIZE], entry);
+	} else {
+		InsertSorted(&pic_queue.overflow, entry);
+	}
+	if (++pic_queue.stats.num_queued > pic_queue.stats.max_queued) {
+		pic_queue.stats.max_queued = pic_queue.stats.num_queued;
 	}
-	Bits cycles=PIC_MakeCycles(pic_queue.next_entry->index-PIC_TickIndex());
-	if (cycles<CPU_Cycles) {
-		CPU_CycleLeft+=CPU_Cycles;
-		CPU_Cycles=0;
+	/* Shorten the current cycle slice if the event is due within it */
+	if (entry->index < PIC_Ticks + 1) {
+		Bits cycles=PIC_MakeCycles(entry->index-PIC_FullIndex());
+		if (cycles<CPU_Cycles) {
+			CPU_CycleLeft+=CPU_Cycles;
+			CPU_Cycles=0;
+		}
 	}
 }
 static bool InEventService = false;
@@ -457,7 +501,7 @@ void PIC_AddEvent(PIC_EventHandler handler, double delay, uint32_t val)
 	}
 	PICEntry * entry=pic_queue.free_entry;
 	if(InEventService) entry->index = delay + srv_lag;
-	else entry->index = delay + PIC_TickIndex();
+	else entry->index = delay + PIC_FullIndex();
 
 	entry->pic_event=handler;
 	entry->value=val;
@@ -465,59 +509,50 @@ void PIC_AddEvent(PIC_EventHandler handler, double delay, uint32_t val)
 	AddEntry(entry);
 }
 
-void PIC_RemoveSpecificEvents(PIC_EventHandler handler, uint32_t val)
-{
-	PICEntry *entry = pic_queue.next_entry;
-	PICEntry *prev_entry;
-	prev_entry = nullptr;
+// unlink every event for the handler (optionally limited to one value)
+// from the list and put the entries back on the free list
+static void RemoveEvents(PICEntry ** where, PIC_EventHandler handler,
+                         const bool match_value, const uint32_t value) {
+	PICEntry * entry=*where;
 	while (entry) {
-		if (GCC_UNLIKELY((entry->pic_event == handler)) && (entry->value == val)) {
-			if (prev_entry) {
-				prev_entry->next=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=prev_entry->next;
-				continue;
-			} else {
-				pic_queue.next_entry=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=pic_queue.next_entry;
-				continue;
-			}
+		if (GCC_UNLIKELY(entry->pic_event==handler) &&
+		    (!match_value || entry->value==value)) {
+			*where=entry->next;
+			entry->next=pic_queue.free_entry;
+			pic_queue.free_entry=entry;
+			--pic_queue.stats.num_queued;
+		} else {
+			where=&entry->next;
 		}
-		prev_entry=entry;
-		entry=entry->next;
+		entry=*where;
+	}
+}
+
+void PIC_RemoveSpecificEvents(PIC_EventHandler handler, uint32_t val)
+{
+	for (auto& slot : pic_queue.slots) {
+		RemoveEvents(&slot, handler, true, val);
 	}
+	RemoveEvents(&pic_queue.overflow, handler, true, val);
 }
 
 void PIC_RemoveEvents(PIC_EventHandler handler) {
-	PICEntry * entry=pic_queue.next_entry;
-	PICEntry * prev_entry;
-	prev_entry=nullptr;
-	while (entry) {
-		if (GCC_UNLIKELY(entry->pic_event==handler)) {
-			if (prev_entry) {
-				prev_entry->next=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=prev_entry->next;
-				continue;
-			} else {
-				pic_queue.next_entry=entry->next;
-				entry->next=pic_queue.free_entry;
-				pic_queue.free_entry=entry;
-				entry=pic_queue.next_entry;
-				continue;
-			}
-		}
-		prev_entry=entry;
-		entry=entry->next;
+	for (auto& slot : pic_queue.slots) {
+		RemoveEvents(&slot, handler, false, 0);
 	}
+	RemoveEvents(&pic_queue.overflow, handler, false, 0);
+}
+
+uint32_t PIC_QueueDepth()
+{
+	// sampled without synchronisation by the telemetry thread; a count
+	// one event stale is fine
+	return pic_queue.stats.num_queued;
 }
 
 
 bool PIC_RunQueue(void) {
+	ZoneScoped;
 	/* Check to see if a new millisecond needs to be started */
 	CPU_CycleLeft+=CPU_Cycles;
 	CPU_Cycles=0;
@@ -525,14 +560,30 @@ bool PIC_RunQueue(void) {
 		return false;
 	}
 
+	/* Check this millisecond's wheel slot for due entries. Event
+	   handlers can schedule new immediate events, so re-read the slot
+	   head on every iteration. */
+	auto& slot = pic_queue.slots[PIC_Ticks % PIC_WHEELSIZE];
+
+	/* Common case: nothing is scheduled for this millisecond, so hand
+	   the remaining cycles to the core after a single branch and skip
+	   the due-time math entirely */
+	if (!slot) {
+		CPU_Cycles   = CPU_CycleLeft;
+		CPU_CycleLeft = 0;
+		if (PIC_IRQCheck && GETFLAG(IF))
+			PIC_runIRQs();
+		return true;
+	}
+
 	const auto index_nd_f = static_cast<double>(PIC_TickIndexND());
 
-	/* Check the queue for an entry */
 	InEventService = true;
-	while (pic_queue.next_entry &&
-	       (pic_queue.next_entry->index * static_cast<double>(CPU_CycleMax) <= index_nd_f)) {
-		PICEntry *entry = pic_queue.next_entry;
-		pic_queue.next_entry = entry->next;
+	while (slot && ((slot->index - PIC_Ticks) *
+	                        static_cast<double>(CPU_CycleMax) <= index_nd_f)) {
+		PICEntry *entry = slot;
+		slot = entry->next;
+		--pic_queue.stats.num_queued;
 
 		srv_lag = entry->index;
 		(entry->pic_event)(entry->value); // call the event handler
@@ -544,9 +595,9 @@ bool PIC_RunQueue(void) {
 	InEventService = false;
 
 	/* Check when to set the new cycle end */
-	if (pic_queue.next_entry) {
+	if (slot && slot->index < PIC_Ticks + 1) {
 		auto cycles = static_cast<int32_t>(
-		        pic_queue.next_entry->index * static_cast<double>(CPU_CycleMax) -
+		        (slot->index - PIC_Ticks) * static_cast<double>(CPU_CycleMax) -
 		        index_nd_f);
 		if (GCC_UNLIKELY(!cycles))
 			cycles = 1;
@@ -557,7 +608,11 @@ bool PIC_RunQueue(void) {
 		}
 	} else CPU_Cycles=CPU_CycleLeft;
 	CPU_CycleLeft-=CPU_Cycles;
-	if (PIC_IRQCheck) PIC_runIRQs();
+	/* The IF test is hoisted out of PIC_runIRQs: while the guest is
+	   servicing an interrupt a pending-but-blocked IRQ would otherwise
+	   pay for the call on every slice */
+	if (PIC_IRQCheck && GETFLAG(IF))
+		PIC_runIRQs();
 	return true;
 }
 
@@ -596,11 +651,33 @@ void TIMER_AddTick(void) {
 	CPU_CycleLeft=CPU_CycleMax;
 	CPU_Cycles=0;
 	PIC_Ticks++;
-	/* Go through the list of scheduled events and lower their index with 1000 */
-	PICEntry * entry=pic_queue.next_entry;
-	while (entry) {
-		entry->index -= 1.0f;
-		entry=entry->next;
+	if (GCC_UNLIKELY(PIC_Ticks == 0)) {
+		/* PIC_Ticks wrapped around; rebase the absolute due times */
+		constexpr auto wrap_ms = 4294967296.0; // 2^32
+		for (auto& slot : pic_queue.slots) {
+			for (PICEntry * entry=slot; entry; entry=entry->next) {
+				entry->index -= wrap_ms;
+			}
+		}
+		for (PICEntry * entry=pic_queue.overflow; entry; entry=entry->next) {
+			entry->index -= wrap_ms;
+		}
+	}
+	/* Carry over any events the previous millisecond left behind (an
+	   event can be scheduled after the last PIC_RunQueue of its tick) */
+	auto& prev_slot = pic_queue.slots[(PIC_Ticks - 1) % PIC_WHEELSIZE];
+	while (prev_slot && prev_slot->index < PIC_Ticks) {
+		PICEntry * entry=prev_slot;
+		prev_slot=entry->next;
+		InsertSorted(&pic_queue.slots[PIC_Ticks % PIC_WHEELSIZE], entry);
+	}
+	/* Migrate overflow events that have come within the wheel horizon */
+	while (pic_queue.overflow &&
+	       EntryDueTick(pic_queue.overflow) - PIC_Ticks < PIC_WHEELSIZE) {
+		PICEntry * entry=pic_queue.overflow;
+		pic_queue.overflow=entry->next;
+		InsertSorted(&pic_queue.slots[EntryDueTick(entry) % PIC_WHEELSIZE],
+		             entry);
 	}
 	/* Call our list of ticker handlers */
 	TickerBlock * ticker=firstticker;
@@ -669,10 +746,23 @@ public:
 		}
 		pic_queue.entries[PIC_QUEUESIZE-1].next=nullptr;
 		pic_queue.free_entry=&pic_queue.entries[0];
-		pic_queue.next_entry=nullptr;
+		for (auto& slot : pic_queue.slots) {
+			slot = nullptr;
+		}
+		pic_queue.overflow = nullptr;
+		pic_queue.stats    = {};
 	}
 
 	~PIC_8259A(){
+		const auto& stats = pic_queue.stats;
+		if (stats.num_insertions) {
+			LOG_MSG("PIC: Event queue peaked at %u queued events; "
+			        "averaged %.2f sort steps over %" PRIu64 " insertions",
+			        stats.max_queued,
+			        static_cast<double>(stats.num_insertion_steps) /
+			                static_cast<double>(stats.num_insertions),
+			        stats.num_insertions);
+		}
 	}
 };
 
@@ -26,6 +26,7 @@
 #include <memory>
 #include <queue>
 #include <string.h>
+#include <vector>
 
 #include "channel_names.h"
 #include "control.h"
@@ -92,6 +93,7 @@ private:
 	IO_WriteHandleObject write_handlers[4] = {};
 	Ps1Registers regs = {};
 	uint8_t fifo[fifo_size] = {};
+	std::vector<float> render_buffer = {};
 
 	// Counters
 	size_t last_write = 0;
@@ -310,16 +312,16 @@ uint8_t Ps1Dac::ReadJoystickPorts204To207(io_port_t, io_width_t)
 
 void Ps1Dac::Update(uint16_t samples)
 {
-	uint8_t *buffer = MixTemp;
+	render_buffer.resize(samples);
+	float *buffer = render_buffer.data();
 
-	int32_t pending = 0;
+	uint32_t pending = 0;
 	uint32_t add = 0;
 	uint32_t pos = read_index_high;
-	uint16_t count = samples;
 
 	if (is_playing) {
 		regs.status = CalcStatus();
-		pending = static_cast<int32_t>(bytes_pending);
+		pending = bytes_pending;
 		add = adder;
 		if ((regs.status & fifo_nearly_empty_flag) && (can_trigger_irq)) {
 			// More bytes needed.
@@ -329,31 +331,38 @@ void Ps1Dac::Update(uint16_t samples)
 		}
 	}
 
-	while (count) {
-		uint8_t out = 0;
-		if (pending <= 0) {
-			pending = 0;
-			while (count--) {
-				*(buffer++) = fifo_midline;
-			}
-			break;
-		} else {
-			out = fifo[pos >> frac_shift];
-			pos += add;
-			pos &= (fifo_size << frac_shift) - 1;
-			pending -= static_cast<int32_t>(add);
-		}
-		*(buffer++) = out;
-		count--;
+	// The FIFO drains a fixed 'add' per output sample, so the span
+	// this block can drain is known up front; the drain and the
+	// silence fill then run as flat loops with no per-sample checks
+	uint16_t drainable = 0;
+	if (add > 0) {
+		const auto pending_samples = ceil_udivide(pending, add);
+		drainable = static_cast<uint16_t>(std::min(
+		        static_cast<uint32_t>(samples), pending_samples));
+	} else if (pending > 0) {
+		// A zero adder holds the FIFO's current byte indefinitely
+		drainable = samples;
+	}
+
+	for (uint16_t i = 0; i < drainable; ++i) {
+		buffer[i] = lut_u8to16[fifo[pos >> frac_shift]];
+		pos = (pos + add) & ((fifo_size << frac_shift) - 1);
 	}
+	const float midline_sample = lut_u8to16[fifo_midline];
+	for (uint16_t i = drainable; i < samples; ++i) {
+		buffer[i] = midline_sample;
+	}
+
 	// Update positions and see if we can clear the fifo_full_flag
 	read_index_high = pos;
 	read_index = static_cast<uint16_t>(pos >> frac_shift);
-	if (pending < 0)
-		pending = 0;
-	bytes_pending = static_cast<uint32_t>(pending);
+	const auto drained = static_cast<uint64_t>(drainable) * add;
+	bytes_pending = (drained < pending)
+	                        ? pending - static_cast<uint32_t>(drained)
+	                        : 0;
 
-	channel->AddSamples_m8(samples, MixTemp);
+	// Sending floats lets the mixer take its batch conversion path
+	channel->AddSamples_mfloat(samples, buffer);
 }
 
 Ps1Dac::~Ps1Dac()
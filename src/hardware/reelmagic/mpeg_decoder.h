@@ -824,6 +824,12 @@ plm_samples_t *plm_audio_decode(plm_audio_t *self);
 #include <string.h>
 #include <stdlib.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #ifndef TRUE
 #define TRUE 1
 #define FALSE 0
@@ -3370,6 +3376,78 @@ void plm_video_interpolate_macroblock(plm_video_t *self, plm_frame_t *s, int mot
 		DEST_INDEX += dest_scan; \
 	}} while(FALSE)
 
+#if defined(__SSE2__)
+
+static inline __m128i plm_video_mb_load(const uint8_t *p, int wide) {
+	return wide
+		? _mm_loadu_si128((const __m128i *)p)
+		: _mm_loadl_epi64((const __m128i *)p);
+}
+
+static inline void plm_video_mb_store(uint8_t *p, __m128i v, int wide) {
+	if (wide) {
+		_mm_storeu_si128((__m128i *)p, v);
+	}
+	else {
+		_mm_storel_epi64((__m128i *)p, v);
+	}
+}
+
+static inline __m128i plm_video_mb_avg(__m128i a, __m128i b) {
+	return _mm_avg_epu8(a, b);
+}
+
+// Exact (a + b + c + d + 2) >> 2 on unsigned bytes; cascading pavgb would
+// round differently than the scalar formula
+static inline __m128i plm_video_mb_avg4(__m128i a, __m128i b, __m128i c, __m128i d) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i two = _mm_set1_epi16(2);
+	__m128i lo = _mm_add_epi16(
+		_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)),
+		_mm_add_epi16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(d, zero)));
+	__m128i hi = _mm_add_epi16(
+		_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)),
+		_mm_add_epi16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(d, zero)));
+	lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+	hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+	return _mm_packus_epi16(lo, hi);
+}
+
+#elif defined(__ARM_NEON)
+
+static inline uint8x16_t plm_video_mb_load(const uint8_t *p, int wide) {
+	return wide
+		? vld1q_u8(p)
+		: vcombine_u8(vld1_u8(p), vdup_n_u8(0));
+}
+
+static inline void plm_video_mb_store(uint8_t *p, uint8x16_t v, int wide) {
+	if (wide) {
+		vst1q_u8(p, v);
+	}
+	else {
+		vst1_u8(p, vget_low_u8(v));
+	}
+}
+
+static inline uint8x16_t plm_video_mb_avg(uint8x16_t a, uint8x16_t b) {
+	return vrhaddq_u8(a, b);
+}
+
+// Exact (a + b + c + d + 2) >> 2 on unsigned bytes; cascading the rounding
+// halving-add would round differently than the scalar formula
+static inline uint8x16_t plm_video_mb_avg4(uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d) {
+	const uint16x8_t lo = vaddq_u16(
+		vaddl_u8(vget_low_u8(a), vget_low_u8(b)),
+		vaddl_u8(vget_low_u8(c), vget_low_u8(d)));
+	const uint16x8_t hi = vaddq_u16(
+		vaddl_u8(vget_high_u8(a), vget_high_u8(b)),
+		vaddl_u8(vget_high_u8(c), vget_high_u8(d)));
+	return vcombine_u8(vrshrn_n_u16(lo, 2), vrshrn_n_u16(hi, 2));
+}
+
+#endif
+
 void plm_video_process_macroblock(
 	plm_video_t *self, uint8_t *s, uint8_t *d,
 	int motion_h, int motion_v, int block_size, int interpolate
@@ -3383,12 +3461,37 @@ void plm_video_process_macroblock(
 
 	unsigned int si = ((self->mb_row * block_size) + vp) * dw + (self->mb_col * block_size) + hp;
 	unsigned int di = (self->mb_row * dw + self->mb_col) * block_size;
-	
+
 	unsigned int max_address = (dw * (self->mb_height * block_size - block_size + 1) - block_size);
 	if (si > max_address || di > max_address) {
 		return; // corrupt video
 	}
 
+#if defined(__SSE2__) || defined(__ARM_NEON)
+	// A whole luma (16) or chroma (8) row fits in one vector; each
+	// half-pel case below produces bit-identical results to the scalar
+	// formulas it replaces
+	const int wide = (block_size == 16);
+	for (int y = 0; y < block_size; y++, si += dw, di += dw) {
+		auto pred = plm_video_mb_load(s + si, wide);
+		if (odd_h && odd_v) {
+			pred = plm_video_mb_avg4(pred,
+			                         plm_video_mb_load(s + si + 1, wide),
+			                         plm_video_mb_load(s + si + dw, wide),
+			                         plm_video_mb_load(s + si + dw + 1, wide));
+		}
+		else if (odd_h) {
+			pred = plm_video_mb_avg(pred, plm_video_mb_load(s + si + 1, wide));
+		}
+		else if (odd_v) {
+			pred = plm_video_mb_avg(pred, plm_video_mb_load(s + si + dw, wide));
+		}
+		if (interpolate) {
+			pred = plm_video_mb_avg(plm_video_mb_load(d + di, wide), pred);
+		}
+		plm_video_mb_store(d + di, pred, wide);
+	}
+#else
 	#define PLM_MB_CASE(INTERPOLATE, ODD_H, ODD_V, OP) \
 		case ((INTERPOLATE << 2) | (ODD_H << 1) | (ODD_V)): \
 			PLM_BLOCK_SET(d, di, dw, si, dw, block_size, OP); \
@@ -3407,6 +3510,7 @@ void plm_video_process_macroblock(
 	}
 
 	#undef PLM_MB_CASE
+#endif
 }
 
 void plm_video_decode_block(plm_video_t *self, int block) {
@@ -3563,6 +3667,212 @@ void plm_video_decode_block(plm_video_t *self, int block) {
 	}
 }
 
+#if defined(__SSE2__)
+
+// Low 32 bits of a lane-wise 32x32 multiply (SSE2 lacks pmulld)
+static inline __m128i plm_video_idct_mul(__m128i a, int b) {
+	const __m128i bv = _mm_set1_epi32(b);
+	const __m128i even = _mm_mul_epu32(a, bv);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), bv);
+	return _mm_unpacklo_epi32(
+		_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+		_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+// One butterfly pass over eight coefficient vectors; lanes are independent
+// columns. The final pass applies the scalar row-transform's (x + 128) >> 8
+// rounding to the outputs.
+static inline void plm_video_idct_pass_sse2(__m128i v[8], int final) {
+	const __m128i c128 = _mm_set1_epi32(128);
+
+	__m128i b1 = v[4];
+	__m128i b3 = _mm_add_epi32(v[2], v[6]);
+	__m128i b4 = _mm_sub_epi32(v[5], v[3]);
+	__m128i tmp1 = _mm_add_epi32(v[1], v[7]);
+	__m128i tmp2 = _mm_add_epi32(v[3], v[5]);
+	__m128i b6 = _mm_sub_epi32(v[1], v[7]);
+	__m128i b7 = _mm_add_epi32(tmp1, tmp2);
+	__m128i m0 = v[0];
+	__m128i x4 = _mm_sub_epi32(
+		_mm_srai_epi32(_mm_add_epi32(_mm_sub_epi32(plm_video_idct_mul(b6, 473),
+		                                           plm_video_idct_mul(b4, 196)),
+		                             c128), 8),
+		b7);
+	__m128i x0 = _mm_sub_epi32(
+		x4,
+		_mm_srai_epi32(_mm_add_epi32(plm_video_idct_mul(_mm_sub_epi32(tmp1, tmp2), 362),
+		                             c128), 8));
+	__m128i x1 = _mm_sub_epi32(m0, b1);
+	__m128i x2 = _mm_sub_epi32(
+		_mm_srai_epi32(_mm_add_epi32(plm_video_idct_mul(_mm_sub_epi32(v[2], v[6]), 362),
+		                             c128), 8),
+		b3);
+	__m128i x3 = _mm_add_epi32(m0, b1);
+	__m128i y3 = _mm_add_epi32(x1, x2);
+	__m128i y4 = _mm_add_epi32(x3, b3);
+	__m128i y5 = _mm_sub_epi32(x1, x2);
+	__m128i y6 = _mm_sub_epi32(x3, b3);
+	__m128i y7 = _mm_sub_epi32(
+		_mm_sub_epi32(_mm_setzero_si128(), x0),
+		_mm_srai_epi32(_mm_add_epi32(_mm_add_epi32(plm_video_idct_mul(b4, 473),
+		                                           plm_video_idct_mul(b6, 196)),
+		                             c128), 8));
+
+	v[0] = _mm_add_epi32(b7, y4);
+	v[1] = _mm_add_epi32(x4, y3);
+	v[2] = _mm_sub_epi32(y5, x0);
+	v[3] = _mm_sub_epi32(y6, y7);
+	v[4] = _mm_add_epi32(y6, y7);
+	v[5] = _mm_add_epi32(x0, y5);
+	v[6] = _mm_sub_epi32(y3, x4);
+	v[7] = _mm_sub_epi32(y4, b7);
+
+	if (final) {
+		for (int i = 0; i < 8; i++) {
+			v[i] = _mm_srai_epi32(_mm_add_epi32(v[i], c128), 8);
+		}
+	}
+}
+
+static inline void plm_video_idct_transpose_4x4(__m128i *r0, __m128i *r1, __m128i *r2, __m128i *r3) {
+	__m128i t0 = _mm_unpacklo_epi32(*r0, *r1);
+	__m128i t1 = _mm_unpacklo_epi32(*r2, *r3);
+	__m128i t2 = _mm_unpackhi_epi32(*r0, *r1);
+	__m128i t3 = _mm_unpackhi_epi32(*r2, *r3);
+	*r0 = _mm_unpacklo_epi64(t0, t1);
+	*r1 = _mm_unpackhi_epi64(t0, t1);
+	*r2 = _mm_unpacklo_epi64(t2, t3);
+	*r3 = _mm_unpackhi_epi64(t2, t3);
+}
+
+// Transpose the 8x8 matrix held as row quadrants lo (columns 0-3) and
+// hi (columns 4-7)
+static inline void plm_video_idct_transpose_sse2(__m128i lo[8], __m128i hi[8]) {
+	plm_video_idct_transpose_4x4(&lo[0], &lo[1], &lo[2], &lo[3]);
+	plm_video_idct_transpose_4x4(&lo[4], &lo[5], &lo[6], &lo[7]);
+	plm_video_idct_transpose_4x4(&hi[0], &hi[1], &hi[2], &hi[3]);
+	plm_video_idct_transpose_4x4(&hi[4], &hi[5], &hi[6], &hi[7]);
+	for (int i = 0; i < 4; i++) {
+		__m128i t = hi[i];
+		hi[i] = lo[i + 4];
+		lo[i + 4] = t;
+	}
+}
+
+void plm_video_idct(int *block) {
+	__m128i lo[8], hi[8];
+	for (int i = 0; i < 8; i++) {
+		lo[i] = _mm_loadu_si128((const __m128i *)(block + i * 8));
+		hi[i] = _mm_loadu_si128((const __m128i *)(block + i * 8 + 4));
+	}
+
+	// Transform columns, then rows via a transposed column pass
+	plm_video_idct_pass_sse2(lo, FALSE);
+	plm_video_idct_pass_sse2(hi, FALSE);
+	plm_video_idct_transpose_sse2(lo, hi);
+	plm_video_idct_pass_sse2(lo, TRUE);
+	plm_video_idct_pass_sse2(hi, TRUE);
+	plm_video_idct_transpose_sse2(lo, hi);
+
+	for (int i = 0; i < 8; i++) {
+		_mm_storeu_si128((__m128i *)(block + i * 8), lo[i]);
+		_mm_storeu_si128((__m128i *)(block + i * 8 + 4), hi[i]);
+	}
+}
+
+#elif defined(__ARM_NEON)
+
+// One butterfly pass over eight coefficient vectors; lanes are independent
+// columns. The final pass applies the scalar row-transform's (x + 128) >> 8
+// rounding to the outputs; vrshrq adds the 128 for us.
+static inline void plm_video_idct_pass_neon(int32x4_t v[8], int final) {
+	int32x4_t b1 = v[4];
+	int32x4_t b3 = vaddq_s32(v[2], v[6]);
+	int32x4_t b4 = vsubq_s32(v[5], v[3]);
+	int32x4_t tmp1 = vaddq_s32(v[1], v[7]);
+	int32x4_t tmp2 = vaddq_s32(v[3], v[5]);
+	int32x4_t b6 = vsubq_s32(v[1], v[7]);
+	int32x4_t b7 = vaddq_s32(tmp1, tmp2);
+	int32x4_t m0 = v[0];
+	int32x4_t x4 = vsubq_s32(
+		vrshrq_n_s32(vsubq_s32(vmulq_n_s32(b6, 473), vmulq_n_s32(b4, 196)), 8),
+		b7);
+	int32x4_t x0 = vsubq_s32(
+		x4, vrshrq_n_s32(vmulq_n_s32(vsubq_s32(tmp1, tmp2), 362), 8));
+	int32x4_t x1 = vsubq_s32(m0, b1);
+	int32x4_t x2 = vsubq_s32(
+		vrshrq_n_s32(vmulq_n_s32(vsubq_s32(v[2], v[6]), 362), 8), b3);
+	int32x4_t x3 = vaddq_s32(m0, b1);
+	int32x4_t y3 = vaddq_s32(x1, x2);
+	int32x4_t y4 = vaddq_s32(x3, b3);
+	int32x4_t y5 = vsubq_s32(x1, x2);
+	int32x4_t y6 = vsubq_s32(x3, b3);
+	int32x4_t y7 = vsubq_s32(
+		vnegq_s32(x0),
+		vrshrq_n_s32(vaddq_s32(vmulq_n_s32(b4, 473), vmulq_n_s32(b6, 196)), 8));
+
+	v[0] = vaddq_s32(b7, y4);
+	v[1] = vaddq_s32(x4, y3);
+	v[2] = vsubq_s32(y5, x0);
+	v[3] = vsubq_s32(y6, y7);
+	v[4] = vaddq_s32(y6, y7);
+	v[5] = vaddq_s32(x0, y5);
+	v[6] = vsubq_s32(y3, x4);
+	v[7] = vsubq_s32(y4, b7);
+
+	if (final) {
+		for (int i = 0; i < 8; i++) {
+			v[i] = vrshrq_n_s32(v[i], 8);
+		}
+	}
+}
+
+static inline void plm_video_idct_transpose_4x4(int32x4_t *r0, int32x4_t *r1, int32x4_t *r2, int32x4_t *r3) {
+	int32x4x2_t t01 = vtrnq_s32(*r0, *r1);
+	int32x4x2_t t23 = vtrnq_s32(*r2, *r3);
+	*r0 = vcombine_s32(vget_low_s32(t01.val[0]), vget_low_s32(t23.val[0]));
+	*r1 = vcombine_s32(vget_low_s32(t01.val[1]), vget_low_s32(t23.val[1]));
+	*r2 = vcombine_s32(vget_high_s32(t01.val[0]), vget_high_s32(t23.val[0]));
+	*r3 = vcombine_s32(vget_high_s32(t01.val[1]), vget_high_s32(t23.val[1]));
+}
+
+// Transpose the 8x8 matrix held as row quadrants lo (columns 0-3) and
+// hi (columns 4-7)
+static inline void plm_video_idct_transpose_neon(int32x4_t lo[8], int32x4_t hi[8]) {
+	plm_video_idct_transpose_4x4(&lo[0], &lo[1], &lo[2], &lo[3]);
+	plm_video_idct_transpose_4x4(&lo[4], &lo[5], &lo[6], &lo[7]);
+	plm_video_idct_transpose_4x4(&hi[0], &hi[1], &hi[2], &hi[3]);
+	plm_video_idct_transpose_4x4(&hi[4], &hi[5], &hi[6], &hi[7]);
+	for (int i = 0; i < 4; i++) {
+		int32x4_t t = hi[i];
+		hi[i] = lo[i + 4];
+		lo[i + 4] = t;
+	}
+}
+
+void plm_video_idct(int *block) {
+	int32x4_t lo[8], hi[8];
+	for (int i = 0; i < 8; i++) {
+		lo[i] = vld1q_s32(block + i * 8);
+		hi[i] = vld1q_s32(block + i * 8 + 4);
+	}
+
+	// Transform columns, then rows via a transposed column pass
+	plm_video_idct_pass_neon(lo, FALSE);
+	plm_video_idct_pass_neon(hi, FALSE);
+	plm_video_idct_transpose_neon(lo, hi);
+	plm_video_idct_pass_neon(lo, TRUE);
+	plm_video_idct_pass_neon(hi, TRUE);
+	plm_video_idct_transpose_neon(lo, hi);
+
+	for (int i = 0; i < 8; i++) {
+		vst1q_s32(block + i * 8, lo[i]);
+		vst1q_s32(block + i * 8 + 4, hi[i]);
+	}
+}
+
+#else
+
 void plm_video_idct(int *block) {
 	int
 		b1, b3, b4, b6, b7, tmp1, tmp2, m0,
@@ -3629,6 +3939,8 @@ void plm_video_idct(int *block) {
 	}
 }
 
+#endif
+
 // YCbCr conversion following the BT.601 standard:
 // https://infogalactic.com/info/YCbCr#ITU-R_BT.601_conversion
 
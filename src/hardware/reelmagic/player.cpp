@@ -468,7 +468,7 @@ public:
 	//
 	// ReelMagic_VideoMixerMPEGProvider implementation here...
 	//
-	void OnVerticalRefresh(void* const outputBuffer, const float fps) override
+	bool OnVerticalRefresh(void* const outputBuffer, const float fps) override
 	{
 		if (fps != _vgaFps) {
 			_vgaFps                = fps;
@@ -478,11 +478,13 @@ public:
 			_drawNextFrame                   = true;
 		}
 
+		bool pictureUpdated = false;
 		if (_drawNextFrame) {
 			if (_nextFrame) {
 				plm_frame_to_rgb(_nextFrame,
 				                 (uint8_t*)outputBuffer,
 				                 _attrs.PictureSize.Width * 3);
+				pictureUpdated = true;
 			}
 			_drawNextFrame = false;
 		}
@@ -490,7 +492,7 @@ public:
 		if (!_playing) {
 			if (_stopOnComplete)
 				ReelMagic_ClearVideoMixerMPEGProvider();
-			return;
+			return pictureUpdated;
 		}
 
 		for (_waitVgaFramesUntilNextMpegFrame -= 1.f; _waitVgaFramesUntilNextMpegFrame < 0.f;
@@ -498,6 +500,7 @@ public:
 			advanceNextFrame();
 			_drawNextFrame = true;
 		}
+		return pictureUpdated;
 	}
 
 	const ReelMagic_PlayerConfiguration& GetConfig() const override
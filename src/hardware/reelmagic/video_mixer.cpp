@@ -25,12 +25,14 @@
 
 #include "reelmagic.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <exception>
 #include <string>
+#include <vector>
 
 #include "../../gui/render_scalers.h" //SCALER_MAXWIDTH SCALER_MAXHEIGHT
 #include "rgb565.h"
@@ -215,6 +217,25 @@ static Bitu _currentRenderLineNumber = 0;
 static uint32_t _renderWidth         = 0;
 static uint32_t _renderHeight        = 0;
 
+// Per-row composition caching state: a shadow copy of the incoming VGA rows
+// detects rows that did not change since the previous frame, and the player
+// reports whether it rewrote the MPEG picture. When neither input to a row
+// changed, the previously composed output row is re-sent as-is and the whole
+// mix loop for that row is skipped.
+static std::vector<uint8_t> _vgaRowShadow           = {};
+static std::vector<RenderOutputPixel> _composedRows = {};
+static std::vector<uint8_t> _composedRowValid       = {};
+static Bitu _composeLineNumber  = 0;
+static bool _mpegPictureChanged = true;
+static bool _composedRowsStale  = true;
+
+// Defer the per-row flag wipe to the next ReelMagic_RENDER_StartUpdate() so
+// back-to-back invalidations (palette loads program 256 entries) stay cheap
+static void InvalidateComposedRows()
+{
+	_composedRowsStale = true;
+}
+
 //
 // pixel mixing / underlay / overlay functions...
 //
@@ -229,11 +250,19 @@ static uint32_t _renderHeight        = 0;
 template <typename VGAPixelT, typename MPEGPixelT>
 static inline void MixPixel(RenderOutputPixel& out, const VGAPixelT& vga, const MPEGPixelT& mpeg)
 {
-	if (vga.IsTransparent())
-		mpeg.CopyRGBTo(out);
-	else
-		vga.CopyRGBTo(out);
-	out.alpha = 0;
+	// branchless select: both candidates are cheap to produce and the
+	// ternaries compile down to conditional moves (or vector blends once
+	// the row loops below are auto-vectorized), which beats a
+	// hard-to-predict colorkey branch per pixel
+	RenderOutputPixel vgaOut  = {};
+	RenderOutputPixel mpegOut = {};
+	vga.CopyRGBTo(vgaOut);
+	mpeg.CopyRGBTo(mpegOut);
+	const bool transparent = vga.IsTransparent();
+	out.blue               = transparent ? mpegOut.blue : vgaOut.blue;
+	out.green              = transparent ? mpegOut.green : vgaOut.green;
+	out.red                = transparent ? mpegOut.red : vgaOut.red;
+	out.alpha              = 0;
 }
 
 template <typename VGAPixelT>
@@ -247,6 +276,7 @@ static void ClearMpegPictureBuffer(const PlayerPicturePixel p)
 {
 	for (Bitu i = 0; i < (sizeof(_mpegPictureBuffer) / sizeof(_mpegPictureBuffer[0])); ++i)
 		_mpegPictureBuffer[i] = p;
+	InvalidateComposedRows();
 }
 
 static void ClearMpegPictureBuffer()
@@ -296,6 +326,35 @@ static void RMR_DrawLine_MixerError([[maybe_unused]] const void* src)
 	RENDER_DrawLine(_finalMixedRenderLineBuffer);
 }
 
+// Composed output row for the given line; falls back to the single-line
+// buffer if VGA hands us more lines than the mode declared
+static inline RenderOutputPixel* ComposedRowBuffer(const Bitu line)
+{
+	if (line >= _renderHeight)
+		return _finalMixedRenderLineBuffer;
+	return &_composedRows[line * _renderWidth];
+}
+
+// Compares the incoming VGA row against its shadow copy (updating the shadow
+// when it differs) and reports whether the cached composed row from the
+// previous frame can be re-sent untouched
+template <typename T>
+static inline bool RowCanBeReused(const T* src, const Bitu line, const bool usesMpegPicture)
+{
+	if (line >= _renderHeight)
+		return false;
+	const size_t rowBytes = _vgaImageInfo.width * sizeof(T);
+	uint8_t* shadow       = &_vgaRowShadow[line * rowBytes];
+	const bool vgaSame    = (memcmp(shadow, src, rowBytes) == 0);
+	if (!vgaSame)
+		memcpy(shadow, src, rowBytes);
+	if (vgaSame && _composedRowValid[line] &&
+	    !(usesMpegPicture && _mpegPictureChanged))
+		return true;
+	_composedRowValid[line] = 1;
+	return false;
+}
+
 // its not real enterprise C++ until yer mixing macros and templates...
 #define CREATE_RMR_VGA_TYPED_FUNCTIONS(DRAWLINE_FUNC_NAME) \
 	static void DRAWLINE_FUNC_NAME##_VGAO8(const void* src) \
@@ -361,14 +420,17 @@ template <typename T>
 static inline void RMR_DrawLine_VGAOnly(const T* src)
 {
 	const Bitu lineWidth = _vgaImageInfo.width;
+	const Bitu line      = _composeLineNumber++;
 
-	RenderOutputPixel* const out = _finalMixedRenderLineBuffer;
+	RenderOutputPixel* const out = ComposedRowBuffer(line);
 
-	for (Bitu i = 0; i < lineWidth; ++i) {
-		MixPixel(out[i], src[i]);
+	if (!RowCanBeReused(src, line, false)) {
+		for (Bitu i = 0; i < lineWidth; ++i) {
+			MixPixel(out[i], src[i]);
+		}
 	}
 
-	RENDER_DrawLine(_finalMixedRenderLineBuffer);
+	RENDER_DrawLine(out);
 }
 CREATE_RMR_VGA_TYPED_FUNCTIONS(RMR_DrawLine_VGAOnly)
 
@@ -376,16 +438,19 @@ template <typename T>
 static inline void RMR_DrawLine_VGAMPEGSameSize(const T* src)
 {
 	const Bitu lineWidth = _vgaImageInfo.width;
+	const Bitu line      = _composeLineNumber++;
 
-	RenderOutputPixel* const out = _finalMixedRenderLineBuffer;
+	RenderOutputPixel* const out = ComposedRowBuffer(line);
 
-	for (Bitu i = 0; i < lineWidth; ++i) {
-		MixPixel(out[i], src[i], _mpegPictureBufferPtr[i]);
+	if (!RowCanBeReused(src, line, true)) {
+		for (Bitu i = 0; i < lineWidth; ++i) {
+			MixPixel(out[i], src[i], _mpegPictureBufferPtr[i]);
+		}
 	}
 
 	_mpegPictureBufferPtr += _mpegPictureWidth;
 
-	RENDER_DrawLine(_finalMixedRenderLineBuffer);
+	RENDER_DrawLine(out);
 }
 CREATE_RMR_VGA_TYPED_FUNCTIONS(RMR_DrawLine_VGAMPEGSameSize)
 
@@ -394,13 +459,16 @@ template <typename T>
 static inline void RMR_DrawLine_VSO_MPEGDoubleVGASize(const T* src)
 {
 	const Bitu lineWidth         = _vgaImageInfo.width;
-	RenderOutputPixel* const out = _finalMixedRenderLineBuffer;
+	const Bitu line              = _composeLineNumber++;
+	RenderOutputPixel* const out = ComposedRowBuffer(line);
 	_mpegPictureBufferPtr -= _mpegPictureWidth * (_currentRenderLineNumber++ & 1);
-	for (Bitu i = 0; i < lineWidth; ++i) {
-		MixPixel(out[i], src[i], _mpegPictureBufferPtr[i >> 1]);
+	if (!RowCanBeReused(src, line, true)) {
+		for (Bitu i = 0; i < lineWidth; ++i) {
+			MixPixel(out[i], src[i], _mpegPictureBufferPtr[i >> 1]);
+		}
 	}
 	_mpegPictureBufferPtr += _mpegPictureWidth;
-	RENDER_DrawLine(_finalMixedRenderLineBuffer);
+	RENDER_DrawLine(out);
 }
 CREATE_RMR_VGA_TYPED_FUNCTIONS(RMR_DrawLine_VSO_MPEGDoubleVGASize)
 
@@ -408,15 +476,18 @@ template <typename T>
 static inline void RMR_DrawLine_VSO_VGAMPEGSameWidthSkip6Vertical(const T* src)
 {
 	const Bitu lineWidth         = _vgaImageInfo.width;
-	RenderOutputPixel* const out = _finalMixedRenderLineBuffer;
-	for (Bitu i = 0; i < lineWidth; ++i)
-		MixPixel(out[i], src[i], _mpegPictureBufferPtr[i]);
+	const Bitu line              = _composeLineNumber++;
+	RenderOutputPixel* const out = ComposedRowBuffer(line);
+	if (!RowCanBeReused(src, line, true)) {
+		for (Bitu i = 0; i < lineWidth; ++i)
+			MixPixel(out[i], src[i], _mpegPictureBufferPtr[i]);
+	}
 	_mpegPictureBufferPtr += _mpegPictureWidth;
 	if (++_currentRenderLineNumber >= 6) {
 		_currentRenderLineNumber = 0;
 		_mpegPictureBufferPtr += _mpegPictureWidth;
 	}
-	RENDER_DrawLine(_finalMixedRenderLineBuffer);
+	RENDER_DrawLine(out);
 }
 CREATE_RMR_VGA_TYPED_FUNCTIONS(RMR_DrawLine_VSO_VGAMPEGSameWidthSkip6Vertical)
 
@@ -424,16 +495,19 @@ template <typename T>
 static inline void RMR_DrawLine_VSO_VGAMPEGDoubleSameWidthSkip6Vertical(const T* src)
 {
 	const Bitu lineWidth         = _vgaImageInfo.width;
-	RenderOutputPixel* const out = _finalMixedRenderLineBuffer;
+	const Bitu line              = _composeLineNumber++;
+	RenderOutputPixel* const out = ComposedRowBuffer(line);
 	_mpegPictureBufferPtr -= _mpegPictureWidth * (_currentRenderLineNumber & 1);
-	for (Bitu i = 0; i < lineWidth; ++i)
-		MixPixel(out[i], src[i], _mpegPictureBufferPtr[i >> 1]);
+	if (!RowCanBeReused(src, line, true)) {
+		for (Bitu i = 0; i < lineWidth; ++i)
+			MixPixel(out[i], src[i], _mpegPictureBufferPtr[i >> 1]);
+	}
 	_mpegPictureBufferPtr += _mpegPictureWidth;
 	if (++_currentRenderLineNumber >= 6) {
 		_currentRenderLineNumber = 0;
 		_mpegPictureBufferPtr += _mpegPictureWidth;
 	}
-	RENDER_DrawLine(_finalMixedRenderLineBuffer);
+	RENDER_DrawLine(out);
 }
 CREATE_RMR_VGA_TYPED_FUNCTIONS(RMR_DrawLine_VSO_VGAMPEGDoubleSameWidthSkip6Vertical)
 
@@ -457,16 +531,19 @@ template <typename T>
 static inline void RMR_DrawLine_VSO_GeneralResizeMPEGToVGA(const T* src)
 {
 	const Bitu lineWidth         = _vgaImageInfo.width;
-	RenderOutputPixel* const out = _finalMixedRenderLineBuffer;
-	for (Bitu i = 0; i < lineWidth; ++i)
-		MixPixel(out[i],
-		         src[i],
-		         _mpegPictureBufferPtr[(i * _RMR_DrawLine_VSO_GeneralResizeMPEGToVGA_WidthRatio) >> 12]);
+	const Bitu line              = _composeLineNumber++;
+	RenderOutputPixel* const out = ComposedRowBuffer(line);
+	if (!RowCanBeReused(src, line, true)) {
+		for (Bitu i = 0; i < lineWidth; ++i)
+			MixPixel(out[i],
+			         src[i],
+			         _mpegPictureBufferPtr[(i * _RMR_DrawLine_VSO_GeneralResizeMPEGToVGA_WidthRatio) >> 12]);
+	}
 	_mpegPictureBufferPtr =
 	        &_mpegPictureBuffer[_mpegPictureWidth * ((++_currentRenderLineNumber *
 	                                                  _RMR_DrawLine_VSO_GeneralResizeMPEGToVGA_HeightRatio) >>
 	                                                 12)];
-	RENDER_DrawLine(_finalMixedRenderLineBuffer);
+	RENDER_DrawLine(out);
 }
 CREATE_RMR_VGA_TYPED_FUNCTIONS(RMR_DrawLine_VSO_GeneralResizeMPEGToVGA)
 
@@ -502,6 +579,14 @@ static void setup_video_mixer(const bool update_render_mode)
 	_renderWidth  = _vgaImageInfo.width;
 	_renderHeight = _vgaImageInfo.height;
 
+	// (re)size the per-row caches for this mode; the shadow is sized for
+	// the widest VGA pixel type (4 bytes) so it covers every line renderer
+	const auto totalPixels = static_cast<size_t>(_renderWidth) * _renderHeight;
+	_vgaRowShadow.assign(totalPixels * 4, 0);
+	_composedRows.resize(totalPixels);
+	_composedRowValid.assign(_renderHeight, 0);
+	InvalidateComposedRows();
+
 	// check to make sure we have enough horizontal line buffer for the
 	// current VGA mode...
 	[[maybe_unused]] const Bitu maxRenderWidth =
@@ -612,6 +697,9 @@ void ReelMagic_RENDER_SetPalette(const uint8_t entry, const uint8_t red,
 
 	VGAPalettePixel::_vgaPalette16bpp[entry].FromRgb888(red, green, blue);
 
+	// palette edits recolor rows whose source bytes did not change
+	InvalidateComposedRows();
+
 	RENDER_SetPalette(entry, red, green, blue);
 }
 
@@ -627,12 +715,22 @@ void ReelMagic_RENDER_SetSize(const ImageInfo& image_info,
 
 bool ReelMagic_RENDER_StartUpdate(void)
 {
+	_mpegPictureChanged = false;
 	if (_activeMpegProvider) {
-		VGAOverPalettePixel::_alphaChannelIndex = _activeMpegProvider->GetConfig().VgaAlphaIndex;
-		_activeMpegProvider->OnVerticalRefresh(_mpegPictureBuffer,
-		                                       static_cast<float>(_vgaFramesPerSecond));
+		const auto alphaIndex = _activeMpegProvider->GetConfig().VgaAlphaIndex;
+		if (alphaIndex != VGAOverPalettePixel::_alphaChannelIndex) {
+			VGAOverPalettePixel::_alphaChannelIndex = alphaIndex;
+			InvalidateComposedRows();
+		}
+		_mpegPictureChanged = _activeMpegProvider->OnVerticalRefresh(
+		        _mpegPictureBuffer, static_cast<float>(_vgaFramesPerSecond));
+	}
+	if (_composedRowsStale) {
+		std::fill(_composedRowValid.begin(), _composedRowValid.end(), 0);
+		_composedRowsStale = false;
 	}
 	_currentRenderLineNumber = 0;
+	_composeLineNumber       = 0;
 	_mpegPictureBufferPtr    = _mpegPictureBuffer;
 	return RENDER_StartUpdate();
 }
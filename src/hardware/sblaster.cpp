@@ -655,100 +655,159 @@ static void DSP_DMA_CallBack(const DmaChannel* chan, DMAEvent event)
 	}
 }
 
-static uint8_t decode_adpcm_portion(const int bit_portion,
-                                    const uint8_t adjust_map[],
-                                    const int8_t scale_map[], const int last_index)
-{
-	auto& scale  = sb.adpcm.stepsize;
-	auto& sample = sb.adpcm.reference;
-
-	const auto i = std::clamp(bit_portion + scale, 0, last_index);
-	scale = (scale + adjust_map[i]) & 0xff;
-	sample = static_cast<uint8_t>(clamp(sample + scale_map[i], 0, 255));
-	return sample;
-}
+// The behaviour of an ADPCM code depends only on the current step size
+// (the "scale"), so the per-step clamp and adjustment work is precomputed
+// into (scale, code) -> (sample delta, next scale) tables and whole DMA
+// chunks decode in tight table-driven loops without branching on the
+// decoder state.
+struct AdpcmStep {
+	int8_t delta       = 0;
+	uint8_t next_scale = 0;
+};
 
-static std::array<uint8_t, 4> decode_ADPCM_2(const uint8_t data)
+template <int NumCodes, size_t MapLen>
+static constexpr std::array<AdpcmStep, 256 * NumCodes> make_adpcm_step_table(
+        const int8_t (&scale_map)[MapLen], const uint8_t (&adjust_map)[MapLen])
 {
-	// clang-format off
+	std::array<AdpcmStep, 256 * NumCodes> table = {};
+	for (int scale = 0; scale < 256; ++scale) {
+		for (int code = 0; code < NumCodes; ++code) {
+			constexpr auto last_index = static_cast<int>(MapLen) - 1;
+			const auto i = std::clamp(code + scale, 0, last_index);
+
+			auto& step      = table[scale * NumCodes + code];
+			step.delta      = scale_map[i];
+			step.next_scale = static_cast<uint8_t>(
+			        (scale + adjust_map[i]) & 0xff);
+		}
+	}
+	return table;
+}
 
-	constexpr int8_t scale_map[] = {
-		0,  1,  0,  -1, 1,  3,  -1,  -3,
-		2,  6, -2,  -6, 4, 12,  -4, -12,
-		8, 24, -8, -24, 6, 48, -16, -48
-	};
-	constexpr uint8_t adjust_map[] = {
-		  0, 4,   0, 4,
-		252, 4, 252, 4, 252, 4, 252, 4,
-		252, 4, 252, 4, 252, 4, 252, 4,
-		252, 0, 252, 0
-	};
-	static_assert(ARRAY_LEN(scale_map) == ARRAY_LEN(adjust_map));
-	constexpr auto last_i = static_cast<uint8_t>(sizeof(scale_map) - 1);;
+// clang-format off
 
-	return {decode_adpcm_portion((data >> 6) & 0x3, adjust_map, scale_map, last_i),
-	        decode_adpcm_portion((data >> 4) & 0x3, adjust_map, scale_map, last_i),
-	        decode_adpcm_portion((data >> 2) & 0x3, adjust_map, scale_map, last_i),
-	        decode_adpcm_portion((data >> 0) & 0x3, adjust_map, scale_map, last_i)};
+constexpr int8_t adpcm2_scale_map[] = {
+	0,  1,  0,  -1, 1,  3,  -1,  -3,
+	2,  6, -2,  -6, 4, 12,  -4, -12,
+	8, 24, -8, -24, 6, 48, -16, -48
+};
+constexpr uint8_t adpcm2_adjust_map[] = {
+	  0, 4,   0, 4,
+	252, 4, 252, 4, 252, 4, 252, 4,
+	252, 4, 252, 4, 252, 4, 252, 4,
+	252, 0, 252, 0
+};
+static_assert(ARRAY_LEN(adpcm2_scale_map) == ARRAY_LEN(adpcm2_adjust_map));
+
+constexpr int8_t adpcm3_scale_map[40] = {
+	0,  1,  2,  3,  0,  -1,  -2,  -3,
+	1,  3,  5,  7, -1,  -3,  -5,  -7,
+	2,  6, 10, 14, -2,  -6, -10, -14,
+	4, 12, 20, 28, -4, -12, -20, -28,
+	5, 15, 25, 35, -5, -15, -25, -35
+};
+constexpr uint8_t adpcm3_adjust_map[40] = {
+	  0, 0, 0, 8,   0, 0, 0, 8,
+	248, 0, 0, 8, 248, 0, 0, 8,
+	248, 0, 0, 8, 248, 0, 0, 8,
+	248, 0, 0, 8, 248, 0, 0, 8,
+	248, 0, 0, 0, 248, 0, 0, 0
+};
+static_assert(ARRAY_LEN(adpcm3_scale_map) == ARRAY_LEN(adpcm3_adjust_map));
 
-	// clang-format on
+constexpr int8_t adpcm4_scale_map[64] = {
+	0,  1,  2,  3,  4,  5,  6,  7,  0,  -1,  -2,  -3,  -4,  -5,  -6,  -7,
+	1,  3,  5,  7,  9, 11, 13, 15, -1,  -3,  -5,  -7,  -9, -11, -13, -15,
+	2,  6, 10, 14, 18, 22, 26, 30, -2,  -6, -10, -14, -18, -22, -26, -30,
+	4, 12, 20, 28, 36, 44, 52, 60, -4, -12, -20, -28, -36, -44, -52, -60
+};
+constexpr uint8_t adpcm4_adjust_map[64] = {
+	  0, 0, 0, 0, 0, 16, 16, 16,
+	  0, 0, 0, 0, 0, 16, 16, 16,
+	240, 0, 0, 0, 0, 16, 16, 16,
+	240, 0, 0, 0, 0, 16, 16, 16,
+	240, 0, 0, 0, 0, 16, 16, 16,
+	240, 0, 0, 0, 0, 16, 16, 16,
+	240, 0, 0, 0, 0,  0,  0,  0,
+	240, 0, 0, 0, 0,  0,  0,  0
+};
+static_assert(ARRAY_LEN(adpcm4_scale_map) == ARRAY_LEN(adpcm4_adjust_map));
+
+// clang-format on
+
+static constexpr auto adpcm2_steps = make_adpcm_step_table<4>(adpcm2_scale_map,
+                                                              adpcm2_adjust_map);
+static constexpr auto adpcm3_steps = make_adpcm_step_table<8>(adpcm3_scale_map,
+                                                              adpcm3_adjust_map);
+static constexpr auto adpcm4_steps = make_adpcm_step_table<16>(adpcm4_scale_map,
+                                                               adpcm4_adjust_map);
+
+// The block decoders return the number of samples written to 'out',
+// which needs room for the chunk's full expansion (up to four samples
+// per input byte)
+static uint32_t decode_ADPCM_2_block(const uint8_t* in, const uint32_t num_bytes,
+                                     uint8_t* out)
+{
+	auto scale  = static_cast<uint8_t>(sb.adpcm.stepsize);
+	auto sample = static_cast<int>(sb.adpcm.reference);
+
+	for (uint32_t i = 0; i < num_bytes; ++i) {
+		const auto data = in[i];
+		for (auto shift = 6; shift >= 0; shift -= 2) {
+			const auto& step = adpcm2_steps[scale * 4 +
+			                                ((data >> shift) & 0x3)];
+			sample = clamp(sample + step.delta, 0, 255);
+			scale  = step.next_scale;
+			*out++ = static_cast<uint8_t>(sample);
+		}
+	}
+	sb.adpcm.stepsize  = scale;
+	sb.adpcm.reference = static_cast<uint8_t>(sample);
+	return num_bytes * 4;
 }
 
-static std::array<uint8_t, 3> decode_ADPCM_3(const uint8_t data)
+static uint32_t decode_ADPCM_3_block(const uint8_t* in, const uint32_t num_bytes,
+                                     uint8_t* out)
 {
-	// clang-format off
-
-	constexpr int8_t scale_map[40] = {
-		0,  1,  2,  3,  0,  -1,  -2,  -3,
-		1,  3,  5,  7, -1,  -3,  -5,  -7,
-		2,  6, 10, 14, -2,  -6, -10, -14,
-		4, 12, 20, 28, -4, -12, -20, -28,
-		5, 15, 25, 35, -5, -15, -25, -35
-	};
-	constexpr uint8_t adjust_map[40] = {
-		  0, 0, 0, 8,   0, 0, 0, 8,
-		248, 0, 0, 8, 248, 0, 0, 8,
-		248, 0, 0, 8, 248, 0, 0, 8,
-		248, 0, 0, 8, 248, 0, 0, 8,
-		248, 0, 0, 0, 248, 0, 0, 0
-	};
-	static_assert(ARRAY_LEN(scale_map) == ARRAY_LEN(adjust_map));
-	constexpr auto last_i = static_cast<uint8_t>(sizeof(scale_map) - 1);;
-
-	return {decode_adpcm_portion((data >> 5) & 0x7, adjust_map, scale_map, last_i),
-	        decode_adpcm_portion((data >> 2) & 0x7, adjust_map, scale_map, last_i),
-	        decode_adpcm_portion((data & 0x3) << 1, adjust_map, scale_map, last_i)};
-
-	// clang-format on
+	auto scale  = static_cast<uint8_t>(sb.adpcm.stepsize);
+	auto sample = static_cast<int>(sb.adpcm.reference);
+
+	for (uint32_t i = 0; i < num_bytes; ++i) {
+		const auto data = in[i];
+		const uint8_t codes[3] = {static_cast<uint8_t>((data >> 5) & 0x7),
+		                          static_cast<uint8_t>((data >> 2) & 0x7),
+		                          static_cast<uint8_t>((data & 0x3) << 1)};
+		for (const auto code : codes) {
+			const auto& step = adpcm3_steps[scale * 8 + code];
+			sample = clamp(sample + step.delta, 0, 255);
+			scale  = step.next_scale;
+			*out++ = static_cast<uint8_t>(sample);
+		}
+	}
+	sb.adpcm.stepsize  = scale;
+	sb.adpcm.reference = static_cast<uint8_t>(sample);
+	return num_bytes * 3;
 }
 
-static std::array<uint8_t, 2> decode_ADPCM_4(const uint8_t data)
+static uint32_t decode_ADPCM_4_block(const uint8_t* in, const uint32_t num_bytes,
+                                     uint8_t* out)
 {
-	// clang-format off
-
-	constexpr int8_t scale_map[64] = {
-		0,  1,  2,  3,  4,  5,  6,  7,  0,  -1,  -2,  -3,  -4,  -5,  -6,  -7,
-		1,  3,  5,  7,  9, 11, 13, 15, -1,  -3,  -5,  -7,  -9, -11, -13, -15,
-		2,  6, 10, 14, 18, 22, 26, 30, -2,  -6, -10, -14, -18, -22, -26, -30,
-		4, 12, 20, 28, 36, 44, 52, 60, -4, -12, -20, -28, -36, -44, -52, -60
-	};
-	constexpr uint8_t adjust_map[64] = {
-		  0, 0, 0, 0, 0, 16, 16, 16,
-		  0, 0, 0, 0, 0, 16, 16, 16,
-		240, 0, 0, 0, 0, 16, 16, 16,
-		240, 0, 0, 0, 0, 16, 16, 16,
-		240, 0, 0, 0, 0, 16, 16, 16,
-		240, 0, 0, 0, 0, 16, 16, 16,
-		240, 0, 0, 0, 0,  0,  0,  0,
-		240, 0, 0, 0, 0,  0,  0,  0
-	};
-	static_assert(ARRAY_LEN(scale_map) == ARRAY_LEN(adjust_map));
-	constexpr auto last_i = static_cast<uint8_t>(sizeof(scale_map) - 1);;
-
-	return {decode_adpcm_portion(data >> 4,  adjust_map, scale_map, last_i),
-	        decode_adpcm_portion(data & 0xf, adjust_map, scale_map, last_i)};
-
-	// clang-format on
+	auto scale  = static_cast<uint8_t>(sb.adpcm.stepsize);
+	auto sample = static_cast<int>(sb.adpcm.reference);
+
+	for (uint32_t i = 0; i < num_bytes; ++i) {
+		const auto data = in[i];
+		for (auto shift = 4; shift >= 0; shift -= 4) {
+			const auto& step = adpcm4_steps[scale * 16 +
+			                                ((data >> shift) & 0xf)];
+			sample = clamp(sample + step.delta, 0, 255);
+			scale  = step.next_scale;
+			*out++ = static_cast<uint8_t>(sample);
+		}
+	}
+	sb.adpcm.stepsize  = scale;
+	sb.adpcm.reference = static_cast<uint8_t>(sample);
+	return num_bytes * 2;
 }
 
 template <typename T>
@@ -805,11 +864,9 @@ static void PlayDMATransfer(uint32_t bytes_requested)
 	// Temporary counter for ADPCM modes
 
 	auto decode_adpcm_dma =
-	        [&](auto decode_adpcm_fn) -> std::tuple<uint32_t, uint32_t, uint16_t> {
+	        [&](auto decode_adpcm_block_fn) -> std::tuple<uint32_t, uint32_t, uint16_t> {
 
 		const uint32_t num_bytes = ReadDMA8(bytes_to_read);
-		uint32_t num_samples = 0;
-		uint16_t num_frames  = 0;
 
 		// Parse the reference ADPCM byte, if provided
 		uint32_t i = 0;
@@ -819,29 +876,30 @@ static void PlayDMATransfer(uint32_t bytes_requested)
 			sb.adpcm.stepsize=MIN_ADAPTIVE_STEP_SIZE;
 			++i;
 		}
-		// Decode the remaining DMA buffer into samples using the provided function
-		while (i < num_bytes) {
-			const auto decoded = decode_adpcm_fn(sb.dma.buf.b8[i]);
-			constexpr auto num_decoded = check_cast<uint8_t>(decoded.size());
-			sb.chan->AddSamples_m8(num_decoded, maybe_silence(num_decoded, decoded.data()));
-			num_samples += num_decoded;
-			++i;
+		// Decode the remaining DMA chunk in one table-driven pass and
+		// hand it to the mixer as a single block
+		static uint8_t decoded[DMA_BUFSIZE * 4];
+		const auto num_samples = decode_adpcm_block_fn(sb.dma.buf.b8 + i,
+		                                               num_bytes - i, decoded);
+		if (num_samples > 0) {
+			sb.chan->AddSamples_m8(check_cast<uint16_t>(num_samples),
+			                       maybe_silence(num_samples, decoded));
 		}
 		 // ADPCM is mono
-		num_frames = check_cast<uint16_t>(num_samples);
+		const auto num_frames = check_cast<uint16_t>(num_samples);
 		return {num_bytes, num_samples, num_frames};
 	};
 
 	//Read the actual data, process it and send it off to the mixer
 	switch (sb.dma.mode) {
 	case DSP_DMA_2:
-		std::tie(bytes_read, samples, frames) = decode_adpcm_dma(decode_ADPCM_2);
+		std::tie(bytes_read, samples, frames) = decode_adpcm_dma(decode_ADPCM_2_block);
 		break;
 	case DSP_DMA_3:
-		std::tie(bytes_read, samples, frames) = decode_adpcm_dma(decode_ADPCM_3);
+		std::tie(bytes_read, samples, frames) = decode_adpcm_dma(decode_ADPCM_3_block);
 		break;
 	case DSP_DMA_4:
-		std::tie(bytes_read, samples, frames) = decode_adpcm_dma(decode_ADPCM_4);
+		std::tie(bytes_read, samples, frames) = decode_adpcm_dma(decode_ADPCM_4_block);
 		break;
 	case DSP_DMA_8:
  		if (sb.dma.stereo) {
@@ -1003,7 +1061,18 @@ static void SuppressDMATransfer(uint32_t bytes_to_read)
 {
 	if (sb.dma.left < bytes_to_read)
 		bytes_to_read = sb.dma.left;
-	const auto read = ReadDMA8(bytes_to_read);
+	// The data is discarded, so consume the whole block up to the IRQ
+	// boundary in buffer-sized chunks instead of spreading the reads
+	// across many small events.
+	uint32_t read = 0;
+	while (read < bytes_to_read) {
+		const auto chunk = std::min(bytes_to_read - read,
+		                            static_cast<uint32_t>(DMA_BUFSIZE));
+		const auto consumed = ReadDMA8(chunk);
+		read += consumed;
+		if (consumed < chunk)
+			break;
+	}
 	sb.dma.left-=read;
 	if (!sb.dma.left) {
 		if (sb.dma.mode >= DSP_DMA_16) SB_RaiseIRQ(SB_IRQ_16);
@@ -1017,10 +1086,8 @@ static void SuppressDMATransfer(uint32_t bytes_to_read)
 		}
 	}
 	if (sb.dma.left) {
-		const uint32_t bigger = (sb.dma.left > sb.dma.min) ? sb.dma.min
-		                                                   : sb.dma.left;
-		double delay = (bigger * 1000.0) / sb.dma.rate;
-		PIC_AddEvent(SuppressDMATransfer, delay, bigger);
+		const double delay = (sb.dma.left * 1000.0) / sb.dma.rate;
+		PIC_AddEvent(SuppressDMATransfer, delay, sb.dma.left);
 	}
 }
 
@@ -1029,9 +1096,10 @@ static void FlushRemainingDMATransfer()
 	if (!sb.dma.left)
 		return;
 	if (!sb.speaker && sb.type!=SBT_16) {
-		const auto num_bytes = std::min(sb.dma.min, sb.dma.left);
-		const double delay = (num_bytes * 1000.0) / sb.dma.rate;
-		PIC_AddEvent(SuppressDMATransfer, delay, num_bytes);
+		// One event at the point where the IRQ is due, consuming the
+		// whole block, rather than an event chain in sb.dma.min steps
+		const double delay = (sb.dma.left * 1000.0) / sb.dma.rate;
+		PIC_AddEvent(SuppressDMATransfer, delay, sb.dma.left);
 		LOG(LOG_SB, LOG_NORMAL)("%s: Silent DMA Transfer scheduling IRQ in %.3f milliseconds", CardType(), delay);
 	} else if (sb.dma.left < sb.dma.min) {
 		const double delay = (sb.dma.left * 1000.0) / sb.dma.rate;
@@ -67,10 +67,22 @@ CDirectSerial::CDirectSerial(const uint8_t port_idx, CommandLine *cmd)
 	CSerial::Init_Registers();
 	InstallationSuccessful = true;
 	rx_state = D_RX_IDLE;
+
+	// The reader thread blocks in the OS on the host port and queues
+	// received bytes; the millisecond tick only drains the queue.
+	keep_reading = true;
+	host_reader  = std::thread(&CDirectSerial::hostReadLoop, this);
+	set_thread_name(host_reader, "dosbox:serial");
+
 	setEvent(SERIAL_POLLING_EVENT, 1); // millisecond receive tick
 }
 
 CDirectSerial::~CDirectSerial () {
+	if (host_reader.joinable()) {
+		keep_reading = false;
+		rx_queue.Stop();
+		host_reader.join();
+	}
 	if(comport) SERIAL_close(comport);
 	// We do not use own events so we don't have to clear them.
 }
@@ -235,11 +247,33 @@ void CDirectSerial::handleUpperEvent(uint16_t type)
 	        }
 }
 
+// How long each wait round sleeps; bounds both shutdown latency and the
+// reader's idle wakeup rate
+constexpr int WaitReadableTimeoutMs = 100;
+
+void CDirectSerial::hostReadLoop() {
+	while (keep_reading) {
+		if (!SERIAL_waitReadable(comport, WaitReadableTimeoutMs))
+			continue; // timeout: just recheck if we should quit
+
+		int value;
+		while (keep_reading && (value = SERIAL_getextchar(comport)) != 0) {
+			// blocks when full; the UART-rate consumer catching
+			// up is the backpressure, Stop() aborts it
+			if (!rx_queue.Enqueue((uint16_t)(value & 0xffff)))
+				return;
+		}
+	}
+}
+
 bool CDirectSerial::doReceive() {
-	int value = SERIAL_getextchar(comport);
-	if(value) {
-		receiveByteEx((uint8_t)(value & 0xff),
-		              (uint8_t)((value & 0xff00) >> 8));
+	// only the cheap atomic check on the (common) empty path
+	if (rx_queue.IsEmpty())
+		return false;
+
+	if (const auto value = rx_queue.Dequeue()) {
+		receiveByteEx((uint8_t)(*value & 0xff),
+		              (uint8_t)((*value & 0xff00) >> 8));
 		return true;
 	}
 	return false;
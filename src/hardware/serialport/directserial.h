@@ -26,7 +26,11 @@
 #define DIRECTSERIAL_AVAILIBLE
 #include "serialport.h"
 
+#include <atomic>
+#include <thread>
+
 #include "libserial.h"
+#include "rwqueue.h"
 
 class CDirectSerial final : public CSerial {
 public:
@@ -61,6 +65,16 @@ private:
 	                           // causing an overrun error.
 	bool doReceive();
 
+	// The host reader thread sleeps in the OS until the port has data
+	// and queues the received characters (data byte plus error flags),
+	// so the tick handler only drains a queue and an idle port costs
+	// zero read syscalls.
+	void hostReadLoop();
+
+	RWQueue<uint16_t> rx_queue{1024};
+	std::thread host_reader       = {};
+	std::atomic<bool> keep_reading = false;
+
 #if SERIAL_DEBUG
 	bool dbgmsg_poll_block = false;
 	bool dbgmsg_rx_block = false;
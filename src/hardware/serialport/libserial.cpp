@@ -33,14 +33,20 @@ struct _COMPORT {
 	HANDLE porthandle;
 	bool breakstatus;
 	DCB orig_dcb;
+	// the port is opened overlapped so a reader thread can sleep in
+	// WaitCommEvent while the emulation thread keeps writing
+	HANDLE read_event;
+	HANDLE write_event;
 };
 
 bool SERIAL_open(const char* portname, COMPORT* port) {
 	// allocate COMPORT structure
 	COMPORT cp = (_COMPORT*)malloc(sizeof(_COMPORT));
 	if(cp == nullptr) return false;
-	
+
 	cp->breakstatus=false;
+	cp->read_event=nullptr;
+	cp->write_event=nullptr;
 
 	// open the port in NT object space (recommended by Microsoft)
 	// allows the user to open COM10+ and custom port names.
@@ -58,11 +64,15 @@ bool SERIAL_open(const char* portname, COMPORT* port) {
 									  // must be opened with exclusive-access
 	                   nullptr,          // no security attributes
 	                   OPEN_EXISTING, // must use OPEN_EXISTING
-	                   0,             // non overlapped I/O
+	                   FILE_FLAG_OVERLAPPED, // reader thread + writer thread
 	                   nullptr           // hTemplate must be NULL for comm devices
 	                  );
 
 	if (cp->porthandle == INVALID_HANDLE_VALUE) goto cleanup_error;
+
+	cp->read_event  = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+	cp->write_event = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+	if (!cp->read_event || !cp->write_event) goto cleanup_error;
 	
 	cp->orig_dcb.DCBlength=sizeof(DCB);
 
@@ -110,10 +120,16 @@ bool SERIAL_open(const char* portname, COMPORT* port) {
 	if(!ClearCommError(cp->porthandle, &errors, nullptr)) {
 		goto cleanup_error;
 	}
+	// wake SERIAL_waitReadable when receive data arrives
+	if(!SetCommMask(cp->porthandle, EV_RXCHAR)) {
+		goto cleanup_error;
+	}
 	*port = cp;
 	return true;
 
 cleanup_error:
+	if (cp->read_event) CloseHandle(cp->read_event);
+	if (cp->write_event) CloseHandle(cp->write_event);
 	if (cp->porthandle != INVALID_HANDLE_VALUE) CloseHandle(cp->porthandle);
 	free(cp);
 	return false;
@@ -125,6 +141,8 @@ void SERIAL_close(COMPORT port) {
 		SetCommState(port->porthandle, &port->orig_dcb);
 		CloseHandle(port->porthandle);
 	}
+	if (port->read_event) CloseHandle(port->read_event);
+	if (port->write_event) CloseHandle(port->write_event);
 	free(port);
 }
 
@@ -186,12 +204,19 @@ int SERIAL_getmodemstatus(COMPORT port) {
 }
 
 bool SERIAL_sendchar(COMPORT port, char data) {
-	DWORD bytesWritten;
+	DWORD bytesWritten = 0;
 
 	// mean bug: with break = 1, WriteFile will never return.
 	if(port->breakstatus) return true; // true or false?!
 
-	WriteFile (port->porthandle, &data, 1, &bytesWritten, nullptr);
+	OVERLAPPED ov = {};
+	ov.hEvent = port->write_event;
+
+	if (!WriteFile (port->porthandle, &data, 1, &bytesWritten, &ov)) {
+		if (GetLastError() != ERROR_IO_PENDING) return false;
+		if (!GetOverlappedResult(port->porthandle, &ov, &bytesWritten, TRUE))
+			return false;
+	}
 	if(bytesWritten==1) return true;
 	else return false;
 }
@@ -202,9 +227,17 @@ int SERIAL_getextchar(COMPORT port) {
 	DWORD dwRead = 0;	// Number of chars read
 	char chRead;
 
+	OVERLAPPED ov = {};
+	ov.hEvent = port->read_event;
+
 	int retval = 0;
-	// receive a byte; TODO communicate failure
-	if (ReadFile (port->porthandle, &chRead, 1, &dwRead, nullptr)) {
+	// receive a byte; the zeroed COMMTIMEOUTS make this return
+	// immediately when nothing is buffered; TODO communicate failure
+	BOOL completed = ReadFile (port->porthandle, &chRead, 1, &dwRead, &ov);
+	if (!completed && GetLastError() == ERROR_IO_PENDING) {
+		completed = GetOverlappedResult(port->porthandle, &ov, &dwRead, TRUE);
+	}
+	if (completed) {
 		if (dwRead) {
 			// check for errors
 			ClearCommError(port->porthandle, &errors, nullptr);
@@ -212,12 +245,35 @@ int SERIAL_getextchar(COMPORT port) {
 			errors &= CE_BREAK|CE_FRAME|CE_RXPARITY|CE_OVERRUN;
 			retval |= (errors<<8);
 			retval |= (chRead & 0xff);
-			retval |= 0x10000; 
+			retval |= 0x10000;
 		}
 	}
 	return retval;
 }
 
+bool SERIAL_waitReadable(COMPORT port, int timeout_ms) {
+	DWORD event_mask = 0;
+
+	OVERLAPPED ov = {};
+	ov.hEvent = port->read_event;
+
+	if (!WaitCommEvent(port->porthandle, &event_mask, &ov)) {
+		if (GetLastError() != ERROR_IO_PENDING) return false;
+
+		if (WaitForSingleObject(port->read_event, timeout_ms) != WAIT_OBJECT_0) {
+			// timed out: re-arming the mask aborts the pending wait
+			SetCommMask(port->porthandle, EV_RXCHAR);
+			DWORD unused = 0;
+			GetOverlappedResult(port->porthandle, &ov, &unused, TRUE);
+			return false;
+		}
+		DWORD unused = 0;
+		if (!GetOverlappedResult(port->porthandle, &ov, &unused, TRUE))
+			return false;
+	}
+	return (event_mask & EV_RXCHAR) != 0;
+}
+
 bool SERIAL_setCommParameters(COMPORT port,
 			int baudrate, char parity, int stopbits, int length) {
 	
@@ -270,6 +326,7 @@ bool SERIAL_setCommParameters(COMPORT port,
 #include <termios.h>
 #include <unistd.h>
 
+#include <poll.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/ioctl.h>
@@ -426,9 +483,18 @@ int SERIAL_getextchar(COMPORT port) {
 	return retval;
 }
 
+bool SERIAL_waitReadable(COMPORT port, int timeout_ms) {
+	pollfd pfd = {};
+	pfd.fd     = port->porthandle;
+	pfd.events = POLLIN;
+
+	const int result = poll(&pfd, 1, timeout_ms);
+	return (result > 0) && (pfd.revents & POLLIN);
+}
+
 bool SERIAL_setCommParameters(COMPORT port,
 			int baudrate, char parity, int stopbits, int length) {
-	
+
 	termios termInfo;
 	int result = tcgetattr(port->porthandle, &termInfo);
 	if (result==-1) return false;
@@ -58,4 +58,10 @@ bool SERIAL_sendchar(COMPORT port, char data);
 
 int SERIAL_getextchar(COMPORT port);
 
+// Blocks until the port has at least one byte to read or the timeout
+// elapses; returns true when readable. Safe to call from a thread other
+// than the one writing the port (overlapped I/O on Windows, poll() on
+// POSIX), which lets a host reader sleep in the OS instead of polling.
+bool SERIAL_waitReadable(COMPORT port, int timeout_ms);
+
 #endif
@@ -31,6 +31,19 @@
 // Constants
 constexpr int connection_timeout_ms = 5000;
 
+// ENet channel layout: channel 0 carries reliable traffic while
+// 'unreliable' mode puts payload bytes on an unsequenced channel that
+// cannot head-of-line block behind a retransmission
+constexpr uint8_t enet_reliable_channel    = 0;
+constexpr uint8_t enet_unsequenced_channel = 1;
+constexpr size_t enet_channel_count        = 2;
+
+// Service the ENet host at most this often so bytes queued within one UART
+// FIFO burst leave as a single batched datagram, and log transport
+// statistics at most this often
+constexpr int64_t enet_service_interval_ms = 1;
+constexpr int64_t enet_stats_interval_ms   = 30000;
+
 const char* to_string(const SocketType socket_type)
 {
 	switch (socket_type) {
@@ -178,7 +191,7 @@ ENETServerSocket::ENETServerSocket(uint16_t port)
 	assert(!host);
 	host = enet_host_create(&address, // create a host
 	                        1, // only allow 1 client to connect
-	                        1, // allow 1 channel to be used, 0
+	                        enet_channel_count, // reliable + unsequenced
 	                        0, // assume any amount of incoming bandwidth
 	                        0  // assume any amount of outgoing bandwidth
 	);
@@ -253,7 +266,7 @@ ENETClientSocket::ENETClientSocket(const char *destination, uint16_t port)
 	assert(!client);
 	client = enet_host_create(nullptr, // create a client host
 	                          1,       // only allow 1 outgoing connection
-	                          1,       // allow 1 channel to be used, 0
+	                          enet_channel_count, // reliable + unsequenced
 	                          0,       // assume any amount of incoming bandwidth
 	                          0        // assume any amount of outgoing bandwidth
 	);
@@ -265,7 +278,7 @@ ENETClientSocket::ENETClientSocket(const char *destination, uint16_t port)
 
 	enet_address_set_host(&address, destination);
 	address.port = port;
-	peer = enet_host_connect(client, &address, 1, 0);
+	peer = enet_host_connect(client, &address, enet_channel_count, 0);
 	if (peer) {
 		LOG_INFO("ENET: Initiating connection to server %s:%u",
 		         destination, port);
@@ -316,6 +329,12 @@ ENETClientSocket::~ENETClientSocket()
 {
 	if (isopen) {
 		assert(peer);
+		LOG_INFO("ENET: Session stats for peer %s:%u => RTT %u ms, "
+		         "%u packets lost/retransmitted",
+		         enet_address_to_string(peer->address),
+		         peer->address.port,
+		         peer->roundTripTime,
+		         peer->totalPacketsLost);
 		enet_peer_reset(peer);
 		enet_host_destroy(client);
 		LOG_INFO("ENET: Closed connection to client %s:%u",
@@ -342,7 +361,10 @@ bool ENETClientSocket::Putchar(uint8_t val)
 {
 	updateState();
 
-	const auto packet = enet_packet_create(&val, 1, ENET_PACKET_FLAG_RELIABLE);
+	const auto flags = unreliable ? ENET_PACKET_FLAG_UNSEQUENCED
+	                              : ENET_PACKET_FLAG_RELIABLE;
+
+	const auto packet = enet_packet_create(&val, 1, flags);
 
 	// Is the packet OK?
 	if (packet == nullptr) {
@@ -350,9 +372,13 @@ bool ENETClientSocket::Putchar(uint8_t val)
 		return false;
 	}
 
-	// Did the packet send successfully?
+	// Queue the packet; it leaves with the next host service, batched
+	// with any other bytes queued in the same interval
 	assert(peer);
-	if (enet_peer_send(peer, 0, packet) < 0) {
+	if (enet_peer_send(peer,
+	                   unreliable ? enet_unsequenced_channel
+	                              : enet_reliable_channel,
+	                   packet) < 0) {
 		LOG_WARNING("ENET: Failed sending packet to peer %s:%u",
 		            enet_address_to_string(peer->address),
 		            peer->address.port);
@@ -360,7 +386,6 @@ bool ENETClientSocket::Putchar(uint8_t val)
 		return false;
 	}
 
-	updateState();
 	return isopen;
 }
 
@@ -372,8 +397,10 @@ bool ENETClientSocket::SendArray(const uint8_t *data, size_t n)
 	// an 8-byte header and 65,527-byte payload.
 	const auto packet_bytes = check_cast<uint16_t>(n);
 
-	const auto packet = enet_packet_create(data, packet_bytes,
-	                                       ENET_PACKET_FLAG_RELIABLE);
+	const auto flags = unreliable ? ENET_PACKET_FLAG_UNSEQUENCED
+	                              : ENET_PACKET_FLAG_RELIABLE;
+
+	const auto packet = enet_packet_create(data, packet_bytes, flags);
 
 	// Is the packet OK?
 	if (packet == nullptr) {
@@ -381,9 +408,13 @@ bool ENETClientSocket::SendArray(const uint8_t *data, size_t n)
 		return false;
 	}
 
-	// Did the packet send successfully?
+	// Queue the packet; it leaves with the next host service, batched
+	// with any other bytes queued in the same interval
 	assert(peer);
-	if (enet_peer_send(peer, 0, packet) < 0) {
+	if (enet_peer_send(peer,
+	                   unreliable ? enet_unsequenced_channel
+	                              : enet_reliable_channel,
+	                   packet) < 0) {
 		LOG_WARNING("ENET: Failed sending %u-byte packet to peer %s:%u",
 		            packet_bytes, enet_address_to_string(peer->address),
 		            peer->address.port);
@@ -391,7 +422,6 @@ bool ENETClientSocket::SendArray(const uint8_t *data, size_t n)
 		return false;
 	}
 
-	updateState();
 	return isopen;
 }
 
@@ -444,11 +474,52 @@ bool ENETClientSocket::GetRemoteAddressString(char *buffer)
 	return true;
 }
 
+void ENETClientSocket::SetUnreliable(const bool enable)
+{
+	unreliable = enable;
+	LOG_INFO("ENET: Payload sends use the %s channel",
+	         enable ? "lossy unsequenced" : "reliable");
+}
+
+// Logs RTT and retransmission counts so long-haul links can be diagnosed
+// from the log alone
+void ENETClientSocket::logTransportStats()
+{
+	if (connecting || !peer) {
+		return;
+	}
+	const auto now = GetTicks();
+	if (lastStatsTicks == 0) {
+		// start the interval at the first serviced connection
+		lastStatsTicks = now;
+		return;
+	}
+	if (now - lastStatsTicks < enet_stats_interval_ms) {
+		return;
+	}
+	lastStatsTicks = now;
+	LOG_INFO("ENET: Peer %s:%u => RTT %u ms (+/- %u ms), "
+	         "%u packets lost/retransmitted this session",
+	         enet_address_to_string(peer->address),
+	         peer->address.port,
+	         peer->roundTripTime,
+	         peer->roundTripTimeVariance,
+	         peer->totalPacketsLost);
+}
+
 void ENETClientSocket::updateState()
 {
 	if (!isopen || !client)
 		return;
 
+	// Service the host at most once per interval so bytes queued by
+	// Putchar()/SendArray() within one UART FIFO burst are batched into
+	// a single service/flush cycle
+	const auto now = GetTicks();
+	if (now - lastServiceTicks < enet_service_interval_ms)
+		return;
+	lastServiceTicks = now;
+
 	ENetEvent event;
 	while (enet_host_service(client, &event, 0) > 0) {
 		switch (event.type) {
@@ -493,6 +564,8 @@ void ENETClientSocket::updateState()
 		}
 	}
 #endif
+
+	logTransportStats();
 }
 
 // --- TCP NET INTERFACE -----------------------------------------------------
@@ -683,6 +756,26 @@ bool TCPClientSocket::Putchar(uint8_t val)
 	return SendArray(&val, 1);
 }
 
+void TCPClientSocket::SetNoDelay([[maybe_unused]] const bool nodelay)
+{
+	// SDL_net enables TCP_NODELAY itself on every socket it opens or
+	// accepts, but offers no way to change it afterwards and skips
+	// sockets inherited from the platform, so we poke the native socket
+	// directly where we can get at it.
+#if defined(NATIVESOCKETS) && defined(TCP_NODELAY)
+	if (!mysock)
+		return;
+
+	const auto channel = reinterpret_cast<_TCPsocketX*>(mysock)->channel;
+
+	const int flag = nodelay ? 1 : 0;
+	if (setsockopt(channel, IPPROTO_TCP, TCP_NODELAY,
+	               reinterpret_cast<const char*>(&flag), sizeof(flag)) < 0) {
+		LOG_WARNING("SDLNET: Failed setting TCP_NODELAY to %d", flag);
+	}
+#endif
+}
+
 bool TCPClientSocket::SendArray(const uint8_t *data, const size_t n)
 {
 	assertm(n <= static_cast<size_t>(std::numeric_limits<int>::max()),
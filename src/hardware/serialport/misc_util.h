@@ -42,6 +42,7 @@
  #include <sys/types.h>
  #include <sys/socket.h>
  #include <netinet/in.h>
+ #include <netinet/tcp.h> //for TCP_NODELAY
  //socklen_t should be handled by configure
 #endif
 
@@ -97,6 +98,16 @@ public:
 	virtual bool ReceiveArray(uint8_t *data, size_t &n) = 0;
 	virtual bool GetRemoteAddressString(char *buffer) = 0;
 
+	// Controls the transport's own write coalescing (TCP_NODELAY); a
+	// no-op for transports without such a knob (ENet/UDP).
+	virtual void SetNoDelay(const bool /*nodelay*/) {}
+
+	// Routes subsequent sends over the transport's lossy unsequenced
+	// channel where one exists, for guest protocols that tolerate loss
+	// and care about latency; a no-op for inherently reliable
+	// transports (TCP).
+	virtual void SetUnreliable(const bool /*unreliable*/) {}
+
 	void FlushBuffer();
 	void SetSendBufferSize(size_t n);
 	bool SendByteBuffered(uint8_t val);
@@ -156,9 +167,11 @@ public:
 	bool SendArray(const uint8_t *data, size_t n) override;
 	bool ReceiveArray(uint8_t *data, size_t &n) override;
 	bool GetRemoteAddressString(char *buffer) override;
+	void SetUnreliable(const bool unreliable) override;
 
 private:
 	void updateState();
+	void logTransportStats();
 
 #ifndef ENET_BLOCKING_CONNECT
 	int64_t              connectStart  = 0;
@@ -168,6 +181,9 @@ private:
 	ENetPeer            *peer          = nullptr;
 	ENetAddress          address       = {};
 	std::queue<uint8_t>  receiveBuffer = {};
+	int64_t              lastServiceTicks = 0;
+	int64_t              lastStatsTicks   = 0;
+	bool                 unreliable       = false;
 };
 
 // --- TCP NET INTERFACE -----------------------------------------------------
@@ -199,6 +215,7 @@ public:
 	bool SendArray(const uint8_t *data, size_t n) override;
 	bool ReceiveArray(uint8_t *data, size_t &n) override;
 	bool GetRemoteAddressString(char *buffer) override;
+	void SetNoDelay(const bool nodelay) override;
 
 private:
 
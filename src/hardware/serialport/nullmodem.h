@@ -70,6 +70,11 @@ private:
 #define N_RX_DISC		4
 
 	bool doReceive();
+	// receive up to a receive-FIFO's worth; returns the number of bytes
+	uint32_t doReceiveBlock();
+	// serve a byte from the staging buffer, refilling it with one bulk
+	// socket read when it runs dry
+	SocketState getRxByte(uint8_t &val);
 	bool ClientConnect(NETClientSocket *newsocket);
 	bool ServerListen();
 	bool ServerConnect();
@@ -92,6 +97,18 @@ private:
 	uint32_t tx_gather = 0; // how long to gather tx data before
 	                        // sending all of them [milliseconds]
 
+	bool tcp_nodelay = true; // disable Nagle's algorithm on the TCP
+	                         // connection; batching is done by the
+	                         // tx_gather window instead
+
+	bool enet_unreliable = false; // send over ENet's lossy unsequenced
+	                              // channel instead of the reliable one
+
+	// staging buffer for bulk socket reads; getRxByte() serves from it
+	uint8_t rx_buffer[256]  = {};
+	uint32_t rx_buffer_size = 0;
+	uint32_t rx_buffer_pos  = 0;
+
 	bool dtrrespect = false; // dtr behavior - only send data to the serial
 	                         // port when DTR is on
 
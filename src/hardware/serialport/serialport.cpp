@@ -367,6 +367,10 @@ bool CSerial::CanReceiveByte() {
 	return !rxfifo->isFull();
 }
 
+size_t CSerial::rxFifoFree() {
+	return rxfifo->getFree();
+}
+
 /*****************************************************************************/
 /* A byte was received                                                      **/
 /*****************************************************************************/
@@ -0,0 +1,205 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "snapshot.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "cpu.h"
+#include "fpu.h"
+#include "mapper.h"
+#include "mem.h"
+#include "paging.h"
+#include "regs.h"
+#include "setup.h"
+#include "support.h"
+
+// Guest RAM is captured and restored per 4 KiB page against the previous
+// snapshot, so periodic checkpoints only copy the pages a title actually
+// touched since the last one. Restores only copy back the pages that
+// differ from the snapshot, which keeps both directions well under a
+// second even for the largest supported memory sizes.
+
+#if (C_DYNAMIC_X86)
+void CPU_Core_Dyn_X86_Cache_Init(bool enable_cache);
+#elif (C_DYNREC)
+void CPU_Core_Dynrec_Cache_Init(bool enable_cache);
+#endif
+
+struct SnapshotModule {
+	std::string name                = {};
+	SNAPSHOT_SaveHandler save       = nullptr;
+	SNAPSHOT_LoadHandler load       = nullptr;
+	std::vector<uint8_t> state      = {};
+};
+
+static struct Snapshot {
+	bool valid = false;
+
+	// CPU register file and control state
+	CPU_Regs regs  = {};
+	Segments segs  = {};
+	CPUBlock block = {};
+#if C_FPU
+	FPU_rec fpu = {};
+#endif
+
+	// All guest RAM pages, laid out back to back
+	std::vector<uint8_t> pages = {};
+
+	std::vector<SnapshotModule> modules = {};
+} snapshot = {};
+
+void SNAPSHOT_AddModule(const char* name, const SNAPSHOT_SaveHandler save,
+                        const SNAPSHOT_LoadHandler load)
+{
+	assert(name && save && load);
+	snapshot.modules.push_back({name, save, load, {}});
+}
+
+void SNAPSHOT_Capture()
+{
+	const auto num_pages  = MEM_TotalPages();
+	const auto total_size = static_cast<size_t>(num_pages) * dos_pagesize;
+
+	// The first capture copies everything; later ones only the pages
+	// that have changed since the previous capture
+	const bool is_incremental = snapshot.valid &&
+	                            snapshot.pages.size() == total_size;
+	if (!is_incremental) {
+		snapshot.pages.resize(total_size);
+	}
+
+	uint32_t pages_copied = 0;
+	for (uint32_t page = 0; page < num_pages; ++page) {
+		const auto offset = static_cast<size_t>(page) * dos_pagesize;
+		const auto* live  = MemBase + offset;
+		auto* stored      = snapshot.pages.data() + offset;
+
+		if (is_incremental && memcmp(stored, live, dos_pagesize) == 0) {
+			continue;
+		}
+		memcpy(stored, live, dos_pagesize);
+		++pages_copied;
+	}
+
+	snapshot.regs  = cpu_regs;
+	snapshot.segs  = Segs;
+	snapshot.block = cpu;
+#if C_FPU
+	snapshot.fpu = fpu;
+#endif
+
+	for (auto& module : snapshot.modules) {
+		module.state.clear();
+		module.save(module.state);
+	}
+
+	snapshot.valid = true;
+	LOG_MSG("SNAPSHOT: Captured machine state (%u of %u pages copied)",
+	        pages_copied,
+	        num_pages);
+}
+
+bool SNAPSHOT_Restore()
+{
+	if (!snapshot.valid) {
+		LOG_WARNING("SNAPSHOT: No snapshot to restore");
+		return false;
+	}
+
+	const auto num_pages = MEM_TotalPages();
+	assert(snapshot.pages.size() ==
+	       static_cast<size_t>(num_pages) * dos_pagesize);
+
+	uint32_t pages_copied = 0;
+	for (uint32_t page = 0; page < num_pages; ++page) {
+		const auto offset = static_cast<size_t>(page) * dos_pagesize;
+		auto* live        = MemBase + offset;
+		const auto* stored = snapshot.pages.data() + offset;
+
+		if (memcmp(live, stored, dos_pagesize) == 0) {
+			continue;
+		}
+		memcpy(live, stored, dos_pagesize);
+		++pages_copied;
+	}
+
+	cpu_regs = snapshot.regs;
+	Segs     = snapshot.segs;
+	cpu      = snapshot.block;
+#if C_FPU
+	fpu = snapshot.fpu;
+#endif
+
+	bool all_loaded = true;
+	for (const auto& module : snapshot.modules) {
+		if (!module.load(module.state)) {
+			LOG_WARNING("SNAPSHOT: Module '%s' rejected its saved state",
+			            module.name.c_str());
+			all_loaded = false;
+		}
+	}
+
+	// The restore wrote to guest RAM behind the paging layer's back, so
+	// drop the TLB and any dynamically recompiled code
+	PAGING_ClearTLB();
+#if (C_DYNAMIC_X86)
+	CPU_Core_Dyn_X86_Cache_Init(true);
+#elif (C_DYNREC)
+	CPU_Core_Dynrec_Cache_Init(true);
+#endif
+
+	LOG_MSG("SNAPSHOT: Restored machine state (%u of %u pages copied)",
+	        pages_copied,
+	        num_pages);
+	return all_loaded;
+}
+
+static void capture_handler(const bool pressed)
+{
+	if (pressed) {
+		SNAPSHOT_Capture();
+	}
+}
+
+static void restore_handler(const bool pressed)
+{
+	if (pressed) {
+		SNAPSHOT_Restore();
+	}
+}
+
+void SNAPSHOT_Init(Section*)
+{
+	// Unbound by default; assign keys through the mapper
+	MAPPER_AddHandler(capture_handler,
+	                  SDL_SCANCODE_UNKNOWN,
+	                  0,
+	                  "snapshot",
+	                  "Take Snapshot");
+	MAPPER_AddHandler(restore_handler,
+	                  SDL_SCANCODE_UNKNOWN,
+	                  0,
+	                  "snaprest",
+	                  "Load Snapshot");
+}
@@ -45,8 +45,10 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <queue>
 #include <string_view>
+#include <vector>
 
 #include "bios.h"
 #include "channel_names.h"
@@ -145,7 +147,7 @@ private:
 	TandyPSG &operator=(const TandyPSG &) = delete;
 
 	void AudioCallback(uint16_t requested_frames);
-	bool MaybeRenderFrame(float &frame);
+	void RenderChipSamples(int num_samples, std::vector<float>& out);
 	void RenderUpToNow();
 	void WriteToPort(io_port_t, io_val_t value, io_width_t);
 
@@ -156,6 +158,11 @@ private:
 	std::unique_ptr<reSIDfp::TwoPassSincResampler> resampler = {};
 	std::queue<float> fifo                                   = {};
 
+	// Scratch buffers for block rendering: chip samples straight from
+	// the MAME core and the resampled frames headed to the mixer
+	std::array<int16_t, 128> chip_buffer = {};
+	std::vector<float> render_buffer     = {};
+
 	// Static rate-related configuration
 	static constexpr auto render_divisor = 16;
 	static constexpr auto render_rate_hz = ceil_sdivide(tandy_psg_clock_hz,
@@ -512,24 +519,33 @@ TandyPSG::~TandyPSG()
 	MIXER_DeregisterChannel(channel);
 }
 
-bool TandyPSG::MaybeRenderFrame(float& frame)
+// Render a block of chip samples with a single call into the MAME core,
+// which keeps its tone and noise state in registers for the whole run,
+// then push them through the resampler and append the finished frames
+// to 'out'
+void TandyPSG::RenderChipSamples(const int num_samples, std::vector<float>& out)
 {
 	assert(dsi);
 	assert(resampler);
 
-	// Request a frame from the audio device
-	static int16_t sample;
-	static int16_t *buf[] = {&sample, nullptr};
 	static device_sound_interface::sound_stream ss;
-	dsi->sound_stream_update(ss, nullptr, buf, 1);
 
-	const auto frame_is_ready = resampler->input(sample);
+	auto samples_remaining = num_samples;
+	while (samples_remaining > 0) {
+		const auto block = std::min(samples_remaining,
+		                            static_cast<int>(chip_buffer.size()));
 
-	// Get the frame
-	if (frame_is_ready)
-		frame = static_cast<float>(resampler->output());
+		int16_t* buf[] = {chip_buffer.data(), nullptr};
+		dsi->sound_stream_update(ss, nullptr, buf, block);
 
-	return frame_is_ready;
+		for (auto i = 0; i < block; ++i) {
+			if (resampler->input(chip_buffer[i])) {
+				out.push_back(static_cast<float>(
+				        resampler->output()));
+			}
+		}
+		samples_remaining -= block;
+	}
 }
 
 void TandyPSG::RenderUpToNow()
@@ -542,11 +558,18 @@ void TandyPSG::RenderUpToNow()
 		last_rendered_ms = now;
 		return;
 	}
-	// Keep rendering until we're current
-	while (last_rendered_ms < now) {
-		last_rendered_ms += ms_per_render;
-		if (float frame = 0.0f; MaybeRenderFrame(frame))
-			fifo.emplace(frame);
+	// Catch up to current time in one block render
+	const auto samples_pending = static_cast<int>(
+	        std::ceil((now - last_rendered_ms) / ms_per_render));
+	if (samples_pending <= 0) {
+		return;
+	}
+	last_rendered_ms += samples_pending * ms_per_render;
+
+	render_buffer.clear();
+	RenderChipSamples(samples_pending, render_buffer);
+	for (const auto frame : render_buffer) {
+		fifo.emplace(frame);
 	}
 }
 
@@ -568,17 +591,33 @@ void TandyPSG::AudioCallback(const uint16_t requested_frames)
 	auto frames_remaining = requested_frames;
 
 	// First, send any frames we've queued since the last callback
+	render_buffer.clear();
 	while (frames_remaining && fifo.size()) {
-		channel->AddSamples_mfloat(1, &fifo.front());
+		render_buffer.push_back(fifo.front());
 		fifo.pop();
 		--frames_remaining;
 	}
+	if (!render_buffer.empty()) {
+		channel->AddSamples_mfloat(check_cast<uint16_t>(
+		                                   render_buffer.size()),
+		                           render_buffer.data());
+	}
 	// If the queue's run dry, render the remainder and sync-up our time datum
-	while (frames_remaining) {
-		if (float frame = 0.0f; MaybeRenderFrame(frame)) {
-			channel->AddSamples_mfloat(1, &frame);
+	if (frames_remaining) {
+		if (device->is_muted()) {
+			// All four attenuators are at maximum, so the chip is
+			// silent: skip synthesis and let the channel's
+			// sleep/fade support idle it until the next write
+			channel->AddSilence();
+		} else {
+			render_buffer.clear();
+			RenderChipSamples(frames_remaining, render_buffer);
+			if (!render_buffer.empty()) {
+				channel->AddSamples_mfloat(
+				        check_cast<uint16_t>(render_buffer.size()),
+				        render_buffer.data());
+			}
 		}
-		--frames_remaining;
 	}
 	last_rendered_ms = PIC_FullIndex();
 }
@@ -21,6 +21,14 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <thread>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif defined(LINUX)
+#include <cerrno>
+#include <time.h>
+#endif
 
 #include "inout.h"
 #include "pic.h"
@@ -31,6 +39,83 @@
 
 const std::chrono::steady_clock::time_point system_start_time = std::chrono::steady_clock::now();
 
+#if defined(WIN32)
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+void DelayUntilTicksNs(const int64_t deadline_ns)
+{
+	const auto remaining_ns = deadline_ns - GetTicksNs();
+	if (remaining_ns <= 0) {
+		return;
+	}
+
+#if defined(WIN32)
+	// High-resolution waitable timers (Windows 10 1803+) honour
+	// sub-millisecond due times; on older systems we fall back to a
+	// regular timer with scheduler granularity.
+	static HANDLE timer = []() {
+		HANDLE handle = CreateWaitableTimerExW(
+		        nullptr, nullptr,
+		        CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+		if (!handle) {
+			handle = CreateWaitableTimerExW(nullptr, nullptr, 0,
+			                                TIMER_ALL_ACCESS);
+		}
+		return handle;
+	}();
+
+	if (timer) {
+		// negative due time means relative, in 100 ns units
+		LARGE_INTEGER due_time = {};
+		due_time.QuadPart = -(remaining_ns / 100);
+		if (SetWaitableTimer(timer, &due_time, 0, nullptr, nullptr, FALSE)) {
+			WaitForSingleObject(timer, INFINITE);
+			return;
+		}
+	}
+	std::this_thread::sleep_for(std::chrono::nanoseconds(remaining_ns));
+#elif defined(LINUX)
+	// Sleep against the absolute monotonic deadline, so a signal or the
+	// time spent between computing the deadline and parking the thread
+	// cannot push the wakeup back
+	timespec now = {};
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	constexpr int64_t nanoseconds_per_second = 1'000'000'000;
+	const auto total_ns = now.tv_sec * nanoseconds_per_second +
+	                      now.tv_nsec + remaining_ns;
+
+	timespec deadline = {};
+	deadline.tv_sec  = total_ns / nanoseconds_per_second;
+	deadline.tv_nsec = total_ns % nanoseconds_per_second;
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline,
+	                       nullptr) == EINTR) {
+		// interrupted by a signal: keep waiting for the same deadline
+	}
+#else
+	std::this_thread::sleep_until(system_start_time +
+	                              std::chrono::nanoseconds(deadline_ns));
+#endif
+}
+
+void DelayUntilTicksNsPrecise(const int64_t deadline_ns)
+{
+	// Hand the OS wait a deadline short by its typical overshoot, then
+	// spin out the remainder against the monotonic clock
+	constexpr int64_t spin_margin_ns = 200'000;
+
+	if (deadline_ns - GetTicksNs() > spin_margin_ns) {
+		DelayUntilTicksNs(deadline_ns - spin_margin_ns);
+	}
+	while (GetTicksNs() < deadline_ns) {
+		std::this_thread::yield();
+	}
+}
+
 /*
  Bit 4 and 5    Access mode :
                 0 0 = Latch count value command
@@ -179,8 +264,45 @@ constexpr int update_channel_delay(PIT_Block &channel)
 	return freq_divider;
 }
 
+// Interrupt batching for multi-kHz channel 0 rates (see 'pit_irq_batching').
+//
+// Instead of one PIC event per period, one host event per batch window
+// raises the first IRQ and banks the rest; every guest EOI of IRQ 0 then
+// immediately re-raises the line until the bank is empty. Every interrupt
+// is still delivered, and latch reads stay exact because counter_latch()
+// derives the count from elapsed emulated time, not from event counts.
+// Batching only engages while the measured guest handler cost stays well
+// below the period - the trivial tick-increment handlers - since bursted
+// delivery compresses the spacing between the interrupts of one window.
+static bool pit_batching_enabled = false; // from the config, set at startup
+
+static int banked_irq0_count  = 0;
+static double irq0_raised_at  = -1.0;
+static double avg_int8_cost_ms = 0.0;
+// No EOI seen yet means no measurement (and an auto-EOI guest would never
+// drain the bank), so stay on per-period events until one arrives
+static bool int8_cost_measured = false;
+
+constexpr double batch_window_ms = 1.0;
+
+static void pit_irq0_acknowledged()
+{
+	if (irq0_raised_at >= 0.0) {
+		const auto cost_ms = PIC_FullIndex() - irq0_raised_at;
+		avg_int8_cost_ms = 0.9 * avg_int8_cost_ms + 0.1 * cost_ms;
+		int8_cost_measured = true;
+		irq0_raised_at     = -1.0;
+	}
+	if (banked_irq0_count > 0) {
+		--banked_irq0_count;
+		irq0_raised_at = PIC_FullIndex();
+		PIC_ActivateIRQ(0);
+	}
+}
+
 static void PIT0_Event(uint32_t /*val*/)
 {
+	irq0_raised_at = PIC_FullIndex();
 	PIC_ActivateIRQ(0);
 	if (channel_0.mode != PitMode::InterruptOnTerminalCount) {
 		channel_0.start += channel_0.delay;
@@ -189,7 +311,19 @@ static void PIT0_Event(uint32_t /*val*/)
 			update_channel_delay(channel_0);
 			channel_0.update_count = false;
 		}
-		PIC_AddEvent(PIT0_Event, channel_0.delay);
+
+		auto periods = 1;
+		if (pit_batching_enabled && int8_cost_measured &&
+		    channel_0.delay * 2.0 < batch_window_ms &&
+		    avg_int8_cost_ms * 2.0 < channel_0.delay) {
+			periods = static_cast<int>(batch_window_ms /
+			                           channel_0.delay);
+			// A still-loaded bank means the guest fell behind; the
+			// leftovers coalesce, as they would on the real IRR
+			banked_irq0_count = periods - 1;
+			channel_0.start += channel_0.delay * (periods - 1);
+		}
+		PIC_AddEvent(PIT0_Event, channel_0.delay * periods);
 	}
 }
 
@@ -397,6 +531,7 @@ static void write_latch(io_port_t port, io_val_t value, io_width_t)
 				    PitMode::InterruptOnTerminalCount) { // DoWhackaDo
 					                                 // demo
 					PIC_RemoveEvents(PIT0_Event);
+					banked_irq0_count = 0;
 				}
 				PIC_AddEvent(PIT0_Event, channel.delay);
 			} else {
@@ -531,6 +666,7 @@ static void latch_single_channel(const uint8_t channel_num, const uint8_t val)
 
 	if (channel_num == 0) {
 		PIC_RemoveEvents(PIT0_Event);
+		banked_irq0_count = 0;
 		if ((channel.mode != PitMode::InterruptOnTerminalCount) && !old_output)
 			PIC_ActivateIRQ(0);
 		else
@@ -636,6 +772,10 @@ private:
 	IO_WriteHandleObject WriteHandler[4];
 public:
 	TIMER(Section* configuration):Module_base(configuration){
+		const auto section = static_cast<Section_prop*>(configuration);
+		pit_batching_enabled = section->Get_bool("pit_irq_batching");
+		PIC_SetIRQ0EOIHandler(pit_irq0_acknowledged);
+
 		WriteHandler[0].Install(0x40, write_latch, io_width_t::byte);
 		//	WriteHandler[1].Install(0x41,write_latch,io_width_t::byte);
 		WriteHandler[2].Install(0x42, write_latch, io_width_t::byte);
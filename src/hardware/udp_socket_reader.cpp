@@ -0,0 +1,93 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024-2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "udp_socket_reader.h"
+
+#if C_IPX
+
+#include "support.h"
+
+// Enough for a multi-millisecond burst; the reader blocks (and the OS
+// socket buffer takes over) if the consumer falls further behind
+constexpr size_t QueueCapacity = 256;
+
+// How long each select() round sleeps; bounds both shutdown latency and
+// the reader's idle wakeup rate
+constexpr uint32_t SelectTimeoutMs = 100;
+
+UdpSocketReader::UdpSocketReader(UDPsocket udp_socket, int udp_channel)
+        : socket(udp_socket),
+          channel(udp_channel),
+          queue(QueueCapacity)
+{
+	socket_set = SDLNet_AllocSocketSet(1);
+	if (!socket_set) {
+		LOG_WARNING("UDP: Failed to allocate socket set: %s",
+		            SDLNet_GetError());
+		return;
+	}
+	SDLNet_UDP_AddSocket(socket_set, socket);
+	reader = std::thread(&UdpSocketReader::ReadLoop, this);
+}
+
+UdpSocketReader::~UdpSocketReader()
+{
+	keep_running = false;
+	queue.Stop();
+	if (reader.joinable())
+		reader.join();
+	if (socket_set)
+		SDLNet_FreeSocketSet(socket_set);
+}
+
+std::optional<UdpDatagram> UdpSocketReader::Receive()
+{
+	// only the cheap atomic check on the (common) empty path
+	if (queue.IsEmpty())
+		return {};
+	return queue.Dequeue();
+}
+
+void UdpSocketReader::ReadLoop()
+{
+	UdpDatagram datagram = {};
+	while (keep_running) {
+		// timeout or transient error: just recheck if we should quit
+		if (SDLNet_CheckSockets(socket_set, SelectTimeoutMs) <= 0)
+			continue;
+
+		UDPpacket packet = {};
+		packet.data    = datagram.data.data();
+		packet.maxlen  = UdpDatagram::MaxSize;
+		packet.channel = channel;
+
+		// drain everything the socket has before sleeping again
+		while (keep_running && SDLNet_UDP_Recv(socket, &packet) > 0) {
+			datagram.address = packet.address;
+			datagram.len     = check_cast<uint16_t>(packet.len);
+			if (!queue.Enqueue(std::move(datagram)))
+				return; // queue stopped; we're shutting down
+			packet.data   = datagram.data.data();
+			packet.maxlen = UdpDatagram::MaxSize;
+		}
+	}
+}
+
+#endif
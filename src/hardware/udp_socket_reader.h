@@ -0,0 +1,84 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024-2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef DOSBOX_UDP_SOCKET_READER_H
+#define DOSBOX_UDP_SOCKET_READER_H
+
+#include "dosbox.h"
+
+#if C_IPX
+
+#include <SDL_net.h>
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <thread>
+
+#include "rwqueue.h"
+
+// A datagram received by the reader thread, ready for the device to consume
+struct UdpDatagram {
+	// Large enough for any payload over a standard 1500-byte MTU
+	static constexpr uint16_t MaxSize = 1472;
+
+	IPaddress address = {};
+	uint16_t len = 0;
+	std::array<uint8_t, MaxSize> data = {};
+};
+
+/* A background reader for a UDP socket
+ *
+ * The IPX device and server used to poll their sockets with a
+ * non-blocking receive from a millisecond tick handler, which burns a
+ * syscall per tick per instance while idle and caps receipt at one
+ * datagram per tick under load. This reader instead sleeps in select()
+ * on a dedicated thread and queues every pending datagram, so the tick
+ * handler only has to drain a lock-free queue.
+ *
+ * Sending stays on the emulation thread; send and receive on a UDP
+ * socket are independent operations, so the two sides don't contend.
+ */
+class UdpSocketReader {
+public:
+	// The socket must stay open for the lifetime of the reader
+	UdpSocketReader(UDPsocket udp_socket, int udp_channel);
+	~UdpSocketReader();
+
+	UdpSocketReader(const UdpSocketReader&) = delete;
+	UdpSocketReader& operator=(const UdpSocketReader&) = delete;
+
+	// Non-blocking; empty when no datagram is pending
+	std::optional<UdpDatagram> Receive();
+
+private:
+	void ReadLoop();
+
+	UDPsocket socket = nullptr;
+	int channel = -1;
+	SDLNet_SocketSet socket_set = nullptr;
+	RWQueue<UdpDatagram> queue;
+	std::thread reader = {};
+	std::atomic<bool> keep_running = true;
+};
+
+#endif
+
+#endif
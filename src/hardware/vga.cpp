@@ -70,6 +70,20 @@ void VGA_SetMode(VGAModes mode) {
 	VGA_StartResize();
 }
 
+void VGA_BeginModeProgram()
+{
+	vga.mode_program.active = true;
+}
+
+void VGA_EndModeProgram()
+{
+	vga.mode_program.active = false;
+	if (vga.mode_program.wants_handlers) {
+		vga.mode_program.wants_handlers = false;
+		VGA_SetupHandlers();
+	}
+}
+
 void VGA_DetermineMode(void) {
 	if (svga.determine_mode) {
 		svga.determine_mode();
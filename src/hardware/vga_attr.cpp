@@ -27,6 +27,7 @@
 
 static void update_palette_mappings()
 {
+	vga.attr.palette_mappings_dirty = false;
 	for (uint8_t i = 0; i < NumCgaColors; ++i) {
 		const auto palette_reg_idx = i;
 		const auto value = PaletteRegister{vga.attr.palette[i]};
@@ -34,6 +35,22 @@ static void update_palette_mappings()
 	}
 }
 
+// Mark the combined palette-to-DAC mappings stale instead of recomputing
+// them on the spot; raster engines rewrite these registers dozens of times
+// around each retrace and the next drawn line picks up the result once.
+static void defer_palette_mappings_update()
+{
+	vga.attr.palette_mappings_dirty = true;
+	VGA_NotifyMidFrameChange();
+}
+
+void VGA_ATTR_FlushPaletteUpdates()
+{
+	if (GCC_UNLIKELY(vga.attr.palette_mappings_dirty)) {
+		update_palette_mappings();
+	}
+}
+
 void VGA_ATTR_SetEGAMonitorPalette(const EgaMonitorMode m)
 {
 	// palette bit assignment:
@@ -169,7 +186,7 @@ static void write_p3c0(io_port_t, io_val_t value, io_width_t)
 			vga.attr.mode_control.data = new_value.data;
 
 			if (has_changed.palette_bits_5_4_select) {
-				update_palette_mappings();
+				defer_palette_mappings_update();
 			}
 			if (has_changed.is_blink_enabled) {
 				VGA_SetBlinking(vga.attr.mode_control.is_blink_enabled);
@@ -208,7 +225,7 @@ static void write_p3c0(io_port_t, io_val_t value, io_width_t)
 			if ((vga.attr.color_plane_enable ^ val) & 0xf) {
 				// In case the plane enable bits change...
 				vga.attr.color_plane_enable = val;
-				update_palette_mappings();
+				defer_palette_mappings_update();
 			} else {
 				vga.attr.color_plane_enable = val;
 			}
@@ -267,7 +284,7 @@ static void write_p3c0(io_port_t, io_val_t value, io_width_t)
 			}
 			if (vga.attr.color_select ^ val) {
 				vga.attr.color_select = val;
-				update_palette_mappings();
+				defer_palette_mappings_update();
 			}
 			// 0-1	If 3C0h index 10h bit 7 is set these 2 bits are
 			// used as bits 4-5 of the index into the DAC table.
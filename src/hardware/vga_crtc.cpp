@@ -254,6 +254,7 @@ void vga_write_p3d5(io_port_t, io_val_t value, io_width_t)
 		vga.crtc.start_address_high = val;
 		vga.config.display_start = (vga.config.display_start & 0xFF00FF) |
 		                           (val << 8);
+		VGA_NotifyMidFrameChange();
 
 		// 0-7  Upper 8 bits of the start address of the display buffer.
 		break;
@@ -261,6 +262,7 @@ void vga_write_p3d5(io_port_t, io_val_t value, io_width_t)
 	case 0x0d: // Start Address Low Register
 		vga.crtc.start_address_low = val;
 		vga.config.display_start = (vga.config.display_start & 0xFFFF00) | val;
+		VGA_NotifyMidFrameChange();
 
 		//0-7	Lower 8 bits of the start address of the display buffer.
 		break;
@@ -353,7 +355,9 @@ void vga_write_p3d5(io_port_t, io_val_t value, io_width_t)
 		//      for byte mode, 4 for word mode and 8 for Double Word mode.
 		break;
 
-	case 0x14: // Underline Location Register
+	case 0x14: { // Underline Location Register
+		const bool dword_mode_changed =
+		        ((vga.crtc.underline_location ^ val) & 0x40) != 0;
 		vga.crtc.underline_location = val;
 		if (IS_VGA_ARCH) {
 			// Byte,word,dword mode
@@ -364,6 +368,11 @@ void vga_write_p3d5(io_port_t, io_val_t value, io_width_t)
 			} else {
 				vga.config.addr_shift = 1;
 			}
+			// Doubleword addressing decides whether chained Mode
+			// 13h can stay mapped onto the packed shadow surface
+			if (dword_mode_changed && vga.mode == M_VGA) {
+				VGA_SetupHandlers();
+			}
 		} else {
 			vga.config.addr_shift = 1;
 		}
@@ -373,6 +382,7 @@ void vga_write_p3d5(io_port_t, io_val_t value, io_width_t)
 		// 		clock.
 		// 6	Double Word mode addressing if set.
 		break;
+	}
 
 	case 0x15: // Start Vertical Blank Register
 		if (val != vga.crtc.start_vertical_blanking) {
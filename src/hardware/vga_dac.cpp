@@ -86,7 +86,9 @@ static void vga_dac_send_color(const uint8_t palette_idx, const uint8_t color_id
 		}
 	}
 
-	// Map the source color into palette's requested index
+	// Map the source color into palette's requested index; the parallel
+	// line worker reads the palette map, so let it finish first
+	VGA_ParallelDrawSync();
 	vga.dac.palette_map[palette_idx].Set(b8, g8, r8);
 
 	ReelMagic_RENDER_SetPalette(palette_idx, r8, g8, b8);
@@ -208,6 +210,10 @@ static void write_p3c9(io_port_t, io_val_t value, io_width_t)
 			}
 		}
 
+		// A completed palette entry landing during active display is
+		// the classic copper-style raster effect
+		VGA_NotifyMidFrameChange();
+
 		++vga.dac.write_index;
 		// vga.dac.read_index = vga.dac.write_index - ;
 		// disabled as it breaks Wari
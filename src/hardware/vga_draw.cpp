@@ -23,9 +23,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include "../gui/render_scalers.h"
 #include "../ints/int10.h"
@@ -36,6 +42,16 @@
 #include "reelmagic.h"
 #include "render.h"
 #include "rgb565.h"
+#include "rwqueue.h"
+#include "tracy.h"
+#include "support.h"
+#include "timer.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 #include "vga.h"
 #include "video.h"
 
@@ -58,11 +74,82 @@ constexpr auto max_line_bytes  = SCALER_MAXWIDTH * max_pixel_bytes;
 alignas(uint32_t) static std::array<uint8_t, max_line_bytes> templine_buffer;
 static auto TempLine = templine_buffer.data();
 
+// Dirty-VRAM window latched once per frame from vga.dirty (see vga.h).
+// While valid, scanlines whose source bytes fall outside the window are
+// handed to the renderer as "unchanged" without running the line drawers.
+static struct {
+	bool valid     = false;
+	uint32_t first = 0;
+	uint32_t last  = 0;
+} dirty_window = {};
+
+// Returns true when the current scanline's source bytes fall outside
+// the latched dirty window, i.e. are unchanged since the last frame.
+static bool is_clean_line()
+{
+	if (!dirty_window.valid) {
+		return false;
+	}
+	// A row never covers more source bytes than the larger of the line
+	// length and the per-row address increment, whichever applies
+	const auto span = std::max(static_cast<Bitu>(vga.draw.line_length),
+	                           vga.draw.address_add) +
+	                  vga.draw.panning;
+
+	const auto start = vga.draw.address & vga.draw.linear_mask;
+	if (GCC_UNLIKELY((start + span) & ~vga.draw.linear_mask)) {
+		// Wrapping lines are rare; just draw them
+		return false;
+	}
+	if (start + span > dirty_window.first && start <= dirty_window.last) {
+		return false;
+	}
+	return true;
+}
+
+// Returns true when the current scanline is unchanged since the last
+// frame and the renderer accepted its cached copy.
+static bool skip_clean_line()
+{
+	return is_clean_line() && RENDER_MaybeSkipLine();
+}
+
 static uint8_t * VGA_Draw_1BPP_Line(Bitu vidstart, Bitu line) {
 	const uint8_t *base = vga.tandy.draw_base + ((line & vga.tandy.line_mask) << vga.tandy.line_shift);
 
+	Bitu x = vga.draw.blocks;
+
+#if defined(__SSE2__)
+	// Deinterleave two source bytes (16 pixels) per step: test each
+	// bit against its positional mask and select between the two
+	// programmed colours (recovered from the expansion table)
+	const auto c0 = _mm_set1_epi8(static_cast<char>(CGA_2_Table[0]));
+	const auto c1 = _mm_set1_epi8(static_cast<char>(CGA_2_Table[15]));
+
+	// Pixel n within each byte is bit (7 - n)
+	const auto bits = _mm_set_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+	                               1, 2, 4, 8, 16, 32, 64, -128);
+
+	auto out = TempLine;
+	while (x >= 2) {
+		const auto b0 = base[vidstart++ & (8 * 1024 - 1)];
+		const auto b1 = base[vidstart++ & (8 * 1024 - 1)];
+
+		const auto v = _mm_unpacklo_epi64(_mm_set1_epi8(static_cast<char>(b0)),
+		                                  _mm_set1_epi8(static_cast<char>(b1)));
+
+		const auto mask = _mm_cmpeq_epi8(_mm_and_si128(v, bits), bits);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out),
+		                 _mm_or_si128(_mm_and_si128(mask, c1),
+		                              _mm_andnot_si128(mask, c0)));
+		out += 16;
+		x -= 2;
+	}
+	uint16_t i = check_cast<uint16_t>((out - TempLine) / sizeof(uint32_t));
+#else
 	uint16_t i = 0;
-	for (Bitu x = vga.draw.blocks; x > 0; --x, ++vidstart) {
+#endif
+	for (; x > 0; --x, ++vidstart) {
 		Bitu val = base[(vidstart & (8 * 1024 -1))];
 		write_unaligned_uint32_at(TempLine, i++, CGA_2_Table[val >> 4]);
 		write_unaligned_uint32_at(TempLine, i++, CGA_2_Table[val & 0xf]);
@@ -148,12 +235,49 @@ static uint8_t byte_clamp(int v)
 	return v < 0 ? 0u : (v > 255 ? 255u : static_cast<uint8_t>(v));
 }
 
+// Composite filter cost accounting, sampled by the telemetry endpoint so
+// the vectorized and scalar kernels can be compared on live instances
+static std::atomic<uint64_t> composite_num_lines = 0;
+static std::atomic<uint64_t> composite_total_us  = 0;
+
+void VGA_GetCompositeFilterStats(uint64_t& num_lines, uint64_t& total_us)
+{
+	num_lines = composite_num_lines;
+	total_us  = composite_total_us;
+}
+
+#if defined(__SSE2__)
+// 4-lane signed 32-bit multiply; SSE2 itself only has the widening form
+static inline __m128i mullo_epi32_sse2(const __m128i a, const __m128i b)
+{
+#if defined(__SSE4_1__)
+	return _mm_mullo_epi32(a, b);
+#else
+	const auto even = _mm_mul_epu32(a, b);
+	const auto odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+	                          _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+}
+
+// Shift each 32-bit lane right by 13 and clamp to 0..255 (the vector
+// counterpart of byte_clamp), returning the four result bytes in the low
+// doubleword
+static inline __m128i clamp13_to_bytes(const __m128i v)
+{
+	const auto w = _mm_packs_epi32(_mm_srai_epi32(v, 13), _mm_setzero_si128());
+	return _mm_packus_epi16(w, w);
+}
+#endif
+
 static uint8_t *Composite_Process(uint8_t border, uint32_t blocks, bool double_width)
 {
 	static int temp[SCALER_MAXWIDTH + 10] = {0};
 	static int atemp[SCALER_MAXWIDTH + 2] = {0};
 	static int btemp[SCALER_MAXWIDTH + 2] = {0};
 
+	const auto start_us = GetTicksUs();
+
 	int w = blocks * 4;
 
 	if (double_width) {
@@ -193,7 +317,35 @@ static uint8_t *Composite_Process(uint8_t border, uint32_t blocks, bool double_w
 		// Decode
 		int *i = temp + 5;
 		uint16_t idx = 0;
-		for (uint32_t x = 0; x < blocks * 4; ++x) {
+		uint32_t x = 0;
+#if defined(__SSE2__)
+		// Luma-only kernel, four pixels per step
+		const auto sharp = _mm_set1_epi32(vga.composite.sharpness);
+		for (; x + 4 <= blocks * 4; x += 4, i += 4, idx += 4) {
+			const auto im1 = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(i - 1));
+			const auto i0 = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(i));
+			const auto ip1 = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(i + 1));
+
+			const auto c = _mm_slli_epi32(i0, 4);
+			const auto d = _mm_slli_epi32(_mm_add_epi32(im1, ip1), 3);
+
+			const auto y = _mm_add_epi32(
+			        _mm_slli_epi32(_mm_add_epi32(c, d), 8),
+			        mullo_epi32_sse2(sharp, _mm_sub_epi32(c, d)));
+
+			// Replicate the grey value into the B, G, and R bytes
+			const auto g8 = clamp13_to_bytes(y);
+			const auto gg = _mm_unpacklo_epi8(g8, g8);
+			const auto g0 = _mm_unpacklo_epi8(g8, _mm_setzero_si128());
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(
+			                         TempLine + idx * sizeof(uint32_t)),
+			                 _mm_unpacklo_epi16(gg, g0));
+		}
+#endif
+		for (; x < blocks * 4; ++x) {
 			int c = (i[0] + i[0]) << 3;
 			int d = (i[-1] + i[1]) << 3;
 			int y = ((c + d) << 8) + vga.composite.sharpness * (c - d);
@@ -202,6 +354,149 @@ static uint8_t *Composite_Process(uint8_t border, uint32_t blocks, bool double_w
 			                          byte_clamp(y) * 0x10101);
 		}
 	} else {
+#if defined(__SSE2__)
+		// Whole-scanline chroma/luma kernels. The colour carrier
+		// completes one period every four pixels, so with four pixels
+		// per vector the phase is fixed per lane and the per-pixel
+		// I/Q modulation becomes constant select-and-negate masks.
+
+		// Store chroma
+		{
+			const int count = w + 2;
+			int k = 0;
+			for (; k + 4 <= count; k += 4) {
+				const int *i = temp + 4 + k;
+
+				const auto load = [](const int* p) {
+					return _mm_loadu_si128(
+					        reinterpret_cast<const __m128i*>(p));
+				};
+				const auto im4 = load(i - 4);
+				const auto im3 = load(i - 3);
+				const auto im2 = load(i - 2);
+				const auto im1 = load(i - 1);
+				const auto i0  = load(i);
+				const auto ip1 = load(i + 1);
+				const auto ip2 = load(i + 2);
+				const auto ip3 = load(i + 3);
+				const auto ip4 = load(i + 4);
+
+				const auto a = _mm_add_epi32(
+				        _mm_sub_epi32(
+				                im4,
+				                _mm_slli_epi32(
+				                        _mm_add_epi32(
+				                                _mm_sub_epi32(im2, i0),
+				                                ip2),
+				                        1)),
+				        ip4);
+				const auto b = _mm_slli_epi32(
+				        _mm_add_epi32(_mm_sub_epi32(im3, im1),
+				                      _mm_sub_epi32(ip1, ip3)),
+				        1);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(atemp + k), a);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(btemp + k), b);
+			}
+			for (; k < count; ++k) {
+				const int *i = temp + 4 + k;
+				atemp[k] = i[-4] -
+				           left_shift_signed(i[-2] - i[0] + i[2], 1) +
+				           i[4];
+				btemp[k] = left_shift_signed(
+				        i[-3] - i[-1] + i[1] - i[3], 1);
+			}
+		}
+
+		// Demodulate the composite signal in place
+		{
+			const int count = w + 2;
+			int k = 0;
+			for (; k + 4 <= count; k += 4) {
+				const auto t = _mm_loadu_si128(
+				        reinterpret_cast<const __m128i*>(temp + 4 + k));
+				const auto a = _mm_loadu_si128(
+				        reinterpret_cast<const __m128i*>(atemp + k));
+				_mm_storeu_si128(
+				        reinterpret_cast<__m128i*>(temp + 4 + k),
+				        _mm_sub_epi32(_mm_slli_epi32(t, 3), a));
+			}
+			for (; k < count; ++k) {
+				temp[4 + k] = left_shift_signed(temp[4 + k], 3) -
+				              atemp[k];
+			}
+		}
+
+		// Decode four pixels (one carrier period) per step
+		const auto sharp = _mm_set1_epi32(vga.composite.sharpness);
+		const auto vri   = _mm_set1_epi32(vga.composite.ri);
+		const auto vrq   = _mm_set1_epi32(vga.composite.rq);
+		const auto vgi   = _mm_set1_epi32(vga.composite.gi);
+		const auto vgq   = _mm_set1_epi32(vga.composite.gq);
+		const auto vbi   = _mm_set1_epi32(vga.composite.bi);
+		const auto vbq   = _mm_set1_epi32(vga.composite.bq);
+
+		// Phase tables: I = { a, -b, -a, b }, Q = { b, a, -b, -a }
+		// (lane index == pixel phase; _mm_set_epi32 lists lane 3 first)
+		const auto lane0 = _mm_set_epi32(0, 0, 0, -1);
+		const auto lane1 = _mm_set_epi32(0, 0, -1, 0);
+		const auto lane2 = _mm_set_epi32(0, -1, 0, 0);
+		const auto lane3 = _mm_set_epi32(-1, 0, 0, 0);
+
+		for (int p = 0; p < w; p += 4) {
+			const auto av = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(atemp + 1 + p));
+			const auto bv = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(btemp + 1 + p));
+
+			const auto ii = _mm_sub_epi32(
+			        _mm_or_si128(_mm_and_si128(av, lane0),
+			                     _mm_and_si128(bv, lane3)),
+			        _mm_or_si128(_mm_and_si128(bv, lane1),
+			                     _mm_and_si128(av, lane2)));
+			const auto qq = _mm_sub_epi32(
+			        _mm_or_si128(_mm_and_si128(bv, lane0),
+			                     _mm_and_si128(av, lane1)),
+			        _mm_or_si128(_mm_and_si128(bv, lane2),
+			                     _mm_and_si128(av, lane3)));
+
+			const auto im1 = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(temp + 4 + p));
+			const auto i0 = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(temp + 5 + p));
+			const auto ip1 = _mm_loadu_si128(
+			        reinterpret_cast<const __m128i*>(temp + 6 + p));
+
+			const auto c = _mm_add_epi32(i0, i0);
+			const auto d = _mm_add_epi32(im1, ip1);
+			const auto y = _mm_add_epi32(
+			        _mm_slli_epi32(_mm_add_epi32(c, d), 8),
+			        mullo_epi32_sse2(sharp, _mm_sub_epi32(c, d)));
+
+			const auto rr = _mm_add_epi32(
+			        y,
+			        _mm_add_epi32(mullo_epi32_sse2(vri, ii),
+			                      mullo_epi32_sse2(vrq, qq)));
+			const auto gg = _mm_add_epi32(
+			        y,
+			        _mm_add_epi32(mullo_epi32_sse2(vgi, ii),
+			                      mullo_epi32_sse2(vgq, qq)));
+			const auto bb = _mm_add_epi32(
+			        y,
+			        _mm_add_epi32(mullo_epi32_sse2(vbi, ii),
+			                      mullo_epi32_sse2(vbq, qq)));
+
+			const auto r8 = clamp13_to_bytes(rr);
+			const auto g8 = clamp13_to_bytes(gg);
+			const auto b8 = clamp13_to_bytes(bb);
+
+			_mm_storeu_si128(
+			        reinterpret_cast<__m128i*>(
+			                TempLine + p * sizeof(uint32_t)),
+			        _mm_unpacklo_epi16(
+			                _mm_unpacklo_epi8(b8, g8),
+			                _mm_unpacklo_epi8(r8, _mm_setzero_si128())));
+		}
+#else
 		// Store chroma
 		int *i = temp + 4;
 		int *ap = atemp + 1;
@@ -251,7 +546,12 @@ static uint8_t *Composite_Process(uint8_t border, uint32_t blocks, bool double_w
 			composite_convert(-ap[0], -bp[0]);
 			composite_convert(bp[0], -ap[0]);
 		}
+#endif
 	}
+
+	composite_total_us += static_cast<uint64_t>(GetTicksUs() - start_us);
+	++composite_num_lines;
+
 	return TempLine;
 }
 
@@ -405,6 +705,46 @@ static uint8_t* draw_unwrapped_line_from_dac_palette(Bitu vidstart,
 	return TempLine;
 }
 
+// Expand 8-bit palette-indexed pixels into 32-bit BGRX pixels via the
+// DAC palette map. This is the hot inner loop of every 256-colour mode
+// rendered through the DAC path, so provide vectorized variants picked
+// at compile time (same approach as voodoo.cpp); the scalar loop is the
+// fallback and handles the tail.
+static void expand_indexed_line(uint8_t* dst, const uint8_t* src, uint16_t num_pixels)
+{
+	constexpr auto palette_map        = vga.dac.palette_map;
+	constexpr uint8_t bytes_per_pixel = sizeof(palette_map[0]);
+
+#if defined(__AVX2__)
+	const auto pal = reinterpret_cast<const int*>(palette_map);
+	while (num_pixels >= 8) {
+		const auto indexes = _mm256_cvtepu8_epi32(
+		        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst),
+		                    _mm256_i32gather_epi32(pal, indexes, 4));
+		src += 8;
+		dst += 8 * bytes_per_pixel;
+		num_pixels -= 8;
+	}
+#elif defined(__SSE2__)
+	const auto pal = reinterpret_cast<const int*>(palette_map);
+	while (num_pixels >= 4) {
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+		                 _mm_set_epi32(pal[src[3]],
+		                               pal[src[2]],
+		                               pal[src[1]],
+		                               pal[src[0]]));
+		src += 4;
+		dst += 4 * bytes_per_pixel;
+		num_pixels -= 4;
+	}
+#endif
+	while (num_pixels--) {
+		memcpy(dst, palette_map + *src++, bytes_per_pixel);
+		dst += bytes_per_pixel;
+	}
+}
+
 static uint8_t* draw_linear_line_from_dac_palette(Bitu vidstart, Bitu /*line*/)
 {
 	const auto offset                 = vidstart & vga.draw.linear_mask;
@@ -448,38 +788,206 @@ static uint8_t* draw_linear_line_from_dac_palette(Bitu vidstart, Bitu /*line*/)
 		        vga.draw.line_length - wrapped_len);
 
 		// unwrapped chunk: to top of memory block
-		auto palette_index_end = palette_index_it +
-		                         std::min(unwrapped_len, pixels_remaining);
-		while (palette_index_it != palette_index_end) {
-			memcpy(line_addr,
-			       palette_map + *palette_index_it++,
-			       bytes_per_pixel);
-			line_addr += bytes_per_pixel;
-			--pixels_remaining;
-		}
+		const auto unwrapped_pixels = std::min(unwrapped_len,
+		                                       pixels_remaining);
+		expand_indexed_line(line_addr, palette_index_it, unwrapped_pixels);
+		line_addr += unwrapped_pixels * bytes_per_pixel;
+		pixels_remaining = check_cast<uint16_t>(pixels_remaining -
+		                                        unwrapped_pixels);
 
 		// wrapped chunk: from the base of the memory block
-		palette_index_it  = vga.draw.linear_base;
-		palette_index_end = palette_index_it +
-		                    std::min(wrapped_len, pixels_remaining);
-		while (palette_index_it != palette_index_end) {
-			memcpy(line_addr,
-			       palette_map + *palette_index_it++,
-			       bytes_per_pixel);
-			line_addr += bytes_per_pixel;
-			--pixels_remaining;
+		expand_indexed_line(line_addr,
+		                    vga.draw.linear_base,
+		                    std::min(wrapped_len, pixels_remaining));
+
+	} else {
+		expand_indexed_line(line_addr, palette_index_it, pixels_remaining);
+	}
+	return TempLine;
+}
+
+// Parallel line pipeline: for snapshot-safe modes the emulation thread
+// only memcpy's the raw source bytes of each scanline into a per-frame
+// slot and a worker thread performs the pixel conversion, change
+// detection and scaling. Modes whose line drawers read more state than
+// the linear source bytes and the DAC palette stay on the serial path.
+namespace parallel_draw {
+
+enum class LineKind : uint8_t {
+	Unchanged,   // no source data; renderer reuses its cached copy
+	Passthrough, // snapshot is already in the renderer's input format
+	DacPalette,  // 8-bit indexed snapshot, expand via dac.palette_map
+};
+
+struct LineJob {
+	LineKind kind = LineKind::Unchanged;
+	bool black    = false; // paint black (screen disabled mid-fade)
+	uint16_t slot = 0;
+};
+
+static RWQueue<LineJob> queue(SCALER_MAXHEIGHT);
+
+static std::thread worker = {};
+
+static std::mutex drained_mutex           = {};
+static std::condition_variable drained_cv = {};
+static std::atomic<int> jobs_in_flight    = 0;
+
+// Raw per-line source snapshots, lines_total slots of slot_stride bytes
+static std::vector<uint8_t> slots = {};
+static uint16_t slot_stride       = 0;
+
+// Frame-constant state decided in begin_frame()
+static bool active_this_frame  = false;
+static LineKind kind_this_frame = LineKind::Passthrough;
+
+// Conversion output buffer owned by the worker thread
+alignas(uint32_t) static std::array<uint8_t, max_line_bytes> worker_line = {};
+
+// Copy the raw source bytes for the line at 'vidstart' into 'dst',
+// unwrapping across the end of the linear region like the drawers do
+static void snapshot_source_line(const Bitu vidstart, uint8_t* dst,
+                                 const uint16_t num_bytes)
+{
+	const auto mask   = vga.draw.linear_mask;
+	const auto offset = vidstart & mask;
+
+	if (GCC_UNLIKELY((offset + num_bytes) & ~mask)) {
+		const auto end           = (offset + num_bytes) & mask;
+		const auto wrapped_len   = end & 0xFFF;
+		const auto unwrapped_len = num_bytes - wrapped_len;
+		memcpy(dst, vga.draw.linear_base + offset, unwrapped_len);
+		memcpy(dst + unwrapped_len, vga.draw.linear_base, wrapped_len);
+	} else {
+		memcpy(dst, vga.draw.linear_base + offset, num_bytes);
+	}
+}
+
+static void expand_dac_palette_line(const uint8_t* src, const uint16_t num_pixels)
+{
+	expand_indexed_line(worker_line.data(), src, num_pixels);
+}
+
+static void worker_loop()
+{
+	while (auto job = queue.Dequeue()) {
+		switch (job->kind) {
+		case LineKind::Unchanged: RENDER_DrawLine(nullptr); break;
+
+		case LineKind::Passthrough:
+			RENDER_DrawLine(&slots[job->slot * slot_stride]);
+			break;
+
+		case LineKind::DacPalette:
+			if (GCC_UNLIKELY(job->black)) {
+				memset(worker_line.data(),
+				       0,
+				       slot_stride * sizeof(uint32_t));
+			} else {
+				expand_dac_palette_line(&slots[job->slot * slot_stride],
+				                        slot_stride);
+			}
+			RENDER_DrawLine(worker_line.data());
+			break;
 		}
+		if (jobs_in_flight.fetch_sub(1) == 1) {
+			std::lock_guard<std::mutex> lock(drained_mutex);
+			drained_cv.notify_all();
+		}
+	}
+}
+
+// Block until the worker has presented all queued lines. Must be called
+// before ending the render update and before mutating any state the
+// worker reads (scaler setup, DAC palette).
+static void drain()
+{
+	if (!worker.joinable() || jobs_in_flight == 0) {
+		return;
+	}
+	std::unique_lock<std::mutex> lock(drained_mutex);
+	drained_cv.wait(lock, [] { return jobs_in_flight == 0; });
+}
+
+// Decide once per frame if the active line drawer can run off-thread
+static void begin_frame()
+{
+	active_this_frame = false;
+
+	// Only worthwhile with a core to spare for the worker
+	static const bool have_spare_core = std::thread::hardware_concurrency() > 2;
+	if (!have_spare_core) {
+		return;
+	}
+	if (vga.draw.mode != PART || vga.draw.vga_override) {
+		return;
+	}
+	// The mixer composes over lines as they are drawn; stay serial
+	if (GCC_UNLIKELY(ReelMagic_IsVideoMixerEnabled())) {
+		return;
+	}
 
+	if (VGA_DrawLine == VGA_Draw_Linear_Line) {
+		kind_this_frame = LineKind::Passthrough;
+		slot_stride = check_cast<uint16_t>(vga.draw.line_length);
+	} else if (VGA_DrawLine == draw_linear_line_from_dac_palette) {
+		kind_this_frame = LineKind::DacPalette;
+		slot_stride = check_cast<uint16_t>(vga.draw.line_length /
+		                                   sizeof(uint32_t));
 	} else {
-		auto palette_index_end = palette_index_it + pixels_remaining;
-		while (palette_index_it != palette_index_end) {
-			memcpy(line_addr,
-			       palette_map + *palette_index_it++,
-			       bytes_per_pixel);
-			line_addr += bytes_per_pixel;
+		return;
+	}
+	if (!slot_stride || !vga.draw.lines_total) {
+		return;
+	}
+	slots.resize(static_cast<size_t>(vga.draw.lines_total) * slot_stride);
+
+	if (!worker.joinable()) {
+		worker = std::thread(worker_loop);
+		set_thread_name(worker, "dosbox:vgaline");
+	}
+	active_this_frame = true;
+}
+
+// Snapshot the current scanline and hand it to the worker
+static void enqueue_line()
+{
+	LineJob job = {};
+	if (is_clean_line() && render.updating && !render.fullFrame) {
+		job.kind = LineKind::Unchanged;
+	} else {
+		job.kind = kind_this_frame;
+		job.slot = check_cast<uint16_t>(vga.draw.lines_done);
+
+		job.black = (kind_this_frame == LineKind::DacPalette) &&
+		            vga.seq.clocking_mode.is_screen_disabled;
+		if (!job.black) {
+			snapshot_source_line(vga.draw.address,
+			                     &slots[job.slot * slot_stride],
+			                     slot_stride);
 		}
 	}
-	return TempLine;
+	++jobs_in_flight;
+	queue.Enqueue(std::move(job));
+}
+
+// Join the worker on shutdown, after the queue stops producing
+struct WorkerGuard {
+	~WorkerGuard()
+	{
+		queue.Stop();
+		if (worker.joinable()) {
+			worker.join();
+		}
+	}
+};
+static WorkerGuard worker_guard = {};
+
+} // namespace parallel_draw
+
+void VGA_ParallelDrawSync()
+{
+	parallel_draw::drain();
 }
 
 enum CursorOp : uint8_t {
@@ -707,20 +1215,138 @@ static bool SkipCursor(Bitu vidstart, Bitu line)
 }
 
 static uint32_t FontMask[2]={0xffffffff,0x0};
+
+// Rendered-glyph cache for the text mode line drawers. Each entry holds the
+// expanded pixel rows of one (character, attribute) pair, validated lazily
+// per scanline against a generation counter. Font RAM writes bump the
+// generation via VGA_InvalidateTextGlyphCache(); per-frame state the baked
+// pixels depend on (blink phase, palette, underline row) is folded into a
+// stamp that is checked on every drawn line. Static text screens - the
+// common case - then assemble each scanline with small row copies instead
+// of re-expanding the font bitmaps for every cell.
+
+constexpr uint8_t max_glyph_lines = 32; // font RAM stores 32 bytes per glyph
+constexpr uint32_t num_glyph_slots = 256 * 256; // (character, attribute) pairs
+
+// For the 8-bpp drawer: eight one-byte pixels per row
+struct TextGlyph8 {
+	uint32_t generation  = 0;
+	uint32_t valid_lines = 0; // bit n set once rows[n] holds pixels
+	alignas(uint32_t) uint8_t rows[max_glyph_lines][8] = {};
+};
+
+// For the DAC-palette drawer: up to nine 32-bit pixels per row
+struct TextGlyph32 {
+	uint32_t generation  = 0;
+	uint32_t valid_lines = 0;
+	uint32_t rows[max_glyph_lines][9] = {};
+};
+
+static std::vector<std::unique_ptr<TextGlyph8>> glyph_cache_8 = {};
+static std::vector<std::unique_ptr<TextGlyph32>> glyph_cache_32 = {};
+
+// Generation zero is reserved so that freshly allocated entries start stale
+static uint32_t glyph_generation = 1;
+
+void VGA_InvalidateTextGlyphCache()
+{
+	if (GCC_UNLIKELY(++glyph_generation == 0)) {
+		// Counter wrapped; drop the entries so stale generations
+		// can't alias the restarted count
+		glyph_cache_8.clear();
+		glyph_cache_32.clear();
+		glyph_generation = 1;
+	}
+}
+
+// Invalidates the cache whenever the folded drawing state changes
+static void check_glyph_cache_stamp(const uint32_t stamp)
+{
+	static uint32_t last_stamp = 0;
+	if (stamp != last_stamp) {
+		last_stamp = stamp;
+		VGA_InvalidateTextGlyphCache();
+	}
+}
+
+// Folds the state baked into the DAC-palette drawer's cached pixels
+static uint32_t dac_text_state_stamp()
+{
+	uint32_t stamp = vga.draw.blink ? 1u : 0u;
+	stamp = (stamp << 1) | (vga.draw.blinking ? 1u : 0u);
+	stamp = (stamp << 1) | (vga.seq.clocking_mode.is_eight_dot_mode ? 1u : 0u);
+	stamp = (stamp << 1) |
+	        (vga.attr.mode_control.is_line_graphics_enabled ? 1u : 0u);
+	stamp = (stamp << 5) | (vga.crtc.underline_location & 0x1f);
+	// Text mode only uses the first 16 palette map entries
+	for (uint8_t i = 0; i < 16; ++i) {
+		stamp = stamp * 31 +
+		        static_cast<uint32_t>(vga.dac.palette_map[i]);
+	}
+	return stamp;
+}
+
+static TextGlyph8& get_glyph8(const uint8_t chr, const uint8_t attr)
+{
+	if (GCC_UNLIKELY(glyph_cache_8.empty())) {
+		glyph_cache_8.resize(num_glyph_slots);
+	}
+	auto& entry = glyph_cache_8[chr * 256 + attr];
+	if (GCC_UNLIKELY(!entry)) {
+		entry = std::make_unique<TextGlyph8>();
+	}
+	if (entry->generation != glyph_generation) {
+		entry->generation  = glyph_generation;
+		entry->valid_lines = 0;
+	}
+	return *entry;
+}
+
+static TextGlyph32& get_glyph32(const uint8_t chr, const uint8_t attr)
+{
+	if (GCC_UNLIKELY(glyph_cache_32.empty())) {
+		glyph_cache_32.resize(num_glyph_slots);
+	}
+	auto& entry = glyph_cache_32[chr * 256 + attr];
+	if (GCC_UNLIKELY(!entry)) {
+		entry = std::make_unique<TextGlyph32>();
+	}
+	if (entry->generation != glyph_generation) {
+		entry->generation  = glyph_generation;
+		entry->valid_lines = 0;
+	}
+	return *entry;
+}
+
 static uint8_t *VGA_TEXT_Draw_Line(Bitu vidstart, Bitu line)
 {
-	uint16_t i = 0;
+	// The blink mask is baked into the cached rows, so a phase flip
+	// must start a new generation (bit 16 tags this drawer's stamp)
+	check_glyph_cache_stamp((1u << 16) | (FontMask[1] & 1));
+
 	const uint8_t* vidmem = VGA_Text_Memwrap(vidstart);
+	uint8_t* draw         = TempLine;
 	for (Bitu cx = 0; cx < vga.draw.blocks; ++cx) {
-		Bitu chr=vidmem[cx*2];
-		Bitu col=vidmem[cx*2+1];
-		Bitu font=vga.draw.font_tables[(col >> 3)&1][chr*32+line];
-		uint32_t mask1=TXT_Font_Table[font>>4] & FontMask[col >> 7];
-		uint32_t mask2=TXT_Font_Table[font&0xf] & FontMask[col >> 7];
-		uint32_t fg=TXT_FG_Table[col&0xf];
-		uint32_t bg=TXT_BG_Table[col>>4];
-		write_unaligned_uint32_at(TempLine, i++, (fg & mask1) | (bg & ~mask1));
-		write_unaligned_uint32_at(TempLine, i++, (fg & mask2) | (bg & ~mask2));
+		const uint8_t chr = vidmem[cx * 2];
+		const uint8_t col = vidmem[cx * 2 + 1];
+		auto& glyph = get_glyph8(chr, col);
+		if (!(glyph.valid_lines & (1u << line))) {
+			const Bitu font = vga.draw.font_tables[(col >> 3) & 1]
+			                                      [chr * 32 + line];
+			const uint32_t mask1 = TXT_Font_Table[font >> 4] &
+			                       FontMask[col >> 7];
+			const uint32_t mask2 = TXT_Font_Table[font & 0xf] &
+			                       FontMask[col >> 7];
+			const uint32_t fg = TXT_FG_Table[col & 0xf];
+			const uint32_t bg = TXT_BG_Table[col >> 4];
+			write_unaligned_uint32_at(glyph.rows[line], 0,
+			                          (fg & mask1) | (bg & ~mask1));
+			write_unaligned_uint32_at(glyph.rows[line], 1,
+			                          (fg & mask2) | (bg & ~mask2));
+			glyph.valid_lines |= (1u << line);
+		}
+		memcpy(draw, glyph.rows[line], sizeof(glyph.rows[line]));
+		draw += sizeof(glyph.rows[line]);
 	}
 	if (SkipCursor(vidstart, line))
 		return TempLine;
@@ -792,6 +1418,10 @@ static uint8_t *VGA_TEXT_Herc_Draw_Line(Bitu vidstart, Bitu line)
 // combined 8/9-dot wide text mode line drawing function
 static uint8_t* draw_text_line_from_dac_palette(Bitu vidstart, Bitu line)
 {
+	// The cached rows bake in the palette, blink phase, underline row,
+	// and dot width; a change in any of them starts a new generation
+	check_glyph_cache_stamp(dac_text_state_stamp());
+
 	// pointer to chars+attribs
 	const uint8_t* vidmem  = VGA_Text_Memwrap(vidstart);
 	const auto palette_map = vga.dac.palette_map;
@@ -806,58 +1436,69 @@ static uint8_t* draw_text_line_from_dac_palette(Bitu vidstart, Bitu line)
 	// the console text right (and vice-versa)
 	const uint16_t draw_idx_start = 8 + vga.draw.panning;
 
-	// This holds the to-be-written pixel offset, and is incremented per
-	// pixel and also per character block.
-	auto draw_idx = draw_idx_start;
+	const uint8_t dots_per_block = vga.seq.clocking_mode.is_eight_dot_mode ? 8 : 9;
+	const auto bytes_per_block = dots_per_block * sizeof(uint32_t);
+
+	auto draw = TempLine + draw_idx_start * sizeof(uint32_t);
 
 	while (blocks--) { // for each character in the line
 		const auto chr  = *vidmem++;
 		const auto attr = *vidmem++;
-		// the font pattern
-		uint16_t font = vga.draw.font_tables[(attr >> 3) & 1][(chr << 5) + line];
-
-		uint8_t bg_palette_idx = attr >> 4;
-		// if blinking is enabled bit7 is not mapped to attributes
-		if (vga.draw.blinking) {
-			bg_palette_idx &= ~0x8;
-		}
-		// choose foreground color if blinking not set for this cell or
-		// blink on
-		const uint8_t fg_palette_idx = (vga.draw.blink || (attr & 0x80) == 0)
-		                                     ? (attr & 0xf)
-		                                     : bg_palette_idx;
-
-		// underline: all foreground [freevga: 0x77, previous 0x7]
-		if (GCC_UNLIKELY(((attr&0x77) == 0x01) &&
-			(vga.crtc.underline_location&0x1f)==line))
-			bg_palette_idx = fg_palette_idx;
-
-		// The font's bits will indicate which color is used per pixel
-		const auto fg_colour = palette_map[fg_palette_idx];
-		const auto bg_colour = palette_map[bg_palette_idx];
-
-		if (vga.seq.clocking_mode.is_eight_dot_mode) {
-			for (auto n = 0; n < 8; ++n) {
-				const auto color = (font & 0x80) ? fg_colour
-				                                 : bg_colour;
-				write_unaligned_uint32_at(TempLine, draw_idx++, color);
-				font <<= 1;
-			}
-		} else {
-			font <<= 1; // 9 pixels
-			// Extend to the 9th pixel if needed
-			if ((font & 0x2) &&
-			    vga.attr.mode_control.is_line_graphics_enabled &&
-			    (chr >= 0xc0) && (chr <= 0xdf)) {
-				font |= 1;
+
+		auto& glyph = get_glyph32(chr, attr);
+		if (!(glyph.valid_lines & (1u << line))) {
+			// the font pattern
+			uint16_t font = vga.draw.font_tables[(attr >> 3) & 1]
+			                                    [(chr << 5) + line];
+
+			uint8_t bg_palette_idx = attr >> 4;
+			// if blinking is enabled bit7 is not mapped to attributes
+			if (vga.draw.blinking) {
+				bg_palette_idx &= ~0x8;
 			}
-			for (auto n = 0; n < 9; ++n) {
-				const auto color = (font & 0x100) ? fg_colour
-				                                  : bg_colour;
-				write_unaligned_uint32_at(TempLine, draw_idx++, color);
-				font <<= 1;
+			// choose foreground color if blinking not set for this
+			// cell or blink on
+			const uint8_t fg_palette_idx =
+			        (vga.draw.blink || (attr & 0x80) == 0)
+			                ? (attr & 0xf)
+			                : bg_palette_idx;
+
+			// underline: all foreground [freevga: 0x77, previous 0x7]
+			if (GCC_UNLIKELY(((attr&0x77) == 0x01) &&
+				(vga.crtc.underline_location&0x1f)==line))
+				bg_palette_idx = fg_palette_idx;
+
+			// The font's bits will indicate which color is used
+			// per pixel
+			const auto fg_colour = palette_map[fg_palette_idx];
+			const auto bg_colour = palette_map[bg_palette_idx];
+
+			if (vga.seq.clocking_mode.is_eight_dot_mode) {
+				for (auto n = 0; n < 8; ++n) {
+					glyph.rows[line][n] = (font & 0x80)
+					                            ? fg_colour
+					                            : bg_colour;
+					font <<= 1;
+				}
+			} else {
+				font <<= 1; // 9 pixels
+				// Extend to the 9th pixel if needed
+				if ((font & 0x2) &&
+				    vga.attr.mode_control.is_line_graphics_enabled &&
+				    (chr >= 0xc0) && (chr <= 0xdf)) {
+					font |= 1;
+				}
+				for (auto n = 0; n < 9; ++n) {
+					glyph.rows[line][n] = (font & 0x100)
+					                            ? fg_colour
+					                            : bg_colour;
+					font <<= 1;
+				}
 			}
+			glyph.valid_lines |= (1u << line);
 		}
+		memcpy(draw, glyph.rows[line], bytes_per_block);
+		draw += bytes_per_block;
 	}
 	// draw the text mode cursor if needed
 	if (!SkipCursor(vidstart, line)) {
@@ -877,7 +1518,7 @@ static uint8_t* draw_text_line_from_dac_palette(Bitu vidstart, Bitu line)
 
 			auto draw_addr = &TempLine[cursor_draw_offset];
 
-			draw_idx = draw_idx_start;
+			auto draw_idx = draw_idx_start;
 			for (uint8_t n = 0; n < 8; ++n) {
 				write_unaligned_uint32_at(draw_addr, draw_idx++, fg_colour);
 			}
@@ -925,6 +1566,7 @@ static void VGA_ProcessSplit()
 static uint8_t bg_color_index = 0; // screen-off black index
 static void VGA_DrawSingleLine(uint32_t /*blah*/)
 {
+	VGA_ATTR_FlushPaletteUpdates();
 	if (GCC_UNLIKELY(vga.attr.disabled)) {
 		switch(machine) {
 		case MCH_PCJR:
@@ -1004,7 +1646,7 @@ static void VGA_DrawSingleLine(uint32_t /*blah*/)
 			}
 		}
 		ReelMagic_RENDER_DrawLine(TempLine);
-	} else {
+	} else if (!skip_clean_line()) {
 		uint8_t * data=VGA_DrawLine( vga.draw.address, vga.draw.address_line );
 		ReelMagic_RENDER_DrawLine(data);
 	}
@@ -1023,10 +1665,11 @@ static void VGA_DrawSingleLine(uint32_t /*blah*/)
 
 static void VGA_DrawEGASingleLine(uint32_t /*blah*/)
 {
+	VGA_ATTR_FlushPaletteUpdates();
 	if (GCC_UNLIKELY(vga.attr.disabled)) {
 		std::fill(templine_buffer.begin(), templine_buffer.end(), 0);
 		ReelMagic_RENDER_DrawLine(TempLine);
-	} else {
+	} else if (!skip_clean_line()) {
 		Bitu address = vga.draw.address;
 		if (vga.mode!=M_TEXT) address += vga.draw.panning;
 		uint8_t * data=VGA_DrawLine(address, vga.draw.address_line );
@@ -1047,9 +1690,16 @@ static void VGA_DrawEGASingleLine(uint32_t /*blah*/)
 
 static void VGA_DrawPart(uint32_t lines)
 {
+	ZoneScoped;
+	VGA_ATTR_FlushPaletteUpdates();
 	while (lines--) {
-		uint8_t * data=VGA_DrawLine( vga.draw.address, vga.draw.address_line );
-		ReelMagic_RENDER_DrawLine(data);
+		if (parallel_draw::active_this_frame) {
+			parallel_draw::enqueue_line();
+		} else if (!skip_clean_line()) {
+			uint8_t* data = VGA_DrawLine(vga.draw.address,
+			                             vga.draw.address_line);
+			ReelMagic_RENDER_DrawLine(data);
+		}
 		++vga.draw.address_line;
 		if (vga.draw.address_line>=vga.draw.address_line_total) {
 			vga.draw.address_line=0;
@@ -1075,10 +1725,53 @@ static void VGA_DrawPart(uint32_t lines)
 #ifdef VGA_KEEP_CHANGES
 		VGA_ChangesEnd();
 #endif
+		parallel_draw::drain();
 		RENDER_EndUpdate(false);
 	}
 }
 
+// Number of consecutive frames without mid-frame palette or display start
+// writes before the per-part draw events are collapsed into a single
+// whole-frame event
+constexpr uint32_t QuietFramesBeforeWholeFrame = 8;
+
+void VGA_NotifyMidFrameChange()
+{
+	// Only writes landing during the active display period matter; writes
+	// during the vertical blank are the well-behaved way to update these
+	// registers and must not be penalised.
+	const auto is_mid_frame = (vga.draw.mode == PART && vga.draw.parts_left &&
+	                           vga.draw.lines_done < vga.draw.lines_total);
+	if (!is_mid_frame) {
+		return;
+	}
+	vga.draw.quiet_frame_count = 0;
+
+	if (!vga.draw.whole_frame_active) {
+		return;
+	}
+	vga.draw.whole_frame_active = false;
+
+	// A whole-frame event is still pending: catch up to the current beam
+	// position now so the lines above it are drawn with the old register
+	// state, then finish the frame in fine parts.
+	PIC_RemoveEvents(VGA_DrawPart);
+
+	const auto time_in_frame = std::max(
+	        0.0, PIC_FullIndex() - vga.draw.delay.framestart);
+
+	const auto lines_elapsed = std::min(
+	        static_cast<uint32_t>(time_in_frame / vga.draw.delay.per_line_ms),
+	        vga.draw.lines_total);
+
+	assert(vga.draw.parts_lines > 0);
+	vga.draw.parts_left = (vga.draw.lines_total - lines_elapsed) /
+	                              vga.draw.parts_lines +
+	                      1;
+
+	VGA_DrawPart(lines_elapsed - vga.draw.lines_done);
+}
+
 void VGA_SetBlinking(const uint8_t enabled)
 {
 	LOG(LOG_VGA, LOG_NORMAL)("Blinking %u", enabled);
@@ -1148,8 +1841,70 @@ static void VGA_PanningLatch(uint32_t /*val*/)
 	vga.draw.panning = vga.config.pel_panning;
 }
 
+// Latch the dirty-VRAM window for the coming frame and re-arm the
+// accumulator. Conservatively falls back to a full redraw whenever the
+// output can change without a corresponding memory write.
+static void latch_dirty_vram_window()
+{
+	static Bitu last_address     = 0;
+	static uint16_t last_panning = 0;
+	static bool last_blink       = false;
+	static uint8_t last_disabled = 0;
+	static VGA_HWCURSOR last_hgc = {};
+
+	bool all = vga.dirty.all || !vga.dirty.handled_writes;
+
+	// Scrolling, page flips, panning, blink phase and blanking all
+	// change the picture without touching video memory
+	if (vga.draw.address != last_address ||
+	    vga.draw.panning != last_panning || vga.draw.blink != last_blink ||
+	    vga.attr.disabled != last_disabled) {
+		all = true;
+	}
+	last_address  = vga.draw.address;
+	last_panning  = vga.draw.panning;
+	last_blink    = vga.draw.blink;
+	last_disabled = vga.attr.disabled;
+
+	// An active split restarts drawing from address zero mid-frame
+	if (vga.draw.split_line < vga.draw.lines_total) {
+		all = true;
+	}
+	// The video mixer composes MPEG data over the VGA frame
+	if (GCC_UNLIKELY(ReelMagic_IsVideoMixerEnabled())) {
+		all = true;
+	}
+	// The hardware cursor is composed over the frame at draw time, so
+	// any change to it has to repaint the lines it covered
+	if (memcmp(&vga.s3.hgc, &last_hgc, sizeof(last_hgc)) != 0) {
+		last_hgc = vga.s3.hgc;
+		all      = true;
+	}
+	// The text cursor repaints its cell every frame without a write
+	if (vga.mode == M_TEXT) {
+		VGA_MarkVramDirty(static_cast<uint32_t>(vga.draw.cursor.address), 4);
+	}
+
+	dirty_window.valid = !all;
+	dirty_window.first = vga.dirty.first;
+	dirty_window.last  = vga.dirty.last;
+
+	vga.dirty.first = UINT32_MAX;
+	vga.dirty.last  = 0;
+	vga.dirty.all   = false;
+
+	// Harvest the pages that were opened for direct writes this frame so
+	// the next write to them is seen again
+	VGA_RearmWriteCombinedPages();
+}
+
 static void VGA_VerticalTimer(uint32_t /*val*/)
 {
+	// One emulated frame per vertical total, as opposed to the unnamed
+	// host-side FrameMark in sdlmain; the two rates differ whenever the
+	// DOS refresh rate and the host present rate do
+	FrameMarkNamed("DOS frame");
+
 	vga.draw.delay.framestart = PIC_FullIndex();
 	PIC_AddEvent(VGA_VerticalTimer, vga.draw.delay.vtotal);
 
@@ -1188,6 +1943,11 @@ static void VGA_VerticalTimer(uint32_t /*val*/)
 	//Check if we can actually render, else skip the rest (frameskip)
 	++vga.draw.cursor.count; // Do this here, else the cursor speed depends
 	                         // on the frameskip
+	if (DOSBOX_IsFastForwardMode()) {
+		// Skip all line rendering; the timing events scheduled above
+		// keep the card's register and interrupt state advancing
+		return;
+	}
 	if (vga.draw.vga_override || !ReelMagic_RENDER_StartUpdate()) {
 		return;
 	}
@@ -1297,17 +2057,37 @@ static void VGA_VerticalTimer(uint32_t /*val*/)
 		vga.draw.address += vga.draw.address_add * vga.draw.vblank_skip / vga.draw.address_line_total;
 	}
 
+	latch_dirty_vram_window();
+	parallel_draw::begin_frame();
+
 	// add the draw event
 	switch (vga.draw.mode) {
 	case PART:
 		if (GCC_UNLIKELY(vga.draw.parts_left)) {
 			LOG(LOG_VGAMISC, LOG_NORMAL)("Parts left: %u", vga.draw.parts_left);
 			PIC_RemoveEvents(VGA_DrawPart);
+			parallel_draw::drain();
 			RENDER_EndUpdate(true);
 		}
 		vga.draw.lines_done = 0;
-		vga.draw.parts_left = vga.draw.parts_total;
-		PIC_AddEvent(VGA_DrawPart, vga.draw.delay.parts + draw_skip, vga.draw.parts_lines);
+		if (!vga.draw.whole_frame_active &&
+		    ++vga.draw.quiet_frame_count >= QuietFramesBeforeWholeFrame) {
+			vga.draw.whole_frame_active = true;
+		}
+		if (vga.draw.whole_frame_active) {
+			// No raster effects observed recently, so draw the
+			// frame in a single event at the end of the active
+			// display period instead of one event per part
+			vga.draw.parts_left = 1;
+			PIC_AddEvent(VGA_DrawPart,
+			             vga.draw.delay.vdend + draw_skip,
+			             vga.draw.lines_total);
+		} else {
+			vga.draw.parts_left = vga.draw.parts_total;
+			PIC_AddEvent(VGA_DrawPart,
+			             vga.draw.delay.parts + draw_skip,
+			             vga.draw.parts_lines);
+		}
 		break;
 	case DRAWLINE:
 	case EGALINE:
@@ -1446,6 +2226,10 @@ static void setup_line_drawing_delays(const uint32_t total_lines)
 
 	vga.draw.delay.parts = vga.draw.delay.vdend / vga.draw.parts_total;
 
+	// Re-learn whether the new mode exhibits raster effects
+	vga.draw.whole_frame_active = false;
+	vga.draw.quiet_frame_count  = 0;
+
 	assert(total_lines > 0 && total_lines <= SCALER_MAXHEIGHT);
 	vga.draw.lines_total = total_lines;
 
@@ -2927,6 +3711,8 @@ void VGA_SetupDrawing(uint32_t /*val*/)
 		vga.draw.lines_scaled = image_info.forced_single_scan ? 2 : 1;
 
 		if (!vga.draw.vga_override) {
+			// The worker must not touch the scalers mid-resize
+			parallel_draw::drain();
 			ReelMagic_RENDER_SetSize(image_info, fps);
 		}
 
@@ -2945,6 +3731,7 @@ void VGA_KillDrawing(void) {
 	PIC_RemoveEvents(VGA_DrawEGASingleLine);
 	vga.draw.parts_left = 0;
 	vga.draw.lines_done = ~0;
+	parallel_draw::drain();
 	if (!vga.draw.vga_override) RENDER_EndUpdate(true);
 }
 
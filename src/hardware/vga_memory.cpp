@@ -55,7 +55,10 @@
 #define MEM_CHANGED( _MEM ) vga.changes.map[ (_MEM) >> VGA_CHANGE_SHIFT ] |= vga.changes.writeMask;
 //#define MEM_CHANGED( _MEM ) vga.changes.map[ (_MEM) >> VGA_CHANGE_SHIFT ] = 1;
 #else
-#define MEM_CHANGED( _MEM ) 
+// Feed the dirty-VRAM range used by vga_draw.cpp to skip unchanged
+// scanlines. Wide writes only report their base address, so mark a
+// small conservative span per write.
+#define MEM_CHANGED( _MEM ) VGA_MarkVramDirty( _MEM, 8 );
 #endif
 
 #define TANDY_VIDBASE(_X_)  &MemBase[ 0x80000 + (_X_)]
@@ -549,9 +552,12 @@ public:
 		
 		if (GCC_LIKELY(vga.seq.map_mask == 0x4)) {
 			vga.draw.font[addr] = val;
+			VGA_InvalidateTextGlyphCache();
 		} else {
-			if (vga.seq.map_mask & 0x4) // font map
+			if (vga.seq.map_mask & 0x4) { // font map
 				vga.draw.font[addr] = val;
+				VGA_InvalidateTextGlyphCache();
+			}
 			if (vga.seq.map_mask & 0x2) // character attribute
 				vga.mem.linear[CHECKED3(vga.svga.bank_read_full +
 				                        addr + 1)] = val;
@@ -576,6 +582,181 @@ public:
 	}
 };
 
+// Linear pages that have been handed a direct TLB write mapping by the
+// write-combining handlers below; re-protected at each vertical retrace
+static std::vector<uint32_t> write_combined_pages = {};
+
+// Map the page straight into the TLB so the remaining writes of this frame
+// bypass the handler, and queue it for re-protection at the next retrace.
+// PAGING_LinkPage only hands out a direct write mapping when the handler
+// advertises PFLAG_WRITEABLE, so advertise it for the duration of the call.
+static void open_page_for_writes(PageHandler* handler, const PhysPt lin_addr)
+{
+	const auto lin_page = static_cast<uint32_t>(lin_addr >> 12);
+	const auto phys_page = static_cast<uint32_t>(
+	        PAGING_GetPhysicalAddress(lin_addr) >> 12);
+
+	handler->flags |= PFLAG_WRITEABLE;
+	PAGING_LinkPage(lin_page, phys_page);
+	handler->flags &= ~PFLAG_WRITEABLE;
+
+	write_combined_pages.push_back(lin_page);
+}
+
+void VGA_RearmWriteCombinedPages(void)
+{
+	for (const auto lin_page : write_combined_pages) {
+		PAGING_UnlinkPages(lin_page, 1);
+	}
+	write_combined_pages.clear();
+}
+
+// Set when guest writes have gone straight to the packed vga.fastmem shadow
+// and the planar copy in vga.mem.linear no longer matches it, along with
+// the end of the packed region touched so far
+static bool chained_shadow_stale = false;
+static Bitu chained_shadow_top = 0;
+
+// Rebuild the planar copy from the packed shadow. Deliberately lazy: it only
+// runs when the memory model changes, e.g. when a game switches from Mode
+// 13h to unchained Mode X addressing or to another video mode.
+static void sync_chained_shadow(void)
+{
+	if (!chained_shadow_stale) {
+		return;
+	}
+	chained_shadow_stale = false;
+	for (Bitu addr = 0; addr < chained_shadow_top; ++addr) {
+		vga.mem.linear[((addr & ~3u) << 2) + (addr & 3u)] = vga.fastmem[addr];
+	}
+	chained_shadow_top = 0;
+}
+
+// Pure Mode 13h specialization of the chained VGA handler: the renderer
+// reads the packed vga.fastmem shadow in this configuration, so guest pages
+// are mapped straight onto it and the planar copy in vga.mem.linear is only
+// reconciled when a register changes the memory model (sync_chained_shadow).
+// The first write to a clean page traps once, marks the page dirty and opens
+// it for direct writes until the next retrace. The first page always stays
+// trapped because writes below offset 320 have to be replicated past the
+// 64 KiB wrap for the renderer.
+class VGA_ChainedVGAFast_Handler final : public PageHandler {
+public:
+	VGA_ChainedVGAFast_Handler() {
+		flags=PFLAG_READABLE|PFLAG_NOCODE;
+	}
+	HostPt GetHostReadPt(Bitu phys_page) override {
+		phys_page-=vgapages.base;
+		return &vga.fastmem[CHECKED(vga.svga.bank_read_full+phys_page*4096)];
+	}
+	HostPt GetHostWritePt(Bitu phys_page) override {
+		phys_page-=vgapages.base;
+		return &vga.fastmem[CHECKED(vga.svga.bank_write_full+phys_page*4096)];
+	}
+
+	void writeb(PhysPt addr, uint8_t val) override
+	{
+		const auto lin_addr = addr;
+		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
+		addr += vga.svga.bank_write_full;
+		addr = CHECKED(addr);
+		VGA_ChainedVGA_Handler::writeCache_byte(addr, val);
+		mark_and_open(lin_addr, addr);
+	}
+
+	void writew(PhysPt addr, uint16_t val) override
+	{
+		const auto lin_addr = addr;
+		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
+		addr += vga.svga.bank_write_full;
+		addr = CHECKED(addr);
+		VGA_ChainedVGA_Handler::writeCache_word(addr, val);
+		mark_and_open(lin_addr, addr);
+	}
+
+	void writed(PhysPt addr, uint32_t val) override
+	{
+		const auto lin_addr = addr;
+		addr = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
+		addr += vga.svga.bank_write_full;
+		addr = CHECKED(addr);
+		VGA_ChainedVGA_Handler::writeCache_dword(addr, val);
+		mark_and_open(lin_addr, addr);
+	}
+
+private:
+	void mark_and_open(const PhysPt lin_addr, const PhysPt offset)
+	{
+		chained_shadow_stale = true;
+
+		// Anything in the page may be written once it's been opened
+		const Bitu page_end = (offset & ~0xfffu) + 4096;
+		if (page_end > chained_shadow_top) {
+			chained_shadow_top = page_end;
+		}
+
+		if (offset >= 4096) {
+			VGA_MarkVramDirty(offset & ~0xfffu, 4096);
+			open_page_for_writes(this, lin_addr);
+		} else {
+			MEM_CHANGED(offset);
+		}
+	}
+};
+
+// Banked-window variant of VGA_Map_Handler for modes that need no format
+// translation: the first write to a clean page traps here, marks the whole
+// page dirty and opens it for direct writes until the next retrace, so the
+// per-write handler cost is paid once per page per frame.
+class VGA_MapDirty_Handler final : public PageHandler {
+public:
+	VGA_MapDirty_Handler() {
+		flags=PFLAG_READABLE|PFLAG_NOCODE;
+	}
+	HostPt GetHostReadPt(Bitu phys_page) override {
+		phys_page-=vgapages.base;
+		return &vga.mem.linear[CHECKED3(vga.svga.bank_read_full+phys_page*4096)];
+	}
+	HostPt GetHostWritePt(Bitu phys_page) override {
+		phys_page-=vgapages.base;
+		return &vga.mem.linear[CHECKED3(vga.svga.bank_write_full+phys_page*4096)];
+	}
+
+	void writeb(PhysPt addr, uint8_t val) override
+	{
+		const auto offset = to_offset(addr);
+		host_writeb(&vga.mem.linear[offset], val);
+		mark_and_open(addr, offset);
+	}
+
+	void writew(PhysPt addr, uint16_t val) override
+	{
+		const auto offset = to_offset(addr);
+		host_writew_at(vga.mem.linear, offset, val);
+		mark_and_open(addr, offset);
+	}
+
+	void writed(PhysPt addr, uint32_t val) override
+	{
+		const auto offset = to_offset(addr);
+		host_writed_at(vga.mem.linear, offset, val);
+		mark_and_open(addr, offset);
+	}
+
+private:
+	static Bitu to_offset(const PhysPt addr)
+	{
+		const auto masked = PAGING_GetPhysicalAddress(addr) & vgapages.mask;
+		return CHECKED(masked + vga.svga.bank_write_full);
+	}
+
+	void mark_and_open(const PhysPt addr, const Bitu offset)
+	{
+		VGA_MarkVramDirty(static_cast<uint32_t>(offset & ~0xfffu), 4096);
+		open_page_for_writes(this, addr);
+	}
+};
+
 class VGA_Changes_Handler final : public PageHandler {
 public:
 	VGA_Changes_Handler() {
@@ -745,6 +926,56 @@ public:
 	}
 };
 
+// Write-combining variant of VGA_LFB_Handler: reads are always mapped
+// directly, while the first write to a clean page traps once, marks the
+// page dirty and opens it for direct writes until the next retrace
+class VGA_LFBDirty_Handler final : public PageHandler {
+public:
+	VGA_LFBDirty_Handler() {
+		flags=PFLAG_READABLE|PFLAG_NOCODE;
+	}
+	HostPt GetHostReadPt(Bitu phys_page) override {
+		phys_page -= vga.lfb.page;
+		return &vga.mem.linear[CHECKED3(phys_page * 4096)];
+	}
+	HostPt GetHostWritePt(Bitu phys_page) override {
+		return GetHostReadPt(phys_page);
+	}
+
+	void writeb(PhysPt addr, uint8_t val) override
+	{
+		const auto offset = to_offset(addr);
+		host_writeb(&vga.mem.linear[offset], val);
+		mark_and_open(addr, offset);
+	}
+
+	void writew(PhysPt addr, uint16_t val) override
+	{
+		const auto offset = to_offset(addr);
+		host_writew_at(vga.mem.linear, offset, val);
+		mark_and_open(addr, offset);
+	}
+
+	void writed(PhysPt addr, uint32_t val) override
+	{
+		const auto offset = to_offset(addr);
+		host_writed_at(vga.mem.linear, offset, val);
+		mark_and_open(addr, offset);
+	}
+
+private:
+	static Bitu to_offset(const PhysPt addr)
+	{
+		return CHECKED(PAGING_GetPhysicalAddress(addr) - vga.lfb.addr);
+	}
+
+	void mark_and_open(const PhysPt addr, const Bitu offset)
+	{
+		VGA_MarkVramDirty(static_cast<uint32_t>(offset & ~0xfffu), 4096);
+		open_page_for_writes(this, addr);
+	}
+};
+
 class VGA_LFB_Handler final : public PageHandler {
 public:
 	VGA_LFB_Handler() {
@@ -877,17 +1108,20 @@ public:
 
 static struct vg {
 	VGA_Map_Handler map = {};
+	VGA_MapDirty_Handler mapdirty = {};
 	VGA_Changes_Handler changes = {};
 	VGA_TEXT_PageHandler text = {};
 	VGA_TANDY_PageHandler tandy = {};
 	VGA_ChainedEGA_Handler cega = {};
 	VGA_ChainedVGA_Handler cvga = {};
+	VGA_ChainedVGAFast_Handler cvgafast = {};
 	VGA_UnchainedEGA_Handler uega = {};
 	VGA_UnchainedVGA_Handler uvga = {};
 	VGA_PCJR_Handler pcjr = {};
 	VGA_HERC_Handler herc = {};
 	VGA_LIN4_Handler lin4 = {};
 	VGA_LFB_Handler lfb = {};
+	VGA_LFBDirty_Handler lfbdirty = {};
 	VGA_LFBChanges_Handler lfbchanges = {};
 	VGA_MMIO_Handler mmio = {};
 	VGA_Empty_Handler empty = {};
@@ -904,9 +1138,30 @@ void VGA_ChangedBank(void) {
 }
 
 void VGA_SetupHandlers(void) {
+	// During a batched mode set the rebuild (and its TLB clear) runs
+	// once when the register program completes
+	if (vga.mode_program.active) {
+		vga.mode_program.wants_handlers = true;
+		return;
+	}
+
 	vga.svga.bank_read_full = vga.svga.bank_read*vga.svga.bank_size;
 	vga.svga.bank_write_full = vga.svga.bank_write*vga.svga.bank_size;
 
+	// Pure Mode 13h maps the guest straight onto the packed shadow (the
+	// renderer reads it in this configuration, see VGA_SetupDrawing);
+	// every other configuration needs the planar copy to be current
+	const bool use_fast_chain4 = (vga.mode == M_VGA) && vga.config.chained &&
+	                             vga.config.compatible_chain4 &&
+	                             (vga.crtc.underline_location & 0x40);
+	if (!use_fast_chain4) {
+		sync_chained_shadow();
+	}
+
+	// Assume writes bypass the handlers (and thus dirty-VRAM tracking)
+	// until an instrumented handler is selected below
+	vga.dirty.handled_writes = false;
+
 	PageHandler *newHandler;
 	switch (machine) {
 	case MCH_CGA:
@@ -964,30 +1219,41 @@ void VGA_SetupHandlers(void) {
 		return;
 	case M_LIN4:
 		newHandler = &vgaph.lin4;
-		break;	
+		vga.dirty.handled_writes = true;
+		break;
 	case M_LIN15:
 	case M_LIN16:
 	case M_LIN24:
 	case M_LIN32:
+		// No format translation, so the banked window can use the
+		// write-combining handler and the renderer can skip clean lines
 #ifdef VGA_LFB_MAPPED
-		newHandler = &vgaph.map;
+		newHandler = &vgaph.mapdirty;
 #else
 		newHandler = &vgaph.changes;
 #endif
+		vga.dirty.handled_writes = true;
 		break;
 	case M_LIN8:
 	case M_VGA:
 		if (vga.config.chained) {
-			if(vga.config.compatible_chain4)
-				newHandler = &vgaph.cvga;
-			else 
+			if(vga.config.compatible_chain4) {
+				if (use_fast_chain4) {
+					newHandler = &vgaph.cvgafast;
+				} else {
+					newHandler = &vgaph.cvga;
+				}
+			} else {
 #ifdef VGA_LFB_MAPPED
-				newHandler = &vgaph.map;
+				newHandler = &vgaph.mapdirty;
 #else
 				newHandler = &vgaph.changes;
 #endif
+			}
+			vga.dirty.handled_writes = true;
 		} else {
 			newHandler = &vgaph.uvga;
+			vga.dirty.handled_writes = true;
 		}
 		break;
 	case M_EGA:
@@ -995,11 +1261,16 @@ void VGA_SetupHandlers(void) {
 			newHandler = &vgaph.cega;
 		else
 			newHandler = &vgaph.uega;
-		break;	
+		vga.dirty.handled_writes = true;
+		break;
 	case M_TEXT:
 		/* Check if we're not in odd/even mode */
-		if (vga.gfx.miscellaneous & 0x2) newHandler = &vgaph.map;
-		else newHandler = &vgaph.text;
+		if (vga.gfx.miscellaneous & 0x2) {
+			newHandler = &vgaph.map;
+		} else {
+			newHandler = &vgaph.text;
+			vga.dirty.handled_writes = true;
+		}
 		break;
 	case M_CGA4:
 	case M_CGA2:
@@ -1045,14 +1316,21 @@ void VGA_SetupHandlers(void) {
 	if(svgaCard == SVGA_S3Trio && (vga.s3.ext_mem_ctrl & 0x10))
 		MEM_SetPageHandler(VGA_PAGE_A0, 16, &vgaph.mmio);
 range_done:
-	PAGING_ClearTLB();
+	// Remapping may expose memory whose writes we haven't seen
+	VGA_MarkAllVramDirty();
+	// Only the A000-BFFF window changed handlers; with paging enabled
+	// the guest's page tables may alias it anywhere, so drop the linked
+	// entries resolving into those physical pages, otherwise the linear
+	// range is the window itself
+	if (PAGING_Enabled()) PAGING_UnlinkPhysPages(VGA_PAGE_A0,32);
+	else PAGING_InvalidateRange(0xA0000,0xBFFFF);
 }
 
 void VGA_StartUpdateLFB(void) {
 	vga.lfb.page = vga.s3.la_window << 4;
 	vga.lfb.addr = vga.s3.la_window << 16;
 #ifdef VGA_LFB_MAPPED
-	vga.lfb.handler = &vgaph.lfb;
+	vga.lfb.handler = &vgaph.lfbdirty;
 #else
 	vga.lfb.handler = &vgaph.lfbchanges;
 #endif
@@ -1101,6 +1379,11 @@ void VGA_SetupMemory(Section* sec)
 	                                                           num_fastmem_bytes);
 	assert(reinterpret_cast<uintptr_t>(vga.fastmem) % vmem_alignment == 0);
 
+	// Video memory content is heavily duplicated across instances running
+	// the same title, so it takes part in the opt-in kernel page merging
+	MEM_AdviseMergeable(vga.mem.linear, num_linear_bytes, "video memory");
+	MEM_AdviseMergeable(vga.fastmem, num_fastmem_bytes, "video fast-memory");
+
 	// In most cases these values stay the same. Assumptions: vmemwrap is power of 2,
 	// vmemwrap <= vmemsize, fastmem implicitly has mem wrap twice as big
 	vga.vmemwrap = vga.vmemsize;
@@ -1335,22 +1335,24 @@ void VGA_SetupOther()
 	vga.tandy.line_shift = 13;
 
 	if (machine==MCH_CGA || IS_TANDY_ARCH) {
-		extern uint8_t int10_font_08[256 * 8];
+		extern const uint8_t int10_font_08[256 * 8];
 		for (int i = 0; i < 256; ++i) {
 			memcpy(&vga.draw.font[i * 32], &int10_font_08[i * 8], 8);
 		}
 		vga.draw.font_tables[0] = vga.draw.font_tables[1] = vga.draw.font;
+		VGA_InvalidateTextGlyphCache();
 	}
 	if (machine==MCH_CGA || IS_TANDY_ARCH || machine==MCH_HERC) {
 		IO_RegisterWriteHandler(0x3db, write_lightpen, io_width_t::byte);
 		IO_RegisterWriteHandler(0x3dc, write_lightpen, io_width_t::byte);
 	}
 	if (machine==MCH_HERC) {
-		extern uint8_t int10_font_14[256 * 14];
+		extern const uint8_t int10_font_14[256 * 14];
 		for (int i = 0; i < 256; ++i) {
 			memcpy(&vga.draw.font[i * 32], &int10_font_14[i * 14], 14);
 		}
 		vga.draw.font_tables[0] = vga.draw.font_tables[1] = vga.draw.font;
+		VGA_InvalidateTextGlyphCache();
 		MAPPER_AddHandler(cycle_hercules_palette, SDL_SCANCODE_F11, 0,
 		                  "hercpal", "Herc Pal");
 	}
@@ -97,6 +97,7 @@ void write_p3c5(io_port_t, io_val_t value, io_width_t)
 		        if (IS_VGA_ARCH)
 			        font2 |= (val & 0x20) >> 5;
 		        vga.draw.font_tables[1] = &vga.draw.font[font2 * 8 * 1024];
+	        VGA_InvalidateTextGlyphCache();
 	}
 	/*
 	        0,1,4  Selects VGA Character Map (0..7) if bit 3 of the character
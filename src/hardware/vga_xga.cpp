@@ -21,6 +21,7 @@
 
 #include "dosbox.h"
 
+#include <algorithm>
 #include <cassert>
 #include <math.h>
 #include <stdio.h>
@@ -159,18 +160,22 @@ void XGA_DrawPoint(Bitu x, Bitu y, Bitu c) {
 		case M_LIN8:
 			if (GCC_UNLIKELY(memaddr >= vga.vmemsize)) break;
 			vga.mem.linear[memaddr] = c;
+			VGA_MarkVramDirty(memaddr, 1);
 			break;
 		case M_LIN15:
 			if (GCC_UNLIKELY(memaddr*2 >= vga.vmemsize)) break;
 			((uint16_t*)(vga.mem.linear))[memaddr] = (uint16_t)(c&0x7fff);
+			VGA_MarkVramDirty(memaddr * 2, 2);
 			break;
 		case M_LIN16:
 			if (GCC_UNLIKELY(memaddr*2 >= vga.vmemsize)) break;
 			((uint16_t*)(vga.mem.linear))[memaddr] = (uint16_t)(c&0xffff);
+			VGA_MarkVramDirty(memaddr * 2, 2);
 			break;
 		case M_LIN32:
 			if (GCC_UNLIKELY(memaddr*4 >= vga.vmemsize)) break;
 			((uint32_t*)(vga.mem.linear))[memaddr] = c;
+			VGA_MarkVramDirty(memaddr * 4, 4);
 			break;
 		default:
 			break;
@@ -500,8 +505,147 @@ static void XGA_DrawLineBresenham(const uint32_t val, const bool skip_last_pixel
 	}
 }
 
+// Bytes per pixel of the current XGA drawing mode, or 0 when the mode
+// doesn't map onto the linear framebuffer.
+static Bitu XGA_PixelSize()
+{
+	switch (XGA_COLOR_MODE) {
+	case M_LIN8: return 1;
+	case M_LIN15:
+	case M_LIN16: return 2;
+	case M_LIN32: return 4;
+	default: return 0;
+	}
+}
+
+// Fill one horizontal span of the linear framebuffer with a solid colour,
+// applying the same per-mode masking and bounds checks as XGA_DrawPoint
+static void XGA_FillSpan(const Bitu x, const Bitu y, const Bitu len, const Bitu c)
+{
+	const auto memaddr = (y * XGA_SCREEN_WIDTH) + x;
+	switch (XGA_COLOR_MODE) {
+	case M_LIN8:
+		if (GCC_UNLIKELY(memaddr >= vga.vmemsize)) break;
+		memset(vga.mem.linear + memaddr,
+		       static_cast<int>(c & 0xff),
+		       std::min<Bitu>(len, vga.vmemsize - memaddr));
+		break;
+	case M_LIN15:
+		if (GCC_UNLIKELY(memaddr * 2 >= vga.vmemsize)) break;
+		std::fill_n(((uint16_t*)vga.mem.linear) + memaddr,
+		            std::min<Bitu>(len, vga.vmemsize / 2 - memaddr),
+		            (uint16_t)(c & 0x7fff));
+		break;
+	case M_LIN16:
+		if (GCC_UNLIKELY(memaddr * 2 >= vga.vmemsize)) break;
+		std::fill_n(((uint16_t*)vga.mem.linear) + memaddr,
+		            std::min<Bitu>(len, vga.vmemsize / 2 - memaddr),
+		            (uint16_t)(c & 0xffff));
+		break;
+	case M_LIN32:
+		if (GCC_UNLIKELY(memaddr * 4 >= vga.vmemsize)) break;
+		std::fill_n(((uint32_t*)vga.mem.linear) + memaddr,
+		            std::min<Bitu>(len, vga.vmemsize / 4 - memaddr),
+		            (uint32_t)c);
+		break;
+	default:
+		break;
+	}
+}
+
+// Draws the rectangle with whole-span fills when the configured mix boils
+// down to a solid colour that is independent of the destination, which
+// covers the fills issued by the Windows and XFree86 S3 drivers. Returns
+// false when the operation needs the per-pixel fallback.
+static bool XGA_DrawRectangleFast(const uint32_t val, const bool skip_last_pixel)
+{
+	// Only the foreground-mix data path is accelerated
+	if (((xga.pix_cntl >> 6) & 0x3) != 0x00) {
+		return false;
+	}
+
+	Bitu fillval = 0;
+	switch ((xga.foremix >> 5) & 0x03) {
+	case 0x00: fillval = xga.backcolor; break;
+	case 0x01: fillval = xga.forecolor; break;
+	default:
+		// PIX_TRANS and bitmap sources vary per pixel
+		return false;
+	}
+
+	bool write_pixels = true;
+	switch (xga.foremix & 0xf) {
+	case 0x01: fillval = 0; break;          // 0 (false)
+	case 0x02: fillval = 0xffffffff; break; // 1 (true)
+	case 0x03: write_pixels = false; break; // DST, leaves memory untouched
+	case 0x07: break;                       // SRC
+	default:
+		// All other mixes read the destination
+		return false;
+	}
+
+	const auto pixel_size = XGA_PixelSize();
+	if (!pixel_size) {
+		return false;
+	}
+
+	// The per-pixel loop wouldn't touch memory either, but it still
+	// advances the drawing position below
+	if (!(xga.curcommand & 0x1) || !(xga.curcommand & 0x10)) {
+		write_pixels = false;
+	}
+
+	const Bits dx = (((val >> 5) & 0x01) != 0) ? 1 : -1;
+	const Bits dy = (((val >> 7) & 0x01) != 0) ? 1 : -1;
+
+	const Bits xrun = xga.MAPcount - (xga.MAPcount && skip_last_pixel);
+
+	if (write_pixels) {
+		// Normalised extents clipped by the scissors; coordinates in
+		// the "negative" range past 2047 always land outside them,
+		// exactly as the per-pixel loop rejects such points
+		const auto x_lo = std::max<Bits>(
+		        std::min<Bits>(xga.curx, xga.curx + dx * xrun),
+		        xga.scissors.x1);
+		const auto x_hi = std::min<Bits>(
+		        std::max<Bits>(xga.curx, xga.curx + dx * xrun),
+		        xga.scissors.x2);
+		const auto y_lo = std::max<Bits>(
+		        std::min<Bits>(xga.cury, xga.cury + dy * xga.MIPcount),
+		        xga.scissors.y1);
+		const auto y_hi = std::min<Bits>(
+		        std::max<Bits>(xga.cury, xga.cury + dy * xga.MIPcount),
+		        xga.scissors.y2);
+
+		if (x_lo <= x_hi && y_lo <= y_hi) {
+			const auto width = static_cast<Bitu>(x_hi - x_lo + 1);
+			for (Bits y = y_lo; y <= y_hi; ++y) {
+				XGA_FillSpan(x_lo, y, width, fillval);
+			}
+
+			// One invalidation for the whole affected window
+			const auto first = ((y_lo * XGA_SCREEN_WIDTH) + x_lo) *
+			                   pixel_size;
+			const auto last = ((y_hi * XGA_SCREEN_WIDTH) + x_hi) *
+			                          pixel_size +
+			                  pixel_size - 1;
+			VGA_MarkVramDirty(static_cast<uint32_t>(first),
+			                  static_cast<uint32_t>(last - first + 1));
+		}
+	}
+
+	// Leave the drawing position as the per-pixel loop would
+	xga.curx = static_cast<uint16_t>(xga.curx + dx * (xrun + 1));
+	xga.cury = static_cast<uint16_t>(xga.cury + dy * (xga.MIPcount + 1));
+	return true;
+}
+
 static void XGA_DrawRectangle(const uint32_t val, const bool skip_last_pixel)
 {
+	if (XGA_DrawRectangleFast(val, skip_last_pixel)) {
+		return;
+	}
+
 	Bitu srcval = 0;
 	Bits srcx, srcy, dx, dy;
 
@@ -794,7 +938,121 @@ void XGA_DrawWait(uint32_t val, io_width_t width)
 	}
 }
 
+// Performs the blit with whole-row moves when it is a plain SRC-mix copy of
+// bitmap data, which is what drivers issue for scrolling and window moves.
+// Returns false when the operation needs the per-pixel fallback.
+static bool XGA_BlitRectFast(const Bitu val)
+{
+	// Only the foreground-mix data path with a straight source copy is
+	// accelerated
+	if (((xga.pix_cntl >> 6) & 0x3) != 0x00) {
+		return false;
+	}
+	if (((xga.foremix >> 5) & 0x03) != 0x03 || (xga.foremix & 0xf) != 0x07) {
+		return false;
+	}
+
+	const auto pixel_size = XGA_PixelSize();
+	if (!pixel_size) {
+		return false;
+	}
+	// A raw copy would carry over bit 15, which XGA_DrawPoint masks off
+	if (XGA_COLOR_MODE == M_LIN15) {
+		return false;
+	}
+
+	// The per-pixel loop wouldn't touch memory either
+	if (!(xga.curcommand & 0x1) || !(xga.curcommand & 0x10)) {
+		return true;
+	}
+
+	// Coordinates past 2047 are in the negative range; leave those to
+	// the fallback
+	if (xga.curx >= 2048 || xga.cury >= 2048 || xga.destx >= 2048 ||
+	    xga.desty >= 2048) {
+		return false;
+	}
+
+	const Bits dx = (((val >> 5) & 0x01) != 0) ? 1 : -1;
+	const Bits dy = (((val >> 7) & 0x01) != 0) ? 1 : -1;
+
+	// Row-wise moves must not let the copy read back its own output; the
+	// per-pixel loop would smear in these step directions, so keep them
+	// on the exact path
+	const auto xdist = static_cast<Bits>(xga.destx) - xga.curx;
+	const auto ydist = static_cast<Bits>(xga.desty) - xga.cury;
+	if (xdist * dx > 0 && xdist * dx <= xga.MAPcount) {
+		return false;
+	}
+	if (ydist * dy > 0 && ydist * dy <= xga.MIPcount) {
+		return false;
+	}
+
+	// Destination extents clipped by the scissors; the source window is
+	// offset from it by a constant (xdist, ydist)
+	const auto x_lo = std::max<Bits>(
+	        std::min<Bits>(xga.destx, xga.destx + dx * xga.MAPcount),
+	        xga.scissors.x1);
+	const auto x_hi = std::min<Bits>(
+	        std::max<Bits>(xga.destx, xga.destx + dx * xga.MAPcount),
+	        xga.scissors.x2);
+	const auto y_lo = std::max<Bits>(
+	        std::min<Bits>(xga.desty, xga.desty + dy * xga.MIPcount),
+	        xga.scissors.y1);
+	const auto y_hi = std::min<Bits>(
+	        std::max<Bits>(xga.desty, xga.desty + dy * xga.MIPcount),
+	        xga.scissors.y2);
+
+	if (x_lo > x_hi || y_lo > y_hi) {
+		return true;
+	}
+
+	// The per-pixel loop reads zeros past the end of video memory and
+	// silently drops writes there; leave such blits to it
+	const auto fb_pixels = vga.vmemsize / pixel_size;
+	const auto width     = static_cast<Bitu>(x_hi - x_lo + 1);
+
+	if (x_lo - xdist < 0 || y_lo - ydist < 0) {
+		return false;
+	}
+	const auto src_last = (static_cast<Bitu>(y_hi - ydist) *
+	                       XGA_SCREEN_WIDTH) +
+	                      (x_hi - xdist);
+	const auto dst_last = (static_cast<Bitu>(y_hi) * XGA_SCREEN_WIDTH) + x_hi;
+	if (src_last >= fb_pixels || dst_last >= fb_pixels) {
+		return false;
+	}
+
+	// Process rows in the step direction, like the per-pixel loop
+	for (Bits row = 0; row <= y_hi - y_lo; ++row) {
+		const Bits y = (dy > 0) ? (y_lo + row) : (y_hi - row);
+
+		const auto src_off = ((static_cast<Bitu>(y - ydist) *
+		                       XGA_SCREEN_WIDTH) +
+		                      (x_lo - xdist)) *
+		                     pixel_size;
+		const auto dst_off = ((static_cast<Bitu>(y) * XGA_SCREEN_WIDTH) +
+		                      x_lo) *
+		                     pixel_size;
+		memmove(vga.mem.linear + dst_off,
+		        vga.mem.linear + src_off,
+		        width * pixel_size);
+	}
+
+	// One invalidation for the whole destination window
+	const auto first = ((y_lo * XGA_SCREEN_WIDTH) + x_lo) * pixel_size;
+	const auto last = ((y_hi * XGA_SCREEN_WIDTH) + x_hi) * pixel_size +
+	                  pixel_size - 1;
+	VGA_MarkVramDirty(static_cast<uint32_t>(first),
+	                  static_cast<uint32_t>(last - first + 1));
+	return true;
+}
+
 void XGA_BlitRect(Bitu val) {
+	if (XGA_BlitRectFast(val)) {
+		return;
+	}
+
 	uint32_t xat, yat;
 	Bitu srcdata;
 	Bitu dstdata;
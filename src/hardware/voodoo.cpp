@@ -80,10 +80,15 @@
 #include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cinttypes>
 #include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <map>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include <SDL.h>
 #include <SDL_cpuinfo.h> // for proper SSE defines for MSVC
@@ -255,7 +260,10 @@ enum VoodooModel
 	VOODOO_2,
 };
 
-enum { TRIANGLE_THREADS = 3, TRIANGLE_WORKERS = TRIANGLE_THREADS + 1 };
+/* upper bound on rasterization workers (helper threads plus the main
+   thread); the actual thread count is resolved at runtime from the
+   'voodoo_threads' setting */
+enum { MAX_TRIANGLE_THREADS = 15, MAX_TRIANGLE_WORKERS = MAX_TRIANGLE_THREADS + 1 };
 
 /* maximum number of TMUs */
 #define MAX_TMU					2
@@ -689,9 +697,11 @@ struct stats_block {
 	int32_t chroma_fail;        // chroma test fail statistic
 	int32_t zfunc_fail;         // z function test fail statistic
 	int32_t afunc_fail;         // alpha function test fail statistic
+	int32_t tiles_claimed;      // scanline tiles claimed (worker
+	                            // utilization; not a guest statistic)
 	// int32_t clip_fail;       // clipping fail statistic
 	// int32_t stipple_count;   // stipple statistic
-	int32_t filler[64 / 4 - 5]; // pad this structure to 64 bytes
+	int32_t filler[64 / 4 - 6]; // pad this structure to 64 bytes
 };
 static_assert(sizeof(stats_block) == 64);
 
@@ -761,6 +771,21 @@ struct tmu_state
 
 	rgb_t				palette[256];			/* palette lookup table */
 	rgb_t				palettea[256];			/* palette+alpha lookup table */
+
+	/* decoded-texture cache: guest texture levels are expanded to the
+	   host ARGB-8888 layout once per update so the rasterizer's inner
+	   loop is a plain array fetch (see texture_cache_prepare) */
+	struct decoded_texture
+	{
+		uint32_t			lodoffset[9];		/* per-LOD offsets into texels */
+		uint32_t			ram_start, ram_end;	/* guest RAM range decoded */
+		std::vector<rgb_t>	texels;
+	};
+	std::map<uint64_t, decoded_texture> texcache; /* keyed on base+format */
+	size_t				texcache_bytes;			/* decoded bytes held */
+	uint32_t			palette_generation;		/* bumped on NCC/palette writes */
+	const rgb_t *		texcache_texels;		/* current triangle's decode */
+	const uint32_t *	texcache_lodoffset;		/* (null when not decoded) */
 };
 
 struct tmu_shared_state
@@ -896,10 +921,14 @@ struct triangle_worker
 	uint16_t *drawbuf;
 	poly_vertex v1, v2, v3;
 	int32_t v1y, v3y, totalpix;
-	std::array<std::thread, TRIANGLE_THREADS> threads;
-	std::array<Semaphore, TRIANGLE_THREADS> sembegin;
+	int32_t num_threads; /* helper threads; workers = num_threads + 1 */
+	int32_t num_tiles;   /* pixel tiles in the current triangle */
+	std::atomic<int32_t> next_tile; /* shared work-stealing cursor */
+	std::vector<std::thread> threads;
+	std::deque<Semaphore> sembegin; /* deque: semaphores aren't movable */
 	Semaphore semdone;
-	int done_count;
+	uint64_t worker_pixels[MAX_TRIANGLE_WORKERS]; /* lifetime utilization */
+	uint64_t worker_tiles[MAX_TRIANGLE_WORKERS];
 };
 
 struct voodoo_state
@@ -925,8 +954,8 @@ struct voodoo_state
 	                                                    rasterizers */
 #endif
 
-	stats_block thread_stats[TRIANGLE_WORKERS] = {}; /* per-thread
-	                                                    statistics */
+	stats_block thread_stats[MAX_TRIANGLE_WORKERS] = {}; /* per-thread
+	                                                        statistics */
 
 	bool send_config   = {};
 	bool clock_enabled = {};
@@ -1982,7 +2011,11 @@ do																				\
 		t *= smax + 1;															\
 																				\
 		/* fetch texel data */													\
-		if (TEXMODE_FORMAT(TEXMODE) < 8)										\
+		if ((TT)->texcache_texels != nullptr)									\
+		{																		\
+			c_local.u = (TT)->texcache_texels[(TT)->texcache_lodoffset[ilod] + t + s];\
+		}																		\
+		else if (TEXMODE_FORMAT(TEXMODE) < 8)									\
 		{																		\
 			texel0 = (TT)->ram[(texbase + t + s) & (TT)->mask];					\
 			c_local.u = (LOOKUP)[texel0];										\
@@ -2043,7 +2076,15 @@ do																				\
 		t1 *= smax + 1;															\
 																				\
 		/* fetch texel data */													\
-		if (TEXMODE_FORMAT(TEXMODE) < 8)										\
+		if ((TT)->texcache_texels != nullptr)									\
+		{																		\
+			const rgb_t *tc = (TT)->texcache_texels + (TT)->texcache_lodoffset[ilod];\
+			texel0 = tc[t + s];													\
+			texel1 = tc[t + s1];												\
+			texel2 = tc[t1 + s];												\
+			texel3 = tc[t1 + s1];												\
+		}																		\
+		else if (TEXMODE_FORMAT(TEXMODE) < 8)									\
 		{																		\
 			texel0 = (TT)->ram[(texbase + t + s) & (TT)->mask];					\
 			texel1 = (TT)->ram[(texbase + t + s1) & (TT)->mask];				\
@@ -3007,6 +3048,7 @@ static voodoo_state* v = nullptr;
 static auto vtype = VOODOO_1;
 static auto voodoo_multithreading     = true;
 static auto voodoo_bilinear_filtering = false;
+static int voodoo_num_threads         = 0; /* 0 = automatic */
 
 #define LOG_VOODOO LOG_PCI
 enum {
@@ -4054,6 +4096,128 @@ static void ncc_table_update(ncc_table *n)
 }
 
 
+
+/*************************************
+ *
+ *  Decoded-texture cache
+ *
+ *************************************/
+
+/* formats 1, 5, 6, 9 and 14 look up texels through the NCC tables or the
+   palette, whose contents can change underneath a decoded texture */
+static inline bool texture_format_uses_palette(const uint32_t format)
+{
+	return ((format & 7) == 1) || (format == 5) || (format == 6) ||
+	       (format == 14);
+}
+
+/* drop decoded textures overlapping a guest texture RAM write */
+static void texture_cache_invalidate(tmu_state *t, const uint32_t addr, const uint32_t len)
+{
+	for (auto it = t->texcache.begin(); it != t->texcache.end();) {
+		const auto& entry = it->second;
+		if (addr < entry.ram_end && addr + len > entry.ram_start) {
+			if (t->texcache_texels == entry.texels.data()) {
+				t->texcache_texels = nullptr;
+			}
+			t->texcache_bytes -= entry.texels.size() * sizeof(rgb_t);
+			it = t->texcache.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+/* look up (or build) the decoded texture for the TMU's current base
+   address and format registers; runs on the main thread before the
+   triangle workers are woken, so the workers see an immutable decode */
+static void texture_cache_prepare(tmu_state *t)
+{
+	const auto texmode = t->reg[textureMode].u;
+	const auto format  = TEXMODE_FORMAT(texmode);
+
+	t->texcache_texels = nullptr;
+	if (t->lookup == nullptr) {
+		return;
+	}
+
+	/* build the cache key from the base address and format registers */
+	uint64_t key = ((uint64_t)t->lodoffset[0] << 34) |
+	               ((uint64_t)format << 30) |
+	               ((uint64_t)TEXMODE_NCC_TABLE_SELECT(texmode) << 29) |
+	               ((uint64_t)(t->lodmask & 0x1ff) << 20) |
+	               ((uint64_t)(t->wmask & 0x3ff) << 10) |
+	               ((uint64_t)(t->hmask & 0x3ff));
+	if (texture_format_uses_palette(format)) {
+		key ^= (uint64_t)t->palette_generation * 0x9e3779b97f4a7c15ull;
+	}
+
+	auto it = t->texcache.find(key);
+	if (it == t->texcache.end()) {
+		/* keep the cache bounded; decoded entries are cheap to rebuild */
+		constexpr size_t max_texcache_bytes = 32 * 1024 * 1024;
+		if (t->texcache_bytes > max_texcache_bytes) {
+			t->texcache.clear();
+			t->texcache_bytes = 0;
+		}
+
+		tmu_state::decoded_texture entry = {};
+		entry.ram_start = t->mask + 1;
+		entry.ram_end   = 0;
+
+		/* decode every LOD the rasterizer can reach; the pipeline
+		   clamps to [lodmin, lodmax] and skips at most one unowned
+		   level, so this range covers all possible fetches */
+		const int ilod_min = t->lodmin >> 8;
+		const int ilod_max = std::min((t->lodmax >> 8) + 1, 8);
+
+		for (int ilod = ilod_min; ilod <= ilod_max; ilod++) {
+			const uint32_t count = ((t->wmask >> ilod) + 1) *
+			                       ((t->hmask >> ilod) + 1);
+			const uint32_t texbase = t->lodoffset[ilod];
+
+			entry.lodoffset[ilod] = (uint32_t)entry.texels.size();
+			entry.texels.reserve(entry.texels.size() + count);
+
+			if (format < 8) {
+				for (uint32_t i = 0; i < count; i++) {
+					const uint8_t texel = t->ram[(texbase + i) & t->mask];
+					entry.texels.push_back(t->lookup[texel]);
+				}
+			} else {
+				for (uint32_t i = 0; i < count; i++) {
+					const uint16_t texel = *(uint16_t *)&t->ram[(texbase + 2 * i) & t->mask];
+					if (format >= 10 && format <= 12) {
+						entry.texels.push_back(t->lookup[texel]);
+					} else {
+						entry.texels.push_back(
+						        (t->lookup[texel & 0xff] & 0xffffff) |
+						        ((texel & 0xff00) << 16));
+					}
+				}
+			}
+
+			/* track the guest RAM range backing this decode */
+			const uint32_t len = count << ((format < 8) ? 0 : 1);
+			if (texbase + len > t->mask + 1) {
+				/* the level wraps the RAM; cover everything */
+				entry.ram_start = 0;
+				entry.ram_end   = t->mask + 1;
+			} else {
+				entry.ram_start = std::min(entry.ram_start, texbase);
+				entry.ram_end = std::max(entry.ram_end, texbase + len);
+			}
+		}
+
+		t->texcache_bytes += entry.texels.size() * sizeof(rgb_t);
+		it = t->texcache.emplace(key, std::move(entry)).first;
+	}
+
+	t->texcache_texels    = it->second.texels.data();
+	t->texcache_lodoffset = it->second.lodoffset;
+}
+
+
 /*************************************
  *
  *  Faux DAC implementation
@@ -4220,6 +4384,9 @@ static void prepare_tmu(tmu_state *t)
 		}
 	}
 
+	/* look up (or build) the decoded texture for the current setup */
+	texture_cache_prepare(t);
+
 	/* compute (ds^2 + dt^2) in both X and Y as 28.36 numbers */
 	texdx = (t->dsdx >> 14) * (t->dsdx >> 14) + (t->dtdx >> 14) * (t->dtdx >> 14);
 	texdy = (t->dsdy >> 14) * (t->dsdy >> 14) + (t->dtdy >> 14) * (t->dtdy >> 14);
@@ -4266,6 +4433,7 @@ static void sum_statistics(stats_block *target, const stats_block *source)
 	target->chroma_fail += source->chroma_fail;
 	target->zfunc_fail += source->zfunc_fail;
 	target->afunc_fail += source->afunc_fail;
+	target->tiles_claimed += source->tiles_claimed;
 }
 
 static void accumulate_statistics(voodoo_state *vs, const stats_block *stats)
@@ -4283,10 +4451,16 @@ static void accumulate_statistics(voodoo_state *vs, const stats_block *stats)
 static void update_statistics(voodoo_state *vs, bool accumulate)
 {
 	/* accumulate/reset statistics from all units */
-	for (auto& thread_stat : vs->thread_stats) {
+	auto& tworker = vs->tworker;
+	for (auto i = 0; i < MAX_TRIANGLE_WORKERS; i++) {
+		const auto& thread_stat = vs->thread_stats[i];
 		if (accumulate) {
 			accumulate_statistics(vs, &thread_stat);
 		}
+		/* fold per-worker totals into the lifetime utilization
+		   counters before the reset below discards them */
+		tworker.worker_pixels[i] += static_cast<uint64_t>(thread_stat.pixels_in);
+		tworker.worker_tiles[i] += static_cast<uint64_t>(thread_stat.tiles_claimed);
 	}
 	memset(vs->thread_stats, 0, sizeof(vs->thread_stats));
 
@@ -4303,7 +4477,7 @@ static void update_statistics(voodoo_state *vs, bool accumulate)
     COMMAND HANDLERS
 ***************************************************************************/
 
-static void triangle_worker_work(triangle_worker& tworker, int32_t worktstart, int32_t worktend)
+static void triangle_worker_work(triangle_worker& tworker, const int32_t worker_id)
 {
 	/* determine the number of TMUs involved */
 	uint32_t tmus     = 0;
@@ -4339,51 +4513,63 @@ static void triangle_worker_work(triangle_worker& tworker, int32_t worktstart, i
 
 	stats_block my_stats = {};
 
-	const int32_t from = tworker.totalpix * worktstart / TRIANGLE_WORKERS;
-	const int32_t to   = tworker.totalpix * worktend / TRIANGLE_WORKERS;
+	/* claim pixel tiles off the shared cursor until none remain; small
+	   tiles keep every worker busy on skewed triangles instead of
+	   having most of them wait on the one that drew the static split */
+	const int32_t num_tiles = tworker.num_tiles;
+	const int32_t totalpix  = tworker.totalpix;
 
-	for (int32_t curscan = tworker.v1y, scanend = tworker.v3y, sumpix = 0, lastsum = 0;
-	     curscan != scanend && lastsum < to;
-	     lastsum = sumpix, curscan++) {
+	for (int32_t tile = tworker.next_tile++; tile < num_tiles;
+	     tile = tworker.next_tile++) {
 
-		const float fully = (float)(curscan) + 0.5f;
+		const int32_t from = totalpix * tile / num_tiles;
+		const int32_t to   = totalpix * (tile + 1) / num_tiles;
+		++my_stats.tiles_claimed;
 
-		const float startx = v1.x + (fully - v1.y) * dxdy_v1v3;
+		for (int32_t curscan = tworker.v1y, scanend = tworker.v3y,
+		             sumpix = 0, lastsum = 0;
+		     curscan != scanend && lastsum < to;
+		     lastsum = sumpix, curscan++) {
 
-		/* compute the ending X based on which part of the triangle we're in */
-		const float stopx = (fully < v2.y
-		                             ? (v1.x + (fully - v1.y) * dxdy_v1v2)
-		                             : (v2.x + (fully - v2.y) * dxdy_v2v3));
+			const float fully = (float)(curscan) + 0.5f;
 
-		/* clamp to full pixels */
-		poly_extent extent;
-		extent.startx = round_coordinate(startx);
-		extent.stopx = round_coordinate(stopx);
+			const float startx = v1.x + (fully - v1.y) * dxdy_v1v3;
 
-		/* force start < stop */
-		if (extent.startx >= extent.stopx)
-		{
-			if (extent.startx == extent.stopx) {
-				continue;
+			/* compute the ending X based on which part of the triangle we're in */
+			const float stopx = (fully < v2.y
+			                             ? (v1.x + (fully - v1.y) * dxdy_v1v2)
+			                             : (v2.x + (fully - v2.y) * dxdy_v2v3));
+
+			/* clamp to full pixels */
+			poly_extent extent;
+			extent.startx = round_coordinate(startx);
+			extent.stopx = round_coordinate(stopx);
+
+			/* force start < stop */
+			if (extent.startx >= extent.stopx)
+			{
+				if (extent.startx == extent.stopx) {
+					continue;
+				}
+				std::swap(extent.startx, extent.stopx);
 			}
-			std::swap(extent.startx, extent.stopx);
-		}
 
-		sumpix += (extent.stopx - extent.startx);
+			sumpix += (extent.stopx - extent.startx);
 
-		if (sumpix <= from) {
-			continue;
-		}
-		if (lastsum < from) {
-			extent.startx += (from - lastsum);
-		}
-		if (sumpix > to) {
-			extent.stopx -= (sumpix - to);
-		}
+			if (sumpix <= from) {
+				continue;
+			}
+			if (lastsum < from) {
+				extent.startx += (from - lastsum);
+			}
+			if (sumpix > to) {
+				extent.stopx -= (sumpix - to);
+			}
 
-		raster_generic(v, tmus, texmode0, texmode1, tworker.drawbuf, curscan, &extent, my_stats);
+			raster_generic(v, tmus, texmode0, texmode1, tworker.drawbuf, curscan, &extent, my_stats);
+		}
 	}
-	sum_statistics(&v->thread_stats[worktstart], &my_stats);
+	sum_statistics(&v->thread_stats[worker_id], &my_stats);
 }
 
 static int triangle_worker_thread_func(int32_t p)
@@ -4392,24 +4578,44 @@ static int triangle_worker_thread_func(int32_t p)
 	for (const int32_t tnum = p; tworker.threads_active;) {
 		tworker.sembegin[tnum].wait();
 		if (tworker.threads_active) {
-			triangle_worker_work(tworker, tnum, tnum + 1);
+			triangle_worker_work(tworker, tnum);
 		}
 		tworker.semdone.notify();
 	}
 	return 0;
 }
 
+static void triangle_worker_log_utilization(const triangle_worker& tworker)
+{
+	uint64_t total_pixels = 0;
+	for (const auto pixels : tworker.worker_pixels) {
+		total_pixels += pixels;
+	}
+	if (total_pixels == 0) {
+		return;
+	}
+	for (int32_t i = 0; i != tworker.num_threads + 1; i++) {
+		LOG_MSG("VOODOO: Worker %d rasterized %" PRIu64
+		        " pixels across %" PRIu64 " tiles (%.1f%% of the total)",
+		        i,
+		        tworker.worker_pixels[i],
+		        tworker.worker_tiles[i],
+		        100.0 * static_cast<double>(tworker.worker_pixels[i]) /
+		                static_cast<double>(total_pixels));
+	}
+}
+
 static void triangle_worker_shutdown(triangle_worker& tworker)
 {
 	if (!tworker.threads_active) {
 		return;
 	}
 	tworker.threads_active = false;
-	for (size_t i = 0; i != TRIANGLE_THREADS; i++) {
-		tworker.sembegin[i].notify();
+	for (auto& begin_semaphore : tworker.sembegin) {
+		begin_semaphore.notify();
 	}
 
-	for (size_t i = 0; i != TRIANGLE_THREADS; i++) {
+	for (size_t i = 0; i != tworker.threads.size(); i++) {
 		tworker.semdone.wait();
 	}
 
@@ -4418,6 +4624,19 @@ static void triangle_worker_shutdown(triangle_worker& tworker)
 			thread.join();
 		}
 	}
+	tworker.threads.clear();
+	tworker.sembegin.clear();
+
+	/* fold in statistics not yet collected, then report how evenly the
+	   rasterization load spread so hosts can be sized appropriately */
+	for (auto i = 0; i < MAX_TRIANGLE_WORKERS; i++) {
+		tworker.worker_pixels[i] += static_cast<uint64_t>(
+		        v->thread_stats[i].pixels_in);
+		tworker.worker_tiles[i] += static_cast<uint64_t>(
+		        v->thread_stats[i].tiles_claimed);
+	}
+	memset(v->thread_stats, 0, sizeof(v->thread_stats));
+	triangle_worker_log_utilization(tworker);
 }
 
 static void triangle_worker_run(triangle_worker& tworker)
@@ -4425,8 +4644,10 @@ static void triangle_worker_run(triangle_worker& tworker)
 	if (!tworker.use_threads)
 	{
 		// do not use threaded calculation
-		tworker.totalpix = 0xFFFFFFF;
-		triangle_worker_work(tworker, 0, TRIANGLE_WORKERS);
+		tworker.totalpix  = 0xFFFFFFF;
+		tworker.num_tiles = 1;
+		tworker.next_tile = 0;
+		triangle_worker_work(tworker, 0);
 		return;
 	}
 
@@ -4465,7 +4686,9 @@ static void triangle_worker_run(triangle_worker& tworker)
 	// Don't wake up threads for just a few pixels
 	if (tworker.totalpix <= 200)
 	{
-		triangle_worker_work(tworker, 0, TRIANGLE_WORKERS);
+		tworker.num_tiles = 1;
+		tworker.next_tile = 0;
+		triangle_worker_work(tworker, 0);
 		return;
 	}
 
@@ -4473,19 +4696,27 @@ static void triangle_worker_run(triangle_worker& tworker)
 	{
 		tworker.threads_active = true;
 
-		int worker_id = 0;
-		for (auto& triangle_worker : tworker.threads) {
-			triangle_worker = std::thread([worker_id] {
+		tworker.sembegin.resize(check_cast<size_t>(tworker.num_threads));
+		for (int32_t worker_id = 0; worker_id != tworker.num_threads;
+		     worker_id++) {
+			tworker.threads.emplace_back([worker_id] {
 				triangle_worker_thread_func(worker_id);
 			});
-			++worker_id;
 		}
 	}
+
+	// Several small tiles per worker let the fast ones steal the tail
+	// end of skewed triangles instead of idling on the slowest worker
+	constexpr int32_t tiles_per_worker = 4;
+	tworker.num_tiles = (tworker.num_threads + 1) * tiles_per_worker;
+	tworker.next_tile = 0;
+
 	for (auto& begin_semaphore : tworker.sembegin) {
 		begin_semaphore.notify();
 	}
-	triangle_worker_work(tworker, TRIANGLE_THREADS, TRIANGLE_WORKERS);
-	for (size_t i = 0; i != TRIANGLE_THREADS; i++) {
+	// The main thread is the last worker
+	triangle_worker_work(tworker, tworker.num_threads);
+	for (int32_t i = 0; i != tworker.num_threads; i++) {
 		tworker.semdone.wait();
 	}
 }
@@ -5791,9 +6022,11 @@ static void register_w(uint32_t offset, uint32_t data)
 		case nccTable+11:
 			if ((chips & 2) != 0) {
 				ncc_table_write(&v->tmu[0].ncc[0], regnum - nccTable, data);
+				v->tmu[0].palette_generation++;
 			}
 			if ((chips & 4) != 0) {
 				ncc_table_write(&v->tmu[1].ncc[0], regnum - nccTable, data);
+				v->tmu[1].palette_generation++;
 			}
 			break;
 
@@ -5811,9 +6044,11 @@ static void register_w(uint32_t offset, uint32_t data)
 		case nccTable+23:
 			if ((chips & 2) != 0) {
 				ncc_table_write(&v->tmu[0].ncc[1], regnum - (nccTable + 12), data);
+				v->tmu[0].palette_generation++;
 			}
 			if ((chips & 4) != 0) {
 				ncc_table_write(&v->tmu[1].ncc[1], regnum - (nccTable + 12), data);
+				v->tmu[1].palette_generation++;
 			}
 			break;
 
@@ -6664,7 +6899,7 @@ static int32_t texture_w(uint32_t offset, uint32_t data) {
 		dest = t->ram;
 		tbaseaddr &= t->mask;
 
-		[[maybe_unused]] bool changed = false;
+		bool changed = false;
 		if (dest[BYTE4_XOR_LE(tbaseaddr + 0)] != ((data >> 0) & 0xff)) {
 			dest[BYTE4_XOR_LE(tbaseaddr + 0)] = static_cast<uint8_t>((data >> 0) & 0xff);
 			changed = true;
@@ -6682,6 +6917,10 @@ static int32_t texture_w(uint32_t offset, uint32_t data) {
 			changed = true;
 		}
 
+		if (changed) {
+			texture_cache_invalidate(t, tbaseaddr, 4);
+		}
+
 #ifdef C_ENABLE_VOODOO_OPENGL
 		if (changed && v->ogl && v->active) {
 			voodoo_ogl_texture_clear(t->lodoffset[lod],tmunum);
@@ -6726,7 +6965,7 @@ static int32_t texture_w(uint32_t offset, uint32_t data) {
 		tbaseaddr &= t->mask;
 		tbaseaddr >>= 1;
 
-		[[maybe_unused]] bool changed = false;
+		bool changed = false;
 		if (dest[BYTE_XOR_LE(tbaseaddr + 0)] != ((data >> 0) & 0xffff)) {
 			dest[BYTE_XOR_LE(tbaseaddr + 0)] = static_cast<uint16_t>((data >> 0) & 0xffff);
 			changed = true;
@@ -6736,6 +6975,10 @@ static int32_t texture_w(uint32_t offset, uint32_t data) {
 			changed = true;
 		}
 
+		if (changed) {
+			texture_cache_invalidate(t, tbaseaddr << 1, 4);
+		}
+
 #ifdef C_ENABLE_VOODOO_OPENGL
 		if (changed && v->ogl && v->active) {
 			voodoo_ogl_texture_clear(t->lodoffset[lod],tmunum);
@@ -7733,6 +7976,16 @@ static void Voodoo_Startup() {
 	v->tworker.use_threads = voodoo_multithreading;
 	v->tworker.disable_bilinear_filter = (voodoo_bilinear_filtering == false);
 
+	// Resolve the worker thread count: automatic sizing leaves a couple
+	// of cores free for the main thread and the rest of the emulator
+	auto num_threads = voodoo_num_threads;
+	if (num_threads <= 0) {
+		const auto num_cores = static_cast<int>(
+		        std::thread::hardware_concurrency());
+		num_threads = num_cores - 2;
+	}
+	v->tworker.num_threads = std::clamp(num_threads, 1, +MAX_TRIANGLE_THREADS);
+
 	// Switch the pagehandler now that v has been allocated and is in use
 	voodoo_pagehandler = &voodoo_real_pagehandler;
 	PAGING_InitTLB();
@@ -7761,6 +8014,7 @@ void VOODOO_Init(Section* sec)
 
 	voodoo_multithreading = section->Get_bool("voodoo_multithreading");
 	voodoo_bilinear_filtering = section->Get_bool("voodoo_bilinear_filtering");
+	voodoo_num_threads = section->Get_int("voodoo_threads");
 
 	sec->AddDestroyFunction(&VOODOO_Destroy,false);
 
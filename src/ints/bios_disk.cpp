@@ -20,15 +20,20 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cinttypes>
 #include <utility>
 
 #include "callback.h"
+#include "control.h"
 #include "regs.h"
 #include "mem.h"
 #include "dos_inc.h" /* for Drives[] */
 #include "drives.h"
 #include "mapper.h"
+#include "setup.h"
 #include "string_utils.h"
+#include "support.h"
+#include "timer.h"
 
 diskGeo DiskGeometryList[] = {
 	{ 160,  8, 1, 40, 0},	// SS/DD 5.25"
@@ -164,8 +169,82 @@ uint8_t imageDisk::Read_Sector(uint32_t head,uint32_t cylinder,uint32_t sector,v
 
 uint8_t imageDisk::Read_AbsoluteSector(uint32_t sectnum, void *data)
 {
+	// Dirty sectors must be served from the write-back cache; the image
+	// file still holds their old contents
+	if (flush_interval_ms > 0) {
+		const auto it = dirty_sectors.find(sectnum);
+		if (it != dirty_sectors.end()) {
+			memcpy(data, it->second.data(), sector_size);
+			return 0x00;
+		}
+	}
+
+	if (read_ahead_sectors > 0) {
+		DrainPrefetchCompletions();
+		const auto it = sector_cache.find(sectnum);
+		if (it != sector_cache.end()) {
+			memcpy(data, it->second.data(), sector_size);
+			sector_cache.erase(it);
+			ScheduleReadAhead(sectnum);
+			return 0x00;
+		}
+	}
+
 	const auto bytenum = check_cast<cross_off_t>(sectnum) * sector_size;
+	{
+		std::lock_guard<std::mutex> lock(file_mutex);
+		if (last_action == WRITE || bytenum != current_fpos) {
+			if (cross_fseeko(diskimg, bytenum, SEEK_SET) != 0) {
+				LOG_ERR("BIOSDISK: Could not seek to sector %u in file '%s': %s",
+				        sectnum, diskname, strerror(errno));
+				return 0xff;
+			}
+		}
+		size_t ret = fread(data, 1, sector_size, diskimg);
+		current_fpos=bytenum+ret;
+		last_action=READ;
+	}
+	if (read_ahead_sectors > 0) {
+		ScheduleReadAhead(sectnum);
+	}
+
+	return 0x00;
+}
 
+uint8_t imageDisk::Read_Sectors(uint32_t head, uint32_t cylinder,
+                                uint32_t sector, uint32_t count, void* data)
+{
+	const auto sectnum = ((cylinder * heads + head) * sectors) + sector - 1;
+
+	return Read_AbsoluteSectors(sectnum, count, data);
+}
+
+// Read 'count' consecutive sectors with a single host read. Falls back to
+// the per-sector path whenever the write-back or read-ahead caches could
+// hold a newer copy of a sector in the range.
+uint8_t imageDisk::Read_AbsoluteSectors(const uint32_t sectnum,
+                                        const uint32_t count, void* data)
+{
+	auto buffer = static_cast<uint8_t*>(data);
+
+	const bool may_be_cached = (flush_interval_ms > 0 &&
+	                            !dirty_sectors.empty()) ||
+	                           read_ahead_sectors > 0;
+	if (may_be_cached) {
+		for (uint32_t i = 0; i < count; ++i) {
+			const auto status = Read_AbsoluteSector(
+			        sectnum + i, buffer + i * sector_size);
+			if (status != 0x00) {
+				return status;
+			}
+		}
+		return 0x00;
+	}
+
+	const auto bytenum = check_cast<cross_off_t>(sectnum) * sector_size;
+	const auto total_bytes = static_cast<size_t>(count) * sector_size;
+
+	std::lock_guard<std::mutex> lock(file_mutex);
 	if (last_action == WRITE || bytenum != current_fpos) {
 		if (cross_fseeko(diskimg, bytenum, SEEK_SET) != 0) {
 			LOG_ERR("BIOSDISK: Could not seek to sector %u in file '%s': %s",
@@ -173,13 +252,98 @@ uint8_t imageDisk::Read_AbsoluteSector(uint32_t sectnum, void *data)
 			return 0xff;
 		}
 	}
-	size_t ret = fread(data, 1, sector_size, diskimg);
-	current_fpos=bytenum+ret;
-	last_action=READ;
+	// Like the single-sector path, a short read past the end of the image
+	// is not treated as an error
+	const size_t ret = fread(buffer, 1, total_bytes, diskimg);
+	current_fpos = bytenum + ret;
+	last_action  = READ;
 
 	return 0x00;
 }
 
+// Move finished prefetches into the sector cache, dropping any that a
+// write has invalidated in the meantime
+void imageDisk::DrainPrefetchCompletions()
+{
+	constexpr size_t max_cached_sectors = 128;
+
+	while (!prefetch_completions.IsEmpty()) {
+		auto job = prefetch_completions.Dequeue();
+		if (!job) {
+			break;
+		}
+		if (job->generation != write_generation.load()) {
+			continue; // stale: a write happened after the prefetch
+		}
+		while (sector_cache.size() >= max_cached_sectors) {
+			sector_cache.erase(sector_cache.begin());
+		}
+		sector_cache[job->sector] = std::move(job->data);
+	}
+}
+
+// Detect sequential access and keep the worker topped up with the next
+// window of sectors
+void imageDisk::ScheduleReadAhead(const uint32_t sectnum)
+{
+	if (sectnum == next_sequential_sector) {
+		auto first = std::max(last_scheduled_sector + 1, sectnum + 1);
+		const auto last = sectnum +
+		                  static_cast<uint32_t>(read_ahead_sectors);
+
+		while (first <= last && prefetch_requests.Size() <
+		                                prefetch_requests.MaxCapacity()) {
+			if (!prefetch_requests.Enqueue(uint32_t(first))) {
+				break;
+			}
+			++first;
+		}
+		last_scheduled_sector = std::max(last_scheduled_sector, first - 1);
+	} else {
+		// random access: collapse the window back to this sector
+		last_scheduled_sector = sectnum;
+	}
+	next_sequential_sector = sectnum + 1;
+}
+
+void imageDisk::PrefetchWorkerLoop()
+{
+	while (auto request = prefetch_requests.Dequeue()) {
+		PrefetchedSector job = {};
+		job.sector     = *request;
+		job.generation = write_generation.load();
+		job.data.resize(sector_size);
+
+		const auto bytenum = check_cast<cross_off_t>(job.sector) *
+		                     sector_size;
+		{
+			std::lock_guard<std::mutex> lock(file_mutex);
+			if (cross_fseeko(diskimg, bytenum, SEEK_SET) != 0 ||
+			    fread(job.data.data(), 1, sector_size, diskimg) !=
+			            sector_size) {
+				// leave this sector to the synchronous path
+				current_fpos = -1;
+				continue;
+			}
+			// the emulation thread has to reseek after our read
+			current_fpos = -1;
+			last_action  = READ;
+		}
+		if (!prefetch_completions.Enqueue(std::move(job))) {
+			break; // the queue was stopped
+		}
+	}
+}
+
+void imageDisk::StopReadAhead()
+{
+	if (prefetch_worker.joinable()) {
+		prefetch_requests.Stop();
+		prefetch_completions.Stop();
+		prefetch_worker.join();
+	}
+}
+
 uint8_t imageDisk::Write_Sector(uint32_t head,uint32_t cylinder,uint32_t sector,void * data) {
 	uint32_t sectnum;
 
@@ -190,10 +354,31 @@ uint8_t imageDisk::Write_Sector(uint32_t head,uint32_t cylinder,uint32_t sector,
 
 
 uint8_t imageDisk::Write_AbsoluteSector(uint32_t sectnum, void *data) {
-	const auto bytenum = check_cast<cross_off_t>(sectnum) * sector_size;
-
 	//LOG_MSG("Writing sectors to %ld at bytenum %d", sectnum, bytenum);
 
+	// Drop the cached copy of this sector (if any); in-flight prefetches
+	// are invalidated by WriteSectorToImage once the file is rewritten
+	if (read_ahead_sectors > 0) {
+		sector_cache.erase(sectnum);
+	}
+
+	if (flush_interval_ms > 0) {
+		++num_cached_writes;
+		auto& sector = dirty_sectors[sectnum];
+		sector.assign(static_cast<const uint8_t*>(data),
+		              static_cast<const uint8_t*>(data) + sector_size);
+		MaybeFlushWriteCache();
+		return 0x00;
+	}
+
+	return WriteSectorToImage(sectnum, data);
+}
+
+uint8_t imageDisk::WriteSectorToImage(const uint32_t sectnum, const void* data)
+{
+	const auto bytenum = check_cast<cross_off_t>(sectnum) * sector_size;
+
+	std::lock_guard<std::mutex> lock(file_mutex);
 	if (last_action == READ || bytenum != current_fpos) {
 		if (cross_fseeko(diskimg, bytenum, SEEK_SET) != 0) {
 			LOG_ERR("BIOSDISK: Could not seek to byte %lld in file '%s': %s",
@@ -207,10 +392,59 @@ uint8_t imageDisk::Write_AbsoluteSector(uint32_t sectnum, void *data) {
 	current_fpos=bytenum+ret;
 	last_action=WRITE;
 
+	// Invalidate in-flight prefetches only after the new contents are in
+	// the file and while still holding file_mutex: a worker that sampled
+	// the generation earlier could otherwise read the old data under the
+	// lock, get tagged with the bumped generation, and slip its stale
+	// copy into the sector cache
+	if (read_ahead_sectors > 0) {
+		++write_generation;
+	}
+
 	return ((ret>0)?0x00:0x05);
 
 }
 
+void imageDisk::MaybeFlushWriteCache()
+{
+	if (GetTicksSince(last_flush_tick) >= flush_interval_ms) {
+		FlushWriteCache();
+	}
+}
+
+void imageDisk::FlushWriteCache()
+{
+	last_flush_tick = GetTicks();
+	if (dirty_sectors.empty()) {
+		return;
+	}
+
+	// std::map iterates in ascending sector order, so the host sees the
+	// dirty sectors as one mostly-sequential sweep
+	for (const auto& [sectnum, data] : dirty_sectors) {
+		WriteSectorToImage(sectnum, data.data());
+		if (read_ahead_sectors > 0) {
+			sector_cache.erase(sectnum);
+		}
+	}
+	num_sectors_flushed += dirty_sectors.size();
+	dirty_sectors.clear();
+
+	std::lock_guard<std::mutex> lock(file_mutex);
+	fflush(diskimg);
+}
+
+void imageDisk::LogWriteCacheStats()
+{
+	if (num_cached_writes > 0) {
+		LOG_MSG("BIOSDISK: Coalesced %" PRIu64 " guest sector writes into %" PRIu64
+		        " host writes for '%s'",
+		        num_cached_writes, num_sectors_flushed, diskname);
+		num_cached_writes   = 0;
+		num_sectors_flushed = 0;
+	}
+}
+
 imageDisk::imageDisk(FILE *img_file, const char *img_name, uint32_t img_size_k, bool is_hdd)
         : hardDrive(is_hdd),
           active(false),
@@ -250,6 +484,15 @@ imageDisk::imageDisk(FILE *img_file, const char *img_name, uint32_t img_size_k,
 			incrementFDD();
 		}
 	}
+
+	const auto section = static_cast<Section_prop *>(control->GetSection("dos"));
+	read_ahead_sectors = section ? section->Get_int("disk_read_ahead_sectors") : 0;
+	flush_interval_ms = section ? section->Get_int("disk_flush_interval_ms") : 0;
+	last_flush_tick   = GetTicks();
+	if (read_ahead_sectors > 0) {
+		prefetch_worker = std::thread(&imageDisk::PrefetchWorkerLoop, this);
+		set_thread_name(prefetch_worker, "dosbox:diskpre");
+	}
 }
 
 void imageDisk::Set_Geometry(uint32_t setHeads, uint32_t setCyl, uint32_t setSect, uint32_t setSectSize) {
@@ -410,6 +653,35 @@ static Bitu INT13_DiskHandler(void) {
 
 		segat = SegValue(es);
 		bufptr = reg_bx;
+
+		// The CHS-to-LBA formula is linear in the sector number, so the
+		// whole run maps to consecutive sectors and can be done as one
+		// host read followed by one block copy into guest memory - as
+		// long as the guest buffer doesn't wrap inside the segment.
+		if (static_cast<uint32_t>(bufptr) + reg_al * 512 <= 0x10000) {
+			std::vector<uint8_t> xfer_buf(reg_al * 512);
+			last_status = imageDiskList[drivenum]->Read_Sectors(
+			        (uint32_t)reg_dh,
+			        (uint32_t)(reg_ch | ((reg_cl & 0xc0) << 2)),
+			        (uint32_t)(reg_cl & 63),
+			        reg_al,
+			        xfer_buf.data());
+			if ((last_status != 0x00) || (killRead)) {
+				LOG_MSG("Error in disk read");
+				killRead = false;
+				reg_ah = 0x04;
+				CALLBACK_SCF(true);
+				return CBRET_NONE;
+			}
+			MEM_BlockWrite(PhysicalMake(segat, bufptr),
+			               xfer_buf.data(),
+			               xfer_buf.size());
+			reg_ah = 0x00;
+			CALLBACK_SCF(false);
+			break;
+		}
+
+		// Wrapping guest buffers take the per-sector, per-byte path
 		for (Bitu i = 0; i < reg_al; i++) {
 			last_status = imageDiskList[drivenum]->Read_Sector((uint32_t)reg_dh, (uint32_t)(reg_ch | ((reg_cl & 0xc0)<< 2)), (uint32_t)((reg_cl & 63)+i), sectbuf);
 			if((last_status != 0x00) || (killRead)) {
@@ -20,6 +20,7 @@
 #include "bios.h"
 
 #include "callback.h"
+#include "cpu.h"
 #include "mem.h"
 #include "keyboard.h"
 #include "regs.h"
@@ -538,6 +539,7 @@ static Bitu INT16_Handler(void) {
 		} else {
 			/* enter small idle loop to allow for irqs to happen */
 			reg_ip+=1;
+			CPU_NotifyIdle();
 		}
 		break;
 	case 0x10: /* GET KEYSTROKE (enhanced keyboards only) */
@@ -550,6 +552,7 @@ static Bitu INT16_Handler(void) {
 		} else {
 			/* enter small idle loop to allow for irqs to happen */
 			reg_ip+=1;
+			CPU_NotifyIdle();
 		}
 		break;
 	case 0x01: /* CHECK FOR KEYSTROKE */
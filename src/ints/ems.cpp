@@ -20,8 +20,10 @@
 #include "dosbox.h"
 
 #include <algorithm>
+#include <cinttypes>
 #include <cstring>
 #include <cstdlib>
+#include <vector>
 
 #include "callback.h"
 #include "mem.h"
@@ -92,6 +94,12 @@ struct EMM_Handle {
 	char name[8];
 	bool saved_page_map;
 	EMM_Mapping page_map[EMM_MAX_PHYS];
+
+	/* The 4kb memory pages backing this handle, in logical order, so a
+	   remap doesn't have to walk the MemHandle chain from the start for
+	   every map. Rebuilt on demand; cleared whenever the allocation
+	   changes. */
+	std::vector<MemHandle> page_list;
 };
 
 static Bitu ems_type;
@@ -284,6 +292,7 @@ static uint8_t EMM_AllocateMemory(uint16_t pages,uint16_t & dhandle,bool can_all
 	}
 	emm_handles[handle].pages = pages;
 	emm_handles[handle].mem = mem;
+	emm_handles[handle].page_list.clear();
 	/* Change handle only if there is no error. */
 	dhandle = handle;
 	return EMM_NO_ERROR;
@@ -301,6 +310,7 @@ static uint8_t EMM_AllocateSystemHandle(uint16_t pages) {
 	if (!mem) E_Exit("EMS:System handle memory allocation failure");
 	emm_handles[handle].pages = pages;
 	emm_handles[handle].mem = mem;
+	emm_handles[handle].page_list.clear();
 	return EMM_NO_ERROR;
 }
 
@@ -317,9 +327,38 @@ static uint8_t EMM_ReallocatePages(uint16_t handle,uint16_t & pages) {
 	}
 	/* Update size */
 	emm_handles[handle].pages=pages;
+	emm_handles[handle].page_list.clear();
 	return EMM_NO_ERROR;
 }
 
+/* Total 16kb page-frame remaps, reported at shutdown; EMS-heavy titles flip
+   mappings thousands of times per second */
+static uint64_t emm_page_maps = 0;
+
+/* PAGING_MapPage already unlinks the remapped first-megabyte pages from the
+   TLB; when the guest has paging enabled its page tables may additionally
+   alias the page frame at other linear addresses, so also drop the linked
+   TLB entries resolving into the four remapped 4kb pages. */
+static void EMM_FlushTLB(const Bitu first_page) {
+	if (PAGING_Enabled()) PAGING_UnlinkPhysPages(first_page,4);
+}
+
+/* Flat per-handle list of the backing 4kb pages; walking the MemHandle
+   chain from the start on every remap is the dominant cost of a map call */
+static const std::vector<MemHandle>& EMM_GetPageList(const uint16_t handle) {
+	auto& list = emm_handles[handle].page_list;
+	const size_t num_pages = emm_handles[handle].pages * 4u;
+	if (list.size() != num_pages) {
+		list.resize(num_pages);
+		MemHandle memh = emm_handles[handle].mem;
+		for (auto& page : list) {
+			page = memh;
+			memh = MEM_NextHandle(memh);
+		}
+	}
+	return list;
+}
+
 static uint8_t EMM_MapPage(Bitu phys_page,uint16_t handle,uint16_t log_page) {
 //	LOG_MSG("EMS MapPage handle %d phys %d log %d",handle,phys_page,log_page);
 	/* Check for too high physical page */
@@ -332,7 +371,8 @@ static uint8_t EMM_MapPage(Bitu phys_page,uint16_t handle,uint16_t log_page) {
 		emm_mappings[phys_page].page=NULL_PAGE;
 		for (Bitu i=0;i<4;i++)
 			PAGING_MapPage(EMM_PAGEFRAME4K+phys_page*4+i,EMM_PAGEFRAME4K+phys_page*4+i);
-		PAGING_ClearTLB();
+		EMM_FlushTLB(EMM_PAGEFRAME4K+phys_page*4);
+		++emm_page_maps;
 		return EMM_NO_ERROR;
 	}
 	/* Check for valid handle */
@@ -343,12 +383,11 @@ static uint8_t EMM_MapPage(Bitu phys_page,uint16_t handle,uint16_t log_page) {
 		emm_mappings[phys_page].handle=handle;
 		emm_mappings[phys_page].page=log_page;
 
-		MemHandle memh=MEM_NextHandleAt(emm_handles[handle].mem,log_page*4);;
-		for (Bitu i=0;i<4;i++) {
-			PAGING_MapPage(EMM_PAGEFRAME4K+phys_page*4+i,memh);
-			memh=MEM_NextHandle(memh);
-		}
-		PAGING_ClearTLB();
+		const auto& page_list=EMM_GetPageList(handle);
+		for (Bitu i=0;i<4;i++)
+			PAGING_MapPage(EMM_PAGEFRAME4K+phys_page*4+i,page_list[log_page*4u+i]);
+		EMM_FlushTLB(EMM_PAGEFRAME4K+phys_page*4);
+		++emm_page_maps;
 		return EMM_NO_ERROR;
 	} else  {
 		/* Illegal logical page it is */
@@ -390,7 +429,8 @@ static uint8_t EMM_MapSegment(Bitu segment,uint16_t handle,uint16_t log_page) {
 			}
 			for (Bitu i=0;i<4;i++)
 				PAGING_MapPage(segment*16/4096+i,segment*16/4096+i);
-			PAGING_ClearTLB();
+			EMM_FlushTLB(segment*16/4096);
+			++emm_page_maps;
 			return EMM_NO_ERROR;
 		}
 		/* Check for valid handle */
@@ -406,12 +446,11 @@ static uint8_t EMM_MapSegment(Bitu segment,uint16_t handle,uint16_t log_page) {
 				emm_segmentmappings[segment>>10].page=log_page;
 			}
 
-			MemHandle memh=MEM_NextHandleAt(emm_handles[handle].mem,log_page*4);;
-			for (Bitu i=0;i<4;i++) {
-				PAGING_MapPage(segment*16/4096+i,memh);
-				memh=MEM_NextHandle(memh);
-			}
-			PAGING_ClearTLB();
+			const auto& page_list=EMM_GetPageList(handle);
+			for (Bitu i=0;i<4;i++)
+				PAGING_MapPage(segment*16/4096+i,page_list[log_page*4u+i]);
+			EMM_FlushTLB(segment*16/4096);
+			++emm_page_maps;
 			return EMM_NO_ERROR;
 		} else  {
 			/* Illegal logical page it is */
@@ -435,6 +474,7 @@ static uint8_t EMM_ReleaseMemory(uint16_t handle) {
 	}
 	/* Reset handle */
 	emm_handles[handle].mem=0;
+	emm_handles[handle].page_list.clear();
 	if (handle==0) {
 		emm_handles[handle].pages=0;	// OS handle is NEVER deallocated
 	} else {
@@ -1515,6 +1555,12 @@ public:
 	~EMS() {
 		if (ems_type<=0) return;
 
+		if (emm_page_maps > 0) {
+			LOG_MSG("EMS: Performed %" PRIu64 " page-frame remaps",
+			        emm_page_maps);
+			emm_page_maps = 0;
+		}
+
 		/* Undo Biosclearing */
 		BIOS_ZeroExtendedSize(false);
 
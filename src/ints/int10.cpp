@@ -731,6 +731,11 @@ static void SetupTandyBios(void) {
 	}
 }
 
+bool INT10_VectorIsDefault()
+{
+	return RealGetVec(0x10) == CALLBACK_RealPointer(call_10);
+}
+
 void INT10_Init(Section* /*sec*/) {
 	INT10_SetupPalette();
 	INT10_InitVGA();
@@ -110,11 +110,11 @@ constexpr uint16_t MaxVesaBiosModeNumber = 0x7ff;
 uint16_t INT10_GetTextColumns();
 uint16_t INT10_GetTextRows();
 
-extern uint8_t int10_font_08[256 * 8];
-extern uint8_t int10_font_14[256 * 14];
-extern uint8_t int10_font_16[256 * 16];
-extern uint8_t int10_font_14_alternate[20 * 15 + 1];
-extern uint8_t int10_font_16_alternate[19 * 17 + 1];
+extern const uint8_t int10_font_08[256 * 8];
+extern const uint8_t int10_font_14[256 * 14];
+extern const uint8_t int10_font_16[256 * 16];
+extern const uint8_t int10_font_14_alternate[20 * 15 + 1];
+extern const uint8_t int10_font_16_alternate[19 * 17 + 1];
 
 struct palette_t {
 	// 64 entries
@@ -251,6 +251,17 @@ void INT10_TeletypeOutputAttrViaInterrupt(const uint8_t char_value,
                                           const uint8_t attribute,
                                           const bool use_attribute);
 
+// Writes a run of printable characters with a single cursor update at the
+// end, much faster than per-character teletype calls. Only safe when the
+// INT 10h vector is unhooked (see INT10_VectorIsDefault), as it bypasses
+// the interrupt.
+void INT10_TeletypeOutputBlock(const uint8_t* chars, uint16_t count,
+                               const uint8_t attribute);
+
+// Returns true if the INT 10h vector still points at the BIOS handler,
+// i.e. no TSR or program has hooked video output
+bool INT10_VectorIsDefault();
+
 void INT10_ReadCharAttr(uint16_t* result, uint8_t page);
 
 void INT10_WriteChar(const uint8_t char_value, const uint8_t attribute,
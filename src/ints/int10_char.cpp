@@ -21,6 +21,8 @@
 
 #include "int10.h"
 
+#include <vector>
+
 #include "bios.h"
 #include "callback.h"
 #include "inout.h"
@@ -106,6 +108,49 @@ static void TEXT_CopyRow(uint8_t cleft,uint8_t cright,uint8_t rold,uint8_t rnew,
 	MEM_BlockCopy(dest,src,(cright-cleft)*2);
 }
 
+/* Move a span through a bounce buffer; scroll regions overlap and the
+   block copy primitives only copy forward */
+static void MoveRowSpan(PhysPt dest,PhysPt src,Bitu bytes) {
+	std::vector<uint8_t> scratch(bytes);
+	MEM_BlockRead(src,scratch.data(),bytes);
+	MEM_BlockWrite(dest,scratch.data(),bytes);
+}
+
+/* Full-width rows are adjacent in memory (per bank on the interleaved
+   layouts), so a whole-window scroll is one block move per bank */
+static void TEXT_CopyRows(uint8_t rold,uint8_t rnew,uint8_t rows,PhysPt base) {
+	MoveRowSpan(base+(rnew*CurMode->twidth)*2,
+	            base+(rold*CurMode->twidth)*2,
+	            rows*CurMode->twidth*2);
+}
+
+static void CGA2_CopyRows(uint8_t rold,uint8_t rnew,uint8_t rows,PhysPt base) {
+	BIOS_CHEIGHT;
+	PhysPt dest=base+(CurMode->twidth*rnew)*(cheight/2);
+	PhysPt src=base+(CurMode->twidth*rold)*(cheight/2);
+	Bitu bytes=rows*CurMode->twidth*(cheight/2);
+	MoveRowSpan(dest,src,bytes);
+	MoveRowSpan(dest+8*1024,src+8*1024,bytes);
+}
+
+static void CGA4_CopyRows(uint8_t rold,uint8_t rnew,uint8_t rows,PhysPt base) {
+	BIOS_CHEIGHT;
+	PhysPt dest=base+((CurMode->twidth*rnew)*(cheight/2))*2;
+	PhysPt src=base+((CurMode->twidth*rold)*(cheight/2))*2;
+	Bitu bytes=rows*CurMode->twidth*(cheight/2)*2;
+	MoveRowSpan(dest,src,bytes);
+	MoveRowSpan(dest+8*1024,src+8*1024,bytes);
+}
+
+static void TANDY16_CopyRows(uint8_t rold,uint8_t rnew,uint8_t rows,PhysPt base) {
+	BIOS_CHEIGHT;
+	uint8_t banks=CurMode->twidth/10;
+	PhysPt dest=base+((CurMode->twidth*rnew)*(cheight/banks))*4;
+	PhysPt src=base+((CurMode->twidth*rold)*(cheight/banks))*4;
+	Bitu bytes=rows*CurMode->twidth*(cheight/banks)*4;
+	for (Bitu b=0;b<banks;b++) MoveRowSpan(dest+b*8*1024,src+b*8*1024,bytes);
+}
+
 static void CGA2_FillRow(uint8_t cleft,uint8_t cright,uint8_t row,PhysPt base,uint8_t attr) {
 	BIOS_CHEIGHT;
 	PhysPt dest=base+((CurMode->twidth*row)*(cheight/2)+cleft);
@@ -191,6 +236,45 @@ static void TEXT_FillRow(uint8_t cleft,uint8_t cright,uint8_t row,PhysPt base,ui
 	}
 }
 
+/* Full-width counterparts of the fill helpers above: build the pattern
+   host-side once and write the whole window as a block per bank */
+static void TEXT_FillRows(uint8_t row,uint8_t rows,PhysPt base,uint8_t attr) {
+	uint16_t fill=(attr<<8)+' ';
+	Bitu cells=rows*CurMode->twidth;
+	std::vector<uint16_t> scratch(cells,fill);
+	MEM_BlockWrite(base+(row*CurMode->twidth)*2,scratch.data(),cells*2);
+}
+
+static void CGA2_FillRows(uint8_t row,uint8_t rows,PhysPt base,uint8_t attr) {
+	BIOS_CHEIGHT;
+	PhysPt dest=base+(CurMode->twidth*row)*(cheight/2);
+	attr=(attr & 0x3) | ((attr & 0x3) << 2) | ((attr & 0x3) << 4) | ((attr & 0x3) << 6);
+	Bitu bytes=rows*CurMode->twidth*(cheight/2);
+	std::vector<uint8_t> scratch(bytes,attr);
+	MEM_BlockWrite(dest,scratch.data(),bytes);
+	MEM_BlockWrite(dest+8*1024,scratch.data(),bytes);
+}
+
+static void CGA4_FillRows(uint8_t row,uint8_t rows,PhysPt base,uint8_t attr) {
+	BIOS_CHEIGHT;
+	PhysPt dest=base+((CurMode->twidth*row)*(cheight/2))*2;
+	attr=(attr & 0x3) | ((attr & 0x3) << 2) | ((attr & 0x3) << 4) | ((attr & 0x3) << 6);
+	Bitu bytes=rows*CurMode->twidth*(cheight/2)*2;
+	std::vector<uint8_t> scratch(bytes,attr);
+	MEM_BlockWrite(dest,scratch.data(),bytes);
+	MEM_BlockWrite(dest+8*1024,scratch.data(),bytes);
+}
+
+static void TANDY16_FillRows(uint8_t row,uint8_t rows,PhysPt base,uint8_t attr) {
+	BIOS_CHEIGHT;
+	uint8_t banks=CurMode->twidth/10;
+	PhysPt dest=base+((CurMode->twidth*row)*(cheight/banks))*4;
+	attr=(attr & 0xf) | (attr & 0xf) << 4;
+	Bitu bytes=rows*CurMode->twidth*(cheight/banks)*4;
+	std::vector<uint8_t> scratch(bytes,attr);
+	for (Bitu b=0;b<banks;b++) MEM_BlockWrite(dest+b*8*1024,scratch.data(),bytes);
+}
+
 uint16_t INT10_GetTextColumns()
 {
 	return real_readw(BIOSMEM_SEG, BIOSMEM_NB_COLS);
@@ -235,6 +319,10 @@ void INT10_ScrollWindow(uint8_t rul,uint8_t cul,uint8_t rlr,uint8_t clr,int8_t n
 
 	/* See how much lines need to be copied */
 	uint8_t start,end;Bits next;
+	/* A full-width window covers contiguous rows, so the common
+	   whole-screen scroll can move and fill in blocks instead of going
+	   through the paging layer cell by cell */
+	bool fullwidth=(cul==0 && clr==ncols);
 	/* Copy some lines */
 	if (nlines>0) {
 		start=rlr-nlines+1;
@@ -248,6 +336,25 @@ void INT10_ScrollWindow(uint8_t rul,uint8_t cul,uint8_t rlr,uint8_t clr,int8_t n
 		nlines=rlr-rul+1;
 		goto filling;
 	}
+	if (fullwidth) {
+		Bits rows=rlr-rul+1-(nlines>0?nlines:-nlines);
+		if (rows>0) {
+			uint8_t rold=(nlines>0)?(uint8_t)(rul+nlines):rul;
+			uint8_t rnew=(nlines>0)?rul:(uint8_t)(rul-nlines);
+			switch (CurMode->type) {
+			case M_TEXT:
+				TEXT_CopyRows(rold,rnew,(uint8_t)rows,base);goto filling;
+			case M_CGA2:
+				CGA2_CopyRows(rold,rnew,(uint8_t)rows,base);goto filling;
+			case M_CGA4:
+				CGA4_CopyRows(rold,rnew,(uint8_t)rows,base);goto filling;
+			case M_TANDY16:
+				TANDY16_CopyRows(rold,rnew,(uint8_t)rows,base);goto filling;
+			default:
+				break; /* per-row path below */
+			}
+		}
+	}
 	while (start!=end) {
 		start+=next;
 		switch (CurMode->type) {
@@ -282,6 +389,20 @@ filling:
 		nlines=-nlines;
 		start=rlr-nlines+1;
 	}
+	if (fullwidth) {
+		switch (CurMode->type) {
+		case M_TEXT:
+			TEXT_FillRows(start,(uint8_t)nlines,base,attr);return;
+		case M_CGA2:
+			CGA2_FillRows(start,(uint8_t)nlines,base,attr);return;
+		case M_CGA4:
+			CGA4_FillRows(start,(uint8_t)nlines,base,attr);return;
+		case M_TANDY16:
+			TANDY16_FillRows(start,(uint8_t)nlines,base,attr);return;
+		default:
+			break; /* per-row path below */
+		}
+	}
 	for (;nlines>0;nlines--) {
 		switch (CurMode->type) {
 		case M_TEXT:
@@ -840,6 +961,49 @@ void INT10_TeletypeOutput(uint8_t chr,uint8_t attr) {
 	INT10_TeletypeOutputAttr(chr,attr,CurMode->type!=M_TEXT);
 }
 
+void INT10_TeletypeOutputBlock(const uint8_t* chars, uint16_t count,
+                               const uint8_t attribute)
+{
+	const auto page    = real_readb(BIOSMEM_SEG, BIOSMEM_CURRENT_PAGE);
+	const bool useattr = CurMode->type != M_TEXT;
+
+	BIOS_NCOLS;
+	BIOS_NROWS;
+	uint8_t cur_row = CURSOR_POS_ROW(page);
+	uint8_t cur_col = CURSOR_POS_COL(page);
+
+	while (count--) {
+		WriteChar(cur_col, cur_row, page, *chars++, attribute, useattr);
+		if (++cur_col < ncols) {
+			continue;
+		}
+		cur_col = 0;
+		if (++cur_row < nrows) {
+			continue;
+		}
+		// Mirror the per-character teletype path: scroll up one line,
+		// filling with the attribute at the cursor position
+		INT10_SetCursorPos(static_cast<uint8_t>(nrows - 1),
+		                   static_cast<uint8_t>(ncols - 1),
+		                   page);
+		uint8_t fill = 0;
+		if (CurMode->type == M_TEXT) {
+			uint16_t chat;
+			INT10_ReadCharAttr(&chat, page);
+			fill = static_cast<uint8_t>(chat >> 8);
+		}
+		INT10_ScrollWindow(0,
+		                   0,
+		                   static_cast<uint8_t>(nrows - 1),
+		                   static_cast<uint8_t>(ncols - 1),
+		                   -1,
+		                   fill,
+		                   page);
+		cur_row--;
+	}
+	INT10_SetCursorPos(cur_row, cur_col, page);
+}
+
 void INT10_TeletypeOutputViaInterrupt(const uint8_t char_value, const uint8_t attribute)
 {
 	constexpr uint8_t teletype_cmd = 0xE;
@@ -740,11 +740,26 @@ static void FinishSetMode(bool clearmem) {
 		case M_HERC_GFX:
 		case M_CGA2_COMPOSITE:
 		case M_CGA4_COMPOSITE:
-		case M_CGA_TEXT_COMPOSITE:
+		case M_CGA_TEXT_COMPOSITE: {
 			//  Hack we just access the memory directly
-			memset(vga.mem.linear,0,vga.vmemsize);
-			memset(vga.fastmem, 0, vga.vmemsize<<1);
+			//
+			// Legacy modes can only reach the first 256 KB (four
+			// 64 KB planes), which is also all a real BIOS clears;
+			// wiping the full SVGA framebuffer costs milliseconds
+			// per switch on titles that flip modes per screen.
+			// VESA modes keep the full clear as guests use the
+			// whole framebuffer for off-screen pages.
+			constexpr uint32_t legacy_window_bytes = 256 * 1024;
+
+			const auto clear_bytes =
+			        (CurMode->mode < MinVesaBiosModeNumber)
+			                ? std::min(vga.vmemsize, legacy_window_bytes)
+			                : vga.vmemsize;
+
+			memset(vga.mem.linear, 0, clear_bytes);
+			memset(vga.fastmem, 0, clear_bytes << 1);
 			break;
+		}
 		case M_ERROR:
 			assert(false);
 			break;
@@ -1092,6 +1107,10 @@ bool INT10_SetVideoMode(uint16_t mode)
 	if (mono_mode) crtc_base=0x3b4;
 	else crtc_base=0x3d4;
 
+	// The register program below reconfigures the memory layout several
+	// times over; batch it so the handlers are rebuilt only once
+	VGA_BeginModeProgram();
+
 	if (IS_VGA_ARCH && (svgaCard == SVGA_S3Trio)) {
 		// Disable MMIO here so we can read / write memory
 		IO_Write(crtc_base,0x53);
@@ -1880,6 +1899,10 @@ dac_text16:
 		svga.set_video_mode(crtc_base, &modeData);
 	}
 
+	// FinishSetMode accesses video memory, so the final handler layout
+	// must be in place before it runs
+	VGA_EndModeProgram();
+
 	FinishSetMode(clearmem);
 
 	//  Set vga attrib register into defined state
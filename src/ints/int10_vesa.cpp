@@ -19,6 +19,7 @@
 
 #include "int10.h"
 
+#include <map>
 #include <string.h>
 #include <stddef.h>
 
@@ -193,14 +194,14 @@ static bool can_triple_buffer_8bit(const VideoModeBlock &m)
 	return vga.vmemsize >= needed_bytes;
 }
 
-uint8_t VESA_GetSVGAModeInformation(uint16_t mode,uint16_t seg,uint16_t off) {
-	MODE_INFO minfo;
+// Builds the information block for a (pre-masked) mode number. All inputs
+// are fixed after machine init, so the result is cacheable per mode.
+static uint8_t build_svga_mode_info(const uint16_t mode, MODE_INFO& minfo)
+{
 	memset(&minfo,0,sizeof(minfo));
-	PhysPt buf=PhysicalMake(seg,off);
 	int modePageSize = 0;
 	uint8_t modeAttributes;
 
-	mode&=0x3fff;	// vbe2 compatible, ignore lfb and keep screen content bits
 	if (mode < MinVesaBiosModeNumber) {
 		return 0x01;
 	}
@@ -377,10 +378,49 @@ uint8_t VESA_GetSVGAModeInformation(uint16_t mode,uint16_t seg,uint16_t off) {
 	if (!int10.vesa_nolfb)
 		minfo.PhysBasePtr = host_to_le32(PciGfxLfbBase);
 
-	MEM_BlockWrite(buf,&minfo,sizeof(MODE_INFO));
 	return VESA_SUCCESS;
 }
 
+// Prebuilt information blocks; filled from the mode list at machine init
+// and answered with a single block copy. SciTech UNIVBE-style loaders
+// query every mode at startup and again on each mode change.
+static std::map<uint16_t, MODE_INFO> mode_info_cache = {};
+
+static void VESA_PrebuildSVGAModeInfoCache()
+{
+	mode_info_cache.clear();
+	for (const auto& v : ModeList_VGA) {
+		if (v.mode < MinVesaBiosModeNumber || v.mode == 0xffff) {
+			continue;
+		}
+		MODE_INFO minfo;
+		if (build_svga_mode_info(v.mode, minfo) == VESA_SUCCESS) {
+			mode_info_cache.emplace(v.mode, minfo);
+		}
+	}
+}
+
+uint8_t VESA_GetSVGAModeInformation(uint16_t mode, uint16_t seg, uint16_t off)
+{
+	mode &= 0x3fff; // vbe2 compatible, ignore lfb and keep screen content bits
+
+	const auto it = mode_info_cache.find(mode);
+	if (it != mode_info_cache.end()) {
+		MEM_BlockWrite(PhysicalMake(seg, off), &it->second, sizeof(MODE_INFO));
+		return VESA_SUCCESS;
+	}
+
+	// Unknown or rejected modes still get the full (failing) lookup so
+	// the returned status matches an uncached implementation
+	MODE_INFO minfo;
+	const auto status = build_svga_mode_info(mode, minfo);
+	if (status == VESA_SUCCESS) {
+		mode_info_cache.emplace(mode, minfo);
+		MEM_BlockWrite(PhysicalMake(seg, off), &minfo, sizeof(MODE_INFO));
+	}
+	return status;
+}
+
 uint8_t VESA_SetSVGAMode(uint16_t mode) {
 	if (INT10_SetVideoMode(mode)) {
 		int10.vesa_setmode=mode&0x7fff;
@@ -747,4 +787,8 @@ void INT10_SetupVESA(void) {
 	/* Finalize the size and clear the required ports pointer */
 	phys_writew( RealToPhysical(int10.rom.pmode_interface) + 6, 0);
 	int10.rom.pmode_interface_size=int10.rom.used - RealOffset( int10.rom.pmode_interface );
+
+	// The set_window callback address above is baked into the mode
+	// information blocks, so the cache can only be built now
+	VESA_PrebuildSVGAModeInfoCache();
 }
@@ -30,6 +30,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assert.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #define MAYBE_UNUSED(x) (void)(x)
 
 // ============================================================================
@@ -949,6 +955,166 @@ void YM7128B_ChipIdeal_Process(
 
 // ----------------------------------------------------------------------------
 
+//! Accumulates one tap's contribution to both output channels; the delay
+//! line addresses descend by one per output sample, i.e. the tap reads a
+//! reversed contiguous run of the buffer.
+YM7128B_INLINE
+void YM7128B_ChipIdeal_AccumulateTapRun(
+    YM7128B_Float const* buffer,
+    YM7128B_TapIdeal head,
+    YM7128B_Float gl,
+    YM7128B_Float gr,
+    YM7128B_Float* out_l,
+    YM7128B_Float* out_r,
+    YM7128B_TapIdeal count
+)
+{
+    YM7128B_TapIdeal i = 0;
+#if defined(__SSE2__)
+    __m128 const vgl = _mm_set1_ps(gl);
+    __m128 const vgr = _mm_set1_ps(gr);
+    for (; i + 4 <= count; i += 4) {
+        __m128 v = _mm_loadu_ps(&buffer[head - i - 3]);
+        v = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 1, 2, 3));
+        __m128 l = _mm_add_ps(_mm_loadu_ps(&out_l[i]), _mm_mul_ps(v, vgl));
+        __m128 r = _mm_add_ps(_mm_loadu_ps(&out_r[i]), _mm_mul_ps(v, vgr));
+        _mm_storeu_ps(&out_l[i], l);
+        _mm_storeu_ps(&out_r[i], r);
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t const vgl = vdupq_n_f32(gl);
+    float32x4_t const vgr = vdupq_n_f32(gr);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t v = vld1q_f32(&buffer[head - i - 3]);
+        v = vrev64q_f32(v);
+        v = vcombine_f32(vget_high_f32(v), vget_low_f32(v));
+        vst1q_f32(&out_l[i], vaddq_f32(vld1q_f32(&out_l[i]), vmulq_f32(v, vgl)));
+        vst1q_f32(&out_r[i], vaddq_f32(vld1q_f32(&out_r[i]), vmulq_f32(v, vgr)));
+    }
+#endif
+    for (; i < count; ++i) {
+        YM7128B_Float buffered = buffer[head - i];
+        out_l[i] += YM7128B_MulFloat(buffered, gl);
+        out_r[i] += YM7128B_MulFloat(buffered, gr);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+//! Processes a chunk small enough that no in-chunk write can evict a delay
+//! line entry an output tap still has to read (see the chunk bound in
+//! YM7128B_ChipIdeal_Process_Block()).
+static void YM7128B_ChipIdeal_Process_Chunk(
+    YM7128B_ChipIdeal* self,
+    YM7128B_Float const* inputs,
+    YM7128B_Float* outputs_left,
+    YM7128B_Float* outputs_right,
+    YM7128B_TapIdeal count
+)
+{
+    // First pass: the feedback path is a serial recurrence, so run it
+    // sample by sample to fill the delay line for the whole chunk
+    for (YM7128B_TapIdeal i = 0; i < count; ++i) {
+        YM7128B_Float sample = inputs[i];
+
+        YM7128B_TapIdeal t0 = self->tail_ + self->taps_[0];
+        YM7128B_TapIdeal filter_head = (t0 >= self->length_) ? (t0 - self->length_) : t0;
+        YM7128B_Float filter_t0  = self->buffer_[filter_head];
+        YM7128B_Float filter_d   = self->t0_d_;
+        self->t0_d_ = filter_t0;
+        YM7128B_Float filter_c0  = YM7128B_MulFloat(filter_t0, self->gains_[YM7128B_Reg_C0]);
+        YM7128B_Float filter_c1  = YM7128B_MulFloat(filter_d, self->gains_[YM7128B_Reg_C1]);
+        YM7128B_Float filter_sum = YM7128B_AddFloat(filter_c0, filter_c1);
+        YM7128B_Float filter_vc  = YM7128B_MulFloat(filter_sum, self->gains_[YM7128B_Reg_VC]);
+
+        YM7128B_Float input_vm  = YM7128B_MulFloat(sample, self->gains_[YM7128B_Reg_VM]);
+        YM7128B_Float input_sum = YM7128B_AddFloat(input_vm, filter_vc);
+
+        self->tail_ = self->tail_ ? (self->tail_ - 1) : (self->length_ - 1);
+        self->buffer_[self->tail_] = input_sum;
+    }
+
+    for (YM7128B_TapIdeal i = 0; i < count; ++i) {
+        outputs_left[i] = 0;
+        outputs_right[i] = 0;
+    }
+
+    // Second pass: accumulate the output taps tap-major; per tap the reads
+    // walk the delay line one entry backwards per sample, giving reversed
+    // contiguous runs between ring wrap-arounds. Each sample still sums the
+    // taps in the same order as the per-sample code.
+    for (YM7128B_Register tap = 1; tap < YM7128B_Tap_Count; ++tap) {
+        YM7128B_Float gl = self->gains_[YM7128B_Reg_GL1 + tap - 1];
+        YM7128B_Float gr = self->gains_[YM7128B_Reg_GR1 + tap - 1];
+
+        // Head position for the first (oldest) sample of the chunk
+        YM7128B_TapIdeal h = (self->tail_ + (count - 1) + self->taps_[tap]) % self->length_;
+        YM7128B_TapIdeal i = 0;
+        while (i < count) {
+            YM7128B_TapIdeal run = h + 1;
+            if (run > count - i) {
+                run = count - i;
+            }
+            YM7128B_ChipIdeal_AccumulateTapRun(
+                self->buffer_, h, gl, gr,
+                &outputs_left[i], &outputs_right[i], run);
+            i += run;
+            h = (run > h) ? (self->length_ - 1) : (h - run);
+        }
+    }
+
+    YM7128B_Float og = 1 / (YM7128B_Float)YM7128B_Oversampling;
+    YM7128B_Float vl = self->gains_[YM7128B_Reg_VL];
+    YM7128B_Float vr = self->gains_[YM7128B_Reg_VR];
+    for (YM7128B_TapIdeal i = 0; i < count; ++i) {
+        outputs_left[i]  = YM7128B_MulFloat(YM7128B_MulFloat(outputs_left[i], vl), og);
+        outputs_right[i] = YM7128B_MulFloat(YM7128B_MulFloat(outputs_right[i], vr), og);
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void YM7128B_ChipIdeal_Process_Block(
+    YM7128B_ChipIdeal* self,
+    YM7128B_Float const* inputs,
+    YM7128B_Float* outputs_left,
+    YM7128B_Float* outputs_right,
+    YM7128B_TapIdeal count
+)
+{
+    assert(self);
+    assert(inputs);
+    assert(outputs_left);
+    assert(outputs_right);
+
+    if ((self->buffer_ == NULL) || (self->length_ == 0)) {
+        return;
+    }
+
+    // The two-pass chunk split is only valid while no in-chunk write can
+    // evict a delay line entry an output tap still has to read, so bound
+    // the chunk size by the headroom left past the longest tap. The taps
+    // never exceed length - 1, so the bound is always at least 1.
+    YM7128B_TapIdeal max_delay = 0;
+    for (YM7128B_Register tap = 1; tap < YM7128B_Tap_Count; ++tap) {
+        if (self->taps_[tap] > max_delay) {
+            max_delay = self->taps_[tap];
+        }
+    }
+    YM7128B_TapIdeal chunk_max = self->length_ - max_delay;
+
+    while (count) {
+        YM7128B_TapIdeal n = (count < chunk_max) ? count : chunk_max;
+        YM7128B_ChipIdeal_Process_Chunk(self, inputs, outputs_left, outputs_right, n);
+        inputs += n;
+        outputs_left += n;
+        outputs_right += n;
+        count -= n;
+    }
+}
+
+// ----------------------------------------------------------------------------
+
 YM7128B_Register YM7128B_ChipIdeal_Read(
     YM7128B_ChipIdeal const* self,
     YM7128B_Address address
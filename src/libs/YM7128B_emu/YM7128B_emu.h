@@ -651,6 +651,18 @@ void YM7128B_ChipIdeal_Process(
     YM7128B_ChipIdeal_Process_Data* data
 );
 
+//! Block-based variant of YM7128B_ChipIdeal_Process(); processes 'count'
+//! mono input samples at once, accumulating the output taps tap-major so
+//! the delay line is read in contiguous runs. Produces the same output as
+//! the per-sample call.
+void YM7128B_ChipIdeal_Process_Block(
+    YM7128B_ChipIdeal* self,
+    YM7128B_Float const* inputs,
+    YM7128B_Float* outputs_left,
+    YM7128B_Float* outputs_right,
+    YM7128B_TapIdeal count
+);
+
 YM7128B_Register YM7128B_ChipIdeal_Read(
     YM7128B_ChipIdeal const* self,
     YM7128B_Address address
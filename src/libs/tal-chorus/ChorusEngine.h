@@ -98,6 +98,55 @@ public:
         *sampleL= *sampleL+resultL*1.4f;
         *sampleR= *sampleR+resultR*1.4f;
     }
+
+    // Block variant: runs each enabled chorus voice over the whole buffer
+    // in flat loops instead of interleaving the voices per sample, then
+    // mixes the wet signal back in one pass. Produces the same output as
+    // the per-sample call.
+    void process(float *samplesL, float *samplesR, int frames)
+    {
+        constexpr int blockSize= 256;
+        float resultL[blockSize];
+        float resultR[blockSize];
+
+        while (frames > 0)
+        {
+            const int n= frames < blockSize ? frames : blockSize;
+            for (int i= 0; i < n; i++)
+            {
+                resultL[i]= 0.0f;
+                resultR[i]= 0.0f;
+            }
+            if (isChorus1Enabled)
+            {
+                for (int i= 0; i < n; i++)
+                {
+                    resultL[i]+= chorus1L->process(&samplesL[i]);
+                    resultR[i]+= chorus1R->process(&samplesR[i]);
+                    dcBlock1L.tick(&resultL[i], 0.01f);
+                    dcBlock1R.tick(&resultR[i], 0.01f);
+                }
+            }
+            if (isChorus2Enabled)
+            {
+                for (int i= 0; i < n; i++)
+                {
+                    resultL[i]+= chorus2L->process(&samplesL[i]);
+                    resultR[i]+= chorus2R->process(&samplesR[i]);
+                    dcBlock2L.tick(&resultL[i], 0.01f);
+                    dcBlock2R.tick(&resultR[i], 0.01f);
+                }
+            }
+            for (int i= 0; i < n; i++)
+            {
+                samplesL[i]= samplesL[i]+resultL[i]*1.4f;
+                samplesR[i]= samplesR[i]+resultR[i]*1.4f;
+            }
+            samplesL+= n;
+            samplesR+= n;
+            frames-= n;
+        }
+    }
 };
 
 #endif
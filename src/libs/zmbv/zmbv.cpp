@@ -18,11 +18,13 @@
 
 #include "zmbv.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <thread>
 
 #include "math_utils.h"
 #include "mem_unaligned.h"
@@ -47,6 +49,11 @@ constexpr int ZLIB_MEM_LEVEL           = 9;          // 1 to 9 (default 8)
 constexpr auto ZLIB_STRATEGY           = Z_FILTERED; // Z_DEFAULT_STRATEGY, Z_FILTERED,
                                                      // Z_HUFFMAN_ONLY, Z_RLE, Z_FIXED
 
+// The motion search is split across up to this many threads; small frames
+// are not worth the spawn cost and are searched on the calling thread.
+constexpr size_t MAX_SEARCH_THREADS      = 4;
+constexpr size_t MIN_BLOCKS_PER_SEARCHER = 512;
+
 ZMBV_FORMAT BPPFormat(const int bpp)
 {
 	switch (bpp) {
@@ -160,17 +167,25 @@ void VideoCodec::CreateVectorTable()
 	}
 }
 
+// Pixels compare equal when their low 24 bits match; for the 8- and 16-bit
+// formats the mask covers the whole pixel.
+template <class P>
+static constexpr P pixel_compare_mask()
+{
+	return static_cast<P>(0x00ffffff);
+}
+
 template <class P>
 int VideoCodec::PossibleBlock(const int vx, const int vy, const FrameBlock & block)
 {
+	constexpr auto mask = pixel_compare_mask<P>();
+
 	int ret = 0;
-	P *pold = reinterpret_cast<P *>(oldframe) + block.start + (vy * pitch) + vx;
-	P *pnew = reinterpret_cast<P *>(newframe) + block.start;
-	;
+	const P *pold = reinterpret_cast<const P *>(oldframe) + block.start + (vy * pitch) + vx;
+	const P *pnew = reinterpret_cast<const P *>(newframe) + block.start;
 	for (auto y = 0; y < block.dy; y += 4) {
 		for (auto x = 0; x < block.dx; x += 4) {
-			const auto test = 0 - ((pold[x] - pnew[x]) & 0x00ffffff);
-			ret -= check_cast<int>(test >> 31);
+			ret += ((pold[x] ^ pnew[x]) & mask) ? 1 : 0;
 		}
 		pold += pitch * 4;
 		pnew += pitch * 4;
@@ -181,15 +196,19 @@ int VideoCodec::PossibleBlock(const int vx, const int vy, const FrameBlock & blo
 template <class P>
 int VideoCodec::CompareBlock(const int vx, const int vy, const FrameBlock & block)
 {
+	constexpr auto mask = pixel_compare_mask<P>();
+
 	int ret = 0;
-	P *pold = reinterpret_cast<P *>(oldframe) + block.start + (vy * pitch) + vx;
-	P *pnew = reinterpret_cast<P *>(newframe) + block.start;
-	;
+	const P *pold = reinterpret_cast<const P *>(oldframe) + block.start + (vy * pitch) + vx;
+	const P *pnew = reinterpret_cast<const P *>(newframe) + block.start;
 	for (auto y = 0; y < block.dy; y++) {
+		// Counted as a per-row branch-free reduction so the compiler
+		// can vectorize the inner loop
+		int row_diffs = 0;
 		for (auto x = 0; x < block.dx; x++) {
-			const auto test = 0 - ((pold[x] - pnew[x]) & 0x00ffffff);
-			ret -= check_cast<int>(test >> 31);
+			row_diffs += ((pold[x] ^ pnew[x]) & mask) ? 1 : 0;
 		}
+		ret += row_diffs;
 		pold += pitch;
 		pnew += pitch;
 	}
@@ -199,13 +218,15 @@ int VideoCodec::CompareBlock(const int vx, const int vy, const FrameBlock & bloc
 template <class P>
 void VideoCodec::AddXorBlock(const int vx, const int vy, const FrameBlock & block)
 {
-	P *pold = reinterpret_cast<P *>(oldframe) + block.start + (vy * pitch) + vx;
-	P *pnew = reinterpret_cast<P *>(newframe) + block.start;
+	const P *pold = reinterpret_cast<const P *>(oldframe) + block.start + (vy * pitch) + vx;
+	const P *pnew = reinterpret_cast<const P *>(newframe) + block.start;
 	for (auto y = 0; y < block.dy; ++y) {
+		// XOR whole rows so the compiler can vectorize the loop
+		const auto dest = reinterpret_cast<P *>(&work[workUsed]);
 		for (auto x = 0; x < block.dx; ++x) {
-			*reinterpret_cast<P *>(&work[workUsed]) = pnew[x] ^ pold[x];
-			workUsed += sizeof(P);
+			dest[x] = pnew[x] ^ pold[x];
 		}
+		workUsed += static_cast<size_t>(block.dx) * sizeof(P);
 		pold += pitch;
 		pnew += pitch;
 	}
@@ -217,22 +238,17 @@ void VideoCodec::AlignWork(size_t & offset) {
 }
 
 template <class P>
-void VideoCodec::AddXorFrame()
+void VideoCodec::SearchBlockRange(const size_t first, const size_t last)
 {
-	auto vectors = &work[workUsed];
-
-	AlignWork(workUsed);
-
-	size_t b = 0;
-	for (const auto & block : blocks) {
+	for (size_t b = first; b < last; ++b) {
+		const auto & block = blocks[b];
 
-		int8_t bestvx   = 0;
-		int8_t bestvy   = 0;
-		auto bestchange = CompareBlock<P>(0, 0, block);
-		auto possibles  = 64;
+		BlockMotion best = {};
+		best.change      = CompareBlock<P>(0, 0, block);
+		auto possibles   = 64;
 
 		for (auto v = 0; v < VectorCount && possibles; v++) {
-			if (bestchange < 4)
+			if (best.change < 4)
 				break;
 			auto vx = VectorTable[v].x;
 			auto vy = VectorTable[v].y;
@@ -241,20 +257,70 @@ void VideoCodec::AddXorFrame()
 				// if (!possibles) Msg("Ran out of possibles, at
 				// %d of %d best%d\n",v,VectorCount,bestchange);
 				auto testchange = CompareBlock<P>(vx, vy, block);
-				if (testchange < bestchange) {
-					bestchange = testchange;
-					bestvx     = check_cast<int8_t>(vx);
-					bestvy     = check_cast<int8_t>(vy);
+				if (testchange < best.change) {
+					best.change = testchange;
+					best.vx     = check_cast<int8_t>(vx);
+					best.vy     = check_cast<int8_t>(vy);
 				}
 			}
 		}
-		vectors[b * 2 + 0] = static_cast<uint8_t>(left_shift_signed(bestvx, 1));
-		vectors[b * 2 + 1] = static_cast<uint8_t>(left_shift_signed(bestvy, 1));
-		if (bestchange) {
+		motion[b] = best;
+	}
+}
+
+template <class P>
+void VideoCodec::AddXorFrame()
+{
+	auto vectors = &work[workUsed];
+
+	AlignWork(workUsed);
+
+	const auto num_blocks = blocks.size();
+	motion.resize(num_blocks);
+
+	// The motion search only reads the two frame buffers, so it can run
+	// in parallel over contiguous block ranges. The per-block vector and
+	// XOR data are then emitted serially in block order, as the format
+	// requires.
+	auto num_searchers = std::min(static_cast<size_t>(
+	                                      std::thread::hardware_concurrency()),
+	                              MAX_SEARCH_THREADS);
+	if (num_blocks < MIN_BLOCKS_PER_SEARCHER * 2) {
+		num_searchers = 1;
+	}
+
+	if (num_searchers > 1) {
+		std::vector<std::thread> searchers = {};
+		searchers.reserve(num_searchers - 1);
+
+		const auto blocks_per_searcher = num_blocks / num_searchers;
+
+		size_t first = 0;
+		for (size_t t = 0; t + 1 < num_searchers; ++t) {
+			searchers.emplace_back(&VideoCodec::SearchBlockRange<P>,
+			                       this,
+			                       first,
+			                       first + blocks_per_searcher);
+			first += blocks_per_searcher;
+		}
+		SearchBlockRange<P>(first, num_blocks);
+
+		for (auto & searcher : searchers) {
+			searcher.join();
+		}
+	} else {
+		SearchBlockRange<P>(0, num_blocks);
+	}
+
+	for (size_t b = 0; b < num_blocks; ++b) {
+		const auto & best = motion[b];
+
+		vectors[b * 2 + 0] = static_cast<uint8_t>(left_shift_signed(best.vx, 1));
+		vectors[b * 2 + 1] = static_cast<uint8_t>(left_shift_signed(best.vy, 1));
+		if (best.change) {
 			vectors[b * 2 + 0] |= 1;
-			AddXorBlock<P>(bestvx, bestvy, block);
+			AddXorBlock<P>(best.vx, best.vy, blocks[b]);
 		}
-		++b;
 	}
 }
 
@@ -82,6 +82,12 @@ private:
 		uint8_t *writeBuf = nullptr;
 	};
 
+	struct BlockMotion {
+		int8_t vx = 0;
+		int8_t vy = 0;
+		int change = 0;
+	};
+
 
 	static constexpr uint8_t keyframeHeaderBytes = {sizeof(KeyframeHeader)};
 
@@ -96,6 +102,7 @@ private:
 	uint32_t bufsize = 0;
 
 	std::vector<FrameBlock> blocks = {};
+	std::vector<BlockMotion> motion = {};
 	size_t workUsed = 0;
 	size_t workPos = 0;
 
@@ -119,6 +126,8 @@ private:
 	template <class P>
 	void UnXorFrame();
 	template <class P>
+	void SearchBlockRange(size_t first, size_t last);
+	template <class P>
 	int PossibleBlock(int vx, int vy, const FrameBlock & block);
 	template <class P>
 	int CompareBlock(int vx, int vy, const FrameBlock & block);
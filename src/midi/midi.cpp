@@ -379,7 +379,10 @@ void MIDI_RawOutByte(uint8_t data)
 	if (midi.sysex.start_ms) {
 		const auto passed_ticks = GetTicksSince(midi.sysex.start_ms);
 		if (passed_ticks < midi.sysex.delay_ms) {
-			Delay(midi.sysex.delay_ms - passed_ticks);
+			// Precise sleep: oversleeping each inter-message gap by
+			// a scheduler quantum makes long SysEx uploads (MT-32
+			// patches) take noticeably longer than on real hardware
+			DelayPreciseUs((midi.sysex.delay_ms - passed_ticks) * 1000);
 		}
 	}
 
@@ -24,6 +24,7 @@
 #if C_ALSA
 
 #include <cassert>
+#include <chrono>
 #include <cstring>
 #include <functional>
 #include <regex>
@@ -33,6 +34,7 @@
 #include "logging.h"
 #include "programs.h"
 #include "string_utils.h"
+#include "support.h"
 
 #define ADDR_DELIM ".:"
 
@@ -79,6 +81,9 @@ static bool port_is_writable(const unsigned int port_caps)
 	return (port_caps & mask) == mask;
 }
 
+// Runs on the output thread: appends the event to the sequencer's output
+// buffer and notes whether the current batch wants a drain. The actual
+// drain (the kernel write) happens once per coalesced batch in output_loop.
 void MidiHandler_alsa::send_event(int do_flush)
 {
 	snd_seq_ev_set_direct(&ev);
@@ -87,7 +92,7 @@ void MidiHandler_alsa::send_event(int do_flush)
 
 	snd_seq_event_output(seq_handle, &ev);
 	if (do_flush)
-		snd_seq_drain_output(seq_handle);
+		pending_drain = true;
 }
 
 static bool parse_addr(const std::string &in, int *client, int *port)
@@ -121,11 +126,28 @@ static bool parse_addr(const std::string &in, int *client, int *port)
 
 void MidiHandler_alsa::PlaySysex(uint8_t *sysex, size_t len)
 {
-	snd_seq_ev_set_sysex(&ev, len, sysex);
-	send_event(1);
+	// One copy into the work item is needed so the bytes outlive the
+	// shared sysex assembly buffer; the sequencer event then references
+	// the item's storage directly on the output thread.
+	std::vector<uint8_t> message(sysex, sysex + len);
+	work_queue.Enqueue({std::move(message), 0, MessageType::SysEx});
 }
 
 void MidiHandler_alsa::PlayMsg(const MidiMessage& msg)
+{
+	std::vector<uint8_t> message(msg.data.begin(), msg.data.end());
+	work_queue.Enqueue({std::move(message), 0, MessageType::Channel});
+}
+
+void MidiHandler_alsa::apply_sysex(const std::vector<uint8_t>& msg)
+{
+	snd_seq_ev_set_sysex(&ev,
+	                     msg.size(),
+	                     const_cast<uint8_t*>(msg.data()));
+	send_event(1);
+}
+
+void MidiHandler_alsa::apply_channel_msg(const std::vector<uint8_t>& msg)
 {
 	const auto status_byte = msg[0];
 
@@ -180,11 +202,62 @@ void MidiHandler_alsa::PlayMsg(const MidiMessage& msg)
 	}
 }
 
+void MidiHandler_alsa::output_loop()
+{
+	auto apply = [this](const MidiWork& work) {
+		if (work.message_type == MessageType::Channel)
+			apply_channel_msg(work.message);
+		else
+			apply_sysex(work.message);
+	};
+
+	// Apply everything currently queued without blocking
+	auto apply_queued = [&] {
+		while (work_queue.Size() > 0) {
+			if (const auto work = work_queue.Dequeue(); work)
+				apply(*work);
+			else
+				break;
+		}
+	};
+
+	while (auto work = work_queue.Dequeue()) {
+		pending_drain = false;
+		apply(*work);
+
+		// Messages already queued behind this one are part of the
+		// same burst; fold them into the same drain
+		apply_queued();
+
+		// Give the emulation thread one coalescing window to extend
+		// the burst before committing it with a kernel write
+		if (coalesce_window_us > 0) {
+			std::this_thread::sleep_for(
+			        std::chrono::microseconds(coalesce_window_us));
+			apply_queued();
+		}
+
+		if (pending_drain)
+			snd_seq_drain_output(seq_handle);
+	}
+
+	// Push out anything still buffered before closing
+	snd_seq_drain_output(seq_handle);
+}
+
 void MidiHandler_alsa::Close()
 {
 	if (seq_handle) {
 		Reset();
+
+		// Reset() queued its messages; the output thread drains the
+		// remainder of the queue before exiting
+		work_queue.Stop();
+		if (output_thread.joinable())
+			output_thread.join();
+
 		snd_seq_close(seq_handle);
+		seq_handle = nullptr;
 	}
 	seq = {-1, -1};
 }
@@ -317,6 +390,17 @@ bool MidiHandler_alsa::Open(const char *conf)
 			LOG_MSG("MIDI:ALSA: Connected to MIDI port %d:%d - %s", seq.client,
 			        seq.port, snd_seq_client_info_get_name(info));
 			snd_seq_client_info_free(info);
+
+			// Size the queue to hold ten seconds of the MIDI
+			// spec's maximum message rate, then start the output
+			// thread
+			static constexpr uint16_t midi_spec_max_msg_rate_hz = 1042;
+			work_queue.Resize(midi_spec_max_msg_rate_hz * 10);
+			work_queue.Start();
+
+			output_thread = std::thread(&MidiHandler_alsa::output_loop,
+			                            this);
+			set_thread_name(output_thread, "dosbox:alsa");
 			return true;
 		}
 	}
@@ -26,8 +26,14 @@
 
 #if C_ALSA
 
+#include <thread>
+#include <vector>
+
 #include <alsa/asoundlib.h>
 
+#include "midi.h"
+#include "rwqueue.h"
+
 struct alsa_address {
 	int client;
 	int port;
@@ -40,7 +46,19 @@ private:
 	alsa_address seq = {-1, -1}; // address of input port we're connected to
 	int output_port = 0;
 
+	// Messages are queued to an output thread, which folds messages
+	// arriving within this window into a single drain so bursts (such as
+	// MT-32 timbre uploads) cost one kernel write instead of one each
+	static constexpr auto coalesce_window_us = 300;
+
+	RWQueue<MidiWork> work_queue{1};
+	std::thread output_thread = {};
+	bool pending_drain        = false;
+
 	void send_event(int do_flush);
+	void apply_channel_msg(const std::vector<uint8_t>& msg);
+	void apply_sysex(const std::vector<uint8_t>& msg);
+	void output_loop();
 
 public:
 	MidiHandler_alsa() : MidiHandler() {}
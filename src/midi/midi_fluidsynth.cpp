@@ -22,8 +22,10 @@
 
 #if C_FLUIDSYNTH
 
+#include <algorithm>
 #include <bitset>
 #include <cassert>
+#include <cinttypes>
 #include <deque>
 #include <numeric>
 #include <string>
@@ -41,6 +43,7 @@
 #include "programs.h"
 #include "string_utils.h"
 #include "support.h"
+#include "timer.h"
 
 MidiHandlerFluidsynth instance;
 
@@ -520,11 +523,12 @@ bool MidiHandlerFluidsynth::Open([[maybe_unused]] const char* conf)
 		mixer_channel->SetLowPassFilter(FilterState::Off);
 	}
 
-	// Double the baseline PCM prebuffer because MIDI is demanding and
-	// bursty. The Mixer's default of ~20 ms becomes 40 ms here, which gives
-	// slower systems a better to keep up (and prevent their audio frame
-	// FIFO from running dry).
-	const auto render_ahead_ms = MIXER_GetPreBufferMs() * 2;
+	// Quadruple the baseline PCM prebuffer because MIDI is demanding and
+	// bursty. The Mixer's default of ~20 ms becomes 80 ms here, which the
+	// render thread fills ahead of the mixer's read cursor in batches
+	// sized from the measured synthesis cost (see Render), giving slower
+	// systems a deeper cushion against underruns.
+	const auto render_ahead_ms = MIXER_GetPreBufferMs() * 4;
 
 	// Size the out-bound audio frame FIFO
 	assert(audio_frame_rate_hz > 8000); // sane lower-bound of 8 KHz
@@ -583,6 +587,17 @@ void MidiHandlerFluidsynth::Close()
 		had_underruns = false;
 	}
 
+	if (ema_render_us_per_frame > 0.0 && min_headroom_frames != SIZE_MAX) {
+		LOG_MSG("FSYNTH: Rendered %.2f us/frame on average; buffer "
+		        "headroom never dropped below %u frames (%" PRId64 " underruns)",
+		        ema_render_us_per_frame,
+		        static_cast<uint32_t>(min_headroom_frames),
+		        num_underruns);
+	}
+	ema_render_us_per_frame = 0.0;
+	min_headroom_frames     = SIZE_MAX;
+	num_underruns           = 0;
+
 	// Stop playback
 	if (channel) {
 		channel->Enable(false);
@@ -749,8 +764,12 @@ void MidiHandlerFluidsynth::MixerCallBack(const uint16_t requested_audio_frames)
 			LOG_WARNING("FSYNTH: Audio buffer underrun");
 		}
 		had_underruns = true;
+		++num_underruns;
 	}
 
+	min_headroom_frames = std::min(min_headroom_frames,
+	                               audio_frame_fifo.Size());
+
 	static std::vector<AudioFrame> audio_frames = {};
 
 	const auto has_dequeued = audio_frame_fifo.BulkDequeue(audio_frames,
@@ -776,6 +795,10 @@ void MidiHandlerFluidsynth::RenderAudioFramesToFifo(const uint16_t num_audio_fra
 		audio_frames.resize(num_audio_frames);
 	}
 
+	// Time only the synthesis call (BulkEnqueue can block when the FIFO
+	// is full, which would inflate the measurement)
+	const auto start_us = GetTicksUs();
+
 	fluid_synth_write_float(synth.get(),
 	                        num_audio_frames,
 	                        &audio_frames[0][0],
@@ -785,6 +808,17 @@ void MidiHandlerFluidsynth::RenderAudioFramesToFifo(const uint16_t num_audio_fra
 	                        1,
 	                        2);
 
+	const auto us_per_frame = static_cast<double>(GetTicksUsSince(start_us)) /
+	                          num_audio_frames;
+
+	// Exponential moving average of the per-frame synthesis cost, used by
+	// Render to size its batches
+	constexpr auto ema_weight = 0.1;
+	ema_render_us_per_frame = (ema_render_us_per_frame > 0.0)
+	                                ? ema_render_us_per_frame * (1.0 - ema_weight) +
+	                                          us_per_frame * ema_weight
+	                                : us_per_frame;
+
 	audio_frame_fifo.BulkEnqueue(audio_frames, num_audio_frames);
 }
 
@@ -822,9 +856,26 @@ void MidiHandlerFluidsynth::ProcessWorkFromFifo()
 // Keep the fifo populated with freshly rendered buffers
 void MidiHandlerFluidsynth::Render()
 {
+	// When no MIDI work is pending, render in batches sized so each
+	// synthesis call stays within this deadline. Batching amortizes the
+	// per-call overhead while the deadline bounds how long an incoming
+	// MIDI message can wait behind an in-flight render.
+	constexpr auto batch_deadline_us     = 1000.0;
+	constexpr uint16_t min_batch_frames  = 8;
+	constexpr uint16_t max_batch_frames  = 1024;
+
 	while (work_fifo.IsRunning()) {
-		work_fifo.IsEmpty() ? RenderAudioFramesToFifo()
-		                    : ProcessWorkFromFifo();
+		if (!work_fifo.IsEmpty()) {
+			ProcessWorkFromFifo();
+			continue;
+		}
+		const auto batch_frames =
+		        (ema_render_us_per_frame > 0.0)
+		                ? std::clamp(batch_deadline_us / ema_render_us_per_frame,
+		                             static_cast<double>(min_batch_frames),
+		                             static_cast<double>(max_batch_frames))
+		                : min_batch_frames;
+		RenderAudioFramesToFifo(static_cast<uint16_t>(batch_frames));
 	}
 }
 
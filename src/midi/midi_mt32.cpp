@@ -22,7 +22,9 @@
 
 #if C_MT32EMU
 
+#include <algorithm>
 #include <cassert>
+#include <cinttypes>
 #include <deque>
 #include <functional>
 #include <map>
@@ -46,6 +48,7 @@
 #include "pic.h"
 #include "string_utils.h"
 #include "support.h"
+#include "timer.h"
 
 // mt32emu Settings
 // ----------------
@@ -824,11 +827,12 @@ bool MidiHandler_mt32::Open([[maybe_unused]] const char* conf)
 		mixer_channel->SetLowPassFilter(FilterState::Off);
 	}
 
-	// Double the baseline PCM prebuffer because MIDI is demanding and
-	// bursty. The Mixer's default of ~20 ms becomes 40 ms here, which gives
-	// slower systems a better to keep up (and prevent their audio frame
-	// FIFO from running dry).
-	const auto render_ahead_ms = MIXER_GetPreBufferMs() * 2;
+	// Quadruple the baseline PCM prebuffer because MIDI is demanding and
+	// bursty. The Mixer's default of ~20 ms becomes 80 ms here, which the
+	// render thread fills ahead of the mixer's read cursor in batches
+	// sized from the measured synthesis cost (see Render), giving slower
+	// systems a deeper cushion against underruns.
+	const auto render_ahead_ms = MIXER_GetPreBufferMs() * 4;
 
 	// Size the out-bound audio frame FIFO
 	assert(sample_rate_hz > 8000); // sane lower-bound of 8 KHz
@@ -885,6 +889,17 @@ void MidiHandler_mt32::Close()
 		had_underruns = false;
 	}
 
+	if (ema_render_us_per_frame > 0.0 && min_headroom_frames != SIZE_MAX) {
+		LOG_MSG("MT32: Rendered %.2f us/frame on average; buffer "
+		        "headroom never dropped below %u frames (%" PRId64 " underruns)",
+		        ema_render_us_per_frame,
+		        static_cast<uint32_t>(min_headroom_frames),
+		        num_underruns);
+	}
+	ema_render_us_per_frame = 0.0;
+	min_headroom_frames     = SIZE_MAX;
+	num_underruns           = 0;
+
 	// Stop playback
 	if (channel) {
 		channel->Enable(false);
@@ -976,8 +991,12 @@ void MidiHandler_mt32::MixerCallBack(const uint16_t requested_audio_frames)
 			LOG_WARNING("MT32: Audio buffer underrun");
 		}
 		had_underruns = true;
+		++num_underruns;
 	}
 
+	min_headroom_frames = std::min(min_headroom_frames,
+	                               audio_frame_fifo.Size());
+
 	static std::vector<AudioFrame> audio_frames = {};
 
 	const auto has_dequeued = audio_frame_fifo.BulkDequeue(audio_frames,
@@ -1004,10 +1023,25 @@ void MidiHandler_mt32::RenderAudioFramesToFifo(const uint16_t num_frames)
 		audio_frames.resize(num_frames);
 	}
 
+	// Time only the synthesis call (BulkEnqueue can block when the FIFO
+	// is full, which would inflate the measurement)
+	const auto start_us = GetTicksUs();
+
 	std::unique_lock<std::mutex> lock(service_mutex);
 	service->renderFloat(&audio_frames[0][0], num_frames);
 	lock.unlock();
 
+	const auto us_per_frame = static_cast<double>(GetTicksUsSince(start_us)) /
+	                          num_frames;
+
+	// Exponential moving average of the per-frame synthesis cost, used by
+	// Render to size its batches
+	constexpr auto ema_weight = 0.1;
+	ema_render_us_per_frame = (ema_render_us_per_frame > 0.0)
+	                                ? ema_render_us_per_frame * (1.0 - ema_weight) +
+	                                          us_per_frame * ema_weight
+	                                : us_per_frame;
+
 	audio_frame_fifo.BulkEnqueue(audio_frames, num_frames);
 }
 
@@ -1054,9 +1088,26 @@ void MidiHandler_mt32::ProcessWorkFromFifo()
 // Keep the fifo populated with freshly rendered buffers
 void MidiHandler_mt32::Render()
 {
+	// When no MIDI work is pending, render in batches sized so each
+	// synthesis call stays within this deadline. Batching amortizes the
+	// per-call overhead while the deadline bounds how long an incoming
+	// MIDI message can wait behind an in-flight render.
+	constexpr auto batch_deadline_us     = 1000.0;
+	constexpr uint16_t min_batch_frames  = 8;
+	constexpr uint16_t max_batch_frames  = 1024;
+
 	while (work_fifo.IsRunning()) {
-		work_fifo.IsEmpty() ? RenderAudioFramesToFifo()
-		                    : ProcessWorkFromFifo();
+		if (!work_fifo.IsEmpty()) {
+			ProcessWorkFromFifo();
+			continue;
+		}
+		const auto batch_frames =
+		        (ema_render_us_per_frame > 0.0)
+		                ? std::clamp(batch_deadline_us / ema_render_us_per_frame,
+		                             static_cast<double>(min_batch_frames),
+		                             static_cast<double>(max_batch_frames))
+		                : min_batch_frames;
+		RenderAudioFramesToFifo(static_cast<uint16_t>(batch_frames));
 	}
 }
 
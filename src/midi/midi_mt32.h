@@ -99,6 +99,13 @@ private:
 	double last_rendered_ms   = 0.0;
 	double ms_per_audio_frame = 0.0;
 
+	// Measured synthesis cost, used to size the render thread's batches
+	// so each render call stays within its deadline (see Render), plus
+	// headroom and underrun counters reported on shutdown.
+	double ema_render_us_per_frame = 0.0;
+	size_t min_headroom_frames     = SIZE_MAX;
+	int64_t num_underruns          = 0;
+
 	bool had_underruns = false;
 	bool is_open       = false;
 };
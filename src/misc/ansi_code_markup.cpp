@@ -18,7 +18,8 @@
  *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
-#include <regex>
+#include <cassert>
+#include <cctype>
 #include <unordered_map>
 
 #include "string_utils.h"
@@ -101,6 +102,22 @@ public:
 	bool color_is_light() const { return c_detail.is_light; }
 	int ansi_num() const;
 
+	// Used by the matcher in convert_ansi_markup to check candidate tag
+	// names (already lowercased) before committing to a full Tag parse.
+	static bool is_tag_name(const std::string &name)
+	{
+		return contains(tags, name);
+	}
+	static bool takes_value(const std::string &name)
+	{
+		const auto it = tags.find(name);
+		if (it == tags.end()) {
+			return false;
+		}
+		const auto group = it->second.group;
+		return group == Group::Colors || group == Group::Erasers;
+	}
+
 private:	
 	bool parse_color_val(const std::string &val);
 	bool parse_erase_val(const std::string &val);
@@ -224,40 +241,85 @@ int Tag::ansi_num() const
 }
 
 /*
- * Regular expression to match tags
+ * Hand-rolled matcher for the tag grammar:
  *
- * The following is an example with group numbers:
- *               _____2_____
- *               |		   |
- * This color is [color=light-red] red
- *                |_4_| |6|
- *                |_5_|
+ *   '\'? '[' WS* '/'? name (WS* '=' WS* value)? WS*  ']'
  *
- * The folowing is a closing tag example:
- * _____2____
- * |		|
- * [/inverse]
- *  ||     |
- *  3|__4__|
+ * where WS is a space or tab, name is one of the known tag names, value
+ * is a run of letters and dashes, and only color and eraser tags may
+ * take a value. Matching is case-insensitive. This used to be a
+ * std::regex, but the grammar is small enough that a manual scan is both
+ * faster and free of allocations for strings without tags, which matters
+ * because every help and shell message passes through here.
  */
-static std::regex markup(R"((\\)?)" // Escape tag? (1)
-                         "(\\["     // Opening bracket, open main group (2)
-                         "[ \\t]*?" // Optional spacing after opening bracket
-                         "(\\/)?"   // Check for closing tag (3)
-                         "("        // Start group of tags (4)
-                         // Select tags which require a value (5)
-                         "(color|bgcolor|erasel|erases)"
-                         // Color or erase value. '=' not captured in separate
-                         // group. Spacing around '=' is allowed (6)
-                         "(?:[ \\t]*?=[ \\t]*?([a-z\\-]+))?"
-                         // All other tags to match
-                         "|i|b|u|s|blink|dim|hidden|inverse|reset"
-                         ")"        // End group of tags (4)
-                         "[ \\t]*?" // Optional spacing before closing bracket
-                         "\\])" // Closing bracket. Note: Clang and MSVC requires
-                                // this to be escaped. Closing main group (2)
-                         ,
-                         std::regex::icase);
+struct TagMatch {
+	std::string name = {};
+	std::string value = {};
+	size_t length = 0; // bytes from '[' to ']', inclusive
+	bool close = false;
+};
+
+static bool is_tag_ws(const char c)
+{
+	return c == ' ' || c == '\t';
+}
+
+static char lower_char(const char c)
+{
+	return static_cast<char>(tolower(static_cast<unsigned char>(c)));
+}
+
+// Try to parse a tag at 's', which must point at a '['. On success fills in
+// 'match' and returns true; on any grammar violation returns false, in which
+// case the text is passed through verbatim (as the regex used to do by
+// simply not matching).
+static bool parse_tag(const char *s, TagMatch &match)
+{
+	const char *p = s;
+	assert(*p == '[');
+	++p;
+	while (is_tag_ws(*p)) {
+		++p;
+	}
+	match.close = (*p == '/');
+	if (match.close) {
+		++p;
+	}
+	match.name.clear();
+	while (isalpha(static_cast<unsigned char>(*p))) {
+		match.name += lower_char(*p++);
+	}
+	if (!Tag::is_tag_name(match.name)) {
+		return false;
+	}
+	while (is_tag_ws(*p)) {
+		++p;
+	}
+	match.value.clear();
+	if (*p == '=') {
+		if (!Tag::takes_value(match.name)) {
+			return false;
+		}
+		++p;
+		while (is_tag_ws(*p)) {
+			++p;
+		}
+		while (isalpha(static_cast<unsigned char>(*p)) || *p == '-') {
+			match.value += lower_char(*p++);
+		}
+		if (match.value.empty()) {
+			return false;
+		}
+		while (is_tag_ws(*p)) {
+			++p;
+		}
+	}
+	if (*p != ']') {
+		return false;
+	}
+	match.length = static_cast<size_t>(p - s) + 1;
+	return true;
+}
 
 static char ansi_code[10] = {};
 
@@ -337,30 +399,41 @@ std::string convert_ansi_markup(const std::string &str)
  */
 std::string convert_ansi_markup(const char *str)
 {
-	std::string result;
-	const char *begin = str;
-	const char *last_match = str;
-	std::cmatch m;
-	while (std::regex_search(begin, m, markup)) {
+	assert(str);
+	std::string result = {};
+	const char *copy_from = str;
+	const char *p = str;
+	TagMatch match = {};
+	while (*p) {
+		if (*p != '[' || !parse_tag(p, match)) {
+			++p;
+			continue;
+		}
+		const bool escape = (p > str && p[-1] == '\\');
 		const char *r = nullptr;
-		bool escape = m[1].matched;
 		if (!escape) {
-			bool close = m[3].matched;
-			std::string tag = m[5].matched ? m[5].str() : m[4].str();
-			std::string val = m[5].matched ? m[6].str() : "";
-			Tag t(tag, val, close);
+			Tag t(match.name, match.value, match.close);
 			r = get_ansi_code(t);
 		}
-		// Copy text before current match to output string
-		result += m.prefix().str();
-		result += r ? r : m[2].str();
-
+		// Copy text before the tag, dropping the escaping backslash
+		result.append(copy_from,
+		              static_cast<size_t>(p - copy_from) - (escape ? 1 : 0));
+		if (r) {
+			result += r;
+		} else {
+			// Keep escaped or unparsable tags verbatim
+			result.append(p, match.length);
+		}
 		// Continue the next iteration from the end of the current match
-		begin += m.position() + m.length();
-		last_match = m[0].second;
+		p += match.length;
+		copy_from = p;
+	}
+	// Strings without a single tag take a one-copy fast path
+	if (copy_from == str) {
+		return str;
 	}
 	// Add the rest of the string after all matches have been found
-	result += last_match;
+	result.append(copy_from);
 	// And just in case our result is empty for some reason, set output
 	// string to input string
 	if (result.empty()) {
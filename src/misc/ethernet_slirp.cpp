@@ -23,6 +23,7 @@
 #if C_SLIRP
 
 #include <algorithm>
+#include <cinttypes>
 #include <map>
 #include <stdexcept>
 
@@ -36,6 +37,16 @@
 #include "string_utils.h"
 #include "timer.h"
 
+// Upper bound on frames staged while the card's receive ring is full.
+// Beyond this the sender is either flooding us or the guest stopped
+// servicing the card, so further frames are dropped like real wire loss.
+constexpr size_t MaxQueuedFrames = 64;
+
+// Staged frames are retried once per millisecond tick; frames the card
+// keeps refusing (e.g. filtered addresses in loopback mode) are dropped
+// after this many attempts.
+constexpr uint16_t MaxDeliveryRetries = 250;
+
 /* Begin boilerplate to map libslirp's C-based callbacks to our C++
  * object. The user data is provided inside the 'opaque' pointer.
  */
@@ -152,8 +163,31 @@ SlirpEthernetConnection::SlirpEthernetConnection()
 
 SlirpEthernetConnection::~SlirpEthernetConnection()
 {
-	if (slirp)
+	if (slirp) {
+		LogSessionCounters();
 		slirp_cleanup(slirp);
+	}
+}
+
+void SlirpEthernetConnection::LogSessionCounters() const
+{
+	// sentinel; an idle session has nothing worth reporting
+	if (!rx_packet_count && !tx_packet_count)
+		return;
+
+	const auto elapsed_ms = std::max(GetTicksSince(session_start_ms),
+	                                 INT64_C(1));
+	const auto elapsed_s = static_cast<double>(elapsed_ms) / 1000.0;
+
+	LOG_MSG("SLIRP: Received %" PRIu64 " frames (%.1f/s, %" PRIu64 " bytes copied)",
+	        rx_packet_count, static_cast<double>(rx_packet_count) / elapsed_s,
+	        rx_copied_bytes);
+	LOG_MSG("SLIRP: Sent %" PRIu64 " frames (%.1f/s, %" PRIu64 " bytes copied)",
+	        tx_packet_count, static_cast<double>(tx_packet_count) / elapsed_s,
+	        tx_copied_bytes);
+	if (rx_dropped_count)
+		LOG_MSG("SLIRP: Dropped %" PRIu64 " inbound frames the card never accepted",
+		        rx_dropped_count);
 }
 
 bool SlirpEthernetConnection::Initialize(Section *dosbox_config)
@@ -217,6 +251,8 @@ bool SlirpEthernetConnection::Initialize(Section *dosbox_config)
 		ClearPortForwards(is_udp, forwarded_udp_ports);
 		forwarded_udp_ports = SetupPortForwards(is_udp, section->Get_string("udp_port_forwards"));
 
+		session_start_ms = GetTicks();
+
 		LOG_MSG("SLIRP: Successfully initialized");
 		return true;
 	} else {
@@ -368,12 +404,15 @@ void SlirpEthernetConnection::SendPacket(const uint8_t *packet, int len)
 		            len, GetMTU());
 		return;
 	}
+	++tx_packet_count;
+	tx_copied_bytes += static_cast<uint64_t>(len);
 	slirp_input(slirp, packet, len);
 }
 
 void SlirpEthernetConnection::GetPackets(std::function<int(const uint8_t *, int)> callback)
 {
 	get_packet_callback = callback;
+	DeliverQueuedPackets();
 	uint32_t timeout_ms = 0;
 	PollsClear();
 	PollsAddRegistered();
@@ -393,7 +432,61 @@ int SlirpEthernetConnection::ReceivePacket(const uint8_t *packet, int len)
 		            len, GetMRU());
 		return -1;
 	}
-	return get_packet_callback(packet, len);
+	/* Deliver in arrival order: if earlier frames are still staged the
+	 * card has no ring space, so this one joins the queue behind them */
+	if (rx_queue.empty()) {
+		const auto accepted = get_packet_callback(packet, len);
+		if (accepted >= 0) {
+			++rx_packet_count;
+			rx_copied_bytes += static_cast<uint64_t>(len);
+			return accepted;
+		}
+	}
+	QueuePacket(packet, len);
+	return len;
+}
+
+void SlirpEthernetConnection::DeliverQueuedPackets()
+{
+	while (!rx_queue.empty()) {
+		auto &frame = rx_queue.front();
+		const auto len = check_cast<int>(frame.data.size());
+		if (get_packet_callback(frame.data.data(), len) < 0) {
+			// card still has no room; retry on the next tick
+			if (--frame.retries_left > 0)
+				return;
+			++rx_dropped_count;
+		} else {
+			++rx_packet_count;
+			rx_copied_bytes += frame.data.size();
+		}
+		RecycleBuffer(std::move(frame.data));
+		rx_queue.pop_front();
+	}
+}
+
+void SlirpEthernetConnection::QueuePacket(const uint8_t *packet, int len)
+{
+	if (rx_queue.size() >= MaxQueuedFrames) {
+		++rx_dropped_count;
+		return;
+	}
+	std::vector<uint8_t> buffer = {};
+	if (!rx_free_buffers.empty()) {
+		buffer = std::move(rx_free_buffers.back());
+		rx_free_buffers.pop_back();
+	}
+	buffer.assign(packet, packet + len);
+	rx_queue.push_back({std::move(buffer), MaxDeliveryRetries});
+}
+
+void SlirpEthernetConnection::RecycleBuffer(std::vector<uint8_t> &&buffer)
+{
+	// sentinel; keep at most a ring's worth of spare buffers around
+	if (rx_free_buffers.size() >= MaxQueuedFrames)
+		return;
+	buffer.clear();
+	rx_free_buffers.push_back(std::move(buffer));
 }
 
 struct slirp_timer *SlirpEthernetConnection::TimerNew(SlirpTimerCb cb, void *cb_opaque)
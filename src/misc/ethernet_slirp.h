@@ -58,6 +58,15 @@ struct slirp_timer {
 	                              callback */
 };
 
+/** A received frame the NIC had no ring space for yet
+ * Held in arrival order and redelivered on later polls so bursts
+ * above the card's small receive ring are smoothed instead of dropped.
+ */
+struct queued_frame {
+	std::vector<uint8_t> data = {}; /*!< The raw Ethernet frame */
+	uint16_t retries_left = 0; /*!< Delivery attempts before giving up */
+};
+
 /** A libslirp-based Ethernet connection
  * This backend uses a virtual Ethernet device. Only TCP, UDP and some ICMP
  * work over this interface. This is because libslirp terminates guest
@@ -109,6 +118,13 @@ private:
 	void ClearPortForwards(const bool is_udp, std::map<int, int> &existing_port_forwards);
 	std::map<int, int> SetupPortForwards(const bool is_udp, const std::string &port_forward_rules);
 
+	/* Staging queue for frames the card could not accept yet */
+	void DeliverQueuedPackets();
+	void QueuePacket(const uint8_t* packet, int len);
+	void RecycleBuffer(std::vector<uint8_t>&& buffer);
+
+	void LogSessionCounters() const;
+
 	/* Builds a list of descriptors and polls them */
 	void PollsAddRegistered();
 	void PollsClear();
@@ -131,6 +147,21 @@ private:
 
 	std::deque<int> registered_fds = {}; /*!< File descriptors to watch */
 
+	/** Frames waiting for receive ring space in the card
+	 * Retired buffers are recycled through rx_free_buffers, so steady
+	 * bursty traffic does not allocate per packet.
+	 */
+	std::deque<queued_frame> rx_queue = {};
+	std::vector<std::vector<uint8_t>> rx_free_buffers = {};
+
+	/* Traffic counters, reported when the connection closes */
+	int64_t session_start_ms = 0;
+	uint64_t rx_packet_count = 0;
+	uint64_t tx_packet_count = 0;
+	uint64_t rx_copied_bytes = 0;
+	uint64_t tx_copied_bytes = 0;
+	uint64_t rx_dropped_count = 0;
+
 	// keep track of the ports fowarded
 	std::map<int, int> forwarded_tcp_ports = {};
 	std::map<int, int> forwarded_udp_ports = {};
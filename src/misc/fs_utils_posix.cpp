@@ -31,6 +31,11 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#if defined(LINUX)
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
 #if defined(HAVE_SYS_XATTR_H)
 #include <sys/xattr.h>
 #endif
@@ -174,9 +179,12 @@ static const std::string XattrName = "user.DOSATTRIB";
 constexpr size_t XattrMinLength = 3;
 constexpr size_t XattrMaxLength = 4;
 
-static std::string fat_attribs_to_xattr(const FatAttributeFlags fat_attribs)
+// Formats into the caller's buffer; attribute writes happen per file
+// operation, so avoid allocating a string for the handful of characters
+static std::string_view fat_attribs_to_xattr(const FatAttributeFlags fat_attribs,
+                                             char (&buffer)[XattrMaxLength + 1])
 {
-	return format_string("0x%x", fat_attribs._data & XattrWriteMask);
+	return format_to(buffer, "0x%x", fat_attribs._data & XattrWriteMask);
 }
 
 static std::optional<FatAttributeFlags> xattr_to_fat_attribs(const std::string& xattr)
@@ -236,7 +244,8 @@ static std::optional<FatAttributeFlags> get_xattr(const std_fs::path& path)
 static bool set_xattr([[maybe_unused]] const std_fs::path& path,
                       const FatAttributeFlags attributes)
 {
-	const auto xattr = fat_attribs_to_xattr(attributes);
+	char xattr_buf[XattrMaxLength + 1];
+	const auto xattr = fat_attribs_to_xattr(attributes, xattr_buf);
 
 #ifdef MACOSX
 	constexpr int offset  = 0;
@@ -244,7 +253,7 @@ static bool set_xattr([[maybe_unused]] const std_fs::path& path,
 
 	const auto result = setxattr(path.c_str(),
 	                             XattrName.c_str(),
-	                             xattr.c_str(),
+	                             xattr.data(),
 	                             xattr.size(),
 	                             offset,
 	                             options);
@@ -253,7 +262,7 @@ static bool set_xattr([[maybe_unused]] const std_fs::path& path,
 
 	const auto result = setxattr(path.c_str(),
                                      XattrName.c_str(),
-                                     xattr.c_str(),
+                                     xattr.data(),
                                      xattr.size(),
                                      flags);
 #else
@@ -267,7 +276,8 @@ static bool set_xattr([[maybe_unused]] const std_fs::path& path,
 static bool set_xattr([[maybe_unused]] const int file_descriptor,
                       const FatAttributeFlags attributes)
 {
-	const auto xattr = fat_attribs_to_xattr(attributes);
+	char xattr_buf[XattrMaxLength + 1];
+	const auto xattr = fat_attribs_to_xattr(attributes, xattr_buf);
 
 #ifdef MACOSX
 	constexpr int offset  = 0;
@@ -275,7 +285,7 @@ static bool set_xattr([[maybe_unused]] const int file_descriptor,
 
 	const auto result = fsetxattr(file_descriptor,
 	                              XattrName.c_str(),
-	                              xattr.c_str(),
+	                              xattr.data(),
 	                              xattr.size(),
 	                              offset,
 	                              options);
@@ -284,7 +294,7 @@ static bool set_xattr([[maybe_unused]] const int file_descriptor,
 
 	const auto result = fsetxattr(file_descriptor,
 	                              XattrName.c_str(),
-	                              xattr.c_str(),
+	                              xattr.data(),
 	                              xattr.size(),
 	                              flags);
 #else
@@ -311,6 +321,47 @@ FILE* local_drive_create_file(const std_fs::path& path,
 	return file_pointer;
 }
 
+bool local_drive_clone_file([[maybe_unused]] FILE* src_file,
+                            [[maybe_unused]] FILE* dst_file)
+{
+#if defined(LINUX)
+	const int src_fd = fileno(src_file);
+	const int dst_fd = fileno(dst_file);
+
+	// Reflink-capable filesystems (Btrfs, XFS) clone without moving any
+	// data through the process
+	if (ioctl(dst_fd, FICLONE, src_fd) == 0) {
+		return true;
+	}
+
+	struct stat status = {};
+	if (fstat(src_fd, &status) != 0) {
+		return false;
+	}
+
+	// copy_file_range keeps the copy in the kernel and lets NFS 4.2
+	// servers perform it entirely on the remote side
+	off_t off_in  = 0;
+	off_t off_out = 0;
+	auto remaining = status.st_size;
+	while (remaining > 0) {
+		const auto copied = copy_file_range(src_fd, &off_in, dst_fd,
+		                                    &off_out,
+		                                    static_cast<size_t>(remaining), 0);
+		if (copied <= 0) {
+			// Leave the destination empty for the caller's
+			// buffered fallback
+			[[maybe_unused]] const auto rc = ftruncate(dst_fd, 0);
+			return false;
+		}
+		remaining -= copied;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
 uint16_t local_drive_get_attributes(const std_fs::path& path,
                                     FatAttributeFlags& attributes)
 {
@@ -354,4 +405,112 @@ uint16_t local_drive_set_attributes(const std_fs::path& path,
 	return status ? DOSERR_NONE : DOSERR_ACCESS_DENIED;
 }
 
+// ***************************************************************************
+// Native directory change watching
+// ***************************************************************************
+
+#if defined(LINUX)
+
+#include <sys/inotify.h>
+
+#include <algorithm>
+#include <map>
+
+struct FsWatch {
+	int fd = -1;
+	// inotify watches are per-directory; remember which path each watch
+	// descriptor stands for so events can be mapped back
+	std::map<int, std::string> dirs_by_wd = {};
+};
+
+FsWatch* fs_watch_open(const std_fs::path& base_dir)
+{
+	const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0) {
+		return nullptr;
+	}
+	auto watch = new FsWatch();
+	watch->fd  = fd;
+	fs_watch_add_dir(watch, base_dir);
+	return watch;
+}
+
+void fs_watch_add_dir(FsWatch* watch, const std_fs::path& dir)
+{
+	if (!watch) {
+		return;
+	}
+	constexpr uint32_t mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+	                          IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB |
+	                          IN_ONLYDIR;
+	// adding an already-watched path just returns the existing descriptor
+	const int wd = inotify_add_watch(watch->fd, dir.string().c_str(), mask);
+	if (wd >= 0) {
+		watch->dirs_by_wd[wd] = dir.string();
+	}
+}
+
+std::vector<std::string> fs_watch_poll(FsWatch* watch)
+{
+	std::vector<std::string> changed = {};
+	if (!watch) {
+		return changed;
+	}
+	alignas(inotify_event) char buffer[4096];
+	for (;;) {
+		const auto bytes = read(watch->fd, buffer, sizeof(buffer));
+		if (bytes <= 0) {
+			break;
+		}
+		ssize_t pos = 0;
+		while (pos < bytes) {
+			const auto* event = reinterpret_cast<const inotify_event*>(
+			        buffer + pos);
+			const auto it = watch->dirs_by_wd.find(event->wd);
+			if (event->mask & IN_IGNORED) {
+				// the watched directory itself went away
+				if (it != watch->dirs_by_wd.end()) {
+					watch->dirs_by_wd.erase(it);
+				}
+			} else if (it != watch->dirs_by_wd.end()) {
+				if (std::find(changed.begin(), changed.end(),
+				              it->second) == changed.end()) {
+					changed.push_back(it->second);
+				}
+			}
+			pos += static_cast<ssize_t>(sizeof(inotify_event) +
+			                            event->len);
+		}
+	}
+	return changed;
+}
+
+void fs_watch_close(FsWatch* watch)
+{
+	if (!watch) {
+		return;
+	}
+	close(watch->fd);
+	delete watch;
+}
+
+#else
+
+// No native watch backend on this host; callers fall back to manual RESCAN
+FsWatch* fs_watch_open(const std_fs::path&)
+{
+	return nullptr;
+}
+
+void fs_watch_add_dir(FsWatch*, const std_fs::path&) {}
+
+std::vector<std::string> fs_watch_poll(FsWatch*)
+{
+	return {};
+}
+
+void fs_watch_close(FsWatch*) {}
+
+#endif
+
 #endif
@@ -83,6 +83,14 @@ FILE* local_drive_create_file(const std_fs::path& path,
 	return file_pointer;
 }
 
+bool local_drive_clone_file([[maybe_unused]] FILE* src_file,
+                            [[maybe_unused]] FILE* dst_file)
+{
+	// No cheap file cloning mechanism on Windows; the caller falls back
+	// to a buffered copy
+	return false;
+}
+
 uint16_t local_drive_get_attributes(const std_fs::path& path,
                                     FatAttributeFlags& attributes)
 {
@@ -106,4 +114,118 @@ uint16_t local_drive_set_attributes(const std_fs::path& path,
 	return DOSERR_NONE;
 }
 
+// ***************************************************************************
+// Native directory change watching
+// ***************************************************************************
+
+struct FsWatch {
+	HANDLE dir_handle    = INVALID_HANDLE_VALUE;
+	OVERLAPPED overlapped = {};
+	std_fs::path base_dir = {};
+	alignas(DWORD) uint8_t buffer[16 * 1024] = {};
+	bool pending = false;
+};
+
+static bool fs_watch_issue(FsWatch* watch)
+{
+	constexpr DWORD filter = FILE_NOTIFY_CHANGE_FILE_NAME |
+	                         FILE_NOTIFY_CHANGE_DIR_NAME |
+	                         FILE_NOTIFY_CHANGE_ATTRIBUTES |
+	                         FILE_NOTIFY_CHANGE_SIZE |
+	                         FILE_NOTIFY_CHANGE_LAST_WRITE;
+	watch->pending = ReadDirectoryChangesW(watch->dir_handle,
+	                                       watch->buffer,
+	                                       sizeof(watch->buffer),
+	                                       TRUE, // watch the whole subtree
+	                                       filter,
+	                                       nullptr,
+	                                       &watch->overlapped,
+	                                       nullptr);
+	return watch->pending;
+}
+
+FsWatch* fs_watch_open(const std_fs::path& base_dir)
+{
+	const HANDLE handle = CreateFileW(base_dir.c_str(),
+	                                  FILE_LIST_DIRECTORY,
+	                                  FILE_SHARE_READ | FILE_SHARE_WRITE |
+	                                          FILE_SHARE_DELETE,
+	                                  nullptr,
+	                                  OPEN_EXISTING,
+	                                  FILE_FLAG_BACKUP_SEMANTICS |
+	                                          FILE_FLAG_OVERLAPPED,
+	                                  nullptr);
+	if (handle == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+	auto watch               = new FsWatch();
+	watch->dir_handle        = handle;
+	watch->base_dir          = base_dir;
+	watch->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!watch->overlapped.hEvent || !fs_watch_issue(watch)) {
+		fs_watch_close(watch);
+		return nullptr;
+	}
+	return watch;
+}
+
+// The base watch already covers the whole subtree on Windows
+void fs_watch_add_dir(FsWatch*, const std_fs::path&) {}
+
+std::vector<std::string> fs_watch_poll(FsWatch* watch)
+{
+	std::vector<std::string> changed = {};
+	if (!watch || !watch->pending) {
+		return changed;
+	}
+	DWORD bytes = 0;
+	if (!GetOverlappedResult(watch->dir_handle, &watch->overlapped, &bytes,
+	                         FALSE)) {
+		// ERROR_IO_INCOMPLETE: nothing happened since the last poll
+		return changed;
+	}
+	ResetEvent(watch->overlapped.hEvent);
+	if (bytes == 0) {
+		// the event buffer overflowed; everything may have changed
+		changed.push_back(watch->base_dir.string());
+	}
+	size_t pos = 0;
+	while (pos < bytes) {
+		const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(
+		        watch->buffer + pos);
+		const std::wstring name(info->FileName,
+		                        info->FileNameLength / sizeof(WCHAR));
+		// events name the changed entry; its parent holds the listing
+		auto parent = (watch->base_dir / name).parent_path();
+		parent.make_preferred();
+		changed.push_back(parent.string());
+		if (info->NextEntryOffset == 0) {
+			break;
+		}
+		pos += info->NextEntryOffset;
+	}
+	fs_watch_issue(watch);
+	return changed;
+}
+
+void fs_watch_close(FsWatch* watch)
+{
+	if (!watch) {
+		return;
+	}
+	if (watch->dir_handle != INVALID_HANDLE_VALUE) {
+		if (watch->pending) {
+			CancelIo(watch->dir_handle);
+			DWORD bytes = 0;
+			GetOverlappedResult(watch->dir_handle, &watch->overlapped,
+			                    &bytes, TRUE);
+		}
+		CloseHandle(watch->dir_handle);
+	}
+	if (watch->overlapped.hEvent) {
+		CloseHandle(watch->overlapped.hEvent);
+	}
+	delete watch;
+}
+
 #endif
@@ -0,0 +1,164 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "guest_profiler.h"
+
+#include <cassert>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+
+#include "cpu.h"
+#include "logging.h"
+#include "pic.h"
+#include "regs.h"
+
+// The emulator subsystem a sample is attributed to. PIC events fire
+// between guest instructions, so the decoder that was active names the
+// code that burned the preceding slice.
+enum class SampledCore : uint8_t {
+	Normal = 0,
+	NormalTrap,
+	Simple,
+	Full,
+	Prefetch,
+	PrefetchTrap,
+	Dynamic,
+	Other,
+};
+
+static const char* core_names[] = {
+        "core_normal",
+        "core_normal_trap",
+        "core_simple",
+        "core_full",
+        "core_prefetch",
+        "core_prefetch_trap",
+        "core_dynamic",
+        "core_other",
+};
+
+// Keyed by core tag, CS, and EIP; a few thousand live buckets even for
+// large titles, so memory stays bounded by the guest's working set
+static std::unordered_map<uint64_t, uint64_t> sample_counts = {};
+
+static bool profiler_running     = false;
+static double sample_interval_ms = 0.0;
+
+static SampledCore active_core()
+{
+	if (cpudecoder == &CPU_Core_Normal_Run)
+		return SampledCore::Normal;
+	if (cpudecoder == &CPU_Core_Normal_Trap_Run)
+		return SampledCore::NormalTrap;
+	if (cpudecoder == &CPU_Core_Simple_Run)
+		return SampledCore::Simple;
+	if (cpudecoder == &CPU_Core_Full_Run)
+		return SampledCore::Full;
+	if (cpudecoder == &CPU_Core_Prefetch_Run)
+		return SampledCore::Prefetch;
+	if (cpudecoder == &CPU_Core_Prefetch_Trap_Run)
+		return SampledCore::PrefetchTrap;
+#if (C_DYNAMIC_X86)
+	if (cpudecoder == &CPU_Core_Dyn_X86_Run ||
+	    cpudecoder == &CPU_Core_Dyn_X86_Trap_Run)
+		return SampledCore::Dynamic;
+#elif (C_DYNREC)
+	if (cpudecoder == &CPU_Core_Dynrec_Run ||
+	    cpudecoder == &CPU_Core_Dynrec_Trap_Run)
+		return SampledCore::Dynamic;
+#endif
+	return SampledCore::Other;
+}
+
+static void sample_event(uint32_t /*val*/)
+{
+	if (!profiler_running) {
+		return;
+	}
+
+	const auto key = (static_cast<uint64_t>(active_core()) << 48) |
+	                 (static_cast<uint64_t>(SegValue(cs)) << 32) | reg_eip;
+	++sample_counts[key];
+
+	PIC_AddEvent(sample_event, sample_interval_ms);
+}
+
+static void dump_at_exit()
+{
+	if (!sample_counts.empty()) {
+		GUESTPROF_Dump("profile.folded");
+	}
+}
+
+void GUESTPROF_Start(const int rate_hz)
+{
+	assert(rate_hz > 0);
+	sample_interval_ms = 1000.0 / rate_hz;
+
+	if (profiler_running) {
+		// Config change at runtime; the next sample picks up the
+		// new interval
+		return;
+	}
+	profiler_running = true;
+	PIC_AddEvent(sample_event, sample_interval_ms);
+
+	static bool registered_exit = false;
+	if (!registered_exit) {
+		atexit(dump_at_exit);
+		registered_exit = true;
+	}
+
+	LOG_MSG("PROFILER: Sampling guest CS:IP at %d Hz", rate_hz);
+}
+
+void GUESTPROF_Stop()
+{
+	if (!profiler_running) {
+		return;
+	}
+	profiler_running = false;
+	PIC_RemoveEvents(sample_event);
+}
+
+bool GUESTPROF_Dump(const std::string& path)
+{
+	FILE* file = fopen(path.c_str(), "wt");
+	if (!file) {
+		LOG_WARNING("PROFILER: Failed writing profile to '%s'",
+		            path.c_str());
+		return false;
+	}
+
+	for (const auto& [key, count] : sample_counts) {
+		const auto core = static_cast<size_t>(key >> 48);
+		const auto cs   = static_cast<uint16_t>(key >> 32);
+		const auto eip  = static_cast<uint32_t>(key);
+		fprintf(file, "dosbox;%s;%04x:%08x %" PRIu64 "\n",
+		        core_names[core], cs, eip, count);
+	}
+	fclose(file);
+
+	LOG_MSG("PROFILER: Wrote %u buckets to '%s'",
+	        static_cast<unsigned>(sample_counts.size()), path.c_str());
+	return true;
+}
@@ -0,0 +1,198 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "logging.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size record: the only work done on the logging thread while the
+// async backend is active is one vsnprintf into the slot, so overlong
+// messages are truncated
+constexpr size_t MaxRecordText = 256;
+
+struct LogRecord {
+	loguru::Verbosity verbosity = loguru::Verbosity_INFO;
+	char text[MaxRecordText]    = {};
+};
+
+// Single-producer ring: the owning thread writes at head, the drain thread
+// consumes at tail. A full ring drops the message and counts the drop;
+// losing a chatty log line beats stalling the emulation thread.
+struct LogRing {
+	static constexpr size_t NumRecords = 256; // power of two
+
+	std::array<LogRecord, NumRecords> records = {};
+
+	std::atomic<size_t> head      = 0;
+	std::atomic<size_t> tail      = 0;
+	std::atomic<uint32_t> dropped = 0;
+};
+
+static std::mutex rings_mutex = {};
+static std::vector<LogRing*> rings = {};
+
+static std::atomic<bool> async_enabled = false;
+static std::atomic<bool> drain_running = false;
+static std::thread drain_thread        = {};
+
+// Rings are intentionally never freed: they are small, the process only
+// ever has a handful of logging threads, and keeping them registered lets
+// the drain thread flush messages a thread logged right before it exited
+static LogRing* get_thread_ring()
+{
+	static thread_local LogRing* ring = nullptr;
+	if (!ring) {
+		ring = new LogRing();
+		std::lock_guard<std::mutex> lock(rings_mutex);
+		rings.push_back(ring);
+	}
+	return ring;
+}
+
+static void drain_ring(LogRing* ring)
+{
+	auto tail       = ring->tail.load(std::memory_order_relaxed);
+	const auto head = ring->head.load(std::memory_order_acquire);
+	while (tail != head) {
+		const auto& record = ring->records[tail % LogRing::NumRecords];
+		loguru::log(record.verbosity, "", 0, "%s", record.text);
+		++tail;
+		ring->tail.store(tail, std::memory_order_release);
+	}
+	const auto dropped = ring->dropped.exchange(0);
+	if (dropped) {
+		loguru::log(loguru::Verbosity_WARNING, "", 0,
+		            "LOG: Async logger dropped %u messages", dropped);
+	}
+}
+
+static void drain_all_rings()
+{
+	std::lock_guard<std::mutex> lock(rings_mutex);
+	for (auto* ring : rings) {
+		drain_ring(ring);
+	}
+}
+
+static void drain_loop()
+{
+	// Polling beats being notified by the producers, which would have to
+	// take a lock on the emulation thread; a few milliseconds of extra
+	// latency on a log line is of no consequence
+	while (drain_running) {
+		drain_all_rings();
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	// final flush of everything logged up to the stop
+	drain_all_rings();
+}
+
+static void enqueue_record(const loguru::Verbosity verbosity,
+                           const char* format, va_list args)
+{
+	auto ring       = get_thread_ring();
+	const auto head = ring->head.load(std::memory_order_relaxed);
+	const auto tail = ring->tail.load(std::memory_order_acquire);
+	if (head - tail >= LogRing::NumRecords) {
+		ring->dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	auto& record     = ring->records[head % LogRing::NumRecords];
+	record.verbosity = verbosity;
+	vsnprintf(record.text, sizeof(record.text), format, args);
+	ring->head.store(head + 1, std::memory_order_release);
+}
+
+static void log_to_backend(const loguru::Verbosity verbosity,
+                           const char* format, va_list args)
+{
+	// suppress messages no active sink would print before any
+	// formatting happens, the same check the LOG_F macros perform
+	if (verbosity > loguru::current_verbosity_cutoff()) {
+		return;
+	}
+	if (async_enabled.load(std::memory_order_relaxed)) {
+		enqueue_record(verbosity, format, args);
+	} else {
+		loguru::vlog(verbosity, "", 0, format, args);
+	}
+}
+
+void LOG_Info(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	log_to_backend(loguru::Verbosity_INFO, format, args);
+	va_end(args);
+}
+
+void LOG_Warn(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	log_to_backend(loguru::Verbosity_WARNING, format, args);
+	va_end(args);
+}
+
+void LOG_Err(const char* format, ...)
+{
+	va_list args;
+	va_start(args, format);
+	log_to_backend(loguru::Verbosity_ERROR, format, args);
+	va_end(args);
+}
+
+void LOG_StartAsync()
+{
+	if (drain_running) {
+		return;
+	}
+	drain_running = true;
+	drain_thread  = std::thread(drain_loop);
+	async_enabled = true;
+
+	// flush whatever is still queued on any exit path, mirroring the
+	// atexit(QuitSDL) registration in sdlmain
+	static bool atexit_registered = false;
+	if (!atexit_registered) {
+		atexit_registered = true;
+		atexit(LOG_StopAsync);
+	}
+}
+
+void LOG_StopAsync()
+{
+	if (!drain_running) {
+		return;
+	}
+	async_enabled = false;
+	drain_running = false;
+	if (drain_thread.joinable()) {
+		drain_thread.join();
+	}
+}
@@ -30,7 +30,6 @@
 
 #include "std_filesystem.h"
 #include <string>
-#include <unordered_map>
 
 #include "ansi_code_markup.h"
 #include "checks.h"
@@ -94,18 +93,22 @@ public:
 
 		assert(rendered_msg.length());
 		const uint16_t cp = get_utf8_code_page();
-		if (rendered_msg_by_codepage[cp].empty()) {
+		auto it = rendered_msg_by_codepage.find(cp);
+		if (it == rendered_msg_by_codepage.end()) {
+			std::string converted = {};
 			if (!utf8_to_dos(rendered_msg,
-			                 rendered_msg_by_codepage[cp],
+			                 converted,
 			                 UnicodeFallback::Box,
 			                 cp)) {
 				LOG_WARNING("LANG: Problem converting UTF8 string '%s' to DOS code page",
 				            rendered_msg.c_str());
 			}
-			assert(rendered_msg_by_codepage[cp].length());
+			assert(converted.length());
+			it = rendered_msg_by_codepage.emplace(cp, std::move(converted))
+			             .first;
 		}
 
-		return rendered_msg_by_codepage[cp].c_str();
+		return it->second.c_str();
 	}
 
 	void Set(const char *markup)
@@ -118,7 +121,10 @@ public:
 	}
 };
 
-static std::unordered_map<std::string, Message> messages;
+// The transparent comparator lets MSG_Get look a message up straight from
+// the caller's C-string without allocating a temporary std::string key on
+// every shell interaction.
+static std::map<std::string, Message, std::less<>> messages;
 static std::deque<std::string> messages_order;
 
 // Add the message if it doesn't exist yet
@@ -221,7 +227,7 @@ const char* MSG_GetRaw(const char* requested_name)
 
 bool MSG_Exists(const char *requested_name)
 {
-	return contains(messages, requested_name);
+	return messages.find(requested_name) != messages.end();
 }
 
 // Write the names and messages (in the order they were added) to the given location
@@ -35,6 +35,7 @@
 #include "fs_utils.h"
 #include "string_utils.h"
 #include "support.h"
+#include "timer.h"
 
 #if defined(_MSC_VER) || (defined(__MINGW32__) && defined(__clang__))
 _CRTIMP extern char** _environ;
@@ -720,11 +721,31 @@ void Property::Set_values(const std::vector<std::string>& in)
 	}
 }
 
+Property* Section_prop::RegisterProperty(Property* prop)
+{
+	properties.push_back(prop);
+
+	auto index_name = prop->propname;
+	lowcase(index_name);
+	property_index[index_name] = prop;
+
+	return prop;
+}
+
+Property* Section_prop::FindProp(const std::string& propname) const
+{
+	auto index_name = propname;
+	lowcase(index_name);
+
+	const auto prop = property_index.find(index_name);
+	return (prop != property_index.end()) ? prop->second : nullptr;
+}
+
 Prop_int* Section_prop::Add_int(const std::string& _propname,
                                 Property::Changeable::Value when, int _value)
 {
 	Prop_int* test = new Prop_int(_propname, when, _value);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
@@ -733,7 +754,7 @@ Prop_string* Section_prop::Add_string(const std::string& _propname,
                                       const char* _value)
 {
 	Prop_string* test = new Prop_string(_propname, when, _value);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
@@ -741,7 +762,7 @@ Prop_path* Section_prop::Add_path(const std::string& _propname,
                                   Property::Changeable::Value when, const char* _value)
 {
 	Prop_path* test = new Prop_path(_propname, when, _value);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
@@ -749,7 +770,7 @@ Prop_bool* Section_prop::Add_bool(const std::string& _propname,
                                   Property::Changeable::Value when, bool _value)
 {
 	Prop_bool* test = new Prop_bool(_propname, when, _value);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
@@ -757,7 +778,7 @@ Prop_hex* Section_prop::Add_hex(const std::string& _propname,
                                 Property::Changeable::Value when, Hex _value)
 {
 	Prop_hex* test = new Prop_hex(_propname, when, _value);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
@@ -766,7 +787,7 @@ PropMultiVal* Section_prop::AddMultiVal(const std::string& _propname,
                                         const std::string& sep)
 {
 	PropMultiVal* test = new PropMultiVal(_propname, when, sep);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
@@ -775,84 +796,41 @@ PropMultiValRemain* Section_prop::AddMultiValRemain(const std::string& _propname
                                                     const std::string& sep)
 {
 	PropMultiValRemain* test = new PropMultiValRemain(_propname, when, sep);
-	properties.push_back(test);
+	RegisterProperty(test);
 	return test;
 }
 
 int Section_prop::Get_int(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			return ((*tel)->GetValue());
-		}
-	}
-	return 0;
+	const auto prop = FindProp(_propname);
+	return prop ? static_cast<int>(prop->GetValue()) : 0;
 }
 
 bool Section_prop::Get_bool(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			return ((*tel)->GetValue());
-		}
-	}
-	return false;
+	const auto prop = FindProp(_propname);
+	return prop ? static_cast<bool>(prop->GetValue()) : false;
 }
 
 double Section_prop::Get_double(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			return ((*tel)->GetValue());
-		}
-	}
-	return 0.0;
+	const auto prop = FindProp(_propname);
+	return prop ? static_cast<double>(prop->GetValue()) : 0.0;
 }
 
 Prop_path* Section_prop::Get_path(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			Prop_path* val = dynamic_cast<Prop_path*>((*tel));
-			if (val) {
-				return val;
-			} else {
-				return nullptr;
-			}
-		}
-	}
-	return nullptr;
+	return dynamic_cast<Prop_path*>(FindProp(_propname));
 }
 
 PropMultiVal* Section_prop::GetMultiVal(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			PropMultiVal* val = dynamic_cast<PropMultiVal*>((*tel));
-			if (val) {
-				return val;
-			} else {
-				return nullptr;
-			}
-		}
-	}
-	return nullptr;
+	return dynamic_cast<PropMultiVal*>(FindProp(_propname));
 }
 
 PropMultiValRemain* Section_prop::GetMultiValRemain(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			PropMultiValRemain* val = dynamic_cast<PropMultiValRemain*>(
-			        (*tel));
-			if (val) {
-				return val;
-			} else {
-				return nullptr;
-			}
-		}
-	}
-	return nullptr;
+	return dynamic_cast<PropMultiValRemain*>(FindProp(_propname));
 }
 
 Property* Section_prop::Get_prop(int index)
@@ -867,43 +845,24 @@ Property* Section_prop::Get_prop(int index)
 
 std::string Section_prop::Get_string(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			return ((*tel)->GetValue());
-		}
-	}
-	return "";
+	const auto prop = FindProp(_propname);
+	return prop ? static_cast<std::string>(prop->GetValue()) : "";
 }
 
 Prop_bool* Section_prop::GetBoolProp(const std::string& propname) const
 {
-	for (const auto property : properties) {
-		if (property->propname == propname) {
-			return dynamic_cast<Prop_bool*>(property);
-		}
-	}
-	return nullptr;
+	return dynamic_cast<Prop_bool*>(FindProp(propname));
 }
 
-
 Prop_string* Section_prop::GetStringProp(const std::string& propname) const
 {
-	for (const auto property : properties) {
-		if (property->propname == propname) {
-			return dynamic_cast<Prop_string*>(property);
-		}
-	}
-	return nullptr;
+	return dynamic_cast<Prop_string*>(FindProp(propname));
 }
 
 Hex Section_prop::Get_hex(const std::string& _propname) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if ((*tel)->propname == _propname) {
-			return ((*tel)->GetValue());
-		}
-	}
-	return 0;
+	const auto prop = FindProp(_propname);
+	return prop ? static_cast<Hex>(prop->GetValue()) : Hex(0);
 }
 
 bool Section_prop::HandleInputline(const std::string& line)
@@ -929,22 +888,23 @@ bool Section_prop::HandleInputline(const std::string& line)
 	trim(name);
 	trim(val);
 
-	for (auto& p : properties) {
-		if (strcasecmp(p->propname.c_str(), name.c_str()) != 0) {
-			continue;
-		}
-
-		if (p->IsDeprecated()) {
-			LOG_WARNING("CONFIG: Deprecated option '%s'", name.c_str());
-			LOG_WARNING("CONFIG: %s", p->GetHelp());
-			return false;
-		}
+	const auto p = FindProp(name);
+	if (!p) {
+		LOG_WARNING("CONFIG: Invalid option '%s'", name.c_str());
+		return false;
+	}
 
-		return p->SetValue(val);
+	if (p->IsDeprecated()) {
+		LOG_WARNING("CONFIG: Deprecated option '%s'", name.c_str());
+		LOG_WARNING("CONFIG: %s", p->GetHelp());
+		return false;
 	}
 
-	LOG_WARNING("CONFIG: Invalid option '%s'", name.c_str());
-	return false;
+	if (!p->SetValue(val)) {
+		return false;
+	}
+	p->NotifyChanged();
+	return true;
 }
 
 void Section_prop::PrintData(FILE* outfile) const
@@ -973,12 +933,8 @@ void Section_prop::PrintData(FILE* outfile) const
 
 string Section_prop::GetPropValue(const std::string& _property) const
 {
-	for (const_it tel = properties.begin(); tel != properties.end(); ++tel) {
-		if (!strcasecmp((*tel)->propname.c_str(), _property.c_str())) {
-			return (*tel)->GetValue().ToString();
-		}
-	}
-	return NO_SUCH_PROPERTY;
+	const auto prop = FindProp(_property);
+	return prop ? prop->GetValue().ToString() : NO_SUCH_PROPERTY;
 }
 
 bool Section_line::HandleInputline(const std::string& line)
@@ -1204,9 +1160,28 @@ Config::Config(Config&& source) noexcept
 
 void Config::Init() const
 {
+	if (!arguments.startup_trace) {
+		for (const auto& sec : sectionlist) {
+			sec->ExecuteInit();
+		}
+		return;
+	}
+
+	// Requested via --startup-trace: report how long each section's init
+	// functions take, so startup time regressions can be pinned down to a
+	// module instead of only showing up in the cold-start total.
+	const auto startup_start_us = GetTicksUs();
+
 	for (const auto& sec : sectionlist) {
+		const auto section_start_us = GetTicksUs();
 		sec->ExecuteInit();
+		LOG_MSG("STARTUP: [%s] initialised in %.2f ms",
+		        sec->GetName(),
+		        static_cast<double>(GetTicksUsSince(section_start_us)) / 1000.0);
 	}
+
+	LOG_MSG("STARTUP: All sections initialised in %.2f ms",
+	        static_cast<double>(GetTicksUsSince(startup_start_us)) / 1000.0);
 }
 
 void Section::AddInitFunction(SectionFunction func, bool changeable_at_runtime)
@@ -1773,6 +1748,7 @@ void Config::ParseArguments()
 	arguments.noprimaryconf = cmdline->FindRemoveBoolArgument("noprimaryconf");
 	arguments.nolocalconf = cmdline->FindRemoveBoolArgument("nolocalconf");
 	arguments.fullscreen  = cmdline->FindRemoveBoolArgument("fullscreen");
+	arguments.headless    = cmdline->FindRemoveBoolArgument("headless");
 	arguments.list_countries = cmdline->FindRemoveBoolArgument("list-countries");
 	arguments.list_glshaders = cmdline->FindRemoveBoolArgument("list-glshaders");
 	arguments.noconsole   = cmdline->FindRemoveBoolArgument("noconsole");
@@ -1780,6 +1756,8 @@ void Config::ParseArguments()
 	arguments.exit        = cmdline->FindRemoveBoolArgument("exit");
 	arguments.securemode = cmdline->FindRemoveBoolArgument("securemode");
 	arguments.noautoexec = cmdline->FindRemoveBoolArgument("noautoexec");
+	arguments.startup_trace = cmdline->FindRemoveBoolArgument("startup-trace");
+	arguments.zygote        = cmdline->FindRemoveBoolArgument("zygote");
 
 	arguments.eraseconf = cmdline->FindRemoveBoolArgument("eraseconf") ||
 	                      cmdline->FindRemoveBoolArgument("resetconf");
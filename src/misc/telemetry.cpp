@@ -0,0 +1,225 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "telemetry.h"
+
+#include "cpu.h"
+#include "logging.h"
+#include "mapper.h"
+#include "mem.h"
+#include "mixer.h"
+#include "pic.h"
+#include "vga.h"
+#include "video.h"
+
+#ifndef WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static std::atomic<bool> server_running = false;
+static std::thread server_thread        = {};
+static int listen_fd                    = -1;
+static std::string bound_path           = {};
+
+// Counters are sampled without synchronisation: each is an atomic or a
+// plain word written by one thread, so a snapshot can mix values that are
+// one frame or one event apart, which is fine for fleet monitoring.
+static size_t write_snapshot(char* buf, const size_t buf_size)
+{
+	int64_t num_presented = 0;
+	int64_t num_skipped   = 0;
+	GFX_GetFrameCounts(num_presented, num_skipped);
+
+	uint64_t num_events       = 0;
+	uint64_t dispatch_us      = 0;
+	uint64_t dispatch_max_us  = 0;
+	MAPPER_GetEventDispatchStats(num_events, dispatch_us, dispatch_max_us);
+
+	uint64_t composite_lines = 0;
+	uint64_t composite_us    = 0;
+	VGA_GetCompositeFilterStats(composite_lines, composite_us);
+
+	uint64_t reverb_us = 0;
+	uint64_t chorus_us = 0;
+	MIXER_GetEffectsStats(reverb_us, chorus_us);
+
+#if (C_DYNAMIC_X86) || (C_DYNREC)
+	const auto cache_used  = static_cast<uint64_t>(CPU_GetDynCacheUsedBytes());
+	const auto cache_total = static_cast<uint64_t>(CPU_GetDynCacheTotalBytes());
+	uint64_t cache_evictions = 0;
+	uint64_t cache_wraps     = 0;
+	CPU_GetDynCacheEvictionStats(cache_evictions, cache_wraps);
+#else
+	constexpr uint64_t cache_used      = 0;
+	constexpr uint64_t cache_total     = 0;
+	constexpr uint64_t cache_evictions = 0;
+	constexpr uint64_t cache_wraps     = 0;
+#endif
+
+	const auto written = snprintf(
+	        buf, buf_size,
+	        "{\"cycles\":{\"max\":%d,\"percent_used\":%d,\"auto_adjust\":%s},"
+	        "\"frames\":{\"presented\":%lld,\"skipped\":%lld},"
+	        "\"audio\":{\"underruns\":%u,\"reverb_us\":%llu,\"chorus_us\":%llu},"
+	        "\"pic\":{\"queue_depth\":%u},"
+	        "\"input\":{\"events\":%llu,\"dispatch_us_total\":%llu,"
+	        "\"dispatch_us_max\":%llu},"
+	        "\"composite\":{\"lines\":%llu,\"filter_us\":%llu},"
+	        "\"dyncache\":{\"bytes_used\":%llu,\"bytes_total\":%llu,"
+	        "\"evictions\":%llu,\"wraps\":%llu},"
+	        "\"memory\":{\"mergeable_bytes\":%llu,\"ksm_merged_pages\":%llu}}\n",
+	        CPU_CycleMax, CPU_CyclePercUsed,
+	        CPU_CycleAutoAdjust ? "true" : "false",
+	        static_cast<long long>(num_presented),
+	        static_cast<long long>(num_skipped), MIXER_GetUnderrunCount(),
+	        static_cast<unsigned long long>(reverb_us),
+	        static_cast<unsigned long long>(chorus_us),
+	        PIC_QueueDepth(), static_cast<unsigned long long>(num_events),
+	        static_cast<unsigned long long>(dispatch_us),
+	        static_cast<unsigned long long>(dispatch_max_us),
+	        static_cast<unsigned long long>(composite_lines),
+	        static_cast<unsigned long long>(composite_us),
+	        static_cast<unsigned long long>(cache_used),
+	        static_cast<unsigned long long>(cache_total),
+	        static_cast<unsigned long long>(cache_evictions),
+	        static_cast<unsigned long long>(cache_wraps),
+	        static_cast<unsigned long long>(MEM_GetMergeableAdvisedBytes()),
+	        static_cast<unsigned long long>(MEM_GetKsmMergedPages()));
+
+	if (written < 0) {
+		return 0;
+	}
+	return std::min(static_cast<size_t>(written), buf_size - 1);
+}
+
+static void serve_loop()
+{
+	while (server_running) {
+		const int conn_fd = accept(listen_fd, nullptr, nullptr);
+		if (conn_fd < 0) {
+			// shutdown() from TELEMETRY_StopServer lands here
+			continue;
+		}
+
+		char snapshot[896];
+		const auto len = write_snapshot(snapshot, sizeof(snapshot));
+
+		size_t sent = 0;
+		while (sent < len) {
+			const auto ret = send(conn_fd, snapshot + sent,
+			                      len - sent, MSG_NOSIGNAL);
+			if (ret <= 0) {
+				break;
+			}
+			sent += static_cast<size_t>(ret);
+		}
+		close(conn_fd);
+	}
+}
+
+void TELEMETRY_StartServer(const std::string& socket_path)
+{
+	if (server_running || socket_path.empty()) {
+		return;
+	}
+
+	sockaddr_un addr = {};
+	addr.sun_family  = AF_UNIX;
+	if (socket_path.size() >= sizeof(addr.sun_path)) {
+		LOG_WARNING("TELEMETRY: Socket path '%s' is too long, not starting",
+		            socket_path.c_str());
+		return;
+	}
+	strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+	listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listen_fd < 0) {
+		LOG_WARNING("TELEMETRY: Failed creating socket: %s",
+		            strerror(errno));
+		return;
+	}
+
+	// A stale socket from a crashed instance blocks bind()
+	unlink(socket_path.c_str());
+
+	if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+	    listen(listen_fd, 4) < 0) {
+		LOG_WARNING("TELEMETRY: Failed binding '%s': %s",
+		            socket_path.c_str(), strerror(errno));
+		close(listen_fd);
+		listen_fd = -1;
+		return;
+	}
+
+	bound_path     = socket_path;
+	server_running = true;
+	server_thread  = std::thread(serve_loop);
+
+	static bool registered_exit = false;
+	if (!registered_exit) {
+		atexit(TELEMETRY_StopServer);
+		registered_exit = true;
+	}
+
+	LOG_MSG("TELEMETRY: Serving runtime stats on '%s'", socket_path.c_str());
+}
+
+void TELEMETRY_StopServer()
+{
+	if (!server_running) {
+		return;
+	}
+	server_running = false;
+
+	// Kick the server thread out of its blocking accept()
+	shutdown(listen_fd, SHUT_RDWR);
+	if (server_thread.joinable()) {
+		server_thread.join();
+	}
+
+	close(listen_fd);
+	listen_fd = -1;
+
+	unlink(bound_path.c_str());
+	bound_path.clear();
+}
+
+#else // WIN32
+
+void TELEMETRY_StartServer(const std::string& socket_path)
+{
+	if (!socket_path.empty()) {
+		LOG_WARNING("TELEMETRY: Unix domain sockets are not supported on this platform");
+	}
+}
+
+void TELEMETRY_StopServer() {}
+
+#endif
@@ -29,6 +29,7 @@
 
 #include "checks.h"
 #include "dos_inc.h"
+#include "mem_unaligned.h"
 #include "string_utils.h"
 
 CHECK_NARROWING();
@@ -2004,12 +2005,60 @@ uint16_t get_utf8_code_page()
 	return 0;
 }
 
+// Plain 7-bit ASCII converts to any DOS code page unchanged, so detecting
+// it up front lets the conversion skip the wide-character round trip and
+// its temporary allocations. Scans word-at-a-time, as strings streamed to
+// the console are mostly (if not entirely) ASCII.
+static bool is_7bit_ascii(const std::string& str)
+{
+	constexpr uint64_t high_bits_mask = UINT64_C(0x8080808080808080);
+
+	const auto bytes = reinterpret_cast<const uint8_t*>(str.data());
+	const auto size  = str.size();
+
+	size_t i = 0;
+	while (i + sizeof(uint64_t) <= size) {
+		if (read_unaligned_uint64(bytes + i) & high_bits_mask) {
+			return false;
+		}
+		i += sizeof(uint64_t);
+	}
+	while (i < size) {
+		if (bytes[i] >= decode_threshold_non_ascii) {
+			return false;
+		}
+		++i;
+	}
+
+	return true;
+}
+
+// The DOS-to-UTF-8 direction is only an identity for the printable ASCII
+// range - control bytes and 0x7f are screen codes representing glyphs
+// with non-ASCII code points.
+static bool is_printable_ascii(const std::string& str)
+{
+	for (const auto character : str) {
+		const auto byte = static_cast<uint8_t>(character);
+		if (byte < 0x20 || byte >= 0x7f) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 static bool utf8_to_dos_common(const std::string& in_str, std::string& out_str,
                                const UnicodeFallback fallback,
                                const uint16_t code_page)
 {
 	load_config_if_needed();
 
+	if (is_7bit_ascii(in_str)) {
+		out_str = in_str;
+		return true;
+	}
+
 	std::vector<uint16_t> tmp = {};
 
 	const bool status1 = utf8_to_wide(in_str, tmp);
@@ -2037,6 +2086,11 @@ static void dos_to_utf8_common(const std::string& in_str, std::string& out_str,
 {
 	load_config_if_needed();
 
+	if (is_printable_ascii(in_str)) {
+		out_str = in_str;
+		return;
+	}
+
 	std::vector<uint16_t> tmp = {};
 
 	dos_to_wide(in_str, tmp, code_page);
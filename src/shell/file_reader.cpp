@@ -20,6 +20,8 @@
 
 #include "file_reader.h"
 
+#include "dos_inc.h"
+
 std::optional<std::unique_ptr<FileReader>> FileReader::GetFileReader(std::string_view file)
 {
 	auto reader = std::make_unique<FileReader>(file, PrivateOnly());
@@ -32,10 +34,33 @@ std::optional<std::unique_ptr<FileReader>> FileReader::GetFileReader(std::string
 FileReader::FileReader(std::string_view file, [[maybe_unused]] PrivateOnly key)
         : filename(file),
           valid(DOS_OpenFile(filename.c_str(), (DOS_NOT_INHERIT | OPEN_READ), &handle))
-{}
+{
+	if (!valid || !dos.batch_file_cache) {
+		return;
+	}
+
+	// Read the whole file up front; batch execution then never returns
+	// to the DOS file layer
+	uint8_t block[4096];
+	std::uint16_t bytes_read = sizeof(block);
+	while (DOS_ReadFile(handle, block, &bytes_read) && bytes_read) {
+		cache.insert(cache.end(), block, block + bytes_read);
+		bytes_read = sizeof(block);
+	}
+
+	DOS_CloseFile(handle);
+	use_cache = true;
+}
 
 std::optional<uint8_t> FileReader::Read()
 {
+	if (use_cache) {
+		if (cache_pos >= cache.size()) {
+			return std::nullopt;
+		}
+		return cache[cache_pos++];
+	}
+
 	std::uint8_t data        = 0;
 	std::uint16_t bytes_read = 1;
 
@@ -49,11 +74,18 @@ std::optional<uint8_t> FileReader::Read()
 
 void FileReader::Reset()
 {
+	if (use_cache) {
+		cache_pos = 0;
+		return;
+	}
+
 	std::uint32_t cursor = 0;
 	DOS_SeekFile(handle, &cursor, DOS_SEEK_SET);
 }
 
 FileReader::~FileReader()
 {
-	DOS_CloseFile(handle);
+	if (!use_cache) {
+		DOS_CloseFile(handle);
+	}
 }
@@ -23,6 +23,7 @@
 
 #include <optional>
 #include <string>
+#include <vector>
 
 #include "shell.h"
 
@@ -53,6 +54,13 @@ private:
 	std::string filename = {};
 	uint16_t handle      = 0;
 	bool valid;
+
+	// With 'batch_file_cache' enabled the whole file is read once at
+	// construction and served from memory, so re-reading each line (and
+	// label scans on GOTO) skip the DOS file layer entirely
+	std::vector<uint8_t> cache = {};
+	size_t cache_pos           = 0;
+	bool use_cache             = false;
 };
 
 #endif
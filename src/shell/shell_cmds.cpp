@@ -895,22 +895,25 @@ void DOS_Shell::CMD_DIR(char* args)
 	}
 
 	std::vector<DOS_DTA::Result> dir_contents;
-
-	do { // File name and extension
-		DOS_DTA::Result result = {};
-		dta.GetResult(result);
-
-		// Skip non-directories if option AD is present,
-		// or skip dirs in case of A-D
-		if (has_option_all_dirs && !result.IsDirectory()) {
-			continue;
-		} else if (has_option_all_files && result.IsDirectory()) {
-			continue;
-		}
-
-		dir_contents.emplace_back(result);
-
-	} while (DOS_FindNext());
+	DOS_FindAllRemaining(dir_contents);
+
+	// Skip non-directories if option AD is present,
+	// or skip dirs in case of A-D
+	if (has_option_all_dirs) {
+		dir_contents.erase(std::remove_if(dir_contents.begin(),
+		                                  dir_contents.end(),
+		                                  [](const DOS_DTA::Result& result) {
+			                                  return !result.IsDirectory();
+		                                  }),
+		                   dir_contents.end());
+	} else if (has_option_all_files) {
+		dir_contents.erase(std::remove_if(dir_contents.begin(),
+		                                  dir_contents.end(),
+		                                  [](const DOS_DTA::Result& result) {
+			                                  return result.IsDirectory();
+		                                  }),
+		                   dir_contents.end());
+	}
 
 	DOS_Sort(dir_contents, option_sorting, option_reverse);
 
@@ -1640,12 +1643,24 @@ nextfile:
 		WriteOut(MSG_Get("SHELL_FILE_NOT_FOUND"),word);
 		return;
 	}
-	uint16_t n;uint8_t c;
+	uint16_t n;
+	uint8_t buffer[4096];
 	do {
-		n=1;
-		DOS_ReadFile(handle,&c,&n);
-		if (c == 0x1a) break; // stop at EOF
-		DOS_WriteFile(STDOUT,&c,&n);
+		n = sizeof(buffer);
+		DOS_ReadFile(handle, buffer, &n);
+
+		// Stop at the DOS end-of-file marker
+		uint16_t to_write = n;
+		for (uint16_t i = 0; i < n; ++i) {
+			if (buffer[i] == 0x1a) {
+				to_write = i;
+				n = 0;
+				break;
+			}
+		}
+		if (to_write) {
+			DOS_WriteFile(STDOUT, buffer, &to_write);
+		}
 	} while (n);
 	DOS_CloseFile(handle);
 	if (*args) goto nextfile;
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "../ints/int10.h"
 #include "callback.h"
@@ -625,38 +626,39 @@ static void run_binary_executable(const std::string_view fullname,
 
 bool DOS_Shell::GetEnvStr(const char* entry, std::string& result) const
 {
-	/* Walk through the internal environment and see for a match */
-	PhysPt env_read = PhysicalMake(psp->GetEnvironment(), 0);
-
-	char env_string[1024 + 1];
 	result.erase();
 	if (!entry[0]) {
 		return false;
 	}
+
+	/* Copy the environment block to the host side in one go and scan it
+	   there; walking the guest strings directly costs a paging lookup
+	   per byte, which adds up with many %VAR% expansions */
+	const auto env_seg = psp->GetEnvironment();
+	DOS_MCB env_mcb(env_seg - 1);
+	const uint32_t env_size = env_mcb.GetSize() * 16;
+	if (!env_size) {
+		return false;
+	}
+
+	std::vector<char> env_block(env_size);
+	MEM_BlockRead(PhysicalMake(env_seg, 0), env_block.data(), env_size);
+
 	const auto entry_length = strlen(entry);
-	do {
-		MEM_StrCopy(env_read, env_string, 1024);
-		if (!env_string[0]) {
-			return false;
-		}
-		env_read += (PhysPt)(safe_strlen(env_string) + 1);
-		char* equal = strchr(env_string, '=');
-		if (!equal) {
-			continue;
-		}
-		/* replace the = with \0 to get the length */
-		*equal = 0;
-		if (strlen(env_string) != entry_length) {
-			continue;
-		}
-		if (strcasecmp(entry, env_string) != 0) {
-			continue;
+
+	const char* cursor    = env_block.data();
+	const char* block_end = cursor + env_size;
+	while (cursor < block_end && *cursor) {
+		const auto str_len = strnlen(cursor, block_end - cursor);
+		const auto* equal  = static_cast<const char*>(
+		        memchr(cursor, '=', str_len));
+		if (equal && static_cast<size_t>(equal - cursor) == entry_length &&
+		    strncasecmp(entry, cursor, entry_length) == 0) {
+			result.assign(cursor, str_len);
+			return true;
 		}
-		/* restore the = to get the original result */
-		*equal = '=';
-		result = env_string;
-		return true;
-	} while (1);
+		cursor += str_len + 1;
+	}
 	return false;
 }
 
@@ -0,0 +1,320 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// dosbox-audiobench: audio DSP stage throughput micro-benchmark
+//
+// Boots a minimal machine (the same sections the unit-test fixture uses)
+// and runs each DSP stage of the audio path over canned input blocks:
+// the MixerChannel sample-conversion templates (through AddSamples_* on
+// a registered channel), the speex resampler at the rate pairs the
+// emulated cards commonly use, the MVerb reverb, the TAL chorus engine
+// and the master Compressor.
+//
+// Results are printed as JSON on stdout, one object per stage/config
+// combination with the cost in nanoseconds per frame, for consumption
+// by external regression tracking. Run it from the project root so the
+// test config file is found:
+//
+//   ./build/tests/dosbox-audiobench
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define SDL_MAIN_HANDLED
+
+#include <speex/speex_resampler.h>
+
+#include "mverb/MVerb.h"
+#include "tal-chorus/ChorusEngine.h"
+
+#include "control.h"
+#include "cross.h"
+#include "dosbox.h"
+#include "mixer.h"
+#include "setup.h"
+#include "src/hardware/compressor.h"
+
+namespace {
+
+constexpr uint16_t BlockFrames = 1024;
+
+constexpr double SecondsPerRun = 0.25;
+
+// Deterministic full-scale noise so every stage gets a non-trivial signal
+template <typename T>
+std::vector<T> MakeNoiseBlock(const size_t num_samples, const double scale)
+{
+	std::vector<T> block(num_samples);
+	uint32_t lcg_state = 0x12345678;
+	for (auto& sample : block) {
+		lcg_state = lcg_state * 1664525 + 1013904223;
+		const auto unit = static_cast<double>(static_cast<int32_t>(lcg_state)) /
+		                  2147483648.0;
+		sample = static_cast<T>(unit * scale);
+	}
+	return block;
+}
+
+// Runs whole-block batches of `workload` until the measurement interval
+// has elapsed; the workload returns the number of frames it processed.
+template <typename Workload>
+double MeasureNsPerFrame(Workload&& workload)
+{
+	int64_t num_frames = 0;
+
+	const auto start_time = std::chrono::steady_clock::now();
+	auto elapsed_seconds  = 0.0;
+
+	while (elapsed_seconds < SecondsPerRun) {
+		num_frames += workload();
+		elapsed_seconds = std::chrono::duration<double>(
+		                          std::chrono::steady_clock::now() -
+		                          start_time)
+		                          .count();
+	}
+	return elapsed_seconds * 1e9 / static_cast<double>(num_frames);
+}
+
+void PrintRow(bool& first_row, const char* stage, const char* config,
+              const double ns_per_frame)
+{
+	printf("%s    {\"stage\": \"%s\", \"config\": \"%s\", "
+	       "\"ns_per_frame\": %.1f}",
+	       first_row ? "" : ",\n",
+	       stage,
+	       config,
+	       ns_per_frame);
+	first_row = false;
+}
+
+// --- MixerChannel conversion templates --------------------------------------
+
+void BenchMixerConversion(bool& first_row)
+{
+	// Channel at the mixer's own rate so AddSamples measures pure
+	// conversion and accumulation, without the resampler stage
+	auto channel = MIXER_AddChannel([](uint16_t) {},
+	                                MIXER_GetSampleRate(),
+	                                "BENCH",
+	                                {});
+
+	const auto mono_u8 = MakeNoiseBlock<uint8_t>(BlockFrames, 127.0);
+	const auto stereo_s8 = MakeNoiseBlock<int8_t>(BlockFrames * 2, 127.0);
+	const auto mono_s16 = MakeNoiseBlock<int16_t>(BlockFrames, 32000.0);
+	const auto stereo_s16 = MakeNoiseBlock<int16_t>(BlockFrames * 2, 32000.0);
+	const auto stereo_s32 = MakeNoiseBlock<int32_t>(BlockFrames * 2,
+	                                                2000000000.0);
+	const auto stereo_float = MakeNoiseBlock<float>(BlockFrames * 2, 1.0);
+
+	PrintRow(first_row, "mixer_convert", "m8", MeasureNsPerFrame([&] {
+		         channel->AddSamples_m8(BlockFrames, mono_u8.data());
+		         return BlockFrames;
+	         }));
+	PrintRow(first_row, "mixer_convert", "s8s", MeasureNsPerFrame([&] {
+		         channel->AddSamples_s8s(BlockFrames, stereo_s8.data());
+		         return BlockFrames;
+	         }));
+	PrintRow(first_row, "mixer_convert", "m16", MeasureNsPerFrame([&] {
+		         channel->AddSamples_m16(BlockFrames, mono_s16.data());
+		         return BlockFrames;
+	         }));
+	PrintRow(first_row, "mixer_convert", "s16", MeasureNsPerFrame([&] {
+		         channel->AddSamples_s16(BlockFrames, stereo_s16.data());
+		         return BlockFrames;
+	         }));
+	PrintRow(first_row, "mixer_convert", "s16_nonnative", MeasureNsPerFrame([&] {
+		         channel->AddSamples_s16_nonnative(BlockFrames,
+		                                           stereo_s16.data());
+		         return BlockFrames;
+	         }));
+	PrintRow(first_row, "mixer_convert", "s32", MeasureNsPerFrame([&] {
+		         channel->AddSamples_s32(BlockFrames, stereo_s32.data());
+		         return BlockFrames;
+	         }));
+	PrintRow(first_row, "mixer_convert", "sfloat", MeasureNsPerFrame([&] {
+		         channel->AddSamples_sfloat(BlockFrames,
+		                                    stereo_float.data());
+		         return BlockFrames;
+	         }));
+
+	MIXER_DeregisterChannel(channel);
+}
+
+// --- Speex resampler --------------------------------------------------------
+
+void BenchSpeexResampler(bool& first_row)
+{
+	// The rate pairs the emulated cards commonly feed the mixer, at the
+	// same quality setting MixerChannel configures
+	constexpr struct {
+		const char* name;
+		uint32_t in_rate;
+		uint32_t out_rate;
+	} configs[] = {
+	        {"8000_to_48000", 8000, 48000},
+	        {"11025_to_48000", 11025, 48000},
+	        {"22050_to_48000", 22050, 48000},
+	        {"44100_to_48000", 44100, 48000},
+	        {"48000_to_44100", 48000, 44100},
+	};
+
+	const auto input = MakeNoiseBlock<float>(BlockFrames * 2, 1.0);
+
+	for (const auto& config : configs) {
+		constexpr auto num_channels = 2;
+		constexpr auto quality      = 5;
+
+		auto state = speex_resampler_init(num_channels, config.in_rate,
+		                                  config.out_rate, quality,
+		                                  nullptr);
+		if (!state) {
+			continue;
+		}
+
+		// Worst-case upsampling is 6x, plus rounding slack
+		std::vector<float> output(BlockFrames * 2 * 8);
+
+		const auto ns_per_frame = MeasureNsPerFrame([&] {
+			auto in_frames = static_cast<uint32_t>(BlockFrames);
+			auto out_frames = static_cast<uint32_t>(output.size() / 2);
+			speex_resampler_process_interleaved_float(state,
+			                                          input.data(),
+			                                          &in_frames,
+			                                          output.data(),
+			                                          &out_frames);
+			return in_frames;
+		});
+		PrintRow(first_row, "speex_resample", config.name, ns_per_frame);
+
+		speex_resampler_destroy(state);
+	}
+}
+
+// --- Effect kernels ---------------------------------------------------------
+
+void BenchReverb(bool& first_row)
+{
+	using EmVerb = MVerb<float>;
+
+	// The 'medium' and 'large' presets from the mixer's reverb table
+	constexpr struct {
+		const char* name;
+		float early_mix, size, density, bandwidth_freq, decay,
+		        dampening_freq;
+	} configs[] = {
+	        {"medium", 0.75f, 0.50f, 0.50f, 0.95f, 0.42f, 0.21f},
+	        {"large", 0.75f, 0.75f, 0.50f, 0.95f, 0.52f, 0.21f},
+	};
+
+	auto in_left   = MakeNoiseBlock<float>(BlockFrames, 1.0);
+	auto in_right  = MakeNoiseBlock<float>(BlockFrames, 1.0);
+	float* buf[2]  = {in_left.data(), in_right.data()};
+
+	for (const auto& config : configs) {
+		EmVerb mverb = {};
+		mverb.setParameter(EmVerb::PREDELAY, 0.0f);
+		mverb.setParameter(EmVerb::EARLYMIX, config.early_mix);
+		mverb.setParameter(EmVerb::SIZE, config.size);
+		mverb.setParameter(EmVerb::DENSITY, config.density);
+		mverb.setParameter(EmVerb::BANDWIDTHFREQ, config.bandwidth_freq);
+		mverb.setParameter(EmVerb::DECAY, config.decay);
+		mverb.setParameter(EmVerb::DAMPINGFREQ, config.dampening_freq);
+		mverb.setParameter(EmVerb::GAIN, 1.0f);
+		mverb.setParameter(EmVerb::MIX, 1.0f);
+		mverb.setSampleRate(static_cast<float>(MIXER_GetSampleRate()));
+
+		const auto ns_per_frame = MeasureNsPerFrame([&] {
+			mverb.process(buf, buf, BlockFrames);
+			return BlockFrames;
+		});
+		PrintRow(first_row, "reverb_mverb", config.name, ns_per_frame);
+	}
+}
+
+void BenchChorus(bool& first_row)
+{
+	ChorusEngine chorus_engine(MIXER_GetSampleRate());
+	chorus_engine.setEnablesChorus(true, false);
+
+	auto left  = MakeNoiseBlock<float>(BlockFrames, 1.0);
+	auto right = MakeNoiseBlock<float>(BlockFrames, 1.0);
+
+	const auto ns_per_frame = MeasureNsPerFrame([&] {
+		chorus_engine.process(left.data(), right.data(), BlockFrames);
+		return BlockFrames;
+	});
+	PrintRow(first_row, "chorus_tal", "chorus1", ns_per_frame);
+}
+
+void BenchCompressor(bool& first_row)
+{
+	// The master compressor settings from init_compressor()
+	Compressor compressor = {};
+	compressor.Configure(MIXER_GetSampleRate(),
+	                     32767.0f,
+	                     -6.0f,   // threshold (dB)
+	                     3.0f,    // ratio
+	                     0.01f,   // attack (ms)
+	                     5000.0f, // release (ms)
+	                     10.0f);  // RMS window (ms)
+
+	auto left  = MakeNoiseBlock<float>(BlockFrames, 32000.0);
+	auto right = MakeNoiseBlock<float>(BlockFrames, 32000.0);
+
+	const auto ns_per_frame = MeasureNsPerFrame([&] {
+		compressor.Process(left.data(), right.data(), BlockFrames);
+		return BlockFrames;
+	});
+	PrintRow(first_row, "compressor", "master", ns_per_frame);
+}
+
+} // namespace
+
+int main(int, char**)
+{
+	// Boot the same minimal machine the unit-test fixture uses; the
+	// mixer section provides the channel registry and output rate
+	const char* bench_args[] = {"-conf tests/files/dosbox-staging-tests.conf"};
+	CommandLine command_line(1, bench_args);
+	control = std::make_unique<Config>(&command_line);
+
+	InitConfigDir();
+	control->ParseConfigFiles(GetConfigDir());
+
+	DOSBOX_Init();
+	for (const auto section_name : {"dosbox", "cpu", "mixer"}) {
+		control->GetSection(section_name)->ExecuteInit();
+	}
+
+	printf("{\n  \"benchmarks\": [\n");
+	bool first_row = true;
+
+	BenchMixerConversion(first_row);
+	BenchSpeexResampler(first_row);
+	BenchReverb(first_row);
+	BenchChorus(first_row);
+	BenchCompressor(first_row);
+
+	printf("\n  ]\n}\n");
+	return 0;
+}
@@ -0,0 +1,241 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2023-2023  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// dosbox-bench: CPU core throughput micro-benchmark
+//
+// Boots a minimal machine (the same sections the unit-test fixture uses),
+// copies tiny self-looping real-mode payloads into guest memory, and runs
+// each available CPU core's decoder directly against them. The decoders
+// retire one cycle per guest instruction (the dynamic cores charge whole
+// blocks by their instruction count), so consumed cycles per wall second
+// approximates retired guest instructions per second.
+//
+// Results are printed as JSON on stdout, one object per core/workload
+// combination, for consumption by external acceptance gates. Run it from
+// the project root so the test config file is found:
+//
+//   ./build/tests/dosbox-bench
+
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#define SDL_MAIN_HANDLED
+
+#include "control.h"
+#include "cpu.h"
+#include "cross.h"
+#include "dosbox.h"
+#include "mem.h"
+#include "regs.h"
+#include "setup.h"
+
+namespace {
+
+struct Workload {
+	const char* name = nullptr;
+
+	// Raw 8086 machine code, assembled to run from offset 0 of its
+	// segment and to loop forever
+	std::vector<uint8_t> code = {};
+};
+
+// clang-format off
+
+// ALU-heavy mix: immediate and register arithmetic, shifts, and logic
+//   start: mov ax,1 / add ax,2 / xor bx,ax / inc cx / shl bx,1
+//          sub ax,3 / dec cx / or ax,bx / jmp start
+const Workload alu_workload = {"alu_mix", {
+        0xb8, 0x01, 0x00,
+        0x05, 0x02, 0x00,
+        0x31, 0xc3,
+        0x41,
+        0xd1, 0xe3,
+        0x2d, 0x03, 0x00,
+        0x49,
+        0x09, 0xd8,
+        0xeb, 0xed}};
+
+// Memory-heavy mix: a byte-copy loop through the segment's own data area
+//   start: mov si,0x200 / mov di,0x300 / mov cx,64
+//   copy:  mov al,[si] / mov [di],al / inc si / inc di / loop copy
+//          jmp start
+const Workload mem_workload = {"mem_copy", {
+        0xbe, 0x00, 0x02,
+        0xbf, 0x00, 0x03,
+        0xb9, 0x40, 0x00,
+        0x8a, 0x04,
+        0x88, 0x05,
+        0x46,
+        0x47,
+        0xe2, 0xf8,
+        0xeb, 0xed}};
+
+// Branch-heavy mix: short call/return pairs with a data-dependent branch
+//   start: mov cx,32
+//   lp:    call sub1 / dec cx / jnz lp / jmp start
+//   sub1:  test cx,1 / jz even / inc dx / ret
+//   even:  dec dx / ret
+const Workload branch_workload = {"branch_call", {
+        0xb9, 0x20, 0x00,
+        0xe8, 0x07, 0x00,
+        0x49,
+        0x75, 0xfa,
+        0xeb, 0xf5,
+        0x90, 0x90,
+        0xf7, 0xc1, 0x01, 0x00,
+        0x74, 0x02,
+        0x42,
+        0xc3,
+        0x4a,
+        0xc3}};
+
+// clang-format on
+
+struct Core {
+	const char* name = nullptr;
+
+	// The value accepted by the [cpu] section's 'core' setting
+	const char* setting = nullptr;
+};
+
+std::vector<Core> GetAvailableCores()
+{
+	std::vector<Core> cores = {};
+	cores.push_back({"core_normal", "normal"});
+	cores.push_back({"core_prefetch", "prefetch"});
+#if (C_DYNAMIC_X86)
+	cores.push_back({"core_dyn_x86", "dynamic"});
+#elif (C_DYNREC)
+	cores.push_back({"core_dynrec", "dynamic"});
+#endif
+	return cores;
+}
+
+bool SelectCore(const char* core_setting)
+{
+	auto section = control->GetSection("cpu");
+	assert(section);
+	if (!section->HandleInputline(std::string("core=") + core_setting)) {
+		return false;
+	}
+	// Re-run only the runtime-changeable init functions, which is how
+	// CONFIG -set applies a core change
+	constexpr auto init_all = false;
+	section->ExecuteInit(init_all);
+	return true;
+}
+
+// Each workload gets its own segment so the dynamic cores don't invalidate
+// each other's code caches between runs
+constexpr uint16_t WorkloadSegment(const size_t workload_index)
+{
+	return static_cast<uint16_t>(0x1000 + 0x100 * workload_index);
+}
+
+constexpr uint16_t StackSegment = 0x3000;
+
+// Cycles granted to the decoder per slice; large enough to amortize the
+// call overhead, small enough to keep the wall-time target accurate
+constexpr int32_t CyclesPerSlice = 100'000;
+
+constexpr double SecondsPerRun = 0.25;
+
+double MeasureInstructionsPerSecond(const Workload& workload,
+                                    const size_t workload_index)
+{
+	// Point the CPU at the payload with a clean register file
+	cpu_regs = {};
+	SegSet16(cs, WorkloadSegment(workload_index));
+	SegSet16(ds, WorkloadSegment(workload_index));
+	SegSet16(es, WorkloadSegment(workload_index));
+	SegSet16(ss, StackSegment);
+	reg_esp = 0xfffe;
+	reg_eip = 0;
+
+	int64_t cycles_retired = 0;
+
+	const auto start_time = std::chrono::steady_clock::now();
+	auto elapsed_seconds  = 0.0;
+
+	while (elapsed_seconds < SecondsPerRun) {
+		CPU_Cycles    = CyclesPerSlice;
+		CPU_CycleLeft = 0;
+		(*cpudecoder)();
+		cycles_retired += CyclesPerSlice - CPU_Cycles;
+
+		elapsed_seconds = std::chrono::duration<double>(
+		                          std::chrono::steady_clock::now() -
+		                          start_time)
+		                          .count();
+	}
+	return static_cast<double>(cycles_retired) / elapsed_seconds;
+}
+
+} // namespace
+
+int main(int, char**)
+{
+	// Boot the same minimal machine the unit-test fixture uses
+	const char* bench_args[] = {"-conf tests/files/dosbox-staging-tests.conf"};
+	CommandLine command_line(1, bench_args);
+	control = std::make_unique<Config>(&command_line);
+
+	InitConfigDir();
+	control->ParseConfigFiles(GetConfigDir());
+
+	DOSBOX_Init();
+	for (const auto section_name : {"dosbox", "cpu"}) {
+		control->GetSection(section_name)->ExecuteInit();
+	}
+
+	const Workload workloads[] = {alu_workload, mem_workload, branch_workload};
+
+	// Stage every payload up-front
+	for (size_t i = 0; i < std::size(workloads); ++i) {
+		const auto& code = workloads[i].code;
+		MEM_BlockWrite(WorkloadSegment(i) * 16, code.data(), code.size());
+	}
+
+	printf("{\n  \"benchmarks\": [\n");
+
+	bool first_row = true;
+	for (const auto& core : GetAvailableCores()) {
+		if (!SelectCore(core.setting)) {
+			continue;
+		}
+		for (size_t i = 0; i < std::size(workloads); ++i) {
+			const auto rate = MeasureInstructionsPerSecond(workloads[i], i);
+
+			printf("%s    {\"core\": \"%s\", \"workload\": \"%s\", "
+			       "\"guest_instructions_per_sec\": %.0f}",
+			       first_row ? "" : ",\n",
+			       core.name,
+			       workloads[i].name,
+			       rate);
+			first_row = false;
+		}
+	}
+	printf("\n  ]\n}\n");
+	return 0;
+}
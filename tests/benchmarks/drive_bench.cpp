@@ -0,0 +1,481 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// dosbox-drivebench: DOS drive layer throughput micro-benchmark
+//
+// Boots a minimal machine (the same sections the unit-test fixture uses)
+// and drives localDrive, Overlay_Drive, fatDrive and isoDrive directly
+// through the DOS_Drive interface, below INT 21h but above the host
+// filesystem. The local and overlay drives run against a scratch
+// directory, the FAT drive against a freshly formatted 1.44M floppy
+// image, and the ISO drive against a synthesized ISO 9660 image, all
+// created under the system temp directory and removed afterwards.
+//
+// Workloads per drive: sequential whole-file reads, random 512-byte
+// reads within one file, FindFirst/FindNext directory enumeration
+// storms, and create/delete churn (skipped on the read-only ISO drive).
+//
+// Results are printed as JSON on stdout, one object per drive/workload
+// combination, for consumption by external regression tracking. Run it
+// from the project root so the test config file is found:
+//
+//   ./build/tests/dosbox-drivebench
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define SDL_MAIN_HANDLED
+
+#include "control.h"
+#include "cross.h"
+#include "dos_inc.h"
+#include "dos_system.h"
+#include "dosbox.h"
+#include "drives.h"
+#include "setup.h"
+#include "std_filesystem.h"
+
+namespace {
+
+// The directory layout every drive is populated with
+constexpr int NumFiles        = 32;
+constexpr uint32_t FileBytes  = 16 * 1024;
+constexpr uint16_t ChunkBytes = 4096;
+
+constexpr double SecondsPerRun = 0.25;
+
+// Geometry MOUNT uses for plain directory mounts
+constexpr uint16_t BytesPerSector   = 512;
+constexpr uint8_t SectorsPerCluster = 32;
+constexpr uint16_t TotalClusters    = 32765;
+constexpr uint16_t FreeClusters     = 16000;
+constexpr uint8_t MediaId           = 0xf8;
+
+std::string BenchFileName(const int index)
+{
+	char name[16];
+	snprintf(name, sizeof(name), "BENCH%03d.DAT", index);
+	return name;
+}
+
+// --- Scratch image synthesis ------------------------------------------------
+
+bool WriteFileBytes(const std_fs::path& path, const std::vector<uint8_t>& bytes)
+{
+	FILE* f = fopen(path.string().c_str(), "wb");
+	if (!f) {
+		return false;
+	}
+	const auto written = fwrite(bytes.data(), 1, bytes.size(), f);
+	fclose(f);
+	return written == bytes.size();
+}
+
+// Freshly formatted, empty 1.44M FAT12 floppy image; the benchmark files
+// are written through the fatDrive API afterwards so the FAT code paths
+// get exercised for the population too.
+bool WriteFatImage(const std_fs::path& path)
+{
+	constexpr uint32_t NumSectors = 2880;
+	std::vector<uint8_t> image(NumSectors * 512, 0);
+
+	uint8_t* boot = image.data();
+	boot[0]       = 0xeb; // jmp short
+	boot[1]       = 0x3c;
+	boot[2]       = 0x90; // nop
+	memcpy(&boot[3], "MSDOS5.0", 8);
+	boot[11] = 0x00; // 512 bytes per sector
+	boot[12] = 0x02;
+	boot[13] = 0x01; // 1 sector per cluster
+	boot[14] = 0x01; // 1 reserved sector
+	boot[15] = 0x00;
+	boot[16] = 0x02; // 2 FATs
+	boot[17] = 0xe0; // 224 root entries
+	boot[18] = 0x00;
+	boot[19] = NumSectors & 0xff;
+	boot[20] = NumSectors >> 8;
+	boot[21] = 0xf0; // media descriptor
+	boot[22] = 0x09; // 9 sectors per FAT
+	boot[23] = 0x00;
+	boot[24] = 0x12; // 18 sectors per track
+	boot[25] = 0x00;
+	boot[26] = 0x02; // 2 heads
+	boot[27] = 0x00;
+	boot[510] = 0x55;
+	boot[511] = 0xaa;
+
+	// Media descriptor entries at the start of both FATs
+	for (const uint32_t fat_sector : {1, 10}) {
+		uint8_t* fat = image.data() + fat_sector * 512;
+		fat[0]       = 0xf0;
+		fat[1]       = 0xff;
+		fat[2]       = 0xff;
+	}
+	return WriteFileBytes(path, image);
+}
+
+void WriteBothEndian16(uint8_t* dest, const uint16_t val)
+{
+	dest[0] = val & 0xff;
+	dest[1] = val >> 8;
+	dest[2] = val >> 8;
+	dest[3] = val & 0xff;
+}
+
+void WriteBothEndian32(uint8_t* dest, const uint32_t val)
+{
+	for (int i = 0; i < 4; ++i) {
+		dest[i]     = (val >> (8 * i)) & 0xff;
+		dest[7 - i] = (val >> (8 * i)) & 0xff;
+	}
+}
+
+// Appends an ISO 9660 directory record; returns its length
+size_t WriteIsoDirRecord(uint8_t* dest, const uint32_t extent_lba,
+                         const uint32_t num_bytes, const uint8_t flags,
+                         const char* ident, const size_t ident_len)
+{
+	const size_t record_len = (33 + ident_len + 1) & ~size_t(1);
+	memset(dest, 0, record_len);
+	dest[0] = static_cast<uint8_t>(record_len);
+	WriteBothEndian32(&dest[2], extent_lba);
+	WriteBothEndian32(&dest[10], num_bytes);
+	dest[25] = flags;
+	WriteBothEndian16(&dest[28], 1); // volume sequence number
+	dest[32] = static_cast<uint8_t>(ident_len);
+	memcpy(&dest[33], ident, ident_len);
+	return record_len;
+}
+
+// Minimal single-directory ISO 9660 image already holding the benchmark
+// files (the ISO drive is read-only, so it can't be populated via its API)
+bool WriteIsoImage(const std_fs::path& path)
+{
+	constexpr uint32_t SectorBytes     = 2048;
+	constexpr uint32_t RootDirSector   = 18;
+	constexpr uint32_t FileDataSector  = 19;
+	constexpr uint32_t SectorsPerFile  = FileBytes / SectorBytes;
+	constexpr uint32_t TotalSectors = FileDataSector + NumFiles * SectorsPerFile;
+
+	std::vector<uint8_t> image(TotalSectors * SectorBytes, 0);
+
+	// Primary volume descriptor
+	uint8_t* pvd = image.data() + 16 * SectorBytes;
+	pvd[0]       = 1; // type: primary
+	memcpy(&pvd[1], "CD001", 5);
+	pvd[6] = 1; // version
+	memset(&pvd[8], ' ', 32 + 32); // system + volume identifiers
+	memcpy(&pvd[40], "DRIVEBENCH", 10);
+	WriteBothEndian32(&pvd[80], TotalSectors);
+	WriteBothEndian16(&pvd[120], 1); // volume set size
+	WriteBothEndian16(&pvd[124], 1); // volume sequence number
+	WriteBothEndian16(&pvd[128], SectorBytes);
+	WriteIsoDirRecord(&pvd[156], RootDirSector, SectorBytes, 2, "\0", 1);
+
+	// Volume descriptor set terminator
+	uint8_t* term = image.data() + 17 * SectorBytes;
+	term[0]       = 255;
+	memcpy(&term[1], "CD001", 5);
+	term[6] = 1;
+
+	// Root directory: ".", ".." and the benchmark files
+	uint8_t* dir = image.data() + RootDirSector * SectorBytes;
+	dir += WriteIsoDirRecord(dir, RootDirSector, SectorBytes, 2, "\0", 1);
+	dir += WriteIsoDirRecord(dir, RootDirSector, SectorBytes, 2, "\1", 1);
+	for (int i = 0; i < NumFiles; ++i) {
+		const auto ident = BenchFileName(i) + ";1";
+		dir += WriteIsoDirRecord(dir,
+		                         FileDataSector + i * SectorsPerFile,
+		                         FileBytes, 0, ident.c_str(),
+		                         ident.size());
+	}
+
+	// File payloads
+	uint8_t* data = image.data() + FileDataSector * SectorBytes;
+	memset(data, 0x5a, NumFiles * SectorsPerFile * SectorBytes);
+
+	return WriteFileBytes(path, image);
+}
+
+// --- Workloads --------------------------------------------------------------
+
+bool PopulateDrive(DOS_Drive& drive)
+{
+	std::vector<uint8_t> payload(ChunkBytes, 0x5a);
+	for (int i = 0; i < NumFiles; ++i) {
+		auto name = BenchFileName(i);
+		DOS_File* file = nullptr;
+		if (!drive.FileCreate(&file, name.data(), FatAttributeFlags::Archive)) {
+			return false;
+		}
+		for (uint32_t written = 0; written < FileBytes;
+		     written += ChunkBytes) {
+			uint16_t num_bytes = ChunkBytes;
+			file->Write(payload.data(), &num_bytes);
+		}
+		file->Close();
+		delete file;
+	}
+	return true;
+}
+
+struct Rates {
+	double ops_per_sec   = 0.0;
+	double bytes_per_sec = 0.0;
+};
+
+// Runs batches of `workload` until the measurement interval has elapsed;
+// the workload reports ops and bytes completed per batch.
+template <typename Workload>
+Rates Measure(Workload&& workload)
+{
+	int64_t num_ops   = 0;
+	int64_t num_bytes = 0;
+
+	const auto start_time = std::chrono::steady_clock::now();
+	auto elapsed_seconds  = 0.0;
+
+	while (elapsed_seconds < SecondsPerRun) {
+		workload(num_ops, num_bytes);
+		elapsed_seconds = std::chrono::duration<double>(
+		                          std::chrono::steady_clock::now() -
+		                          start_time)
+		                          .count();
+	}
+	return {static_cast<double>(num_ops) / elapsed_seconds,
+	        static_cast<double>(num_bytes) / elapsed_seconds};
+}
+
+Rates MeasureSequentialRead(DOS_Drive& drive)
+{
+	std::vector<uint8_t> buffer(ChunkBytes);
+	return Measure([&](int64_t& num_ops, int64_t& num_bytes) {
+		for (int i = 0; i < NumFiles; ++i) {
+			auto name = BenchFileName(i);
+			DOS_File* file = nullptr;
+			if (!drive.FileOpen(&file, name.data(), OPEN_READ)) {
+				continue;
+			}
+			uint16_t num_read = ChunkBytes;
+			while (file->Read(buffer.data(), &num_read) && num_read) {
+				num_bytes += num_read;
+				num_read = ChunkBytes;
+			}
+			file->Close();
+			delete file;
+			++num_ops;
+		}
+	});
+}
+
+Rates MeasureRandomRead(DOS_Drive& drive)
+{
+	auto name = BenchFileName(0);
+	DOS_File* file = nullptr;
+	if (!drive.FileOpen(&file, name.data(), OPEN_READ)) {
+		return {};
+	}
+
+	std::vector<uint8_t> buffer(BytesPerSector);
+	uint32_t lcg_state = 0x12345678;
+
+	const auto rates = Measure([&](int64_t& num_ops, int64_t& num_bytes) {
+		for (int i = 0; i < 256; ++i) {
+			lcg_state = lcg_state * 1664525 + 1013904223;
+			uint32_t pos = (lcg_state % (FileBytes / BytesPerSector)) *
+			               BytesPerSector;
+			file->Seek(&pos, DOS_SEEK_SET);
+
+			uint16_t num_read = BytesPerSector;
+			file->Read(buffer.data(), &num_read);
+			num_bytes += num_read;
+			++num_ops;
+		}
+	});
+
+	file->Close();
+	delete file;
+	return rates;
+}
+
+Rates MeasureFindFirstStorm(DOS_Drive& drive)
+{
+	DOS_DTA dta(dos.tables.tempdta);
+	return Measure([&](int64_t& num_ops, int64_t& num_bytes) {
+		for (int scan = 0; scan < 16; ++scan) {
+			char pattern[] = "*.*";
+			dta.SetupSearch(0, FatAttributeFlags::NotVolume, pattern);
+			char dir[] = "";
+			if (!drive.FindFirst(dir, dta)) {
+				continue;
+			}
+			++num_ops;
+			while (drive.FindNext(dta)) {
+				++num_ops;
+			}
+		}
+		num_bytes = 0;
+	});
+}
+
+Rates MeasureCreateDeleteChurn(DOS_Drive& drive)
+{
+	std::vector<uint8_t> payload(BytesPerSector, 0x5a);
+	return Measure([&](int64_t& num_ops, int64_t& num_bytes) {
+		for (int i = 0; i < 64; ++i) {
+			char name[] = "CHURN.TMP";
+			DOS_File* file = nullptr;
+			if (!drive.FileCreate(&file, name,
+			                      FatAttributeFlags::Archive)) {
+				continue;
+			}
+			uint16_t num_written = BytesPerSector;
+			file->Write(payload.data(), &num_written);
+			file->Close();
+			delete file;
+			drive.FileUnlink(name);
+			num_bytes += num_written;
+			++num_ops;
+		}
+	});
+}
+
+void PrintRow(bool& first_row, const char* drive_name, const char* workload,
+              const Rates& rates)
+{
+	printf("%s    {\"drive\": \"%s\", \"workload\": \"%s\", "
+	       "\"ops_per_sec\": %.0f, \"mib_per_sec\": %.1f}",
+	       first_row ? "" : ",\n",
+	       drive_name,
+	       workload,
+	       rates.ops_per_sec,
+	       rates.bytes_per_sec / (1024.0 * 1024.0));
+	first_row = false;
+}
+
+void BenchDrive(bool& first_row, const char* drive_name, DOS_Drive& drive,
+                const bool writable)
+{
+	PrintRow(first_row, drive_name, "seq_read", MeasureSequentialRead(drive));
+	PrintRow(first_row, drive_name, "random_read", MeasureRandomRead(drive));
+	PrintRow(first_row, drive_name, "find_first", MeasureFindFirstStorm(drive));
+	if (writable) {
+		PrintRow(first_row, drive_name, "create_delete",
+		         MeasureCreateDeleteChurn(drive));
+	}
+}
+
+} // namespace
+
+int main(int, char**)
+{
+	// Boot the same minimal machine the unit-test fixture uses; the DOS
+	// section is needed for guest-side DTA memory and MSCDEX
+	const char* bench_args[] = {"-conf tests/files/dosbox-staging-tests.conf"};
+	CommandLine command_line(1, bench_args);
+	control = std::make_unique<Config>(&command_line);
+
+	InitConfigDir();
+	control->ParseConfigFiles(GetConfigDir());
+
+	DOSBOX_Init();
+	for (const auto section_name : {"dosbox", "cpu", "mixer", "midi",
+	                                "sblaster", "speaker", "serial", "dos"}) {
+		control->GetSection(section_name)->ExecuteInit();
+	}
+
+	// Scratch area under the system temp directory
+	const auto scratch_dir = std_fs::temp_directory_path() /
+	                         "dosbox-drivebench-scratch";
+	const auto base_dir    = scratch_dir / "base";
+	const auto overlay_dir = scratch_dir / "overlay";
+	std_fs::create_directories(base_dir);
+	std_fs::create_directories(overlay_dir);
+
+	// localDrive expects its base directory with a trailing separator
+	const auto base_str    = base_dir.string() + "/";
+	const auto overlay_str = overlay_dir.string() + "/";
+
+	printf("{\n  \"benchmarks\": [\n");
+	bool first_row = true;
+
+	{
+		localDrive drive(base_str.c_str(), BytesPerSector,
+		                 SectorsPerCluster, TotalClusters, FreeClusters,
+		                 MediaId);
+		if (PopulateDrive(drive)) {
+			BenchDrive(first_row, "local", drive, true);
+		} else {
+			fprintf(stderr, "drivebench: populating localDrive failed\n");
+		}
+	}
+
+	{
+		// Same populated base directory, writes diverted to the overlay
+		uint8_t error = 0;
+		Overlay_Drive drive(base_str.c_str(), overlay_str.c_str(),
+		                    BytesPerSector, SectorsPerCluster,
+		                    TotalClusters, FreeClusters, MediaId, error);
+		if (error == 0) {
+			BenchDrive(first_row, "overlay", drive, true);
+		} else {
+			fprintf(stderr, "drivebench: Overlay_Drive setup failed (%u)\n",
+			        error);
+		}
+	}
+
+	{
+		const auto image_path = scratch_dir / "floppy.img";
+		if (WriteFatImage(image_path)) {
+			fatDrive drive(image_path.string().c_str(), 0, 0, 0, 0,
+			               0, false);
+			if (drive.created_successfully && PopulateDrive(drive)) {
+				BenchDrive(first_row, "fat", drive, true);
+			} else {
+				fprintf(stderr, "drivebench: mounting FAT image failed\n");
+			}
+		}
+	}
+
+	{
+		const auto image_path = scratch_dir / "cdrom.iso";
+		if (WriteIsoImage(image_path)) {
+			int error = 0;
+			isoDrive drive('D', image_path.string().c_str(),
+			               MediaId, error);
+			if (error == 0) {
+				BenchDrive(first_row, "iso", drive, false);
+			} else {
+				fprintf(stderr, "drivebench: mounting ISO image failed (%d)\n",
+				        error);
+			}
+		}
+	}
+
+	printf("\n  ]\n}\n");
+
+	std::error_code ec = {};
+	std_fs::remove_all(scratch_dir, ec);
+	return 0;
+}
@@ -0,0 +1,195 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+// dosbox-imagebench: screenshot upscaler throughput micro-benchmark
+//
+// Runs the capture ImageScaler over synthetic frames in the video modes
+// and pixel formats the screenshot path commonly sees, covering both the
+// integer (palette/RGB replication) and the fractional ("sharp-bilinear")
+// code paths. The scaler is self-contained, so no machine is booted.
+//
+// Results are printed as JSON on stdout, one object per input mode, with
+// the cost per full upscaled frame and the output pixel rate, for
+// consumption by external regression tracking:
+//
+//   ./build/tests/dosbox-imagebench
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#define SDL_MAIN_HANDLED
+
+#include "src/capture/image/image_scaler.h"
+
+#include "fraction.h"
+#include "render.h"
+#include "video.h"
+
+namespace {
+
+constexpr double SecondsPerRun = 0.25;
+
+uint8_t to_bytes_per_pixel(const PixelFormat format)
+{
+	switch (format) {
+	case PixelFormat::Indexed8: return 1;
+	case PixelFormat::RGB555_Packed16:
+	case PixelFormat::RGB565_Packed16: return 2;
+	case PixelFormat::BGR24_ByteArray: return 3;
+	case PixelFormat::BGRX32_ByteArray: return 4;
+	default: assert(false); return 0;
+	}
+}
+
+// Owns the pixel and palette storage the RenderedImage points into
+struct BenchImage {
+	std::vector<uint8_t> pixels  = {};
+	std::vector<uint8_t> palette = {};
+
+	RenderedImage image = {};
+};
+
+// Deterministic noise frame in the given video mode; the scaler's cost is
+// data-independent, the noise just keeps the input non-trivial.
+BenchImage MakeBenchImage(const uint16_t width, const uint16_t height,
+                          const PixelFormat pixel_format,
+                          const Fraction& pixel_aspect_ratio)
+{
+	BenchImage bench_image = {};
+
+	const auto pitch = static_cast<uint16_t>(width *
+	                                         to_bytes_per_pixel(pixel_format));
+
+	bench_image.pixels.resize(static_cast<size_t>(pitch) * height);
+	bench_image.palette.resize(256 * 4);
+
+	uint32_t lcg_state = 0x12345678;
+	auto next_byte     = [&] {
+		lcg_state = lcg_state * 1664525 + 1013904223;
+		return static_cast<uint8_t>(lcg_state >> 24);
+	};
+	for (auto& byte : bench_image.pixels) {
+		byte = next_byte();
+	}
+	for (auto& byte : bench_image.palette) {
+		byte = next_byte();
+	}
+
+	auto& image = bench_image.image;
+
+	image.params.width              = width;
+	image.params.height             = height;
+	image.params.pixel_aspect_ratio = pixel_aspect_ratio;
+	image.params.pixel_format       = pixel_format;
+
+	image.params.video_mode.width              = width;
+	image.params.video_mode.height             = height;
+	image.params.video_mode.pixel_aspect_ratio = pixel_aspect_ratio;
+
+	image.pitch        = pitch;
+	image.image_data   = bench_image.pixels.data();
+	image.palette_data = bench_image.palette.data();
+
+	return bench_image;
+}
+
+void BenchScaler(bool& first_row, const char* config, const BenchImage& bench_image)
+{
+	ImageScaler scaler = {};
+
+	int64_t num_images = 0;
+
+	const auto start_time = std::chrono::steady_clock::now();
+	auto elapsed_seconds  = 0.0;
+
+	while (elapsed_seconds < SecondsPerRun) {
+		scaler.Init(bench_image.image);
+
+		auto rows_to_write = scaler.GetOutputHeight();
+		while (rows_to_write--) {
+			scaler.GetNextOutputRow();
+		}
+		++num_images;
+
+		elapsed_seconds = std::chrono::duration<double>(
+		                          std::chrono::steady_clock::now() -
+		                          start_time)
+		                          .count();
+	}
+
+	// Re-query the output size for the report; Init() above has already
+	// settled the scaling parameters.
+	scaler.Init(bench_image.image);
+
+	const auto output_pixels = static_cast<double>(scaler.GetOutputWidth()) *
+	                           scaler.GetOutputHeight();
+
+	const auto us_per_image = elapsed_seconds * 1e6 /
+	                          static_cast<double>(num_images);
+
+	const auto mpix_per_sec = output_pixels * static_cast<double>(num_images) /
+	                          elapsed_seconds / 1e6;
+
+	printf("%s    {\"config\": \"%s\", \"output\": \"%dx%d\", "
+	       "\"us_per_image\": %.1f, \"mpix_per_sec\": %.1f}",
+	       first_row ? "" : ",\n",
+	       config,
+	       scaler.GetOutputWidth(),
+	       scaler.GetOutputHeight(),
+	       us_per_image,
+	       mpix_per_sec);
+	first_row = false;
+}
+
+} // namespace
+
+int main(int, char**)
+{
+	// Mode selection: 320x200 mode 13h exercises the paletted integer
+	// path, 640x480 and 320x240 the RGB integer path, and the EGA and
+	// text modes the fractional sharp-bilinear path.
+	const auto vga_320x200 = MakeBenchImage(
+	        320, 200, PixelFormat::Indexed8, {5, 6});
+
+	const auto vesa_320x240 = MakeBenchImage(
+	        320, 240, PixelFormat::Indexed8, {1, 1});
+
+	const auto vesa_640x480 = MakeBenchImage(
+	        640, 480, PixelFormat::BGRX32_ByteArray, {1, 1});
+
+	const auto ega_640x350 = MakeBenchImage(
+	        640, 350, PixelFormat::BGR24_ByteArray, {35, 48});
+
+	const auto text_720x400 = MakeBenchImage(
+	        720, 400, PixelFormat::RGB565_Packed16, {20, 27});
+
+	printf("{\n  \"benchmarks\": [\n");
+	bool first_row = true;
+
+	BenchScaler(first_row, "vga_320x200_indexed8", vga_320x200);
+	BenchScaler(first_row, "vesa_320x240_indexed8", vesa_320x240);
+	BenchScaler(first_row, "vesa_640x480_bgrx32", vesa_640x480);
+	BenchScaler(first_row, "ega_640x350_bgr24", ega_640x350);
+	BenchScaler(first_row, "text_720x400_rgb565", text_720x400);
+
+	printf("\n  ]\n}\n");
+	return 0;
+}
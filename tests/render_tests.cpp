@@ -0,0 +1,125 @@
+/*
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ *  Copyright (C) 2024  The DOSBox Staging Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "render.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// A 320x200 32-bit frame, the most common capture size
+constexpr uint32_t Mode13hFrameBytes = 320 * 200 * 4;
+
+TEST(RenderFrameBufferPool, SteadyStateStaysOffTheHeap)
+{
+	// Warm the pool with one frame-sized buffer
+	RENDER_ReleaseFrameBuffer(RENDER_AcquireFrameBuffer(Mode13hFrameBytes));
+
+	const auto before = RENDER_GetFrameBufferPoolStats();
+
+	// The capture cadence: one acquire and release per frame
+	constexpr auto num_frames = 100;
+	for (auto i = 0; i < num_frames; ++i) {
+		auto buffer = RENDER_AcquireFrameBuffer(Mode13hFrameBytes);
+		ASSERT_TRUE(buffer);
+
+		// The whole requested span must be writable
+		buffer[0]                     = 0xaa;
+		buffer[Mode13hFrameBytes - 1] = 0x55;
+
+		RENDER_ReleaseFrameBuffer(buffer);
+	}
+
+	const auto after = RENDER_GetFrameBufferPoolStats();
+	EXPECT_EQ(after.heap_allocations, before.heap_allocations);
+	EXPECT_EQ(after.pool_reuses, before.pool_reuses + num_frames);
+}
+
+TEST(RenderFrameBufferPool, SameSizeClassReusesAcrossModeChanges)
+{
+	// A 32-bit and a 24-bit 320x200 frame round up to the same
+	// power-of-two class, so switching between them reuses the buffer
+	constexpr uint32_t bgrx32_frame_bytes = 320 * 200 * 4;
+	constexpr uint32_t bgr24_frame_bytes  = 320 * 200 * 3;
+
+	RENDER_ReleaseFrameBuffer(RENDER_AcquireFrameBuffer(bgrx32_frame_bytes));
+
+	const auto before = RENDER_GetFrameBufferPoolStats();
+
+	RENDER_ReleaseFrameBuffer(RENDER_AcquireFrameBuffer(bgr24_frame_bytes));
+
+	const auto after = RENDER_GetFrameBufferPoolStats();
+	EXPECT_EQ(after.heap_allocations, before.heap_allocations);
+	EXPECT_EQ(after.pool_reuses, before.pool_reuses + 1);
+}
+
+TEST(RenderFrameBufferPool, ConcurrentBuffersAreDistinct)
+{
+	auto first  = RENDER_AcquireFrameBuffer(Mode13hFrameBytes);
+	auto second = RENDER_AcquireFrameBuffer(Mode13hFrameBytes);
+
+	EXPECT_NE(first, second);
+
+	RENDER_ReleaseFrameBuffer(first);
+	RENDER_ReleaseFrameBuffer(second);
+}
+
+TEST(RenderFrameBufferPool, ReleasingNullIsANoOp)
+{
+	RENDER_ReleaseFrameBuffer(nullptr);
+}
+
+TEST(RenderFrameBufferPool, DeepCopyRoundTripIsAllocationFreeWhenWarm)
+{
+	constexpr uint16_t width  = 64;
+	constexpr uint16_t height = 32;
+
+	std::vector<uint8_t> source(width * height);
+	for (size_t i = 0; i < source.size(); ++i) {
+		source[i] = static_cast<uint8_t>(i);
+	}
+	std::vector<uint8_t> palette(256 * 4, 0x7f);
+
+	RenderedImage image    = {};
+	image.params.width     = width;
+	image.params.height    = height;
+	image.pitch            = width;
+	image.image_data       = source.data();
+	image.palette_data     = palette.data();
+
+	// First copy may allocate; it warms both size classes
+	auto warm_copy = image.deep_copy();
+	warm_copy.free();
+
+	const auto before = RENDER_GetFrameBufferPoolStats();
+
+	auto copy = image.deep_copy();
+	EXPECT_EQ(0, std::memcmp(copy.image_data, source.data(), source.size()));
+	EXPECT_EQ(0, std::memcmp(copy.palette_data, palette.data(), palette.size()));
+	copy.free();
+
+	const auto after = RENDER_GetFrameBufferPoolStats();
+	EXPECT_EQ(after.heap_allocations, before.heap_allocations);
+}
+
+} // namespace
@@ -98,4 +98,35 @@ TEST(ParseEnv, FilterOutEmptyPropname)
 	EXPECT_EQ(expected_empty, parse_environ(test_environ));
 }
 
+TEST(SectionProp, FindPropIsCaseInsensitive)
+{
+	Section_prop section("test");
+	section.Add_int("someint", Property::Changeable::Always, 7);
+
+	EXPECT_NE(nullptr, section.FindProp("someint"));
+	EXPECT_EQ(section.FindProp("someint"), section.FindProp("SomeInt"));
+	EXPECT_EQ(nullptr, section.FindProp("missing"));
+	EXPECT_EQ(7, section.Get_int("SOMEINT"));
+}
+
+TEST(PropHandleTest, ResolvedOnceAndNotified)
+{
+	Section_prop section("test");
+	section.Add_bool("somebool", Property::Changeable::Always, false);
+
+	const PropHandle<bool> handle(&section, "somebool");
+	ASSERT_TRUE(handle.IsValid());
+	EXPECT_FALSE(handle.Get());
+
+	bool notified = false;
+	handle.OnChange([&](const Value& value) { notified = (bool)value; });
+
+	EXPECT_TRUE(section.HandleInputline("somebool = on"));
+	EXPECT_TRUE(handle.Get());
+	EXPECT_TRUE(notified);
+
+	const PropHandle<bool> invalid(&section, "missing");
+	EXPECT_FALSE(invalid.IsValid());
+}
+
 } // namespace